@@ -0,0 +1,477 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file main.c
+ *
+ * AT client parser benchmark.
+ *
+ * Replays a captured modem output, rich in unsolicited responses, to an AT client device through
+ * a socket pair, with the handlers of a typical modem service subscribed along with dozens of
+ * handlers that never match.  The stream is written in chunks that split lines over several
+ * reads.  Checks that each handler gets exactly the unsolicited responses it subscribed to, then
+ * sends commands answered with intermediate and final responses, and reports the number of
+ * lines and commands handled per second.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_PASSES           100
+#   define NUM_COMMANDS         100
+#else
+#   define NUM_PASSES           2000
+#   define NUM_COMMANDS         1000
+#endif
+
+/// Number of subscribed patterns no line of the capture matches.
+#define NUM_IDLE_HANDLERS       48
+
+/// Size of the chunks the capture is written in, so that lines are split over reads.
+#define CHUNK_BYTES             100
+
+/// Time to wait for all unsolicited responses or command responses, in seconds.
+#define TIMEOUT_SEC             60
+
+/// Command sent to the device, and its responses.
+#define COMMAND                 "AT+CSQ"
+#define INTERMEDIATE_RSP        "+CSQ: 18,99"
+#define FINAL_RSP               "OK"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Captured modem output: one unsolicited response per entry, lines separated by CRLF.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* const Capture[] =
+{
+    "+CREG: 1,\"1A2B\",\"0C3D4E5\",7",
+    "+CGREG: 1,\"1A2B\",\"0C3D4E5\",7,\"01\"",
+    "+CSQ: 18,99",
+    "+CMTI: \"SM\",3",
+    "RING",
+    "+CLIP: \"+33612345678\",145,,,,0",
+    "RING",
+    "+CLIP: \"+33612345678\",145,,,,0",
+    "NO CARRIER",
+    "+CMT: \"+33612345678\",,\"24/10/17,10:12:55+08\"\r\nHello from the parser benchmark",
+    "+CIEV: 2,3",
+    "^SYSSTART",
+    "+CREG: 5,\"1A2B\",\"0C3D4E6\",7",
+    "+CEREG: 1,\"1A2B\",\"0C3D4E6\",7",
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscribed unsolicited response.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char        pattern[16];        ///< Pattern to match
+    uint32_t    lineCount;          ///< Number of lines of the response
+    bool        checkText;          ///< Check the response is one of the captured ones
+    int         expectedCount;      ///< Number of responses expected
+    int         count;              ///< Number of responses received
+    int         badCount;           ///< Number of responses not matching the capture
+    le_atClient_UnsolicitedResponseHandlerRef_t ref;    ///< Handler reference
+}
+Subscription_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscriptions of a modem service, the last one overlapping the others, then idle ones.
+ */
+//--------------------------------------------------------------------------------------------------
+static Subscription_t Subscriptions[8 + 1 + NUM_IDLE_HANDLERS] =
+{
+    { .pattern = "+CREG:",      .lineCount = 1, .checkText = true },
+    { .pattern = "+CGREG:",     .lineCount = 1, .checkText = true },
+    { .pattern = "+CMTI:",      .lineCount = 1, .checkText = true },
+    { .pattern = "RING",        .lineCount = 1, .checkText = true },
+    { .pattern = "+CLIP:",      .lineCount = 1, .checkText = true },
+    { .pattern = "NO CARRIER",  .lineCount = 1, .checkText = true },
+    { .pattern = "+CMT:",       .lineCount = 2, .checkText = true },
+    { .pattern = "+CIEV:",      .lineCount = 1, .checkText = true },
+    { .pattern = "+C",          .lineCount = 1, .checkText = false },
+};
+
+/// Total number of unsolicited responses expected, and received.
+static int ExpectedTotal;
+static int ReceivedTotal;
+
+/// Posted once all unsolicited responses are received.
+static le_sem_Ref_t DoneSem;
+
+/// Host end of the socket pair.
+static int HostFd;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetElapsedSec
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count the lines of a capture entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CountLines
+(
+    const char* entryPtr        ///< [IN] Capture entry.
+)
+{
+    int count = 1;
+
+    while ((entryPtr = strstr(entryPtr, "\r\n")) != NULL)
+    {
+        entryPtr += 2;
+        count++;
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response handler, called in the device thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnsolicitedHandler
+(
+    const char* unsolicitedRsp, ///< [IN] Unsolicited response.
+    void* contextPtr            ///< [IN] Subscription.
+)
+{
+    Subscription_t* subPtr = contextPtr;
+    size_t i;
+
+    subPtr->count++;
+
+    if (subPtr->checkText)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(Capture); i++)
+        {
+            if (strcmp(unsolicitedRsp, Capture[i]) == 0)
+            {
+                break;
+            }
+        }
+        if (i == NUM_ARRAY_MEMBERS(Capture))
+        {
+            subPtr->badCount++;
+        }
+    }
+
+    if (++ReceivedTotal == ExpectedTotal)
+    {
+        le_sem_Post(DoneSem);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the stream replayed to the device.
+ *
+ * @return Stream, to be freed.
+ */
+//--------------------------------------------------------------------------------------------------
+static char* BuildStream
+(
+    size_t* sizePtr,            ///< [OUT] Stream size.
+    int* numLinesPtr            ///< [OUT] Number of lines of the stream.
+)
+{
+    size_t passSize = 0;
+    int passLines = 0;
+    size_t i;
+    int pass;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Capture); i++)
+    {
+        passSize += strlen("\r\n") + strlen(Capture[i]) + strlen("\r\n");
+        passLines += CountLines(Capture[i]);
+    }
+
+    char* streamPtr = malloc(passSize * NUM_PASSES + 1);
+    LE_ASSERT(streamPtr != NULL);
+
+    char* endPtr = streamPtr;
+    for (pass = 0; pass < NUM_PASSES; pass++)
+    {
+        for (i = 0; i < NUM_ARRAY_MEMBERS(Capture); i++)
+        {
+            endPtr += sprintf(endPtr, "\r\n%s\r\n", Capture[i]);
+        }
+    }
+
+    *sizePtr = endPtr - streamPtr;
+    *numLinesPtr = passLines * NUM_PASSES;
+    return streamPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscribe to the unsolicited responses, and compute the expected count of each one by matching
+ * the capture against every pattern.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Subscribe
+(
+    le_atClient_DeviceRef_t devRef  ///< [IN] Device.
+)
+{
+    size_t i;
+    size_t j;
+
+    ExpectedTotal = 0;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        Subscription_t* subPtr = &Subscriptions[i];
+
+        if (subPtr->pattern[0] == '\0')
+        {
+            snprintf(subPtr->pattern, sizeof(subPtr->pattern), "+XIDLE%02zu:", i);
+            subPtr->lineCount = 1;
+        }
+
+        subPtr->expectedCount = 0;
+        for (j = 0; j < NUM_ARRAY_MEMBERS(Capture); j++)
+        {
+            if (strncmp(Capture[j], subPtr->pattern, strlen(subPtr->pattern)) == 0)
+            {
+                subPtr->expectedCount += NUM_PASSES;
+            }
+        }
+        ExpectedTotal += subPtr->expectedCount;
+
+        subPtr->ref = le_atClient_AddUnsolicitedResponseHandler(subPtr->pattern, devRef,
+                                                                 UnsolicitedHandler, subPtr,
+                                                                 subPtr->lineCount);
+        LE_TEST_ASSERT(subPtr->ref != NULL, "Subscribe to %s", subPtr->pattern);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the capture and check the unsolicited responses received.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReplayCapture
+(
+    void
+)
+{
+    size_t streamSize;
+    int numLines;
+    char* streamPtr = BuildStream(&streamSize, &numLines);
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_clk_Time_t timeout = { TIMEOUT_SEC, 0 };
+    size_t offset;
+    size_t i;
+    int failCount = 0;
+
+    LE_TEST_INFO("Replaying %zu bytes, %d lines, %d unsolicited responses expected",
+                 streamSize, numLines, ExpectedTotal);
+
+    for (offset = 0; offset < streamSize; offset += CHUNK_BYTES)
+    {
+        size_t size = streamSize - offset;
+
+        if (size > CHUNK_BYTES)
+        {
+            size = CHUNK_BYTES;
+        }
+
+        LE_TEST_ASSERT(write(HostFd, streamPtr + offset, size) == (ssize_t)size,
+                       "Write stream");
+    }
+
+    LE_TEST_OK(le_sem_WaitWithTimeOut(DoneSem, timeout) == LE_OK,
+               "%d unsolicited responses received", ReceivedTotal);
+
+    double sec = GetElapsedSec(startTime);
+    LE_TEST_INFO("Parsed %d lines in %.3f s (%.0f lines/s), %zu handlers",
+                 numLines, sec, sec > 0 ? numLines / sec : 0,
+                 NUM_ARRAY_MEMBERS(Subscriptions));
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        Subscription_t* subPtr = &Subscriptions[i];
+
+        if ((subPtr->count != subPtr->expectedCount) || (subPtr->badCount != 0))
+        {
+            LE_TEST_INFO("%s: %d responses, %d expected, %d unexpected", subPtr->pattern,
+                         subPtr->count, subPtr->expectedCount, subPtr->badCount);
+            failCount++;
+        }
+    }
+    LE_TEST_OK(failCount == 0, "Each handler got its unsolicited responses");
+
+    free(streamPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Answer the commands sent to the device.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Responder
+(
+    void* contextPtr
+)
+{
+    static const char response[] = "\r\n" INTERMEDIATE_RSP "\r\n\r\n" FINAL_RSP "\r\n";
+    char buffer[64];
+    size_t size = 0;
+    int count;
+
+    for (count = 0; count < NUM_COMMANDS; count++)
+    {
+        char* endPtr;
+
+        while ((endPtr = memchr(buffer, '\r', size)) == NULL)
+        {
+            ssize_t readSize = read(HostFd, buffer + size, sizeof(buffer) - size);
+
+            if (readSize <= 0)
+            {
+                return NULL;
+            }
+            size += readSize;
+        }
+
+        // Drop the command, keep what follows it
+        endPtr++;
+        size -= endPtr - buffer;
+        memmove(buffer, endPtr, size);
+
+        if (write(HostFd, response, sizeof(response) - 1) != sizeof(response) - 1)
+        {
+            return NULL;
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send commands and check their responses.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendCommands
+(
+    le_atClient_DeviceRef_t devRef  ///< [IN] Device.
+)
+{
+    le_thread_Ref_t responderRef = le_thread_Create("Responder", Responder, NULL);
+    char buffer[LE_ATDEFS_RESPONSE_MAX_BYTES];
+    le_clk_Time_t startTime;
+    int okCount = 0;
+    int i;
+
+    le_thread_SetJoinable(responderRef);
+    le_thread_Start(responderRef);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_COMMANDS; i++)
+    {
+        le_atClient_CmdRef_t cmdRef;
+
+        if (le_atClient_SetCommandAndSend(&cmdRef, devRef, COMMAND, "+CSQ:",
+                                          "OK|ERROR|+CME ERROR:", TIMEOUT_SEC * 1000) != LE_OK)
+        {
+            continue;
+        }
+
+        if ((le_atClient_GetFinalResponse(cmdRef, buffer, sizeof(buffer)) == LE_OK) &&
+            (strcmp(buffer, FINAL_RSP) == 0) &&
+            (le_atClient_GetFirstIntermediateResponse(cmdRef, buffer, sizeof(buffer)) == LE_OK) &&
+            (strcmp(buffer, INTERMEDIATE_RSP) == 0))
+        {
+            okCount++;
+        }
+        le_atClient_Delete(cmdRef);
+    }
+
+    double sec = GetElapsedSec(startTime);
+    LE_TEST_INFO("Sent %d commands in %.3f s (%.0f/s)", NUM_COMMANDS, sec,
+                 sec > 0 ? NUM_COMMANDS / sec : 0);
+    LE_TEST_OK(okCount == NUM_COMMANDS, "%d commands answered", okCount);
+
+    le_thread_Join(responderRef, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* Benchmark
+(
+    void* contextPtr
+)
+{
+    le_atClient_DeviceRef_t devRef;
+    int fds[2];
+    size_t i;
+
+    LE_TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "Create socket pair");
+    HostFd = fds[1];
+
+    devRef = le_atClient_Start(fds[0]);
+    LE_TEST_ASSERT(devRef != NULL, "Start device");
+
+    Subscribe(devRef);
+    ReplayCapture();
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        le_atClient_RemoveUnsolicitedResponseHandler(Subscriptions[i].ref);
+    }
+
+    SendCommands(devRef);
+
+    LE_TEST_OK(le_atClient_Stop(devRef) == LE_OK, "Stop device");
+    close(HostFd);
+
+    LE_TEST_EXIT;
+    return NULL;
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("AT client parser benchmark");
+
+    DoneSem = le_sem_Create("ParserPerfSem", 0);
+
+    le_thread_Start(le_thread_Create("ParserPerf", Benchmark, NULL));
+}
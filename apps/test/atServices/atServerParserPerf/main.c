@@ -0,0 +1,355 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file main.c
+ *
+ * AT server parser benchmark.
+ *
+ * Opens an AT server device on the slave side of a pseudo-terminal, with a typical set of basic
+ * and extended commands registered along with dozens of commands never sent.  A host thread
+ * writes command lines to the master side, one at a time, and waits for the final response of
+ * each of them: single commands first, then lines of concatenated commands mixing basic and
+ * extended commands, quoted strings and lower case names.  The handlers check the parameters
+ * they get and answer synchronously.  Reports the number of lines and commands handled per
+ * second.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+
+#include <termios.h>
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_LINES            500
+#else
+#   define NUM_LINES            10000
+#endif
+
+/// Number of registered commands no line refers to.
+#define NUM_IDLE_COMMANDS       48
+
+/// Time to wait for the final response of a line, in milliseconds.
+#define TIMEOUT_MS              10000
+
+/// Final response expected for each line.
+#define FINAL_RSP               "\r\nOK\r\n"
+
+/// Parameters of the extended command, as sent and as expected by its handler.
+#define BENCH_PARAMS            "1,\"Hello; world, \",abc"
+static const char* const BenchParams[] = { "1", "Hello; world, ", "ABC" };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Command line sent to the device, and number of commands it holds.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* linePtr;            ///< Command line, without the ending CR
+    int         cmdCount;           ///< Number of commands in the line
+}
+CmdLine_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Single commands.
+ */
+//--------------------------------------------------------------------------------------------------
+static const CmdLine_t SingleLines[] =
+{
+    { "AT+BENCH=" BENCH_PARAMS, 1 },
+    { "at+bench?",              1 },
+    { "AT+BENCH=?",             1 },
+    { "ATE0",                   1 },
+    { "ATS0=2",                 1 },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Concatenated commands.
+ */
+//--------------------------------------------------------------------------------------------------
+static const CmdLine_t ConcatenatedLines[] =
+{
+    { "AT+BENCH=" BENCH_PARAMS ";+bench?;E1V1Q0&C1S0=2;+BENCH=" BENCH_PARAMS, 8 },
+    { "ATE0V1&C1;+BENCH=?;+Bench=" BENCH_PARAMS ";+BENCH?",                  6 },
+    { "at&c1e0v1q0s0=3s7?;+bench=" BENCH_PARAMS,                             7 },
+};
+
+/// Basic commands registered, in addition to the extended one.
+static const char* const BasicCmds[] = { "ATE", "ATV", "ATQ", "AT&C", "ATS" };
+
+/// Number of commands handled, and of commands that got unexpected parameters.
+static int HandledCount;
+static int BadParamCount;
+
+/// Master side of the pseudo-terminal.
+static int HostFd;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetElapsedSec
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extended command handler: checks the parameters, then answers OK.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchCmdHandler
+(
+    le_atServer_CmdRef_t commandRef,
+    le_atServer_Type_t type,
+    uint32_t parametersNumber,
+    void* contextPtr
+)
+{
+    char param[LE_ATDEFS_PARAMETER_MAX_BYTES];
+    uint32_t expectedNumber = (type == LE_ATSERVER_TYPE_PARA) ?
+                              NUM_ARRAY_MEMBERS(BenchParams) : 0;
+    uint32_t i;
+
+    HandledCount++;
+
+    if (parametersNumber != expectedNumber)
+    {
+        BadParamCount++;
+    }
+    else
+    {
+        for (i = 0; i < parametersNumber; i++)
+        {
+            if ((le_atServer_GetParameter(commandRef, i, param, sizeof(param)) != LE_OK) ||
+                (strcmp(param, BenchParams[i]) != 0))
+            {
+                BadParamCount++;
+                break;
+            }
+        }
+    }
+
+    le_atServer_SendFinalResultCode(commandRef, LE_ATSERVER_OK, "", 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Basic command handler: reads the parameters, then answers OK.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BasicCmdHandler
+(
+    le_atServer_CmdRef_t commandRef,
+    le_atServer_Type_t type,
+    uint32_t parametersNumber,
+    void* contextPtr
+)
+{
+    char param[LE_ATDEFS_PARAMETER_MAX_BYTES];
+    uint32_t i;
+
+    HandledCount++;
+
+    if (parametersNumber == 0)
+    {
+        BadParamCount++;
+    }
+
+    for (i = 0; i < parametersNumber; i++)
+    {
+        if ((le_atServer_GetParameter(commandRef, i, param, sizeof(param)) != LE_OK) ||
+            (param[0] < '0') || (param[0] > '9'))
+        {
+            BadParamCount++;
+            break;
+        }
+    }
+
+    le_atServer_SendFinalResultCode(commandRef, LE_ATSERVER_OK, "", 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a command line and wait for its final response.
+ *
+ * @return true if the line was answered OK.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendLine
+(
+    const char* linePtr         ///< [IN] Command line, without the ending CR.
+)
+{
+    char buffer[64];
+    size_t size = 0;
+    size_t len = strlen(linePtr);
+    struct pollfd pollFd = { .fd = HostFd, .events = POLLIN };
+
+    if ((write(HostFd, linePtr, len) != (ssize_t)len) || (write(HostFd, "\r", 1) != 1))
+    {
+        return false;
+    }
+
+    // A final response is the first line ending with CRLF that is not empty
+    while ((size <= 2) || (memcmp(buffer + size - 2, "\r\n", 2) != 0))
+    {
+        ssize_t readSize;
+
+        if ((size == sizeof(buffer)) || (poll(&pollFd, 1, TIMEOUT_MS) != 1))
+        {
+            return false;
+        }
+
+        readSize = read(HostFd, buffer + size, sizeof(buffer) - size);
+        if (readSize <= 0)
+        {
+            return false;
+        }
+        size += readSize;
+    }
+
+    return (size == strlen(FINAL_RSP)) && (memcmp(buffer, FINAL_RSP, size) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send NUM_LINES command lines, cycling through a set of them, and check they are answered.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendLines
+(
+    const char* stepPtr,        ///< [IN] Step name.
+    const CmdLine_t* linesPtr,  ///< [IN] Command lines.
+    size_t numLines             ///< [IN] Number of command lines.
+)
+{
+    le_clk_Time_t startTime;
+    int expectedCount = 0;
+    int okCount = 0;
+    int i;
+
+    HandledCount = 0;
+    BadParamCount = 0;
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_LINES; i++)
+    {
+        const CmdLine_t* cmdLinePtr = &linesPtr[i % numLines];
+
+        expectedCount += cmdLinePtr->cmdCount;
+        if (SendLine(cmdLinePtr->linePtr))
+        {
+            okCount++;
+        }
+    }
+
+    double sec = GetElapsedSec(startTime);
+    LE_TEST_INFO("%s: %d lines, %d commands in %.3f s (%.0f lines/s, %.0f commands/s)",
+                 stepPtr, NUM_LINES, expectedCount, sec,
+                 sec > 0 ? NUM_LINES / sec : 0, sec > 0 ? expectedCount / sec : 0);
+
+    LE_TEST_OK(okCount == NUM_LINES, "%s: %d lines answered OK", stepPtr, okCount);
+    LE_TEST_OK(HandledCount == expectedCount, "%s: %d commands handled", stepPtr, HandledCount);
+    LE_TEST_OK(BadParamCount == 0, "%s: %d commands with unexpected parameters",
+               stepPtr, BadParamCount);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Host thread: drives the device through the master side of the pseudo-terminal.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* AtHost
+(
+    void* contextPtr
+)
+{
+    SendLines("Single", SingleLines, NUM_ARRAY_MEMBERS(SingleLines));
+    SendLines("Concatenated", ConcatenatedLines, NUM_ARRAY_MEMBERS(ConcatenatedLines));
+
+    LE_TEST_OK(!SendLine("AT+XUNKNOWN"), "Unknown command rejected");
+    LE_TEST_OK(SendLine("ATE1"), "Device still usable");
+
+    close(HostFd);
+
+    LE_TEST_EXIT;
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Register a command and its handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RegisterCommand
+(
+    const char* namePtr,                            ///< [IN] Command name.
+    le_atServer_CommandHandlerFunc_t handlerPtr     ///< [IN] Command handler.
+)
+{
+    le_atServer_CmdRef_t cmdRef = le_atServer_Create(namePtr);
+
+    LE_TEST_ASSERT(cmdRef != NULL, "Create %s", namePtr);
+    LE_TEST_ASSERT(le_atServer_AddCommandHandler(cmdRef, handlerPtr, NULL) != NULL,
+                   "Add %s handler", namePtr);
+}
+
+
+COMPONENT_INIT
+{
+    char name[LE_ATDEFS_COMMAND_MAX_BYTES];
+    struct termios term;
+    int slaveFd;
+    size_t i;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("AT server parser benchmark, %d lines per step", NUM_LINES);
+
+    HostFd = posix_openpt(O_RDWR | O_NOCTTY);
+    LE_TEST_ASSERT(HostFd != -1, "Open pseudo-terminal master");
+    LE_TEST_ASSERT((grantpt(HostFd) == 0) && (unlockpt(HostFd) == 0), "Unlock slave");
+
+    slaveFd = open(ptsname(HostFd), O_RDWR | O_NOCTTY);
+    LE_TEST_ASSERT(slaveFd != -1, "Open pseudo-terminal slave");
+
+    // Raw mode: no echo, CR not translated
+    LE_TEST_ASSERT(tcgetattr(slaveFd, &term) == 0, "Get slave attributes");
+    cfmakeraw(&term);
+    LE_TEST_ASSERT(tcsetattr(slaveFd, TCSANOW, &term) == 0, "Set slave attributes");
+
+    for (i = 0; i < NUM_IDLE_COMMANDS; i++)
+    {
+        snprintf(name, sizeof(name), "AT+XIDLE%02zu", i);
+        RegisterCommand(name, BenchCmdHandler);
+    }
+    RegisterCommand("AT+BENCH", BenchCmdHandler);
+    for (i = 0; i < NUM_ARRAY_MEMBERS(BasicCmds); i++)
+    {
+        RegisterCommand(BasicCmds[i], BasicCmdHandler);
+    }
+
+    LE_TEST_ASSERT(le_atServer_Open(slaveFd) != NULL, "Open device");
+
+    le_thread_Start(le_thread_Create("AtHost", AtHost, NULL));
+}
@@ -0,0 +1,329 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file recordPerfMain.c
+ *
+ * Time series recording benchmark.
+ *
+ * Records the same interleaved humidity and temperature samples twice: once with one
+ * le_avdata_RecordInt() or le_avdata_RecordFloat() call per sample, then with
+ * le_avdata_RecordBatch().  Checks that the batches record every sample, in order, and reports
+ * the number of samples recorded per second with each API.
+ *
+ * Time series are enabled on both fields if the target supports them, and restarted whenever
+ * their buffer fills up, as no session is needed to run this test.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+
+#define HUMIDITY_FIELD          "Humidity"
+#define HUMIDITY_INCREMENT      1000
+#define HUMIDITY_SCALE          .001
+
+#define TEMPERATURE_FIELD       "Temperature"
+#define TEMPERATURE_INCREMENT   0.01
+#define TEMPERATURE_SCALE       100
+
+/// Samples are 10 ms apart, i.e. a time stamp factor of .1.
+#define SAMPLE_PERIOD_MSEC      10
+#define SAMPLE_RATE             .1
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_SAMPLES          400
+#else
+#   define NUM_SAMPLES          4000
+#endif
+
+/// Instance the samples are recorded on.
+static le_avdata_AssetInstanceRef_t InstRef;
+
+/// Are time series enabled on the fields?
+static bool IsTimeSeries;
+
+/// Time stamp of the first sample.
+static uint64_t StartMilliSec;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetElapsedSec
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build sample i of the sequence: even samples are humidity, odd samples are temperature.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MakeSample
+(
+    int i,                              ///< [IN] Index of the sample.
+    le_avdata_Sample_t* samplePtr       ///< [OUT] Sample.
+)
+{
+    memset(samplePtr, 0, sizeof(*samplePtr));
+
+    if (i % 2 == 0)
+    {
+        LE_ASSERT_OK(le_utf8_Copy(samplePtr->fieldName, HUMIDITY_FIELD,
+                                  sizeof(samplePtr->fieldName), NULL));
+        samplePtr->type = LE_AVDATA_SAMPLE_INT;
+        samplePtr->intValue = (i / 2) * HUMIDITY_INCREMENT;
+    }
+    else
+    {
+        LE_ASSERT_OK(le_utf8_Copy(samplePtr->fieldName, TEMPERATURE_FIELD,
+                                  sizeof(samplePtr->fieldName), NULL));
+        samplePtr->type = LE_AVDATA_SAMPLE_FLOAT;
+        samplePtr->floatValue = 20 + (i / 2) * TEMPERATURE_INCREMENT;
+    }
+
+    samplePtr->timestamp = StartMilliSec + (uint64_t)i * SAMPLE_PERIOD_MSEC;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start time series on both fields.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartTimeSeries
+(
+    void
+)
+{
+    le_result_t result;
+
+    result = le_avdata_StartTimeSeries(InstRef, HUMIDITY_FIELD, HUMIDITY_SCALE, SAMPLE_RATE);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    return le_avdata_StartTimeSeries(InstRef, TEMPERATURE_FIELD, TEMPERATURE_SCALE, SAMPLE_RATE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restart the time series of a field whose buffer is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestartTimeSeries
+(
+    const char* fieldName       ///< [IN] Field whose buffer is full.
+)
+{
+    bool isHumidity = (strcmp(fieldName, HUMIDITY_FIELD) == 0);
+
+    LE_TEST_ASSERT(IsTimeSeries, "Buffer full only when time series are enabled");
+    LE_TEST_ASSERT(le_avdata_StopTimeSeries(InstRef, fieldName) == LE_OK,
+                   "Stop time series on %s", fieldName);
+    LE_TEST_ASSERT(le_avdata_StartTimeSeries(InstRef, fieldName,
+                                             isHumidity ? HUMIDITY_SCALE : TEMPERATURE_SCALE,
+                                             SAMPLE_RATE) == LE_OK,
+                   "Restart time series on %s", fieldName);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record all samples with one call per sample.
+ *
+ * @return Number of samples recorded per second.
+ */
+//--------------------------------------------------------------------------------------------------
+static double RecordEach
+(
+    void
+)
+{
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_avdata_Sample_t sample;
+    int i;
+
+    for (i = 0; i < NUM_SAMPLES; i++)
+    {
+        le_result_t result;
+
+        MakeSample(i, &sample);
+
+        if (sample.type == LE_AVDATA_SAMPLE_INT)
+        {
+            result = le_avdata_RecordInt(InstRef, sample.fieldName, sample.intValue,
+                                         sample.timestamp);
+        }
+        else
+        {
+            result = le_avdata_RecordFloat(InstRef, sample.fieldName, sample.floatValue,
+                                           sample.timestamp);
+        }
+
+        if (result == LE_OVERFLOW)
+        {
+            // Not recorded: make room and record it again.
+            RestartTimeSeries(sample.fieldName);
+            i--;
+            continue;
+        }
+        if (result == LE_NO_MEMORY)
+        {
+            RestartTimeSeries(sample.fieldName);
+            continue;
+        }
+        LE_TEST_ASSERT(result == LE_OK, "Record sample %d (%s)", i, LE_RESULT_TXT(result));
+    }
+
+    return NUM_SAMPLES / GetElapsedSec(startTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record all samples in batches.
+ *
+ * @return Number of samples recorded per second.
+ */
+//--------------------------------------------------------------------------------------------------
+static double RecordBatches
+(
+    void
+)
+{
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_avdata_Sample_t samples[LE_AVDATA_RECORD_BATCH_MAX];
+    int numRecorded = 0;
+    int numCalls = 0;
+
+    while (numRecorded < NUM_SAMPLES)
+    {
+        size_t numSamples = 0;
+        uint32_t batchRecorded;
+        le_result_t result;
+
+        while ((numSamples < NUM_ARRAY_MEMBERS(samples)) &&
+               (numRecorded + (int)numSamples < NUM_SAMPLES))
+        {
+            MakeSample(numRecorded + numSamples, &samples[numSamples]);
+            numSamples++;
+        }
+
+        result = le_avdata_RecordBatch(InstRef, samples, numSamples, &batchRecorded);
+        numCalls++;
+
+        LE_TEST_ASSERT(batchRecorded <= numSamples, "Recorded %" PRIu32 " of %zu samples",
+                       batchRecorded, numSamples);
+        numRecorded += batchRecorded;
+
+        if (result == LE_OVERFLOW)
+        {
+            // The sample after the recorded ones did not fit: resume from it.
+            RestartTimeSeries(samples[batchRecorded].fieldName);
+            continue;
+        }
+        if (result == LE_NO_MEMORY)
+        {
+            // The last recorded sample filled its buffer: resume after it.
+            LE_TEST_ASSERT(batchRecorded > 0, "Sample recorded before buffer full");
+            RestartTimeSeries(samples[batchRecorded - 1].fieldName);
+            continue;
+        }
+        LE_TEST_ASSERT(result == LE_OK, "Record batch (%s)", LE_RESULT_TXT(result));
+        LE_TEST_ASSERT(batchRecorded == numSamples, "All samples of batch recorded");
+    }
+
+    LE_TEST_INFO("%d samples recorded in %d calls", numRecorded, numCalls);
+    LE_TEST_OK(numRecorded == NUM_SAMPLES, "%d samples recorded by batches, expected %d",
+               numRecorded, NUM_SAMPLES);
+
+    return NUM_SAMPLES / GetElapsedSec(startTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that the fields hold the values of the last samples.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckLastValues
+(
+    const char* apiName         ///< [IN] API the samples were recorded with.
+)
+{
+    le_avdata_Sample_t sample;
+    int32_t humidity;
+    double temperature;
+
+    le_avdata_GetInt(InstRef, HUMIDITY_FIELD, &humidity);
+    MakeSample(NUM_SAMPLES - 2, &sample);
+    LE_TEST_OK(humidity == sample.intValue, "%s: last humidity %" PRId32 ", expected %" PRId32,
+               apiName, humidity, sample.intValue);
+
+    le_avdata_GetFloat(InstRef, TEMPERATURE_FIELD, &temperature);
+    MakeSample(NUM_SAMPLES - 1, &sample);
+    LE_TEST_OK(temperature == sample.floatValue, "%s: last temperature %f, expected %f",
+               apiName, temperature, sample.floatValue);
+}
+
+
+COMPONENT_INIT
+{
+    struct timeval tv;
+    double eachRate;
+    double batchRate;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("Time series recording benchmark");
+
+    gettimeofday(&tv, NULL);
+    StartMilliSec = (uint64_t)(tv.tv_sec) * 1000 + (uint64_t)(tv.tv_usec) / 1000;
+
+    InstRef = le_avdata_Create("myHouse");
+
+    IsTimeSeries = (StartTimeSeries() == LE_OK);
+    LE_TEST_INFO("Time series %s", IsTimeSeries ? "enabled" : "not supported, recording values");
+
+    eachRate = RecordEach();
+    CheckLastValues("RecordInt/RecordFloat");
+
+    if (IsTimeSeries)
+    {
+        RestartTimeSeries(HUMIDITY_FIELD);
+        RestartTimeSeries(TEMPERATURE_FIELD);
+    }
+
+    // Reset the fields, so that the batch run is checked on its own.
+    le_avdata_SetInt(InstRef, HUMIDITY_FIELD, -1);
+    le_avdata_SetFloat(InstRef, TEMPERATURE_FIELD, -1);
+
+    batchRate = RecordBatches();
+    CheckLastValues("RecordBatch");
+
+    LE_TEST_INFO("RecordInt/RecordFloat: %.0f samples/s", eachRate);
+    LE_TEST_INFO("RecordBatch (%d per call): %.0f samples/s (x%.1f)", LE_AVDATA_RECORD_BATCH_MAX,
+                 batchRate, batchRate / eachRate);
+
+    if (IsTimeSeries)
+    {
+        le_avdata_StopTimeSeries(InstRef, HUMIDITY_FIELD);
+        le_avdata_StopTimeSeries(InstRef, TEMPERATURE_FIELD);
+    }
+
+    LE_TEST_EXIT;
+}
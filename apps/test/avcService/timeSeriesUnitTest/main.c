@@ -0,0 +1,574 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file main.c
+ *
+ * Unit test of the AV Data time series encoder.
+ *
+ * Records time series of each sample type, then inflates and CBOR decodes their payload, and
+ * checks that the header, the factors and the delta encoded samples give back what was recorded.
+ * The stream limits are reduced in Component.cdef, so that the payload of the larger series is
+ * spread over several chunks, and then spilled to a file until the stream refuses samples.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "timeSeries.h"
+
+#include "cbor.h"
+#include "zlib.h"
+
+/// Size of the compressed chunks of a stream.
+#define CHUNK_NUMBYTES          1024
+
+/// Maximum compressed size kept in memory, and kept in the spill file, as set in Component.cdef.
+#define MEMORY_MAX_NUMBYTES     (TIMESERIES_MAX_CHUNKS * CHUNK_NUMBYTES)
+#define SPILL_MAX_NUMBYTES      (TIMESERIES_SPILL_MAX_KBYTES * 1024)
+
+/// Maximum size of an inflated payload, and maximum number of samples in a series.
+#define INFLATED_MAX_NUMBYTES   (512 * 1024)
+#define SAMPLES_MAX             20000
+
+/// Number of samples of the small series, held in a single chunk.
+#define NUM_SMALL_SAMPLES       20
+
+/// Number of samples of the series spread over the chunks kept in memory.
+#define NUM_MEMORY_SAMPLES      300
+
+/// Resource path in the payload header.
+#define HEADER_ID               "/0/1"
+
+/// Time stamp of the first sample, in UTC milli seconds.
+#define START_MS                1500000000000ULL
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sample decoded from a payload.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t timeStamp;         ///< Absolute time stamp, the deltas being summed up.
+    CborValue value;            ///< Value, still CBOR encoded; a delta for integers and floats.
+}
+Sample_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload once inflated, its parser, and the samples decoded from it.  The samples refer to the
+ * parser, so it has to outlive Decode().
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t Inflated[INFLATED_MAX_NUMBYTES];
+static CborParser Parser;
+static Sample_t Samples[SAMPLES_MAX];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Recorded samples, to check the decoded ones against.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t TimeStamps[SAMPLES_MAX];
+static int IntValues[SAMPLES_MAX];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Return from the calling function with -1 if a condition on the payload is not met.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHECK_PAYLOAD(cond) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            LE_ERROR("Unexpected payload: %s", #cond); \
+            return -1; \
+        } \
+    } \
+    while (0)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a pseudo random number, the same sequence on every run.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NextRandom
+(
+    uint32_t* statePtr          ///< [IN/OUT] Generator state.
+)
+{
+    *statePtr = *statePtr * 1103515245u + 12345u;
+
+    return *statePtr >> 16;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Inflate a payload into Inflated.
+ *
+ * @return Size of the inflated payload, -1 on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Inflate
+(
+    const uint8_t* payloadPtr,  ///< [IN] Compressed payload.
+    size_t payloadNumBytes      ///< [IN] Compressed payload size.
+)
+{
+    z_stream zStream;
+    int zResult;
+
+    memset(&zStream, 0, sizeof(zStream));
+    CHECK_PAYLOAD(inflateInit(&zStream) == Z_OK);
+
+    zStream.next_in = (Bytef*)payloadPtr;
+    zStream.avail_in = (uInt)payloadNumBytes;
+    zStream.next_out = Inflated;
+    zStream.avail_out = sizeof(Inflated);
+
+    zResult = inflate(&zStream, Z_FINISH);
+    inflateEnd(&zStream);
+
+    CHECK_PAYLOAD(zResult == Z_STREAM_END);
+    CHECK_PAYLOAD(zStream.avail_in == 0);
+
+    return (int)(sizeof(Inflated) - zStream.avail_out);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Inflate and decode a payload into Samples, checking its header and factors.
+ *
+ * @return Number of samples, -1 on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Decode
+(
+    const uint8_t* payloadPtr,  ///< [IN] Compressed payload.
+    size_t payloadNumBytes,     ///< [IN] Compressed payload size.
+    double factor               ///< [IN] Expected value factor.
+)
+{
+    CborValue it;
+    CborValue map;
+    CborValue array;
+    double timeStampFactor;
+    double valueFactor;
+    int64_t timeStamp;
+    bool isEqual;
+    int numSamples = 0;
+    int numBytes = Inflate(payloadPtr, payloadNumBytes);
+
+    CHECK_PAYLOAD(numBytes > 0);
+    CHECK_PAYLOAD(cbor_parser_init(Inflated, numBytes, 0, &Parser, &it) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_is_map(&it));
+    CHECK_PAYLOAD(cbor_value_enter_container(&it, &map) == CborNoError);
+
+    // "h" : [ "/0/1" ]
+    CHECK_PAYLOAD(cbor_value_is_text_string(&map));
+    CHECK_PAYLOAD(cbor_value_text_string_equals(&map, "h", &isEqual) == CborNoError && isEqual);
+    CHECK_PAYLOAD(cbor_value_advance(&map) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_is_array(&map));
+    CHECK_PAYLOAD(cbor_value_enter_container(&map, &array) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_is_text_string(&array));
+    CHECK_PAYLOAD(cbor_value_text_string_equals(&array, HEADER_ID, &isEqual) == CborNoError &&
+                  isEqual);
+    CHECK_PAYLOAD(cbor_value_advance(&array) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_leave_container(&map, &array) == CborNoError);
+
+    // "f" : [ <time stamp factor>, <factor> ]
+    CHECK_PAYLOAD(cbor_value_text_string_equals(&map, "f", &isEqual) == CborNoError && isEqual);
+    CHECK_PAYLOAD(cbor_value_advance(&map) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_enter_container(&map, &array) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_is_double(&array));
+    CHECK_PAYLOAD(cbor_value_get_double(&array, &timeStampFactor) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_advance(&array) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_is_double(&array));
+    CHECK_PAYLOAD(cbor_value_get_double(&array, &valueFactor) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_advance(&array) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_leave_container(&map, &array) == CborNoError);
+    CHECK_PAYLOAD(timeStampFactor == 1);
+    CHECK_PAYLOAD(valueFactor == factor);
+
+    // "s" : [ <time stamp>, <value>, <time stamp delta>, <value>, ... ]
+    CHECK_PAYLOAD(cbor_value_text_string_equals(&map, "s", &isEqual) == CborNoError && isEqual);
+    CHECK_PAYLOAD(cbor_value_advance(&map) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_is_array(&map));
+    CHECK_PAYLOAD(!cbor_value_is_length_known(&map));
+    CHECK_PAYLOAD(cbor_value_enter_container(&map, &array) == CborNoError);
+
+    while (!cbor_value_at_end(&array))
+    {
+        CHECK_PAYLOAD(numSamples < SAMPLES_MAX);
+        CHECK_PAYLOAD(cbor_value_is_integer(&array));
+        CHECK_PAYLOAD(cbor_value_get_int64(&array, &timeStamp) == CborNoError);
+        CHECK_PAYLOAD(cbor_value_advance(&array) == CborNoError);
+        CHECK_PAYLOAD(!cbor_value_at_end(&array));
+
+        Samples[numSamples].timeStamp = (uint64_t)timeStamp +
+                                        (numSamples > 0 ? Samples[numSamples - 1].timeStamp : 0);
+        Samples[numSamples].value = array;
+        numSamples++;
+
+        CHECK_PAYLOAD(cbor_value_advance(&array) == CborNoError);
+    }
+
+    CHECK_PAYLOAD(cbor_value_leave_container(&map, &array) == CborNoError);
+    CHECK_PAYLOAD(cbor_value_at_end(&map));
+    CHECK_PAYLOAD(cbor_value_leave_container(&it, &map) == CborNoError);
+
+    return numSamples;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the decoded samples of an integer series against the recorded ones.
+ *
+ * @return Number of samples, -1 if they differ.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CheckIntSamples
+(
+    int numSamples              ///< [IN] Number of decoded samples.
+)
+{
+    int64_t value = 0;
+    int64_t delta;
+    int i;
+
+    for (i = 0; i < numSamples; i++)
+    {
+        CHECK_PAYLOAD(cbor_value_is_integer(&Samples[i].value));
+        CHECK_PAYLOAD(cbor_value_get_int64(&Samples[i].value, &delta) == CborNoError);
+
+        value += delta;
+
+        CHECK_PAYLOAD(Samples[i].timeStamp == TimeStamps[i]);
+        CHECK_PAYLOAD(value == IntValues[i]);
+    }
+
+    return numSamples;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the next integer sample of a series, with a jittered time stamp and a random value.
+ *
+ * @return Result of timeSeries_AddInt().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddRandomInt
+(
+    timeSeries_Ref_t streamRef, ///< [IN] Stream to add to.
+    int index,                  ///< [IN] Index of the sample.
+    uint32_t* randomPtr         ///< [IN/OUT] Random generator state.
+)
+{
+    TimeStamps[index] = START_MS + index * 1000 + NextRandom(randomPtr) % 100;
+    IntValues[index] = (int)(NextRandom(randomPtr) & 0xFFFF) - 0x8000;
+
+    return timeSeries_AddInt(streamRef, TimeStamps[index], IntValues[index]);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Small integer series: the payload is in a single chunk, and the stream is closed once finished.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestSmallInt
+(
+    void
+)
+{
+    timeSeries_Ref_t streamRef = timeSeries_Create(HEADER_ID, 1, 1);
+    uint8_t* payloadPtr;
+    size_t payloadNumBytes;
+    int i;
+
+    LE_TEST_ASSERT(streamRef != NULL, "Create small integer series");
+
+    for (i = 0; i < NUM_SMALL_SAMPLES; i++)
+    {
+        TimeStamps[i] = START_MS + i * 500;
+        IntValues[i] = i * i - 50;
+
+        if (timeSeries_AddInt(streamRef, TimeStamps[i], IntValues[i]) != LE_OK)
+        {
+            break;
+        }
+    }
+    LE_TEST_OK(i == NUM_SMALL_SAMPLES, "%d integer samples added", i);
+    LE_TEST_OK(timeSeries_GetNumSamples(streamRef) == NUM_SMALL_SAMPLES, "Number of samples");
+
+    LE_TEST_ASSERT(timeSeries_Finish(streamRef, &payloadPtr, &payloadNumBytes) == LE_OK,
+                   "Finish small integer series");
+    LE_TEST_OK(payloadNumBytes <= CHUNK_NUMBYTES, "Payload of %zu bytes in one chunk",
+               payloadNumBytes);
+    LE_TEST_OK(CheckIntSamples(Decode(payloadPtr, payloadNumBytes, 1)) == NUM_SMALL_SAMPLES,
+               "Integer samples decoded");
+
+    LE_TEST_OK(timeSeries_AddInt(streamRef, START_MS, 0) == LE_FAULT, "No sample once finished");
+    LE_TEST_OK(timeSeries_Finish(streamRef, &payloadPtr, &payloadNumBytes) == LE_FAULT,
+               "Finish only once");
+
+    timeSeries_Delete(streamRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Float series, encoded as floats with a factor of 1, and as integers otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestFloat
+(
+    double factor               ///< [IN] Value factor.
+)
+{
+    timeSeries_Ref_t streamRef = timeSeries_Create(HEADER_ID, 1, factor);
+    uint8_t* payloadPtr;
+    size_t payloadNumBytes;
+    double value = 0;
+    int numSamples;
+    int i;
+
+    LE_TEST_ASSERT(streamRef != NULL, "Create float series with factor %g", factor);
+
+    for (i = 0; i < NUM_SMALL_SAMPLES; i++)
+    {
+        TimeStamps[i] = START_MS + i * 250;
+
+        if (timeSeries_AddFloat(streamRef, TimeStamps[i], i * 0.25 - 1.5) != LE_OK)
+        {
+            break;
+        }
+    }
+    LE_TEST_OK(i == NUM_SMALL_SAMPLES, "%d float samples added", i);
+
+    LE_TEST_ASSERT(timeSeries_Finish(streamRef, &payloadPtr, &payloadNumBytes) == LE_OK,
+                   "Finish float series");
+
+    numSamples = Decode(payloadPtr, payloadNumBytes, factor);
+    LE_TEST_OK(numSamples == NUM_SMALL_SAMPLES, "%d float samples decoded", numSamples);
+
+    for (i = 0; i < numSamples; i++)
+    {
+        double delta;
+        int64_t intDelta;
+
+        // With a factor other than 1, floats are encoded as integers.
+        if ((factor == 1) && cbor_value_is_double(&Samples[i].value))
+        {
+            cbor_value_get_double(&Samples[i].value, &delta);
+        }
+        else if ((factor != 1) && cbor_value_is_integer(&Samples[i].value))
+        {
+            cbor_value_get_int64(&Samples[i].value, &intDelta);
+            delta = intDelta / factor;
+        }
+        else
+        {
+            break;
+        }
+        value += delta;
+
+        if ((Samples[i].timeStamp != TimeStamps[i]) || (fabs(value - (i * 0.25 - 1.5)) > 1e-9))
+        {
+            break;
+        }
+    }
+    LE_TEST_OK(i == numSamples, "Float samples match up to %d", i);
+
+    timeSeries_Delete(streamRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Boolean and string series, whose values are not delta encoded.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestBoolString
+(
+    void
+)
+{
+    timeSeries_Ref_t boolRef = timeSeries_Create(HEADER_ID, 1, 1);
+    timeSeries_Ref_t stringRef = timeSeries_Create(HEADER_ID, 1, 1);
+    uint8_t* payloadPtr;
+    size_t payloadNumBytes;
+    char string[32];
+    int numSamples;
+    int i;
+
+    LE_TEST_ASSERT((boolRef != NULL) && (stringRef != NULL), "Create bool and string series");
+
+    for (i = 0; i < NUM_SMALL_SAMPLES; i++)
+    {
+        snprintf(string, sizeof(string), "sample %d", i);
+
+        if ((timeSeries_AddBool(boolRef, START_MS + i, (i % 3) == 0) != LE_OK) ||
+            (timeSeries_AddString(stringRef, START_MS + i, string) != LE_OK))
+        {
+            break;
+        }
+    }
+    LE_TEST_OK(i == NUM_SMALL_SAMPLES, "%d bool and string samples added", i);
+
+    LE_TEST_ASSERT(timeSeries_Finish(boolRef, &payloadPtr, &payloadNumBytes) == LE_OK,
+                   "Finish bool series");
+    numSamples = Decode(payloadPtr, payloadNumBytes, 1);
+    LE_TEST_OK(numSamples == NUM_SMALL_SAMPLES, "%d bool samples decoded", numSamples);
+
+    for (i = 0; i < numSamples; i++)
+    {
+        bool value;
+
+        if (!cbor_value_is_boolean(&Samples[i].value) ||
+            (cbor_value_get_boolean(&Samples[i].value, &value) != CborNoError) ||
+            (value != ((i % 3) == 0)) || (Samples[i].timeStamp != START_MS + i))
+        {
+            break;
+        }
+    }
+    LE_TEST_OK(i == numSamples, "Bool samples match up to %d", i);
+
+    LE_TEST_ASSERT(timeSeries_Finish(stringRef, &payloadPtr, &payloadNumBytes) == LE_OK,
+                   "Finish string series");
+    numSamples = Decode(payloadPtr, payloadNumBytes, 1);
+    LE_TEST_OK(numSamples == NUM_SMALL_SAMPLES, "%d string samples decoded", numSamples);
+
+    for (i = 0; i < numSamples; i++)
+    {
+        char value[32];
+        size_t valueNumBytes = sizeof(value);
+
+        snprintf(string, sizeof(string), "sample %d", i);
+
+        if (!cbor_value_is_text_string(&Samples[i].value) ||
+            (cbor_value_copy_text_string(&Samples[i].value, value, &valueNumBytes, NULL) !=
+             CborNoError) ||
+            (strcmp(value, string) != 0) || (Samples[i].timeStamp != START_MS + i))
+        {
+            break;
+        }
+    }
+    LE_TEST_OK(i == numSamples, "String samples match up to %d", i);
+
+    timeSeries_Delete(boolRef);
+    timeSeries_Delete(stringRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Integer series spread over the chunks kept in memory, which are gathered when finished.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestMemoryChunks
+(
+    void
+)
+{
+    timeSeries_Ref_t streamRef = timeSeries_Create(HEADER_ID, 1, 1);
+    uint32_t random = 1;
+    uint8_t* payloadPtr;
+    size_t payloadNumBytes;
+    int i;
+
+    LE_TEST_ASSERT(streamRef != NULL, "Create integer series in memory");
+
+    for (i = 0; i < NUM_MEMORY_SAMPLES; i++)
+    {
+        if (AddRandomInt(streamRef, i, &random) != LE_OK)
+        {
+            break;
+        }
+    }
+    LE_TEST_OK(i == NUM_MEMORY_SAMPLES, "%d integer samples added", i);
+
+    LE_TEST_ASSERT(timeSeries_Finish(streamRef, &payloadPtr, &payloadNumBytes) == LE_OK,
+                   "Finish integer series in memory");
+    LE_TEST_OK((payloadNumBytes > CHUNK_NUMBYTES) && (payloadNumBytes <= MEMORY_MAX_NUMBYTES),
+               "Payload of %zu bytes over several chunks", payloadNumBytes);
+    LE_TEST_OK(CheckIntSamples(Decode(payloadPtr, payloadNumBytes, 1)) == NUM_MEMORY_SAMPLES,
+               "Integer samples decoded");
+
+    timeSeries_Delete(streamRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Integer series filled up: its chunks are spilled to a file, until the file is full too.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestSpill
+(
+    void
+)
+{
+    timeSeries_Ref_t streamRef = timeSeries_Create(HEADER_ID, 1, 1);
+    uint32_t random = 2;
+    uint8_t* payloadPtr;
+    size_t payloadNumBytes;
+    le_result_t result = LE_OK;
+    int numSamples = 0;
+
+    LE_TEST_ASSERT(streamRef != NULL, "Create spilled integer series");
+
+    while ((result == LE_OK) && (numSamples < SAMPLES_MAX))
+    {
+        result = AddRandomInt(streamRef, numSamples, &random);
+
+        // A sample refused with LE_OVERFLOW is not in the stream.
+        if (result != LE_OVERFLOW)
+        {
+            numSamples++;
+        }
+    }
+    LE_TEST_OK((result == LE_NO_MEMORY) || (result == LE_OVERFLOW),
+               "Series full after %d samples (%s)", numSamples, LE_RESULT_TXT(result));
+    LE_TEST_OK(timeSeries_GetNumSamples(streamRef) == (uint32_t)numSamples, "Number of samples");
+
+    LE_TEST_ASSERT(timeSeries_Finish(streamRef, &payloadPtr, &payloadNumBytes) == LE_OK,
+                   "Finish spilled integer series");
+    LE_TEST_OK((payloadNumBytes > MEMORY_MAX_NUMBYTES) &&
+               (payloadNumBytes <= MEMORY_MAX_NUMBYTES + SPILL_MAX_NUMBYTES),
+               "Payload of %zu bytes spilled", payloadNumBytes);
+    LE_TEST_OK(CheckIntSamples(Decode(payloadPtr, payloadNumBytes, 1)) == numSamples,
+               "Spilled integer samples decoded");
+
+    timeSeries_Delete(streamRef);
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    timeSeries_Init();
+
+    TestSmallInt();
+    TestFloat(1);
+    TestFloat(100);
+    TestBoolString();
+    TestMemoryChunks();
+    TestSpill();
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,364 @@
+/**
+ * configTreePerf.c
+ *
+ * Config tree persistence benchmark.  Measures the latency of committing write transactions
+ * against a tree with a realistic number of nodes, and the cost of serializing and parsing the
+ * same tree in the text format, for comparison.  Also measures name lookups in a stem with
+ * thousands of children, and reading and writing an app's settings at startup one value at a time
+ * versus in one batch.
+ *
+ * Run this once with CFGTREE_JOURNAL enabled and once with it disabled to compare the binary
+ * snapshot and journal against the text store.  Boot-time load durations for each tree are
+ * reported by the configTree daemon at DEBUG level.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+// Root of the config tree data used by the benchmark.
+#define TEST_ROOT_NODE     "/configTreePerf/"
+
+// Shape of the bulk data: STEM_COUNT stems of LEAF_COUNT values each.
+#define STEM_COUNT         64
+#define LEAF_COUNT         32
+
+// Number of single-value commits to time.
+#define COMMIT_ITERATIONS  200
+
+// Number of children of the stem used for the lookup test.
+#define LOOKUP_CHILD_COUNT 4000
+
+// Number of lookups to time.
+#define LOOKUP_ITERATIONS  2000
+
+// Number of times the startup settings are read and written.
+#define STARTUP_ITERATIONS 100
+
+// Where the text format export is written.
+#define EXPORT_PATH        "/tmp/configTreePerf.cfg"
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Get the time elapsed since a starting point, in microseconds.
+ */
+// -------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUs
+(
+    le_clk_Time_t startTime  ///< [IN] When the measurement started.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint64_t)elapsed.sec * 1000000 + elapsed.usec;
+}
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Populate the test tree in one transaction, and time the commit.
+ */
+// -------------------------------------------------------------------------------------------------
+static void BulkCommitTest
+(
+    void
+)
+{
+    char path[64];
+
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(TEST_ROOT_NODE);
+
+    for (int stem = 0; stem < STEM_COUNT; stem++)
+    {
+        for (int leaf = 0; leaf < LEAF_COUNT; leaf++)
+        {
+            snprintf(path, sizeof(path), "app%d/setting%d", stem, leaf);
+
+            if (leaf % 2)
+            {
+                le_cfg_SetInt(iterRef, path, stem * LEAF_COUNT + leaf);
+            }
+            else
+            {
+                le_cfg_SetString(iterRef, path, "a reasonably sized configuration string value");
+            }
+        }
+    }
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_cfg_CommitTxn(iterRef);
+
+    LE_TEST_INFO("Bulk commit of %d nodes: %" PRIu64 " us",
+                 STEM_COUNT * LEAF_COUNT,
+                 ElapsedUs(startTime));
+
+    iterRef = le_cfg_CreateReadTxn(TEST_ROOT_NODE);
+    LE_TEST_OK(le_cfg_GetInt(iterRef, "app3/setting5", -1) == 3 * LEAF_COUNT + 5,
+               "Bulk data committed");
+    le_cfg_CancelTxn(iterRef);
+}
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Time a series of single value commits, which is the common case for apps updating their
+ *  settings.
+ */
+// -------------------------------------------------------------------------------------------------
+static void SingleCommitTest
+(
+    void
+)
+{
+    uint64_t totalUs = 0;
+    uint64_t maxUs = 0;
+    char path[64];
+
+    for (int i = 0; i < COMMIT_ITERATIONS; i++)
+    {
+        snprintf(path, sizeof(path), TEST_ROOT_NODE "app%d/setting1", i % STEM_COUNT);
+
+        le_clk_Time_t startTime = le_clk_GetRelativeTime();
+        le_cfg_QuickSetInt(path, i);
+        uint64_t elapsedUs = ElapsedUs(startTime);
+
+        totalUs += elapsedUs;
+
+        if (elapsedUs > maxUs)
+        {
+            maxUs = elapsedUs;
+        }
+    }
+
+    LE_TEST_INFO("QuickSetInt commit latency over %d commits: avg %" PRIu64 " us, max %" PRIu64
+                 " us",
+                 COMMIT_ITERATIONS,
+                 totalUs / COMMIT_ITERATIONS,
+                 maxUs);
+
+    snprintf(path, sizeof(path), TEST_ROOT_NODE "app%d/setting1",
+             (COMMIT_ITERATIONS - 1) % STEM_COUNT);
+    LE_TEST_OK(le_cfg_QuickGetInt(path, -1) == COMMIT_ITERATIONS - 1, "Last commit visible");
+}
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Time writing and parsing the test tree in the text format, as the text store does on every
+ *  commit and on every load.
+ */
+// -------------------------------------------------------------------------------------------------
+static void TextFormatTest
+(
+    void
+)
+{
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(TEST_ROOT_NODE);
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_result_t result = le_cfgAdmin_ExportTree(iterRef, EXPORT_PATH, "");
+
+    LE_TEST_OK(result == LE_OK, "Export tree as text: %s", LE_RESULT_TXT(result));
+    LE_TEST_INFO("Text format write: %" PRIu64 " us", ElapsedUs(startTime));
+
+    startTime = le_clk_GetRelativeTime();
+    result = le_cfgAdmin_ImportTree(iterRef, EXPORT_PATH, "");
+
+    LE_TEST_OK(result == LE_OK, "Import tree from text: %s", LE_RESULT_TXT(result));
+    LE_TEST_INFO("Text format parse: %" PRIu64 " us", ElapsedUs(startTime));
+
+    // Leave the tree as it was.
+    le_cfg_CancelTxn(iterRef);
+}
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Time looking up nodes by name in a stem with a large number of children, as apps keeping a
+ *  node per asset or per message do.
+ */
+// -------------------------------------------------------------------------------------------------
+static void LookupTest
+(
+    void
+)
+{
+    char path[64];
+
+    le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(TEST_ROOT_NODE "large");
+
+    for (int i = 0; i < LOOKUP_CHILD_COUNT; i++)
+    {
+        snprintf(path, sizeof(path), "item%d", i);
+        le_cfg_SetInt(iterRef, path, i);
+    }
+
+    le_cfg_CommitTxn(iterRef);
+
+    iterRef = le_cfg_CreateReadTxn(TEST_ROOT_NODE "large");
+
+    bool isOk = true;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (int i = 0; i < LOOKUP_ITERATIONS; i++)
+    {
+        // Spread the lookups over the whole collection.
+        int item = (i * 7919) % LOOKUP_CHILD_COUNT;
+
+        snprintf(path, sizeof(path), "item%d", item);
+
+        if (le_cfg_GetInt(iterRef, path, -1) != item)
+        {
+            isOk = false;
+        }
+    }
+
+    LE_TEST_INFO("Lookup in a stem of %d children: avg %" PRIu64 " us",
+                 LOOKUP_CHILD_COUNT,
+                 ElapsedUs(startTime) / LOOKUP_ITERATIONS);
+    LE_TEST_OK(isOk, "Lookups found the right nodes");
+
+    le_cfg_CancelTxn(iterRef);
+}
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Time an app reading and writing its settings at startup, once with a quick function call per
+ *  value and once with the batch functions.
+ */
+// -------------------------------------------------------------------------------------------------
+static void StartupBatchTest
+(
+    void
+)
+{
+    le_cfg_BatchItem_t items[LE_CFG_BATCH_MAX];
+    le_cfg_BatchItem_t values[LE_CFG_BATCH_MAX];
+    char path[64];
+
+    memset(items, 0, sizeof(items));
+
+    for (int i = 0; i < LE_CFG_BATCH_MAX; i++)
+    {
+        snprintf(items[i].path, sizeof(items[i].path), "setting%d", i);
+        items[i].type = LE_CFG_TYPE_INT;
+        items[i].intValue = i;
+    }
+
+    // One commit per value.
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (int n = 0; n < STARTUP_ITERATIONS; n++)
+    {
+        for (int i = 0; i < LE_CFG_BATCH_MAX; i++)
+        {
+            snprintf(path, sizeof(path), TEST_ROOT_NODE "startup/%s", items[i].path);
+            le_cfg_QuickSetInt(path, items[i].intValue);
+        }
+    }
+
+    LE_TEST_INFO("Write %d settings with QuickSetInt: avg %" PRIu64 " us",
+                 LE_CFG_BATCH_MAX,
+                 ElapsedUs(startTime) / STARTUP_ITERATIONS);
+
+    // One commit per batch.
+    startTime = le_clk_GetRelativeTime();
+
+    for (int n = 0; n < STARTUP_ITERATIONS; n++)
+    {
+        le_cfg_QuickSetBatch(TEST_ROOT_NODE "startup", items, LE_CFG_BATCH_MAX);
+    }
+
+    LE_TEST_INFO("Write %d settings with QuickSetBatch: avg %" PRIu64 " us",
+                 LE_CFG_BATCH_MAX,
+                 ElapsedUs(startTime) / STARTUP_ITERATIONS);
+
+    // One round trip per value.
+    bool isOk = true;
+    startTime = le_clk_GetRelativeTime();
+
+    for (int n = 0; n < STARTUP_ITERATIONS; n++)
+    {
+        for (int i = 0; i < LE_CFG_BATCH_MAX; i++)
+        {
+            snprintf(path, sizeof(path), TEST_ROOT_NODE "startup/%s", items[i].path);
+
+            if (le_cfg_QuickGetInt(path, -1) != i)
+            {
+                isOk = false;
+            }
+        }
+    }
+
+    LE_TEST_INFO("Read %d settings with QuickGetInt: avg %" PRIu64 " us",
+                 LE_CFG_BATCH_MAX,
+                 ElapsedUs(startTime) / STARTUP_ITERATIONS);
+    LE_TEST_OK(isOk, "Single reads returned the right values");
+
+    // One round trip per batch.  Use -1 as the default so that a missed read is noticed.
+    for (int i = 0; i < LE_CFG_BATCH_MAX; i++)
+    {
+        items[i].intValue = -1;
+    }
+
+    startTime = le_clk_GetRelativeTime();
+
+    for (int n = 0; n < STARTUP_ITERATIONS; n++)
+    {
+        size_t valueCount = LE_CFG_BATCH_MAX;
+
+        le_cfg_QuickGetBatch(TEST_ROOT_NODE "startup",
+                             items,
+                             LE_CFG_BATCH_MAX,
+                             values,
+                             &valueCount);
+
+        if (valueCount != LE_CFG_BATCH_MAX)
+        {
+            isOk = false;
+        }
+    }
+
+    LE_TEST_INFO("Read %d settings with QuickGetBatch: avg %" PRIu64 " us",
+                 LE_CFG_BATCH_MAX,
+                 ElapsedUs(startTime) / STARTUP_ITERATIONS);
+
+    for (int i = 0; i < LE_CFG_BATCH_MAX; i++)
+    {
+        if ((values[i].type != LE_CFG_TYPE_INT) || (values[i].intValue != i))
+        {
+            isOk = false;
+        }
+    }
+
+    LE_TEST_OK(isOk, "Batch reads returned the right values");
+
+    // A missing node gives back the default, and says it doesn't exist.
+    LE_ASSERT(le_utf8_Copy(items[0].path, "missing", sizeof(items[0].path), NULL) == LE_OK);
+
+    size_t valueCount = 1;
+    le_cfg_QuickGetBatch(TEST_ROOT_NODE "startup", items, 1, values, &valueCount);
+
+    LE_TEST_OK((valueCount == 1)
+               && (values[0].type == LE_CFG_TYPE_DOESNT_EXIST)
+               && (values[0].intValue == -1),
+               "Batch read of a missing node returned the default");
+}
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    LE_TEST_INFO("********** Start configTreePerf Test ***********");
+
+    le_cfg_QuickDeleteNode(TEST_ROOT_NODE);
+
+    BulkCommitTest();
+    SingleCommitTest();
+    TextFormatTest();
+    LookupTest();
+    StartupBatchTest();
+
+    le_cfg_QuickDeleteNode(TEST_ROOT_NODE);
+
+    LE_TEST_INFO("============ configTreePerf FINISHED =============");
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,319 @@
+/**
+ * @file networkSocketPerf.c
+ *
+ * Network socket le_comm implementation benchmark.
+ *
+ * Streams frames through a client channel to a receiver that reads slowly from a small socket
+ * buffer, so that the socket is congested most of the time.  Checks that:
+ *  - le_comm_Send() never blocks the event loop, however congested the socket is;
+ *  - data the socket could not take right away is buffered and delivered in order;
+ *  - a full output buffer is reported as LE_NO_MEMORY, after which the sender can back off and
+ *    retry.
+ *
+ * Reports the throughput and the longest time spent in le_comm_Send().
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "le_comm.h"
+
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/// Address and TCP port of the receiver.
+#define RECV_ADDRESS        "127.0.0.1"
+#define RECV_PORT           "54321"
+
+/// Size of the frames sent; not a power of two, so that frames are split across writes.
+#define FRAME_SIZE          1000
+
+/// Receive buffer size of the receiver socket, and size of its reads.
+#define RECV_SOCKET_BUFFER  4096
+#define RECV_CHUNK          2048
+
+/// Pause of the receiver between reads.
+#define RECV_PAUSE_USEC     100
+
+/// Longest time le_comm_Send() may take without being considered blocking.
+#define MAX_SEND_SEC        0.05
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define TOTAL_BYTES      (256 * 1024)
+#else
+#   define TOTAL_BYTES      (4 * 1024 * 1024)
+#endif
+
+/// Channel handle.
+static void* Handle;
+
+/// Sender state.
+static size_t BytesSent;
+static int NumBackoffs;
+static double MaxSendSec;
+static le_clk_Time_t StartTime;
+static le_timer_Ref_t BackoffTimerRef;
+
+/// Receiver state, written by the receiver thread until it signals completion.
+static size_t BytesReceived;
+static size_t NumBadBytes;
+
+/// Main thread, and semaphore posted once the receiver listens.
+static le_thread_Ref_t MainThreadRef;
+static le_sem_Ref_t ListeningSem;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetElapsedSec
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the results, once the receiver got everything.  Runs in the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReceiverDone
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    double elapsedSec = GetElapsedSec(StartTime);
+
+    LE_TEST_OK(BytesReceived == TOTAL_BYTES, "Received %zu of %d bytes",
+               BytesReceived, TOTAL_BYTES);
+    LE_TEST_OK(NumBadBytes == 0, "Data received in order (%zu bad bytes)", NumBadBytes);
+    LE_TEST_OK(MaxSendSec < MAX_SEND_SEC, "Send does not block (longest %.3f ms)",
+               MaxSendSec * 1000.0);
+    LE_TEST_INFO("%.1f KiB/s, %d back-offs on a full output buffer",
+                 (TOTAL_BYTES / 1024.0) / elapsedSec, NumBackoffs);
+
+    le_comm_Delete(Handle);
+
+    LE_TEST_EXIT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receiver thread: a plain blocking TCP server that reads slowly and checks the byte sequence.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ReceiverThread
+(
+    void* contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    struct sockaddr_in sockAddr;
+    uint8_t buffer[RECV_CHUNK];
+    int bufferSize = RECV_SOCKET_BUFFER;
+    int reuse = 1;
+    int listenFd;
+    int fd;
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    LE_TEST_ASSERT(listenFd >= 0, "Create receiver socket");
+
+    // Small buffer, inherited by the accepted socket, so the sender soon gets congested
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    setsockopt(listenFd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sin_family = AF_INET;
+    sockAddr.sin_addr.s_addr = inet_addr(RECV_ADDRESS);
+    sockAddr.sin_port = htons(atoi(RECV_PORT));
+
+    LE_TEST_ASSERT(bind(listenFd, (struct sockaddr*) &sockAddr, sizeof(sockAddr)) == 0,
+                   "Bind receiver socket");
+    LE_TEST_ASSERT(listen(listenFd, 1) == 0, "Listen on receiver socket");
+    le_sem_Post(ListeningSem);
+
+    fd = accept(listenFd, NULL, NULL);
+    LE_TEST_ASSERT(fd >= 0, "Accept connection");
+    close(listenFd);
+
+    while (BytesReceived < TOTAL_BYTES)
+    {
+        ssize_t len = read(fd, buffer, sizeof(buffer));
+        ssize_t i;
+
+        if (len <= 0)
+        {
+            if ((len < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            break;
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            if (buffer[i] != (uint8_t)(BytesReceived + i))
+            {
+                NumBadBytes++;
+            }
+        }
+        BytesReceived += len;
+
+        usleep(RECV_PAUSE_USEC);
+    }
+
+    close(fd);
+
+    le_event_QueueFunctionToThread(MainThreadRef, ReceiverDone, NULL, NULL);
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send frames until everything is sent, or the output buffer is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendFrames
+(
+    void
+)
+{
+    uint8_t frame[FRAME_SIZE];
+
+    while (BytesSent < TOTAL_BYTES)
+    {
+        size_t len = TOTAL_BYTES - BytesSent;
+        size_t i;
+        le_clk_Time_t sendStartTime;
+        double sendSec;
+        le_result_t result;
+
+        if (len > sizeof(frame))
+        {
+            len = sizeof(frame);
+        }
+        for (i = 0; i < len; i++)
+        {
+            frame[i] = (uint8_t)(BytesSent + i);
+        }
+
+        sendStartTime = le_clk_GetRelativeTime();
+        result = le_comm_Send(Handle, frame, len);
+        sendSec = GetElapsedSec(sendStartTime);
+        if (sendSec > MaxSendSec)
+        {
+            MaxSendSec = sendSec;
+        }
+
+        if (result == LE_NO_MEMORY)
+        {
+            // Nothing was taken - back off, and send the same frame again
+            NumBackoffs++;
+            le_timer_Start(BackoffTimerRef);
+            return;
+        }
+        LE_TEST_ASSERT(result == LE_OK, "Send frame at offset %zu (%s)",
+                       BytesSent, LE_RESULT_TXT(result));
+
+        BytesSent += len;
+    }
+
+    LE_TEST_INFO("All %d bytes handed over in %.3f s", TOTAL_BYTES, GetElapsedSec(StartTime));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Back-off timer handler: retry sending.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BackoffTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    LE_UNUSED(timerRef);
+
+    SendFrames();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive handler: the receiver never writes, so only errors and hang-ups are expected.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecvHandler
+(
+    void* handle,   ///< [IN] Channel handle.
+    short events    ///< [IN] Events.
+)
+{
+    LE_UNUSED(handle);
+
+    LE_TEST_OK(!(events & POLLERR), "No error on the channel (events 0x%hX)", events);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Connection handler: start sending once connected.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ConnectionHandler
+(
+    void* handle,   ///< [IN] Channel handle.
+    short events    ///< [IN] Events.
+)
+{
+    LE_TEST_ASSERT(!(events & (POLLERR | POLLHUP)), "Connect to receiver");
+    LE_TEST_ASSERT(le_comm_RegisterHandleMonitor(handle, RecvHandler,
+                                                 POLLIN | POLLRDHUP | POLLERR) == LE_OK,
+                   "Register receive handler");
+
+    StartTime = le_clk_GetRelativeTime();
+    SendFrames();
+}
+
+
+COMPONENT_INIT
+{
+    const char* argv[] = { RECV_ADDRESS, RECV_PORT };
+    le_result_t result;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("Network socket transport benchmark");
+
+    MainThreadRef = le_thread_GetCurrent();
+    ListeningSem = le_sem_Create("listening", 0);
+
+    BackoffTimerRef = le_timer_Create("backoff");
+    le_timer_SetMsInterval(BackoffTimerRef, 1);
+    le_timer_SetHandler(BackoffTimerRef, BackoffTimerHandler);
+
+    le_thread_Start(le_thread_Create("receiver", ReceiverThread, NULL));
+    le_sem_Wait(ListeningSem);
+
+    Handle = le_comm_Create(NUM_ARRAY_MEMBERS(argv), argv, &result);
+    LE_TEST_ASSERT(result == LE_OK, "Create channel");
+    LE_TEST_ASSERT(le_comm_RegisterHandleMonitor(Handle, ConnectionHandler, 0x00) == LE_OK,
+                   "Register connection handler");
+
+    result = le_comm_Connect(Handle);
+    LE_TEST_ASSERT((result == LE_OK) || (result == LE_IN_PROGRESS), "Connect channel");
+}
@@ -0,0 +1,404 @@
+/**
+ * @file rpcProxyPerf.c
+ *
+ * RPC Proxy transport benchmark, over the local loopback le_comm implementation.
+ *
+ * Sends RPC Proxy style messages (a header followed by a payload) through the loopback, and
+ * measures the message rate when:
+ *  - the header and payload are first copied into one buffer and sent with le_comm_Send(), as the
+ *    RPC Proxy does when a message must be repacked;
+ *  - the header and payload are sent from where they are with le_comm_SendV();
+ *  - the payload is also compressed;
+ *  - several small messages are coalesced into one frame, as the RPC Proxy does with the messages
+ *    sent to a system during one pass of the event loop.
+ *
+ * Also checks the compression codec round-trip, and reports its ratio and throughput on a few
+ * kinds of payload.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "le_comm.h"
+#include "le_rpcProxyCompress.h"
+
+/// Size of the message payloads.
+#define MSG_SIZE            512
+
+/// Size of the small message payloads, and number of small messages coalesced into one frame.
+#define SMALL_MSG_SIZE      48
+#define COALESCE_COUNT      16
+
+/// Flag set in the message type for compressed payloads.
+#define COMPRESSED_FLAG     0x80
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_MESSAGES     500
+#else
+#   define NUM_MESSAGES     20000
+#endif
+
+/// Message header, as sent by the RPC Proxy.
+typedef struct __attribute__((packed))
+{
+    uint32_t id;
+    uint32_t serviceId;
+    uint8_t  type;
+    uint16_t msgSize;
+}
+Header_t;
+
+/// Payload sent by the current run.
+static uint8_t Payload[MSG_SIZE];
+static size_t PayloadSize = MSG_SIZE;
+
+/// Buffers used by the sender.
+static uint8_t SendBuffer[sizeof(Header_t) + MSG_SIZE];
+static uint8_t CoalesceBuffer[COALESCE_COUNT * (sizeof(Header_t) + SMALL_MSG_SIZE)];
+static uint8_t CompressBuffer[MSG_SIZE];
+
+/// Buffers used by the receiver.
+static uint8_t RecvBuffer[MSG_SIZE];
+static uint8_t DecompressBuffer[MSG_SIZE];
+
+/// Receiver statistics.
+static int NumReceived;
+static int NumBad;
+
+/// Loopback handle.
+static void* Handle;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetElapsedSec
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill the payload with data resembling a telemetry message: tagged fields with slowly changing
+ * values.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillTelemetry
+(
+    void
+)
+{
+    size_t len = 0;
+    int i = 0;
+
+    while (len < MSG_SIZE)
+    {
+        char field[64];
+        int fieldLen = snprintf(field, sizeof(field), "sensor.%d.value=%d.%d;",
+                                i % 8, 20 + (i % 3), i % 10);
+        size_t copyLen = ((size_t)fieldLen < (MSG_SIZE - len)) ? (size_t)fieldLen :
+                                                                 (MSG_SIZE - len);
+
+        memcpy(Payload + len, field, copyLen);
+        len += copyLen;
+        i++;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive handler: reads every complete message from the loopback and checks its payload.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecvHandler
+(
+    void* handle,   ///< [IN] Loopback handle.
+    short events    ///< [IN] Events.
+)
+{
+    LE_UNUSED(events);
+
+    for (;;)
+    {
+        Header_t header;
+        size_t len = sizeof(header);
+        size_t msgSize;
+        const uint8_t* dataPtr = RecvBuffer;
+
+        if ((le_comm_Receive(handle, &header, &len) != LE_OK) || (len == 0))
+        {
+            return;
+        }
+        if (len != sizeof(header))
+        {
+            NumBad++;
+            return;
+        }
+
+        msgSize = be16toh(header.msgSize);
+        len = msgSize;
+        if ((msgSize > sizeof(RecvBuffer)) ||
+            (le_comm_Receive(handle, RecvBuffer, &len) != LE_OK) ||
+            (len != msgSize))
+        {
+            NumBad++;
+            return;
+        }
+
+        if (header.type & COMPRESSED_FLAG)
+        {
+            len = sizeof(DecompressBuffer);
+            if (rpcProxyCompress_Decompress(RecvBuffer, msgSize, DecompressBuffer, &len) != LE_OK)
+            {
+                NumBad++;
+                continue;
+            }
+            dataPtr = DecompressBuffer;
+        }
+
+        if ((len != PayloadSize) || (memcmp(dataPtr, Payload, len) != 0))
+        {
+            NumBad++;
+        }
+        NumReceived++;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send messages through the loopback and report the message rate.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunTransport
+(
+    const char* desc,   ///< [IN] Description of the run.
+    bool gather,        ///< [IN] Send the header and payload with le_comm_SendV().
+    bool compress       ///< [IN] Compress the payload.
+)
+{
+    le_clk_Time_t startTime;
+    double elapsedSec;
+    size_t wireBytes = 0;
+    int i;
+
+    NumReceived = 0;
+    NumBad = 0;
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_MESSAGES; i++)
+    {
+        Header_t header;
+        const uint8_t* dataPtr = Payload;
+        size_t dataSize = PayloadSize;
+        le_result_t result;
+
+        header.id = htobe32(i);
+        header.serviceId = htobe32(1);
+        header.type = 4;
+
+        if (compress)
+        {
+            size_t compressedSize = rpcProxyCompress_Compress(Payload, PayloadSize,
+                                                              CompressBuffer,
+                                                              sizeof(CompressBuffer));
+            if (compressedSize > 0)
+            {
+                header.type |= COMPRESSED_FLAG;
+                dataPtr = CompressBuffer;
+                dataSize = compressedSize;
+            }
+        }
+        header.msgSize = htobe16((uint16_t)dataSize);
+
+        if (gather)
+        {
+            le_comm_IoVec_t iov[2] =
+            {
+                { .bufPtr = &header, .len = sizeof(header) },
+                { .bufPtr = dataPtr, .len = dataSize }
+            };
+
+            result = le_comm_SendV(Handle, iov, 2);
+        }
+        else
+        {
+            memcpy(SendBuffer, &header, sizeof(header));
+            memcpy(SendBuffer + sizeof(header), dataPtr, dataSize);
+            result = le_comm_Send(Handle, SendBuffer, sizeof(header) + dataSize);
+        }
+
+        if (result != LE_OK)
+        {
+            NumBad++;
+        }
+        wireBytes += sizeof(header) + dataSize;
+    }
+    elapsedSec = GetElapsedSec(startTime);
+
+    LE_TEST_OK((NumReceived == NUM_MESSAGES) && (NumBad == 0),
+               "%s: %d messages received intact (%d bad)", desc, NumReceived, NumBad);
+    LE_TEST_INFO("%s: %.0f messages/s, %.1f wire bytes/message", desc,
+                 NUM_MESSAGES / elapsedSec, (double)wireBytes / NUM_MESSAGES);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send small messages through the loopback, either one per write or coalesced several to a frame,
+ * and report the message rate.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunCoalesce
+(
+    const char* desc,   ///< [IN] Description of the run.
+    int count           ///< [IN] Number of messages per frame.
+)
+{
+    le_clk_Time_t startTime;
+    double elapsedSec;
+    size_t len = 0;
+    int i;
+
+    PayloadSize = SMALL_MSG_SIZE;
+    NumReceived = 0;
+    NumBad = 0;
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_MESSAGES; i++)
+    {
+        Header_t header;
+
+        header.id = htobe32(i);
+        header.serviceId = htobe32(1);
+        header.type = 4;
+        header.msgSize = htobe16((uint16_t)PayloadSize);
+
+        memcpy(CoalesceBuffer + len, &header, sizeof(header));
+        memcpy(CoalesceBuffer + len + sizeof(header), Payload, PayloadSize);
+        len += sizeof(header) + PayloadSize;
+
+        if ((((i + 1) % count) == 0) || (i == (NUM_MESSAGES - 1)))
+        {
+            if (le_comm_Send(Handle, CoalesceBuffer, len) != LE_OK)
+            {
+                NumBad++;
+            }
+            len = 0;
+        }
+    }
+    elapsedSec = GetElapsedSec(startTime);
+
+    LE_TEST_OK((NumReceived == NUM_MESSAGES) && (NumBad == 0),
+               "%s: %d messages received intact (%d bad)", desc, NumReceived, NumBad);
+    LE_TEST_INFO("%s: %.0f messages/s, %d writes", desc, NUM_MESSAGES / elapsedSec,
+                 (NUM_MESSAGES + count - 1) / count);
+
+    PayloadSize = MSG_SIZE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the codec round-trip on the current payload, and report its ratio and throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunCodec
+(
+    const char* desc    ///< [IN] Description of the payload.
+)
+{
+    le_clk_Time_t startTime;
+    double compressSec, decompressSec;
+    size_t compressedSize = 0;
+    size_t len = sizeof(DecompressBuffer);
+    le_result_t result = LE_OK;
+    int i;
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_MESSAGES; i++)
+    {
+        compressedSize = rpcProxyCompress_Compress(Payload, sizeof(Payload),
+                                                   CompressBuffer, sizeof(CompressBuffer));
+    }
+    compressSec = GetElapsedSec(startTime);
+
+    if (compressedSize == 0)
+    {
+        LE_TEST_INFO("%s: not compressible, would be sent as is", desc);
+        return;
+    }
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; (i < NUM_MESSAGES) && (result == LE_OK); i++)
+    {
+        len = sizeof(DecompressBuffer);
+        result = rpcProxyCompress_Decompress(CompressBuffer, compressedSize,
+                                             DecompressBuffer, &len);
+    }
+    decompressSec = GetElapsedSec(startTime);
+
+    LE_TEST_OK((result == LE_OK) && (len == sizeof(Payload)) &&
+               (memcmp(DecompressBuffer, Payload, len) == 0), "%s: round-trip", desc);
+    LE_TEST_INFO("%s: %" PRIuS " -> %" PRIuS " bytes, compress %.1f MB/s, decompress %.1f MB/s",
+                 desc, sizeof(Payload), compressedSize,
+                 (NUM_MESSAGES * sizeof(Payload)) / (compressSec * 1000000.0),
+                 (NUM_MESSAGES * sizeof(Payload)) / (decompressSec * 1000000.0));
+
+    len = sizeof(Payload) / 2;
+    LE_TEST_OK(rpcProxyCompress_Decompress(CompressBuffer, compressedSize,
+                                           DecompressBuffer, &len) == LE_OVERFLOW,
+               "%s: overflow detected", desc);
+    len = sizeof(DecompressBuffer);
+    result = rpcProxyCompress_Decompress(CompressBuffer, compressedSize - 1,
+                                         DecompressBuffer, &len);
+    LE_TEST_OK((result != LE_OK) || (len != sizeof(Payload)), "%s: truncation detected", desc);
+}
+
+
+COMPONENT_INIT
+{
+    const char* argv[] = { NULL };
+    le_result_t result;
+    size_t i;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("RPC Proxy transport benchmark");
+
+    LE_TEST_ASSERT(le_comm_SendV != NULL, "le_comm_SendV() is implemented");
+    Handle = le_comm_Create(0, argv, &result);
+    LE_TEST_ASSERT(result == LE_OK, "Create loopback");
+    LE_TEST_ASSERT(le_comm_RegisterHandleMonitor(Handle, RecvHandler, POLLIN) == LE_OK,
+                   "Register receive handler");
+    LE_TEST_ASSERT(le_comm_Connect(Handle) == LE_OK, "Connect loopback");
+
+    // Codec
+    FillTelemetry();
+    RunCodec("Telemetry");
+    memset(Payload, 0, sizeof(Payload));
+    RunCodec("Zeros");
+    for (i = 0; i < sizeof(Payload); i++)
+    {
+        Payload[i] = (uint8_t)rand();
+    }
+    RunCodec("Random");
+
+    // Transport
+    FillTelemetry();
+    RunTransport("Copy + send", false, false);
+    RunTransport("Scatter/gather send", true, false);
+    RunTransport("Compressed scatter/gather send", true, true);
+    RunCoalesce("Small messages, one per write", 1);
+    RunCoalesce("Small messages, coalesced", COALESCE_COUNT);
+
+    LE_TEST_EXIT;
+}
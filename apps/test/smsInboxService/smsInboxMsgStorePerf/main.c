@@ -0,0 +1,332 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file main.c
+ *
+ * SMS Inbox message store benchmark.
+ *
+ * Fills a message store with NUM_MSGS messages held in two message boxes, then marks them read,
+ * browses and reads them, deletes half of them, reopens the store from its index snapshot and
+ * from its log alone, and compacts it.  Checks the store content after each step and reports the
+ * time taken by each of them.  Then reopens the store with its message boxes swapped, and with one
+ * of them removed, and checks that the messages follow their message box.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "msgStore.h"
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_MSGS             1000
+#else
+#   define NUM_MSGS             10000
+#endif
+
+/// Size of the message bodies, close to a text SMS with its sender and timestamp.
+#define BODY_BYTES              220
+
+/// Message boxes the messages are stored in.
+#define MBOX_A                  0
+#define MBOX_B                  1
+#define MBOX_MASK               ((1u << MBOX_A) | (1u << MBOX_B))
+
+/// Names of the message boxes, by bit.
+static const char* const MboxNames[] = { "boxA", "boxB" };
+static const char* const SwappedMboxNames[] = { "boxB", "boxA" };
+static const char* const RemovedMboxNames[] = { NULL, "boxA" };
+
+/// Index snapshot file, as named by the message store.
+#define INDEX_FILE_NAME         "msg.idx"
+
+/// Directory of the store, ending with a '/'.
+static char StorePath[PATH_MAX];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetElapsedSec
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the rate of a step.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportRate
+(
+    const char* stepPtr,        ///< [IN] Step name.
+    int count,                  ///< [IN] Number of operations done.
+    le_clk_Time_t startTime     ///< [IN] Start time of the step.
+)
+{
+    double sec = GetElapsedSec(startTime);
+
+    LE_TEST_INFO("%s: %d in %.3f s (%.0f/s)", stepPtr, count, sec, sec > 0 ? count / sec : 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the body of message msgId.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MakeBody
+(
+    uint32_t msgId,             ///< [IN] Message identifier.
+    uint8_t* bodyPtr            ///< [OUT] Body, BODY_BYTES long.
+)
+{
+    int i;
+
+    for (i = 0; i < BODY_BYTES; i++)
+    {
+        bodyPtr[i] = (uint8_t)(msgId * 31 + i);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count the messages of a message box by browsing it, checking they come in increasing order.
+ *
+ * @return Number of messages, -1 if they are out of order.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Browse
+(
+    uint32_t mboxIdx            ///< [IN] Message box.
+)
+{
+    uint32_t cursor = 0;
+    uint32_t prevId = 0;
+    uint32_t msgId;
+    int count = 0;
+
+    while ((msgId = msgStore_GetNext(mboxIdx, &cursor)) != 0)
+    {
+        if (msgId <= prevId)
+        {
+            LE_TEST_INFO("Message %" PRIu32 " after %" PRIu32, msgId, prevId);
+            return -1;
+        }
+        prevId = msgId;
+        count++;
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reopen the store and check its content.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Reopen
+(
+    const char* stepPtr,        ///< [IN] Step name.
+    int expectedCount           ///< [IN] Number of messages expected in each message box.
+)
+{
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    LE_TEST_ASSERT(msgStore_Open(StorePath, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "%s: open store", stepPtr);
+    ReportRate(stepPtr, expectedCount, startTime);
+
+    LE_TEST_OK(msgStore_GetCount(MBOX_A) == (uint32_t)expectedCount,
+               "%s: %" PRIu32 " messages in box A", stepPtr, msgStore_GetCount(MBOX_A));
+    LE_TEST_OK(Browse(MBOX_B) == expectedCount, "%s: browse box B", stepPtr);
+}
+
+
+COMPONENT_INIT
+{
+    uint8_t body[BODY_BYTES];
+    uint8_t expectedBody[BODY_BYTES];
+    char indexPath[PATH_MAX];
+    le_clk_Time_t startTime;
+    size_t logSize;
+    size_t deadSize;
+    uint32_t inboxMask;
+    uint32_t unreadMask;
+    uint32_t msgId;
+    int count;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("SMS Inbox message store benchmark, %d messages", NUM_MSGS);
+
+    snprintf(StorePath, sizeof(StorePath), "/tmp/smsInboxPerfXXXXXX");
+    LE_TEST_ASSERT(mkdtemp(StorePath) != NULL, "Create store directory");
+    strcat(StorePath, "/");
+    snprintf(indexPath, sizeof(indexPath), "%s" INDEX_FILE_NAME, StorePath);
+
+    LE_TEST_ASSERT(msgStore_Open(StorePath, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "Open store");
+
+    // Add: one synced append per message
+    startTime = le_clk_GetRelativeTime();
+    count = 0;
+    for (msgId = 1; msgId <= NUM_MSGS; msgId++)
+    {
+        MakeBody(msgId, body);
+        if (msgStore_Add(msgId, MBOX_MASK, MBOX_MASK, body, sizeof(body)) == LE_OK)
+        {
+            count++;
+        }
+    }
+    ReportRate("Add", NUM_MSGS, startTime);
+    LE_TEST_ASSERT(count == NUM_MSGS, "%d messages added", count);
+
+    LE_TEST_OK(msgStore_GetLatestId() == NUM_MSGS, "Latest message %" PRIu32,
+               msgStore_GetLatestId());
+    LE_TEST_OK(msgStore_Add(1, MBOX_MASK, 0, body, sizeof(body)) == LE_DUPLICATE,
+               "Duplicate message rejected");
+
+    // Mark read in box A
+    startTime = le_clk_GetRelativeTime();
+    count = 0;
+    for (msgId = 1; msgId <= NUM_MSGS; msgId++)
+    {
+        if (msgStore_SetFlags(msgId, MBOX_MASK, 1u << MBOX_B) == LE_OK)
+        {
+            count++;
+        }
+    }
+    ReportRate("Mark read", NUM_MSGS, startTime);
+    LE_TEST_ASSERT(count == NUM_MSGS, "%d messages marked read", count);
+
+    LE_TEST_OK(msgStore_GetFlags(NUM_MSGS / 2, &inboxMask, &unreadMask) == LE_OK &&
+               inboxMask == MBOX_MASK && unreadMask == (1u << MBOX_B), "Flags updated");
+
+    // Browse
+    startTime = le_clk_GetRelativeTime();
+    count = Browse(MBOX_A);
+    ReportRate("Browse", count, startTime);
+    LE_TEST_OK(count == NUM_MSGS, "%d messages browsed", count);
+
+    // Read
+    startTime = le_clk_GetRelativeTime();
+    count = 0;
+    for (msgId = 1; msgId <= NUM_MSGS; msgId++)
+    {
+        size_t size = sizeof(body);
+
+        MakeBody(msgId, expectedBody);
+        if ((msgStore_Read(msgId, body, &size) == LE_OK) && (size == sizeof(body)) &&
+            (memcmp(body, expectedBody, size) == 0))
+        {
+            count++;
+        }
+    }
+    ReportRate("Read", NUM_MSGS, startTime);
+    LE_TEST_OK(count == NUM_MSGS, "%d messages read back", count);
+
+    // Delete every other message from both boxes
+    startTime = le_clk_GetRelativeTime();
+    count = 0;
+    for (msgId = 2; msgId <= NUM_MSGS; msgId += 2)
+    {
+        if (msgStore_SetFlags(msgId, 0, 0) == LE_OK)
+        {
+            count++;
+        }
+    }
+    ReportRate("Delete", NUM_MSGS / 2, startTime);
+    LE_TEST_ASSERT(count == NUM_MSGS / 2, "%d messages deleted", count);
+
+    LE_TEST_OK(msgStore_GetFlags(2, &inboxMask, &unreadMask) == LE_NOT_FOUND, "Message deleted");
+    LE_TEST_OK(msgStore_GetCount(MBOX_A) == NUM_MSGS / 2, "%" PRIu32 " messages left",
+               msgStore_GetCount(MBOX_A));
+
+    msgStore_GetLogSize(&logSize, &deadSize);
+    LE_TEST_INFO("Log: %zu bytes, %zu reclaimable", logSize, deadSize);
+
+    // Reopen from the index snapshot, then from the log alone
+    msgStore_Close();
+    Reopen("Reopen from snapshot", NUM_MSGS / 2);
+
+    msgStore_Close();
+    LE_TEST_ASSERT(unlink(indexPath) == 0, "Remove index snapshot");
+    Reopen("Reopen from log", NUM_MSGS / 2);
+
+    // Compact
+    startTime = le_clk_GetRelativeTime();
+    LE_TEST_OK(msgStore_Compact() == LE_OK, "Compact");
+    ReportRate("Compact", NUM_MSGS / 2, startTime);
+
+    msgStore_GetLogSize(&logSize, &deadSize);
+    LE_TEST_INFO("Log: %zu bytes, %zu reclaimable", logSize, deadSize);
+    LE_TEST_OK(deadSize == 0, "Nothing left to reclaim");
+
+    LE_TEST_OK(msgStore_GetFlags(1, &inboxMask, &unreadMask) == LE_OK &&
+               inboxMask == MBOX_MASK && unreadMask == (1u << MBOX_B), "Flags kept");
+
+    msgStore_Close();
+    Reopen("Reopen compacted", NUM_MSGS / 2);
+
+    // Swap the message boxes: the flags follow their names
+    msgStore_Close();
+    startTime = le_clk_GetRelativeTime();
+    LE_TEST_ASSERT(msgStore_Open(StorePath, SwappedMboxNames,
+                                 NUM_ARRAY_MEMBERS(SwappedMboxNames)) == LE_OK,
+                   "Open with swapped message boxes");
+    ReportRate("Reopen swapped", NUM_MSGS / 2, startTime);
+
+    LE_TEST_OK(msgStore_GetFlags(1, &inboxMask, &unreadMask) == LE_OK &&
+               inboxMask == MBOX_MASK && unreadMask == (1u << MBOX_A),
+               "Unread flag moved with box B");
+
+    // Remove box B: its messages are dropped, box A keeps its own
+    msgStore_Close();
+    LE_TEST_ASSERT(msgStore_Open(StorePath, RemovedMboxNames,
+                                 NUM_ARRAY_MEMBERS(RemovedMboxNames)) == LE_OK,
+                   "Open with box B removed");
+
+    LE_TEST_OK(msgStore_GetFlags(1, &inboxMask, &unreadMask) == LE_OK &&
+               inboxMask == (1u << MBOX_B) && unreadMask == 0, "Box B flags dropped");
+    LE_TEST_OK(msgStore_GetCount(MBOX_A) == 0, "%" PRIu32 " messages in unused bit",
+               msgStore_GetCount(MBOX_A));
+    LE_TEST_OK(Browse(MBOX_B) == NUM_MSGS / 2, "Box A browsed from its new bit");
+
+    msgStore_GetLogSize(&logSize, &deadSize);
+    LE_TEST_OK(deadSize == 0, "Log rewritten with the new message boxes");
+
+    // Reopen with the same names: nothing to remap
+    msgStore_Close();
+    LE_TEST_ASSERT(msgStore_Open(StorePath, RemovedMboxNames,
+                                 NUM_ARRAY_MEMBERS(RemovedMboxNames)) == LE_OK,
+                   "Reopen with box B removed");
+    LE_TEST_OK(Browse(MBOX_B) == NUM_MSGS / 2, "Box A kept");
+
+    // Empty both boxes
+    for (msgId = 1; msgId <= NUM_MSGS; msgId += 2)
+    {
+        msgStore_SetFlags(msgId, 0, 0);
+    }
+    LE_TEST_OK(Browse(MBOX_A) == 0 && Browse(MBOX_B) == 0, "Message boxes empty");
+
+    msgStore_Close();
+
+    LE_TEST_INFO("Remove %s", StorePath);
+    char command[PATH_MAX + 16];
+    snprintf(command, sizeof(command), "rm -rf %s", StorePath);
+    LE_TEST_OK(system(command) == 0, "Remove store directory");
+
+    LE_TEST_EXIT;
+}
@@ -20,22 +20,12 @@
 
 #include "limit.h"
 #include "assetData.h"
+#include "timeSeries.h"
 #include "le_print.h"
 
 // For htonl
 #include <arpa/inet.h>
 
-#if FEATURE_TIMESERIES
-#   error "This time series implementation is obsolete"
-#endif
-
-#if FEATURE_TIMESERIES
-
-#include "cbor.h"
-#include "zlib.h"
-
-#endif
-
 //--------------------------------------------------------------------------------------------------
 // Macros
 //--------------------------------------------------------------------------------------------------
@@ -62,33 +52,6 @@
 #define STRING_VALUE_NUMBYTES 256
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Maximum number of bytes for CBOR encoded time series data
- */
-//--------------------------------------------------------------------------------------------------
-#define MAX_CBOR_BUFFER_NUMBYTES 1024
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Checks the return value from the tinyCBOR encoder and returns from function if an error is found.
- */
-//--------------------------------------------------------------------------------------------------
-#if FEATURE_TIMESERIES
-
-#define \
-    RETURN_IF_CBOR_ERROR( err ) \
-    ({ \
-        if (err != CborNoError) \
-        { \
-            LE_ERROR("CBOR encoding error %s", cbor_error_string(err)); \
-            return LE_FAULT; \
-        } \
-    })
-
-#endif
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Supported data types.  (Not all LWM2M types are listed yet)
@@ -157,38 +120,6 @@ typedef struct le_avdata_AssetInstance
 InstanceData_t;
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Data contained in time series
- */
-//--------------------------------------------------------------------------------------------------
-typedef struct
-{
-    uint8_t* bufferPtr;             ///< Buffer for accumulating history data.
-    size_t bufferSize;              ///< Buffer size of history data.
-
-#if FEATURE_TIMESERIES
-    double timeStampFactor;         ///< Factor of time stamp.
-    uint64_t prevTimeStamp;         ///< Time stamp of last data capture, used for delta encoding.
-
-    double factor;                  ///< Factor of data.
-    union
-    {
-        int prevIntValue;           ///< Value of of last data capture - used for delta encoding.
-        double prevFloatValue;      ///< Value of last data capture - used for delta encoding.
-    };
-
-    uint32_t numElements;           ///< Number of elements in cbor encoded stream.
-
-    CborEncoder streamRef;          ///< CBOR encoded stream reference.
-    CborEncoder mapRef;             ///< CBOR encoded map reference.
-    CborEncoder sampleRef;          ///< CBOR encoded sample data reference.
-#endif
-}
-TimeSeriesData_t;
-
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Data contained in a single field of an asset instance
@@ -212,7 +143,7 @@ typedef struct
         char* strValuePtr;
     };
 
-    TimeSeriesData_t* timeSeriesPtr;
+    timeSeries_Ref_t timeSeriesRef;     ///< Time series recorded on this field, NULL if none
 
     le_dls_Link_t link;          ///< For adding to the field list
 }
@@ -335,22 +266,6 @@ static le_hashmap_Ref_t AssetMapByName = NULL;
 static le_timer_Ref_t RegUpdateTimerRef;
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Time series data memory pool.  Initialized in assetData_Init().
- */
-//--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t TimeSeriesDataPoolRef = NULL;
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * CBOR buffer memory pool.  Initialized in assetData_Init().
- */
-//--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t CborBufferPoolRef = NULL;
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Table mapping data type strings to DataType_t values
@@ -564,7 +479,7 @@ static void InitDefaultFieldData
     fieldDataPtr->isObserve = false;
     fieldDataPtr->readCallBackOpRef = NULL;
 
-    fieldDataPtr->timeSeriesPtr = NULL;
+    fieldDataPtr->timeSeriesRef = NULL;
 
     switch ( fieldDataPtr->type )
     {
@@ -1315,11 +1230,7 @@ static le_result_t StartTimeSeries
 
     le_result_t result;
     FieldData_t* fieldDataPtr;
-    uint8_t* timeSeriesBufferPtr;
     char headerId[64];
-    CborError err;
-    CborEncoder headerArray;
-    CborEncoder factorArray;
 
     result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
     if ( result != LE_OK )
@@ -1329,7 +1240,7 @@ static le_result_t StartTimeSeries
     }
 
     // Is time series enabled on this field.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         LE_ERROR("Time series already enabled on this field.");
         return LE_BUSY;
@@ -1341,78 +1252,11 @@ static le_result_t StartTimeSeries
                  instanceRef->instanceId,
                  fieldId);
 
-    fieldDataPtr->timeSeriesPtr = le_mem_ForceAlloc(TimeSeriesDataPoolRef);
-
-    memset(fieldDataPtr->timeSeriesPtr, 0, sizeof(TimeSeriesData_t));
-
-    timeSeriesBufferPtr = le_mem_ForceAlloc(CborBufferPoolRef);
-    fieldDataPtr->timeSeriesPtr->bufferPtr = timeSeriesBufferPtr;
-
-    fieldDataPtr->timeSeriesPtr->bufferSize = MAX_CBOR_BUFFER_NUMBYTES;
-
-    // Initialize CBOR stream.
-    cbor_encoder_init(&fieldDataPtr->timeSeriesPtr->streamRef,
-                      timeSeriesBufferPtr,
-                      MAX_CBOR_BUFFER_NUMBYTES,
-                      0);
-
-    err = cbor_encoder_create_map(&fieldDataPtr->timeSeriesPtr->streamRef,
-                                  &fieldDataPtr->timeSeriesPtr->mapRef,
-                                  NUM_TIME_SERIES_MAPS);
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Create a map and add the header in to the map.
-    err = cbor_encode_text_stringz(&fieldDataPtr->timeSeriesPtr->mapRef, "h");
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Create an array for the header.
-    err = cbor_encoder_create_array(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                    &headerArray,
-                                    1);
-    RETURN_IF_CBOR_ERROR(err);
-
-    err = cbor_encode_text_string(&headerArray, headerId, strlen(headerId));
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Close the heade map i.e done with entering in to header array.
-    // e.g. "h" : [/1000/0]  --> map for header.
-    cbor_encoder_close_container(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                 &headerArray);
-
-    // Create a map for factor.
-    // e.g. "f" : [1]  --> map for factor.
-    err = cbor_encode_text_stringz(&fieldDataPtr->timeSeriesPtr->mapRef, "f");
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Create an array of factors (time stamp factor, data factor)
-    err = cbor_encoder_create_array(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                    &factorArray,
-                                    2);
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Add factor for time stamp.
-    err = cbor_encode_double(&factorArray, timeStampFactor);
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Add factor for sample.
-    err = cbor_encode_double(&factorArray, factor);
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Close the map i.e done with entering in to factor array.
-    cbor_encoder_close_container(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                 &factorArray);
-
-    // Create an array for samples. The sample array will have time stamp and data pair.
-    err = cbor_encode_text_stringz(&fieldDataPtr->timeSeriesPtr->mapRef, "s");
-    RETURN_IF_CBOR_ERROR(err);
-
-    err = cbor_encoder_create_array(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                    &fieldDataPtr->timeSeriesPtr->sampleRef,
-                                    CborIndefiniteLength);
-    RETURN_IF_CBOR_ERROR(err);
-
-    fieldDataPtr->timeSeriesPtr->factor = factor;
-    fieldDataPtr->timeSeriesPtr->timeStampFactor = timeStampFactor;
+    fieldDataPtr->timeSeriesRef = timeSeries_Create(headerId, timeStampFactor, factor);
+    if (fieldDataPtr->timeSeriesRef == NULL)
+    {
+        return LE_FAULT;
+    }
 
     return result;
 
@@ -1450,16 +1294,15 @@ static le_result_t StopTimeSeries
         return result;
     }
 
-    if (fieldDataPtr->timeSeriesPtr == NULL)
+    if (fieldDataPtr->timeSeriesRef == NULL)
     {
         LE_ERROR("Time series not enabled on this field.");
         return LE_CLOSED;
     }
 
-    le_mem_Release(fieldDataPtr->timeSeriesPtr->bufferPtr);
-    le_mem_Release(fieldDataPtr->timeSeriesPtr);
+    timeSeries_Delete(fieldDataPtr->timeSeriesRef);
 
-    fieldDataPtr->timeSeriesPtr = NULL;
+    fieldDataPtr->timeSeriesRef = NULL;
 
     return LE_OK;
 
@@ -1494,12 +1337,9 @@ static le_result_t PushTimeSeries
 
     le_result_t result;
     FieldData_t* fieldDataPtr;
-    uint32_t cborStreamSize;
-    unsigned char compressedBuf[MAX_CBOR_BUFFER_NUMBYTES];
-    unsigned long int compressBufLength;
-    z_stream defstream;
+    uint8_t* payloadPtr;
+    size_t payloadNumBytes;
     pa_avc_LWM2MOperationDataRef_t opRef;
-    CborError err;
 
     double dataFactor;
     double timeStampFactor;
@@ -1510,7 +1350,7 @@ static le_result_t PushTimeSeries
         return result;
     }
 
-    if (fieldDataPtr->timeSeriesPtr == NULL)
+    if (fieldDataPtr->timeSeriesRef == NULL)
     {
         // Time series not enabled on this field.
         LE_ERROR("Time series not enabled on this field.");
@@ -1525,46 +1365,15 @@ static le_result_t PushTimeSeries
     }
 
     // Remember the factors used.
-    dataFactor = fieldDataPtr->timeSeriesPtr->factor;
-    timeStampFactor = fieldDataPtr->timeSeriesPtr->timeStampFactor;
-
-    // Close the map i.e done with entering in to sample array.
-    err = cbor_encoder_close_container_checked(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                               &fieldDataPtr->timeSeriesPtr->sampleRef);
-
-    RETURN_IF_CBOR_ERROR(err);
+    timeSeries_GetFactors(fieldDataPtr->timeSeriesRef, &timeStampFactor, &dataFactor);
 
-    // Close the stream.
-    err = cbor_encoder_close_container_checked(&fieldDataPtr->timeSeriesPtr->streamRef,
-                                               &fieldDataPtr->timeSeriesPtr->mapRef);
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Dump CBOR encoded data.
-    cborStreamSize = cbor_encoder_get_buffer_size(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                                  fieldDataPtr->timeSeriesPtr->bufferPtr);
-
-    //LE_DEBUG("cborStreamSize = %d", cborStreamSize);
-    //LE_DUMP(fieldDataPtr->timeSeriesPtr->bufferPtr, cborStreamSize);
-
-    // Compress the cbor encoded data
-    // ToDo: In place compression
-    defstream.zalloc = Z_NULL;
-    defstream.zfree = Z_NULL;
-    defstream.opaque = Z_NULL;
-
-    defstream.avail_in = cborStreamSize;
-    defstream.next_in = (Bytef *)fieldDataPtr->timeSeriesPtr->bufferPtr;
-    defstream.avail_out = (uInt)sizeof(compressedBuf);
-    defstream.next_out = (Bytef *)compressedBuf;
-
-    deflateInit(&defstream, Z_BEST_COMPRESSION);
-    deflate(&defstream, Z_FINISH);
-    deflateEnd(&defstream);
-
-    compressBufLength = defstream.total_out;
-
-    //LE_DEBUG("Compressed size is: %lu\n", compressBufLength);
-    //LE_DUMP(compressedBuf, compressBufLength);
+    // The samples were compressed as they were recorded, so only the tail of the stream is left
+    // to compress here.
+    result = timeSeries_Finish(fieldDataPtr->timeSeriesRef, &payloadPtr, &payloadNumBytes);
+    if (result != LE_OK)
+    {
+        return result;
+    }
 
     // Send the delta encoded + CBOR encoded + Zipped data to the server.
     opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
@@ -1576,9 +1385,9 @@ static le_result_t PushTimeSeries
                                 fieldDataPtr->token,
                                 fieldDataPtr->tokenLength);
 
-    pa_avc_NotifyChange(opRef, compressedBuf, compressBufLength);
+    pa_avc_NotifyChange(opRef, payloadPtr, payloadNumBytes);
 
-    // Stop time series.
+    // Stop time series.  This also frees the payload, which has been copied by the notification.
     result = StopTimeSeries(instanceRef, fieldId);
 
     // Restart time series if asked.
@@ -1625,7 +1434,7 @@ le_result_t GetTimeSeriesStatus
         return result;
     }
 
-    if (fieldDataPtr->timeSeriesPtr == NULL)
+    if (fieldDataPtr->timeSeriesRef == NULL)
     {
         // Time series not enabled on this field.
         LE_DEBUG("Time series not enabled on this field.");
@@ -1636,7 +1445,7 @@ le_result_t GetTimeSeriesStatus
     else
     {
         *isTimeSeriesPtr = true;
-        *numDataPointsPtr = fieldDataPtr->timeSeriesPtr->numElements;
+        *numDataPointsPtr = timeSeries_GetNumSamples(fieldDataPtr->timeSeriesRef);
     }
 
     return LE_OK;
@@ -1650,7 +1459,7 @@ le_result_t GetTimeSeriesStatus
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add the sampled data in to the CBOR sample array.
+ * Add the sampled data to the time series of the field.
  *
  * @return:
  *      - LE_OK on success
@@ -1668,27 +1477,9 @@ static le_result_t TimeSeriesAddEntry
 
 #if FEATURE_TIMESERIES
 
-    CborError err;
-    uint64_t timeStamp;
-    int intDelta;
-    double floatDelta;
-    size_t currentSize;
+    le_result_t result = LE_FAULT;
     struct timeval tv;
 
-    // Reserve CBOR_RESERVED_BYTES bytes for closing the container.
-    // The stream has to be flushed it starts getting in to the reserved area.
-    currentSize = cbor_encoder_get_buffer_size(&fieldDataPtr->timeSeriesPtr->sampleRef,
-                                               fieldDataPtr->timeSeriesPtr->bufferPtr);
-
-
-    if (currentSize > (fieldDataPtr->timeSeriesPtr->bufferSize - CBOR_RESERVED_BYTES))
-    {
-        LE_WARN("Time series buffer overflow on field %d.", fieldDataPtr->fieldId);
-        LE_DEBUG("currentSize = %zd.", currentSize);
-
-        return LE_OVERFLOW;
-    }
-
     // Get current system time if utc milli seconds is not provided.
     // The time stamp is expected in UTC milli seconds by the server.
     if (utcMilliSec == 0)
@@ -1697,104 +1488,43 @@ static le_result_t TimeSeriesAddEntry
         utcMilliSec = (uint64_t)(tv.tv_sec) * 1000 + (uint64_t)(tv.tv_usec) / 1000;
     }
 
-    // For the first entry write the absolute value, for all other entries calculate delta.
-    if (fieldDataPtr->timeSeriesPtr->numElements == 0)
-    {
-        timeStamp = utcMilliSec * fieldDataPtr->timeSeriesPtr->timeStampFactor;
-    }
-    else
-    {
-        timeStamp = (utcMilliSec - fieldDataPtr->timeSeriesPtr->prevTimeStamp) *
-                    fieldDataPtr->timeSeriesPtr->timeStampFactor;
-    }
-
-    // Add time stamp to sample array.
-    err = cbor_encode_int(&fieldDataPtr->timeSeriesPtr->sampleRef, timeStamp);
-    RETURN_IF_CBOR_ERROR(err);
-
-    fieldDataPtr->timeSeriesPtr->prevTimeStamp = utcMilliSec;
-
-    // Add the data to sample array.
     switch ( fieldDataPtr->type )
     {
         case DATA_TYPE_INT:
-            if (fieldDataPtr->timeSeriesPtr->numElements == 0)
-            {
-                intDelta = fieldDataPtr->intValue * fieldDataPtr->timeSeriesPtr->factor;
-            }
-            else
-            {
-                intDelta = (fieldDataPtr->intValue - fieldDataPtr->timeSeriesPtr->prevIntValue) *
-                            fieldDataPtr->timeSeriesPtr->factor;
-            }
-
-            //LE_DEBUG("intDelta = %d", intDelta);
-
-            err = cbor_encode_int(&fieldDataPtr->timeSeriesPtr->sampleRef, intDelta);
-
-            fieldDataPtr->timeSeriesPtr->prevIntValue = fieldDataPtr->intValue;
+            result = timeSeries_AddInt(fieldDataPtr->timeSeriesRef,
+                                       utcMilliSec,
+                                       fieldDataPtr->intValue);
             break;
 
         case DATA_TYPE_BOOL:
-            err = cbor_encode_boolean(&fieldDataPtr->timeSeriesPtr->sampleRef, fieldDataPtr->boolValue);
+            result = timeSeries_AddBool(fieldDataPtr->timeSeriesRef,
+                                        utcMilliSec,
+                                        fieldDataPtr->boolValue);
             break;
 
         case DATA_TYPE_STRING:
-            err = cbor_encode_text_string(&fieldDataPtr->timeSeriesPtr->sampleRef,
-                                          fieldDataPtr->strValuePtr,
-                                          strlen(fieldDataPtr->strValuePtr));
+            result = timeSeries_AddString(fieldDataPtr->timeSeriesRef,
+                                          utcMilliSec,
+                                          fieldDataPtr->strValuePtr);
             break;
 
         case DATA_TYPE_FLOAT:
-            // ToDO: float doesn't benefit from use of factor - investigate.
-            if (fieldDataPtr->timeSeriesPtr->numElements == 0)
-            {
-                floatDelta = fieldDataPtr->floatValue * fieldDataPtr->timeSeriesPtr->factor;
-            }
-            else
-            {
-                floatDelta = (fieldDataPtr->floatValue - fieldDataPtr->timeSeriesPtr->prevFloatValue);
-                floatDelta = floatDelta * fieldDataPtr->timeSeriesPtr->factor;
-            }
-
-            if ((uint64_t)fieldDataPtr->timeSeriesPtr->factor == 1)
-            {
-                err = cbor_encode_double(&fieldDataPtr->timeSeriesPtr->sampleRef, floatDelta);
-            }
-            else
-            {
-                LE_DEBUG("Float data encoded as integer.");
-                err = cbor_encode_int(&fieldDataPtr->timeSeriesPtr->sampleRef, (int64_t)floatDelta);
-            }
-
-            fieldDataPtr->timeSeriesPtr->prevFloatValue = fieldDataPtr->floatValue;
+            result = timeSeries_AddFloat(fieldDataPtr->timeSeriesRef,
+                                         utcMilliSec,
+                                         fieldDataPtr->floatValue);
             break;
 
         case DATA_TYPE_NONE:
-            LE_ERROR("Failed to add an entry in CBOR stream.");
+            LE_ERROR("Failed to add an entry in time series.");
             break;
     }
 
-    RETURN_IF_CBOR_ERROR(err);
-
-    fieldDataPtr->timeSeriesPtr->numElements++;
-
-
-    // Reserve CBOR_RESERVED_BYTES bytes for closing the container.
-    // The stream has to be flushed it starts getting in to the reserved area.
-    currentSize = cbor_encoder_get_buffer_size(&fieldDataPtr->timeSeriesPtr->sampleRef,
-                                               fieldDataPtr->timeSeriesPtr->bufferPtr);
-
-    if (currentSize > (fieldDataPtr->timeSeriesPtr->bufferSize - CBOR_RESERVED_BYTES))
+    if ((result == LE_OVERFLOW) || (result == LE_NO_MEMORY))
     {
-        LE_WARN("Time series buffer full; flush and restart time series on field %d.",
-                 fieldDataPtr->fieldId);
-        LE_DEBUG("currentSize = %zd.", currentSize);
-
-        return LE_NO_MEMORY;
+        LE_WARN("Time series buffer full on field %d.", fieldDataPtr->fieldId);
     }
 
-    return LE_OK;
+    return result;
 
 #else
     LE_ERROR("Time series not supported.");
@@ -2204,7 +1934,7 @@ static le_result_t SetInt
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -2318,7 +2048,7 @@ static le_result_t SetFloat
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -2473,7 +2203,7 @@ static le_result_t SetBool
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -2631,7 +2361,7 @@ static le_result_t SetString
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -3195,13 +2925,14 @@ void assetData_DeleteInstance
                 break;
         }
 
+#if FEATURE_TIMESERIES
         // Release Time Series resources.
-        if (fieldDataPtr->timeSeriesPtr != NULL)
+        if (fieldDataPtr->timeSeriesRef != NULL)
         {
             LE_DEBUG("Releasing time series resources of %s", fieldDataPtr->name);
-            le_mem_Release(fieldDataPtr->timeSeriesPtr->bufferPtr);
-            le_mem_Release(fieldDataPtr->timeSeriesPtr);
+            timeSeries_Delete(fieldDataPtr->timeSeriesRef);
         }
+#endif
 
         // Release the field.
         LE_DEBUG("Deleting field %s", fieldDataPtr->name);
@@ -4536,9 +4267,10 @@ le_result_t assetData_Init
     ActionHandlerDataPoolRef = le_mem_CreatePool("Action handler data pool",
                                                  sizeof(ActionHandlerData_t));
 
-    // Memory pool for time series data.
-    TimeSeriesDataPoolRef = le_mem_CreatePool("TimeSeries data pool", sizeof(TimeSeriesData_t));
-    CborBufferPoolRef = le_mem_CreatePool("CBOR buffer pool", MAX_CBOR_BUFFER_NUMBYTES);
+#if FEATURE_TIMESERIES
+    // Memory pools for time series streams.
+    timeSeries_Init();
+#endif
 
     StringValuePoolRef = le_mem_CreatePool("String value pool", STRING_VALUE_NUMBYTES);
     AddressStringPoolRef = le_mem_CreatePool("Address pool", 100);
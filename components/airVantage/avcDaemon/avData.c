@@ -1402,6 +1402,128 @@ le_result_t le_avdata_RecordString
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record several samples, on any fields of an instance, in time series.
+ *
+ * All the field names are resolved before any sample is recorded, and consecutive samples on the
+ * same field only resolve it once.  The samples are then recorded in order, as the individual
+ * le_avdata_Record*() functions would record them, until one fails.
+ *
+ * @note The client will be terminated if the instRef is not valid, or one of the fields doesn't
+ *       exist.  In that case no sample is recorded.
+ *
+ * @return:
+ *      - LE_OK if all the samples were recorded
+ *      - LE_OVERFLOW if the sample following the recorded ones was NOT added as the time series
+ *                    buffer of its field is full.
+ *      - LE_NO_MEMORY if the last recorded sample was added but there is no space for the next
+ *                    one on its field.
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_avdata_RecordBatch
+(
+    le_avdata_AssetInstanceRef_t instRef,
+        ///< [IN]
+
+    const le_avdata_Sample_t* samplesPtr,
+        ///< [IN] Samples to record.
+
+    size_t samplesSize,
+        ///< [IN]
+
+    uint32_t* numRecordedPtr
+        ///< [OUT] Number of samples recorded.
+)
+{
+    int fieldIds[LE_AVDATA_RECORD_BATCH_MAX];
+    le_result_t result = LE_OK;
+    size_t i;
+
+    *numRecordedPtr = 0;
+
+    // Map safeRef to desired data
+    instRef = GetInstRefFromSafeRef(instRef, __func__);
+    if (instRef == NULL)
+    {
+        return LE_FAULT;
+    }
+
+    if (samplesSize > LE_AVDATA_RECORD_BATCH_MAX)
+    {
+        LE_KILL_CLIENT("Too many samples (%zu) in batch", samplesSize);
+        return LE_FAULT;
+    }
+
+    for (i = 0; i < samplesSize; i++)
+    {
+        if ((i > 0) && (strcmp(samplesPtr[i].fieldName, samplesPtr[i - 1].fieldName) == 0))
+        {
+            fieldIds[i] = fieldIds[i - 1];
+        }
+        else if ( assetData_GetFieldIdFromName(instRef,
+                                               samplesPtr[i].fieldName,
+                                               &fieldIds[i]) != LE_OK )
+        {
+            LE_KILL_CLIENT("Invalid instance '%p' or unknown field name '%s'",
+                           instRef, samplesPtr[i].fieldName);
+            return LE_FAULT;
+        }
+    }
+
+    for (i = 0; (i < samplesSize) && (result == LE_OK); i++)
+    {
+        const le_avdata_Sample_t* samplePtr = &samplesPtr[i];
+
+        switch (samplePtr->type)
+        {
+            case LE_AVDATA_SAMPLE_INT:
+                result = assetData_client_RecordInt(instRef, fieldIds[i],
+                                                    samplePtr->intValue, samplePtr->timestamp);
+                break;
+
+            case LE_AVDATA_SAMPLE_FLOAT:
+                result = assetData_client_RecordFloat(instRef, fieldIds[i],
+                                                      samplePtr->floatValue, samplePtr->timestamp);
+                break;
+
+            case LE_AVDATA_SAMPLE_BOOL:
+                result = assetData_client_RecordBool(instRef, fieldIds[i],
+                                                     samplePtr->boolValue, samplePtr->timestamp);
+                break;
+
+            default:
+                LE_ERROR("Invalid sample type %d for field=%i", samplePtr->type, fieldIds[i]);
+                result = LE_FAULT;
+                break;
+        }
+
+        // A sample that filled the buffer is recorded, but ends the batch.
+        if ((result == LE_OK) || (result == LE_NO_MEMORY))
+        {
+            (*numRecordedPtr)++;
+        }
+    }
+
+    if (result == LE_NO_MEMORY)
+    {
+        LE_WARN("Time series buffer full for field=%i", fieldIds[*numRecordedPtr - 1]);
+    }
+    else if (result == LE_OVERFLOW)
+    {
+        LE_WARN("Time series buffer overflow for field=%i", fieldIds[*numRecordedPtr]);
+    }
+    else if (result != LE_OK)
+    {
+        LE_ERROR("Error recording sample %" PRIu32 " of batch", *numRecordedPtr);
+    }
+
+    return result;
+}
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Is time series enabled on this resource, if yes how many data points are recorded so far?
@@ -0,0 +1,1089 @@
+/**
+ * @file timeSeries.c
+ *
+ * Streaming encoder for the time series recorded on asset data fields.
+ *
+ * Each sample is delta encoded against the previous one, CBOR encoded and appended to a raw chunk.
+ * Every time the raw chunk fills up it is deflated into the compressed chunks of the stream, so
+ * the compression cost is spread over the recording instead of being paid all at once when the
+ * time series is pushed.  Deflate is sync-flushed at each raw chunk boundary: the compressed size
+ * is then known exactly, which allows checking that a sample fits before accepting it.
+ *
+ * Up to LE_CONFIG_AVC_TIMESERIES_MAX_CHUNKS compressed chunks are kept in memory per stream.  If
+ * LE_CONFIG_AVC_TIMESERIES_SPILL_DIR is set, full chunks are then moved to a spill file in that
+ * directory, of at most LE_CONFIG_AVC_TIMESERIES_SPILL_MAX_KBYTES, so that a field can buffer
+ * hours of samples while the device is offline.  A deflate stream cannot drop its oldest data,
+ * so the spill file is bounded rather than circular: once it is full, samples are refused until
+ * the time series is pushed.
+ *
+ * The payload has the format expected by the AirVantage server:
+ *
+ * @verbatim
+   { "h" : [ "/<instanceId>/<fieldId>" ],
+     "f" : [ <time stamp factor>, <factor> ],
+     "s" : [ <time stamp>, <value>, <time stamp>, <value>, ... ] }
+   @endverbatim
+ *
+ * where the first time stamp and value are absolute, and the following ones are deltas.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "limit.h"
+#include "timeSeries.h"
+
+#if FEATURE_TIMESERIES
+
+#include <sys/mman.h>
+
+#include "cbor.h"
+#include "zlib.h"
+
+//--------------------------------------------------------------------------------------------------
+// Definitions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the raw and compressed chunks.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_NUMBYTES 1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of maps (called objects in JSON) in the CBOR encoded data (header, factor & sample).
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_TIME_SERIES_MAPS 3
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a CBOR encoded sample: a time stamp and a string value.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SAMPLE_MAX_NUMBYTES 320
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes reserved in the compressed stream for the sync flush markers, the final block
+ * and the trailer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFLATE_RESERVED_BYTES 32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deflate window and memory level.  These keep the deflate state of a stream around 32 KB, where
+ * the defaults would take about 256 KB.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFLATE_WINDOW_BITS 12
+#define DEFLATE_MEM_LEVEL   5
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CBOR "break" byte, which closes the indefinite length sample array.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CBOR_BREAK 0xFF
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Limits of a stream, and spill directory.  These come from the KConfig, but can be overridden at
+ * build time, e.g. by the unit test to exercise the spill file.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef TIMESERIES_MAX_CHUNKS
+#define TIMESERIES_MAX_CHUNKS           LE_CONFIG_AVC_TIMESERIES_MAX_CHUNKS
+#endif
+
+#ifndef TIMESERIES_SPILL_DIR
+#define TIMESERIES_SPILL_DIR            LE_CONFIG_AVC_TIMESERIES_SPILL_DIR
+#endif
+
+#ifndef TIMESERIES_SPILL_MAX_KBYTES
+#define TIMESERIES_SPILL_MAX_KBYTES     LE_CONFIG_AVC_TIMESERIES_SPILL_MAX_KBYTES
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum compressed size kept in memory, and kept in the spill file, per stream.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEMORY_MAX_NUMBYTES (TIMESERIES_MAX_CHUNKS * CHUNK_NUMBYTES)
+#define SPILL_MAX_NUMBYTES  ((size_t)TIMESERIES_SPILL_MAX_KBYTES * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks the return value from the tinyCBOR encoder and returns from function if an error is found.
+ */
+//--------------------------------------------------------------------------------------------------
+#define \
+    RETURN_IF_CBOR_ERROR( err ) \
+    ({ \
+        if (err != CborNoError) \
+        { \
+            LE_ERROR("CBOR encoding error %s", cbor_error_string(err)); \
+            return LE_FAULT; \
+        } \
+    })
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Chunk of compressed data.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint8_t data[CHUNK_NUMBYTES];   ///< Compressed data.
+    le_sls_Link_t link;             ///< For adding to the chunk list of the stream.
+}
+Chunk_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Where the payload of a finished stream is stored.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    PAYLOAD_NONE,                   ///< Stream not finished.
+    PAYLOAD_CHUNK,                  ///< In the only compressed chunk.
+    PAYLOAD_POOL,                   ///< In a block of the payload pool.
+    PAYLOAD_MAPPED                  ///< In the mapped spill file.
+}
+PayloadStorage_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time series stream.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct timeSeries_Stream
+{
+    double timeStampFactor;         ///< Factor of time stamp.
+    uint64_t prevTimeStamp;         ///< Time stamp of last data capture, used for delta encoding.
+
+    double factor;                  ///< Factor of data.
+    union
+    {
+        int prevIntValue;           ///< Value of of last data capture - used for delta encoding.
+        double prevFloatValue;      ///< Value of last data capture - used for delta encoding.
+    };
+
+    uint32_t numSamples;            ///< Number of samples in the stream.
+
+    uint8_t* rawChunkPtr;           ///< CBOR encoded samples not compressed yet.
+    size_t rawNumBytes;             ///< Number of bytes used in the raw chunk.
+
+    z_stream deflateStream;         ///< Compressor state.
+    bool isDeflateInit;             ///< Is the compressor initialized?
+
+    le_sls_List_t chunkList;        ///< Compressed chunks kept in memory.
+    Chunk_t* lastChunkPtr;          ///< Last compressed chunk, NULL if none.
+    size_t lastChunkNumBytes;       ///< Number of bytes used in the last compressed chunk.
+    size_t numChunks;               ///< Number of compressed chunks kept in memory.
+
+    int spillFd;                    ///< Spill file, -1 if not created yet.
+    size_t spillNumBytes;           ///< Number of compressed bytes in the spill file.
+
+    PayloadStorage_t payloadStorage;///< Where the payload is, once finished.
+    uint8_t* payloadPtr;            ///< Payload, once finished.
+    size_t payloadNumBytes;         ///< Payload size, once finished.
+}
+Stream_t;
+
+
+//--------------------------------------------------------------------------------------------------
+// Local Data
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stream memory pool.  Initialized in timeSeries_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StreamPoolRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Raw chunk memory pool.  Initialized in timeSeries_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t RawChunkPoolRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compressed chunk memory pool.  Initialized in timeSeries_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ChunkPoolRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for the payloads spread over several chunks.  Initialized in timeSeries_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t PayloadPoolRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+// Local functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Is spilling to flash enabled?
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSpillEnabled
+(
+    void
+)
+{
+    return (TIMESERIES_SPILL_DIR[0] != '\0') && (SPILL_MAX_NUMBYTES > 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of compressed bytes produced so far by a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t GetCompressedNumBytes
+(
+    Stream_t* streamPtr
+)
+{
+    size_t numBytes = streamPtr->spillNumBytes;
+
+    if (streamPtr->numChunks > 0)
+    {
+        numBytes += (streamPtr->numChunks - 1) * CHUNK_NUMBYTES + streamPtr->lastChunkNumBytes;
+    }
+
+    return numBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a sample, and the end of the stream after it, are guaranteed to fit in the stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool HasRoomFor
+(
+    Stream_t* streamPtr,
+    size_t sampleNumBytes
+)
+{
+    size_t capacity = MEMORY_MAX_NUMBYTES + (IsSpillEnabled() ? SPILL_MAX_NUMBYTES : 0);
+    uLong pendingNumBytes = streamPtr->rawNumBytes + sampleNumBytes + 1;
+
+    return (GetCompressedNumBytes(streamPtr) +
+            deflateBound(&streamPtr->deflateStream, pendingNumBytes) +
+            DEFLATE_RESERVED_BYTES) <= capacity;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a buffer to the spill file of a stream, creating the file if needed.
+ *
+ * The file is unlinked right after being created: it is only reached through its descriptor, and
+ * goes away with the stream, or with the daemon.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteSpill
+(
+    Stream_t* streamPtr,
+    const uint8_t* bufPtr,
+    size_t numBytes
+)
+{
+    if (streamPtr->spillFd < 0)
+    {
+        char path[LIMIT_MAX_PATH_BYTES];
+
+        if (snprintf(path, sizeof(path), "%s/timeSeriesXXXXXX",
+                     TIMESERIES_SPILL_DIR) >= (int)sizeof(path))
+        {
+            LE_ERROR("Time series spill directory path is too long.");
+            return LE_FAULT;
+        }
+
+        streamPtr->spillFd = mkostemp(path, O_CLOEXEC);
+        if (streamPtr->spillFd < 0)
+        {
+            LE_ERROR("Failed to create time series spill file in '%s' (%m).",
+                     TIMESERIES_SPILL_DIR);
+            return LE_FAULT;
+        }
+
+        unlink(path);
+    }
+
+    while (numBytes > 0)
+    {
+        ssize_t written = write(streamPtr->spillFd, bufPtr, numBytes);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            LE_ERROR("Failed to write time series spill file (%m).");
+            return LE_FAULT;
+        }
+
+        bufPtr += written;
+        numBytes -= written;
+        streamPtr->spillNumBytes += written;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move all the compressed chunks of a stream to its spill file.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SpillChunks
+(
+    Stream_t* streamPtr
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&streamPtr->chunkList)) != NULL)
+    {
+        Chunk_t* chunkPtr = CONTAINER_OF(linkPtr, Chunk_t, link);
+        size_t numBytes = (chunkPtr == streamPtr->lastChunkPtr) ?
+                          streamPtr->lastChunkNumBytes : CHUNK_NUMBYTES;
+        le_result_t result = WriteSpill(streamPtr, chunkPtr->data, numBytes);
+
+        le_mem_Release(chunkPtr);
+        streamPtr->numChunks--;
+
+        if (result != LE_OK)
+        {
+            // The chunk is lost, so the stream is broken.
+            streamPtr->lastChunkPtr = NULL;
+            return LE_FAULT;
+        }
+    }
+
+    streamPtr->lastChunkPtr = NULL;
+    streamPtr->lastChunkNumBytes = 0;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an empty compressed chunk to a stream, spilling the full ones first if needed.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddChunk
+(
+    Stream_t* streamPtr
+)
+{
+    if (streamPtr->numChunks >= TIMESERIES_MAX_CHUNKS)
+    {
+        if (!IsSpillEnabled() || (SpillChunks(streamPtr) != LE_OK))
+        {
+            LE_ERROR("No space left for compressed time series data.");
+            return LE_FAULT;
+        }
+    }
+
+    Chunk_t* chunkPtr = le_mem_ForceAlloc(ChunkPoolRef);
+
+    chunkPtr->link = LE_SLS_LINK_INIT;
+    le_sls_Queue(&streamPtr->chunkList, &chunkPtr->link);
+
+    streamPtr->lastChunkPtr = chunkPtr;
+    streamPtr->lastChunkNumBytes = 0;
+    streamPtr->numChunks++;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compress the raw chunk of a stream.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Deflate
+(
+    Stream_t* streamPtr,
+    int flush                       ///< Z_SYNC_FLUSH, or Z_FINISH to end the stream.
+)
+{
+    z_stream* zStreamPtr = &streamPtr->deflateStream;
+    int zResult;
+
+    zStreamPtr->next_in = (Bytef*)streamPtr->rawChunkPtr;
+    zStreamPtr->avail_in = (uInt)streamPtr->rawNumBytes;
+
+    do
+    {
+        if ((streamPtr->lastChunkPtr == NULL) || (streamPtr->lastChunkNumBytes == CHUNK_NUMBYTES))
+        {
+            if (AddChunk(streamPtr) != LE_OK)
+            {
+                return LE_FAULT;
+            }
+        }
+
+        zStreamPtr->next_out = (Bytef*)streamPtr->lastChunkPtr->data +
+                               streamPtr->lastChunkNumBytes;
+        zStreamPtr->avail_out = (uInt)(CHUNK_NUMBYTES - streamPtr->lastChunkNumBytes);
+
+        zResult = deflate(zStreamPtr, flush);
+
+        streamPtr->lastChunkNumBytes = CHUNK_NUMBYTES - zStreamPtr->avail_out;
+
+        if (zResult == Z_STREAM_ERROR)
+        {
+            LE_ERROR("Time series compression error.");
+            return LE_FAULT;
+        }
+    }
+    while ((flush == Z_FINISH) ? (zResult != Z_STREAM_END) : (zStreamPtr->avail_out == 0));
+
+    streamPtr->rawNumBytes = 0;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Encode the header of a stream, up to the opening of the sample array, in its raw chunk.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t EncodeHeader
+(
+    Stream_t* streamPtr,
+    const char* headerIdPtr
+)
+{
+    CborError err;
+    CborEncoder streamRef;
+    CborEncoder mapRef;
+    CborEncoder headerArray;
+    CborEncoder factorArray;
+    CborEncoder sampleRef;
+
+    cbor_encoder_init(&streamRef, streamPtr->rawChunkPtr, CHUNK_NUMBYTES, 0);
+
+    err = cbor_encoder_create_map(&streamRef, &mapRef, NUM_TIME_SERIES_MAPS);
+    RETURN_IF_CBOR_ERROR(err);
+
+    // e.g. "h" : [/1000/0]  --> map for header.
+    err = cbor_encode_text_stringz(&mapRef, "h");
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encoder_create_array(&mapRef, &headerArray, 1);
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encode_text_string(&headerArray, headerIdPtr, strlen(headerIdPtr));
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encoder_close_container(&mapRef, &headerArray);
+    RETURN_IF_CBOR_ERROR(err);
+
+    // e.g. "f" : [1, 1]  --> map for factors (time stamp factor, data factor).
+    err = cbor_encode_text_stringz(&mapRef, "f");
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encoder_create_array(&mapRef, &factorArray, 2);
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encode_double(&factorArray, streamPtr->timeStampFactor);
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encode_double(&factorArray, streamPtr->factor);
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encoder_close_container(&mapRef, &factorArray);
+    RETURN_IF_CBOR_ERROR(err);
+
+    // "s" : [ ...  --> sample array, of time stamp and data pairs.  It is left open here: samples
+    // are appended to the raw stream as they come, and the array is closed by timeSeries_Finish().
+    err = cbor_encode_text_stringz(&mapRef, "s");
+    RETURN_IF_CBOR_ERROR(err);
+
+    err = cbor_encoder_create_array(&mapRef, &sampleRef, CborIndefiniteLength);
+    RETURN_IF_CBOR_ERROR(err);
+
+    streamPtr->rawNumBytes = cbor_encoder_get_buffer_size(&sampleRef, streamPtr->rawChunkPtr);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start encoding a sample: initialize its encoder and encode its time stamp.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t EncodeTimeStamp
+(
+    Stream_t* streamPtr,
+    CborEncoder* encoderPtr,
+    uint8_t* samplePtr,
+    uint64_t utcMilliSec
+)
+{
+    CborError err;
+    uint64_t timeStamp;
+
+    if (streamPtr->payloadStorage != PAYLOAD_NONE)
+    {
+        LE_ERROR("Time series already finished.");
+        return LE_FAULT;
+    }
+
+    cbor_encoder_init(encoderPtr, samplePtr, SAMPLE_MAX_NUMBYTES, 0);
+
+    // For the first entry write the absolute value, for all other entries calculate delta.
+    if (streamPtr->numSamples == 0)
+    {
+        timeStamp = utcMilliSec * streamPtr->timeStampFactor;
+    }
+    else
+    {
+        timeStamp = (utcMilliSec - streamPtr->prevTimeStamp) * streamPtr->timeStampFactor;
+    }
+
+    err = cbor_encode_int(encoderPtr, timeStamp);
+    RETURN_IF_CBOR_ERROR(err);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append an encoded sample to the raw chunk of a stream, compressing the chunk first if it is
+ * full.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the stream is full.
+ *      - LE_NO_MEMORY if the sample was added but there is no space for the next one.
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendSample
+(
+    Stream_t* streamPtr,
+    CborEncoder* encoderPtr,
+    const uint8_t* samplePtr,
+    uint64_t utcMilliSec
+)
+{
+    size_t sampleNumBytes = cbor_encoder_get_buffer_size(encoderPtr, samplePtr);
+
+    // Keep a byte for closing the sample array.
+    if ((streamPtr->rawNumBytes + sampleNumBytes + 1) > CHUNK_NUMBYTES)
+    {
+        if (Deflate(streamPtr, Z_SYNC_FLUSH) != LE_OK)
+        {
+            return LE_FAULT;
+        }
+    }
+
+    if (!HasRoomFor(streamPtr, sampleNumBytes))
+    {
+        LE_WARN("Time series buffer overflow.");
+        return LE_OVERFLOW;
+    }
+
+    memcpy(streamPtr->rawChunkPtr + streamPtr->rawNumBytes, samplePtr, sampleNumBytes);
+    streamPtr->rawNumBytes += sampleNumBytes;
+
+    streamPtr->prevTimeStamp = utcMilliSec;
+    streamPtr->numSamples++;
+
+    if (!HasRoomFor(streamPtr, sampleNumBytes))
+    {
+        LE_WARN("Time series buffer full; flush and restart time series.");
+        return LE_NO_MEMORY;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Interface functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a time series stream.
+ *
+ * @return:
+ *      - Reference to the new stream
+ *      - NULL on error
+ */
+//--------------------------------------------------------------------------------------------------
+timeSeries_Ref_t timeSeries_Create
+(
+    const char* headerIdPtr,                    ///< [IN] Resource path, i.e. /instanceId/fieldId
+    double timeStampFactor,                     ///< [IN] Factor applied to time stamp deltas
+    double factor                               ///< [IN] Factor applied to value deltas
+)
+{
+    Stream_t* streamPtr = le_mem_ForceAlloc(StreamPoolRef);
+
+    memset(streamPtr, 0, sizeof(Stream_t));
+
+    streamPtr->timeStampFactor = timeStampFactor;
+    streamPtr->factor = factor;
+    streamPtr->rawChunkPtr = le_mem_ForceAlloc(RawChunkPoolRef);
+    streamPtr->chunkList = LE_SLS_LIST_INIT;
+    streamPtr->spillFd = -1;
+    streamPtr->payloadStorage = PAYLOAD_NONE;
+
+    if (deflateInit2(&streamPtr->deflateStream,
+                     Z_BEST_COMPRESSION,
+                     Z_DEFLATED,
+                     DEFLATE_WINDOW_BITS,
+                     DEFLATE_MEM_LEVEL,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        LE_ERROR("Failed to initialize time series compression.");
+        timeSeries_Delete(streamPtr);
+        return NULL;
+    }
+    streamPtr->isDeflateInit = true;
+
+    if (EncodeHeader(streamPtr, headerIdPtr) != LE_OK)
+    {
+        timeSeries_Delete(streamPtr);
+        return NULL;
+    }
+
+    return streamPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a time series stream, along with its payload if it was finished.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Delete
+(
+    timeSeries_Ref_t streamRef                  ///< [IN] Stream to delete
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    switch (streamRef->payloadStorage)
+    {
+        case PAYLOAD_POOL:
+            le_mem_Release(streamRef->payloadPtr);
+            break;
+
+        case PAYLOAD_MAPPED:
+            munmap(streamRef->payloadPtr, streamRef->payloadNumBytes);
+            break;
+
+        case PAYLOAD_NONE:
+        case PAYLOAD_CHUNK:
+            break;
+    }
+
+    if (streamRef->isDeflateInit)
+    {
+        deflateEnd(&streamRef->deflateStream);
+    }
+
+    while ((linkPtr = le_sls_Pop(&streamRef->chunkList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Chunk_t, link));
+    }
+
+    if (streamRef->spillFd >= 0)
+    {
+        close(streamRef->spillFd);
+    }
+
+    le_mem_Release(streamRef->rawChunkPtr);
+    le_mem_Release(streamRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an integer sample to a time series stream.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the stream is full.
+ *      - LE_NO_MEMORY if the sample was added but there is no space for the next one.
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddInt
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    int value                                   ///< [IN] Sampled value
+)
+{
+    uint8_t sample[SAMPLE_MAX_NUMBYTES];
+    CborEncoder encoder;
+    CborError err;
+    int intDelta;
+    le_result_t result;
+
+    if (EncodeTimeStamp(streamRef, &encoder, sample, utcMilliSec) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (streamRef->numSamples == 0)
+    {
+        intDelta = value * streamRef->factor;
+    }
+    else
+    {
+        intDelta = (value - streamRef->prevIntValue) * streamRef->factor;
+    }
+
+    err = cbor_encode_int(&encoder, intDelta);
+    RETURN_IF_CBOR_ERROR(err);
+
+    result = AppendSample(streamRef, &encoder, sample, utcMilliSec);
+    if ((result == LE_OK) || (result == LE_NO_MEMORY))
+    {
+        streamRef->prevIntValue = value;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a float sample to a time series stream.
+ *
+ * If the factor is not 1, the value is encoded as an integer to save space.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the stream is full.
+ *      - LE_NO_MEMORY if the sample was added but there is no space for the next one.
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddFloat
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    double value                                ///< [IN] Sampled value
+)
+{
+    uint8_t sample[SAMPLE_MAX_NUMBYTES];
+    CborEncoder encoder;
+    CborError err;
+    double floatDelta;
+    le_result_t result;
+
+    if (EncodeTimeStamp(streamRef, &encoder, sample, utcMilliSec) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (streamRef->numSamples == 0)
+    {
+        floatDelta = value * streamRef->factor;
+    }
+    else
+    {
+        floatDelta = (value - streamRef->prevFloatValue) * streamRef->factor;
+    }
+
+    if ((uint64_t)streamRef->factor == 1)
+    {
+        err = cbor_encode_double(&encoder, floatDelta);
+    }
+    else
+    {
+        err = cbor_encode_int(&encoder, (int64_t)floatDelta);
+    }
+    RETURN_IF_CBOR_ERROR(err);
+
+    result = AppendSample(streamRef, &encoder, sample, utcMilliSec);
+    if ((result == LE_OK) || (result == LE_NO_MEMORY))
+    {
+        streamRef->prevFloatValue = value;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a boolean sample to a time series stream.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the stream is full.
+ *      - LE_NO_MEMORY if the sample was added but there is no space for the next one.
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddBool
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    bool value                                  ///< [IN] Sampled value
+)
+{
+    uint8_t sample[SAMPLE_MAX_NUMBYTES];
+    CborEncoder encoder;
+    CborError err;
+
+    if (EncodeTimeStamp(streamRef, &encoder, sample, utcMilliSec) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    err = cbor_encode_boolean(&encoder, value);
+    RETURN_IF_CBOR_ERROR(err);
+
+    return AppendSample(streamRef, &encoder, sample, utcMilliSec);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a string sample to a time series stream.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the stream is full.
+ *      - LE_NO_MEMORY if the sample was added but there is no space for the next one.
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddString
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    const char* valuePtr                        ///< [IN] Sampled value
+)
+{
+    uint8_t sample[SAMPLE_MAX_NUMBYTES];
+    CborEncoder encoder;
+    CborError err;
+
+    if (EncodeTimeStamp(streamRef, &encoder, sample, utcMilliSec) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    err = cbor_encode_text_string(&encoder, valuePtr, strlen(valuePtr));
+    RETURN_IF_CBOR_ERROR(err);
+
+    return AppendSample(streamRef, &encoder, sample, utcMilliSec);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of samples added to a time series stream.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timeSeries_GetNumSamples
+(
+    timeSeries_Ref_t streamRef                  ///< [IN] Stream to query
+)
+{
+    return streamRef->numSamples;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the factors a time series stream was created with.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_GetFactors
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to query
+    double* timeStampFactorPtr,                 ///< [OUT] Factor applied to time stamp deltas
+    double* factorPtr                           ///< [OUT] Factor applied to value deltas
+)
+{
+    *timeStampFactorPtr = streamRef->timeStampFactor;
+    *factorPtr = streamRef->factor;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a time series stream and get its compressed payload.  No sample can be added afterwards.
+ *
+ * The payload remains valid until the stream is deleted.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_Finish
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to close
+    uint8_t** payloadPtrPtr,                    ///< [OUT] Compressed payload
+    size_t* payloadNumBytesPtr                  ///< [OUT] Compressed payload size
+)
+{
+    if (streamRef->payloadStorage != PAYLOAD_NONE)
+    {
+        LE_ERROR("Time series already finished.");
+        return LE_FAULT;
+    }
+
+    // Close the sample array, and compress what is left.  A byte is always kept for the break.
+    streamRef->rawChunkPtr[streamRef->rawNumBytes++] = CBOR_BREAK;
+
+    if (Deflate(streamRef, Z_FINISH) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (streamRef->spillNumBytes > 0)
+    {
+        // Part of the payload is in the spill file: move the rest there and map the whole file.
+        // The mapping is private, so the payload can be handed over as a writable buffer.
+        if (SpillChunks(streamRef) != LE_OK)
+        {
+            return LE_FAULT;
+        }
+
+        void* mapPtr = mmap(NULL, streamRef->spillNumBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                            streamRef->spillFd, 0);
+        if (mapPtr == MAP_FAILED)
+        {
+            LE_ERROR("Failed to map time series spill file (%m).");
+            return LE_FAULT;
+        }
+
+        streamRef->payloadStorage = PAYLOAD_MAPPED;
+        streamRef->payloadPtr = mapPtr;
+        streamRef->payloadNumBytes = streamRef->spillNumBytes;
+    }
+    else if (streamRef->numChunks == 1)
+    {
+        // Small time series: the payload is used in place.
+        streamRef->payloadStorage = PAYLOAD_CHUNK;
+        streamRef->payloadPtr = streamRef->lastChunkPtr->data;
+        streamRef->payloadNumBytes = streamRef->lastChunkNumBytes;
+    }
+    else
+    {
+        le_sls_Link_t* linkPtr = le_sls_Peek(&streamRef->chunkList);
+
+        streamRef->payloadStorage = PAYLOAD_POOL;
+        streamRef->payloadPtr = le_mem_ForceAlloc(PayloadPoolRef);
+        streamRef->payloadNumBytes = 0;
+
+        while (linkPtr != NULL)
+        {
+            Chunk_t* chunkPtr = CONTAINER_OF(linkPtr, Chunk_t, link);
+            size_t numBytes = (chunkPtr == streamRef->lastChunkPtr) ?
+                              streamRef->lastChunkNumBytes : CHUNK_NUMBYTES;
+
+            memcpy(streamRef->payloadPtr + streamRef->payloadNumBytes, chunkPtr->data, numBytes);
+            streamRef->payloadNumBytes += numBytes;
+
+            linkPtr = le_sls_PeekNext(&streamRef->chunkList, linkPtr);
+        }
+    }
+
+    LE_DEBUG("Time series of %" PRIu32 " samples compressed to %zu bytes.",
+             streamRef->numSamples, streamRef->payloadNumBytes);
+
+    *payloadPtrPtr = streamRef->payloadPtr;
+    *payloadNumBytesPtr = streamRef->payloadNumBytes;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Init this sub-component
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Init
+(
+    void
+)
+{
+    StreamPoolRef = le_mem_CreatePool("TimeSeries stream pool", sizeof(Stream_t));
+    RawChunkPoolRef = le_mem_CreatePool("TimeSeries raw chunk pool", CHUNK_NUMBYTES);
+    ChunkPoolRef = le_mem_CreatePool("TimeSeries chunk pool", sizeof(Chunk_t));
+    PayloadPoolRef = le_mem_CreatePool("TimeSeries payload pool", MEMORY_MAX_NUMBYTES);
+}
+
+#endif // FEATURE_TIMESERIES
@@ -0,0 +1,167 @@
+/**
+ * @file timeSeries.h
+ *
+ * Interface of the streaming encoder for the time series recorded on asset data fields.
+ *
+ * A time series stream accumulates samples as they are recorded, and produces the delta encoded,
+ * CBOR encoded and deflated payload that is pushed to the AirVantage server.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef LEGATO_TIME_SERIES_INCLUDE_GUARD
+#define LEGATO_TIME_SERIES_INCLUDE_GUARD
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time series support, selected by AVC_FEATURE_TIMESERIES in the KConfig.  It needs the tinycbor
+ * and zlib libraries.
+ */
+//--------------------------------------------------------------------------------------------------
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
+#   define FEATURE_TIMESERIES 1
+#else
+#   define FEATURE_TIMESERIES 0
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a time series stream.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct timeSeries_Stream* timeSeries_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+// Interface functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Init this sub-component
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a time series stream.
+ *
+ * @return:
+ *      - Reference to the new stream
+ *      - NULL on error
+ */
+//--------------------------------------------------------------------------------------------------
+timeSeries_Ref_t timeSeries_Create
+(
+    const char* headerIdPtr,                    ///< [IN] Resource path, i.e. /instanceId/fieldId
+    double timeStampFactor,                     ///< [IN] Factor applied to time stamp deltas
+    double factor                               ///< [IN] Factor applied to value deltas
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a time series stream, along with its payload if it was finished.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Delete
+(
+    timeSeries_Ref_t streamRef                  ///< [IN] Stream to delete
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a sample to a time series stream.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the stream is full.
+ *      - LE_NO_MEMORY if the sample was added but there is no space for the next one.
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddInt
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    int value                                   ///< [IN] Sampled value
+);
+
+le_result_t timeSeries_AddFloat
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    double value                                ///< [IN] Sampled value
+);
+
+le_result_t timeSeries_AddBool
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    bool value                                  ///< [IN] Sampled value
+);
+
+le_result_t timeSeries_AddString
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to add to
+    uint64_t utcMilliSec,                       ///< [IN] Time stamp in UTC milli seconds
+    const char* valuePtr                        ///< [IN] Sampled value
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of samples added to a time series stream.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timeSeries_GetNumSamples
+(
+    timeSeries_Ref_t streamRef                  ///< [IN] Stream to query
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the factors a time series stream was created with.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_GetFactors
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to query
+    double* timeStampFactorPtr,                 ///< [OUT] Factor applied to time stamp deltas
+    double* factorPtr                           ///< [OUT] Factor applied to value deltas
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close a time series stream and get its compressed payload.  No sample can be added afterwards.
+ *
+ * The payload remains valid until the stream is deleted.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_FAULT on any error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_Finish
+(
+    timeSeries_Ref_t streamRef,                 ///< [IN] Stream to close
+    uint8_t** payloadPtrPtr,                    ///< [OUT] Compressed payload
+    size_t* payloadNumBytesPtr                  ///< [OUT] Compressed payload size
+);
+
+#endif // LEGATO_TIME_SERIES_INCLUDE_GUARD
@@ -0,0 +1,355 @@
+/** @file le_trie.c
+ *
+ * Implementation of the prefix tree of AT strings.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "le_trie.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Trees pool size
+ */
+//--------------------------------------------------------------------------------------------------
+#define TRIE_POOL_SIZE      4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tree nodes pool size, i.e. a few dozens of AT response patterns
+ */
+//--------------------------------------------------------------------------------------------------
+#define NODE_POOL_SIZE      256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tree node: one character of one or more keys
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct Node
+{
+    struct Node*    childPtr;       ///< First node of the next character
+    struct Node*    siblingPtr;     ///< Next node for the same character position
+    le_dls_List_t   itemList;       ///< Items of the key ending with this node
+    char            c;              ///< Character, lower case if the tree ignores case
+}
+Node_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prefix tree
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_trie
+{
+    Node_t  root;           ///< Node of the empty key
+    bool    ignoreCase;     ///< Keys are compared without regard to ASCII case
+}
+Trie_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for trees
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t TriePool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for tree nodes
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t NodePool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the character stored in the tree for a key character.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline char GetNodeChar
+(
+    const Trie_t*   triePtr,
+    char            c
+)
+{
+    return triePtr->ignoreCase ? (char)tolower((unsigned char)c) : c;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the child of a node for a character.
+ *
+ * @return
+ *      - Child node
+ *      - NULL if there is none
+ */
+//--------------------------------------------------------------------------------------------------
+static inline Node_t* GetChild
+(
+    const Node_t*   nodePtr,
+    char            c
+)
+{
+    Node_t* childPtr = nodePtr->childPtr;
+
+    while ((childPtr != NULL) && (childPtr->c != c))
+    {
+        childPtr = childPtr->siblingPtr;
+    }
+
+    return childPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a node, its siblings and all their children.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseNodes
+(
+    Node_t* nodePtr
+)
+{
+    while (nodePtr != NULL)
+    {
+        Node_t* siblingPtr = nodePtr->siblingPtr;
+
+        ReleaseNodes(nodePtr->childPtr);
+        le_mem_Release(nodePtr);
+        nodePtr = siblingPtr;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the prefix tree module.  Must be called once before creating a tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_trie_Init
+(
+    void
+)
+{
+    TriePool = le_mem_CreatePool("AtTriePool", sizeof(Trie_t));
+    le_mem_ExpandPool(TriePool, TRIE_POOL_SIZE);
+
+    NodePool = le_mem_CreatePool("AtTrieNodePool", sizeof(Node_t));
+    le_mem_ExpandPool(NodePool, NODE_POOL_SIZE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty prefix tree.
+ *
+ * @return Reference to the tree
+ */
+//--------------------------------------------------------------------------------------------------
+le_trie_Ref_t le_trie_Create
+(
+    bool ignoreCase     ///< [IN] Compare keys without regard to ASCII case
+)
+{
+    Trie_t* triePtr = le_mem_ForceAlloc(TriePool);
+
+    memset(triePtr, 0, sizeof(Trie_t));
+    triePtr->root.itemList = LE_DLS_LIST_INIT;
+    triePtr->ignoreCase = ignoreCase;
+
+    return triePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a prefix tree.  The items still in the tree are left untouched.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_trie_Delete
+(
+    le_trie_Ref_t trieRef   ///< [IN] Tree
+)
+{
+    ReleaseNodes(trieRef->root.childPtr);
+    le_mem_Release(trieRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an item to a key, after the items already added to it.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_trie_Insert
+(
+    le_trie_Ref_t   trieRef,    ///< [IN] Tree
+    const char*     keyPtr,     ///< [IN] Key, null-terminated
+    le_dls_Link_t*  linkPtr     ///< [IN] Link of the item, not in any list
+)
+{
+    Node_t* nodePtr = &trieRef->root;
+
+    for (; *keyPtr != '\0'; keyPtr++)
+    {
+        char c = GetNodeChar(trieRef, *keyPtr);
+        Node_t* childPtr = GetChild(nodePtr, c);
+
+        if (childPtr == NULL)
+        {
+            childPtr = le_mem_ForceAlloc(NodePool);
+            childPtr->childPtr = NULL;
+            childPtr->siblingPtr = nodePtr->childPtr;
+            childPtr->itemList = LE_DLS_LIST_INIT;
+            childPtr->c = c;
+            nodePtr->childPtr = childPtr;
+        }
+        nodePtr = childPtr;
+    }
+
+    le_dls_Queue(&nodePtr->itemList, linkPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove an item from a key.  The nodes left without items are freed.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the item is not in the key
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_trie_Remove
+(
+    le_trie_Ref_t   trieRef,    ///< [IN] Tree
+    const char*     keyPtr,     ///< [IN] Key, null-terminated
+    le_dls_Link_t*  linkPtr     ///< [IN] Link of the item
+)
+{
+    Node_t* nodePtr = &trieRef->root;
+    // Link to the first of the nodes that are only on the path of this key, if any
+    Node_t** cutPtr = NULL;
+
+    for (; *keyPtr != '\0'; keyPtr++)
+    {
+        char c = GetNodeChar(trieRef, *keyPtr);
+        Node_t** childRefPtr = &nodePtr->childPtr;
+
+        while ((*childRefPtr != NULL) && ((*childRefPtr)->c != c))
+        {
+            childRefPtr = &(*childRefPtr)->siblingPtr;
+        }
+        if (*childRefPtr == NULL)
+        {
+            return LE_NOT_FOUND;
+        }
+
+        if ((cutPtr == NULL) || !le_dls_IsEmpty(&nodePtr->itemList) ||
+            (nodePtr->childPtr->siblingPtr != NULL))
+        {
+            cutPtr = childRefPtr;
+        }
+        nodePtr = *childRefPtr;
+    }
+
+    if (!le_dls_IsInList(&nodePtr->itemList, linkPtr))
+    {
+        return LE_NOT_FOUND;
+    }
+    le_dls_Remove(&nodePtr->itemList, linkPtr);
+
+    if ((cutPtr != NULL) && le_dls_IsEmpty(&nodePtr->itemList) && (nodePtr->childPtr == NULL))
+    {
+        // Unlink the branch, then free it: each of its nodes has at most one child.
+        nodePtr = *cutPtr;
+        *cutPtr = nodePtr->siblingPtr;
+
+        while (nodePtr != NULL)
+        {
+            Node_t* childPtr = nodePtr->childPtr;
+
+            le_mem_Release(nodePtr);
+            nodePtr = childPtr;
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the items of a key.
+ *
+ * @return
+ *      - Items of the key
+ *      - NULL if the key holds no item
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* le_trie_Find
+(
+    le_trie_Ref_t   trieRef,    ///< [IN] Tree
+    const char*     keyPtr,     ///< [IN] Key, not necessarily null-terminated
+    size_t          keyLen      ///< [IN] Key length
+)
+{
+    Node_t* nodePtr = &trieRef->root;
+    size_t i;
+
+    for (i = 0; (i < keyLen) && (nodePtr != NULL); i++)
+    {
+        nodePtr = GetChild(nodePtr, GetNodeChar(trieRef, keyPtr[i]));
+    }
+
+    if ((nodePtr == NULL) || le_dls_IsEmpty(&nodePtr->itemList))
+    {
+        return NULL;
+    }
+
+    return &nodePtr->itemList;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call a function for each key prefixing a string, shortest key first.  The empty key prefixes
+ * any string.
+ *
+ * @return Number of keys the function was called for
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_trie_ForEachPrefix
+(
+    le_trie_Ref_t           trieRef,    ///< [IN] Tree
+    const char*             strPtr,     ///< [IN] String, not necessarily null-terminated
+    size_t                  strLen,     ///< [IN] String length
+    le_trie_PrefixFunc_t    func,       ///< [IN] Function to call
+    void*                   contextPtr  ///< [IN] Context passed to the function
+)
+{
+    Node_t* nodePtr = &trieRef->root;
+    size_t count = 0;
+    size_t i = 0;
+
+    for (;;)
+    {
+        if (!le_dls_IsEmpty(&nodePtr->itemList))
+        {
+            count++;
+            if (!func(&nodePtr->itemList, i, contextPtr))
+            {
+                break;
+            }
+        }
+
+        if (i == strLen)
+        {
+            break;
+        }
+
+        nodePtr = GetChild(nodePtr, GetNodeChar(trieRef, strPtr[i]));
+        if (nodePtr == NULL)
+        {
+            break;
+        }
+        i++;
+    }
+
+    return count;
+}
@@ -0,0 +1,134 @@
+/** @file le_trie.h
+ *
+ * Prefix tree of AT strings (response patterns, command names).
+ *
+ * Each key of the tree holds a list of items, linked through an le_dls_Link_t embedded in the
+ * item by the caller: inserting or removing an item allocates no memory other than the tree nodes
+ * of a new key.  Looking up the keys that prefix a received line costs one node visit per
+ * character of the line, however many keys are stored.
+ *
+ * A tree is not thread-safe: it must be updated and looked up in the same thread.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_LE_TRIE_INCLUDE_GUARD
+#define LEGATO_LE_TRIE_INCLUDE_GUARD
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a prefix tree.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_trie* le_trie_Ref_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype of the function called for each key prefixing a string.
+ *
+ * @return
+ *      - true to go on with the next (longer) key
+ *      - false to stop the lookup
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*le_trie_PrefixFunc_t)
+(
+    le_dls_List_t*  itemListPtr,    ///< [IN] Items of the key, in insertion order
+    size_t          keyLen,         ///< [IN] Key length
+    void*           contextPtr      ///< [IN] Context given to le_trie_ForEachPrefix()
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the prefix tree module.  Must be called once before creating a tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_trie_Init
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an empty prefix tree.
+ *
+ * @return Reference to the tree
+ */
+//--------------------------------------------------------------------------------------------------
+le_trie_Ref_t le_trie_Create
+(
+    bool ignoreCase     ///< [IN] Compare keys without regard to ASCII case
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a prefix tree.  The items still in the tree are left untouched.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_trie_Delete
+(
+    le_trie_Ref_t trieRef   ///< [IN] Tree
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an item to a key, after the items already added to it.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_trie_Insert
+(
+    le_trie_Ref_t   trieRef,    ///< [IN] Tree
+    const char*     keyPtr,     ///< [IN] Key, null-terminated
+    le_dls_Link_t*  linkPtr     ///< [IN] Link of the item, not in any list
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove an item from a key.  The nodes left without items are freed.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the item is not in the key
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_trie_Remove
+(
+    le_trie_Ref_t   trieRef,    ///< [IN] Tree
+    const char*     keyPtr,     ///< [IN] Key, null-terminated
+    le_dls_Link_t*  linkPtr     ///< [IN] Link of the item
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the items of a key.
+ *
+ * @return
+ *      - Items of the key
+ *      - NULL if the key holds no item
+ */
+//--------------------------------------------------------------------------------------------------
+le_dls_List_t* le_trie_Find
+(
+    le_trie_Ref_t   trieRef,    ///< [IN] Tree
+    const char*     keyPtr,     ///< [IN] Key, not necessarily null-terminated
+    size_t          keyLen      ///< [IN] Key length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call a function for each key prefixing a string, shortest key first.  The empty key prefixes
+ * any string.
+ *
+ * @return Number of keys the function was called for
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_trie_ForEachPrefix
+(
+    le_trie_Ref_t           trieRef,    ///< [IN] Tree
+    const char*             strPtr,     ///< [IN] String, not necessarily null-terminated
+    size_t                  strLen,     ///< [IN] String length
+    le_trie_PrefixFunc_t    func,       ///< [IN] Function to call
+    void*                   contextPtr  ///< [IN] Context passed to the function
+);
+
+#endif /* end LEGATO_LE_TRIE_INCLUDE_GUARD */
@@ -63,6 +63,7 @@
 #include "interfaces.h"
 #include "le_dev.h"
 #include "le_fd.h"
+#include "le_trie.h"
 #include "watchdogChain.h"
 
 //--------------------------------------------------------------------------------------------------
@@ -204,6 +205,7 @@ typedef struct
 {
     char            line[LE_ATDEFS_RESPONSE_MAX_BYTES]; ///< string value
     le_dls_Link_t   link;                               ///< link for list
+    le_dls_Link_t   trieLink;                           ///< link in response patterns tree
 }
 RspString_t;
 
@@ -258,10 +260,15 @@ typedef struct
     char          unsolBuffer[LE_ATDEFS_UNSOLICITED_MAX_BYTES]; ///< Unsolicited buffer
     uint32_t      lineCount;                                    ///< Unsolicited lines number
     uint32_t      lineCounter;                                  ///< Received line counter
-    bool          inProgress;                                   ///< Reception in progress
+    bool          inProgress;                                   ///< Reception in progress, i.e.
+                                                                ///< in pending unsolicited list
+    uint32_t      seqNum;                                       ///< Subscription order
     le_atClient_UnsolicitedResponseHandlerRef_t ref;            ///< Unsolicited reference
     DeviceContextPtr_t interfacePtr;                            ///< device context
     le_dls_Link_t link;                                         ///< link in Unsolicited List
+    le_dls_Link_t trieLink;                                     ///< link in unsolicited tree
+    le_dls_Link_t pendingLink;                                  ///< link in pending unsolicited
+                                                                ///< list
     le_msg_SessionRef_t sessionRef;                             ///< client session reference
 }
 Unsolicited_t;
@@ -283,6 +290,10 @@ typedef struct DeviceContext
     le_timer_Ref_t  timerRef;           ///< command timer
     le_dls_List_t   atCommandList;      ///< List of command waiting for execution
     le_dls_List_t   unsolicitedList;    ///< unsolicited command list
+    le_trie_Ref_t   unsolicitedTrie;    ///< unsolicited commands, by pattern
+    le_dls_List_t   pendingUnsolList;   ///< unsolicited commands receiving lines, in
+                                        ///< subscription order
+    uint32_t        unsolSeqNum;        ///< subscription counter
     le_sem_Ref_t    waitingSemaphore;   ///< semaphore used for synchronization
     le_atClient_DeviceRef_t ref;        ///< reference of the device context
     le_msg_SessionRef_t sessionRef;     ///< client session reference
@@ -301,6 +312,8 @@ typedef struct AtCmd
                                                                 ///< intermediate response
     le_dls_List_t          expectResponseList;                  ///< List of str  pattern for final
                                                                 ///< response
+    le_trie_Ref_t          intermediateTrie;                    ///< intermediate response patterns
+    le_trie_Ref_t          finalTrie;                           ///< final response patterns
     char                   text[LE_ATDEFS_TEXT_MAX_BYTES+1];    ///< text to be sent after >
                                                                 ///< +1 for ctrl-z
     size_t                 textSize;                            ///< size of text to send
@@ -381,77 +394,171 @@ static void UpdateTransitionManager(ClientStatePtr_t  parserStatePtr,
 static void SendLine(RxParserPtr_t charParserPtr);
 static void SendData(RxParserPtr_t charParserPtr);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is called for each subscribed unsolicited response pattern prefixing a received
+ * line.  It adds the subscriptions of the pattern to the pending unsolicited list, which is kept
+ * in subscription order.
+ *
+ * @return true, to look for longer patterns
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AddPendingUnsolicited
+(
+    le_dls_List_t* unsolListPtr,    ///< [IN] Subscriptions of the pattern
+    size_t         patternLen,      ///< [IN] Pattern length
+    void*          contextPtr       ///< [IN] Device context
+)
+{
+    DeviceContext_t* interfacePtr = contextPtr;
+    le_dls_Link_t* linkPtr = le_dls_Peek(unsolListPtr);
+
+    while (linkPtr != NULL)
+    {
+        Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, trieLink);
+
+        if (!unsolPtr->inProgress)
+        {
+            le_dls_Link_t* pendingLinkPtr = le_dls_Peek(&interfacePtr->pendingUnsolList);
+
+            while ((pendingLinkPtr != NULL) &&
+                   (CONTAINER_OF(pendingLinkPtr, Unsolicited_t, pendingLink)->seqNum <
+                    unsolPtr->seqNum))
+            {
+                pendingLinkPtr = le_dls_PeekNext(&interfacePtr->pendingUnsolList, pendingLinkPtr);
+            }
+
+            if (pendingLinkPtr != NULL)
+            {
+                le_dls_AddBefore(&interfacePtr->pendingUnsolList, pendingLinkPtr,
+                                 &unsolPtr->pendingLink);
+            }
+            else
+            {
+                le_dls_Queue(&interfacePtr->pendingUnsolList, &unsolPtr->pendingLink);
+            }
+
+            unsolPtr->inProgress = true;
+        }
+
+        linkPtr = le_dls_PeekNext(unsolListPtr, linkPtr);
+    }
+
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to check if the received data matches with a subscribed unsolicited
  * response.
  *
+ * The subscriptions whose pattern prefixes the line are looked up in the unsolicited tree, so
+ * the cost does not depend on the number of subscriptions.  They are then handled along with the
+ * multi-line subscriptions still waiting for lines, in subscription order.
+ *
  */
 //--------------------------------------------------------------------------------------------------
 static void CheckUnsolicited
 (
     char* unsolRspPtr,
     size_t stringSize,
-    le_dls_List_t *unsolListPtr
+    DeviceContext_t* interfacePtr
 )
 {
     LE_DEBUG("Start checking unsolicited");
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(unsolListPtr);
+    le_trie_ForEachPrefix(interfacePtr->unsolicitedTrie, unsolRspPtr, stringSize,
+                          AddPendingUnsolicited, interfacePtr);
+
+    le_dls_List_t* pendingListPtr = &interfacePtr->pendingUnsolList;
+    le_dls_Link_t* linkPtr = le_dls_Peek(pendingListPtr);
 
-    /* Browse all the queue while the string is not found */
     while (linkPtr != NULL)
     {
         Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr,
                                                Unsolicited_t,
-                                                link);
+                                               pendingLink);
 
-        if ((strncmp(unsolPtr->unsolRsp,unsolRspPtr,strlen(unsolPtr->unsolRsp)) == 0) ||
-            (unsolPtr->inProgress))
-        {
-            LE_DEBUG("unsol found");
-            uint32_t len =
-                (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer)) ?
-                stringSize :
-                LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer);
+        linkPtr = le_dls_PeekNext(pendingListPtr, linkPtr);
 
-            strncpy(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer), unsolRspPtr, len);
+        LE_DEBUG("unsol found");
+        uint32_t len =
+            (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer)) ?
+            stringSize :
+            LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer);
 
-            unsolPtr->inProgress = true;
-        }
+        strncpy(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer), unsolRspPtr, len);
 
-        if (unsolPtr->inProgress)
+        if ( (unsolPtr->lineCount - unsolPtr->lineCounter) == 1 )
         {
-            if ( (unsolPtr->lineCount - unsolPtr->lineCounter) == 1 )
-            {
-                unsolPtr->handlerPtr(unsolPtr->unsolBuffer, unsolPtr->contextPtr );
-                memset(unsolPtr->unsolBuffer,0,LE_ATDEFS_UNSOLICITED_MAX_BYTES);
-                unsolPtr->lineCounter = 0;
-                unsolPtr->inProgress = false;
-            }
-            else
+            le_dls_Remove(pendingListPtr, &unsolPtr->pendingLink);
+            unsolPtr->handlerPtr(unsolPtr->unsolBuffer, unsolPtr->contextPtr );
+            memset(unsolPtr->unsolBuffer,0,LE_ATDEFS_UNSOLICITED_MAX_BYTES);
+            unsolPtr->lineCounter = 0;
+            unsolPtr->inProgress = false;
+        }
+        else
+        {
+            if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - strlen(unsolPtr->unsolBuffer) > sizeof("\r\n"))
             {
-                if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - strlen(unsolPtr->unsolBuffer) > sizeof("\r\n"))
-                {
-                    snprintf(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer),
-                             sizeof("\r\n") + 1,    // +1 for Null terminator
-                             "\r\n" );
-                }
-
-                unsolPtr->lineCounter++;
+                snprintf(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer),
+                         sizeof("\r\n") + 1,    // +1 for Null terminator
+                         "\r\n" );
             }
-        }
 
-        linkPtr = le_dls_PeekNext(unsolListPtr, linkPtr);
+            unsolPtr->lineCounter++;
+        }
     }
 
     LE_DEBUG("Stop checking unsolicited");
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to find the next character of the Rx data the parser acts upon:
+ * '\\r', '\\n' or the prompt '>'.
+ *
+ * @return number of characters before it (size if there is none)
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FindSpecialChar
+(
+    const uint8_t* bufferPtr,   ///< [IN] Data to look into
+    size_t         size         ///< [IN] Data size
+)
+{
+    const uint8_t* foundPtr;
+
+    // Each search only goes up to the previous match, so the data is only scanned once in full.
+    foundPtr = memchr(bufferPtr, '\n', size);
+    if (foundPtr != NULL)
+    {
+        size = foundPtr - bufferPtr;
+    }
+
+    foundPtr = memchr(bufferPtr, '\r', size);
+    if (foundPtr != NULL)
+    {
+        size = foundPtr - bufferPtr;
+    }
+
+    foundPtr = memchr(bufferPtr, '>', size);
+    if (foundPtr != NULL)
+    {
+        size = foundPtr - bufferPtr;
+    }
+
+    return size;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to get the next event to send to the Rx parser
  *
+ * Lines are not copied: the parser only moves its indexes in the Rx buffer, and a run of
+ * characters up to the next CRLF or prompt is reported as a single PARSER_CHAR event, as the
+ * parser does not act on the following ones.
+ *
  * @return
  *      - true if a new event is detected and RX parser has to be processed
  *      - false otherwise
@@ -464,64 +571,54 @@ static bool GetNextEvent
     RxEvent_t     *evPtr
 )
 {
-    int32_t idx = charParserPtr->rxData.idx++;
-    if (idx < charParserPtr->rxData.endBuffer)
+    RxData_t* rxDataPtr = &charParserPtr->rxData;
+    int32_t idx = rxDataPtr->idx;
+
+    if ((size_t)idx >= rxDataPtr->endBuffer)
+    {
+        return false;
+    }
+
+    size_t charCount = FindSpecialChar(&rxDataPtr->buffer[idx], rxDataPtr->endBuffer - idx);
+
+    if (charCount > 0)
+    {
+        rxDataPtr->idx += charCount;
+        *evPtr = PARSER_CHAR;
+        return true;
+    }
+
+    rxDataPtr->idx++;
+
+    if (rxDataPtr->buffer[idx] == '\r')
     {
-        if (charParserPtr->rxData.buffer[idx] == '\r')
+        if ((size_t)idx + 1 >= rxDataPtr->endBuffer)
         {
-            idx = charParserPtr->rxData.idx++;
-            if (idx < charParserPtr->rxData.endBuffer)
-            {
-                if ( charParserPtr->rxData.buffer[idx] == '\n')
-                {
-                    *evPtr = PARSER_CRLF;
-                    return true;
-                }
-                else
-                {
-                    return false;
-                }
-            }
-            else
-            {
-                charParserPtr->rxData.idx--;
-                return false;
-            }
+            // The '\n' may come with the next read
+            return false;
         }
-        else if (charParserPtr->rxData.buffer[idx] == '\n')
-        {
-            if ( idx-1 > 0 )
-            {
-                if (charParserPtr->rxData.buffer[idx-1] == '\r')
-                {
-                    *evPtr = PARSER_CRLF;
-                    return true;
-                }
-                else
-                {
-                    return false;
-                }
-            }
-            else
-            {
-                return false;
-            }
-        }
-        else if (charParserPtr->rxData.buffer[idx] == '>')
+
+        rxDataPtr->idx++;
+        if (rxDataPtr->buffer[idx + 1] == '\n')
         {
-            *evPtr = PARSER_PROMPT;
+            *evPtr = PARSER_CRLF;
             return true;
         }
-        else
+        return false;
+    }
+    else if (rxDataPtr->buffer[idx] == '\n')
+    {
+        // CRLF split over two reads
+        if ((idx - 1 > 0) && (rxDataPtr->buffer[idx - 1] == '\r'))
         {
-            *evPtr = PARSER_CHAR;
+            *evPtr = PARSER_CRLF;
             return true;
         }
-    }
-    else
-    {
         return false;
     }
+
+    *evPtr = PARSER_PROMPT;
+    return true;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -559,16 +656,15 @@ static void ResetRxBuffer
 {
     if (rxParserPtr->curState == ProcessingState)
     {
-        size_t idx,sizeToCopy;
+        size_t sizeToCopy;
         sizeToCopy = rxParserPtr->rxData.endBuffer-rxParserPtr->rxData.idxLastCrLf+2;
 
         LE_DEBUG("%d sizeToCopy %zd from %d",
                             rxParserPtr->rxData.idx,sizeToCopy,rxParserPtr->rxData.idxLastCrLf-2);
 
-        for (idx = 0; idx < sizeToCopy; idx++) {
-            rxParserPtr->rxData.buffer[idx] =
-                                rxParserPtr->rxData.buffer[idx+rxParserPtr->rxData.idxLastCrLf-2];
-        }
+        memmove(rxParserPtr->rxData.buffer,
+                &rxParserPtr->rxData.buffer[rxParserPtr->rxData.idxLastCrLf-2],
+                sizeToCopy);
 
         rxParserPtr->rxData.idxLastCrLf = 2;
         rxParserPtr->rxData.endBuffer = sizeToCopy;
@@ -676,6 +772,12 @@ static void DestroyDeviceThread
         le_mem_Release(unsolPtr);
     }
 
+    if (interfacePtr->unsolicitedTrie)
+    {
+        le_trie_Delete(interfacePtr->unsolicitedTrie);
+        interfacePtr->unsolicitedTrie = NULL;
+    }
+
     while ((linkPtr=le_dls_Pop(&interfacePtr->atCommandList)) != NULL)
     {
         AtCmd_t* atCmdPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
@@ -835,6 +937,25 @@ static void StartTimer
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is called for the first response string prefixing a received line.
+ *
+ * @return false, as one matching response string is enough
+ */
+//--------------------------------------------------------------------------------------------------
+static bool StopAtFirstResponse
+(
+    le_dls_List_t* rspListPtr,      ///< [IN] Response strings
+    size_t         rspLen,          ///< [IN] Response strings length
+    void*          contextPtr       ///< [IN] Unused
+)
+{
+    LE_DEBUG("Item: %s, size: %zu",
+             CONTAINER_OF(le_dls_Peek(rspListPtr), RspString_t, trieLink)->line, rspLen);
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to check if the line matches any of response strings of the command
@@ -848,7 +969,7 @@ static bool CheckResponse
 (
     char*          receivedRspPtr,   ///< [IN] Received line pointer
     size_t         lineSize,         ///< [IN] Received line size
-    le_dls_List_t* responseListPtr,  ///< [IN] List of response strings of the command
+    le_trie_Ref_t  responseTrie,     ///< [IN] Tree of response strings of the command
     le_dls_List_t* resultListPtr,    ///< [OUT] List of matched strings after comparison
     char*          cmdNamePtr        ///< [IN] Command name pointer
 )
@@ -860,10 +981,8 @@ static bool CheckResponse
         return false;
     }
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(responseListPtr);
-
     LE_DEBUG("Command: %s, size: %zu", cmdNamePtr, strlen(cmdNamePtr));
-    LE_DEBUG("Received response: %s, size: %zu", receivedRspPtr, lineSize);
+    LE_DEBUG("Received response: %.*s, size: %zu", (int)lineSize, receivedRspPtr, lineSize);
 
     if (strncmp(cmdNamePtr, receivedRspPtr, strlen(cmdNamePtr)) == 0)
     {
@@ -871,37 +990,25 @@ static bool CheckResponse
         return false;
     }
 
-    /* Browse all the queue while the string is not found */
-    while (linkPtr != NULL)
+    if (le_trie_ForEachPrefix(responseTrie, receivedRspPtr, lineSize,
+                              StopAtFirstResponse, NULL) > 0)
     {
-        RspString_t* currStringPtr = CONTAINER_OF(linkPtr,
-                                                  RspString_t,
-                                                  link);
-        LE_DEBUG("Item: %s, size: %zu", currStringPtr->line, strlen(currStringPtr->line));
-
-        if ((strlen(currStringPtr->line) == 0) ||
-           ((lineSize >= strlen(currStringPtr->line)) &&
-           (strncmp(currStringPtr->line, receivedRspPtr, strlen(currStringPtr->line)) == 0)))
-        {
-            LE_DEBUG("Rsp matched, size: %zu", lineSize);
-
-            RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
-            memset(newStringPtr, 0, sizeof(RspString_t));
+        LE_DEBUG("Rsp matched, size: %zu", lineSize);
 
-            if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
-            {
-                LE_ERROR("String too long");
-                le_mem_Release(newStringPtr);
-                return false;
-            }
+        RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
+        memset(newStringPtr, 0, sizeof(RspString_t));
 
-            strncpy(newStringPtr->line, receivedRspPtr, lineSize);
-            newStringPtr->link = LE_DLS_LINK_INIT;
-            le_dls_Queue(resultListPtr, &(newStringPtr->link));
-            return true;
+        if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
+        {
+            LE_ERROR("String too long");
+            le_mem_Release(newStringPtr);
+            return false;
         }
 
-        linkPtr = le_dls_PeekNext(responseListPtr, linkPtr);
+        strncpy(newStringPtr->line, receivedRspPtr, lineSize);
+        newStringPtr->link = LE_DLS_LINK_INIT;
+        le_dls_Queue(resultListPtr, &(newStringPtr->link));
+        return true;
     }
 
     LE_DEBUG("Stop checking response");
@@ -963,7 +1070,7 @@ static void SendingState
             size_t lineSize = newCRLF - parserPtr->idxLastCrLf;
 
             if (CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                              &(cmdPtr->expectResponseList), &(cmdPtr->responseList),
+                              cmdPtr->finalTrie, &(cmdPtr->responseList),
                               cmdPtr->cmd))
             {
                 LE_DEBUG("Final command found");
@@ -981,7 +1088,7 @@ static void SendingState
             }
 
             CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
-                          &(cmdPtr->ExpectintermediateResponseList), &(cmdPtr->responseList),
+                          cmdPtr->intermediateTrie, &(cmdPtr->responseList),
                           cmdPtr->cmd);
             break;
         }
@@ -1052,7 +1159,7 @@ static void WaitingState
 
             CheckUnsolicited((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]),
                               lineSize,
-                              &interfacePtr->unsolicitedList);
+                              interfacePtr);
             break;
         }
         default:
@@ -1241,6 +1348,9 @@ static void AtCmdPoolDestructor
     ReleaseRspStringList(&(oldPtr->expectResponseList));
     ReleaseRspStringList(&(oldPtr->ExpectintermediateResponseList));
 
+    le_trie_Delete(oldPtr->finalTrie);
+    le_trie_Delete(oldPtr->intermediateTrie);
+
     le_ref_DeleteRef(CmdRefMap, oldPtr->ref);
 }
 
@@ -1294,6 +1404,18 @@ static void UnsolicitedPoolDestructor
         le_dls_Remove(listPtr, linkPtr);
     }
 
+    if (unsolicitedPtr->inProgress)
+    {
+        le_dls_Remove(&unsolicitedPtr->interfacePtr->pendingUnsolList,
+                      &unsolicitedPtr->pendingLink);
+    }
+
+    if (unsolicitedPtr->interfacePtr->unsolicitedTrie)
+    {
+        le_trie_Remove(unsolicitedPtr->interfacePtr->unsolicitedTrie, unsolicitedPtr->unsolRsp,
+                       &unsolicitedPtr->trieLink);
+    }
+
     // Delete the reference for unsolicited structure pointer.
     le_ref_DeleteRef(UnsolRefMap, unsolicitedPtr->ref);
 }
@@ -1369,6 +1491,8 @@ le_atClient_CmdRef_t le_atClient_Create
 
     cmdPtr->ExpectintermediateResponseList  = LE_DLS_LIST_INIT;
     cmdPtr->expectResponseList              = LE_DLS_LIST_INIT;
+    cmdPtr->intermediateTrie                = le_trie_Create(false);
+    cmdPtr->finalTrie                       = le_trie_Create(false);
     cmdPtr->textSize                        = 0;
     cmdPtr->timeout                         = LE_ATDEFS_COMMAND_DEFAULT_TIMEOUT;
     cmdPtr->interfacePtr                    = NULL;
@@ -1538,6 +1662,8 @@ le_result_t le_atClient_SetIntermediateResponse
             newStringPtr->link = LE_DLS_LINK_INIT;
 
             le_dls_Queue(&(cmdPtr->ExpectintermediateResponseList), &(newStringPtr->link));
+            le_trie_Insert(cmdPtr->intermediateTrie, newStringPtr->line,
+                           &(newStringPtr->trieLink));
 
             interPtr = strtok_r(NULL, "|", &savePtr);
         }
@@ -1548,6 +1674,7 @@ le_result_t le_atClient_SetIntermediateResponse
         memset(newStringPtr, 0, sizeof(RspString_t));
         newStringPtr->link = LE_DLS_LINK_INIT;
         le_dls_Queue(&(cmdPtr->ExpectintermediateResponseList), &(newStringPtr->link));
+        le_trie_Insert(cmdPtr->intermediateTrie, newStringPtr->line, &(newStringPtr->trieLink));
 
     }
 
@@ -1609,6 +1736,7 @@ le_result_t le_atClient_SetFinalResponse
             newStringPtr->link = LE_DLS_LINK_INIT;
 
             le_dls_Queue(&(cmdPtr->expectResponseList),&(newStringPtr->link));
+            le_trie_Insert(cmdPtr->finalTrie, newStringPtr->line, &(newStringPtr->trieLink));
 
             respPtr = strtok_r(NULL, "|", &savePtr);
         }
@@ -2049,12 +2177,17 @@ le_atClient_UnsolicitedResponseHandlerRef_t le_atClient_AddUnsolicitedResponseHa
     unsolicitedPtr->handlerPtr = handlerPtr;
     unsolicitedPtr->contextPtr = contextPtr;
     unsolicitedPtr->inProgress = false;
+    unsolicitedPtr->seqNum = interfacePtr->unsolSeqNum++;
     unsolicitedPtr->ref = le_ref_CreateRef(UnsolRefMap, unsolicitedPtr);
     unsolicitedPtr->interfacePtr = interfacePtr;
     unsolicitedPtr->link = LE_DLS_LINK_INIT;
+    unsolicitedPtr->trieLink = LE_DLS_LINK_INIT;
+    unsolicitedPtr->pendingLink = LE_DLS_LINK_INIT;
     unsolicitedPtr->sessionRef = le_atClient_GetClientSessionRef();
 
     le_dls_Queue(&interfacePtr->unsolicitedList, &unsolicitedPtr->link);
+    le_trie_Insert(interfacePtr->unsolicitedTrie, unsolicitedPtr->unsolRsp,
+                   &unsolicitedPtr->trieLink);
 
     return unsolicitedPtr->ref;
 }
@@ -2168,6 +2301,7 @@ le_atClient_DeviceRef_t le_atClient_Start
 
     LE_DEBUG("Create a new interface for '%d'", fd);
     newInterfacePtr->device.fd = fd;
+    newInterfacePtr->unsolicitedTrie = le_trie_Create(false);
 
     snprintf(name,THREAD_NAME_MAX_LENGTH,"atCommandClient-%d",threatCounter);
     newInterfacePtr->threadRef = le_thread_Create(name,DeviceThread,newInterfacePtr);
@@ -2228,6 +2362,9 @@ le_result_t le_atClient_Stop
 //--------------------------------------------------------------------------------------------------
 COMPONENT_INIT
 {
+    // Prefix trees of response patterns
+    le_trie_Init();
+
     // Device pool allocation
     DevicesPool = le_mem_CreatePool("AtClientDevicesPool",sizeof(DeviceContext_t));
     le_mem_ExpandPool(DevicesPool,DEVICE_POOL_SIZE);
@@ -13,6 +13,7 @@
 #endif
 #include "le_atServer_local.h"
 #include "le_dev.h"
+#include "le_trie.h"
 #include "watchdogChain.h"
 
 //--------------------------------------------------------------------------------------------------
@@ -36,13 +37,6 @@
 //--------------------------------------------------------------------------------------------------
 #define CMD_STRING_TYPICAL_BYTES 32
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Command parameters pool size
- */
-//--------------------------------------------------------------------------------------------------
-#define PARAM_POOL_SIZE       20
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Command responses pool size
@@ -225,13 +219,6 @@ static le_mem_PoolRef_t    DevicesPool;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t  AtCommandsPool;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Pool for parameter string
- */
-//--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t  ParamStringPool;
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Pool for response
@@ -256,10 +243,10 @@ static le_ref_MapRef_t   SubscribedCmdRefMap;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Map for AT commands
+ * Index of the AT commands by name
  */
 //--------------------------------------------------------------------------------------------------
-static le_hashmap_Ref_t   CmdHashMap;
+static le_trie_Ref_t   CmdTrie;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -503,19 +490,6 @@ typedef struct
 }
 UserErrorCode_t;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * structure used to describe a parameter.
- *
- */
-//--------------------------------------------------------------------------------------------------
-typedef struct
-{
-    char            param[LE_ATDEFS_PARAMETER_MAX_BYTES];   ///< string value
-    le_dls_Link_t   link;                                   ///< link for list
-}
-ParamString_t;
-
 //--------------------------------------------------------------------------------------------------
 /**
  * AT command response structure.
@@ -608,7 +582,11 @@ typedef struct
     char*                   cmdName;                                ///< Command to send
     le_atServer_AvailableDevice_t availableDevice;                  ///< device to send unsol rsp
     le_atServer_Type_t      type;                                   ///< cmd type
-    le_dls_List_t           paramList;                              ///< parameters list
+    char*                   paramPtr;                               ///< first parameter, the
+                                                                    ///< others follow it, each
+                                                                    ///< null-terminated, in the
+                                                                    ///< foundCmd buffer
+    uint32_t                paramCount;                             ///< number of parameters
     bool                    processing;                             ///< is command processing
     le_atServer_DeviceRef_t deviceRef;                              ///< device refrence
 #if !MK_CONFIG_DISABLE_AT_BRIDGE
@@ -622,6 +600,7 @@ typedef struct
     le_atServer_CommandHandlerFunc_t handlerFunc;                   ///< Handler associated with the
                                                                     ///< AT command
     void*                   handlerContextPtr;                      ///< client handler context
+    le_dls_Link_t           trieLink;                               ///< link in CmdTrie
 }
 ATCmdSubscribed_t;
 
@@ -643,7 +622,16 @@ typedef struct
                                                                     ///< in foundCmd buffer
     char*                   lastCharPtr;                            ///< last received character
                                                                     ///< position in foundCmd buffer
+    char*                   paramWritePtr;                          ///< next parameter character
+                                                                    ///< position in foundCmd buffer
+    char*                   paramStartPtr;                          ///< current parameter position
+                                                                    ///< in foundCmd buffer
     ATCmdSubscribed_t*      currentCmdPtr;                          ///< current command context
+    bool                    dispatching;                            ///< is a command handler
+                                                                    ///< being called
+    bool                    parseNext;                              ///< has the current command
+                                                                    ///< been completed during its
+                                                                    ///< handler call
 }
 CmdParser_t;
 
@@ -785,23 +773,6 @@ LE_MEM_DEFINE_STATIC_POOL(AtServerCommandStringsPool,
 static le_mem_PoolRef_t AtCommandStringsPool;
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Static pool for parameter string
- */
-//--------------------------------------------------------------------------------------------------
-LE_MEM_DEFINE_STATIC_POOL(ParamString,
-                          PARAM_POOL_SIZE,
-                          sizeof(ParamString_t));
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Pool for parameter string
- */
-//--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t  ParamStringPool;
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Static pool for response
@@ -884,18 +855,10 @@ static le_ref_MapRef_t   SubscribedCmdRefMap;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Static hashmap for AT commands
- */
-//--------------------------------------------------------------------------------------------------
-LE_HASHMAP_DEFINE_STATIC(CmdHashMap, CMD_POOL_SIZE);
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Map for AT commands
+ * Index of the AT commands by name
  */
 //--------------------------------------------------------------------------------------------------
-static le_hashmap_Ref_t   CmdHashMap;
+static le_trie_Ref_t   CmdTrie;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -1042,6 +1005,173 @@ CmdParserFunc_t CmdParserTab[PARSE_MAX][PARSE_MAX] =
                          }
 };
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up an AT command by name, without regard to case.
+ *
+ * @return
+ *      - AT command
+ *      - NULL if no command is registered with this name
+ */
+//--------------------------------------------------------------------------------------------------
+static ATCmdSubscribed_t* FindCmd
+(
+    const char* namePtr,    ///< [IN] Name, not necessarily null-terminated
+    size_t      nameLen     ///< [IN] Name length
+)
+{
+    le_dls_List_t* cmdListPtr = le_trie_Find(CmdTrie, namePtr, nameLen);
+
+    if (cmdListPtr == NULL)
+    {
+        return NULL;
+    }
+
+    // A name is registered once: le_atServer_Create() returns the existing command otherwise.
+    return CONTAINER_OF(le_dls_Peek(cmdListPtr), ATCmdSubscribed_t, trieLink);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Keep the longest basic format command name prefixing a string (called by
+ * le_trie_ForEachPrefix).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool KeepLongestBasicCmd
+(
+    le_dls_List_t*  cmdListPtr,     ///< [IN] Commands of the prefix
+    size_t          nameLen,        ///< [IN] Prefix length
+    void*           contextPtr      ///< [OUT] Longest command found so far
+)
+{
+    // "AT" alone is not a basic format command
+    if (nameLen > 2)
+    {
+        *(ATCmdSubscribed_t**)contextPtr = CONTAINER_OF(le_dls_Peek(cmdListPtr),
+                                                         ATCmdSubscribed_t,
+                                                         trieLink);
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the current command is processed for the device of a parser.
+ *
+ * The parameters of a command are stored in the foundCmd buffer of the device processing it, so
+ * they must not be touched by another device parsing the same command.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsCmdOwner
+(
+    CmdParser_t* cmdParserPtr
+)
+{
+    DeviceContext_t* devPtr = CONTAINER_OF(cmdParserPtr, DeviceContext_t, cmdParser);
+
+    return (cmdParserPtr->currentCmdPtr->processing) &&
+           (cmdParserPtr->currentCmdPtr->deviceRef == devPtr->ref);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a new parameter of the current command.
+ *
+ * Parameters are stored in place, in the foundCmd buffer, from the beginning of the command:
+ * the name is not needed anymore once the command is found, and a parameter never takes more
+ * characters than it is received with.  The name and the separators leave enough room to
+ * null-terminate each parameter without overwriting any character still to be parsed, nor the
+ * two characters before the next concatenated command, where "AT" is written to parse it.
+ *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_BUSY          The command is processed for another device.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartParam
+(
+    CmdParser_t* cmdParserPtr
+)
+{
+    ATCmdSubscribed_t* cmdPtr = cmdParserPtr->currentCmdPtr;
+
+    if (!IsCmdOwner(cmdParserPtr))
+    {
+        LE_ERROR("AT command processed for another device");
+        return LE_BUSY;
+    }
+
+    if (cmdPtr->paramCount == 0)
+    {
+        cmdPtr->paramPtr = cmdParserPtr->currentAtCmdPtr;
+        cmdParserPtr->paramWritePtr = cmdParserPtr->currentAtCmdPtr;
+    }
+    else
+    {
+        // Terminate the previous parameter
+        *cmdParserPtr->paramWritePtr++ = '\0';
+    }
+
+    cmdParserPtr->paramStartPtr = cmdParserPtr->paramWritePtr;
+    cmdPtr->paramCount++;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a character to the current parameter.
+ *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_OVERFLOW      The parameter is too long.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PutParamChar
+(
+    CmdParser_t* cmdParserPtr,
+    char c
+)
+{
+    if (cmdParserPtr->paramWritePtr - cmdParserPtr->paramStartPtr >= LE_ATDEFS_PARAMETER_MAX_LEN)
+    {
+        LE_ERROR("Parameter size exceeds %d bytes", LE_ATDEFS_PARAMETER_MAX_LEN);
+        return LE_OVERFLOW;
+    }
+
+    *cmdParserPtr->paramWritePtr++ = c;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the length of the current parameter.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t GetParamLen
+(
+    CmdParser_t* cmdParserPtr
+)
+{
+    return cmdParserPtr->paramWritePtr - cmdParserPtr->paramStartPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop the parameters of a command.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void ClearParams
+(
+    ATCmdSubscribed_t* cmdPtr
+)
+{
+    cmdPtr->paramPtr = NULL;
+    cmdPtr->paramCount = 0;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is the destructor for ATCmdSubscribed_t struct
@@ -1054,23 +1184,13 @@ static void AtCmdPoolDestructor
 )
 {
     ATCmdSubscribed_t* cmdPtr = commandPtr;
-    le_dls_Link_t* linkPtr;
 
     LE_DEBUG("AT command destructor for '%s'", cmdPtr->cmdName);
 
-    // cleanup the hashmap
-    le_hashmap_Remove(CmdHashMap, cmdPtr->cmdName);
+    // cleanup the index
+    le_trie_Remove(CmdTrie, cmdPtr->cmdName, &cmdPtr->trieLink);
     le_mem_Release(cmdPtr->cmdName);
 
-    // cleanup ParamList dls pool
-    while((linkPtr = le_dls_Pop(&cmdPtr->paramList)) != NULL)
-    {
-        ParamString_t *paramPtr = CONTAINER_OF(linkPtr,
-                                    ParamString_t,
-                                    link);
-        le_mem_Release(paramPtr);
-    }
-
     le_ref_DeleteRef(SubscribedCmdRefMap, cmdPtr->cmdRef);
 }
 
@@ -1490,8 +1610,7 @@ static le_result_t CreateModemCommand
         return LE_FAULT;
     }
 
-    cmdParserPtr->currentCmdPtr = le_hashmap_Get(CmdHashMap,
-                                                 atCmdPtr);
+    cmdParserPtr->currentCmdPtr = FindCmd(atCmdPtr, strlen(atCmdPtr));
 
     if ( cmdParserPtr->currentCmdPtr == NULL )
     {
@@ -1536,7 +1655,8 @@ static le_result_t GetAtCmdContext
 
     if (cmdParserPtr->currentCmdPtr == NULL)
     {
-        cmdParserPtr->currentCmdPtr = le_hashmap_Get(CmdHashMap, cmdParserPtr->currentAtCmdPtr);
+        cmdParserPtr->currentCmdPtr = FindCmd(cmdParserPtr->currentAtCmdPtr,
+                                              strlen(cmdParserPtr->currentAtCmdPtr));
 
         if ( cmdParserPtr->currentCmdPtr == NULL )
         {
@@ -1681,10 +1801,13 @@ static le_result_t ParseBasicCmdParam
     CmdParser_t* cmdParserPtr
 )
 {
-    ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
-    memset(paramPtr,0,sizeof(ParamString_t));
-    uint32_t index = 0;
     bool tokenQuote = false;
+    le_result_t res = StartParam(cmdParserPtr);
+
+    if (res != LE_OK)
+    {
+        return res;
+    }
 
     while ( cmdParserPtr->currentCharPtr <= cmdParserPtr->lastCharPtr )
     {
@@ -1703,11 +1826,7 @@ static le_result_t ParseBasicCmdParam
             // If "bridge command", keep the quote
             if ((cmdParserPtr->currentCmdPtr)->bridgeCmd)
             {
-                if (index < sizeof(paramPtr->param) -1)
-                {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-                }
-                else
+                if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
                 {
                     return LE_OVERFLOW;
                 }
@@ -1718,11 +1837,7 @@ static le_result_t ParseBasicCmdParam
         {
             if ((tokenQuote) || ( IS_NUMBER(*cmdParserPtr->currentCharPtr) ))
             {
-                if (index < sizeof(paramPtr->param) -1)
-                {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-                }
-                else
+                if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
                 {
                     return LE_OVERFLOW;
                 }
@@ -1742,7 +1857,6 @@ static le_result_t ParseBasicCmdParam
     }
 
     cmdParserPtr->currentCmdPtr->type = LE_ATSERVER_TYPE_PARA;
-    le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
 
     return LE_OK;
 }
@@ -1763,11 +1877,14 @@ static le_result_t ParseBasicDCmdParam
                                       '@',';','I','i','G','g'};
 
     int i;
-    int index = 0;
-    ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
     bool dialingFromPhonebook = false;
-    memset(paramPtr,0,sizeof(ParamString_t));
     bool tokenQuote = false;
+    le_result_t res = StartParam(cmdParserPtr);
+
+    if (res != LE_OK)
+    {
+        return res;
+    }
 
     LE_DEBUG("%s", cmdParserPtr->currentCharPtr);
 
@@ -1791,11 +1908,7 @@ static le_result_t ParseBasicDCmdParam
                     tokenQuote = true;
                 }
 
-                if (index < sizeof(paramPtr->param) -1)
-                {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-                }
-                else
+                if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
                 {
                     return LE_OVERFLOW;
                 }
@@ -1804,11 +1917,7 @@ static le_result_t ParseBasicDCmdParam
             {
                 if (tokenQuote)
                 {
-                    if (index < sizeof(paramPtr->param) -1)
-                    {
-                        paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-                    }
-                    else
+                    if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
                     {
                         return LE_OVERFLOW;
                     }
@@ -1818,22 +1927,16 @@ static le_result_t ParseBasicDCmdParam
                     if ( (*cmdParserPtr->currentCharPtr == 'i') ||
                          ( *cmdParserPtr->currentCharPtr == 'g') )
                     {
-                        if (index < sizeof(paramPtr->param) -1)
-                        {
-                            paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-                        }
-                        else
+                        if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
                         {
                             return LE_OVERFLOW;
                         }
                     }
                     else
                     {
-                        if (index < sizeof(paramPtr->param) -1)
-                        {
-                            paramPtr->param[index++] = toupper(*cmdParserPtr->currentCharPtr);
-                        }
-                        else
+                        char c = toupper(*cmdParserPtr->currentCharPtr);
+
+                        if (PutParamChar(cmdParserPtr, c) != LE_OK)
                         {
                             return LE_OVERFLOW;
                         }
@@ -1857,11 +1960,7 @@ static le_result_t ParseBasicDCmdParam
                 {
                     if (*testCharPtr == charTabPtr[i])
                     {
-                        if (index < sizeof(paramPtr->param) -1)
-                        {
-                            paramPtr->param[index++] = *testCharPtr;
-                        }
-                        else
+                        if (PutParamChar(cmdParserPtr, *testCharPtr) != LE_OK)
                         {
                             return LE_OVERFLOW;
                         }
@@ -1896,16 +1995,14 @@ static le_result_t ParseBasicDCmdParam
         cmdParserPtr->currentCharPtr++;
     }
 
-    if (index == 0)
+    if (GetParamLen(cmdParserPtr) == 0)
     {
         LE_ERROR("empty phone number");
-        le_mem_Release(paramPtr);
         return LE_FAULT;
     }
 
 end:
     cmdParserPtr->currentCmdPtr->type = LE_ATSERVER_TYPE_PARA;
-    le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
 
     return LE_OK;
 }
@@ -1947,8 +2044,9 @@ static le_result_t ParseBasicEnd
     CmdParser_t* cmdParserPtr
 )
 {
+    // "AT" is written there by ParseAtCmd() once the current command is completed, as its
+    // parameters may be stored there until then.
     cmdParserPtr->currentAtCmdPtr = cmdParserPtr->currentCharPtr-2;
-    memcpy(cmdParserPtr->currentAtCmdPtr, "AT", 2);
 
     // Put the index at the correct place for next parsing
     cmdParserPtr->currentCharPtr = cmdParserPtr->currentAtCmdPtr;
@@ -1964,19 +2062,30 @@ static le_result_t ParseBasicEnd
 /**
  * Basic format command found, update command context
  *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_BUSY          The command is currently in processing.
  */
 //--------------------------------------------------------------------------------------------------
-static void BasicCmdFound
+static le_result_t BasicCmdFound
 (
     CmdParser_t* cmdParserPtr
 )
 {
     DeviceContext_t* devPtr = CONTAINER_OF(cmdParserPtr, DeviceContext_t, cmdParser);
 
+    if (cmdParserPtr->currentCmdPtr->processing)
+    {
+        LE_DEBUG("AT command currently in processing");
+        return LE_BUSY;
+    }
+
     cmdParserPtr->currentCmdPtr->deviceRef = devPtr->ref;
     cmdParserPtr->currentCmdPtr->type = LE_ATSERVER_TYPE_ACT;
     cmdParserPtr->currentCmdPtr->processing = true;
     cmdParserPtr->currentCmdPtr->isBasicCommand = true;
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1999,31 +2108,23 @@ static le_result_t ParseBasic
         cmdParserPtr->currentCharPtr++;
     }
 
-    uint32_t len = cmdParserPtr->currentCharPtr-cmdParserPtr->currentAtCmdPtr+1;
-#if !MK_CONFIG_DISABLE_AT_BRIDGE
-    char* initialPosPtr = cmdParserPtr->currentCharPtr;
-#endif
-    char atCmd[len];
-    memset(atCmd,0,len);
-    strncpy(atCmd, cmdParserPtr->currentAtCmdPtr, len-1);
+    // Look for the longest command name prefixing the characters found
+    size_t len = cmdParserPtr->currentCharPtr - cmdParserPtr->currentAtCmdPtr;
+    ATCmdSubscribed_t* cmdPtr = NULL;
+
+    le_trie_ForEachPrefix(CmdTrie, cmdParserPtr->currentAtCmdPtr, len,
+                          KeepLongestBasicCmd, &cmdPtr);
 
-    while (strlen(atCmd) > 2)
+    if (cmdPtr != NULL)
     {
-        cmdParserPtr->currentCmdPtr = le_hashmap_Get(CmdHashMap, atCmd);
+        cmdParserPtr->currentCmdPtr = cmdPtr;
+        cmdParserPtr->currentCharPtr = cmdParserPtr->currentAtCmdPtr + strlen(cmdPtr->cmdName);
 
-        if ( cmdParserPtr->currentCmdPtr == NULL )
-        {
-            atCmd[strlen(atCmd)-1] = '\0';
-            cmdParserPtr->currentCharPtr--;
-        }
-        else
-        {
-            BasicCmdFound(cmdParserPtr);
+        le_result_t res = BasicCmdFound(cmdParserPtr);
 
-            cmdParserPtr->currentCharPtr--;
+        cmdParserPtr->currentCharPtr--;
 
-            return LE_OK;
-        }
+        return res;
     }
 
 #if !MK_CONFIG_DISABLE_AT_BRIDGE
@@ -2031,10 +2132,10 @@ static le_result_t ParseBasic
 
     if ( devPtr->bridgeRef )
     {
-        //Reset the pointer to its initial value
-        cmdParserPtr->currentCharPtr = initialPosPtr;
+        char atCmd[len+1];
 
-        strncpy(atCmd, cmdParserPtr->currentAtCmdPtr, len-1);
+        memcpy(atCmd, cmdParserPtr->currentAtCmdPtr, len);
+        atCmd[len] = '\0';
 
         if (( CreateModemCommand(cmdParserPtr,
                                  atCmd,
@@ -2045,11 +2146,11 @@ static le_result_t ParseBasic
             return LE_FAULT;
         }
 
-        BasicCmdFound(cmdParserPtr);
+        le_result_t res = BasicCmdFound(cmdParserPtr);
 
         cmdParserPtr->currentCharPtr--;
 
-        return LE_OK;
+        return res;
     }
 #endif /* end !MK_CONFIG_DISABLE_AT_BRIDGE */
 
@@ -2089,18 +2190,22 @@ static le_result_t ParseParam
     CmdParser_t* cmdParserPtr
 )
 {
-    uint32_t index = 0;
     bool tokenQuote = false;
     bool loop = true;
-    ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
-    memset(paramPtr, 0, sizeof(ParamString_t));
 
-    if (le_dls_NumLinks(&(cmdParserPtr->currentCmdPtr->paramList)) != 0)
+    if (cmdParserPtr->currentCmdPtr->paramCount != 0)
     {
         // bypass comma (not done for the first param)
         cmdParserPtr->currentCharPtr++;
     }
 
+    le_result_t res = StartParam(cmdParserPtr);
+
+    if (res != LE_OK)
+    {
+        return res;
+    }
+
     if (( cmdParserPtr->currentCharPtr > cmdParserPtr->lastCharPtr ) ||
         ( *cmdParserPtr->currentCharPtr == AT_TOKEN_COMMA ) ||
         ( *cmdParserPtr->currentCharPtr == AT_TOKEN_SEMICOLON ))
@@ -2111,13 +2216,6 @@ static le_result_t ParseParam
 
     while (loop)
     {
-        if (LE_ATDEFS_PARAMETER_MAX_BYTES <= index)
-        {
-            LE_ERROR("Parameter size exceeds %d bytes", LE_ATDEFS_PARAMETER_MAX_BYTES);
-            le_mem_Release(paramPtr);
-            return LE_FAULT;
-        }
-
         if ( IS_QUOTE(*cmdParserPtr->currentCharPtr) )
         {
             if (tokenQuote)
@@ -2133,11 +2231,7 @@ static le_result_t ParseParam
             // If "bridge command", keep the quote
             if ((cmdParserPtr->currentCmdPtr)->bridgeCmd)
             {
-                if (index < sizeof(paramPtr->param) -1)
-                {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-                }
-                else
+                if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
                 {
                     return LE_OVERFLOW;
                 }
@@ -2154,18 +2248,13 @@ static le_result_t ParseParam
 
             if ((tokenQuote) || ( IS_PARAM_CHAR(*cmdParserPtr->currentCharPtr) ))
             {
-                if (index < sizeof(paramPtr->param) -1)
-                {
-                    paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-                }
-                else
+                if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
                 {
                     return LE_OVERFLOW;
                 }
             }
             else
             {
-                le_mem_Release(paramPtr);
                 return LE_FAULT;
             }
         }
@@ -2186,8 +2275,6 @@ static le_result_t ParseParam
         }
     }
 
-    le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
-
     return LE_OK;
 }
 
@@ -2206,19 +2293,18 @@ static le_result_t ParseReadParam
     {
         // For AT extended format read command like "AT+<command>?[<value>]", we put <value>
         // into the parameter 0 if exists.
-        uint32_t index = 0;
         bool loop = true;
-        ParamString_t* paramPtr = le_mem_ForceAlloc(ParamStringPool);
-        memset(paramPtr, 0, sizeof(ParamString_t));
+        le_result_t res = StartParam(cmdParserPtr);
+
+        if (res != LE_OK)
+        {
+            return res;
+        }
 
         // Go through paramater buffers until ";" or last char.
         while (loop)
         {
-            if (index < sizeof(paramPtr->param) -1)
-            {
-                paramPtr->param[index++] = *cmdParserPtr->currentCharPtr;
-            }
-            else
+            if (PutParamChar(cmdParserPtr, *cmdParserPtr->currentCharPtr) != LE_OK)
             {
                 return LE_OVERFLOW;
             }
@@ -2232,7 +2318,6 @@ static le_result_t ParseReadParam
                 cmdParserPtr->currentCharPtr--;
             }
         }
-        le_dls_Queue(&(cmdParserPtr->currentCmdPtr->paramList),&(paramPtr->link));
         return LE_OK;
     }
     return LE_FAULT;
@@ -2288,13 +2373,13 @@ static le_result_t ParseSemicolon
         return LE_FAULT;
     }
 
-    // Concatenate command: prepare the buffer for the next parsing
+    // Concatenate command: prepare the buffer for the next parsing. "AT" is written before the
+    // next command by ParseAtCmd() once the current one is completed, as its parameters may be
+    // stored there until then.
     // Be sure to not write outside the buffer
     cmdParserPtr->currentCharPtr--;
     if (cmdParserPtr->currentCharPtr >= cmdParserPtr->foundCmd)
     {
-        memcpy(cmdParserPtr->currentCharPtr, "AT", 2);
-
         // Put the index at the correct place for next parsing
         cmdParserPtr->currentAtCmdPtr = cmdParserPtr->currentCharPtr;
         cmdParserPtr->currentCharPtr--;
@@ -2309,21 +2394,16 @@ static le_result_t ParseSemicolon
 
 //--------------------------------------------------------------------------------------------------
 /**
- * AT parser main function
+ * Parse the next AT command of the command line and call its handler, or send the final response
+ * if the command line is over.
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void ParseAtCmd
+static void ParseNextAtCmd
 (
     DeviceContext_t* devPtr
 )
 {
-    if (devPtr == NULL)
-    {
-        LE_ERROR("Bad device");
-        return;
-    }
-
     CmdParser_t* cmdParserPtr = &devPtr->cmdParser;
 
     cmdParserPtr->cmdParser = PARSE_CMDNAME;
@@ -2339,6 +2419,9 @@ static void ParseAtCmd
         return;
     }
 
+    // The parameters of the previous concatenated command, if any, are not needed anymore
+    memcpy(cmdParserPtr->currentAtCmdPtr, "AT", 2);
+
     while (( cmdParserPtr->cmdParser != PARSE_SEMICOLON ) &&
            ( cmdParserPtr->cmdParser != PARSE_LAST ))
     {
@@ -2443,26 +2526,15 @@ static void ParseAtCmd
 
             if (res == LE_BUSY)
             {
+                // The command and its parameters belong to another device
                 LE_INFO("AT command busy");
             }
-            else
+            else if (cmdParserPtr->currentCmdPtr)
             {
-                if (cmdParserPtr->currentCmdPtr)
-                {
-                    cmdParserPtr->currentCmdPtr->processing = false;
-                }
-            }
+                cmdParserPtr->currentCmdPtr->processing = false;
 
-            // Incurred error in parsing AT command. Clear all parsed parameters.
-            if (cmdParserPtr->currentCmdPtr)
-            {
-                ATCmdSubscribed_t* cmdPtr = cmdParserPtr->currentCmdPtr;
-                le_dls_Link_t* linkPtr;
-                while ((linkPtr = le_dls_Pop(&cmdPtr->paramList)) != NULL)
-                {
-                    ParamString_t *paraPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-                    le_mem_Release(paraPtr);
-                }
+                // Incurred error in parsing AT command. Clear all parsed parameters.
+                ClearParams(cmdParserPtr->currentCmdPtr);
             }
 
             const int sizeMax = LE_ATDEFS_RESPONSE_MAX_BYTES;
@@ -2480,11 +2552,17 @@ static void ParseAtCmd
     {
         ATCmdSubscribed_t* cmdPtr = cmdParserPtr->currentCmdPtr;
 
+        if ((cmdPtr->paramCount != 0) && IsCmdOwner(cmdParserPtr))
+        {
+            // Terminate the last parameter
+            *cmdParserPtr->paramWritePtr = '\0';
+        }
+
         if (cmdPtr->handlerFunc)
         {
             (cmdPtr->handlerFunc)( cmdPtr->cmdRef,
                                    cmdPtr->type,
-                                   le_dls_NumLinks(&(cmdPtr->paramList)),
+                                   cmdPtr->paramCount,
                                    cmdPtr->handlerContextPtr );
         }
         else
@@ -2493,12 +2571,7 @@ static void ParseAtCmd
             cmdParserPtr->currentCmdPtr->processing = false;
 
             // Clean AT command context, not in use now
-            le_dls_Link_t* linkPtr;
-            while ((linkPtr=le_dls_Pop(&cmdPtr->paramList)) != NULL)
-            {
-                ParamString_t *paraPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-                le_mem_Release(paraPtr);
-            }
+            ClearParams(cmdPtr);
 
             goto sendErrorRsp;
         }
@@ -2513,6 +2586,49 @@ sendErrorRsp:
     SendFinalRsp(devPtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * AT parser main function
+ *
+ * The concatenated commands of a command line are parsed one after the other, each one once the
+ * previous one is completed.  When a handler completes its command before returning, the next
+ * command is parsed here rather than from le_atServer_SendFinalResultCode(), so that a command
+ * line is processed in a loop instead of recursively.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseAtCmd
+(
+    DeviceContext_t* devPtr
+)
+{
+    if (devPtr == NULL)
+    {
+        LE_ERROR("Bad device");
+        return;
+    }
+
+    CmdParser_t* cmdParserPtr = &devPtr->cmdParser;
+
+    if (cmdParserPtr->dispatching)
+    {
+        // Called back by the handler of the current command: parse the next one on return
+        cmdParserPtr->parseNext = true;
+        return;
+    }
+
+    cmdParserPtr->dispatching = true;
+
+    do
+    {
+        cmdParserPtr->parseNext = false;
+        ParseNextAtCmd(devPtr);
+    }
+    while (cmdParserPtr->parseNext);
+
+    cmdParserPtr->dispatching = false;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Parser incoming characters
@@ -3394,7 +3510,7 @@ le_atServer_CmdRef_t le_atServer_Create
 )
 {
     // Search if the command already exists
-    ATCmdSubscribed_t* cmdPtr = le_hashmap_Get(CmdHashMap, namePtr);
+    ATCmdSubscribed_t* cmdPtr = FindCmd(namePtr, strlen(namePtr));
 
     // if the command exists return its reference
     if (cmdPtr)
@@ -3421,10 +3537,10 @@ le_atServer_CmdRef_t le_atServer_Create
 
     cmdPtr->cmdRef = le_ref_CreateRef(SubscribedCmdRefMap, cmdPtr);
 
-    le_hashmap_Put(CmdHashMap, cmdPtr->cmdName, cmdPtr);
+    cmdPtr->trieLink = LE_DLS_LINK_INIT;
+    le_trie_Insert(CmdTrie, cmdPtr->cmdName, &cmdPtr->trieLink);
 
     cmdPtr->availableDevice = LE_ATSERVER_ALL_DEVICES;
-    cmdPtr->paramList = LE_DLS_LIST_INIT;
 
     // NOTE: The 'sessionRef' is NULL if the command is created by bridge device because
     // we are not in IPC command environment. In this case, "sessionRef" is set when the
@@ -3486,35 +3602,25 @@ le_result_t le_atServer_Delete
  * handler.
  */
 //--------------------------------------------------------------------------------------------------
-static bool CallCmdRegistrationHandler
+static void CallCmdRegistrationHandler
 (
-    const void* keyPtr,
-    const void* valuePtr,
-    void* contextPtr
+    const ATCmdSubscribed_t* cmdPtr,
+    CmdRegHandlerInfo_t* handlerInfoPtr
 )
 {
-    if (valuePtr == NULL)
+    if (cmdPtr == NULL)
     {
-        LE_WARN("AT command '%s' is not properly created", (char*)keyPtr);
-        return true;
+        LE_WARN("AT command is not properly created");
+        return;
     }
 
-    const ATCmdSubscribed_t* cmdPtr = valuePtr;
     if (!cmdPtr->handlerFunc)
     {
-        LE_WARN("AT command '%s' does not have a handler", (char*)keyPtr);
-        return true;
-    }
-
-    if (contextPtr == NULL)
-    {
-        LE_ERROR("No command registration handler found for AT command '%s'", (char*)keyPtr);
-        return true;
+        LE_WARN("AT command '%s' does not have a handler", cmdPtr->cmdName);
+        return;
     }
 
-    CmdRegHandlerInfo_t* handlerInfoPtr = (CmdRegHandlerInfo_t*)contextPtr;
     (*handlerInfoPtr->clientHandlerFunc)(cmdPtr->cmdRef, handlerInfoPtr->contextPtr);
-    return true;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3553,7 +3659,11 @@ LE_SHARED le_atServer_CmdRegistrationHandlerRef_t le_atServer_AddCmdRegistration
     CmdRegHandlerInfo_t handlerInfo;
     handlerInfo.clientHandlerFunc = handlerPtr;
     handlerInfo.contextPtr = contextPtr;
-    le_hashmap_ForEach(CmdHashMap, CallCmdRegistrationHandler, &handlerInfo);
+    le_ref_IterRef_t iter = le_ref_GetIterator(SubscribedCmdRefMap);
+    while (LE_OK == le_ref_NextNode(iter))
+    {
+        CallCmdRegistrationHandler(le_ref_GetValue(iter), &handlerInfo);
+    }
 
     return (le_atServer_CmdRegistrationHandlerRef_t)(handlerRef);
 }
@@ -3674,34 +3784,23 @@ le_result_t le_atServer_GetParameter
         return LE_FAULT;
     }
 
-    uint32_t numParam = le_dls_NumLinks(&cmdPtr->paramList);
+    const char* paramPtr = cmdPtr->paramPtr;
     uint32_t i;
-    le_dls_Link_t* linkPtr;
 
-    if (index >= numParam)
+    if (index >= cmdPtr->paramCount)
     {
         return LE_BAD_PARAMETER;
     }
 
-    linkPtr = le_dls_Peek(&cmdPtr->paramList);
-
+    // Parameters follow each other in the command buffer
     for(i=0;i<index;i++)
     {
-        linkPtr = le_dls_PeekNext(&cmdPtr->paramList, linkPtr);
+        paramPtr += strlen(paramPtr) + 1;
     }
 
-    if (linkPtr)
-    {
-        ParamString_t* paramPtr;
-
-        paramPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-
-        snprintf(parameter, parameterNumElements, "%s", paramPtr->param);
-
-        return LE_OK;
-    }
+    snprintf(parameter, parameterNumElements, "%s", paramPtr);
 
-    return LE_FAULT;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3916,12 +4015,7 @@ le_result_t le_atServer_SendFinalResultCode
     }
 
     // Clean AT command context, not in use now
-    le_dls_Link_t* linkPtr;
-    while ((linkPtr=le_dls_Pop(&cmdPtr->paramList)) != NULL)
-    {
-        ParamString_t *paraPtr = CONTAINER_OF(linkPtr, ParamString_t, link);
-        le_mem_Release(paraPtr);
-    }
+    ClearParams(cmdPtr);
 
     cmdPtr->deviceRef = NULL;
     cmdPtr->processing = false;
@@ -4449,10 +4543,10 @@ COMPONENT_INIT
                                            sizeof(ATCmdSubscribed_t));
     le_mem_SetDestructor(AtCommandsPool,AtCmdPoolDestructor);
     SubscribedCmdRefMap = le_ref_InitStaticMap(SubscribedCmdRefMap, CMD_POOL_SIZE);
-    CmdHashMap = le_hashmap_InitStatic(CmdHashMap,
-                                    CMD_POOL_SIZE,
-                                    le_hashmap_HashString,
-                                       le_hashmap_EqualsString);
+
+    // AT commands index: names are matched without regard to case
+    le_trie_Init();
+    CmdTrie = le_trie_Create(true);
 
     // AT command strings pool allocation
     AtCommandStringsPool = le_mem_InitStaticPool(AtServerCommandStringsPool,
@@ -4463,12 +4557,6 @@ COMPONENT_INIT
                                                     "AtCommandSmallStringsPool",
                                                     0, CMD_STRING_TYPICAL_BYTES);
 
-
-    // Parameters pool allocation
-    ParamStringPool = le_mem_InitStaticPool(ParamString,
-                                            PARAM_POOL_SIZE,
-                                            sizeof(ParamString_t));
-
     // Parameters pool allocation
     RspStringPool = le_mem_InitStaticPool(RspString,
                                           RSP_POOL_SIZE,
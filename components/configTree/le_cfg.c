@@ -1022,6 +1022,119 @@ void le_cfg_SetBool
     }
 }
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a batch of values from the configuration tree, relative to the iterator's node.
+ *
+ *  Node types are not recorded by this implementation, so each returned item keeps its requested
+ *  type if the node exists, or is set to LE_CFG_TYPE_DOESNT_EXIST if it doesn't.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_GetBatch
+(
+    le_cfg_IteratorRef_t     externalRef,   ///< [IN]     Iterator to use as a basis for the
+                                            ///<          transaction.
+    const le_cfg_BatchItem_t *itemsPtr,     ///< [IN]     Items to read, with their defaults.
+    size_t                   itemsSize,     ///< [IN]     Number of items to read.
+    le_cfg_BatchItem_t      *valuesPtr,     ///< [OUT]    Items read.
+    size_t                  *valuesSizePtr  ///< [IN/OUT] Size of the values buffer, then number of
+                                            ///<          items read.
+)
+{
+    size_t count = MIN(itemsSize, *valuesSizePtr);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const le_cfg_BatchItem_t *itemPtr = &itemsPtr[i];
+        le_cfg_BatchItem_t       *valuePtr = &valuesPtr[i];
+
+        *valuePtr = *itemPtr;
+
+        switch (itemPtr->type)
+        {
+            case LE_CFG_TYPE_STRING:
+                le_cfg_GetString(externalRef, itemPtr->path, valuePtr->stringValue,
+                    sizeof(valuePtr->stringValue), itemPtr->stringValue);
+                break;
+
+            case LE_CFG_TYPE_BOOL:
+                valuePtr->boolValue = le_cfg_GetBool(externalRef, itemPtr->path,
+                    itemPtr->boolValue);
+                break;
+
+            case LE_CFG_TYPE_INT:
+                valuePtr->intValue = le_cfg_GetInt(externalRef, itemPtr->path, itemPtr->intValue);
+                break;
+
+            case LE_CFG_TYPE_FLOAT:
+                valuePtr->floatValue = le_cfg_GetFloat(externalRef, itemPtr->path,
+                    itemPtr->floatValue);
+                break;
+
+            default:
+                break;
+        }
+
+        if (!le_cfg_NodeExists(externalRef, itemPtr->path))
+        {
+            valuePtr->type = LE_CFG_TYPE_DOESNT_EXIST;
+        }
+    }
+
+    *valuesSizePtr = count;
+}
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a batch of values to the configuration tree, relative to the iterator's node.  Only valid
+ *  during a write transaction.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_SetBatch
+(
+    le_cfg_IteratorRef_t      externalRef,  ///< [IN] Iterator to use as a basis for the
+                                            ///<      transaction.
+    const le_cfg_BatchItem_t *itemsPtr,     ///< [IN] Items to write.
+    size_t                    itemsSize     ///< [IN] Number of items to write.
+)
+{
+    for (size_t i = 0; i < itemsSize; i++)
+    {
+        const le_cfg_BatchItem_t *itemPtr = &itemsPtr[i];
+
+        switch (itemPtr->type)
+        {
+            case LE_CFG_TYPE_EMPTY:
+                le_cfg_SetEmpty(externalRef, itemPtr->path);
+                break;
+
+            case LE_CFG_TYPE_STRING:
+                le_cfg_SetString(externalRef, itemPtr->path, itemPtr->stringValue);
+                break;
+
+            case LE_CFG_TYPE_BOOL:
+                le_cfg_SetBool(externalRef, itemPtr->path, itemPtr->boolValue);
+                break;
+
+            case LE_CFG_TYPE_INT:
+                le_cfg_SetInt(externalRef, itemPtr->path, itemPtr->intValue);
+                break;
+
+            case LE_CFG_TYPE_FLOAT:
+                le_cfg_SetFloat(externalRef, itemPtr->path, itemPtr->floatValue);
+                break;
+
+            case LE_CFG_TYPE_DOESNT_EXIST:
+                le_cfg_DeleteNode(externalRef, itemPtr->path);
+                break;
+
+            default:
+                LE_WARN("Ignoring batch item '%s' of type %d", itemPtr->path, itemPtr->type);
+                break;
+        }
+    }
+}
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Delete the node specified by the path.  If the node doesn't exist, nothing happens.  All child
@@ -1255,6 +1368,43 @@ void le_cfg_QuickSetBool
     le_cfg_CommitTxn(ref);
 }
 
+// -------------------------------------------------------------------------------------------------
+/**
+ * Reads several values from the config tree in one call, relative to the base path.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_QuickGetBatch
+(
+    const char               *basePath,      ///< [IN]     Path the item paths are relative to.
+    const le_cfg_BatchItem_t *itemsPtr,      ///< [IN]     Items to read, with their defaults.
+    size_t                    itemsSize,     ///< [IN]     Number of items to read.
+    le_cfg_BatchItem_t       *valuesPtr,     ///< [OUT]    Items read.
+    size_t                   *valuesSizePtr  ///< [IN/OUT] Size of the values buffer, then number
+                                             ///<          of items read.
+)
+{
+    le_cfg_IteratorRef_t ref = le_cfg_CreateReadTxn(basePath);
+    le_cfg_GetBatch(ref, itemsPtr, itemsSize, valuesPtr, valuesSizePtr);
+    le_cfg_CancelTxn(ref);
+}
+
+// -------------------------------------------------------------------------------------------------
+/**
+ * Writes several values to the config tree in one call, relative to the base path.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_QuickSetBatch
+(
+    const char               *basePath,  ///< [IN] Path the item paths are relative to.
+    const le_cfg_BatchItem_t *itemsPtr,  ///< [IN] Items to write.
+    size_t                    itemsSize  ///< [IN] Number of items to write.
+)
+{
+    le_cfg_IteratorRef_t ref = le_cfg_CreateWriteTxn(basePath);
+    le_cfg_SetBatch(ref, itemsPtr, itemsSize);
+    le_cfg_CommitTxn(ref);
+}
+
 // -------------------------------------------------------------------------------------------------
 // Component Initialization
 // -------------------------------------------------------------------------------------------------
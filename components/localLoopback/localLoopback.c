@@ -16,9 +16,36 @@
 #include "interfaces.h"
 #include "le_comm.h"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the loopback buffer.  Large enough for a couple of maximum-size RPC Proxy messages.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifdef LE_CONFIG_RPC_PROXY_MAX_MESSAGE
+#define LOOPBACK_BUFFER_SIZE    (2 * (LE_CONFIG_RPC_PROXY_MAX_MESSAGE + 64))
+#else
+#define LOOPBACK_BUFFER_SIZE    2048
+#endif
+
 static le_comm_CallbackHandlerFunc_t local_callback_handler;
-static char local_buffer[200];
-static size_t local_msgsize;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Loopback byte stream.  Data sent is appended at local_write_offset; data received is taken from
+ * local_read_offset, in as many pieces as the receiver asks for, like a stream socket.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t local_buffer[LOOPBACK_BUFFER_SIZE];
+static size_t local_read_offset;
+static size_t local_write_offset;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set while the receive callback is running, so that data sent from within it (such as a reply)
+ * is queued and picked up by the receiver's read loop rather than delivered recursively.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool local_in_callback;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -88,24 +115,94 @@ LE_SHARED le_result_t le_comm_Disconnect (void* handle)
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append data to the loopback stream.
+ *
+ * @return
+ *      - LE_OK if successfully.
+ *      - LE_NO_MEMORY if the stream does not have room for the data.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendData (const void* buf, size_t len)
+{
+    if ((sizeof(local_buffer) - local_write_offset) < len)
+    {
+        // Move unread data to the start of the buffer to make room
+        memmove(local_buffer,
+                local_buffer + local_read_offset,
+                local_write_offset - local_read_offset);
+        local_write_offset -= local_read_offset;
+        local_read_offset = 0;
+
+        if ((sizeof(local_buffer) - local_write_offset) < len)
+        {
+            LE_ERROR("Loopback buffer full, %" PRIuS " bytes dropped", len);
+            return LE_NO_MEMORY;
+        }
+    }
+
+    memcpy(local_buffer + local_write_offset, buf, len);
+    local_write_offset += len;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call the receive handler until it has read everything, or stops reading.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeliverData (void* handle)
+{
+    if (local_in_callback || (local_callback_handler == NULL))
+    {
+        return;
+    }
+
+    local_in_callback = true;
+    while (local_read_offset < local_write_offset)
+    {
+        size_t unread = local_write_offset - local_read_offset;
+
+        // Call RPC Proxy receive handler
+        local_callback_handler(handle, POLLIN);
+
+        if ((local_write_offset - local_read_offset) >= unread)
+        {
+            // No progress
+            break;
+        }
+    }
+    local_in_callback = false;
+}
+
 LE_SHARED le_result_t le_comm_Send (void* handle, const void* buf, size_t len)
 {
-    // Ensure local loopback buffer is big enough
-    if (sizeof(local_buffer) < len)
+    le_result_t result = AppendData(buf, len);
+
+    if (result == LE_OK)
     {
-        LE_INFO("Send Buffer too small");
-        return LE_OK;
+        DeliverData(handle);
     }
 
-    // Copy Proxy Message onto local loopback buffer and set the size
-    memcpy(&local_buffer, buf, len);
-    local_msgsize = len;
+    return result;
+}
 
-    LE_INFO("Calling local_callback_handler() function");
+LE_SHARED le_result_t le_comm_SendV (void* handle, const le_comm_IoVec_t* iovPtr, size_t iovCount)
+{
+    size_t i;
 
-    // Call RPC Proxy receive handler
-    local_callback_handler(handle, 0x00);
-    LE_INFO("Finished local_callback_handler() function");
+    for (i = 0; i < iovCount; i++)
+    {
+        le_result_t result = AppendData(iovPtr[i].bufPtr, iovPtr[i].len);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+
+    DeliverData(handle);
 
     return LE_OK;
 }
@@ -113,16 +210,22 @@ LE_SHARED le_result_t le_comm_Send (void* handle, const void* buf, size_t len)
 LE_SHARED le_result_t le_comm_Receive (void* handle, void* buf, size_t* len)
 {
     LE_UNUSED(handle);
-    LE_INFO("Calling myLocal le_comm_Receive");
 
-    if (*len < local_msgsize)
+    size_t unread = local_write_offset - local_read_offset;
+
+    if (*len > unread)
     {
-        LE_INFO("Receive Buffer too small");
-        return LE_OK;
+        *len = unread;
     }
 
-    memcpy(buf, &local_buffer, local_msgsize);
-    *len = local_msgsize;
+    memcpy(buf, local_buffer + local_read_offset, *len);
+    local_read_offset += *len;
+
+    if (local_read_offset == local_write_offset)
+    {
+        local_read_offset = 0;
+        local_write_offset = 0;
+    }
 
     return LE_OK;
 }
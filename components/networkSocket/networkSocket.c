@@ -18,6 +18,9 @@
 
 #ifdef LE_CONFIG_LINUX
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/uio.h>
 #endif
 
 //--------------------------------------------------------------------------------------------------
@@ -43,11 +46,19 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reference to File descriptor monitor object.
+ * Maximum number of segments in a scatter/gather send
  */
 //--------------------------------------------------------------------------------------------------
-static le_fdMonitor_Ref_t FdMonitorRef = NULL;
-static short PollingEvents = 0x00;
+#define NETWORK_SOCKET_IOV_MAX                       8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the output buffer holding the data a socket did not accept yet, and maximum number of
+ * such buffers in use at once.  Buffers are only taken while a socket is congested.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NETWORK_SOCKET_OUTPUT_BUFFER_SIZE            16384
+#define NETWORK_SOCKET_OUTPUT_BUFFER_MAX_NUM         4
 
 
 //--------------------------------------------------------------------------------------------------
@@ -60,6 +71,14 @@ typedef struct HandleRecord
     int fd; ///< File-descriptor of the socket connection
     bool isListeningFd; ///< Identifies if this is a listening server socket
     void* parentRecordPtr; ///< Pointer to parent (listening) socket record [client sockets only]
+    le_fdMonitor_Ref_t fdMonitorRef; ///< Monitor of the data events of the socket
+    le_fdMonitor_Ref_t connectionFdMonitorRef; ///< Monitor of the connection events of the socket
+    short pollingEvents; ///< Data events monitored on behalf of the RPC Proxy
+    char ipAddress[NETWORK_SOCKET_IP6ADDR_STRLEN_MAX]; ///< IP Address of the server
+    uint16_t tcpPort; ///< TCP Listening Port of the server
+    uint8_t* outputBufferPtr; ///< Data accepted for sending but not written yet, or NULL
+    size_t outputStart; ///< Offset of the first unwritten byte in the output buffer
+    size_t outputLen; ///< Number of unwritten bytes in the output buffer
 }
 HandleRecord_t;
 
@@ -75,6 +94,18 @@ LE_MEM_DEFINE_STATIC_POOL(HandleRecordPool,
 
 static le_mem_PoolRef_t HandleRecordPoolRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This pool is used to allocate memory for the output buffers.
+ * Initialized in COMPONENT_INIT().
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(OutputBufferPool,
+                          NETWORK_SOCKET_OUTPUT_BUFFER_MAX_NUM,
+                          NETWORK_SOCKET_OUTPUT_BUFFER_SIZE);
+
+static le_mem_PoolRef_t OutputBufferPoolRef = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Hash Map to store the Handle record (value), using the File Descriptor (key).
@@ -100,28 +131,6 @@ static le_comm_CallbackHandlerFunc_t AsyncReceiveHandlerFuncPtr = NULL;
 static le_comm_CallbackHandlerFunc_t AsyncConnectionHandlerFuncPtr = NULL;
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Connection Socket File descriptor and monitor object
- */
-//--------------------------------------------------------------------------------------------------
-static le_fdMonitor_Ref_t ConnectionFdMonitorRef = NULL;
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Network Socket IP Address string
- */
-//--------------------------------------------------------------------------------------------------
-static char NetworkSocketIpAddress[NETWORK_SOCKET_IP6ADDR_STRLEN_MAX];
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Network Socket TCP Listening Port Number string
- */
-//--------------------------------------------------------------------------------------------------
-static uint16_t NetworkSocketTCPListeningPort;
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * This function must be called to initialize the RPC Communication implementation.
@@ -144,6 +153,14 @@ static void networkSocketInitialize(void)
                                                     sizeof(HandleRecord_t));
     }
 
+    if (OutputBufferPoolRef == NULL)
+    {
+        // NOTE: Must be performed once.
+        OutputBufferPoolRef = le_mem_InitStaticPool(OutputBufferPool,
+                                                    NETWORK_SOCKET_OUTPUT_BUFFER_MAX_NUM,
+                                                    NETWORK_SOCKET_OUTPUT_BUFFER_SIZE);
+    }
+
     if (HandleRecordByFileDescriptor == NULL) {
         // Create hash map for storing the handle record (value) using the FD (key)
         // NOTE: Must be performed once.
@@ -170,6 +187,340 @@ COMPONENT_INIT
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a Handle record for a socket.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitHandleRecord
+(
+    HandleRecord_t* connectionRecordPtr,    ///< [IN] Handle record
+    int fd                                  ///< [IN] File-descriptor of the socket
+)
+{
+    memset(connectionRecordPtr, 0, sizeof(*connectionRecordPtr));
+    connectionRecordPtr->fd = fd;
+    connectionRecordPtr->isListeningFd = false;
+    connectionRecordPtr->parentRecordPtr = NULL;
+    connectionRecordPtr->fdMonitorRef = NULL;
+    connectionRecordPtr->connectionFdMonitorRef = NULL;
+    connectionRecordPtr->outputBufferPtr = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Disable Nagle's algorithm on a connected socket.  Each message is handed over in one write, so
+ * there is nothing to gain from delaying small segments, and a lot of latency to lose.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetNoDelay
+(
+    int fd  ///< [IN] File-descriptor of the socket
+)
+{
+#ifdef LE_CONFIG_LINUX
+    int noDelay = 1;
+
+    if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) != 0)
+    {
+        LE_WARN("Unable to set TCP_NODELAY, fd [%d], errno %d", fd, errno);
+    }
+#else
+    LE_UNUSED(fd);
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the errno of a failed send to a result code.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetSendResult
+(
+    int error   ///< [IN] errno of the failed send
+)
+{
+    switch (error)
+    {
+        case EAGAIN:  // Same as EWOULDBLOCK
+            return LE_NO_MEMORY;
+
+        case ENOTCONN:
+        case ECONNRESET:
+            LE_WARN("sendmsg() failed with errno %d", error);
+            return LE_COMM_ERROR;
+
+        default:
+            LE_ERROR("sendmsg() failed with errno %d", error);
+            return LE_FAULT;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write as much as the socket takes of the data gathered from several buffers, in a single system
+ * call.
+ *
+ * @return
+ *      - Number of bytes written.
+ *      - -1 on error, with errno set.
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t WriteSegments
+(
+    int fd,                         ///< [IN] File-descriptor of the socket
+    const le_comm_IoVec_t* iovPtr,  ///< [IN] Buffers to write
+    size_t iovCount                 ///< [IN] Number of buffers
+)
+{
+    ssize_t bytesSent;
+
+#ifdef LE_CONFIG_LINUX
+    if (iovCount > 1)
+    {
+        struct iovec iov[NETWORK_SOCKET_IOV_MAX];
+        struct msghdr msg;
+        size_t i;
+
+        for (i = 0; i < iovCount; i++)
+        {
+            iov[i].iov_base = (void*) iovPtr[i].bufPtr;
+            iov[i].iov_len = iovPtr[i].len;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovCount;
+
+        // Retry if interrupted by a signal
+        do
+        {
+            bytesSent = sendmsg(fd, &msg, 0);
+        }
+        while ((bytesSent < 0) && (errno == EINTR));
+
+        return bytesSent;
+    }
+#else
+    LE_ASSERT(iovCount == 1);
+#endif
+
+    // Retry if interrupted by a signal
+    do
+    {
+        bytesSent = send(fd, iovPtr[0].bufPtr, iovPtr[0].len, 0);
+    }
+    while ((bytesSent < 0) && (errno == EINTR));
+
+    return bytesSent;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write out as much of the output buffer as the socket takes.  The buffer is released once empty.
+ *
+ * @return
+ *      - LE_OK if successfully (the buffer may still hold data the socket did not take yet).
+ *      - otherwise failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlushOutput
+(
+    HandleRecord_t* connectionRecordPtr ///< [IN] Handle record
+)
+{
+    while (connectionRecordPtr->outputLen > 0)
+    {
+        ssize_t bytesSent;
+
+        // Retry if interrupted by a signal
+        do
+        {
+            bytesSent = send(connectionRecordPtr->fd,
+                             connectionRecordPtr->outputBufferPtr + connectionRecordPtr->outputStart,
+                             connectionRecordPtr->outputLen,
+                             0);
+        }
+        while ((bytesSent < 0) && (errno == EINTR));
+
+        if (bytesSent < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                // Socket is still congested - wait to be told it can take more
+                return LE_OK;
+            }
+            return GetSendResult(errno);
+        }
+
+        connectionRecordPtr->outputStart += bytesSent;
+        connectionRecordPtr->outputLen -= bytesSent;
+    }
+
+    if (connectionRecordPtr->outputBufferPtr != NULL)
+    {
+        le_mem_Release(connectionRecordPtr->outputBufferPtr);
+        connectionRecordPtr->outputBufferPtr = NULL;
+        connectionRecordPtr->outputStart = 0;
+
+        if (connectionRecordPtr->fdMonitorRef != NULL)
+        {
+            le_fdMonitor_Disable(connectionRecordPtr->fdMonitorRef, POLLOUT);
+        }
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the data gathered from several buffers, less the bytes already written, to the output
+ * buffer, and monitor the socket for room to write it.
+ *
+ * @return
+ *      - LE_OK if successfully.
+ *      - LE_NO_MEMORY if the output buffer is full, and none of the data was written.
+ *      - LE_FAULT if the output buffer is full, and some of the data was written.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t QueueOutput
+(
+    HandleRecord_t* connectionRecordPtr,    ///< [IN] Handle record
+    const le_comm_IoVec_t* iovPtr,          ///< [IN] Buffers
+    size_t iovCount,                        ///< [IN] Number of buffers
+    size_t skip,                            ///< [IN] Number of bytes already written
+    size_t len                              ///< [IN] Total number of bytes in the buffers
+)
+{
+    size_t i;
+
+    if (connectionRecordPtr->outputBufferPtr == NULL)
+    {
+        connectionRecordPtr->outputBufferPtr = le_mem_TryAlloc(OutputBufferPoolRef);
+        connectionRecordPtr->outputStart = 0;
+        connectionRecordPtr->outputLen = 0;
+    }
+
+    if ((connectionRecordPtr->outputBufferPtr == NULL) ||
+        ((len - skip) > (NETWORK_SOCKET_OUTPUT_BUFFER_SIZE - connectionRecordPtr->outputLen)))
+    {
+        LE_ERROR("Output buffer full, fd [%d], %zu bytes not sent",
+                 connectionRecordPtr->fd,
+                 len - skip);
+
+        if ((connectionRecordPtr->outputBufferPtr != NULL) &&
+            (connectionRecordPtr->outputLen == 0))
+        {
+            le_mem_Release(connectionRecordPtr->outputBufferPtr);
+            connectionRecordPtr->outputBufferPtr = NULL;
+        }
+
+        // The stream cannot be resumed if part of the data was written
+        return (skip > 0) ? LE_FAULT : LE_NO_MEMORY;
+    }
+
+    // Move the unwritten data to the start of the buffer, if the new data does not fit after it
+    if ((connectionRecordPtr->outputStart + connectionRecordPtr->outputLen + (len - skip)) >
+        NETWORK_SOCKET_OUTPUT_BUFFER_SIZE)
+    {
+        memmove(connectionRecordPtr->outputBufferPtr,
+                connectionRecordPtr->outputBufferPtr + connectionRecordPtr->outputStart,
+                connectionRecordPtr->outputLen);
+        connectionRecordPtr->outputStart = 0;
+    }
+
+    for (i = 0; i < iovCount; i++)
+    {
+        const uint8_t* bufPtr = iovPtr[i].bufPtr;
+        size_t segmentLen = iovPtr[i].len;
+
+        if (skip >= segmentLen)
+        {
+            skip -= segmentLen;
+            continue;
+        }
+
+        memcpy(connectionRecordPtr->outputBufferPtr +
+                   connectionRecordPtr->outputStart + connectionRecordPtr->outputLen,
+               bufPtr + skip,
+               segmentLen - skip);
+        connectionRecordPtr->outputLen += segmentLen - skip;
+        skip = 0;
+    }
+
+    // Get notified when the socket can take more
+    if (connectionRecordPtr->fdMonitorRef != NULL)
+    {
+        le_fdMonitor_Enable(connectionRecordPtr->fdMonitorRef, POLLOUT);
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the data gathered from several buffers without blocking.  What the socket does not take
+ * right away is kept in the output buffer, and written out when the socket has room again; data
+ * sent later is queued behind it, so the stream stays in order.
+ *
+ * @return
+ *      - LE_OK if successfully.
+ *      - LE_NO_MEMORY if the data could not be buffered.
+ *      - otherwise failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendSegments
+(
+    HandleRecord_t* connectionRecordPtr,    ///< [IN] Handle record
+    const le_comm_IoVec_t* iovPtr,          ///< [IN] Buffers to send
+    size_t iovCount                         ///< [IN] Number of buffers
+)
+{
+    size_t len = 0;
+    ssize_t bytesSent = 0;
+    size_t i;
+
+    for (i = 0; i < iovCount; i++)
+    {
+        len += iovPtr[i].len;
+    }
+
+    if (len == 0)
+    {
+        return LE_OK;
+    }
+
+    // Data waiting in the output buffer goes first
+    if (connectionRecordPtr->outputLen > 0)
+    {
+        le_result_t result = FlushOutput(connectionRecordPtr);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+
+    if (connectionRecordPtr->outputLen == 0)
+    {
+        bytesSent = WriteSegments(connectionRecordPtr->fd, iovPtr, iovCount);
+        if (bytesSent < 0)
+        {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+            {
+                return GetSendResult(errno);
+            }
+            bytesSent = 0;
+        }
+
+        if ((size_t) bytesSent == len)
+        {
+            return LE_OK;
+        }
+    }
+
+    return QueueOutput(connectionRecordPtr, iovPtr, iovCount, (size_t) bytesSent, len);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Callback function to receive events on a connection and pass them onto the RPC Proxy
@@ -185,6 +536,22 @@ static void AsyncRecvHandler(void* handle, short events)
         return;
     }
 
+    if (events & POLLOUT)
+    {
+        // Socket has room for the data waiting in the output buffer
+        if (FlushOutput(connectionRecordPtr) != LE_OK)
+        {
+            // Let the RPC Proxy tear the connection down
+            events |= POLLERR;
+        }
+        events &= ~POLLOUT;
+    }
+
+    if (events == 0)
+    {
+        return;
+    }
+
     // Notify the RPC Proxy
     AsyncReceiveHandlerFuncPtr(connectionRecordPtr, events);
 }
@@ -197,7 +564,8 @@ static void AsyncRecvHandler(void* handle, short events)
 static le_result_t ParseCommandLineArgs
 (
     const int argc,
-    const char* argv[]
+    const char* argv[],
+    HandleRecord_t* connectionRecordPtr
 )
 {
     le_result_t result = LE_OK;
@@ -210,8 +578,9 @@ static le_result_t ParseCommandLineArgs
     }
 
     // Extract the Server's IP address
-    le_utf8_Copy(NetworkSocketIpAddress, argv[0], sizeof(NetworkSocketIpAddress), NULL);
-    LE_INFO("Setting Network Socket IP Address [%s]", NetworkSocketIpAddress);
+    le_utf8_Copy(connectionRecordPtr->ipAddress, argv[0],
+                 sizeof(connectionRecordPtr->ipAddress), NULL);
+    LE_INFO("Setting Network Socket IP Address [%s]", connectionRecordPtr->ipAddress);
 
     // Extract the Server's TCP Listening port
     int portNumber = atoi(argv[1]);
@@ -221,9 +590,9 @@ static le_result_t ParseCommandLineArgs
     {
         return LE_BAD_PARAMETER;
     }
-    NetworkSocketTCPListeningPort = portNumber;
+    connectionRecordPtr->tcpPort = portNumber;
     LE_INFO("Setting Network Socket TCP Port [%" PRIu16 "]",
-            NetworkSocketTCPListeningPort);
+            connectionRecordPtr->tcpPort);
 
     return result;
 }
@@ -269,10 +638,11 @@ static void ConnectionRecvHandler(void* handle, short events)
     connectionRecordPtr = le_mem_AssertAlloc(HandleRecordPoolRef);
 
     // Initialize the connection record
-    connectionRecordPtr->fd = clientFd;
-    connectionRecordPtr->isListeningFd = false;
+    InitHandleRecord(connectionRecordPtr, clientFd);
     connectionRecordPtr->parentRecordPtr = parentRecordPtr;
 
+    SetNoDelay(clientFd);
+
     le_hashmap_Put(HandleRecordByFileDescriptor,
                    (void*)(intptr_t) connectionRecordPtr->fd,
                    connectionRecordPtr);
@@ -317,6 +687,11 @@ static void ConnectionRecvHandler(void* handle, short events)
     // Set the parent record to ourself
     connectionRecordPtr->parentRecordPtr = connectionRecordPtr;
 
+    if (socketErr == 0)
+    {
+        SetNoDelay(connectionRecordPtr->fd);
+    }
+
 #endif
 
     LE_INFO("Notifying RPC Proxy socket is connected, fd [%d]",
@@ -362,27 +737,19 @@ LE_SHARED void* le_comm_Create
     // Check if Communication Globals need initialization
     networkSocketInitialize();
 
-    if (!le_hashmap_isEmpty(HandleRecordByFileDescriptor))
-    {
-        LE_ERROR("Sanity Check Failure: Hashmap is not empty");
-        *resultPtr = LE_FAULT;
-        return NULL;
-    }
+    HandleRecord_t* connectionRecordPtr = le_mem_AssertAlloc(HandleRecordPoolRef);
+
+    // Initialize the connection record
+    InitHandleRecord(connectionRecordPtr, -1);
 
     // Parse the Command Line arguments to extract the IP Address and TCP Port number
-    *resultPtr = ParseCommandLineArgs(argc, argv);
+    *resultPtr = ParseCommandLineArgs(argc, argv, connectionRecordPtr);
     if (*resultPtr != LE_OK)
     {
+        le_mem_Release(connectionRecordPtr);
         return NULL;
     }
 
-    HandleRecord_t* connectionRecordPtr = le_mem_AssertAlloc(HandleRecordPoolRef);
-
-    // Initialize the connection record
-    connectionRecordPtr->fd = -1;
-    connectionRecordPtr->isListeningFd = false;
-    connectionRecordPtr->parentRecordPtr = NULL;
-
     // Create the socket
     connectionRecordPtr->fd = socket(AF_INET, SOCK_STREAM, 0);
     if (connectionRecordPtr->fd < 0)
@@ -431,7 +798,7 @@ LE_SHARED void* le_comm_Create
     // Prepare the sockaddr_in structure
     sockAddr.sin_family = AF_INET;
     sockAddr.sin_addr.s_addr = INADDR_ANY;
-    sockAddr.sin_port = htons(NetworkSocketTCPListeningPort);
+    sockAddr.sin_port = htons(connectionRecordPtr->tcpPort);
 
     // Bind
     if (bind(connectionRecordPtr->fd, (struct sockaddr *)&sockAddr, sizeof(sockAddr)) < 0)
@@ -488,24 +855,25 @@ LE_SHARED le_result_t le_comm_RegisterHandleMonitor
         snprintf(socketName, sizeof(socketName) - 1, "inetSocket-%d", connectionRecordPtr->fd);
 
         // Set the Polling Events
-        PollingEvents = events;
+        connectionRecordPtr->pollingEvents = events;
 
 #ifndef SOCKET_SERVER
-        if (ConnectionFdMonitorRef != NULL)
+        if (connectionRecordPtr->connectionFdMonitorRef != NULL)
         {
             // Delete Connection FD monitor
-            le_fdMonitor_Delete(ConnectionFdMonitorRef);
-            ConnectionFdMonitorRef = NULL;
+            le_fdMonitor_Delete(connectionRecordPtr->connectionFdMonitorRef);
+            connectionRecordPtr->connectionFdMonitorRef = NULL;
         }
 #endif
 
-        // Create thread to monitor FD handle for activity, as defined by the events
-        FdMonitorRef =
+        // Create thread to monitor FD handle for activity, as defined by the events, and for
+        // room to write if data is already waiting to be sent
+        connectionRecordPtr->fdMonitorRef =
             le_fdMonitor_Create(
                 socketName,
                 connectionRecordPtr->fd,
                 (le_fdMonitor_HandlerFunc_t) AsyncRecvHandler,
-                PollingEvents);
+                events | ((connectionRecordPtr->outputLen > 0) ? POLLOUT : 0));
     }
     else
     {
@@ -532,12 +900,25 @@ LE_SHARED le_result_t le_comm_Delete (void* handle)
 
     LE_INFO("Deleting AF_INET socket, fd %d .........", connectionRecordPtr->fd);
 
-    if ((FdMonitorRef != NULL) &&
-        (le_fdMonitor_GetFd(FdMonitorRef) == connectionRecordPtr->fd))
+    if (connectionRecordPtr->fdMonitorRef != NULL)
     {
         // Delete FD monitor
-        le_fdMonitor_Delete(FdMonitorRef);
-        FdMonitorRef = NULL;
+        le_fdMonitor_Delete(connectionRecordPtr->fdMonitorRef);
+        connectionRecordPtr->fdMonitorRef = NULL;
+    }
+
+    if (connectionRecordPtr->connectionFdMonitorRef != NULL)
+    {
+        // Delete Connection FD monitor
+        le_fdMonitor_Delete(connectionRecordPtr->connectionFdMonitorRef);
+        connectionRecordPtr->connectionFdMonitorRef = NULL;
+    }
+
+    // Drop the data not sent yet
+    if (connectionRecordPtr->outputBufferPtr != NULL)
+    {
+        le_mem_Release(connectionRecordPtr->outputBufferPtr);
+        connectionRecordPtr->outputBufferPtr = NULL;
     }
 
     // Remove the Handle record
@@ -554,10 +935,6 @@ LE_SHARED le_result_t le_comm_Delete (void* handle)
     le_mem_Release(connectionRecordPtr);
     connectionRecordPtr = NULL;
 
-    // Reset the Network IP Address and TCP Port
-    memset(NetworkSocketIpAddress, 0, sizeof(NetworkSocketIpAddress));
-    NetworkSocketTCPListeningPort = 0;
-
     return LE_OK;
 }
 
@@ -584,7 +961,7 @@ LE_SHARED le_result_t le_comm_Connect (void* handle)
     snprintf(socketName, sizeof(socketName) - 1, "inetSocket-%d", connectionRecordPtr->fd);
 
     // Create thread to monitor FD handle for activity, as defined by the events
-    ConnectionFdMonitorRef =
+    connectionRecordPtr->connectionFdMonitorRef =
         le_fdMonitor_Create(
             socketName,
             connectionRecordPtr->fd,
@@ -600,9 +977,9 @@ LE_SHARED le_result_t le_comm_Connect (void* handle)
 #ifndef SOCKET_SERVER
     struct sockaddr_in sockAddr;
 
-    sockAddr.sin_addr.s_addr = inet_addr(NetworkSocketIpAddress);
+    sockAddr.sin_addr.s_addr = inet_addr(connectionRecordPtr->ipAddress);
     sockAddr.sin_family = AF_INET;
-    sockAddr.sin_port = htons(NetworkSocketTCPListeningPort);
+    sockAddr.sin_port = htons(connectionRecordPtr->tcpPort);
 
     // Connect the client socket
     int result =
@@ -658,10 +1035,19 @@ LE_SHARED le_result_t le_comm_Connect (void* handle)
 LE_SHARED le_result_t le_comm_Disconnect (void* handle)
 {
     HandleRecord_t* connectionRecordPtr = (HandleRecord_t*) handle;
-    if (FdMonitorRef != NULL)
+    if (connectionRecordPtr->fdMonitorRef != NULL)
     {
         // Disable FD Monitoring
-        le_fdMonitor_Disable(FdMonitorRef, PollingEvents);
+        le_fdMonitor_Disable(connectionRecordPtr->fdMonitorRef,
+                             connectionRecordPtr->pollingEvents | POLLOUT);
+    }
+
+    // Drop the data not sent yet
+    if (connectionRecordPtr->outputBufferPtr != NULL)
+    {
+        le_mem_Release(connectionRecordPtr->outputBufferPtr);
+        connectionRecordPtr->outputBufferPtr = NULL;
+        connectionRecordPtr->outputLen = 0;
     }
 
     le_hashmap_Remove(HandleRecordByFileDescriptor, (void*)(intptr_t) connectionRecordPtr->fd);
@@ -674,52 +1060,48 @@ LE_SHARED le_result_t le_comm_Disconnect (void* handle)
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Function for Sending Data over RPC Network-Socket Communication Channel
+ * Function for Sending Data over RPC Network-Socket Communication Channel.  Does not block: data
+ * the socket does not take right away is buffered, and written out when the socket has room.
  *
  * @return
  *      - LE_OK if successfully.
+ *      - LE_NO_MEMORY if the data could not be buffered.
+ *      - otherwise failure
  */
 //--------------------------------------------------------------------------------------------------
 LE_SHARED le_result_t le_comm_Send (void* handle, const void* buf, size_t len)
 {
     HandleRecord_t* connectionRecordPtr = (HandleRecord_t*) handle;
-    ssize_t bytesSent;
+    le_comm_IoVec_t iov = { .bufPtr = buf, .len = len };
 
-    // Now send the message (retry if interrupted by a signal).
-    do
-    {
-        bytesSent = send(connectionRecordPtr->fd, buf, len, 0);
-    }
-    while ((bytesSent < 0) && (errno == EINTR));
-
-    if (bytesSent < 0)
-    {
-        switch (errno)
-        {
-            case EAGAIN:  // Same as EWOULDBLOCK
-                return LE_NO_MEMORY;
-
-            case ENOTCONN:
-            case ECONNRESET:
-                LE_WARN("sendmsg() failed with errno %d", errno);
-                return LE_COMM_ERROR;
+    return SendSegments(connectionRecordPtr, &iov, 1);
+}
 
-            default:
-                LE_ERROR("sendmsg() failed with errno %d", errno);
-                return LE_FAULT;
-        }
-    }
+#ifdef LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for Sending Data gathered from several buffers over RPC Network-Socket Communication
+ * Channel, in a single system call.  Does not block, like le_comm_Send().
+ *
+ * @return
+ *      - LE_OK if successfully.
+ *      - LE_NO_MEMORY if the data could not be buffered.
+ *      - otherwise failure
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t le_comm_SendV (void* handle, const le_comm_IoVec_t* iovPtr, size_t iovCount)
+{
+    HandleRecord_t* connectionRecordPtr = (HandleRecord_t*) handle;
 
-    if (bytesSent < len)
+    if (iovCount > NETWORK_SOCKET_IOV_MAX)
     {
-        LE_ERROR("The last %zu data bytes (of %zu total) were discarded by sendmsg()!",
-                 len - bytesSent,
-                 len);
-        return LE_FAULT;
+        LE_ERROR("Too many segments (%zu)", iovCount);
+        return LE_BAD_PARAMETER;
     }
 
-    return LE_OK;
+    return SendSegments(connectionRecordPtr, iovPtr, iovCount);
 }
+#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
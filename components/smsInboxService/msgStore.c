@@ -0,0 +1,1715 @@
+// -------------------------------------------------------------------------------------------------
+/**
+ *  SMS Inbox Server
+ *
+ *  Message store.
+ *
+ *  Messages are stored in a single append-only log (msg.log).  The log starts with a header, which
+ *  holds the name of the message box of each bit of the flags, followed by records of two types:
+ *   - a message record holds a message body, with the flags of the message when it was added;
+ *   - a flags record holds new flags for a message: the message boxes it is in (the inbox mask)
+ *     and the message boxes it is unread in (the unread mask).
+ *  Each record starts with a CRC32, so that a record torn by a power loss is detected (and
+ *  dropped) when the log is replayed.
+ *
+ *  The index, i.e. the offset and current flags of each message, is kept in memory as an array
+ *  ordered by arrival, plus a hash map from message identifier to entry.  Adding a message or
+ *  changing its flags thus costs one append to the log, whatever the number of stored messages.
+ *  A message is deleted once it is in no message box.
+ *
+ *  A snapshot of the index is saved to msg.idx every SNAPSHOT_INTERVAL records, so that only the
+ *  end of the log has to be replayed at startup.  Once deleted messages and flag records take
+ *  more room in the log than the stored messages (and at least
+ *  LE_CONFIG_SMSINBOX_COMPACT_MIN_KBYTES), the stored messages are copied to a new log which
+ *  atomically replaces the old one.
+ *
+ *  The message boxes are given by name when the store is opened.  If they do not match the names
+ *  in the log header, the flags of the stored messages are remapped to the new bits, bits whose
+ *  name no longer exists are dropped, and the log is compacted to record the new names.
+ *
+ *  Copyright (C) Sierra Wireless Inc.
+ */
+// -------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "msgStore.h"
+
+
+//--------------------------------------------------------------------------------------------------
+// Symbols and enums.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File names, in the store directory.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_FILE_NAME           "msg.log"
+#define INDEX_FILE_NAME         "msg.idx"
+#define TMP_FILE_SUFFIX         ".tmp"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a file path.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_PATH_BYTES          128
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic numbers and version of the log and index files.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_MAGIC               0x4C534D53  // "SMSL"
+#define INDEX_MAGIC             0x49534D53  // "SMSI"
+#define FORMAT_VERSION          2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record types.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_MSG              1
+#define RECORD_FLAGS            2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of records appended to the log between two snapshots of the index.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SNAPSHOT_INTERVAL       256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes of deleted messages and flag records below which the log is never compacted.
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMPACT_MIN_BYTES       ((size_t)LE_CONFIG_SMSINBOX_COMPACT_MIN_KBYTES * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initial number of entries of the index, which then doubles as needed.
+ */
+//--------------------------------------------------------------------------------------------------
+#define INDEX_INITIAL_ENTRIES   64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer used to write new log and index files.
+ */
+//--------------------------------------------------------------------------------------------------
+#define WRITE_BUFFER_BYTES      8192
+
+
+//--------------------------------------------------------------------------------------------------
+// Data structures.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log file header.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;             ///< LOG_MAGIC
+    uint32_t version;           ///< FORMAT_VERSION
+    uint32_t generation;        ///< Incremented at each compaction
+    uint32_t crc;               ///< CRC32 of the message box names
+    char     mboxNames[MSGSTORE_MAX_MBOX][MSGSTORE_MBOX_NAME_BYTES];
+                                ///< Message box of each bit of the flags, "" if unused
+}
+LogHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log record header, followed by the message body for message records.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t crc;               ///< CRC32 of the rest of the header and of the body
+    uint16_t type;              ///< RECORD_MSG or RECORD_FLAGS
+    uint16_t bodySize;          ///< Body size, 0 for flags records
+    uint32_t msgId;             ///< Message identifier
+    uint32_t inboxMask;         ///< Message boxes the message is in
+    uint32_t unreadMask;        ///< Message boxes the message is unread in
+}
+RecordHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index entry of a message, as saved in the index file.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t msgId;             ///< Message identifier
+    uint32_t offset;            ///< Offset of the message record in the log
+    uint32_t inboxMask;         ///< Message boxes the message is in, 0 once deleted
+    uint32_t unreadMask;        ///< Message boxes the message is unread in
+    uint32_t bodySize;          ///< Body size
+}
+IndexRecord_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index file header, followed by the index records.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;             ///< INDEX_MAGIC
+    uint32_t version;           ///< FORMAT_VERSION
+    uint32_t generation;        ///< Generation of the log the index applies to
+    uint32_t logSize;           ///< Size of the log when the index was saved
+    uint32_t numRecords;        ///< Number of index records
+    uint32_t crc;               ///< CRC32 of the index records
+}
+IndexHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * In-memory index entry.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    IndexRecord_t record;       ///< Index record
+    uint32_t seq;               ///< Arrival order, never reused while the store is open
+    uint32_t newOffset;         ///< Offset in the log being compacted, 0 if not copied
+}
+Entry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffered writer, used to write new log and index files.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int         fd;                             ///< File written
+    size_t      used;                           ///< Number of bytes in the buffer
+    le_result_t result;                         ///< LE_FAULT once a write failed
+    uint8_t     buffer[WRITE_BUFFER_BYTES];     ///< Buffer
+}
+Writer_t;
+
+
+//--------------------------------------------------------------------------------------------------
+//                                       Static declarations
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File paths.
+ */
+//--------------------------------------------------------------------------------------------------
+static char DirPath[MAX_PATH_BYTES];
+static char LogPath[MAX_PATH_BYTES];
+static char IndexPath[MAX_PATH_BYTES];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message box of each bit of the flags, "" if unused.
+ */
+//--------------------------------------------------------------------------------------------------
+static char MboxNames[MSGSTORE_MAX_MBOX][MSGSTORE_MBOX_NAME_BYTES];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log file descriptor, -1 when the store is closed.
+ */
+//--------------------------------------------------------------------------------------------------
+static int LogFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log generation, size, and number of bytes of stored messages and of dead records.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Generation;
+static size_t LogSize;
+static size_t LiveSize;
+static size_t DeadSize;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index, ordered by arrival.  Entries of deleted messages remain until the next compaction.
+ */
+//--------------------------------------------------------------------------------------------------
+static Entry_t* EntriesPtr;
+static size_t NumEntries;
+static size_t MaxEntries;
+static uint32_t NextSeq = 1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map of the stored messages: message identifier -> arrival order.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t SeqMap;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages in each message box.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t MboxCount[MSGSTORE_MAX_MBOX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of records appended to the log since the last snapshot of the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NumSinceSnapshot;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffered writer.
+ */
+//--------------------------------------------------------------------------------------------------
+static Writer_t Writer;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the CRC of a record.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ComputeRecordCrc
+(
+    const RecordHeader_t* headerPtr,    ///< [IN] Record header
+    const void* bodyPtr                 ///< [IN] Record body
+)
+{
+    le_crc_Chunk_t chunks[] =
+    {
+        { &headerPtr->type, sizeof(*headerPtr) - offsetof(RecordHeader_t, type) },
+        { bodyPtr,          headerPtr->bodySize },
+    };
+
+    return le_crc_Crc32Chunks(chunks, NUM_ARRAY_MEMBERS(chunks), LE_CRC_START_CRC32);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a log header, with the current message box names.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitLogHeader
+(
+    LogHeader_t* headerPtr,         ///< [OUT] Log header
+    uint32_t generation             ///< [IN] Log generation
+)
+{
+    headerPtr->magic = LOG_MAGIC;
+    headerPtr->version = FORMAT_VERSION;
+    headerPtr->generation = generation;
+    memcpy(headerPtr->mboxNames, MboxNames, sizeof(headerPtr->mboxNames));
+    headerPtr->crc = le_crc_Crc32((uint8_t*)headerPtr->mboxNames, sizeof(headerPtr->mboxNames),
+                                  LE_CRC_START_CRC32);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a log header read from the log.
+ *
+ * @return true if the header is valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsLogHeaderValid
+(
+    LogHeader_t* headerPtr          ///< [IN] Log header
+)
+{
+    uint32_t i;
+
+    if ((headerPtr->magic != LOG_MAGIC) ||
+        (headerPtr->version != FORMAT_VERSION) ||
+        (headerPtr->crc != le_crc_Crc32((uint8_t*)headerPtr->mboxNames,
+                                        sizeof(headerPtr->mboxNames), LE_CRC_START_CRC32)))
+    {
+        return false;
+    }
+
+    for (i = 0; i < MSGSTORE_MAX_MBOX; i++)
+    {
+        if (headerPtr->mboxNames[i][MSGSTORE_MBOX_NAME_BYTES - 1] != '\0')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a whole buffer at a given offset.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_OUT_OF_RANGE if the end of file was reached
+ *      - LE_FAULT on error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadAt
+(
+    int fd,                 ///< [IN] File descriptor
+    void* bufferPtr,        ///< [OUT] Buffer
+    size_t size,            ///< [IN] Number of bytes to read
+    size_t offset           ///< [IN] Offset in the file
+)
+{
+    uint8_t* ptr = bufferPtr;
+
+    while (size > 0)
+    {
+        ssize_t count = pread(fd, ptr, size, offset);
+
+        if (count < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            LE_ERROR("Read error: %m");
+            return LE_FAULT;
+        }
+        if (count == 0)
+        {
+            return LE_OUT_OF_RANGE;
+        }
+
+        ptr += count;
+        size -= count;
+        offset += count;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a whole buffer at a given offset.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteAt
+(
+    int fd,                 ///< [IN] File descriptor
+    const void* bufferPtr,  ///< [IN] Buffer
+    size_t size,            ///< [IN] Number of bytes to write
+    size_t offset           ///< [IN] Offset in the file
+)
+{
+    const uint8_t* ptr = bufferPtr;
+
+    while (size > 0)
+    {
+        ssize_t count = pwrite(fd, ptr, size, offset);
+
+        if (count < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            LE_ERROR("Write error: %m");
+            return LE_FAULT;
+        }
+
+        ptr += count;
+        size -= count;
+        offset += count;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start writing a new file with the buffered writer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriterStart
+(
+    int fd                  ///< [IN] File descriptor of the new file
+)
+{
+    Writer.fd = fd;
+    Writer.used = 0;
+    Writer.result = LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the content of the writer buffer to the file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriterFlush
+(
+    size_t* offsetPtr       ///< [INOUT] Offset of the buffer in the file
+)
+{
+    if ((Writer.result == LE_OK) && (Writer.used > 0))
+    {
+        Writer.result = WriteAt(Writer.fd, Writer.buffer, Writer.used, *offsetPtr);
+        *offsetPtr += Writer.used;
+    }
+    Writer.used = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append data to the file written by the buffered writer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriterPut
+(
+    const void* dataPtr,    ///< [IN] Data
+    size_t size,            ///< [IN] Data size
+    size_t* offsetPtr       ///< [INOUT] Offset of the writer buffer in the file
+)
+{
+    const uint8_t* ptr = dataPtr;
+
+    while (size > 0)
+    {
+        size_t count = WRITE_BUFFER_BYTES - Writer.used;
+
+        if (count > size)
+        {
+            count = size;
+        }
+        memcpy(Writer.buffer + Writer.used, ptr, count);
+        Writer.used += count;
+        ptr += count;
+        size -= count;
+
+        if (Writer.used == WRITE_BUFFER_BYTES)
+        {
+            WriterFlush(offsetPtr);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flush a directory, so that a file rename is on flash.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SyncDir
+(
+    void
+)
+{
+    int fd = open(DirPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the position of an entry in the index from its arrival order.
+ *
+ * @return Position of the first entry which arrived at or after seq.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FindPos
+(
+    uint32_t seq            ///< [IN] Arrival order
+)
+{
+    size_t low = 0;
+    size_t high = NumEntries;
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (EntriesPtr[mid].seq < seq)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the index entry of a stored message.
+ *
+ * @return Index entry, NULL if the message is not stored.
+ */
+//--------------------------------------------------------------------------------------------------
+static Entry_t* FindEntry
+(
+    uint32_t msgId          ///< [IN] Message identifier
+)
+{
+    if (SeqMap == NULL)
+    {
+        // Store never opened
+        return NULL;
+    }
+
+    uint32_t seq = (uint32_t)(uintptr_t)le_hashmap_Get(SeqMap, (void*)(uintptr_t)msgId);
+
+    if (seq == 0)
+    {
+        return NULL;
+    }
+
+    size_t pos = FindPos(seq);
+
+    LE_ASSERT((pos < NumEntries) && (EntriesPtr[pos].seq == seq));
+
+    return &EntriesPtr[pos];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the message box counters after a change of inbox mask.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateCounts
+(
+    uint32_t oldMask,       ///< [IN] Previous inbox mask
+    uint32_t newMask        ///< [IN] New inbox mask
+)
+{
+    uint32_t changed = oldMask ^ newMask;
+    uint32_t i;
+
+    for (i = 0; changed != 0; i++, changed >>= 1)
+    {
+        if (changed & 1)
+        {
+            if (newMask & (1u << i))
+            {
+                MboxCount[i]++;
+            }
+            else
+            {
+                MboxCount[i]--;
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a stored message to the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddEntry
+(
+    const IndexRecord_t* recordPtr  ///< [IN] Index record of the message
+)
+{
+    if (NumEntries == MaxEntries)
+    {
+        size_t maxEntries = (MaxEntries == 0) ? INDEX_INITIAL_ENTRIES : 2 * MaxEntries;
+        Entry_t* entriesPtr = realloc(EntriesPtr, maxEntries * sizeof(Entry_t));
+
+        LE_ASSERT(entriesPtr != NULL);
+        EntriesPtr = entriesPtr;
+        MaxEntries = maxEntries;
+    }
+
+    Entry_t* entryPtr = &EntriesPtr[NumEntries++];
+
+    entryPtr->record = *recordPtr;
+    entryPtr->seq = NextSeq++;
+    entryPtr->newOffset = 0;
+
+    le_hashmap_Put(SeqMap, (void*)(uintptr_t)recordPtr->msgId, (void*)(uintptr_t)entryPtr->seq);
+    UpdateCounts(0, recordPtr->inboxMask);
+    LiveSize += sizeof(RecordHeader_t) + recordPtr->bodySize;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the flags of a stored message in the index, and delete it if it is in no message box.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetEntryFlags
+(
+    Entry_t* entryPtr,      ///< [IN] Index entry
+    uint32_t inboxMask,     ///< [IN] Message boxes the message is in
+    uint32_t unreadMask     ///< [IN] Message boxes the message is unread in
+)
+{
+    UpdateCounts(entryPtr->record.inboxMask, inboxMask);
+    entryPtr->record.inboxMask = inboxMask;
+    entryPtr->record.unreadMask = unreadMask;
+
+    if (inboxMask == 0)
+    {
+        size_t recordSize = sizeof(RecordHeader_t) + entryPtr->record.bodySize;
+
+        le_hashmap_Remove(SeqMap, (void*)(uintptr_t)entryPtr->record.msgId);
+        LiveSize -= recordSize;
+        DeadSize += recordSize;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drop the entries of deleted messages from the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PurgeEntries
+(
+    void
+)
+{
+    size_t i;
+    size_t numEntries = 0;
+
+    for (i = 0; i < NumEntries; i++)
+    {
+        if (EntriesPtr[i].record.inboxMask != 0)
+        {
+            EntriesPtr[numEntries++] = EntriesPtr[i];
+        }
+    }
+
+    NumEntries = numEntries;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the flags of the stored messages from the message boxes named in the log header to the
+ * current ones.  Messages left in no message box are deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemapEntries
+(
+    const LogHeader_t* headerPtr    ///< [IN] Log header
+)
+{
+    int newBit[MSGSTORE_MAX_MBOX];
+    uint32_t i;
+    uint32_t j;
+    size_t pos;
+
+    for (i = 0; i < MSGSTORE_MAX_MBOX; i++)
+    {
+        newBit[i] = -1;
+
+        if (headerPtr->mboxNames[i][0] == '\0')
+        {
+            continue;
+        }
+
+        for (j = 0; j < MSGSTORE_MAX_MBOX; j++)
+        {
+            if (strcmp(headerPtr->mboxNames[i], MboxNames[j]) == 0)
+            {
+                newBit[i] = j;
+                break;
+            }
+        }
+
+        if (newBit[i] < 0)
+        {
+            LE_WARN("Message box %s removed, %" PRIu32 " messages dropped from it",
+                    headerPtr->mboxNames[i], MboxCount[i]);
+        }
+        else if (newBit[i] != (int)i)
+        {
+            LE_INFO("Message box %s moved from bit %" PRIu32 " to bit %d",
+                    headerPtr->mboxNames[i], i, newBit[i]);
+        }
+    }
+
+    for (pos = 0; pos < NumEntries; pos++)
+    {
+        Entry_t* entryPtr = &EntriesPtr[pos];
+        uint32_t inboxMask = 0;
+        uint32_t unreadMask = 0;
+
+        if (entryPtr->record.inboxMask == 0)
+        {
+            continue;
+        }
+
+        for (i = 0; i < MSGSTORE_MAX_MBOX; i++)
+        {
+            if (newBit[i] < 0)
+            {
+                continue;
+            }
+            if (entryPtr->record.inboxMask & (1u << i))
+            {
+                inboxMask |= 1u << newBit[i];
+            }
+            if (entryPtr->record.unreadMask & (1u << i))
+            {
+                unreadMask |= 1u << newBit[i];
+            }
+        }
+
+        SetEntryFlags(entryPtr, inboxMask, unreadMask);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clear the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearIndex
+(
+    void
+)
+{
+    free(EntriesPtr);
+    EntriesPtr = NULL;
+    NumEntries = 0;
+    MaxEntries = 0;
+    le_hashmap_RemoveAll(SeqMap);
+    memset(MboxCount, 0, sizeof(MboxCount));
+    LiveSize = 0;
+    DeadSize = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a record to the log.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on write error, the log is left unchanged
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendRecord
+(
+    RecordHeader_t* headerPtr,      ///< [IN] Record header, the CRC is computed here
+    const void* bodyPtr             ///< [IN] Record body
+)
+{
+    uint8_t record[sizeof(RecordHeader_t) + MSGSTORE_BODY_MAX_BYTES];
+    size_t recordSize = sizeof(RecordHeader_t) + headerPtr->bodySize;
+
+    headerPtr->crc = ComputeRecordCrc(headerPtr, bodyPtr);
+    memcpy(record, headerPtr, sizeof(RecordHeader_t));
+    memcpy(record + sizeof(RecordHeader_t), bodyPtr, headerPtr->bodySize);
+
+    if (WriteAt(LogFd, record, recordSize, LogSize) != LE_OK)
+    {
+        // Drop what was written of the record
+        if (ftruncate(LogFd, LogSize) != 0)
+        {
+            LE_ERROR("Unable to truncate %s: %m", LogPath);
+        }
+        return LE_FAULT;
+    }
+
+    LogSize += recordSize;
+    NumSinceSnapshot++;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a message record from the log, and check it.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on read error or if the record is corrupted
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadMsgRecord
+(
+    const IndexRecord_t* indexPtr,  ///< [IN] Index record of the message
+    RecordHeader_t* headerPtr,      ///< [OUT] Record header
+    uint8_t* bodyPtr                ///< [OUT] Record body, MSGSTORE_BODY_MAX_BYTES
+)
+{
+    uint8_t record[sizeof(RecordHeader_t) + MSGSTORE_BODY_MAX_BYTES];
+    size_t recordSize = sizeof(RecordHeader_t) + indexPtr->bodySize;
+
+    if (ReadAt(LogFd, record, recordSize, indexPtr->offset) != LE_OK)
+    {
+        LE_ERROR("Unable to read message %08x", (unsigned int)indexPtr->msgId);
+        return LE_FAULT;
+    }
+
+    memcpy(headerPtr, record, sizeof(RecordHeader_t));
+    memcpy(bodyPtr, record + sizeof(RecordHeader_t), indexPtr->bodySize);
+
+    if ((headerPtr->type != RECORD_MSG) ||
+        (headerPtr->msgId != indexPtr->msgId) ||
+        (headerPtr->bodySize != indexPtr->bodySize) ||
+        (headerPtr->crc != ComputeRecordCrc(headerPtr, bodyPtr)))
+    {
+        LE_ERROR("Message %08x is corrupted", (unsigned int)indexPtr->msgId);
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a new, empty, log.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on write error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CreateLog
+(
+    void
+)
+{
+    LogHeader_t header;
+
+    InitLogHeader(&header, Generation);
+
+    // The index of a previous log must not be applied to this one
+    unlink(IndexPath);
+
+    if ((ftruncate(LogFd, 0) != 0) ||
+        (WriteAt(LogFd, &header, sizeof(header), 0) != LE_OK) ||
+        (fdatasync(LogFd) != 0))
+    {
+        LE_ERROR("Unable to create %s: %m", LogPath);
+        return LE_FAULT;
+    }
+
+    LogSize = sizeof(header);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Save a snapshot of the index.  The snapshot is a cache: it is not flushed to flash, as the log
+ * is replayed if it is missing or outdated.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SaveIndex
+(
+    void
+)
+{
+    char tmpPath[MAX_PATH_BYTES + sizeof(TMP_FILE_SUFFIX)];
+    IndexHeader_t header = { INDEX_MAGIC, FORMAT_VERSION, Generation, LogSize, 0,
+                             LE_CRC_START_CRC32 };
+    size_t offset = sizeof(header);
+    size_t i;
+    int fd;
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s" TMP_FILE_SUFFIX, IndexPath);
+
+    fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LE_ERROR("Unable to create %s: %m", tmpPath);
+        return;
+    }
+
+    WriterStart(fd);
+    for (i = 0; i < NumEntries; i++)
+    {
+        const IndexRecord_t* recordPtr = &EntriesPtr[i].record;
+
+        if (recordPtr->inboxMask != 0)
+        {
+            header.crc = le_crc_Crc32((uint8_t*)recordPtr, sizeof(*recordPtr), header.crc);
+            header.numRecords++;
+            WriterPut(recordPtr, sizeof(*recordPtr), &offset);
+        }
+    }
+    WriterFlush(&offset);
+
+    if ((Writer.result == LE_OK) && (WriteAt(fd, &header, sizeof(header), 0) == LE_OK))
+    {
+        close(fd);
+
+        if (rename(tmpPath, IndexPath) == 0)
+        {
+            NumSinceSnapshot = 0;
+            return;
+        }
+        LE_ERROR("Unable to rename %s: %m", tmpPath);
+    }
+    else
+    {
+        close(fd);
+    }
+
+    unlink(tmpPath);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the snapshot of the index, if it applies to the log.
+ *
+ * @return Size of the log covered by the snapshot, 0 if there is no valid snapshot.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t LoadIndex
+(
+    size_t logSize          ///< [IN] Current size of the log
+)
+{
+    IndexHeader_t header;
+    IndexRecord_t* recordsPtr = NULL;
+    size_t recordsSize;
+    size_t coveredSize = 0;
+    uint32_t i;
+    int fd;
+
+    fd = open(IndexPath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    if ((ReadAt(fd, &header, sizeof(header), 0) != LE_OK) ||
+        (header.magic != INDEX_MAGIC) ||
+        (header.version != FORMAT_VERSION) ||
+        (header.generation != Generation) ||
+        (header.logSize < sizeof(LogHeader_t)) ||
+        (header.logSize > logSize) ||
+        (header.numRecords > logSize / sizeof(RecordHeader_t)))
+    {
+        LE_WARN("Outdated message index");
+        goto end;
+    }
+
+    recordsSize = (size_t)header.numRecords * sizeof(IndexRecord_t);
+    recordsPtr = malloc(recordsSize ? recordsSize : 1);
+    LE_ASSERT(recordsPtr != NULL);
+
+    if ((ReadAt(fd, recordsPtr, recordsSize, sizeof(header)) != LE_OK) ||
+        (le_crc_Crc32((uint8_t*)recordsPtr, recordsSize, LE_CRC_START_CRC32) != header.crc))
+    {
+        LE_WARN("Corrupted message index");
+        goto end;
+    }
+
+    for (i = 0; i < header.numRecords; i++)
+    {
+        if ((recordsPtr[i].bodySize > MSGSTORE_BODY_MAX_BYTES) ||
+            (recordsPtr[i].offset + sizeof(RecordHeader_t) + recordsPtr[i].bodySize >
+                                                                            header.logSize))
+        {
+            LE_WARN("Corrupted message index");
+            goto end;
+        }
+    }
+
+    for (i = 0; i < header.numRecords; i++)
+    {
+        AddEntry(&recordsPtr[i]);
+    }
+
+    // Everything covered by the snapshot which is not a stored message is dead
+    coveredSize = header.logSize;
+    DeadSize = coveredSize - sizeof(LogHeader_t) - LiveSize;
+
+end:
+    free(recordsPtr);
+    close(fd);
+
+    return coveredSize;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the log from a given offset, to complete the index.  The log is truncated after its last
+ * valid record.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReplayLog
+(
+    size_t offset,          ///< [IN] Offset of the first record to replay
+    size_t logSize          ///< [IN] Size of the log
+)
+{
+    uint8_t body[MSGSTORE_BODY_MAX_BYTES];
+    RecordHeader_t header;
+
+    while (offset + sizeof(header) <= logSize)
+    {
+        size_t recordSize;
+
+        if (ReadAt(LogFd, &header, sizeof(header), offset) != LE_OK)
+        {
+            break;
+        }
+
+        recordSize = sizeof(header) + header.bodySize;
+
+        if ((header.bodySize > MSGSTORE_BODY_MAX_BYTES) ||
+            ((header.type != RECORD_MSG) && (header.type != RECORD_FLAGS)) ||
+            (offset + recordSize > logSize) ||
+            (ReadAt(LogFd, body, header.bodySize, offset + sizeof(header)) != LE_OK) ||
+            (header.crc != ComputeRecordCrc(&header, body)))
+        {
+            break;
+        }
+
+        Entry_t* entryPtr = FindEntry(header.msgId);
+
+        if (header.type == RECORD_MSG)
+        {
+            IndexRecord_t record =
+            {
+                header.msgId, offset, header.inboxMask, header.unreadMask, header.bodySize
+            };
+
+            if (entryPtr != NULL)
+            {
+                LE_WARN("Message %08x stored twice", (unsigned int)header.msgId);
+                SetEntryFlags(entryPtr, 0, 0);
+            }
+
+            if (header.inboxMask != 0)
+            {
+                AddEntry(&record);
+            }
+            else
+            {
+                DeadSize += recordSize;
+            }
+        }
+        else
+        {
+            if (entryPtr != NULL)
+            {
+                SetEntryFlags(entryPtr, header.inboxMask, header.unreadMask);
+            }
+            DeadSize += recordSize;
+        }
+
+        offset += recordSize;
+        NumSinceSnapshot++;
+    }
+
+    if (offset != logSize)
+    {
+        LE_WARN("Dropping %zu bytes at the end of %s", logSize - offset, LogPath);
+        if (ftruncate(LogFd, offset) != 0)
+        {
+            LE_ERROR("Unable to truncate %s: %m", LogPath);
+        }
+    }
+
+    LogSize = offset;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compact the log if it is worth it, otherwise save a snapshot of the index if it is due.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Maintain
+(
+    void
+)
+{
+    if ((DeadSize >= COMPACT_MIN_BYTES) && (DeadSize >= LiveSize))
+    {
+        if (msgStore_Compact() == LE_OK)
+        {
+            return;
+        }
+    }
+
+    if (NumSinceSnapshot >= SNAPSHOT_INTERVAL)
+    {
+        SaveIndex();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+//                                       Public functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the message store kept in a directory, creating it if needed.
+ *
+ * The index is loaded from its last snapshot, and completed by replaying the end of the log.  A
+ * record torn by a power loss is dropped.
+ *
+ * Message box i is bit i of the flags.  If the message boxes were named differently when the
+ * store was last opened, the flags of the stored messages are moved to the bits now holding
+ * their message boxes, and messages are dropped from the message boxes that no longer exist.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT if the store can't be opened or created, or a name is too long
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Open
+(
+    const char* dirPathPtr,                 ///< [IN] Directory of the store, ending with a '/'
+    const char* const* mboxNamesPtr,        ///< [IN] Name of the message box of each bit of the
+                                            ///<      flags, NULL or "" if unused
+    size_t numMboxes                        ///< [IN] Number of message box names
+)
+{
+    char tmpPath[MAX_PATH_BYTES + sizeof(TMP_FILE_SUFFIX)];
+    LogHeader_t header;
+    struct stat st;
+    size_t coveredSize;
+    size_t i;
+
+    if (LogFd >= 0)
+    {
+        LE_ERROR("Message store already open");
+        return LE_FAULT;
+    }
+
+    if (numMboxes > MSGSTORE_MAX_MBOX)
+    {
+        LE_ERROR("Too many message boxes: %zu", numMboxes);
+        return LE_FAULT;
+    }
+
+    memset(MboxNames, 0, sizeof(MboxNames));
+    for (i = 0; i < numMboxes; i++)
+    {
+        if ((mboxNamesPtr[i] != NULL) &&
+            (LE_OK != le_utf8_Copy(MboxNames[i], mboxNamesPtr[i], sizeof(MboxNames[i]), NULL)))
+        {
+            LE_ERROR("Message box name too long: %s", mboxNamesPtr[i]);
+            return LE_FAULT;
+        }
+    }
+
+    if ((LE_OK != le_utf8_Copy(DirPath, dirPathPtr, sizeof(DirPath), NULL)) ||
+        (snprintf(LogPath, sizeof(LogPath), "%s" LOG_FILE_NAME, dirPathPtr) >=
+                                                                    (int)sizeof(LogPath) - 4) ||
+        (snprintf(IndexPath, sizeof(IndexPath), "%s" INDEX_FILE_NAME, dirPathPtr) >=
+                                                                    (int)sizeof(IndexPath) - 4))
+    {
+        LE_ERROR("Path too long: %s", dirPathPtr);
+        return LE_FAULT;
+    }
+
+    if (SeqMap == NULL)
+    {
+        SeqMap = le_hashmap_Create("smsInboxMsgIds", INDEX_INITIAL_ENTRIES,
+                                   le_hashmap_HashVoidPointer, le_hashmap_EqualsVoidPointer);
+    }
+    ClearIndex();
+    NumSinceSnapshot = 0;
+
+    // Files left by an interrupted compaction or snapshot
+    snprintf(tmpPath, sizeof(tmpPath), "%s" TMP_FILE_SUFFIX, LogPath);
+    unlink(tmpPath);
+    snprintf(tmpPath, sizeof(tmpPath), "%s" TMP_FILE_SUFFIX, IndexPath);
+    unlink(tmpPath);
+
+    LogFd = open(LogPath, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if ((LogFd < 0) || (fstat(LogFd, &st) != 0))
+    {
+        LE_ERROR("Unable to open %s: %m", LogPath);
+        goto error;
+    }
+
+    if (((size_t)st.st_size < sizeof(header)) ||
+        (ReadAt(LogFd, &header, sizeof(header), 0) != LE_OK) ||
+        (!IsLogHeaderValid(&header)))
+    {
+        if (st.st_size != 0)
+        {
+            LE_ERROR("%s is not a valid message log, its messages are lost", LogPath);
+        }
+
+        Generation = 1;
+        if (CreateLog() != LE_OK)
+        {
+            goto error;
+        }
+        return LE_OK;
+    }
+
+    Generation = header.generation;
+
+    coveredSize = LoadIndex(st.st_size);
+    if (coveredSize == 0)
+    {
+        coveredSize = sizeof(header);
+    }
+    ReplayLog(coveredSize, st.st_size);
+
+    LE_INFO("%zu messages stored, log of %zu bytes (%zu dead)",
+            le_hashmap_Size(SeqMap), LogSize, DeadSize);
+
+    // The flags refer to the message boxes named in the log: record the new names before
+    // anything is appended with the new bits.
+    if (memcmp(header.mboxNames, MboxNames, sizeof(MboxNames)) != 0)
+    {
+        RemapEntries(&header);
+
+        if (msgStore_Compact() != LE_OK)
+        {
+            LE_ERROR("Unable to record the new message boxes in %s", LogPath);
+            goto error;
+        }
+        return LE_OK;
+    }
+
+    Maintain();
+
+    return LE_OK;
+
+error:
+    if (LogFd >= 0)
+    {
+        close(LogFd);
+        LogFd = -1;
+    }
+    ClearIndex();
+    return LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the message store, saving a snapshot of its index.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStore_Close
+(
+    void
+)
+{
+    if (LogFd < 0)
+    {
+        return;
+    }
+
+    if (NumSinceSnapshot > 0)
+    {
+        SaveIndex();
+    }
+
+    close(LogFd);
+    LogFd = -1;
+
+    ClearIndex();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a message.  The message is on flash when this function returns.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_DUPLICATE if a message with this identifier is already stored
+ *      - LE_BAD_PARAMETER if the message is in no message box or is too large
+ *      - LE_FAULT on write error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Add
+(
+    uint32_t msgId,                         ///< [IN] Message identifier, not 0
+    uint32_t inboxMask,                     ///< [IN] Message boxes the message is in
+    uint32_t unreadMask,                    ///< [IN] Message boxes the message is unread in
+    const void* bodyPtr,                    ///< [IN] Message body
+    size_t bodySize                         ///< [IN] Message body size, in bytes
+)
+{
+    if ((msgId == 0) || (inboxMask == 0) || (bodySize > MSGSTORE_BODY_MAX_BYTES))
+    {
+        LE_ERROR("Bad message %08x, inbox mask %08x, size %zu",
+                 (unsigned int)msgId, (unsigned int)inboxMask, bodySize);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (LogFd < 0)
+    {
+        LE_ERROR("Message store not open");
+        return LE_FAULT;
+    }
+
+    if (FindEntry(msgId) != NULL)
+    {
+        return LE_DUPLICATE;
+    }
+
+    RecordHeader_t header =
+    {
+        .type = RECORD_MSG,
+        .bodySize = bodySize,
+        .msgId = msgId,
+        .inboxMask = inboxMask,
+        .unreadMask = unreadMask
+    };
+    IndexRecord_t record = { msgId, LogSize, inboxMask, unreadMask, bodySize };
+
+    if (AppendRecord(&header, bodyPtr) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    // The message may have been removed from the SIM: make sure it is on flash
+    if (fdatasync(LogFd) != 0)
+    {
+        LE_ERROR("Unable to flush %s: %m", LogPath);
+    }
+
+    AddEntry(&record);
+    Maintain();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the flags of a message.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message is not stored
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_GetFlags
+(
+    uint32_t msgId,                         ///< [IN] Message identifier
+    uint32_t* inboxMaskPtr,                 ///< [OUT] Message boxes the message is in
+    uint32_t* unreadMaskPtr                 ///< [OUT] Message boxes the message is unread in
+)
+{
+    Entry_t* entryPtr = FindEntry(msgId);
+
+    if (entryPtr == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    *inboxMaskPtr = entryPtr->record.inboxMask;
+    *unreadMaskPtr = entryPtr->record.unreadMask;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the flags of a message.  The message is deleted once it is in no message box.
+ *
+ * Flag changes are appended to the log but not flushed: a power loss may undo the latest ones.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message is not stored
+ *      - LE_FAULT on write error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_SetFlags
+(
+    uint32_t msgId,                         ///< [IN] Message identifier
+    uint32_t inboxMask,                     ///< [IN] Message boxes the message is in
+    uint32_t unreadMask                     ///< [IN] Message boxes the message is unread in
+)
+{
+    Entry_t* entryPtr = FindEntry(msgId);
+
+    if (entryPtr == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if ((entryPtr->record.inboxMask == inboxMask) && (entryPtr->record.unreadMask == unreadMask))
+    {
+        return LE_OK;
+    }
+
+    RecordHeader_t header =
+    {
+        .type = RECORD_FLAGS,
+        .bodySize = 0,
+        .msgId = msgId,
+        .inboxMask = inboxMask,
+        .unreadMask = unreadMask
+    };
+
+    if (AppendRecord(&header, NULL) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+    DeadSize += sizeof(header);
+
+    SetEntryFlags(entryPtr, inboxMask, unreadMask);
+    Maintain();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the body of a message.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message is not stored
+ *      - LE_OVERFLOW if the buffer is too small
+ *      - LE_FAULT on read error or if the message is corrupted
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Read
+(
+    uint32_t msgId,                         ///< [IN] Message identifier
+    void* bodyPtr,                          ///< [OUT] Message body
+    size_t* bodySizePtr                     ///< [INOUT] Buffer size, then message body size
+)
+{
+    uint8_t body[MSGSTORE_BODY_MAX_BYTES];
+    RecordHeader_t header;
+    Entry_t* entryPtr = FindEntry(msgId);
+
+    if (entryPtr == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if (entryPtr->record.bodySize > *bodySizePtr)
+    {
+        return LE_OVERFLOW;
+    }
+
+    if (ReadMsgRecord(&entryPtr->record, &header, body) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    memcpy(bodyPtr, body, header.bodySize);
+    *bodySizePtr = header.bodySize;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next message of a message box, in the order the messages were added.
+ *
+ * The cursor must be set to 0 to get the first message.  Messages added or deleted while
+ * browsing are taken into account.
+ *
+ * @return
+ *      - Message identifier
+ *      - 0 if there is no more message
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStore_GetNext
+(
+    uint32_t mboxIdx,                       ///< [IN] Message box, i.e. bit number in the flags
+    uint32_t* cursorPtr                     ///< [INOUT] Browsing cursor
+)
+{
+    size_t pos;
+
+    if (mboxIdx >= MSGSTORE_MAX_MBOX)
+    {
+        return 0;
+    }
+
+    for (pos = FindPos(*cursorPtr + 1); pos < NumEntries; pos++)
+    {
+        if (EntriesPtr[pos].record.inboxMask & (1u << mboxIdx))
+        {
+            *cursorPtr = EntriesPtr[pos].seq;
+            return EntriesPtr[pos].record.msgId;
+        }
+    }
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStore_GetCount
+(
+    uint32_t mboxIdx                        ///< [IN] Message box, i.e. bit number in the flags
+)
+{
+    if (mboxIdx >= MSGSTORE_MAX_MBOX)
+    {
+        return 0;
+    }
+
+    return MboxCount[mboxIdx];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the identifier of the latest message added.
+ *
+ * @return
+ *      - Message identifier
+ *      - 0 if the store is empty
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStore_GetLatestId
+(
+    void
+)
+{
+    if (NumEntries == 0)
+    {
+        return 0;
+    }
+
+    return EntriesPtr[NumEntries - 1].record.msgId;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rewrite the log with the stored messages only.  This is done automatically once deleted
+ * messages and flag changes take more room than the stored messages.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on error, the log is left unchanged
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Compact
+(
+    void
+)
+{
+    char tmpPath[MAX_PATH_BYTES + sizeof(TMP_FILE_SUFFIX)];
+    LogHeader_t logHeader;
+    uint8_t body[MSGSTORE_BODY_MAX_BYTES];
+    RecordHeader_t header;
+    size_t offset = 0;
+    size_t newSize;
+    size_t i;
+    int fd;
+
+    if (LogFd < 0)
+    {
+        LE_ERROR("Message store not open");
+        return LE_FAULT;
+    }
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s" TMP_FILE_SUFFIX, LogPath);
+
+    fd = open(tmpPath, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LE_ERROR("Unable to create %s: %m", tmpPath);
+        return LE_FAULT;
+    }
+
+    InitLogHeader(&logHeader, Generation + 1);
+
+    // Copy the stored messages, with their current flags.  The index is only updated once the
+    // new log has replaced the old one.
+    WriterStart(fd);
+    WriterPut(&logHeader, sizeof(logHeader), &offset);
+    for (i = 0; i < NumEntries; i++)
+    {
+        Entry_t* entryPtr = &EntriesPtr[i];
+
+        entryPtr->newOffset = 0;
+
+        if (entryPtr->record.inboxMask == 0)
+        {
+            continue;
+        }
+
+        if (ReadMsgRecord(&entryPtr->record, &header, body) != LE_OK)
+        {
+            // Unreadable: don't carry it over
+            continue;
+        }
+
+        entryPtr->newOffset = offset + Writer.used;
+
+        header.inboxMask = entryPtr->record.inboxMask;
+        header.unreadMask = entryPtr->record.unreadMask;
+        header.crc = ComputeRecordCrc(&header, body);
+
+        WriterPut(&header, sizeof(header), &offset);
+        WriterPut(body, header.bodySize, &offset);
+    }
+    WriterFlush(&offset);
+
+    if ((Writer.result != LE_OK) || (fdatasync(fd) != 0) || (rename(tmpPath, LogPath) != 0))
+    {
+        LE_ERROR("Unable to compact %s", LogPath);
+        close(fd);
+        unlink(tmpPath);
+        return LE_FAULT;
+    }
+    SyncDir();
+
+    close(LogFd);
+    LogFd = fd;
+    Generation++;
+
+    // Messages are now back to back, in the same order, except the unreadable ones
+    for (i = 0; i < NumEntries; i++)
+    {
+        Entry_t* entryPtr = &EntriesPtr[i];
+
+        if (entryPtr->record.inboxMask == 0)
+        {
+            continue;
+        }
+
+        if (entryPtr->newOffset == 0)
+        {
+            SetEntryFlags(entryPtr, 0, 0);
+        }
+        else
+        {
+            entryPtr->record.offset = entryPtr->newOffset;
+        }
+    }
+    PurgeEntries();
+    newSize = offset;
+
+    LE_INFO("Message log compacted from %zu to %zu bytes", LogSize, newSize);
+
+    LogSize = newSize;
+    DeadSize = 0;
+    SaveIndex();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the log size, and the number of bytes that compaction would reclaim.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStore_GetLogSize
+(
+    size_t* logSizePtr,                     ///< [OUT] Log size, in bytes
+    size_t* deadSizePtr                     ///< [OUT] Size of deleted messages and flag changes
+)
+{
+    *logSizePtr = LogSize;
+    *deadSizePtr = DeadSize;
+}
@@ -0,0 +1,227 @@
+// -------------------------------------------------------------------------------------------------
+/**
+ *  SMS Inbox Server
+ *
+ *  Interface of the message store: an append-only log of messages, indexed in memory by message
+ *  identifier, with the message box membership and read status of each message kept as bitmaps
+ *  (one bit per message box).  The name of the message box of each bit is kept in the log, so
+ *  that messages follow their message box when bits are reassigned.
+ *
+ *  Copyright (C) Sierra Wireless Inc.
+ */
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MSGSTORE_H_INCLUDE_GUARD
+#define MSGSTORE_H_INCLUDE_GUARD
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of message boxes, i.e. number of bits in the flags bitmaps.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSGSTORE_MAX_MBOX           32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a message box name, including the terminating null character.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSGSTORE_MBOX_NAME_BYTES    64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a message body, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSGSTORE_BODY_MAX_BYTES     1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the message store kept in a directory, creating it if needed.
+ *
+ * The index is loaded from its last snapshot, and completed by replaying the end of the log.  A
+ * record torn by a power loss is dropped.
+ *
+ * Message box i is bit i of the flags.  If the message boxes were named differently when the
+ * store was last opened, the flags of the stored messages are moved to the bits now holding
+ * their message boxes, and messages are dropped from the message boxes that no longer exist.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT if the store can't be opened or created, or a name is too long
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Open
+(
+    const char* dirPathPtr,                 ///< [IN] Directory of the store, ending with a '/'
+    const char* const* mboxNamesPtr,        ///< [IN] Name of the message box of each bit of the
+                                            ///<      flags, NULL or "" if unused
+    size_t numMboxes                        ///< [IN] Number of message box names
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the message store, saving a snapshot of its index.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStore_Close
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a message.  The message is on flash when this function returns.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_DUPLICATE if a message with this identifier is already stored
+ *      - LE_BAD_PARAMETER if the message is in no message box or is too large
+ *      - LE_FAULT on write error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Add
+(
+    uint32_t msgId,                         ///< [IN] Message identifier, not 0
+    uint32_t inboxMask,                     ///< [IN] Message boxes the message is in
+    uint32_t unreadMask,                    ///< [IN] Message boxes the message is unread in
+    const void* bodyPtr,                    ///< [IN] Message body
+    size_t bodySize                         ///< [IN] Message body size, in bytes
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the flags of a message.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message is not stored
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_GetFlags
+(
+    uint32_t msgId,                         ///< [IN] Message identifier
+    uint32_t* inboxMaskPtr,                 ///< [OUT] Message boxes the message is in
+    uint32_t* unreadMaskPtr                 ///< [OUT] Message boxes the message is unread in
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the flags of a message.  The message is deleted once it is in no message box.
+ *
+ * Flag changes are appended to the log but not flushed: a power loss may undo the latest ones.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message is not stored
+ *      - LE_FAULT on write error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_SetFlags
+(
+    uint32_t msgId,                         ///< [IN] Message identifier
+    uint32_t inboxMask,                     ///< [IN] Message boxes the message is in
+    uint32_t unreadMask                     ///< [IN] Message boxes the message is unread in
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the body of a message.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message is not stored
+ *      - LE_OVERFLOW if the buffer is too small
+ *      - LE_FAULT on read error or if the message is corrupted
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Read
+(
+    uint32_t msgId,                         ///< [IN] Message identifier
+    void* bodyPtr,                          ///< [OUT] Message body
+    size_t* bodySizePtr                     ///< [INOUT] Buffer size, then message body size
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next message of a message box, in the order the messages were added.
+ *
+ * The cursor must be set to 0 to get the first message.  Messages added or deleted while
+ * browsing are taken into account.
+ *
+ * @return
+ *      - Message identifier
+ *      - 0 if there is no more message
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStore_GetNext
+(
+    uint32_t mboxIdx,                       ///< [IN] Message box, i.e. bit number in the flags
+    uint32_t* cursorPtr                     ///< [INOUT] Browsing cursor
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStore_GetCount
+(
+    uint32_t mboxIdx                        ///< [IN] Message box, i.e. bit number in the flags
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the identifier of the latest message added.
+ *
+ * @return
+ *      - Message identifier
+ *      - 0 if the store is empty
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t msgStore_GetLatestId
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rewrite the log with the stored messages only.  This is done automatically once deleted
+ * messages and flag changes take more room than the stored messages.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on error, the log is left unchanged
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgStore_Compact
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the log size, and the number of bytes that compaction would reclaim.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgStore_GetLogSize
+(
+    size_t* logSizePtr,                     ///< [OUT] Log size, in bytes
+    size_t* deadSizePtr                     ///< [OUT] Size of deleted messages and flag changes
+);
+
+#endif // MSGSTORE_H_INCLUDE_GUARD
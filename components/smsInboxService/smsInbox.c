@@ -2,18 +2,17 @@
 /**
  *  SMS Inbox Server
  *
- * When the service is activated, or when a SMS is received, the SMS is copied from the SIM to a
- * specific folder (SMSINBOX_PATH/MSG_PATH).
+ * When the service is activated, or when a SMS is received, the SMS is copied from the SIM to the
+ * message store (see msgStore.h) kept in SMSINBOX_PATH.
  *
- * Each SMS is copied into a dedicated file (named with a unique message identifier). The data
- * are stored using the Jannsson representation: Each data (imsi, SMS format, message length,
- * text/pdu, sender telephone number, timestamp, read/unread) are recorded with a key to retrieve
- * each value.
+ * Each SMS is appended to the store log as a binary record holding its data (imsi, SMS format,
+ * message length, text/pdu, sender telephone number, timestamp). The message boxes of the
+ * applications using the SMS Inbox Server are bitmaps kept with each message in the store index:
+ * one bit per application tells if the message is in its message box, another one if it is unread.
  *
- * Each application using the SMS Inbox Server possesses a configuration file in
- * SMSINBOX_PATH/CONF_PATH directory (also encoding using Jansson format): this file is used to
- * store the message identifier contained in the application mailbox. It is updated each time is new
- * SMS is received.
+ * Previous versions stored each SMS into a dedicated Jansson file of SMSINBOX_PATH/MSG_PATH, and
+ * the message identifiers of each application mailbox into a Jansson file of
+ * SMSINBOX_PATH/CONF_PATH. These files are imported into the message store, then removed.
  *
  *  Copyright (C) Sierra Wireless Inc.
  */
@@ -23,6 +22,7 @@
 #include "interfaces.h"
 #include "mdmCfgEntries.h"
 #include "le_smsInbox.h"
+#include "msgStore.h"
 
 #include "le_print.h"
 #include "le_hex.h"
@@ -78,6 +78,9 @@
 //--------------------------------------------------------------------------------------------------
 #define MAX_APPS 16
 
+// Each application has a bit in the message store flags
+static_assert(MAX_APPS <= MSGSTORE_MAX_MBOX, "Too many applications for the message store");
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Default size of message box.
@@ -90,7 +93,14 @@
  * Maximum number of messages for message box.
  */
 //--------------------------------------------------------------------------------------------------
-#define MAX_MBOX_SIZE     100
+#define MAX_MBOX_SIZE     LE_CONFIG_SMSINBOX_MAX_MBOX_SIZE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a message payload: PDU, text or binary data with a last '\0'.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PAYLOAD_MAX_BYTES (LE_SMS_PDU_MAX_BYTES + 1)
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -139,40 +149,30 @@ typedef uint32_t MessageId_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    json_t* jsonObjPtr;
-    json_t* jsonArrayPtr;
-    uint32_t currentMessageIndex;
-    uint32_t maxIndex;
+    uint32_t cursor;                    ///< Message store cursor
+    bool     isBrowsing;                ///< GetFirst called and last message not reached
 }
 BrowseCtx_t;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Entry description structure.
+ * Message body, as kept in the message store. Only the payloadLen first bytes of the payload are
+ * stored.
  *
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    enum
-    {
-        DESC_INT,
-        DESC_STRING,
-        DESC_BOOL
-    }                               type;       ///< Union type (string or integer
-    union
-    {
-        struct
-        {
-            char*   strPtr;                     ///< String
-            size_t  lenStr;                     ///< Length of the string
-        }                  str;                 ///< Value for string
-        uint32_t           val;                 ///< Value for integer
-        bool               boolVal;             ///< Boolean value
-    }                               uVal;       ///< Union type
+    int32_t  format;                                    ///< le_sms_Format_t
+    uint32_t msgLen;                                    ///< Message length
+    uint16_t payloadLen;                                ///< Payload length
+    bool     hasPayload;                                ///< Payload is set
+    char     imsi[LE_SIM_IMSI_BYTES];                   ///< SIM IMSI
+    char     senderTel[LE_MDMDEFS_PHONE_NUM_MAX_BYTES]; ///< Sender telephone number
+    char     timestamp[LE_SMS_TIMESTAMP_MAX_BYTES];     ///< Timestamp
+    uint8_t  payload[PAYLOAD_MAX_BYTES];                ///< Text, binary data or PDU
 }
-EntryDesc_t;
-
+MsgBody_t;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -184,8 +184,6 @@ typedef struct
 {
     char *    namePtr;                  ///< App name
     uint32_t inboxSize;                 ///< Max messages in the inbox
-    uint32_t msgCount;                  ///< Number message
-
 }
 MboxCtx_t;
 
@@ -336,1137 +334,754 @@ static le_ref_MapRef_t ActivationRequestRefMap;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add a boolean value of a key in a Jason object
+ * Get the SMSInbox directory path length
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t AddBooleanKeyInJsonObject
+static uint32_t GetSMSInboxMessagePathLen
 (
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    bool value          ///<[IN] Value to be added
+    void
 )
 {
-    json_t *jsonBoolPtr;
-    int ret = -1;
-
-    if ( value == true )
-    {
-        jsonBoolPtr = json_true();
-    }
-    else
-    {
-        jsonBoolPtr = json_false();
-    }
-
-    if (jsonBoolPtr)
-    {
-        ret = json_object_set_new(jsonObjPtr, key, jsonBoolPtr);
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
+    return 2*sizeof(MessageId_t)+strlen(SMSINBOX_PATH)+strlen(MSG_PATH)+strlen(FILE_EXTENSION)+1;
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Add an integer value of a key in a Jason object
+ * Get the SMSInbox file path
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t AddIntegerKeyInJsonObject
+static void GetSMSInboxMessagePath
 (
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    int  value          ///<[IN] Value to be added
+    MessageId_t messageId,  ///[IN] message identifier
+    char* pathPtr,          ///<[OUT] path of the messageId file
+    uint32_t pathLen        ///<[IN] Length of pathPtr
 )
 {
-    json_t *jsonIntPtr = json_integer(value);
-    int ret = -1;
-
-    if (jsonIntPtr)
-    {
-        if (json_is_array(jsonObjPtr))
-        {
-            ret = json_array_append_new(jsonObjPtr, jsonIntPtr);
-        }
-        else
-        {
-            ret = json_object_set_new(jsonObjPtr, key, jsonIntPtr);
-        }
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
+    snprintf(pathPtr, pathLen, "%s%s%08x%s", SMSINBOX_PATH, MSG_PATH,
+                                            (int) messageId,
+                                            FILE_EXTENSION);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add a string value of a key in a Jason object
+ * Get the SMSInbox configuration path length
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t AddStringKeyInJsonObject
+static uint32_t GetSMSInboxConfigPathLen
 (
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    char* string        ///<[IN] String to be added
+    char* appNamePtr    ///<[IN] Application name
 )
 {
-    json_t * jsonStrPtr = json_string(string);
-    int ret = -1;
-
-    if (jsonStrPtr)
-    {
-        ret = json_object_set_new(jsonObjPtr, key, jsonStrPtr);
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
+    return strlen(appNamePtr)+strlen(SMSINBOX_PATH)+strlen(CONF_PATH)+strlen(FILE_EXTENSION)+1;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the SMSInbox directory path length
+ * Get the application's box file descriptor path
  *
  */
 //--------------------------------------------------------------------------------------------------
-static uint32_t GetSMSInboxMessagePathLen
+static void GetSMSInboxConfigPath
 (
-    void
+    char* appNamePtr,   ///<[IN] Application name
+    char* pathPtr,      ///<[OUT] configuration file path
+    uint32_t pathLen    ///<[IN] path length
 )
 {
-    return 2*sizeof(MessageId_t)+strlen(SMSINBOX_PATH)+strlen(MSG_PATH)+strlen(FILE_EXTENSION)+1;
+    snprintf(pathPtr, pathLen, "%s%s%s%s", SMSINBOX_PATH, CONF_PATH, appNamePtr, FILE_EXTENSION);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the SMSInbox file path
+ * Get the index of a message box, i.e. its bit number in the message store flags.  The message
+ * store keeps the name of each bit, so the index may change when message boxes are added or
+ * removed.
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void GetSMSInboxMessagePath
+static uint32_t GetMboxIdx
 (
-    MessageId_t messageId,  ///[IN] message identifier
-    char* pathPtr,          ///<[OUT] path of the messageId file
-    uint32_t pathLen        ///<[IN] Length of pathPtr
+    const MboxCtx_t* mboxCtxPtr     ///<[IN] message box
 )
 {
-    snprintf(pathPtr, pathLen, "%s%s%08x%s", SMSINBOX_PATH, MSG_PATH,
-                                            (int) messageId,
-                                            FILE_EXTENSION);
+    return mboxCtxPtr - Apps;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the SMSInbox configuration path length
+ * Get the bit of a message box in the message store flags
  *
  */
 //--------------------------------------------------------------------------------------------------
-static uint32_t GetSMSInboxConfigPathLen
+static uint32_t GetMboxBit
 (
-    char* appNamePtr    ///<[IN] Application name
+    const MboxCtx_t* mboxCtxPtr     ///<[IN] message box
 )
 {
-    return strlen(appNamePtr)+strlen(SMSINBOX_PATH)+strlen(CONF_PATH)+strlen(FILE_EXTENSION)+1;
+    return 1u << GetMboxIdx(mboxCtxPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the application's box file descriptor path
+ * Check if a message belongs to a message box
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void GetSMSInboxConfigPath
+static bool IsMsgInMbox
 (
-    char* appNamePtr,   ///<[IN] Application name
-    char* pathPtr,      ///<[OUT] configuration file path
-    uint32_t pathLen    ///<[IN] path length
+    const MboxCtx_t* mboxCtxPtr,    ///<[IN] message box
+    MessageId_t messageId           ///<[IN] Message identifier
 )
 {
-    snprintf(pathPtr, pathLen, "%s%s%s%s", SMSINBOX_PATH, CONF_PATH, appNamePtr, FILE_EXTENSION);
+    uint32_t inboxMask;
+    uint32_t unreadMask;
+
+    if ( (msgStore_GetFlags(messageId, &inboxMask, &unreadMask) != LE_OK) ||
+         !(inboxMask & GetMboxBit(mboxCtxPtr)) )
+    {
+        LE_ERROR("Bad msg id %08x or mbox name %s", (int) messageId, mboxCtxPtr->namePtr);
+        return false;
+    }
+
+    return true;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Modify Json object
+ * Remove a message from a message box. The message is erased once it is in no message box.
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ModifyJsonObj
+static void RemoveMsgFromMbox
 (
-    json_t* jsonObjPtr,         ///<[IN] Json object (root object)
-    json_t* jsonValPtr,         ///<[IN] Json value to be modified
-    char*   key,                ///<[IN] Key to modify
-    EntryDesc_t * modifPtr      ///<[IN] Requested modification
+    const MboxCtx_t* mboxCtxPtr,    ///<[IN] message box
+    MessageId_t messageId           ///<[IN] Message identifier
 )
 {
-    int res = 0;
+    uint32_t mboxBit = GetMboxBit(mboxCtxPtr);
+    uint32_t inboxMask;
+    uint32_t unreadMask;
 
-    if (jsonValPtr == NULL)
+    if (msgStore_GetFlags(messageId, &inboxMask, &unreadMask) != LE_OK)
     {
-        LE_ERROR("NULL jsonValPtr");
-        return LE_FAULT;
+        return;
     }
 
-    switch (modifPtr->type)
-    {
-        case DESC_STRING:
-            // check the type
-            if (json_is_string(jsonValPtr) == false)
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if ( res == 0 )
-            {
-                res = json_string_set(jsonValPtr, modifPtr->uVal.str.strPtr);
-            }
-        break;
-        case DESC_INT:
-            // check the type
-            if (json_is_integer(jsonValPtr) == false )
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if ( res == 0 )
-            {
-                res = json_integer_set(jsonValPtr, modifPtr->uVal.val);
-            }
-        break;
-        case DESC_BOOL:
-            // check the type
-            if ( (json_is_true(jsonValPtr) != true) && (json_is_false(jsonValPtr) != true) )
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if (( res == 0 ) &&
-                (AddBooleanKeyInJsonObject(jsonObjPtr, key, modifPtr->uVal.boolVal) != LE_OK))
-            {
-                res = -1;
-            }
-        break;
-        default:
-            res = -1;
-        break;
-    }
+    LE_DEBUG("Remove messageId %d from %s", (int) messageId, mboxCtxPtr->namePtr);
 
-    if (res < 0)
-    {
-        LE_ERROR(("Update error %d"), modifPtr->type);
-        return LE_FAULT;
-    }
-    else
+    if (msgStore_SetFlags(messageId, inboxMask & ~mboxBit, unreadMask & ~mboxBit) != LE_OK)
     {
-        LE_DEBUG("ModifyJsonObj OK");
-        return LE_OK;
+        LE_ERROR("Can't remove message %08x from %s", (int) messageId, mboxCtxPtr->namePtr);
     }
-
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Modify message file
+ * Check if a message is unread in a message box
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ModifyMsgEntry
+static bool IsUnread
 (
-    MessageId_t messageId,      ///<[IN] Message identifier to be modified
-    char* keyPtr[],              ///<[IN] Key to modify
-    uint8_t nbKey,              ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * modifPtr      ///<[IN] Requested modification
+    const MboxCtx_t* mboxCtxPtr,    ///<[IN] message box
+    MessageId_t messageId           ///<[IN] Message identifier
 )
 {
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    json_error_t error;
-    le_result_t res;
-    int indexKey = -1;
+    uint32_t inboxMask;
+    uint32_t unreadMask;
 
-    GetSMSInboxMessagePath(messageId, path, pathLen);
+    if (msgStore_GetFlags(messageId, &inboxMask, &unreadMask) != LE_OK)
+    {
+        LE_ERROR("Message %08x not found", (int) messageId);
+        return false;
+    }
 
-    LE_DEBUG("ModifyMsgEntry: messageId %d, path %s",messageId, path);
+    return (unreadMask & GetMboxBit(mboxCtxPtr)) != 0;
+}
 
-    json_t* jsonRootPtr = json_load_file(path, 0, &error);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a message as read or unread in a message box
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetUnread
+(
+    const MboxCtx_t* mboxCtxPtr,    ///<[IN] message box
+    MessageId_t messageId,          ///<[IN] Message identifier
+    bool isUnread                   ///<[IN] New status
+)
+{
+    uint32_t mboxBit = GetMboxBit(mboxCtxPtr);
+    uint32_t inboxMask;
+    uint32_t unreadMask;
 
-    if ( jsonRootPtr == NULL )
+    if (msgStore_GetFlags(messageId, &inboxMask, &unreadMask) != LE_OK)
     {
-        LE_ERROR("Json decoder error %s", error.text);
-        return LE_FAULT;
+        LE_ERROR("Message %08x not found", (int) messageId);
+        return;
     }
 
-    json_t* jsonValPtr = jsonRootPtr;
-    json_t* jsonSubObjPtr = jsonRootPtr;
+    unreadMask = isUnread ? (unreadMask | mboxBit) : (unreadMask & ~mboxBit);
 
-    while ( ( json_is_object(jsonValPtr) == true ) && ( nbKey > indexKey ) )
+    // Nothing is written if the status doesn't change
+    if (msgStore_SetFlags(messageId, inboxMask, unreadMask) != LE_OK)
     {
-        indexKey++;
-        jsonSubObjPtr = jsonValPtr;
-        jsonValPtr = json_object_get(jsonSubObjPtr, keyPtr[indexKey]);
+        LE_ERROR("Can't modify message %08x", (int) messageId);
     }
+}
 
-    if ( !jsonValPtr )
-    {
-        if ((indexKey > -1) && (indexKey < nbKey))
-        {
-            LE_ERROR("Unable to get the object %s", keyPtr[indexKey]);
-        }
-        else
-        {
-            LE_ERROR("IndexKey: %d is out of range", indexKey);
-        }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a message from the message store
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadMsg
+(
+    const MboxCtx_t* mboxCtxPtr,    ///<[IN] message box
+    MessageId_t messageId,          ///<[IN] Message identifier
+    MsgBody_t* bodyPtr              ///<[OUT] Message body
+)
+{
+    size_t size = sizeof(MsgBody_t);
 
-        res = LE_FAULT;
-    }
-    else
+    if ( (msgStore_Read(messageId, bodyPtr, &size) != LE_OK) ||
+         (size < offsetof(MsgBody_t, payload)) ||
+         (size != offsetof(MsgBody_t, payload) + bodyPtr->payloadLen) )
     {
-        if ((indexKey > -1) && (indexKey < nbKey))
-        {
-            res = ModifyJsonObj(jsonSubObjPtr, jsonValPtr, keyPtr[indexKey], modifPtr);
-        }
-        else
-        {
-            LE_ERROR("IndexKey: %d is out of range", indexKey);
-            res = LE_FAULT;
-        }
+        // Unreadable message: remove it from the mbox
+        LE_ERROR("Message %08x can't be read, mboxName %s", (int) messageId, mboxCtxPtr->namePtr);
+        RemoveMsgFromMbox(mboxCtxPtr, messageId);
+        return LE_FAULT;
     }
 
-    if ( res == LE_OK )
-    {
-        if (json_dump_file(jsonRootPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0)
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
-    }
-    else
+    bodyPtr->imsi[sizeof(bodyPtr->imsi) - 1] = '\0';
+    bodyPtr->senderTel[sizeof(bodyPtr->senderTel) - 1] = '\0';
+    bodyPtr->timestamp[sizeof(bodyPtr->timestamp) - 1] = '\0';
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy a string of a message
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CopyMsgString
+(
+    const char* srcPtr,     ///<[IN] String of the message
+    char* dstPtr,           ///<[OUT] Buffer
+    size_t dstSize          ///<[IN] Buffer size
+)
+{
+    size_t len = strlen(srcPtr);
+
+    if (len >= dstSize)
     {
-        LE_ERROR("Something was wrong in ModifyJsonObj");
+        LE_ERROR("String too long");
+        return LE_OVERFLOW;
     }
 
-    json_decref(jsonRootPtr);
+    memcpy(dstPtr, srcPtr, len + 1);
 
-    return res;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read Json object
+ * Encode a message body
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ReadJsonObj
+static void EncodeMsgEntry
 (
-    json_t* jsonValPtr,         ///<[IN] Json value to be read
-    char* keyPtr[],             ///<[IN] Key to read
-    uint8_t nbKey,              ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * decodePtr     ///<[OUT] Decoding result
+    le_sms_MsgRef_t msgRef, ///<[IN] SMS to be encoded
+    MsgBody_t* bodyPtr      ///<[OUT] Message body
 )
 {
-    le_result_t res = LE_OK;
+    memset(bodyPtr, 0, offsetof(MsgBody_t, payload));
 
-    if ( jsonValPtr == NULL )
+    // Add imsi
+    if (le_utf8_Copy(bodyPtr->imsi, SimImsi, sizeof(bodyPtr->imsi), NULL) != LE_OK)
     {
-        LE_ERROR("No information");
-        return LE_FAULT;
+        LE_ERROR("Bad IMSI %s", SimImsi);
     }
 
-    switch json_typeof(jsonValPtr)
+    // Add sms format
+    le_sms_Format_t format = le_sms_GetFormat(msgRef);
+    bodyPtr->format = format;
+
+    switch ( format )
     {
-        case JSON_STRING:
+        case LE_SMS_FORMAT_TEXT:
+        case LE_SMS_FORMAT_BINARY:
         {
-            if ( decodePtr->type != DESC_STRING )
+            // Add phone number
+            le_result_t result = le_sms_GetSenderTel(msgRef, bodyPtr->senderTel,
+                                                     sizeof(bodyPtr->senderTel));
+
+            if (result != LE_OK)
             {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
+                LE_ERROR("Unable to get the tel number %d", result);
+                bodyPtr->senderTel[0] = '\0';
+            }
+            else
+            {
+                LE_DEBUG("Tel num: %s", bodyPtr->senderTel);
             }
 
-            if (res == LE_OK)
+            // Add timestamp
+            result = le_sms_GetTimeStamp(msgRef, bodyPtr->timestamp, sizeof(bodyPtr->timestamp));
+
+            if (result != LE_OK)
+            {
+                LE_ERROR("Unable to get the timestamp %d", result);
+                bodyPtr->timestamp[0] = '\0';
+            }
+            else
             {
-                const char* strPtr = json_string_value((const json_t *)jsonValPtr);
+                LE_DEBUG("Timestamp: %s", bodyPtr->timestamp);
+            }
 
-                if ( strlen(strPtr) >= decodePtr->uVal.str.lenStr )
-                {
-                    LE_ERROR("String too long");
-                    res = LE_OVERFLOW;
-                }
-                else
-                {
-                    strncpy(decodePtr->uVal.str.strPtr, strPtr, decodePtr->uVal.str.lenStr);
-                    decodePtr->uVal.str.lenStr = strlen(strPtr);
-                }
+            size_t len = le_sms_GetUserdataLen(msgRef);
+            bodyPtr->msgLen = len;
+
+            // Add a character for last '\0'
+            len++;
+            if (len > sizeof(bodyPtr->payload))
+            {
+                len = sizeof(bodyPtr->payload);
             }
-        }
-        break;
-        case JSON_INTEGER:
-        {
-            if ( decodePtr->type != DESC_INT )
+
+            if (format == LE_SMS_FORMAT_TEXT)
             {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
+                // Get text
+                result = le_sms_GetText(msgRef, (char*) bodyPtr->payload, len);
             }
             else
             {
-                decodePtr->uVal.val = json_integer_value((const json_t *)jsonValPtr);
+                // Get binary
+                result = le_sms_GetBinary(msgRef, bodyPtr->payload, &len);
             }
-        }
-        break;
-        case JSON_TRUE:
-        case JSON_FALSE:
-        {
-            if ( decodePtr->type != DESC_BOOL )
+
+            if (result != LE_OK)
             {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
+                LE_ERROR("Unable to get payload %d", result);
+                bodyPtr->msgLen = 0;
             }
             else
             {
-                decodePtr->uVal.boolVal = json_is_true((const json_t *)jsonValPtr);
+                // Payload is stored as is: no conversion is needed for extended-ASCII characters
+                bodyPtr->hasPayload = true;
+                bodyPtr->payloadLen = len;
             }
         }
         break;
-        case JSON_OBJECT:
-        {
-            // if key-value is an object, read the next key
-            if (nbKey >= 1)
-            {
-                json_t* jsonSubValPtr = json_object_get(jsonValPtr, keyPtr[0]);
 
-                if ( jsonSubValPtr )
-                {
-                    res = ReadJsonObj(jsonSubValPtr, &keyPtr[1], nbKey-1,  decodePtr );
-                }
-                else
-                {
-                    LE_ERROR("Bad format");
-                    res = LE_FAULT;
-                }
+        case LE_SMS_FORMAT_PDU:
+        {
+            size_t len = le_sms_GetPDULen(msgRef);
+            bodyPtr->msgLen = len;
+
+            // Add a character for last '\0'
+            len++;
+            if (len > sizeof(bodyPtr->payload))
+            {
+                len = sizeof(bodyPtr->payload);
+            }
+
+            // Add pdu
+            le_result_t result = le_sms_GetPDU(msgRef, bodyPtr->payload, &len);
+
+            if (result != LE_OK)
+            {
+                LE_ERROR("Unable to get pdu %d", result);
+                bodyPtr->msgLen = 0;
             }
             else
             {
-                LE_ERROR("Key error");
-                res = LE_FAULT;
+                bodyPtr->hasPayload = true;
+                bodyPtr->payloadLen = len;
+                LE_DEBUG("PDU format OK");
             }
         }
         break;
-        case JSON_ARRAY:
-        case JSON_REAL:
-        case JSON_NULL:
+        case LE_SMS_FORMAT_UNKNOWN:
         default:
-            LE_ERROR("Bad json_typeof");
-            res = LE_FAULT;
-        break;
+            LE_ERROR("Bad format %d", format);
     }
-
-    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read Application's config file
+ * Get an unused message identifier
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t GetMsgListFromMbox
+static MessageId_t AllocMessageId
 (
-    char* pathPtr,              ///<[IN] Application's config file path
-    json_t **jsonRootObjPtr,    ///<[OUT] json root object
-    json_t **jsonArrayPtr       ///<[OUT] messages in box list
+    void
 )
 {
-    json_error_t error;
-    *jsonRootObjPtr = json_load_file(pathPtr, 0, &error);
+    uint32_t inboxMask;
+    uint32_t unreadMask;
 
-    if ( !(*jsonRootObjPtr) )
+    // Skip 0 (no message) and identifiers still in use after a wrap-around
+    while ( (NextMessageId == 0) ||
+            (msgStore_GetFlags(NextMessageId, &inboxMask, &unreadMask) == LE_OK) )
     {
-        // File doesn't exist, create objects
-        *jsonRootObjPtr = json_object();
-
-        if ( !(*jsonRootObjPtr) )
-        {
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
-    }
-
-    *jsonArrayPtr = json_object_get(*jsonRootObjPtr, JSON_MSGINBOX);
-
-    if ( !(*jsonArrayPtr) )
-    {
-        // Array doesn't exist, create it
-        *jsonArrayPtr = json_array();
-
-        if (!(*jsonArrayPtr))
-        {
-            json_decref(*jsonRootObjPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
-
-        if ( json_object_set(*jsonRootObjPtr, JSON_MSGINBOX, *jsonArrayPtr) < 0 )
-        {
-            json_decref(*jsonRootObjPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
+        NextMessageId++;
     }
 
-    return LE_OK;
+    return NextMessageId++;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Remove a message from the application's cfg file
+ * Store a new message in the message box of all the applications
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t DeleteMsgInAppCfg
+static le_result_t StoreMsg
 (
-    char *appNamePtr,               ///<[IN] application name
-    MessageId_t deleteMessageId     ///<[IN] message to delete
+    le_sms_MsgRef_t msgRef, ///<[IN] SMS to be stored
+    MessageId_t *msgPtr     ///<[OUT] created messageId
 )
 {
-    uint32_t pathLen = GetSMSInboxConfigPathLen(appNamePtr);
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    GetSMSInboxConfigPath(appNamePtr, path, pathLen);
-    json_t *jsonObjPtr;
-    json_t *jsonArrayPtr;
-
-    LE_DEBUG("DeleteMessageId %d, path %s",deleteMessageId, path);
-
-    if (GetMsgListFromMbox(path, &jsonObjPtr, &jsonArrayPtr) != LE_OK)
-    {
-       LE_ERROR("No message");
-       return LE_FAULT;
-    }
-
-    int i;
+    MsgBody_t body;
     MessageId_t messageId;
+    uint32_t inboxMask = 0;
+    int i;
 
-    for (i=0; i < json_array_size(jsonArrayPtr); i++)
-    {
-        json_t * jsonIntegerPtr = json_array_get(jsonArrayPtr, i);
-
-        if (jsonIntegerPtr)
-        {
-            messageId = json_integer_value(jsonIntegerPtr);
+    EncodeMsgEntry(msgRef, &body);
 
-            if (messageId == deleteMessageId)
-            {
-                LE_DEBUG("Remove %d", (int) messageId);
-                json_array_remove(jsonArrayPtr, i);
-            }
-        }
-        else
+    // For all the applications
+    for (i = 0; i < MAX_APPS; i++)
+    {
+        if ( Apps[i].namePtr && strlen(Apps[i].namePtr) && (Apps[i].inboxSize > 0) )
         {
-            LE_ERROR("Json error");
+            inboxMask |= GetMboxBit(&Apps[i]);
         }
     }
 
-    le_result_t res = LE_OK;
-    if ( json_dump_file(jsonObjPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0 )
+    if (inboxMask == 0)
     {
-        res = LE_FAULT;
-        LE_ERROR("Json_dump_file error");
+        LE_ERROR("No mbox to store the message");
+        return LE_FAULT;
     }
 
-    json_decref(jsonObjPtr);
+    messageId = AllocMessageId();
 
-    return res;
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Check if a message belongs to a message box
- *
- */
-//--------------------------------------------------------------------------------------------------
-
-static le_result_t CheckMessageIdInMbox
-(
-    char* mboxName,
-    MessageId_t messageId
-)
-{
-    json_t *jsonRootObjPtr;
-    json_t *jsonArrayPtr;
-    uint32_t pathLen = GetSMSInboxConfigPathLen(mboxName);
-    char path[pathLen];
-    GetSMSInboxConfigPath(mboxName, path, pathLen);
-
-    if ( GetMsgListFromMbox(path, &jsonRootObjPtr, &jsonArrayPtr) != LE_OK )
+    // Unread by default for all applications
+    if (msgStore_Add(messageId, inboxMask, inboxMask, &body,
+                     offsetof(MsgBody_t, payload) + body.payloadLen) != LE_OK)
     {
-        LE_ERROR("Error in GetMsgListFromMbox");
+        LE_ERROR("Unable to store message %08x", (int) messageId);
         return LE_FAULT;
     }
 
-    int i = 0;
+    LE_DEBUG("New entry: %08x", (int) messageId);
 
-    while (i < json_array_size(jsonArrayPtr))
+    // Delete the oldest messages of the full mboxes
+    for (i = 0; i < MAX_APPS; i++)
     {
-        json_t * jsonIntegerPtr = json_array_get(jsonArrayPtr, i);
-        MessageId_t msgId = 0;
-
-        if (jsonIntegerPtr)
+        if (inboxMask & GetMboxBit(&Apps[i]))
         {
-            msgId = json_integer_value(jsonIntegerPtr);
-        }
-        else
-        {
-            LE_ERROR("Json error");
-            json_decref(jsonRootObjPtr);
-            return LE_FAULT;
-        }
+            while (msgStore_GetCount(i) > Apps[i].inboxSize)
+            {
+                uint32_t cursor = 0;
+                MessageId_t oldestId = msgStore_GetNext(i, &cursor);
 
-        LE_DEBUG("MessageId %d, msgId %d, i %d", messageId, msgId, i);
-        if (msgId == messageId)
-        {
-            json_decref(jsonRootObjPtr);
-            return LE_OK;
+                if (oldestId == 0)
+                {
+                    break;
+                }
+                RemoveMsgFromMbox(&Apps[i], oldestId);
+            }
         }
-
-        i++;
     }
 
-    LE_ERROR("Bad msg id or mbox name");
-    json_decref(jsonRootObjPtr);
-    return LE_FAULT;
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Decode message file
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t DecodeMsgEntry
-(
-    char* mboxName,                      ///<[IN] mbox name
-    MessageId_t messageId,               ///<[IN] Message identifier to decode
-    char* keyPtr[],                      ///<[IN] Key to retrieve
-    uint8_t nbKey,                       ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * decodePtr              ///<[IN/OUT] Decoding result
-)
-{
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    json_error_t error;
-    le_result_t res = LE_OK;
+    *msgPtr = messageId;
 
-    GetSMSInboxMessagePath(messageId, path, pathLen);
-
-    json_t* jsonRootPtr = json_load_file(path, JSON_REJECT_DUPLICATES, &error);
-
-    if ( jsonRootPtr == NULL )
-    {
-        LE_ERROR("Json decoder error %s mboxName %s", error.text, mboxName);
-        DeleteMsgInAppCfg(mboxName, messageId);
-        return LE_FAULT;
-    }
-
-    res = ReadJsonObj(jsonRootPtr, keyPtr, nbKey, decodePtr);
-
-    json_decref(jsonRootPtr);
-
-    return res;
+    return LE_OK;
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Check if an application requested the deletion of a message
+ * Create a directory
  *
  */
 //--------------------------------------------------------------------------------------------------
-static bool IsDeleted
+static le_result_t MkdirCreate
 (
-    MessageId_t messageId,  ///<[IN] Message identifier
-    char* appNamePtr        ///<[IN] Application name
+    const char* path    ///<[IN] path for directory creation
 )
 {
-    EntryDesc_t decode;
-    decode.type = DESC_BOOL;
-    char* key[2] = {JSON_ISDELETED, appNamePtr};
-
-    if (DecodeMsgEntry(appNamePtr, messageId, key, 2, &decode) == LE_OK)
-    {
-        LE_DEBUG("Decode.uVal.boolVal %d", decode.uVal.boolVal);
-        return decode.uVal.boolVal;
-    }
-    else
+    int status = mkdir(path, S_IRWXU|S_IRWXG);
+    if (0 != status)
     {
-        // if error, delete the message
-        return true;
+        if (EEXIST != errno)
+        {
+            LE_ERROR("Unable to create directory %s: %m", path);
+            return LE_FAULT;
+        }
     }
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform the deleteion
+ * Copy a string value of a key in a Json object of a previous version message file
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void PerformDeletion
+static void ReadLegacyString
 (
-    MessageId_t messageId   ///<[IN] Message identifier
+    json_t* jsonObjPtr,     ///<[IN] Json object
+    const char* keyPtr,     ///<[IN] Key
+    char* strPtr,           ///<[OUT] Buffer
+    size_t strSize          ///<[IN] Buffer size
 )
 {
-    int i;
-    bool deleted = true;
+    const char* valuePtr = json_string_value(json_object_get(jsonObjPtr, keyPtr));
 
-    for (i=0; i < MAX_APPS; i++)
+    if ( valuePtr && (le_utf8_Copy(strPtr, valuePtr, strSize, NULL) != LE_OK) )
     {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            deleted &= IsDeleted(messageId, Apps[i].namePtr);
-        }
-    }
-
-    // All applications mark this message to be delteted => erase physically the message
-    if (deleted)
-    {
-        uint16_t pathLen = GetSMSInboxMessagePathLen();
-        char path[pathLen];
-        memset(path, 0, pathLen);
-
-        GetSMSInboxMessagePath(messageId, path, pathLen);
-
-        LE_DEBUG("Delete messageId %d, path %s",messageId, path);
-        unlink(path);
+        LE_ERROR("%s too long", keyPtr);
+        strPtr[0] = '\0';
     }
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add a message in the application's cfg file
+ * Read a message file written by a previous version, in the Json format
  *
+ * @return
+ *  - LE_OK on success
+ *  - LE_NOT_FOUND if the message doesn't exist or is deleted for this application
+ *  - LE_FAULT if the message file is invalid
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t AddMsgInAppCfg
+static le_result_t ReadLegacyMsg
 (
-    MboxCtx_t* appsPtr,         ///<[IN] application config
-    MessageId_t messageId     ///<[IN] message to add
+    MessageId_t messageId,  ///<[IN] Message identifier
+    const char* appNamePtr, ///<[IN] Application name
+    MsgBody_t* bodyPtr,     ///<[OUT] Message body
+    bool* isUnreadPtr       ///<[OUT] Message unread by the application
 )
 {
-    uint32_t pathLen = GetSMSInboxConfigPathLen(appsPtr->namePtr);
+    const char* payloadKey[] = { JSON_TEXT, JSON_BIN, JSON_PDU };
+    uint32_t pathLen = GetSMSInboxMessagePathLen();
     char path[pathLen];
-    GetSMSInboxConfigPath(appsPtr->namePtr, path, pathLen);
-    json_t* jsonMsgIdPtr = NULL;
-    json_t* jsonPtr;
-    json_t* jsonArrayPtr;
-
-    if ( GetMsgListFromMbox (path, &jsonPtr, &jsonArrayPtr) != LE_OK )
-    {
-        LE_ERROR("Message %s not found", path);
-        return LE_FAULT;
-    }
-    LE_DEBUG("Add messageId %d, path %s, array Size %zu", messageId,
-                                                          path,
-                                                          json_array_size(jsonArrayPtr) );
-
-    if ( json_array_size(jsonArrayPtr) == appsPtr->inboxSize )
-    {
-        // delete older entry
-        jsonMsgIdPtr = json_array_get(jsonArrayPtr, 0);
-        MessageId_t messageId = 0;
-
-        if (jsonMsgIdPtr)
-        {
-            messageId = json_integer_value(jsonMsgIdPtr);
-        }
-
-        if (messageId != 0)
-        {
-            json_array_remove(jsonArrayPtr, 0);
-
-            EntryDesc_t modif;
-            modif.type = DESC_BOOL;
-            modif.uVal.boolVal = true;
-            char* key[2]={JSON_ISDELETED, appsPtr->namePtr};
-
-            if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-            {
-                LE_ERROR("Can't modify entry %08x, path %s", (int) messageId, path);
-            }
-
-            PerformDeletion(messageId);
-        }
-        else
-        {
-            json_decref(jsonPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
-    }
-
-    if (AddIntegerKeyInJsonObject(jsonArrayPtr, NULL, messageId) != LE_OK)
-    {
-        json_decref(jsonPtr);
-        LE_ERROR("Json error");
-        return LE_FAULT;
-    }
-
-    if ( json_dump_file(jsonPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0 )
-    {
-        json_decref(jsonPtr);
-        LE_ERROR("Json error");
-        return LE_FAULT;
-    }
+    json_error_t error;
+    json_t* jsonRootPtr;
+    json_t* jsonValPtr;
+    le_result_t res = LE_OK;
+    size_t i;
 
-    json_decref(jsonPtr);
+    GetSMSInboxMessagePath(messageId, path, pathLen);
 
-    // Use for the first initialization
-    if (jsonArrayPtr->refcount > 0)
+    if (access(path, F_OK) != 0)
     {
-        json_decref(jsonArrayPtr);
+        return LE_NOT_FOUND;
     }
 
-    return LE_OK;
-}
-
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Encode Json file
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t EncodeMsgEntry
-(
-    uint32_t fd,            ///<[IN] file descriptor
-    le_sms_MsgRef_t msgRef  ///<[IN] SMS to be encoding
-)
-{
-    json_t *jsonRootPtr = json_object();
-
+    jsonRootPtr = json_load_file(path, 0, &error);
     if (!jsonRootPtr)
     {
-        LE_ERROR("Json error");
+        LE_ERROR("Json decoder error %s, path %s", error.text, path);
         return LE_FAULT;
     }
 
-    // Add imsi in json file
-    AddStringKeyInJsonObject(jsonRootPtr, JSON_IMSI, SimImsi);
-
-    // Add sms format in json file
-    le_sms_Format_t format = le_sms_GetFormat(msgRef);
-    AddIntegerKeyInJsonObject(jsonRootPtr, JSON_FORMAT, (int) format);
-
-    // Unread by default for all applications
-    json_t *jsonUnreadPtr = json_object();
-    int i;
-    for (i=0; i < MAX_APPS; i++)
-    {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            AddBooleanKeyInJsonObject(jsonUnreadPtr, Apps[i].namePtr, true);
-        }
-    }
-
-    json_object_set_new(jsonRootPtr, JSON_ISUNREAD, jsonUnreadPtr);
-
-    // Undeleted by default for all applications
-    json_t *jsonDeletePtr = json_object();
-    for (i=0; i < MAX_APPS; i++)
-    {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            AddBooleanKeyInJsonObject(jsonDeletePtr, Apps[i].namePtr, false);
-        }
-    }
-
-    json_object_set_new(jsonRootPtr, JSON_ISDELETED, jsonDeletePtr);
-
-    switch ( format )
-    {
-        case LE_SMS_FORMAT_TEXT:
-        case LE_SMS_FORMAT_BINARY:
-        {
-            char tel[LE_MDMDEFS_PHONE_NUM_MAX_BYTES];
-            memset(tel, 0, LE_MDMDEFS_PHONE_NUM_MAX_BYTES);
-
-            // Add phone number
-            le_result_t result = le_sms_GetSenderTel(msgRef, tel, LE_MDMDEFS_PHONE_NUM_MAX_BYTES);
-
-            if (result != LE_OK)
-            {
-                LE_ERROR("Unable to get the tel number %d", result);
-            }
-            else
-            {
-                LE_DEBUG("Tel num: %s", tel);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_SENDERTEL, tel);
-            }
-
-            // Add timestamp
-            char timeStamp[LE_SMS_TIMESTAMP_MAX_BYTES];
-            result = le_sms_GetTimeStamp (msgRef, timeStamp, LE_SMS_TIMESTAMP_MAX_BYTES);
-
-            if (result != LE_OK)
-            {
-                LE_ERROR("Unable to get the timestamp %d", result);
-            }
-            else
-            {
-                LE_DEBUG("Timestamp: %s", timeStamp);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_TIMESTAMP, timeStamp);
-            }
-
-            size_t len = le_sms_GetUserdataLen(msgRef);
-            AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, len);
-
-            // Add a character for last '\0'
-            len++;
-
-            uint8_t bin[len];
-            memset(bin, 0, len);
-            int32_t strLen = 2*len + 1;
-            char string[strLen];
-            memset(string, 0, strLen);
-            const char* jsonKey;
-
-            if (format == LE_SMS_FORMAT_TEXT)
-            {
-                // Get text
-                result = le_sms_GetText(msgRef, (char*) bin, len);
-                jsonKey = JSON_TEXT;
-            }
-            else
-            {
-                // Get binary
-                result = le_sms_GetBinary(msgRef, bin, &len);
-                jsonKey = JSON_BIN;
-            }
-
-            if (result != LE_OK)
-            {
-                LE_ERROR("Unable to get payload %d", result);
-                AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, 0);
-            }
-            else
-            {
-                // Convert payload in string: json supports only utf-8 characters.
-                // Some extended-ASCII characters can be sent by SMS (such as character with accent)
-                // and can't be convert directly in utf-8. A convertion in string solves this issue.
-                strLen = le_hex_BinaryToString(bin, len, string, strLen);
-                AddStringKeyInJsonObject(jsonRootPtr, jsonKey, string);
-
-            }
-        }
-        break;
-
-        case LE_SMS_FORMAT_PDU:
-        {
-            size_t len = le_sms_GetPDULen(msgRef);
-            AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, len);
-            // Add a character for last '\0'
-            len++;
-            uint8_t pdu[len];
-            memset(pdu, 0, len);
-            int32_t strLen = 2*len + 1;
-            char string[strLen];
-            memset(string, 0, strLen);
-
-            // Add pdu
-            le_result_t result = le_sms_GetPDU(msgRef, pdu, &len);
-
-            if (result != LE_OK)
-            {
-                LE_ERROR("Unable to get pdu %d", result);
-                AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, 0);
-            }
-            else
-            {
-                // Convert pdu in string
-                strLen = le_hex_BinaryToString(pdu, len, string, strLen);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_PDU, string);
-                LE_DEBUG("PDU format OK");
-            }
-        }
-        break;
-        case LE_SMS_FORMAT_UNKNOWN:
-        default:
-            LE_ERROR("Bad format %d", format);
-    }
-
-    // Write json file in the file system
-    char* jsondumpStr = json_dumps( (const json_t *) jsonRootPtr,
-                                    JSON_INDENT(1) | JSON_PRESERVE_ORDER);
-    if (!jsondumpStr)
+    if (json_is_true(json_object_get(json_object_get(jsonRootPtr, JSON_ISDELETED), appNamePtr)))
     {
-        LE_ERROR("JsondumpStr is NULL");
-        return LE_FAULT;
+        json_decref(jsonRootPtr);
+        return LE_NOT_FOUND;
     }
 
-    char* restJsondumpStr = jsondumpStr;
-    ssize_t writeSize = strlen(jsondumpStr);
-    ssize_t writtenSize;
+    memset(bodyPtr, 0, offsetof(MsgBody_t, payload));
 
-    do
+    jsonValPtr = json_object_get(jsonRootPtr, JSON_FORMAT);
+    bodyPtr->format = json_is_integer(jsonValPtr) ? json_integer_value(jsonValPtr) :
+                                                    LE_SMS_FORMAT_UNKNOWN;
+    bodyPtr->msgLen = json_integer_value(json_object_get(jsonRootPtr, JSON_MSGLEN));
+
+    ReadLegacyString(jsonRootPtr, JSON_IMSI, bodyPtr->imsi, sizeof(bodyPtr->imsi));
+    ReadLegacyString(jsonRootPtr, JSON_SENDERTEL, bodyPtr->senderTel, sizeof(bodyPtr->senderTel));
+    ReadLegacyString(jsonRootPtr, JSON_TIMESTAMP, bodyPtr->timestamp, sizeof(bodyPtr->timestamp));
+
+    // Unread by default
+    *isUnreadPtr = !json_is_false(json_object_get(json_object_get(jsonRootPtr, JSON_ISUNREAD),
+                                                  appNamePtr));
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(payloadKey); i++)
     {
-        writtenSize = write( fd, restJsondumpStr, writeSize );
-        if (writtenSize > 0)
+        const char* hexPtr = json_string_value(json_object_get(jsonRootPtr, payloadKey[i]));
+
+        if (hexPtr)
         {
-            writeSize -= writtenSize;
-            restJsondumpStr += writtenSize;
+            int32_t len = le_hex_StringToBinary(hexPtr, strlen(hexPtr), bodyPtr->payload,
+                                                sizeof(bodyPtr->payload));
+            if (len < 0)
+            {
+                LE_ERROR("Bad %s in %s", payloadKey[i], path);
+                res = LE_FAULT;
+            }
+            else
+            {
+                bodyPtr->hasPayload = true;
+                bodyPtr->payloadLen = len;
+            }
+            break;
         }
     }
-    while ((writeSize > 0) && ((writtenSize >= 0) || (EINTR == errno)));
 
-    free(jsondumpStr);
     json_decref(jsonRootPtr);
 
-    return LE_OK;
+    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create a new message entry
+ * Remove the message files written by a previous version, once all the message boxes are imported
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t CreateMsgEntry
+static void RemoveLegacyMsgFiles
 (
-    MessageId_t *msgPtr,    ///<[OUT] create messageId
-    int32_t *fdPtr         ///<[OUT] Created file descriptor
+    void
 )
 {
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
+    char path[PATH_MAX];
+    struct dirent* entryPtr;
+    DIR* dirPtr;
+    int i;
 
-    GetSMSInboxMessagePath(NextMessageId, path, pathLen);
-    LE_DEBUG("Create entry: NextMessageId %d, path %s",NextMessageId, path);
+    for (i = 0; i < MAX_APPS; i++)
+    {
+        if (Apps[i].namePtr)
+        {
+            GetSMSInboxConfigPath(Apps[i].namePtr, path, sizeof(path));
 
-    *fdPtr = open( path, O_CREAT | O_RDWR | O_SYNC, S_IRUSR | S_IWUSR );
+            if (access(path, F_OK) == 0)
+            {
+                return;
+            }
+        }
+    }
 
-    if (*fdPtr < 0)
+    dirPtr = opendir(SMSINBOX_PATH MSG_PATH);
+    if (!dirPtr)
     {
-        LE_ERROR("No such file: %s: %m", path);
-        return LE_FAULT;
+        return;
     }
 
-    LE_DEBUG("New entry: %s", path);
-
-    int i;
-
-    // For all the applications
-    for (i = 0; i < MAX_APPS; i++)
+    while ((entryPtr = readdir(dirPtr)) != NULL)
     {
-        if ( Apps[i].namePtr && strlen(Apps[i].namePtr) )
+        if (entryPtr->d_name[0] != '.')
         {
-            AddMsgInAppCfg(&Apps[i], NextMessageId);
+            snprintf(path, sizeof(path), "%s%s%s", SMSINBOX_PATH, MSG_PATH, entryPtr->d_name);
+            unlink(path);
         }
     }
 
-    *msgPtr = NextMessageId;
+    closedir(dirPtr);
 
-    NextMessageId++;
-
-    return LE_OK;
+    LE_INFO("Message files of previous version removed");
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Convert the file name string in hexa
+ * Import the message box of an application written by a previous version, in the Json format.
+ * The configuration file of the message box is removed once imported.
  *
- * @return
- *      - Positive integer corresponding to the hexadecimal input string
- *      - -1 in case of error
  */
 //--------------------------------------------------------------------------------------------------
-static MessageId_t GetMessageId
+static void ImportLegacyMbox
 (
-    char* fileNamePtr  ///<[IN] file name to be converted
+    MboxCtx_t* mboxCtxPtr   ///<[IN] message box
 )
 {
-    char *savePtr;
+    uint32_t pathLen = GetSMSInboxConfigPathLen(mboxCtxPtr->namePtr);
+    char path[pathLen];
+    uint32_t mboxBit = GetMboxBit(mboxCtxPtr);
+    json_error_t error;
+    json_t* jsonRootPtr;
+    json_t* jsonArrayPtr;
+    int nbMsg = 0;
+    size_t i;
 
-    if(NULL != fileNamePtr)
-    {
-        char *str = strtok_r(fileNamePtr,".", &savePtr);
+    GetSMSInboxConfigPath(mboxCtxPtr->namePtr, path, pathLen);
 
-        if (NULL == str)
-        {
-            LE_ERROR("Unable to find . in the file name");
-            return -1;
-        }
-        return le_hex_HexaToInteger(str);
+    if (access(path, F_OK) != 0)
+    {
+        return;
     }
-    else
+
+    jsonRootPtr = json_load_file(path, 0, &error);
+    if (!jsonRootPtr)
     {
-        LE_ERROR("Provided file name pointer is NULL");
-        return -1;
+        LE_ERROR("Json decoder error %s, path %s", error.text, path);
     }
-}
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Create a directory
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t MkdirCreate
-(
-    const char* path    ///<[IN] path for directory creation
-)
-{
-    int status = mkdir(path, S_IRWXU|S_IRWXG);
-    if (0 != status)
+    jsonArrayPtr = json_object_get(jsonRootPtr, JSON_MSGINBOX);
+
+    for (i = 0; i < json_array_size(jsonArrayPtr); i++)
     {
-        if (EEXIST != errno)
+        MessageId_t messageId = json_integer_value(json_array_get(jsonArrayPtr, i));
+        uint32_t inboxMask;
+        uint32_t unreadMask;
+        MsgBody_t body;
+        bool isUnread;
+        le_result_t res;
+
+        if ( (messageId == 0) ||
+             (ReadLegacyMsg(messageId, mboxCtxPtr->namePtr, &body, &isUnread) != LE_OK) )
         {
-            LE_ERROR("Unable to create directory %s: %m", path);
-            return LE_FAULT;
+            continue;
+        }
+
+        if (msgStore_GetFlags(messageId, &inboxMask, &unreadMask) == LE_OK)
+        {
+            // Already imported in the message box of another application
+            res = msgStore_SetFlags(messageId, inboxMask | mboxBit,
+                                    isUnread ? (unreadMask | mboxBit) : unreadMask);
+        }
+        else
+        {
+            res = msgStore_Add(messageId, mboxBit, isUnread ? mboxBit : 0, &body,
+                               offsetof(MsgBody_t, payload) + body.payloadLen);
+        }
+
+        if (res != LE_OK)
+        {
+            LE_ERROR("Unable to import message %08x", (int) messageId);
+            continue;
         }
+
+        if (messageId >= NextMessageId)
+        {
+            NextMessageId = messageId + 1;
+        }
+        nbMsg++;
     }
-    return LE_OK;
+
+    json_decref(jsonRootPtr);
+
+    LE_INFO("%d messages imported in %s", nbMsg, mboxCtxPtr->namePtr);
+
+    unlink(path);
+    RemoveLegacyMsgFiles();
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Init the SMSInBox directory
+ * Init the SMSInBox directory and open the message store
  *
  */
 //--------------------------------------------------------------------------------------------------
@@ -1475,63 +1090,35 @@ static void InitSmsInBoxDirectory
     void
 )
 {
-    struct dirent **namelist;
-    uint32_t nbSmsEntries;
+    int i;
 
     LE_DEBUG("InitSmsInBoxDirectory");
 
-    // create directories
+    // create directory
     if (LE_OK != MkdirCreate(SMSINBOX_PATH))
     {
         return;
     }
 
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, CONF_PATH);
-
-    if (LE_OK != MkdirCreate(path))
+    // Message box i is bit i of the message store flags
+    if (LE_OK != msgStore_Open(SMSINBOX_PATH, le_smsInbox_mboxName, le_smsInbox_NbMbx))
     {
+        LE_ERROR("Unable to open the message store");
         return;
     }
 
-    memset(path, 0, pathLen);
-    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, MSG_PATH);
-
-    if (LE_OK != MkdirCreate(path))
-    {
-        return;
-    }
+    NextMessageId = msgStore_GetLatestId() + 1;
 
-    nbSmsEntries = scandir(path, &namelist, NULL, alphasort);
-    if ( nbSmsEntries > 2 )
+    // Import the message boxes of a previous version
+    for (i = 0; i < MAX_APPS; i++)
     {
-        uint8_t len = strlen(namelist[nbSmsEntries-1]->d_name);
-        char name[len+1];
-        MessageId_t id;
-
-        memset(name, 0, len+1);
-        strncpy(name, namelist[nbSmsEntries-1]->d_name, len);
-
-        id = GetMessageId(name);
-        if (-1 == id)
+        if (Apps[i].namePtr)
         {
-            LE_ERROR("Unable to get the id of %s", name);
-            return;
+            ImportLegacyMbox(&Apps[i]);
         }
-
-        NextMessageId = ++id;
-
-        LE_DEBUG("NextMessageId %d", (int) NextMessageId);
     }
 
-    while (nbSmsEntries--)
-    {
-        free(namelist[nbSmsEntries]);
-    }
-
-    free(namelist);
+    LE_DEBUG("NextMessageId %d", (int) NextMessageId);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1545,7 +1132,6 @@ static void MoveSmsFromSimToFolder
     void
 )
 {
-    int32_t fd;
     le_result_t result = LE_OK;
 
     le_sms_MsgListRef_t msgListRef = le_sms_CreateRxMsgList();
@@ -1562,18 +1148,7 @@ static void MoveSmsFromSimToFolder
     {
         MessageId_t msgId;
 
-        result = CreateMsgEntry(&msgId, &fd);
-
-        if (result == LE_OK)
-        {
-            if ( EncodeMsgEntry(fd, smsRef) != LE_OK )
-            {
-                LE_ERROR("Encoding issue");
-            }
-
-            close(fd);
-        }
-        else
+        if (StoreMsg(smsRef, &msgId) != LE_OK)
         {
             LE_ERROR("Error during new entry creation");
         }
@@ -1602,23 +1177,12 @@ static void NewSmsMsgHandler
     void*           contextPtr
 )
 {
-    int32_t fd;
     le_result_t result;
     MessageId_t msgId;
 
     LE_DEBUG("Receive new message");
 
-    result = CreateMsgEntry(&msgId, &fd);
-
-    if (result == LE_OK)
-    {
-        result = EncodeMsgEntry(fd, msgRef);
-        close(fd);
-    }
-    else
-    {
-        LE_ERROR("CreateMsgEntry error");
-    }
+    result = StoreMsg(msgRef, &msgId);
 
     if (result == LE_OK)
     {
@@ -1630,7 +1194,7 @@ static void NewSmsMsgHandler
     }
     else
     {
-        LE_ERROR("EncodeMsgEntry error");
+        LE_ERROR("StoreMsg error");
     }
 }
 
@@ -1874,6 +1438,10 @@ SmsInbox_SessionRef_t SmsInbox_Open
     {
         if (Apps[i].namePtr && (strcmp(Apps[i].namePtr, mboxName) == 0))
         {
+            // Message boxes of a previous version are imported at startup, unless their files
+            // are restored afterwards
+            ImportLegacyMbox(&Apps[i]);
+
             ClientRequest_t* clientRequestPtr = le_mem_ForceAlloc(SmsInboxHandlerPoolRef);
             clientRequestPtr->mboxSessionPtr = (MboxSession_t*) le_mem_ForceAlloc(MboxSessionPool);
 
@@ -2040,30 +1608,13 @@ void SmsInbox_DeleteMsg
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = true;
-    char* key[2]={JSON_ISDELETED, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
-
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-    {
-        LE_ERROR("ModifyMsgEntry error");
-    }
-
-    if (DeleteMsgInAppCfg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId)
-                          != LE_OK)
-    {
-        LE_ERROR("DeleteMsgInAppCfg error");
-    }
-
-    PerformDeletion(messageId);
+    RemoveMsgFromMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, (MessageId_t) msgId);
 }
 
 
@@ -2111,13 +1662,15 @@ le_result_t SmsInbox_GetImsi
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
+    MboxCtx_t* mboxCtxPtr = clientRequestPtr->mboxSessionPtr->mboxCtxPtr;
+    MsgBody_t body;
     le_result_t res;
 
     memset(imsiPtr, 0, imsiNumElements);
@@ -2127,14 +1680,12 @@ le_result_t SmsInbox_GetImsi
         return LE_OVERFLOW;
     }
 
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = imsiPtr;
-    decode.uVal.str.lenStr = imsiNumElements;
-    char* key[1] = {JSON_IMSI};
+    if ((res = ReadMsg(mboxCtxPtr, messageId, &body)) == LE_OK)
+    {
+        res = CopyMsgString(body.imsi, imsiPtr, imsiNumElements);
+    }
 
-    if ((res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr,
-                              messageId, key, 1, &decode)) == LE_OK)
+    if (res == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
     }
@@ -2178,22 +1729,19 @@ le_sms_Format_t SmsInbox_GetFormat
         return 0;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return 0;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_INT;
-    char* key[1] = {JSON_FORMAT};
+    MsgBody_t body;
 
-    if (DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                      &decode) == LE_OK)
+    if (ReadMsg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId, &body) == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
-        return decode.uVal.val;
+        return body.format;
     }
     else
     {
@@ -2243,23 +1791,33 @@ le_result_t SmsInbox_GetSenderTel
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
+    MboxCtx_t* mboxCtxPtr = clientRequestPtr->mboxSessionPtr->mboxCtxPtr;
+    MsgBody_t body;
     le_result_t res;
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = telPtr;
-    decode.uVal.str.lenStr = telNumElements;
+
     memset(telPtr, 0, telNumElements);
-    char* key[1] = {JSON_SENDERTEL};
 
-    if ((res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key,
-                              1, &decode)) == LE_OK)
+    if ((res = ReadMsg(mboxCtxPtr, messageId, &body)) == LE_OK)
+    {
+        if (body.senderTel[0] == '\0')
+        {
+            LE_ERROR("No sender in message %08x", (int) messageId);
+            res = LE_FAULT;
+        }
+        else
+        {
+            res = CopyMsgString(body.senderTel, telPtr, telNumElements);
+        }
+    }
+
+    if (res == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
     }
@@ -2313,23 +1871,33 @@ le_result_t SmsInbox_GetTimeStamp
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = timestampPtr;
-    decode.uVal.str.lenStr = timestampNumElements;
-    memset(timestampPtr, 0, timestampNumElements);
-    char* key[1] = {JSON_TIMESTAMP};
+    MboxCtx_t* mboxCtxPtr = clientRequestPtr->mboxSessionPtr->mboxCtxPtr;
+    MsgBody_t body;
     le_result_t res;
 
-    if ( (res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId,
-                               key, 1, &decode)) == LE_OK )
+    memset(timestampPtr, 0, timestampNumElements);
+
+    if ((res = ReadMsg(mboxCtxPtr, messageId, &body)) == LE_OK)
+    {
+        if (body.timestamp[0] == '\0')
+        {
+            LE_ERROR("No timestamp in message %08x", (int) messageId);
+            res = LE_FAULT;
+        }
+        else
+        {
+            res = CopyMsgString(body.timestamp, timestampPtr, timestampNumElements);
+        }
+    }
+
+    if (res == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
     }
@@ -2370,28 +1938,20 @@ size_t SmsInbox_GetMsgLen
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
+    MsgBody_t body;
 
-    EntryDesc_t decode;
-    decode.type = DESC_INT;
-    char* key[1] = {JSON_MSGLEN};
-    le_result_t res;
-
-    if ( (res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr,
-                                messageId,
-                                key,
-                                1,
-                                &decode)) == LE_OK )
+    if (ReadMsg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId, &body) == LE_OK)
     {
         SmsInbox_MarkRead(sessionRef, msgId);
 
-        return decode.uVal.val;
+        return body.msgLen;
     }
     else
     {
@@ -2442,42 +2002,41 @@ le_result_t SmsInbox_GetText
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
+    MsgBody_t body;
     le_result_t res;
-    size_t len = 2*textNumElements+1;
-    char tmpTextPtr[len];
-    memset(tmpTextPtr, 0, len);
-    memset(textPtr, 0, textNumElements);
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpTextPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_TEXT};
+    memset(textPtr, 0, textNumElements);
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                         &decode);
+    res = ReadMsg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId, &body);
+    if (res != LE_OK)
+    {
+        return res;
+    }
 
-    if ( res == LE_OK )
+    if ((body.format != LE_SMS_FORMAT_TEXT) || !body.hasPayload)
     {
-        if ( le_hex_StringToBinary(tmpTextPtr,
-                                   decode.uVal.str.lenStr,
-                                   (uint8_t*) textPtr,
-                                   textNumElements ) < 0 )
-        {
-            return LE_FAULT;
-        }
+        LE_ERROR("No text in message %08x", (int) messageId);
+        return LE_FAULT;
+    }
 
-        SmsInbox_MarkRead(sessionRef, msgId);
+    if (body.payloadLen > textNumElements)
+    {
+        LE_ERROR("Text too long: %d bytes", body.payloadLen);
+        return LE_OVERFLOW;
     }
 
-    return res;
+    memcpy(textPtr, body.payload, body.payloadLen);
+
+    SmsInbox_MarkRead(sessionRef, msgId);
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2529,46 +2088,42 @@ le_result_t SmsInbox_GetBinary
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
+    MsgBody_t body;
     le_result_t res;
-    EntryDesc_t decode;
-    size_t len = 2*(*binNumElementsPtr)+1;
-    char tmpBinPtr[len];
-    memset(tmpBinPtr, 0, len);
-    memset(binPtr, 0, *binNumElementsPtr);
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpBinPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_BIN};
+    memset(binPtr, 0, *binNumElementsPtr);
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId,
-                         key, 1, &decode);
+    res = ReadMsg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId, &body);
+    if (res != LE_OK)
+    {
+        return res;
+    }
 
-    if ( res == LE_OK )
+    if ((body.format != LE_SMS_FORMAT_BINARY) || !body.hasPayload)
     {
-        int32_t binNumElements = le_hex_StringToBinary(tmpBinPtr,
-                                                    decode.uVal.str.lenStr,
-                                                    binPtr,
-                                                    *binNumElementsPtr);
+        LE_ERROR("No binary data in message %08x", (int) messageId);
+        return LE_FAULT;
+    }
 
-        if ( binNumElements < 0 )
-        {
-            return LE_FAULT;
-        }
+    if (body.payloadLen > *binNumElementsPtr)
+    {
+        LE_ERROR("Binary data too long: %d bytes", body.payloadLen);
+        return LE_OVERFLOW;
+    }
 
-        *binNumElementsPtr = binNumElements;
+    memcpy(binPtr, body.payload, body.payloadLen);
+    *binNumElementsPtr = body.payloadLen;
 
-        SmsInbox_MarkRead(sessionRef, msgId);
-    }
+    SmsInbox_MarkRead(sessionRef, msgId);
 
-    return res;
+    return LE_OK;
 }
 
 
@@ -2624,46 +2179,42 @@ le_result_t SmsInbox_GetPdu
         return 0;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return 0;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
+    MsgBody_t body;
     le_result_t res;
-    EntryDesc_t decode;
-    size_t len = 2*(*pduNumElementsPtr)+1;
-    char tmpPduPtr[len];
-    memset(tmpPduPtr, 0, len);
-    memset(pduPtr, 0, *pduNumElementsPtr);
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpPduPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_PDU};
+    memset(pduPtr, 0, *pduNumElementsPtr);
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                         &decode);
+    res = ReadMsg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId, &body);
+    if (res != LE_OK)
+    {
+        return res;
+    }
 
-    if ( res == LE_OK )
+    if ((body.format != LE_SMS_FORMAT_PDU) || !body.hasPayload)
     {
-        int32_t pduNumElements = le_hex_StringToBinary(tmpPduPtr,
-                                                    decode.uVal.str.lenStr,
-                                                    pduPtr,
-                                                    *pduNumElementsPtr);
+        LE_ERROR("No PDU in message %08x", (int) messageId);
+        return LE_FAULT;
+    }
 
-        if ( pduNumElements < 0 )
-        {
-            return LE_FAULT;
-        }
+    if (body.payloadLen > *pduNumElementsPtr)
+    {
+        LE_ERROR("PDU too long: %d bytes", body.payloadLen);
+        return LE_OVERFLOW;
+    }
 
-        *pduNumElementsPtr = pduNumElements;
+    memcpy(pduPtr, body.payload, body.payloadLen);
+    *pduNumElementsPtr = body.payloadLen;
 
-        SmsInbox_MarkRead(sessionRef, msgId);
-    }
+    SmsInbox_MarkRead(sessionRef, msgId);
 
-    return res;
+    return LE_OK;
 }
 
 
@@ -2698,75 +2249,21 @@ uint32_t SmsInbox_GetFirst
         return 0;
     }
 
-    uint32_t pathLen = GetSMSInboxConfigPathLen(clientRequestPtr->
-                                                mboxSessionPtr->mboxCtxPtr->namePtr);
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    GetSMSInboxConfigPath(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, path, pathLen);
-    le_result_t res = LE_OK;
-    MessageId_t messageId=0;
-
-    if ( GetMsgListFromMbox(path,
-                        &clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr,
-                        &clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr) != LE_OK )
-    {
-        LE_ERROR("Error in GetMsgListFromMbox");
-        return 0;
-    }
+    MboxSession_t* mboxSessionPtr = clientRequestPtr->mboxSessionPtr;
 
-    clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex =
-                      json_array_size(clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr);
+    mboxSessionPtr->browseCtx.cursor = 0;
 
-    LE_DEBUG("MaxIndex %d", clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex);
-
-    if ( clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex > 0 )
-    {
-        json_t * jsonIntegerPtr =
-                 json_array_get(clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr, 0);
+    MessageId_t messageId = msgStore_GetNext(GetMboxIdx(mboxSessionPtr->mboxCtxPtr),
+                                             &mboxSessionPtr->browseCtx.cursor);
 
-        if (jsonIntegerPtr)
-        {
-            messageId = json_integer_value(jsonIntegerPtr);
-        }
-        else
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
+    mboxSessionPtr->browseCtx.isBrowsing = (messageId != 0);
 
-        if (messageId)
-        {
-            clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex = 1;
-        }
-        else
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
-    }
-    else
+    if (!messageId)
     {
-        res = LE_FAULT;
         LE_DEBUG("Empty mbox");
     }
 
-    if (res == LE_FAULT)
-    {
-        if (clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr)
-        {
-            json_decref(clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr);
-        }
-
-        memset(&clientRequestPtr->mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
-
-        return 0;
-    }
-    else
-    {
-        return messageId;
-    }
-
-    return 0;
+    return messageId;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2794,60 +2291,24 @@ uint32_t SmsInbox_GetNext
         return LE_BAD_PARAMETER;
     }
 
-    while(clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex !=
-          clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex)
-    {
-        LE_DEBUG("CurrentIndex %d, maxIndex %d", clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.currentMessageIndex,
-                                                 clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.maxIndex);
-
-        json_t * jsonIntegerPtr = json_array_get(clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.jsonArrayPtr,
-                                                 clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.currentMessageIndex);
-
-        if (jsonIntegerPtr)
-        {
-            MessageId_t messageId = json_integer_value(jsonIntegerPtr);
-
-            if (messageId > 0)
-            {
-                clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex++;
-
-                // Check if the message exist (it may be deleted since the GetFirst call)
-                uint16_t pathLen = GetSMSInboxMessagePathLen();
-                char path[pathLen];
-                memset(path, 0, pathLen);
-                GetSMSInboxMessagePath(messageId, path, pathLen);
-                int32_t fd = open(path, O_RDWR);
+    MboxSession_t* mboxSessionPtr = clientRequestPtr->mboxSessionPtr;
+    MessageId_t messageId = 0;
 
-                if (fd >= 0)
-                {
-                    // message is still existing
-                    close(fd);
-                    return messageId;
-                }
-
-                // else continue the parsing
-            }
-            else
-            {
-                LE_ERROR("Json error");
-            }
-        }
-        else
-        {
-            LE_ERROR("Json error");
-        }
+    // Messages deleted since the GetFirst call are skipped by the message store
+    if (mboxSessionPtr->browseCtx.isBrowsing)
+    {
+        messageId = msgStore_GetNext(GetMboxIdx(mboxSessionPtr->mboxCtxPtr),
+                                     &mboxSessionPtr->browseCtx.cursor);
     }
 
-    // Parsing end => free the memory
-    LE_DEBUG("No more messages");
-    json_decref(clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr);
-    memset(&clientRequestPtr->mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
+    if (!messageId)
+    {
+        // Parsing end
+        LE_DEBUG("No more messages");
+        memset(&mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
+    }
 
-    return 0;
+    return messageId;
 }
 //--------------------------------------------------------------------------------------------------
 /**
@@ -2886,27 +2347,15 @@ bool SmsInbox_IsUnread
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_BOOL;
-    char* key[] = {JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
 
-    if (DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 2,
-                       &decode) == LE_OK)
-    {
-        return decode.uVal.boolVal;
-    }
-    else
-    {
-        LE_ERROR("Error in DecodeMsgEntry");
-        return false;
-    }
+    return IsUnread(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2941,22 +2390,15 @@ void SmsInbox_MarkRead
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = false;
-    char* key[2]={JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
 
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-    {
-        LE_ERROR("Error in ModifyMsgEntry");
-    }
+    SetUnread(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId, false);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2991,22 +2433,15 @@ void SmsInbox_MarkUnread
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (!IsMsgInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId))
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
     MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = true;
-    char* key[2]={JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
 
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-    {
-        LE_ERROR("Error in ModifyMsgEntry");
-    }
+    SetUnread(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, messageId, true);
 }
 
 //--------------------------------------------------------------------------------------------------
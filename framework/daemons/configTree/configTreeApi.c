@@ -235,6 +235,60 @@ static tdb_TreeRef_t QuickGetTree
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check the items of a batch request before any of them are applied, so that a bad item doesn't
+ *  leave the batch half done.  If an item is bad, the client is terminated.
+ *
+ *  @return True if all of the items can be processed, false if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static bool CheckBatchItems
+(
+    const le_cfg_BatchItem_t* itemsPtr,  ///< [IN] The items to check.
+    size_t itemCount,                    ///< [IN] How many items there are.
+    bool isWrite                         ///< [IN] Are the items going to be written?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    for (size_t i = 0; i < itemCount; i++)
+    {
+        if (CheckPathForSpecifier(itemsPtr[i].path))
+        {
+            return false;
+        }
+
+        if (isWrite)
+        {
+            switch (itemsPtr[i].type)
+            {
+                case LE_CFG_TYPE_EMPTY:
+                case LE_CFG_TYPE_STRING:
+                case LE_CFG_TYPE_BOOL:
+                case LE_CFG_TYPE_INT:
+                case LE_CFG_TYPE_FLOAT:
+                case LE_CFG_TYPE_DOESNT_EXIST:
+                    break;
+
+                case LE_CFG_TYPE_STEM:
+                    tu_TerminateConfigClient(le_cfg_GetClientSessionRef(),
+                                             "A stem node can not be written as a batch item.");
+                    return false;
+
+                default:
+                    tu_TerminateConfigClient(le_cfg_GetClientSessionRef(),
+                                             "Unknown node type in a batch item.");
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Create a read transaction and open a new iterator for traversing the configuration tree.
@@ -1372,6 +1426,94 @@ void le_cfg_SetBool
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a batch of values from the configuration tree, relative to the iterator's current node.
+ *  Each item is read as the matching single value get function would read it, and the item's type
+ *  is replaced with the type of the node that was found.
+ *
+ *  Valid for both read and write transactions.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_GetBatch
+(
+    le_cfg_ServerCmdRef_t commandRef,    ///< [IN] Reference used to generate a reply for this
+                                         ///<      request.
+    le_cfg_IteratorRef_t externalRef,    ///< [IN] Iterator to use as a basis for the transaction.
+    const le_cfg_BatchItem_t* itemsPtr,  ///< [IN] Items to read, holding their default values.
+    size_t itemsSize,                    ///< [IN] Number of items to read.
+    size_t valuesSize                    ///< [IN] Number of items the client can receive.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Reading a batch of %" PRIuS " values relative to the iterator <%p>.",
+             itemsSize,
+             externalRef);
+
+    ni_IteratorRef_t iteratorRef = GetIteratorFromRef(externalRef);
+    le_cfg_BatchItem_t values[LE_CFG_BATCH_MAX];
+    size_t valueCount = 0;
+
+    if (   (NULL != iteratorRef)
+        && (CheckBatchItems(itemsPtr, itemsSize, false)))
+    {
+        valueCount = MIN(MIN(itemsSize, valuesSize), LE_CFG_BATCH_MAX);
+
+        for (size_t i = 0; i < valueCount; i++)
+        {
+            values[i] = itemsPtr[i];
+            ni_GetBatchItem(iteratorRef, &values[i]);
+        }
+    }
+
+    le_cfg_GetBatchRespond(commandRef, values, valueCount);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a batch of values to the configuration tree, relative to the iterator's current node.
+ *  Only valid during a write transaction.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_SetBatch
+(
+    le_cfg_ServerCmdRef_t commandRef,    ///< [IN] Reference used to generate a reply for this
+                                         ///<      request.
+    le_cfg_IteratorRef_t externalRef,    ///< [IN] Iterator to use as a basis for the transaction.
+    const le_cfg_BatchItem_t* itemsPtr,  ///< [IN] Items to write.
+    size_t itemsSize                     ///< [IN] Number of items to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Writing a batch of %" PRIuS " values relative to the iterator <%p>.",
+             itemsSize,
+             externalRef);
+
+    ni_IteratorRef_t iteratorRef = GetWriteIteratorFromRef(externalRef);
+
+    if (   (NULL != iteratorRef)
+        && (CheckBatchItems(itemsPtr, itemsSize, true)))
+    {
+        for (size_t i = 0; i < itemsSize; i++)
+        {
+            if (ni_SetBatchItem(iteratorRef, &itemsPtr[i]) != LE_OK)
+            {
+                tu_TerminateConfigClient(le_cfg_GetClientSessionRef(),
+                                         "A batch item could not be written.");
+                return;
+            }
+        }
+    }
+
+    le_cfg_SetBatchRespond(commandRef);
+}
+
+
+
+
 
 
 // -------------------------------------------------------------------------------------------------
@@ -1817,3 +1959,78 @@ void le_cfg_QuickSetBool
                               value);
     }
 }
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a batch of values from the configuration tree.  All of the items are read in one implicit
+ *  read transaction, relative to the base path.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_QuickGetBatch
+(
+    le_cfg_ServerCmdRef_t commandRef,    ///< [IN] Reference used to generate a reply for this
+                                         ///<      request.
+    const char* basePath,                ///< [IN] Path the item paths are relative to.
+    const le_cfg_BatchItem_t* itemsPtr,  ///< [IN] Items to read, holding their default values.
+    size_t itemsSize,                    ///< [IN] Number of items to read.
+    size_t valuesSize                    ///< [IN] Number of items the client can receive.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Quick get batch of %" PRIuS " values at \"%s\".", itemsSize, basePath);
+
+    tu_UserRef_t userRef = tu_GetCurrentConfigUserInfo();
+    tdb_TreeRef_t treeRef = QuickGetTree(userRef, TU_TREE_READ, basePath);
+
+    if (   (treeRef != NULL)
+        && (CheckBatchItems(itemsPtr, itemsSize, false)))
+    {
+        rq_HandleQuickGetBatch(le_cfg_GetClientSessionRef(),
+                               commandRef,
+                               userRef,
+                               treeRef,
+                               tp_GetPathOnly(basePath),
+                               itemsPtr,
+                               MIN(MIN(itemsSize, valuesSize), LE_CFG_BATCH_MAX));
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a batch of values to the configuration tree.  All of the items are written in one
+ *  implicit write transaction, relative to the base path, and committed together.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_QuickSetBatch
+(
+    le_cfg_ServerCmdRef_t commandRef,    ///< [IN] Reference used to generate a reply for this
+                                         ///<      request.
+    const char* basePath,                ///< [IN] Path the item paths are relative to.
+    const le_cfg_BatchItem_t* itemsPtr,  ///< [IN] Items to write.
+    size_t itemsSize                     ///< [IN] Number of items to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Quick set batch of %" PRIuS " values at \"%s\".", itemsSize, basePath);
+
+    tu_UserRef_t userRef = tu_GetCurrentConfigUserInfo();
+    tdb_TreeRef_t treeRef = QuickGetTree(userRef, TU_TREE_WRITE, basePath);
+
+    if (   (treeRef != NULL)
+        && (CheckBatchItems(itemsPtr, itemsSize, true)))
+    {
+        rq_HandleQuickSetBatch(le_cfg_GetClientSessionRef(),
+                               commandRef,
+                               userRef,
+                               treeRef,
+                               tp_GetPathOnly(basePath),
+                               itemsPtr,
+                               MIN(itemsSize, LE_CFG_BATCH_MAX));
+    }
+}
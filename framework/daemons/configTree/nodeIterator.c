@@ -1305,3 +1305,115 @@ void ni_SetNodeValueBool
         tdb_SetValueAsBool(nodeRef, value);
     }
 }
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Read one item of a batch.  The value field selected by the item's type is read from the tree,
+ *  with the item's current value used as the default.  The item's type is then replaced with the
+ *  type of the node that was found, so that the caller can tell if the default was used.
+ */
+//--------------------------------------------------------------------------------------------------
+void ni_GetBatchItem
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN]     The iterator object to access.
+    le_cfg_BatchItem_t* itemPtr    ///< [IN/OUT] The item to read, holding the default value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* pathPtr = itemPtr->path;
+
+    switch (itemPtr->type)
+    {
+        case LE_CFG_TYPE_STRING:
+        {
+            char defaultValue[LE_CFG_STR_LEN_BYTES];
+
+            LE_ASSERT(le_utf8_Copy(defaultValue,
+                                   itemPtr->stringValue,
+                                   sizeof(defaultValue),
+                                   NULL) == LE_OK);
+
+            // Both buffers are LE_CFG_STR_LEN_BYTES long, so the value always fits.
+            ni_GetNodeValueString(iteratorRef,
+                                  pathPtr,
+                                  itemPtr->stringValue,
+                                  sizeof(itemPtr->stringValue),
+                                  defaultValue);
+            break;
+        }
+
+        case LE_CFG_TYPE_BOOL:
+            itemPtr->boolValue = ni_GetNodeValueBool(iteratorRef, pathPtr, itemPtr->boolValue);
+            break;
+
+        case LE_CFG_TYPE_INT:
+            itemPtr->intValue = ni_GetNodeValueInt(iteratorRef, pathPtr, itemPtr->intValue);
+            break;
+
+        case LE_CFG_TYPE_FLOAT:
+            itemPtr->floatValue = ni_GetNodeValueFloat(iteratorRef, pathPtr, itemPtr->floatValue);
+            break;
+
+        default:
+            // Only the node type was requested.
+            break;
+    }
+
+    itemPtr->type = ni_GetNodeType(iteratorRef, pathPtr);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Write one item of a batch.  LE_CFG_TYPE_EMPTY clears the node and LE_CFG_TYPE_DOESNT_EXIST
+ *  deletes it.
+ *
+ *  @return LE_OK if the item was applied, LE_BAD_PARAMETER if the item's type can not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t ni_SetBatchItem
+(
+    ni_IteratorRef_t iteratorRef,      ///< [IN] The iterator object to access.
+    const le_cfg_BatchItem_t* itemPtr  ///< [IN] The item to write.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* pathPtr = itemPtr->path;
+
+    switch (itemPtr->type)
+    {
+        case LE_CFG_TYPE_EMPTY:
+            ni_SetEmpty(iteratorRef, pathPtr);
+            break;
+
+        case LE_CFG_TYPE_STRING:
+            ni_SetNodeValueString(iteratorRef, pathPtr, itemPtr->stringValue);
+            break;
+
+        case LE_CFG_TYPE_BOOL:
+            ni_SetNodeValueBool(iteratorRef, pathPtr, itemPtr->boolValue);
+            break;
+
+        case LE_CFG_TYPE_INT:
+            ni_SetNodeValueInt(iteratorRef, pathPtr, itemPtr->intValue);
+            break;
+
+        case LE_CFG_TYPE_FLOAT:
+            ni_SetNodeValueFloat(iteratorRef, pathPtr, itemPtr->floatValue);
+            break;
+
+        case LE_CFG_TYPE_DOESNT_EXIST:
+            ni_DeleteNode(iteratorRef, pathPtr);
+            break;
+
+        default:
+            return LE_BAD_PARAMETER;
+    }
+
+    return LE_OK;
+}
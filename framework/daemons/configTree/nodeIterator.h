@@ -612,4 +612,37 @@ void ni_SetNodeValueBool
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Read one item of a batch.  The value field selected by the item's type is read from the tree,
+ *  with the item's current value used as the default.  The item's type is then replaced with the
+ *  type of the node that was found.
+ */
+//--------------------------------------------------------------------------------------------------
+void ni_GetBatchItem
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN]     The iterator object to access.
+    le_cfg_BatchItem_t* itemPtr    ///< [IN/OUT] The item to read, holding the default value.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Write one item of a batch.  LE_CFG_TYPE_EMPTY clears the node and LE_CFG_TYPE_DOESNT_EXIST
+ *  deletes it.
+ *
+ *  @return LE_OK if the item was applied, LE_BAD_PARAMETER if the item's type can not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t ni_SetBatchItem
+(
+    ni_IteratorRef_t iteratorRef,      ///< [IN] The iterator object to access.
+    const le_cfg_BatchItem_t* itemPtr  ///< [IN] The item to write.
+);
+
+
+
+
 #endif
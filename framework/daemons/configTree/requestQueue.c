@@ -74,6 +74,14 @@ typedef struct UpdateRequest
             value;
         }
         writeReq;
+
+        struct
+        {
+            char pathPtr[LE_CFG_STR_LEN_BYTES];            ///< Path the item paths are relative to.
+            size_t itemCount;                              ///< Number of items in the batch.
+            le_cfg_BatchItem_t items[LE_CFG_BATCH_MAX];    ///< The values to write.
+        }
+        batchReq;
     }
     data;
 
@@ -416,6 +424,21 @@ static void ProcessRequestQueue
                                           requestPtr->data.writeReq.value.AsBool);
                     break;
 
+                case RQ_SET_BATCH:
+                    LE_DEBUG("Processing deferred quick 'set batch' for user %u (%s) on tree '%s'.",
+                             tu_GetUserId(requestPtr->userRef),
+                             tu_GetUserName(requestPtr->userRef),
+                             tdb_GetTreeName(requestPtr->treeRef));
+
+                    rq_HandleQuickSetBatch(requestPtr->sessionRef,
+                                           requestPtr->commandRef,
+                                           requestPtr->userRef,
+                                           requestPtr->treeRef,
+                                           requestPtr->data.batchReq.pathPtr,
+                                           requestPtr->data.batchReq.items,
+                                           requestPtr->data.batchReq.itemCount);
+                    break;
+
                 case RQ_INVALID:
                     LE_FATAL("Invalid request block used.");
             }
@@ -1207,3 +1230,114 @@ void rq_HandleQuickSetBool
         le_cfg_QuickSetBoolRespond(commandRef);
     }
 }
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a batch of values from the configTree.  All of the items are read through the same
+ *  iterator, so they come from one consistent view of the tree.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleQuickGetBatch
+(
+    le_msg_SessionRef_t sessionRef,       ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,     ///< [IN] This handle is used to generate the reply for
+                                          ///<      this message.
+    tu_UserRef_t userRef,                 ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,                ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr,                  ///< [IN] The path the item paths are relative to.
+    const le_cfg_BatchItem_t* itemsPtr,   ///< [IN] The items to read, with their default values.
+    size_t itemCount                      ///< [IN] How many items there are.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_cfg_BatchItem_t values[LE_CFG_BATCH_MAX];
+
+    LE_ASSERT(itemCount <= LE_CFG_BATCH_MAX);
+
+    ni_IteratorRef_t iteratorRef = ni_CreateIterator(sessionRef,
+                                                     userRef,
+                                                     treeRef,
+                                                     NI_READ,
+                                                     pathPtr);
+
+    for (size_t i = 0; i < itemCount; i++)
+    {
+        values[i] = itemsPtr[i];
+        ni_GetBatchItem(iteratorRef, &values[i]);
+    }
+
+    ni_Release(iteratorRef);
+
+    le_cfg_QuickGetBatchRespond(commandRef, values, itemCount);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a batch of values to the configTree.  All of the items are written through one write
+ *  iterator, and the tree is committed once for the whole batch.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleQuickSetBatch
+(
+    le_msg_SessionRef_t sessionRef,       ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,     ///< [IN] This handle is used to generate the reply for
+                                          ///<      this message.
+    tu_UserRef_t userRef,                 ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,                ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr,                  ///< [IN] The path the item paths are relative to.
+    const le_cfg_BatchItem_t* itemsPtr,   ///< [IN] The items to write.
+    size_t itemCount                      ///< [IN] How many items there are.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(itemCount <= LE_CFG_BATCH_MAX);
+
+    if (CanQuickSet(treeRef) == false)
+    {
+        UpdateRequest_t* requestPtr = NewRequestBlock(RQ_SET_BATCH,
+                                                      userRef,
+                                                      treeRef,
+                                                      sessionRef,
+                                                      commandRef);
+
+        LE_ASSERT(le_utf8_Copy(requestPtr->data.batchReq.pathPtr,
+                               pathPtr,
+                               sizeof(requestPtr->data.batchReq.pathPtr),
+                               NULL) == LE_OK);
+
+        memcpy(requestPtr->data.batchReq.items, itemsPtr, itemCount * sizeof(le_cfg_BatchItem_t));
+        requestPtr->data.batchReq.itemCount = itemCount;
+
+        QueueRequest(tdb_GetRequestQueue(treeRef), requestPtr);
+    }
+    else
+    {
+        ni_IteratorRef_t iteratorRef = ni_CreateIterator(sessionRef,
+                                                         userRef,
+                                                         treeRef,
+                                                         NI_WRITE,
+                                                         pathPtr);
+
+        for (size_t i = 0; i < itemCount; i++)
+        {
+            // Drop the whole batch rather than commit part of it.
+            if (ni_SetBatchItem(iteratorRef, &itemsPtr[i]) != LE_OK)
+            {
+                ni_Release(iteratorRef);
+                tu_TerminateConfigClient(sessionRef, "A batch item could not be written.");
+                return;
+            }
+        }
+
+        ni_Commit(iteratorRef);
+        ni_Release(iteratorRef);
+
+        le_cfg_QuickSetBatchRespond(commandRef);
+    }
+}
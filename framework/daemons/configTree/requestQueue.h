@@ -36,7 +36,8 @@ typedef enum
     RQ_SET_BINARY,
     RQ_SET_INT,
     RQ_SET_FLOAT,
-    RQ_SET_BOOL
+    RQ_SET_BOOL,
+    RQ_SET_BATCH
 }
 RequestType_t;
 
@@ -325,4 +326,44 @@ void rq_HandleQuickSetBool
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a batch of values from the configTree, all in one read transaction.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleQuickGetBatch
+(
+    le_msg_SessionRef_t sessionRef,       ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,     ///< [IN] This handle is used to generate the reply for
+                                          ///<      this message.
+    tu_UserRef_t userRef,                 ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,                ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr,                  ///< [IN] The path the item paths are relative to.
+    const le_cfg_BatchItem_t* itemsPtr,   ///< [IN] The items to read, with their default values.
+    size_t itemCount                      ///< [IN] How many items there are.
+);
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a batch of values to the configTree, all in one write transaction.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleQuickSetBatch
+(
+    le_msg_SessionRef_t sessionRef,       ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,     ///< [IN] This handle is used to generate the reply for
+                                          ///<      this message.
+    tu_UserRef_t userRef,                 ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,                ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr,                  ///< [IN] The path the item paths are relative to.
+    const le_cfg_BatchItem_t* itemsPtr,   ///< [IN] The items to write.
+    size_t itemCount                      ///< [IN] How many items there are.
+);
+
+
+
+
 #endif
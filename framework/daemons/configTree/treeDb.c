@@ -120,6 +120,26 @@
  *  in order to have a handler registed for it.  In fact, a handler will be called when a node is
  *  deleted and when it is recreated.
  *
+ *  <b>Persistence:</b>
+ *
+ *  Originally each tree is stored as a text file, which is rewritten in full under a new name
+ *  (rock, paper or scissors) every time a write transaction is committed.
+ *
+ *  When LE_CONFIG_CFGTREE_JOURNAL is enabled, trees are instead stored as a binary snapshot,
+ *  (<tree>.snap,) and an append-only journal, (<tree>.journal.)  Committing a write transaction
+ *  appends one record to the journal, holding the new contents of the branches that were changed
+ *  and the paths of the nodes that were deleted, and syncs it.  The record is protected by a CRC, so
+ *  a record torn by a power loss is detected and dropped when the journal is replayed on top of the
+ *  snapshot at load time.  Once the journal grows past LE_CONFIG_CFGTREE_JOURNAL_COMPACT_SIZE a new
+ *  snapshot is written and the journal is cleared.  Each snapshot has a generation number that is
+ *  also written in the journal header, so a journal that was not cleared because of a crash right
+ *  after a new snapshot was written is ignored.  The snapshot and journal being replaced are kept,
+ *  (<tree>.snap.prev and <tree>.journal.prev,) so if the current snapshot can't be read the tree is
+ *  rebuilt from them and the current journal.
+ *
+ *  Trees that are still stored in the text format are loaded from it, and converted to a snapshot on
+ *  their next commit.
+ *
  *  Copyright (C) Sierra Wireless Inc.
  *
  */
@@ -134,6 +154,10 @@
 #include "nodeIterator.h"
 #include "sysPaths.h"
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+#include <sys/mman.h>
+#endif
+
 
 
 /// Maximum path size for the config tree.
@@ -145,6 +169,39 @@
 #define SMALL_STR 24
 
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+
+/// Magic numbers at the start of the snapshot and journal files, "LECS" and "LECJ".
+#define SNAPSHOT_MAGIC  0x5343454CU
+#define JOURNAL_MAGIC   0x4A43454CU
+
+/// Version of the snapshot and journal formats.
+#define STORE_VERSION   1
+
+/// Snapshot header:  magic, version, generation, payload size and payload CRC32.
+#define SNAPSHOT_HEADER_SIZE  20
+
+/// Journal header:  magic, version and the generation of the snapshot the journal applies to.
+#define JOURNAL_HEADER_SIZE   12
+
+/// Journal record header:  payload size and payload CRC32.
+#define RECORD_HEADER_SIZE    8
+
+/// Node types as stored in the snapshot and journal.
+#define STORE_TYPE_EMPTY   0
+#define STORE_TYPE_STRING  1
+#define STORE_TYPE_BOOL    2
+#define STORE_TYPE_INT     3
+#define STORE_TYPE_FLOAT   4
+#define STORE_TYPE_STEM    5
+
+/// Journal operations.  Each is followed by a node path, and replace is followed by the node.
+#define JOURNAL_OP_DELETE   1
+#define JOURNAL_OP_REPLACE  2
+
+#endif /* end LE_CONFIG_CFGTREE_JOURNAL */
+
+
 
 
 //--------------------------------------------------------------------------------------------------
@@ -230,17 +287,40 @@ CleanUpContext_t;
 // -------------------------------------------------------------------------------------------------
 typedef enum
 {
-    NODE_FLAGS_UNSET = 0x0,  ///< No flags have been set.
-    NODE_IS_SHADOW   = 0x1,  ///< The node is a shadow for a node in another tree.
-    NODE_IS_MODIFIED = 0x2,  ///< This node has been modified.
-    NODE_IS_DELETED  = 0x4   ///< This node has been marked as deleted, the actual deletion will
-                             ///<   take place later.
+    NODE_FLAGS_UNSET  = 0x0,  ///< No flags have been set.
+    NODE_IS_SHADOW    = 0x1,  ///< The node is a shadow for a node in another tree.
+    NODE_IS_MODIFIED  = 0x2,  ///< This node has been modified.
+    NODE_IS_DELETED   = 0x4,  ///< This node has been marked as deleted, the actual deletion will
+                              ///<   take place later.
+    NODE_IS_REORDERED = 0x8   ///< A child of this shadow node was renamed in place, so the whole
+                              ///<   node is journaled to preserve the order of its children.
 }
 NodeFlags_t;
 
 
 
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Hash index over the children of a stem node, keyed by the child's name hash.  Each bucket is a
+ *  chain of child nodes linked through their indexNextRef fields.
+ */
+// -------------------------------------------------------------------------------------------------
+typedef struct ChildIndex
+{
+    struct Node* buckets[LE_CONFIG_CFGTREE_CHILD_INDEX_BUCKETS];  ///< Chains of child nodes.
+}
+ChildIndex_t;
+
+static_assert((LE_CONFIG_CFGTREE_CHILD_INDEX_BUCKETS & (LE_CONFIG_CFGTREE_CHILD_INDEX_BUCKETS - 1))
+              == 0,
+              "Child index bucket count must be a power of two");
+#endif
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  The Node object structure.
@@ -263,6 +343,12 @@ typedef struct Node
     le_dls_Link_t siblingList;       ///< The linked list of node siblings.  All of the nodes
                                      ///<   in this list have the same parent node.
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    ChildIndex_t* childIndexPtr;     ///< Index of this node's children by name, if it has been
+                                     ///<   built.
+    struct Node* indexNextRef;       ///< Next node in this node's bucket of the parent's index.
+#endif
+
     union
     {
         dstr_Ref_t valueRef;         ///< The value of the node.  This is only valid if the
@@ -307,12 +393,61 @@ typedef struct Tree
 
     le_sls_List_t requestList;            ///< Each tree maintains it's own list of pending
                                           ///<   requests.
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    uint32_t generation;                  ///< Generation of the binary snapshot the tree was last
+                                          ///<   written to, 0 if there is none yet.
+    int journalFd;                        ///< The open journal file, or -1.
+    size_t journalSize;                   ///< Size of the valid data in the journal.
+    bool isCompactPending;                ///< Is a rewrite of the snapshot queued?
+    bool hasGoodSnapshot;                 ///< Was the current snapshot loaded or written
+                                          ///<   successfully?  Only then is it kept as the
+                                          ///<   previous snapshot when it's replaced.
+#endif
 }
 Tree_t;
 
 
 
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffered writer used to stream data to the snapshot and journal files.  Keeps a running CRC32
+ * and byte count of the data written, and latches the first error encountered.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int fd;                                ///< The file being written.
+    off_t offset;                          ///< File offset the buffered data goes to.
+    uint32_t crc;                          ///< CRC32 of the data written so far.
+    size_t size;                           ///< Number of bytes written so far.
+    size_t used;                           ///< Number of bytes in the buffer.
+    le_result_t result;                    ///< LE_OK, or the first error encountered.
+    uint8_t buffer[4096];                  ///< Data waiting to be written to the file.
+}
+StoreWriter_t;
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position within a snapshot or journal record being decoded.
+ **/
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const uint8_t* dataPtr;                ///< Next byte to read.
+    size_t remaining;                      ///< Number of bytes left.
+}
+StoreReader_t;
+#endif
+
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Types of lexical tokens that can be found in configuration data files.
@@ -337,6 +472,15 @@ LE_MEM_DEFINE_STATIC_POOL(nodePool, LE_CONFIG_CFGTREE_MAX_NODE_POOL_SIZE, sizeof
 /// The memory pool responsible for tree nodes.
 static le_mem_PoolRef_t NodePoolRef = NULL;
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+/// Define static pool for child indices
+LE_MEM_DEFINE_STATIC_POOL(childIndexPool, LE_CONFIG_CFGTREE_MAX_CHILD_INDEX_POOL_SIZE,
+    sizeof(ChildIndex_t));
+
+/// Pool from which the indices of large stems are allocated.
+static le_mem_PoolRef_t ChildIndexPoolRef = NULL;
+#endif
+
 
 /// Define static memory for collection of configuration trees managed by the system
 LE_HASHMAP_DEFINE_STATIC(TreeCollection, LE_CONFIG_CFGTREE_MAX_TREE_POOL_SIZE);
@@ -570,6 +714,10 @@ static tdb_NodeRef_t NewNode
     newNodeRef->nameRef = NULL;
     newNodeRef->nameHash = 0;
     newNodeRef->siblingList = LE_DLS_LINK_INIT;
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    newNodeRef->childIndexPtr = NULL;
+    newNodeRef->indexNextRef = NULL;
+#endif
     memset(&newNodeRef->info, 0, sizeof(newNodeRef->info));
 
     return newNodeRef;
@@ -578,6 +726,157 @@ static tdb_NodeRef_t NewNode
 
 
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Get the bucket of a node's child index that children with the given name hash belong in.
+ */
+// -------------------------------------------------------------------------------------------------
+static inline tdb_NodeRef_t* GetIndexBucket
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN] The indexed parent node.
+    size_t nameHash         ///< [IN] Name hash of the child.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    return &nodeRef->childIndexPtr->buckets[nameHash & (LE_CONFIG_CFGTREE_CHILD_INDEX_BUCKETS - 1)];
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Add a node to its parent's child index, if the parent has one.  Must be called whenever a node
+ *  is given a name, (or a new name,) while it is in its parent's collection.
+ */
+// -------------------------------------------------------------------------------------------------
+static void IndexChild
+(
+    tdb_NodeRef_t childRef  ///< [IN] The child node to add.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_NodeRef_t parentRef = childRef->parentRef;
+
+    if (   (parentRef == NULL)
+        || (parentRef->childIndexPtr == NULL))
+    {
+        return;
+    }
+
+    tdb_NodeRef_t* bucketPtr = GetIndexBucket(parentRef, tdb_GetNodeNameHash(childRef));
+
+    childRef->indexNextRef = *bucketPtr;
+    *bucketPtr = childRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Remove a node from its parent's child index, if it is in it.  Must be called before a node's
+ *  name changes, or it leaves its parent's collection.
+ */
+// -------------------------------------------------------------------------------------------------
+static void UnindexChild
+(
+    tdb_NodeRef_t childRef  ///< [IN] The child node to remove.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_NodeRef_t parentRef = childRef->parentRef;
+
+    if (   (parentRef == NULL)
+        || (parentRef->childIndexPtr == NULL))
+    {
+        return;
+    }
+
+    tdb_NodeRef_t* linkPtr = GetIndexBucket(parentRef, tdb_GetNodeNameHash(childRef));
+
+    while (*linkPtr != NULL)
+    {
+        if (*linkPtr == childRef)
+        {
+            *linkPtr = childRef->indexNextRef;
+            break;
+        }
+
+        linkPtr = &(*linkPtr)->indexNextRef;
+    }
+
+    childRef->indexNextRef = NULL;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Drop a node's child index.  Done before its children are released, so that they don't each
+ *  have to be unlinked from it.
+ */
+// -------------------------------------------------------------------------------------------------
+static void DropChildIndex
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The node whose index is dropped.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (nodeRef->childIndexPtr != NULL)
+    {
+        le_mem_Release(nodeRef->childIndexPtr);
+        nodeRef->childIndexPtr = NULL;
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Build the index of a stem node's children.  Called once a name lookup on the node has had to
+ *  walk past LE_CONFIG_CFGTREE_CHILD_INDEX_THRESHOLD children.  From then on the index is kept up
+ *  to date as children are added, renamed and removed.
+ */
+// -------------------------------------------------------------------------------------------------
+static void BuildChildIndex
+(
+    tdb_NodeRef_t nodeRef  ///< [IN] The stem node to index.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    nodeRef->childIndexPtr = le_mem_TryAlloc(ChildIndexPoolRef);
+
+    if (nodeRef->childIndexPtr == NULL)
+    {
+        // Lookups on this node will just keep using the linear search.
+        return;
+    }
+
+    memset(nodeRef->childIndexPtr, 0, sizeof(ChildIndex_t));
+
+    // Go through the children backwards so that each bucket ends up in collection order, and so
+    // the first of any nodes sharing a name is the one found, as with the linear search.
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&nodeRef->info.children);
+
+    while (linkPtr != NULL)
+    {
+        IndexChild(CONTAINER_OF(linkPtr, Node_t, siblingList));
+        linkPtr = le_dls_PeekPrev(&nodeRef->info.children, linkPtr);
+    }
+}
+#else
+#define IndexChild(childRef)        do {} while (0)
+#define UnindexChild(childRef)      do {} while (0)
+#define DropChildIndex(nodeRef)     do {} while (0)
+#endif
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  The node destructor function.  This will take care of freeing a node's string values and any
@@ -592,6 +891,9 @@ static void NodeDestructor
 {
     tdb_NodeRef_t nodeRef = (tdb_NodeRef_t)objectPtr;
 
+    UnindexChild(nodeRef);
+    DropChildIndex(nodeRef);
+
     if (nodeRef->nameRef)
     {
         dstr_Release(nodeRef->nameRef);
@@ -784,6 +1086,7 @@ static void ShadowChildren
         newShadowRef->parentRef = shadowParentRef;
 
         le_dls_Queue(&shadowParentRef->info.children, &newShadowRef->siblingList);
+        IndexChild(newShadowRef);
 
         originalChildRef = tdb_GetNextSiblingNode(originalChildRef);
     }
@@ -854,8 +1157,49 @@ static tdb_NodeRef_t GetNamedChild
     size_t stringHash = le_hashmap_HashString(nameRef);
     size_t nodeHash;
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    // If this is a large collection, only look at the children that share the name's bucket.
+    if (nodeRef->childIndexPtr != NULL)
+    {
+        currentRef = *GetIndexBucket(nodeRef, stringHash);
+
+        while (currentRef != NULL)
+        {
+            if (tdb_GetNodeNameHash(currentRef) == stringHash)
+            {
+                tdb_GetNodeName(currentRef, currentNameRef, sizeof(currentNameRef));
+
+                if (strncmp(currentNameRef, nameRef, sizeof(currentNameRef)) == 0)
+                {
+                    return currentRef;
+                }
+            }
+
+            currentRef = currentRef->indexNextRef;
+        }
+
+        return NULL;
+    }
+
+    size_t searchCount = 0;
+#endif
+
     while (currentRef != NULL)
     {
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+        if (++searchCount == LE_CONFIG_CFGTREE_CHILD_INDEX_THRESHOLD)
+        {
+            // This collection is big enough to be worth indexing.  Let the index finish the
+            // search.
+            BuildChildIndex(nodeRef);
+
+            if (nodeRef->childIndexPtr != NULL)
+            {
+                return GetNamedChild(nodeRef, nameRef);
+            }
+        }
+#endif
+
         nodeHash = tdb_GetNodeNameHash(currentRef);
 
         // if the hash doesn't match, the name is different. If the hash matches, there is
@@ -939,22 +1283,7 @@ static bool NodeExists
 )
 // -------------------------------------------------------------------------------------------------
 {
-    tdb_NodeRef_t currentRef = tdb_GetFirstChildNode(parentRef);
-    char currentName[LE_CFG_NAME_LEN_BYTES] = "";
-
-    while (currentRef != NULL)
-    {
-        tdb_GetNodeName(currentRef, currentName, sizeof(currentName));
-
-        if (strncmp(currentName, namePtr, sizeof(currentName)) == 0)
-        {
-            return true;
-        }
-
-        currentRef = tdb_GetNextSiblingNode(currentRef);
-    }
-
-    return false;
+    return GetNamedChild(parentRef, namePtr) != NULL;
 }
 
 
@@ -1085,6 +1414,8 @@ static void MergeNode
     // If the name has been changed, then copy it over now.
     if (dstr_IsNullOrEmpty(nodeRef->nameRef) == false)
     {
+        UnindexChild(originalRef);
+
         if (originalRef->nameRef != NULL)
         {
             dstr_Copy(originalRef->nameRef, nodeRef->nameRef);
@@ -1094,6 +1425,8 @@ static void MergeNode
             originalRef->nameRef = dstr_NewFromDstr(nodeRef->nameRef);
         }
         originalRef->nameHash = nodeRef->nameHash;
+
+        IndexChild(originalRef);
     }
 
     // Check the types of the original and the shadow nodes.  If the new node has been cleared,
@@ -1613,6 +1946,14 @@ tdb_TreeRef_t NewTree
     treeRef->activeWriteIterRef = NULL;
     treeRef->requestList = LE_SLS_LIST_INIT;
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+    treeRef->generation = 0;
+    treeRef->journalFd = -1;
+    treeRef->journalSize = 0;
+    treeRef->isCompactPending = false;
+    treeRef->hasGoodSnapshot = false;
+#endif
+
     return treeRef;
 }
 
@@ -1640,6 +1981,14 @@ static void TreeDestructor
     LE_ASSERT(treeRef->activeReadCount == 0);
     LE_ASSERT(treeRef->activeWriteIterRef == NULL);
     LE_ASSERT(le_sls_IsEmpty(&treeRef->requestList) == true);
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    if (treeRef->journalFd >= 0)
+    {
+        close(treeRef->journalFd);
+        treeRef->journalFd = -1;
+    }
+#endif
 }
 
 
@@ -1665,7 +2014,7 @@ static void GetTreePath
     // rock     --> scissors   2 -> 3
     // scissors --> paper      3 -> 1
 
-    static const char* revNames[] = { "paper", "rock", "scissors" };
+    static const char* revNames[] = { CFG_TREE_TEXT_EXTS };
     int printSize;
 
     LE_ASSERT((revisionId >= 1) && (revisionId <= 3));
@@ -2514,6 +2863,7 @@ static size_t ComputePathLength
 
 
 
+#if !LE_CONFIG_CFGTREE_JOURNAL
 // -------------------------------------------------------------------------------------------------
 /**
  *  Bump up the version id of this tree.
@@ -2532,86 +2882,1593 @@ static void IncrementRevision
         treeRef->revisionId = 1;
     }
 }
+#endif
 
 
 
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Attempt to load a configuration tree from a config file.  This function will look for the latest
- *  valid version of the config file and load that one.
+ *  Call this function to delete a tree file from the filesystem.
  */
 // -------------------------------------------------------------------------------------------------
-static void LoadTree
+static void DeleteTreeFile
 (
-    tdb_TreeRef_t treeRef  ///< [IN] The tree object to load from the filesystem.
+    const char* filePathPtr  ///< Path to the tree file in question.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // If we don't know the revision then hunt it out from the filesystem.
-    if (treeRef->revisionId == 0)
-    {
-        UpdateRevision(treeRef);
-    }
+    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
 
-    // If this tree has no root, create it now.
-    if (treeRef->rootNodeRef == NULL)
+    if (unlink(filePathPtr) != 0)
     {
-        treeRef->rootNodeRef = NewNode();
+        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
     }
+}
 
-    // Ok, if we found a valid revision of the tree in the fs, try to load it now.
-    if (treeRef->revisionId != 0)
-    {
-        char pathPtr[LE_CFG_STR_LEN_BYTES] = "";
-        GetTreePath(treeRef->name, treeRef->revisionId, pathPtr, sizeof(pathPtr));
-
-        LE_DEBUG("** Loading configuration tree from '%s'.", pathPtr);
-
-        FILE* fileRef;
 
-        fileRef = fopen(pathPtr, "r");
 
-        tdb_EnsureExists(treeRef->rootNodeRef);
 
-        if (!fileRef)
-        {
-            LE_ERROR("Could not open configuration tree file: %s, reason: %s",
-                     pathPtr,
-                     LE_ERRNO_TXT(errno));
-        }
-        else
-        {
-            if (tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) == false)
-            {
-                LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
-                le_mem_Release(treeRef->rootNodeRef);
-                treeRef->rootNodeRef = NewNode();
-            }
+#if LE_CONFIG_CFGTREE_JOURNAL
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Build the path to one of the binary store files of a tree.
+ */
+// -------------------------------------------------------------------------------------------------
+static void GetStorePath
+(
+    const char* treeNameRef,  ///< [IN] The name of the tree we're generating a name for.
+    const char* extPtr,       ///< [IN] Extension of the file, CFG_TREE_SNAPSHOT_EXT, etc.
+    char* pathBuffer,         ///< [IN] Buffer to hold the new path.
+    size_t pathSize           ///< [IN] Size of the path buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    int printSize = snprintf(pathBuffer, pathSize, "%s/%s.%s", CFG_TREE_PATH, treeNameRef, extPtr);
 
-            fclose(fileRef);
-        }
+    if ((printSize < 0) || ((size_t)printSize >= pathSize))
+    {
+       LE_ERROR("Unable to store config tree path in buffer");
+       pathBuffer[0] = '\0';
     }
 }
 
 
 
+
 // -------------------------------------------------------------------------------------------------
 /**
- *  Removes the handler object from the given registration object.  This function will also free the
- *  memory that the handler object had used.
+ *  Write out the buffered data of a store writer.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
  */
 // -------------------------------------------------------------------------------------------------
-static void RemoveHandler
+static le_result_t FlushStore
 (
-    Registration_t* registrationPtr,  ///< [IN] The registration object to remove the link from.
-    Handler_t* handlerPtr             ///< [IN] The handler object we're removing.
+    StoreWriter_t* writerPtr  ///< [IN] The writer to flush.
 )
 // -------------------------------------------------------------------------------------------------
 {
-    // Kill the ref, and remove the object from the registration list.
-    le_ref_DeleteRef(HandlerSafeRefMap, handlerPtr->safeRef);
-    le_dls_Remove(&registrationPtr->handlerList, &handlerPtr->link);
+    size_t done = 0;
+
+    while (   (writerPtr->result == LE_OK)
+           && (done < writerPtr->used))
+    {
+        ssize_t written = pwrite(writerPtr->fd,
+                                 writerPtr->buffer + done,
+                                 writerPtr->used - done,
+                                 writerPtr->offset);
+
+        if (written < 0)
+        {
+            if (errno != EINTR)
+            {
+                LE_EMERG("Failed to write to config tree store (%m).");
+                writerPtr->result = LE_IO_ERROR;
+            }
+        }
+        else
+        {
+            done += written;
+            writerPtr->offset += written;
+        }
+    }
+
+    writerPtr->used = 0;
+    return writerPtr->result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Add data to a store file.  The data is buffered and included in the writer's running CRC.
+ *  Errors are latched in the writer, so callers only need to check the result once they're done.
+ */
+// -------------------------------------------------------------------------------------------------
+static void WriteStore
+(
+    StoreWriter_t* writerPtr,  ///< [IN] The writer to add the data to.
+    const void* dataPtr,       ///< [IN] The data to write.
+    size_t dataSize            ///< [IN] The amount of data to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    const uint8_t* bytePtr = dataPtr;
+
+    writerPtr->crc = le_crc_Crc32((uint8_t*)bytePtr, dataSize, writerPtr->crc);
+    writerPtr->size += dataSize;
+
+    while (   (dataSize > 0)
+           && (writerPtr->result == LE_OK))
+    {
+        size_t chunkSize = sizeof(writerPtr->buffer) - writerPtr->used;
+
+        if (chunkSize > dataSize)
+        {
+            chunkSize = dataSize;
+        }
+
+        memcpy(writerPtr->buffer + writerPtr->used, bytePtr, chunkSize);
+        writerPtr->used += chunkSize;
+        bytePtr += chunkSize;
+        dataSize -= chunkSize;
+
+        if (writerPtr->used == sizeof(writerPtr->buffer))
+        {
+            FlushStore(writerPtr);
+        }
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Store a 32-bit value in little endian byte order.
+ */
+// -------------------------------------------------------------------------------------------------
+static void PutStoreU32
+(
+    uint8_t* bufferPtr,  ///< [OUT] Where to store the value.
+    uint32_t value       ///< [IN]  The value to store.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    bufferPtr[0] = (uint8_t)value;
+    bufferPtr[1] = (uint8_t)(value >> 8);
+    bufferPtr[2] = (uint8_t)(value >> 16);
+    bufferPtr[3] = (uint8_t)(value >> 24);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Load a 32-bit value stored in little endian byte order.
+ *
+ *  @return The value.
+ */
+// -------------------------------------------------------------------------------------------------
+static uint32_t GetStoreU32
+(
+    const uint8_t* bufferPtr  ///< [IN] Where the value is stored.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    return    (uint32_t)bufferPtr[0]
+           | ((uint32_t)bufferPtr[1] << 8)
+           | ((uint32_t)bufferPtr[2] << 16)
+           | ((uint32_t)bufferPtr[3] << 24);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a length prefixed string to a store file.  The length is stored in lengthSize bytes, (2 or
+ *  4.)
+ */
+// -------------------------------------------------------------------------------------------------
+static void WriteStoreString
+(
+    StoreWriter_t* writerPtr,  ///< [IN] The writer to add the string to.
+    const char* stringPtr,     ///< [IN] The string to write.
+    size_t stringSize,         ///< [IN] Length of the string, in bytes.
+    size_t lengthSize          ///< [IN] Number of bytes used to encode the length.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    uint8_t lengthBuffer[4];
+
+    PutStoreU32(lengthBuffer, (uint32_t)stringSize);
+    WriteStore(writerPtr, lengthBuffer, lengthSize);
+    WriteStore(writerPtr, stringPtr, stringSize);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Serialize a node and it's children in the binary store format.
+ *
+ *  Each node is written as a type byte, followed by the value as a 4 byte length and the value
+ *  string, or for stems, by each child's 2 byte name length, name and encoded node.  A zero name
+ *  length ends the child list.
+ */
+// -------------------------------------------------------------------------------------------------
+static void EncodeNode
+(
+    StoreWriter_t* writerPtr,  ///< [IN] The writer to add the node to.
+    tdb_NodeRef_t nodeRef,     ///< [IN] The node being written.
+    char* stringBuffer         ///< [IN] Scratch buffer of TDB_MAX_ENCODED_SIZE bytes.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    uint8_t storeType;
+    le_cfg_nodeType_t nodeType = tdb_GetNodeType(nodeRef);
+
+    switch (nodeType)
+    {
+        case LE_CFG_TYPE_STRING:
+            storeType = STORE_TYPE_STRING;
+            break;
+
+        case LE_CFG_TYPE_BOOL:
+            storeType = STORE_TYPE_BOOL;
+            break;
+
+        case LE_CFG_TYPE_INT:
+            storeType = STORE_TYPE_INT;
+            break;
+
+        case LE_CFG_TYPE_FLOAT:
+            storeType = STORE_TYPE_FLOAT;
+            break;
+
+        case LE_CFG_TYPE_STEM:
+            storeType = STORE_TYPE_STEM;
+            break;
+
+        case LE_CFG_TYPE_EMPTY:
+        case LE_CFG_TYPE_DOESNT_EXIST:
+        default:
+            storeType = STORE_TYPE_EMPTY;
+            break;
+    }
+
+    WriteStore(writerPtr, &storeType, 1);
+
+    if (storeType == STORE_TYPE_STEM)
+    {
+        tdb_NodeRef_t childRef = tdb_GetFirstActiveChildNode(nodeRef);
+
+        while (   (childRef != NULL)
+               && (writerPtr->result == LE_OK))
+        {
+            tdb_GetNodeName(childRef, stringBuffer, LE_CFG_NAME_LEN_BYTES);
+            WriteStoreString(writerPtr, stringBuffer, strlen(stringBuffer), 2);
+            EncodeNode(writerPtr, childRef, stringBuffer);
+
+            childRef = tdb_GetNextActiveSiblingNode(childRef);
+        }
+
+        WriteStoreString(writerPtr, "", 0, 2);
+    }
+    else if (storeType != STORE_TYPE_EMPTY)
+    {
+        tdb_GetValueAsString(nodeRef, stringBuffer, TDB_MAX_ENCODED_SIZE, "");
+        WriteStoreString(writerPtr, stringBuffer, strlen(stringBuffer), 4);
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a little endian value of 1, 2 or 4 bytes from a store buffer.
+ *
+ *  @return LE_OK if the value was read, LE_FORMAT_ERROR if the buffer is too short.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadStoreValue
+(
+    StoreReader_t* readerPtr,  ///< [IN]  The buffer being read.
+    size_t valueSize,          ///< [IN]  Number of bytes in the value.
+    uint32_t* valuePtr         ///< [OUT] The value read.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    if (readerPtr->remaining < valueSize)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    *valuePtr = 0;
+
+    for (i = 0; i < valueSize; i++)
+    {
+        *valuePtr |= (uint32_t)readerPtr->dataPtr[i] << (8 * i);
+    }
+
+    readerPtr->dataPtr += valueSize;
+    readerPtr->remaining -= valueSize;
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a length prefixed string from a store buffer into a null terminated buffer.
+ *
+ *  @return LE_OK if the string was read, LE_FORMAT_ERROR if the buffer is too short or the string
+ *          doesn't fit in the output buffer.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadStoreString
+(
+    StoreReader_t* readerPtr,  ///< [IN]  The buffer being read.
+    size_t lengthSize,         ///< [IN]  Number of bytes used to encode the length.
+    char* stringPtr,           ///< [OUT] Buffer for the string.
+    size_t stringSize          ///< [IN]  Size of the string buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    uint32_t length;
+
+    if (   (ReadStoreValue(readerPtr, lengthSize, &length) != LE_OK)
+        || (length >= stringSize)
+        || (length > readerPtr->remaining))
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    memcpy(stringPtr, readerPtr->dataPtr, length);
+    stringPtr[length] = '\0';
+
+    readerPtr->dataPtr += length;
+    readerPtr->remaining -= length;
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a node and it's children from a store buffer, replacing the node's current contents.
+ *
+ *  @return LE_OK if the read is successful, LE_FORMAT_ERROR if the data is malformed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t DecodeNode
+(
+    tdb_NodeRef_t nodeRef,     ///< [IN] The node we're reading a value for.
+    StoreReader_t* readerPtr,  ///< [IN] The buffer being read.
+    char* stringBuffer         ///< [IN] Scratch buffer of TDB_MAX_ENCODED_SIZE bytes.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    uint32_t storeType;
+    le_cfg_nodeType_t nodeType = LE_CFG_TYPE_EMPTY;
+
+    if (ReadStoreValue(readerPtr, 1, &storeType) != LE_OK)
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    tdb_SetEmpty(nodeRef);
+
+    switch (storeType)
+    {
+        case STORE_TYPE_EMPTY:
+            break;
+
+        case STORE_TYPE_STRING:
+            nodeType = LE_CFG_TYPE_STRING;
+            break;
+
+        case STORE_TYPE_BOOL:
+            nodeType = LE_CFG_TYPE_BOOL;
+            break;
+
+        case STORE_TYPE_INT:
+            nodeType = LE_CFG_TYPE_INT;
+            break;
+
+        case STORE_TYPE_FLOAT:
+            nodeType = LE_CFG_TYPE_FLOAT;
+            break;
+
+        case STORE_TYPE_STEM:
+            for (;;)
+            {
+                if (ReadStoreString(readerPtr, 2, stringBuffer, LE_CFG_NAME_LEN_BYTES) != LE_OK)
+                {
+                    return LE_FORMAT_ERROR;
+                }
+
+                if (stringBuffer[0] == '\0')
+                {
+                    break;
+                }
+
+                // Names in the store were valid and unique when they were written, so skip the
+                // checks done by tdb_SetNodeName.
+                tdb_NodeRef_t childRef = NewChildNode(nodeRef);
+
+                childRef->nameRef = dstr_NewFromCstr(stringBuffer);
+                childRef->nameHash = le_hashmap_HashString(stringBuffer);
+                IndexChild(childRef);
+
+                if (DecodeNode(childRef, readerPtr, stringBuffer) != LE_OK)
+                {
+                    return LE_FORMAT_ERROR;
+                }
+            }
+            break;
+
+        default:
+            LE_ERROR("Unexpected node type %" PRIu32 " in config tree store.", storeType);
+            return LE_FORMAT_ERROR;
+    }
+
+    if (nodeType != LE_CFG_TYPE_EMPTY)
+    {
+        if (ReadStoreString(readerPtr, 4, stringBuffer, TDB_MAX_ENCODED_SIZE) != LE_OK)
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        tdb_SetValueAsString(nodeRef, stringBuffer);
+        nodeRef->type = nodeType;
+    }
+
+    ClearModifiedFlag(nodeRef);
+    ClearDeletedFlag(nodeRef);
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Compute the path of a node relative to the root of it's tree, as stored in the journal.  That
+ *  is, the node names seperated by '/', without a leading seperator.  The root node has an empty
+ *  path.
+ *
+ *  @return LE_OK if the path fit in the buffer, LE_OVERFLOW if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t GetStoreNodePath
+(
+    tdb_NodeRef_t nodeRef,  ///< [IN]  Compute a path for this node.
+    char* pathPtr,          ///< [OUT] Buffer for the path.
+    size_t pathSize,        ///< [IN]  Size of the path buffer.
+    size_t* lengthPtr       ///< [OUT] Length of the path.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
+    size_t length = 0;
+    size_t nameLength;
+
+    if (nodeRef->parentRef == NULL)
+    {
+        pathPtr[0] = '\0';
+        *lengthPtr = 0;
+        return LE_OK;
+    }
+
+    if (GetStoreNodePath(nodeRef->parentRef, pathPtr, pathSize, &length) != LE_OK)
+    {
+        return LE_OVERFLOW;
+    }
+
+    tdb_GetNodeName(nodeRef, nodeName, sizeof(nodeName));
+    nameLength = strlen(nodeName);
+
+    if (length + nameLength + 2 > pathSize)
+    {
+        return LE_OVERFLOW;
+    }
+
+    if (length > 0)
+    {
+        pathPtr[length++] = '/';
+    }
+
+    memcpy(pathPtr + length, nodeName, nameLength + 1);
+    *lengthPtr = length + nameLength;
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Find the node at a journal path, optionally creating it and any missing parents.
+ *
+ *  @return The node, or NULL if it doesn't exist and wasn't to be created.
+ */
+// -------------------------------------------------------------------------------------------------
+static tdb_NodeRef_t FindStoreNode
+(
+    tdb_NodeRef_t rootRef,  ///< [IN] The root node of the tree.
+    char* pathPtr,          ///< [IN] The path to look up.  Modified during the search.
+    bool create             ///< [IN] Create the node if it doesn't exist?
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_NodeRef_t nodeRef = rootRef;
+    char* namePtr = pathPtr;
+
+    while (   (nodeRef != NULL)
+           && (*namePtr != '\0'))
+    {
+        char* endPtr = strchr(namePtr, '/');
+
+        if (endPtr != NULL)
+        {
+            *endPtr = '\0';
+        }
+
+        tdb_NodeRef_t childRef = GetNamedChild(nodeRef, namePtr);
+
+        if (   (childRef == NULL)
+            && (create))
+        {
+            if (nodeRef->type != LE_CFG_TYPE_STEM)
+            {
+                tdb_SetEmpty(nodeRef);
+                nodeRef->type = LE_CFG_TYPE_EMPTY;
+            }
+
+            childRef = NewChildNode(nodeRef);
+            childRef->nameRef = dstr_NewFromCstr(namePtr);
+            childRef->nameHash = le_hashmap_HashString(namePtr);
+            IndexChild(childRef);
+        }
+
+        nodeRef = childRef;
+        namePtr = (endPtr != NULL) ? endPtr + 1 : namePtr + strlen(namePtr);
+    }
+
+    return nodeRef;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Apply the operations of a journal record to a tree.
+ *
+ *  @return LE_OK if the record was applied, LE_FORMAT_ERROR if it was malformed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ApplyJournalRecord
+(
+    tdb_NodeRef_t rootRef,     ///< [IN] The root node of the tree being updated.
+    StoreReader_t* readerPtr,  ///< [IN] The record's payload.
+    char* stringBuffer         ///< [IN] Scratch buffer of TDB_MAX_ENCODED_SIZE bytes.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char path[LE_CFG_STR_LEN_BYTES];
+
+    while (readerPtr->remaining > 0)
+    {
+        uint32_t op;
+
+        if (   (ReadStoreValue(readerPtr, 1, &op) != LE_OK)
+            || (ReadStoreString(readerPtr, 2, path, sizeof(path)) != LE_OK))
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        if (op == JOURNAL_OP_DELETE)
+        {
+            tdb_NodeRef_t nodeRef = FindStoreNode(rootRef, path, false);
+
+            if (nodeRef == rootRef)
+            {
+                tdb_SetEmpty(rootRef);
+                ClearModifiedFlag(rootRef);
+            }
+            else if (nodeRef != NULL)
+            {
+                le_mem_Release(nodeRef);
+            }
+        }
+        else if (op == JOURNAL_OP_REPLACE)
+        {
+            if (DecodeNode(FindStoreNode(rootRef, path, true), readerPtr, stringBuffer) != LE_OK)
+            {
+                return LE_FORMAT_ERROR;
+            }
+        }
+        else
+        {
+            LE_ERROR("Unexpected operation %" PRIu32 " in config tree journal.", op);
+            return LE_FORMAT_ERROR;
+        }
+    }
+
+    return LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Map a store file into memory for reading.
+ *
+ *  @return The start of the mapping, or NULL if the file is empty or can't be mapped.
+ */
+// -------------------------------------------------------------------------------------------------
+static const uint8_t* MapStoreFile
+(
+    int fd,            ///< [IN]  The open store file.
+    size_t* sizePtr    ///< [OUT] The size of the file.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    struct stat st;
+
+    if (   (fstat(fd, &st) != 0)
+        || (!S_ISREG(st.st_mode)))
+    {
+        LE_ERROR("Unable to stat config tree store (%m).");
+        return NULL;
+    }
+
+    *sizePtr = st.st_size;
+
+    if (st.st_size == 0)
+    {
+        return NULL;
+    }
+
+    void* mapPtr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (mapPtr == MAP_FAILED)
+    {
+        LE_ERROR("Unable to map config tree store (%m).");
+        return NULL;
+    }
+
+    return mapPtr;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Load a tree from it's current or previous binary snapshot, if there is a valid one.
+ *
+ *  @return LE_OK if the tree was loaded.
+ *          LE_NOT_FOUND if there is no snapshot.
+ *          LE_FORMAT_ERROR if the snapshot is corrupt.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t LoadSnapshot
+(
+    tdb_TreeRef_t treeRef,  ///< [IN] The tree to load.
+    const char* extPtr      ///< [IN] CFG_TREE_SNAPSHOT_EXT or CFG_TREE_SNAPSHOT_PREV_EXT.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char path[LE_CFG_STR_LEN_BYTES] = "";
+    size_t fileSize = 0;
+
+    GetStorePath(treeRef->name, extPtr, path, sizeof(path));
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        if (errno != ENOENT)
+        {
+            LE_ERROR("Could not open configuration tree snapshot: %s, reason: %s",
+                     path,
+                     LE_ERRNO_TXT(errno));
+        }
+
+        return LE_NOT_FOUND;
+    }
+
+    const uint8_t* dataPtr = MapStoreFile(fd, &fileSize);
+    le_result_t result = LE_FORMAT_ERROR;
+
+    close(fd);
+
+    if (   (dataPtr != NULL)
+        && (fileSize >= SNAPSHOT_HEADER_SIZE)
+        && (GetStoreU32(dataPtr) == SNAPSHOT_MAGIC)
+        && (GetStoreU32(dataPtr + 4) == STORE_VERSION)
+        && (GetStoreU32(dataPtr + 12) == fileSize - SNAPSHOT_HEADER_SIZE)
+        && (GetStoreU32(dataPtr + 16) == le_crc_Crc32((uint8_t*)dataPtr + SNAPSHOT_HEADER_SIZE,
+                                                      fileSize - SNAPSHOT_HEADER_SIZE,
+                                                      LE_CRC_START_CRC32)))
+    {
+        char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
+        StoreReader_t reader = { dataPtr + SNAPSHOT_HEADER_SIZE, fileSize - SNAPSHOT_HEADER_SIZE };
+
+        result = DecodeNode(treeRef->rootNodeRef, &reader, stringBuffer);
+
+        if (   (result == LE_OK)
+            && (reader.remaining != 0))
+        {
+            result = LE_FORMAT_ERROR;
+        }
+
+        if (result == LE_OK)
+        {
+            treeRef->generation = GetStoreU32(dataPtr + 8);
+        }
+
+        le_mem_Release(stringBuffer);
+    }
+
+    if (dataPtr != NULL)
+    {
+        munmap((void*)dataPtr, fileSize);
+    }
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("Could not parse configuration tree snapshot: %s.", path);
+    }
+
+    return result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Replay the committed changes recorded in a tree's journal on top of the snapshot just loaded.
+ *
+ *  Replay stops at the first incomplete or corrupt record, which can only be the last one written
+ *  before the system went down.  The journal is truncated there so new records are appended after
+ *  the last good one.  A journal written for another snapshot generation is ignored, and will be
+ *  reset on the next commit.
+ *
+ *  The journal is left open as the tree's journal.
+ */
+// -------------------------------------------------------------------------------------------------
+static void ReplayJournal
+(
+    tdb_TreeRef_t treeRef,  ///< [IN] The tree to update.
+    const char* extPtr      ///< [IN] CFG_TREE_JOURNAL_EXT or CFG_TREE_JOURNAL_PREV_EXT.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char path[LE_CFG_STR_LEN_BYTES] = "";
+    size_t fileSize = 0;
+    size_t offset = JOURNAL_HEADER_SIZE;
+    size_t numRecords = 0;
+
+    GetStorePath(treeRef->name, extPtr, path, sizeof(path));
+
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    const uint8_t* dataPtr = MapStoreFile(fd, &fileSize);
+
+    if (   (dataPtr == NULL)
+        || (fileSize < JOURNAL_HEADER_SIZE)
+        || (GetStoreU32(dataPtr) != JOURNAL_MAGIC)
+        || (GetStoreU32(dataPtr + 4) != STORE_VERSION)
+        || (GetStoreU32(dataPtr + 8) != treeRef->generation))
+    {
+        LE_DEBUG("Ignoring stale journal '%s'.", path);
+
+        if (dataPtr != NULL)
+        {
+            munmap((void*)dataPtr, fileSize);
+        }
+        close(fd);
+        return;
+    }
+
+    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
+
+    while (fileSize - offset >= RECORD_HEADER_SIZE)
+    {
+        uint32_t recordSize = GetStoreU32(dataPtr + offset);
+        const uint8_t* payloadPtr = dataPtr + offset + RECORD_HEADER_SIZE;
+
+        if (   (recordSize == 0)
+            || (recordSize > fileSize - offset - RECORD_HEADER_SIZE)
+            || (GetStoreU32(dataPtr + offset + 4) != le_crc_Crc32((uint8_t*)payloadPtr,
+                                                                  recordSize,
+                                                                  LE_CRC_START_CRC32)))
+        {
+            break;
+        }
+
+        StoreReader_t reader = { payloadPtr, recordSize };
+
+        if (ApplyJournalRecord(treeRef->rootNodeRef, &reader, stringBuffer) != LE_OK)
+        {
+            // The record passed its CRC check, so this can only be a bug.  The tree may be
+            // partially updated, but it's the best we can do.
+            LE_CRIT("Malformed record in configuration tree journal: %s.", path);
+            break;
+        }
+
+        offset += RECORD_HEADER_SIZE + recordSize;
+        numRecords++;
+    }
+
+    le_mem_Release(stringBuffer);
+    munmap((void*)dataPtr, fileSize);
+
+    if (offset < fileSize)
+    {
+        LE_WARN("Discarding %" PRIuS " bytes of incomplete journal data from '%s'.",
+                fileSize - offset,
+                path);
+
+        if (ftruncate(fd, offset) != 0)
+        {
+            LE_ERROR("Failed to truncate journal '%s' (%m).", path);
+            close(fd);
+            return;
+        }
+    }
+
+    LE_DEBUG("Replayed %" PRIuS " journal records from '%s'.", numRecords, path);
+
+    treeRef->journalFd = fd;
+    treeRef->journalSize = offset;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Flush any data a writer has buffered, and sync the file to storage.
+ *
+ *  @return LE_OK if successful, LE_IO_ERROR if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SyncStore
+(
+    StoreWriter_t* writerPtr  ///< [IN] The writer to sync.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (   (FlushStore(writerPtr) == LE_OK)
+        && (fdatasync(writerPtr->fd) != 0))
+    {
+        LE_EMERG("Failed to sync config tree store (%m).");
+        writerPtr->result = LE_IO_ERROR;
+    }
+
+    return writerPtr->result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Close a tree's journal, if it's open.
+ */
+// -------------------------------------------------------------------------------------------------
+static void CloseJournal
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree to close the journal of.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (treeRef->journalFd >= 0)
+    {
+        close(treeRef->journalFd);
+        treeRef->journalFd = -1;
+    }
+
+    treeRef->journalSize = 0;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Get the generation number of the snapshot that replaces one of the given generation.
+ */
+// -------------------------------------------------------------------------------------------------
+static uint32_t NextGeneration
+(
+    uint32_t generation  ///< [IN] Generation of the snapshot being replaced.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    generation++;
+
+    // Generation 0 means "no snapshot".
+    if (generation == 0)
+    {
+        generation = 1;
+    }
+
+    return generation;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Keep a tree's current snapshot, and the journal that goes with it, as the previous snapshot and
+ *  journal, before the snapshot is replaced.  They are hard linked, so the current files stay in
+ *  place until the new snapshot is renamed over them.  LoadTree() falls back to them if the new
+ *  snapshot can't be read back.
+ *
+ *  This is best effort, failing to keep them doesn't stop the new snapshot from being written.
+ */
+// -------------------------------------------------------------------------------------------------
+static void KeepPreviousSnapshot
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree whose snapshot is about to be replaced.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    static const char* extensions[][2] =
+        {
+            { CFG_TREE_SNAPSHOT_EXT, CFG_TREE_SNAPSHOT_PREV_EXT },
+            { CFG_TREE_JOURNAL_EXT,  CFG_TREE_JOURNAL_PREV_EXT }
+        };
+    char paths[NUM_ARRAY_MEMBERS(extensions)][2][LE_CFG_STR_LEN_BYTES];
+    size_t i;
+
+    // Drop the old pair first, so a snapshot is never paired with a journal it doesn't go with.
+    for (i = 0; i < NUM_ARRAY_MEMBERS(extensions); i++)
+    {
+        GetStorePath(treeRef->name, extensions[i][0], paths[i][0], sizeof(paths[i][0]));
+        GetStorePath(treeRef->name, extensions[i][1], paths[i][1], sizeof(paths[i][1]));
+
+        if (   (unlink(paths[i][1]) != 0)
+            && (errno != ENOENT))
+        {
+            LE_ERROR("File delete failure, '%s', reason '%m'.", paths[i][1]);
+            return;
+        }
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(extensions); i++)
+    {
+        if (   (link(paths[i][0], paths[i][1]) != 0)
+            && (errno != ENOENT))
+        {
+            LE_WARN("Could not keep previous configuration tree file '%s' (%m).", paths[i][0]);
+        }
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Start a new, empty, journal for the tree's current snapshot generation.
+ *
+ *  @return LE_OK if successful, LE_IO_ERROR if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ResetJournal
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree to reset the journal of.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    StoreWriter_t writer = { .fd = treeRef->journalFd, .result = LE_OK };
+    uint8_t header[JOURNAL_HEADER_SIZE];
+
+    if (writer.fd < 0)
+    {
+        char path[LE_CFG_STR_LEN_BYTES] = "";
+
+        GetStorePath(treeRef->name, CFG_TREE_JOURNAL_EXT, path, sizeof(path));
+        writer.fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+
+        if (writer.fd < 0)
+        {
+            LE_EMERG("Failed to open config journal '%s' (%m).", path);
+            return LE_IO_ERROR;
+        }
+
+        treeRef->journalFd = writer.fd;
+    }
+
+    treeRef->journalSize = 0;
+
+    if (ftruncate(writer.fd, 0) != 0)
+    {
+        LE_EMERG("Failed to truncate config journal (%m).");
+        return LE_IO_ERROR;
+    }
+
+    PutStoreU32(header, JOURNAL_MAGIC);
+    PutStoreU32(header + 4, STORE_VERSION);
+    PutStoreU32(header + 8, treeRef->generation);
+    WriteStore(&writer, header, sizeof(header));
+
+    if (SyncStore(&writer) == LE_OK)
+    {
+        treeRef->journalSize = JOURNAL_HEADER_SIZE;
+    }
+
+    return writer.result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a complete binary snapshot of a tree, and start a new journal for it.
+ *
+ *  The snapshot is written to a temporary file that is then renamed over the old one, so either
+ *  the old or the new snapshot survives a crash.  The new snapshot has a new generation number,
+ *  which causes the old journal to be ignored even if resetting the journal doesn't complete.
+ *
+ *  If the old snapshot is known to be good, it's kept along with it's journal as the previous
+ *  snapshot, see KeepPreviousSnapshot().  The new journal is then a new file, so the previous
+ *  journal isn't truncated through the link.
+ *
+ *  @return LE_OK if successful, LE_IO_ERROR if not.  LE_NOT_PERMITTED if the config tree is stored
+ *          on a read-only filesystem.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t WriteSnapshot
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree to snapshot.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    char tempPath[LE_CFG_STR_LEN_BYTES] = "";
+    char path[LE_CFG_STR_LEN_BYTES] = "";
+    uint8_t header[SNAPSHOT_HEADER_SIZE] = { 0 };
+    StoreWriter_t writer = { .result = LE_OK };
+    uint32_t generation = NextGeneration(treeRef->generation);
+
+    GetStorePath(treeRef->name, CFG_TREE_SNAPSHOT_TEMP_EXT, tempPath, sizeof(tempPath));
+    GetStorePath(treeRef->name, CFG_TREE_SNAPSHOT_EXT, path, sizeof(path));
+
+    writer.fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+
+    if (writer.fd < 0)
+    {
+        if (errno == EROFS)
+        {
+            return LE_NOT_PERMITTED;
+        }
+
+        LE_EMERG("Failed to open config snapshot '%s' (%m).", tempPath);
+        return LE_IO_ERROR;
+    }
+
+    // Leave room for the header, which can only be filled in once the payload is known.
+    writer.offset = SNAPSHOT_HEADER_SIZE;
+    writer.crc = LE_CRC_START_CRC32;
+
+    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
+    EncodeNode(&writer, treeRef->rootNodeRef, stringBuffer);
+    le_mem_Release(stringBuffer);
+
+    PutStoreU32(header, SNAPSHOT_MAGIC);
+    PutStoreU32(header + 4, STORE_VERSION);
+    PutStoreU32(header + 8, generation);
+    PutStoreU32(header + 12, (uint32_t)writer.size);
+    PutStoreU32(header + 16, writer.crc);
+
+    if (FlushStore(&writer) == LE_OK)
+    {
+        writer.offset = 0;
+        memcpy(writer.buffer, header, sizeof(header));
+        writer.used = sizeof(header);
+
+        if (   (FlushStore(&writer) == LE_OK)
+            && (fsync(writer.fd) != 0))
+        {
+            LE_EMERG("Failed to sync config snapshot '%s' (%m).", tempPath);
+            writer.result = LE_IO_ERROR;
+        }
+    }
+
+    if (close(writer.fd) != 0)
+    {
+        LE_EMERG("An error occurred while closing the snapshot file: %s", LE_ERRNO_TXT(errno));
+        writer.result = LE_IO_ERROR;
+    }
+
+    if (   (writer.result == LE_OK)
+        && (treeRef->hasGoodSnapshot))
+    {
+        KeepPreviousSnapshot(treeRef);
+    }
+
+    if (   (writer.result == LE_OK)
+        && (rename(tempPath, path) != 0))
+    {
+        LE_EMERG("Failed to rename config snapshot '%s' (%m).", tempPath);
+        writer.result = LE_IO_ERROR;
+    }
+
+    if (writer.result != LE_OK)
+    {
+        DeleteTreeFile(tempPath);
+        return writer.result;
+    }
+
+    // Make sure the rename itself is durable before the journal it replaces is dropped.
+    int dirFd = open(CFG_TREE_PATH, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (dirFd >= 0)
+    {
+        fsync(dirFd);
+        close(dirFd);
+    }
+
+    treeRef->generation = generation;
+    treeRef->hasGoodSnapshot = true;
+
+    // The old journal may be linked as the previous one, so start a new file instead of truncating
+    // it.
+    char journalPath[LE_CFG_STR_LEN_BYTES] = "";
+    GetStorePath(treeRef->name, CFG_TREE_JOURNAL_EXT, journalPath, sizeof(journalPath));
+
+    CloseJournal(treeRef);
+
+    if (   (unlink(journalPath) != 0)
+        && (errno != ENOENT))
+    {
+        LE_ERROR("File delete failure, '%s', reason '%m'.", journalPath);
+    }
+
+    return ResetJournal(treeRef);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write the journal operations for the changes in a shadow tree that is being merged.
+ *
+ *  Only the topmost changed node of each modified branch is recorded, as a "replace" of the whole
+ *  branch with it's merged contents.  Nodes that were deleted or renamed are recorded as a "delete"
+ *  of their original path.  All deletes are written before any replace, so the replaces win when
+ *  a node is renamed and a new node is created under the old name.
+ *
+ *  This function is called twice for a merge.  Once before it, to record the deletes while the
+ *  original paths still exist, and once after it to record the replaces with the merged values.
+ */
+// -------------------------------------------------------------------------------------------------
+static void JournalChanges
+(
+    StoreWriter_t* writerPtr,  ///< [IN] The writer for the journal record.
+    tdb_NodeRef_t nodeRef,     ///< [IN] The shadow node to check.
+    bool isMerged,             ///< [IN] Has the shadow tree been merged yet?
+    char* stringBuffer         ///< [IN] Scratch buffer of TDB_MAX_ENCODED_SIZE bytes.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (writerPtr->result != LE_OK)
+    {
+        return;
+    }
+
+    if (   (IsModified(nodeRef) == false)
+        && (IsDeleted(nodeRef) == false)
+        && ((nodeRef->flags & NODE_IS_REORDERED) == 0))
+    {
+        // Only look at the shadow nodes that already exist.  The ones that haven't been created
+        // yet can't have been modified.
+        if (nodeRef->type == LE_CFG_TYPE_STEM)
+        {
+            le_dls_Link_t* linkPtr = le_dls_Peek(&nodeRef->info.children);
+
+            while (linkPtr != NULL)
+            {
+                JournalChanges(writerPtr,
+                               CONTAINER_OF(linkPtr, Node_t, siblingList),
+                               isMerged,
+                               stringBuffer);
+                linkPtr = le_dls_PeekNext(&nodeRef->info.children, linkPtr);
+            }
+        }
+
+        return;
+    }
+
+    uint8_t op;
+    tdb_NodeRef_t originalRef = nodeRef->shadowRef;
+
+    if (isMerged == false)
+    {
+        if (   (originalRef == NULL)
+            || ((IsDeleted(nodeRef) == false) && (WasRenamed(nodeRef) == false)))
+        {
+            return;
+        }
+
+        // A rename keeps the node's place amongst its siblings, which a delete followed by a
+        // replace would not.  So have the second pass record the whole parent instead.
+        if (   (IsDeleted(nodeRef) == false)
+            && (nodeRef->parentRef != NULL))
+        {
+            nodeRef->parentRef->flags |= NODE_IS_REORDERED;
+            return;
+        }
+
+        op = JOURNAL_OP_DELETE;
+    }
+    else
+    {
+        if (   (originalRef == NULL)
+            || (IsDeleted(nodeRef)))
+        {
+            return;
+        }
+
+        op = JOURNAL_OP_REPLACE;
+    }
+
+    char path[LE_CFG_STR_LEN_BYTES];
+    size_t pathLength;
+
+    if (GetStoreNodePath(originalRef, path, sizeof(path), &pathLength) != LE_OK)
+    {
+        LE_EMERG("Config node path too long for the journal.");
+        writerPtr->result = LE_OVERFLOW;
+        return;
+    }
+
+    WriteStore(writerPtr, &op, 1);
+    WriteStoreString(writerPtr, path, pathLength, 2);
+
+    if (op == JOURNAL_OP_REPLACE)
+    {
+        EncodeNode(writerPtr, originalRef, stringBuffer);
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Rewrite a tree's snapshot, folding in it's journal.  This is queued to run from the event loop
+ *  once the journal has grown past LE_CONFIG_CFGTREE_JOURNAL_COMPACT_SIZE, so that it happens after
+ *  the reply to the commit that triggered it has been sent.
+ */
+// -------------------------------------------------------------------------------------------------
+static void CompactTree
+(
+    void* param1Ptr,  ///< [IN] The tree to compact.  A reference is held on it.
+    void* param2Ptr   ///< [IN] Unused.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    tdb_TreeRef_t treeRef = param1Ptr;
+
+    treeRef->isCompactPending = false;
+
+    // Make sure the tree wasn't deleted in the meantime.
+    if (le_hashmap_Get(TreeCollectionRef, treeRef->name) == treeRef)
+    {
+        LE_DEBUG("Compacting configuration tree '%s', journal size %" PRIuS ".",
+                 treeRef->name,
+                 treeRef->journalSize);
+
+        if (WriteSnapshot(treeRef) != LE_OK)
+        {
+            LE_ERROR("Failed to compact configuration tree '%s'.", treeRef->name);
+        }
+    }
+
+    le_mem_Release(treeRef);
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Start a journal record for a commit.  The record header is filled in by EndJournalRecord().
+ */
+// -------------------------------------------------------------------------------------------------
+static void StartJournalRecord
+(
+    tdb_TreeRef_t treeRef,    ///< [IN] The tree being committed.
+    StoreWriter_t* writerPtr  ///< [IN] The writer to initialize.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    memset(writerPtr, 0, offsetof(StoreWriter_t, buffer));
+
+    writerPtr->fd = treeRef->journalFd;
+    writerPtr->offset = treeRef->journalSize + RECORD_HEADER_SIZE;
+    writerPtr->crc = LE_CRC_START_CRC32;
+    writerPtr->result = LE_OK;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Complete a journal record and sync it to storage.  Once this returns successfully, the commit is
+ *  durable.
+ *
+ *  @return LE_OK if successful, LE_IO_ERROR if not.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t EndJournalRecord
+(
+    tdb_TreeRef_t treeRef,    ///< [IN] The tree being committed.
+    StoreWriter_t* writerPtr  ///< [IN] The writer holding the record.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    uint8_t header[RECORD_HEADER_SIZE];
+    uint32_t recordSize = (uint32_t)writerPtr->size;
+
+    // Nothing was changed.
+    if (   (writerPtr->result == LE_OK)
+        && (recordSize == 0))
+    {
+        return LE_OK;
+    }
+
+    PutStoreU32(header, recordSize);
+    PutStoreU32(header + 4, writerPtr->crc);
+
+    if (FlushStore(writerPtr) == LE_OK)
+    {
+        writerPtr->offset = treeRef->journalSize;
+        memcpy(writerPtr->buffer, header, sizeof(header));
+        writerPtr->used = sizeof(header);
+    }
+
+    if (SyncStore(writerPtr) == LE_OK)
+    {
+        treeRef->journalSize += RECORD_HEADER_SIZE + recordSize;
+    }
+    else if (ftruncate(writerPtr->fd, treeRef->journalSize) != 0)
+    {
+        LE_ERROR("Failed to drop partial journal record (%m).");
+    }
+
+    return writerPtr->result;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Delete all of the binary store files of a tree.
+ */
+// -------------------------------------------------------------------------------------------------
+static void DeleteStoreFiles
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree being deleted.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    static const char* extensions[] =
+        {
+            CFG_TREE_SNAPSHOT_EXT,
+            CFG_TREE_JOURNAL_EXT,
+            CFG_TREE_SNAPSHOT_TEMP_EXT,
+            CFG_TREE_SNAPSHOT_PREV_EXT,
+            CFG_TREE_JOURNAL_PREV_EXT
+        };
+    size_t i;
+
+    CloseJournal(treeRef);
+
+    treeRef->generation = 0;
+    treeRef->hasGoodSnapshot = false;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(extensions); i++)
+    {
+        char path[LE_CFG_STR_LEN_BYTES] = "";
+        GetStorePath(treeRef->name, extensions[i], path, sizeof(path));
+
+        if (   (path[0] != '\0')
+            && (unlink(path) != 0)
+            && (errno != ENOENT))
+        {
+            LE_ERROR("File delete failure, '%s', reason '%m'.", path);
+        }
+    }
+}
+#endif /* end LE_CONFIG_CFGTREE_JOURNAL */
+
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Attempt to load a configuration tree from a config file.  This function will look for the latest
+ *  valid version of the config file and load that one.
+ */
+// -------------------------------------------------------------------------------------------------
+static void LoadTree
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree object to load from the filesystem.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_clk_Time_t loadTime;
+
+#if LE_CONFIG_CFGTREE_JOURNAL
+    // Prefer the binary snapshot and journal.  The text files are only used if the tree hasn't
+    // been committed since the binary store was introduced.
+    if (treeRef->rootNodeRef == NULL)
+    {
+        treeRef->rootNodeRef = NewNode();
+    }
+
+    tdb_EnsureExists(treeRef->rootNodeRef);
+
+    le_result_t result = LoadSnapshot(treeRef, CFG_TREE_SNAPSHOT_EXT);
+
+    if (result == LE_OK)
+    {
+        treeRef->hasGoodSnapshot = true;
+        ReplayJournal(treeRef, CFG_TREE_JOURNAL_EXT);
+
+        loadTime = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+        LE_DEBUG("** Loaded configuration tree '%s' from snapshot in %" PRIu64 " us.",
+                 treeRef->name,
+                 (uint64_t)loadTime.sec * 1000000 + loadTime.usec);
+        return;
+    }
+
+    if (result == LE_FORMAT_ERROR)
+    {
+        le_mem_Release(treeRef->rootNodeRef);
+        treeRef->rootNodeRef = NewNode();
+    }
+
+    // The snapshot is corrupt, or the system went down while it was being replaced.  Rebuild the
+    // tree from the previous snapshot and the journal it was kept with, which together hold what
+    // the current snapshot was written from, then replay the current journal on top of that.
+    // Nothing is deleted here.  A snapshot that didn't load isn't kept as the previous one when it's
+    // replaced, so the previous snapshot stays in place until a good one has been written.
+    le_result_t prevResult = LoadSnapshot(treeRef, CFG_TREE_SNAPSHOT_PREV_EXT);
+
+    if (prevResult == LE_OK)
+    {
+        ReplayJournal(treeRef, CFG_TREE_JOURNAL_PREV_EXT);
+        CloseJournal(treeRef);
+
+        treeRef->generation = NextGeneration(treeRef->generation);
+        ReplayJournal(treeRef, CFG_TREE_JOURNAL_EXT);
+
+        LE_WARN_IF(result == LE_FORMAT_ERROR,
+                   "Configuration tree '%s' recovered from it's previous snapshot.",
+                   treeRef->name);
+        return;
+    }
+
+    if (prevResult == LE_FORMAT_ERROR)
+    {
+        le_mem_Release(treeRef->rootNodeRef);
+        treeRef->rootNodeRef = NewNode();
+    }
+
+    treeRef->generation = 0;
+
+    LE_CRIT_IF(result == LE_FORMAT_ERROR,
+               "No usable snapshot of configuration tree '%s', falling back to it's text files.",
+               treeRef->name);
+#endif
+
+    // If we don't know the revision then hunt it out from the filesystem.
+    if (treeRef->revisionId == 0)
+    {
+        UpdateRevision(treeRef);
+    }
+
+    // If this tree has no root, create it now.
+    if (treeRef->rootNodeRef == NULL)
+    {
+        treeRef->rootNodeRef = NewNode();
+    }
+
+    // Ok, if we found a valid revision of the tree in the fs, try to load it now.
+    if (treeRef->revisionId != 0)
+    {
+        char pathPtr[LE_CFG_STR_LEN_BYTES] = "";
+        GetTreePath(treeRef->name, treeRef->revisionId, pathPtr, sizeof(pathPtr));
+
+        LE_DEBUG("** Loading configuration tree from '%s'.", pathPtr);
+
+        FILE* fileRef;
+
+        fileRef = fopen(pathPtr, "r");
+
+        tdb_EnsureExists(treeRef->rootNodeRef);
+
+        if (!fileRef)
+        {
+            LE_ERROR("Could not open configuration tree file: %s, reason: %s",
+                     pathPtr,
+                     LE_ERRNO_TXT(errno));
+        }
+        else
+        {
+            if (tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) == false)
+            {
+                LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
+                le_mem_Release(treeRef->rootNodeRef);
+                treeRef->rootNodeRef = NewNode();
+            }
+
+            fclose(fileRef);
+        }
+
+        loadTime = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+        LE_DEBUG("** Loaded configuration tree '%s' from text in %" PRIu64 " us.",
+                 treeRef->name,
+                 (uint64_t)loadTime.sec * 1000000 + loadTime.usec);
+    }
+}
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Removes the handler object from the given registration object.  This function will also free the
+ *  memory that the handler object had used.
+ */
+// -------------------------------------------------------------------------------------------------
+static void RemoveHandler
+(
+    Registration_t* registrationPtr,  ///< [IN] The registration object to remove the link from.
+    Handler_t* handlerPtr             ///< [IN] The handler object we're removing.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Kill the ref, and remove the object from the registration list.
+    le_ref_DeleteRef(HandlerSafeRefMap, handlerPtr->safeRef);
+    le_dls_Remove(&registrationPtr->handlerList, &handlerPtr->link);
 
     // Clear out the link data, just to be safe.
     handlerPtr->link = LE_DLS_LINK_INIT;
@@ -2682,28 +4539,6 @@ static bool OnHandlerRegistrationCleanup
 
 
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Call this function to delete a tree file from the filesystem.
- */
-// -------------------------------------------------------------------------------------------------
-static void DeleteTreeFile
-(
-    const char* filePathPtr  ///< Path to the tree file in question.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
-
-    if (unlink(filePathPtr) != 0)
-    {
-        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
-    }
-}
-
-
-
-
 // -------------------------------------------------------------------------------------------------
 /**
  *  Find the root node represented by the path ref.
@@ -2754,6 +4589,12 @@ void tdb_Init
     le_mem_SetDestructor(NodePoolRef, NodeDestructor);
     le_mem_SetNumObjsToForce(NodePoolRef, 50);    // Grow in chunks of 50 blocks.
 
+#if LE_CONFIG_CFGTREE_CHILD_INDEX
+    ChildIndexPoolRef = le_mem_InitStaticPool(childIndexPool,
+                                              LE_CONFIG_CFGTREE_MAX_CHILD_INDEX_POOL_SIZE,
+                                              sizeof(ChildIndex_t));
+#endif
+
     TreePoolRef = le_mem_InitStaticPool(treePool, LE_CONFIG_CFGTREE_MAX_TREE_POOL_SIZE,
                                         sizeof(Tree_t));
     le_mem_SetDestructor(TreePoolRef, TreeDestructor);
@@ -2860,6 +4701,10 @@ void tdb_DeleteTree
             }
         }
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+        DeleteStoreFiles(treeRef);
+#endif
+
         LE_ASSERT(le_hashmap_Remove(TreeCollectionRef, treeRef->name) == treeRef);
         le_mem_Release(treeRef);
     }
@@ -3135,12 +4980,87 @@ void tdb_MergeTree
     tdb_NodeRef_t nodeRef = shadowTreeRef->rootNodeRef;
     le_pathIter_Ref_t pathRef = CreateBasePath(shadowTreeRef->originalTreeRef->name);
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+    // If the tree has a snapshot, the changes are appended to it's journal.  The paths of deleted
+    // and renamed nodes have to be recorded before the merge removes them from the original tree.
+    tdb_TreeRef_t treeRef = shadowTreeRef->originalTreeRef;
+    char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
+    bool isJournaled = (treeRef->generation != 0) && (treeRef->journalFd >= 0);
+    StoreWriter_t writer;
+
+    if (isJournaled)
+    {
+        StartJournalRecord(treeRef, &writer);
+        JournalChanges(&writer, nodeRef, false, stringBuffer);
+    }
+#endif
+
     InternalMergeTree(shadowTreeRef->originalTreeRef->name, pathRef, nodeRef, false);
     le_pathIter_Delete(pathRef);
 
     // Now, go through and call the triggered callbacks.
     FireTriggeredCallbacks();
 
+#if LE_CONFIG_CFGTREE_JOURNAL
+    if (isJournaled)
+    {
+        JournalChanges(&writer, nodeRef, true, stringBuffer);
+    }
+
+    le_mem_Release(stringBuffer);
+
+    if (isJournaled)
+    {
+        if (EndJournalRecord(treeRef, &writer) == LE_OK)
+        {
+            // Once the journal gets too big, fold it into a new snapshot.  This is done later from
+            // the event loop so this commit isn't held up by it.
+            if (   (treeRef->journalSize >= LE_CONFIG_CFGTREE_JOURNAL_COMPACT_SIZE)
+                && (treeRef->isCompactPending == false))
+            {
+                treeRef->isCompactPending = true;
+                le_mem_AddRef(treeRef);
+                le_event_QueueFunction(CompactTree, treeRef, NULL);
+            }
+
+            return;
+        }
+
+        LE_WARN("Failed to journal changes to '%s', writing a new snapshot instead.",
+                treeRef->name);
+    }
+
+    le_result_t result = WriteSnapshot(treeRef);
+
+    if (result == LE_NOT_PERMITTED)
+    {
+        // In case we are R/O for the config tree, we discard the update to flash
+        return;
+    }
+
+    if (result != LE_OK)
+    {
+        LE_EMERG("Changes have been merged in memory, however they could not be committed to the "
+                 "filesystem!!");
+        return;
+    }
+
+    // The tree is now stored in binary form, so drop any text versions of it.
+    int id;
+
+    for (id = 1; id <= 3; id++)
+    {
+        if (TreeFileExists(treeRef->name, id))
+        {
+            char filePath[LE_CFG_STR_LEN_BYTES] = "";
+            GetTreePath(treeRef->name, id, filePath, sizeof(filePath));
+
+            DeleteTreeFile(filePath);
+        }
+    }
+
+    treeRef->revisionId = 0;
+#else
     // Now increment revision of the tree and open a tree file for writing.
     tdb_TreeRef_t originalTreeRef = shadowTreeRef->originalTreeRef;
     int oldId = originalTreeRef->revisionId;
@@ -3193,6 +5113,7 @@ void tdb_MergeTree
         LE_EMERG("The attempt to write to the config tree file, '%s,' failed.", filePath);
         DeleteTreeFile(filePath);
     }
+#endif /* end LE_CONFIG_CFGTREE_JOURNAL */
 }
 
 
@@ -3561,6 +5482,8 @@ le_result_t tdb_SetNodeName
 
     // Copy over the new name.  Note that we don't care if this node is a shadow node.  Coping over
     // the name is taken care of as part of the merge process.
+    UnindexChild(nodeRef);
+
     if (nodeRef->nameRef == NULL)
     {
         nodeRef->nameRef = dstr_NewFromCstr(stringPtr);
@@ -3571,6 +5494,8 @@ le_result_t tdb_SetNodeName
     }
     nodeRef->nameHash = le_hashmap_HashString(stringPtr);
 
+    IndexChild(nodeRef);
+
     // If this is a shadow node and this is the change that modified it, then try to get it's
     // children now.  This is done so that later when this node is merged the merge code doesn't end
     // up thinking that the child nodes where removed.
@@ -3696,6 +5621,8 @@ void tdb_SetEmpty
     // If this is a stem node, then go through and clear out the children.
     if (nodeRef->type == LE_CFG_TYPE_STEM)
     {
+        DropChildIndex(nodeRef);
+
         tdb_NodeRef_t childRef = tdb_GetFirstChildNode(nodeRef);
 
         while (childRef != NULL)
@@ -238,6 +238,42 @@ static bool IsRegularFile
     return false;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Check whether a file name extension is the one of a file a tree can be loaded from, one of the
+ *  text revisions or the current or previous binary snapshot.  The journals and the temporary
+ *  snapshot are never found without a tree file they belong to.
+ *
+ *  @return
+ *       True if the tree can be loaded from a file with this extension.
+ *       False otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsTreeFileExt
+(
+    const char* extPtr  ///< [IN] The extension, without the dot.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    static const char* extensions[] =
+        {
+            CFG_TREE_TEXT_EXTS,
+            CFG_TREE_SNAPSHOT_EXT,
+            CFG_TREE_SNAPSHOT_PREV_EXT
+        };
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(extensions); i++)
+    {
+        if (strcmp(extPtr, extensions[i]) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Search the file system and find all of the tree files stored there.  This function will not
@@ -277,9 +313,7 @@ static void FindFileTrees
                return;
             }
 
-            if (   (strcmp(dotStrPtr, ".rock") != 0)
-                && (strcmp(dotStrPtr, ".paper") != 0)
-                && (strcmp(dotStrPtr, ".scissors") != 0))
+            if (!IsTreeFileExt(dotStrPtr + 1))
             {
                 continue;
             }
@@ -45,6 +45,25 @@ typedef enum
     LE_SDTP_MSGID_BIND,             ///< Create one binding.  The payload is the binding details.
                                     ///  If the Service Directory runs into an error, it will
                                     ///  drop the connection to the sdir tool without responding.
+                                    ///  Need not be a request: during a load, bindings are sent
+                                    ///  without waiting for each to be acknowledged.
+
+    LE_SDTP_MSGID_LOAD_START,       ///< Delete all bindings and start loading a new set of
+                                    ///  bindings (This message has no payload).  Clients are not
+                                    ///  matched against the bindings created during the load
+                                    ///  until it ends.
+
+    LE_SDTP_MSGID_LOAD_END,         ///< End a load: match all unbound clients against the
+                                    ///  bindings, in a single pass (This message has no payload).
+                                    ///  A load also ends if the sdir tool disconnects.
+
+    LE_SDTP_MSGID_STATS,            ///< Report the session open timing statistics.
+                                    ///  Payload is a file descriptor to which output
+                                    ///  should be written.
+    LE_SDTP_MSGID_FIRST_ADVERTISE,  ///< Get the time the user @c server started serving at:
+                                    ///  when it advertised a service while it had none.  The
+                                    ///  response holds it in @c firstAdvertiseMs, or 0 if the
+                                    ///  user serves no service.
 }
 le_sdtp_MsgType_t;
 
@@ -61,6 +80,8 @@ typedef struct
     uid_t server;               ///< Unix user ID of the server.
     char clientInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES]; ///< Client's interface name.
     char serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES]; ///< Server's interface name.
+    uint64_t firstAdvertiseMs;  ///< Relative time (le_clk_GetRelativeTime()) the server
+                                ///  started serving at, in milliseconds.
 }
 le_sdtp_Msg_t;
 
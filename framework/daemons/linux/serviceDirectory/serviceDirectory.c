@@ -9,6 +9,7 @@
  * @ref sd_deathDetection <br>
  * @ref sd_threading <br>
  * @ref sd_startUpSync <br>
+ * @ref sd_openStats <br>
  * @ref sd_DesignNotes <br>
  *
  * @section sd_intro        Introduction
@@ -89,6 +90,10 @@ User List ------> User --+---> Name               |        |        |
  * Client Connection objects and Server Connection objects are created when clients and servers
  * connect to the Service Directory.
  *
+ * Bindings are also indexed in the Binding Table, and advertised services in the Service Table,
+ * both keyed by user ID and interface name, so that opening a session costs a couple of hash
+ * lookups however many users, bindings and services there are.
+ *
  * Client Connection objects are deleted when the client disconnects or its connection is passed
  * to a server.
  *
@@ -166,6 +171,17 @@ User List ------> User --+---> Name               |        |        |
  *    ready to talk to service clients and servers), the Service Directory closes fd 0 and reopens
  *    it to "/dev/null".
  *
+ * @section sd_openStats           Session Open Statistics
+ *
+ * The time spent in each phase of opening a session is accumulated, and reported by
+ * <c>sdir stats</c>:
+ * - request: from the client connecting to its "Open" request being received,
+ * - lookup: finding the binding of the client interface,
+ * - access: granting the client and server access to each other (SMACK labels),
+ * - dispatch: handing the client connection over to the server,
+ * - total: from the client connecting to the connection being handed over, including any time
+ *   spent waiting for a binding or a server.
+ *
  * @section sd_DesignNotes          Design Notes
  *
  * @subsection sd_DesignNotesConfig     Binding Configuration
@@ -187,6 +203,10 @@ User List ------> User --+---> Name               |        |        |
  * So, instead, we created the "sdir load" tool and made the Supervisor run it before starting
  * any applications and made the installer run it after installing/removing any apps.
  *
+ * "sdir load" sends all the bindings in one batch, between a "load start" and a "load end"
+ * message, without waiting for each to be acknowledged.  Clients left unbound are matched against
+ * the new bindings once, when the load ends, rather than each time a binding is created.
+ *
  * @subsection sd_DesignNotesLateBind   Late Binding Updates
  *
  * Note that bindings can be updated after the client and/or server have already been started.
@@ -222,6 +242,19 @@ User List ------> User --+---> Name               |        |        |
 #define MAX_CONNECT_REQUEST_BACKLOG 100
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key of the Binding Table and Service Table: a user ID and an interface name.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uid_t   uid;                                        ///< Unix user ID.
+    char    name[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES];   ///< Interface name.
+}
+InterfaceKey_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a user.  Objects of this type are allocated from the User Pool and are kept on the
@@ -236,6 +269,8 @@ typedef struct
     le_dls_List_t   bindingList;        ///< List of bindings of user's client i/fs to services.
     le_dls_List_t   serviceList;        ///< List of services served up by this user.
     le_dls_List_t   unboundClientsList; ///< List of Client Connections waiting to be bound.
+    le_clk_Time_t   firstAdvertiseTime; ///< When the user advertised a service while it had none
+                                        ///  (relative time).  Valid if serviceList is not empty.
 }
 User_t;
 
@@ -267,6 +302,7 @@ typedef struct
     User_t*                     userPtr;        ///< Pointer to the User object for the client uid.
     pid_t                       pid;            ///< Process ID of client process.
     svcdir_InterfaceDetails_t   interface;      ///< IPC interface details.
+    InterfaceKey_t              key;            ///< Key in the Service Table, once advertised.
 }
 ServerConnection_t;
 
@@ -292,6 +328,7 @@ typedef struct
     char                serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES];///< Service name
     ServerConnection_t* serverConnectionPtr;///< Ptr to Server Connection (NULL if service unavail.)
     le_dls_List_t       waitingClientsList; ///< List of Client Connections waiting for the service.
+    InterfaceKey_t      key;                ///< Key in the Binding Table (client uid and i/f name).
 }
 Binding_t;
 
@@ -332,6 +369,8 @@ typedef struct
     pid_t                   pid;            ///< Process ID of client process.
     svcdir_InterfaceDetails_t interface;    ///< Interface details (protocol & interface name)
     Binding_t*              bindingPtr;     ///< Ptr to Binding whose Waiting Clients List we are on
+    le_clk_Time_t           connectTime;    ///< When the client connected (relative time).
+    bool                    waitCounted;    ///< Already counted in WaitingOpenCount.
 }
 ClientConnection_t;
 
@@ -342,6 +381,95 @@ ClientConnection_t;
 static le_mem_PoolRef_t ClientConnectionPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/// Binding Table: Binding objects, keyed by client user ID and client interface name.
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t BindingTable;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Service Table: advertised services' Server Connection objects, keyed by server user ID and
+/// service name.
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ServiceTable;
+
+
+//--------------------------------------------------------------------------------------------------
+/// IPC session of the 'sdir' tool that is loading bindings, or NULL if no load is in progress.
+//--------------------------------------------------------------------------------------------------
+static le_msg_SessionRef_t LoadSessionRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Phases of opening a session, timed separately.  See @ref sd_openStats.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    OPEN_PHASE_REQUEST,     ///< Client connected -> "Open" request received.
+    OPEN_PHASE_LOOKUP,      ///< Binding look-up.
+    OPEN_PHASE_ACCESS,      ///< Access granted.
+    OPEN_PHASE_DISPATCH,    ///< Client connection handed over to the server.
+    OPEN_PHASE_TOTAL,       ///< Client connected -> handed over to the server.
+    OPEN_PHASE_COUNT
+}
+OpenPhase_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timing statistics of one phase of opening a session.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* name;       ///< Name of the phase.
+    uint64_t    count;      ///< Number of times the phase was timed.
+    uint64_t    totalUsec;  ///< Total time spent in the phase, in microseconds.
+    uint64_t    maxUsec;    ///< Longest time spent in the phase, in microseconds.
+}
+OpenPhaseStats_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Timing statistics of each phase of opening a session.
+//--------------------------------------------------------------------------------------------------
+static OpenPhaseStats_t OpenPhaseStats[OPEN_PHASE_COUNT] =
+{
+    [OPEN_PHASE_REQUEST]  = { .name = "request" },
+    [OPEN_PHASE_LOOKUP]   = { .name = "lookup" },
+    [OPEN_PHASE_ACCESS]   = { .name = "access" },
+    [OPEN_PHASE_DISPATCH] = { .name = "dispatch" },
+    [OPEN_PHASE_TOTAL]    = { .name = "total" },
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/// Number of "Open" requests that had to wait for a binding or a server.
+//--------------------------------------------------------------------------------------------------
+static uint64_t WaitingOpenCount;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Counts a client connection's "Open" request as waiting, once however many times it has to wait
+ * (e.g., first for a binding, then for the server).
+ */
+//--------------------------------------------------------------------------------------------------
+static void CountWaitingOpen
+(
+    ClientConnection_t* clientConnectionPtr
+)
+{
+    if (!clientConnectionPtr->waitCounted)
+    {
+        clientConnectionPtr->waitCounted = true;
+        WaitingOpenCount++;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /// File descriptor for the Client Socket (which IPC clients connect to).
 //--------------------------------------------------------------------------------------------------
@@ -372,6 +500,96 @@ static le_fdMonitor_Ref_t ServerSocketMonitorRef;
 // =======================================
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hashes a Binding Table or Service Table key.
+ *
+ * @return The hash value.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t HashInterfaceKey
+(
+    const void* keyPtr  ///< [in] Pointer to the key.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* interfaceKeyPtr = keyPtr;
+
+    return le_hashmap_HashString(interfaceKeyPtr->name) ^
+           ((size_t)interfaceKeyPtr->uid * 2654435761U);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compares two Binding Table or Service Table keys.
+ *
+ * @return true if the keys are equal.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool EqualsInterfaceKey
+(
+    const void* firstKeyPtr,    ///< [in] Pointer to the first key.
+    const void* secondKeyPtr    ///< [in] Pointer to the second key.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* firstPtr = firstKeyPtr;
+    const InterfaceKey_t* secondPtr = secondKeyPtr;
+
+    return (firstPtr->uid == secondPtr->uid) && (strcmp(firstPtr->name, secondPtr->name) == 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fills in a Binding Table or Service Table key.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void SetInterfaceKey
+(
+    InterfaceKey_t* keyPtr,     ///< [out] Key to fill in.
+    uid_t uid,                  ///< [in] Unix user ID.
+    const char* interfaceName   ///< [in] Interface name.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    memset(keyPtr, 0, sizeof(*keyPtr));
+    keyPtr->uid = uid;
+    le_utf8_Copy(keyPtr->name, interfaceName, sizeof(keyPtr->name), NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds the time elapsed since a given time to the statistics of a phase of opening a session.
+ *
+ * @return The current relative time, to be used as the start time of the next phase.
+ **/
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t RecordOpenPhase
+(
+    OpenPhase_t phase,          ///< [in] Phase that ended.
+    le_clk_Time_t startTime     ///< [in] Relative time at which the phase started.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    le_clk_Time_t elapsed = le_clk_Sub(now, startTime);
+    uint64_t elapsedUsec = ((uint64_t)elapsed.sec * 1000000) + elapsed.usec;
+    OpenPhaseStats_t* statsPtr = &OpenPhaseStats[phase];
+
+    statsPtr->count++;
+    statsPtr->totalUsec += elapsedUsec;
+    if (elapsedUsec > statsPtr->maxUsec)
+    {
+        statsPtr->maxUsec = elapsedUsec;
+    }
+
+    return now;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a User object for a given Unix user ID.
@@ -400,6 +618,7 @@ static User_t* CreateUser
     userPtr->bindingList = LE_DLS_LIST_INIT;
     userPtr->serviceList = LE_DLS_LIST_INIT;
     userPtr->unboundClientsList = LE_DLS_LIST_INIT;
+    userPtr->firstAdvertiseTime = (le_clk_Time_t){ 0, 0 };
 
     // Add it to the User List.
     le_dls_Queue(&UserList, &userPtr->link);
@@ -474,21 +693,11 @@ static Binding_t* FindBinding
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->bindingList);
-
-    while (linkPtr != NULL)
-    {
-        Binding_t* bindingPtr = CONTAINER_OF(linkPtr, Binding_t, link);
+    InterfaceKey_t key;
 
-        if (strcmp(bindingPtr->clientInterfaceName, interfaceName) == 0)
-        {
-            return bindingPtr;
-        }
+    SetInterfaceKey(&key, userPtr->uid, interfaceName);
 
-        linkPtr = le_dls_PeekNext(&userPtr->bindingList, linkPtr);
-    }
-
-    return NULL;
+    return le_hashmap_Get(BindingTable, &key);
 }
 
 
@@ -611,21 +820,11 @@ static ServerConnection_t* FindService
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->serviceList);
+    InterfaceKey_t key;
 
-    while (linkPtr != NULL)
-    {
-        ServerConnection_t* serverConnectionPtr = CONTAINER_OF(linkPtr, ServerConnection_t, link);
-
-        if (strcmp(serverConnectionPtr->interface.interfaceName, serviceName) == 0)
-        {
-            return serverConnectionPtr;
-        }
+    SetInterfaceKey(&key, userPtr->uid, serviceName);
 
-        linkPtr = le_dls_PeekNext(&userPtr->serviceList, linkPtr);
-    }
-
-    return NULL;
+    return le_hashmap_Get(ServiceTable, &key);
 }
 
 
@@ -796,9 +995,11 @@ static le_result_t DispatchToServer
     else
     {
         le_result_t result = LE_OK;
+        le_clk_Time_t startTime = le_clk_GetRelativeTime();
 
         // Enable communication between client and server
         result = AllowCommunication(clientConnectionPtr, serverConnectionPtr);
+        startTime = RecordOpenPhase(OPEN_PHASE_ACCESS, startTime);
         if (result != LE_OK)
         {
             LE_ERROR("Rejecting communication between client (uid %u '%s', pid %d) and "
@@ -824,6 +1025,9 @@ static le_result_t DispatchToServer
 
         if (result == LE_OK)
         {
+            RecordOpenPhase(OPEN_PHASE_DISPATCH, startTime);
+            RecordOpenPhase(OPEN_PHASE_TOTAL, clientConnectionPtr->connectTime);
+
             LE_DEBUG("Client (uid %u '%s', pid %d) connected to server (uid %u '%s', pid %d) for "
                         "service '%s' (protocol ID = '%s').",
                      clientConnectionPtr->userPtr->uid,
@@ -889,6 +1093,8 @@ static void FollowBinding
     // client connection how it is (in the WAITING state).
     else if (shouldWait)
     {
+        CountWaitingOpen(clientConnectionPtr);
+
         LE_DEBUG("Client user %s (uid %u) pid %d interface '%s' is waiting for"
                     " server user %s (%u) to advertise service '%s'.",
                  clientConnectionPtr->userPtr->name,
@@ -994,12 +1200,20 @@ static void CreateBinding
     bindingPtr->serverConnectionPtr = NULL;
     bindingPtr->waitingClientsList = LE_DLS_LIST_INIT;
 
-    // Add the Binding to the client User's Binding List.
+    // Add the Binding to the client User's Binding List, and to the Binding Table.
     le_dls_Queue(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    SetInterfaceKey(&bindingPtr->key, clientUserId, clientInterfaceName);
+    le_hashmap_Put(BindingTable, &bindingPtr->key, bindingPtr);
 
     // Look for a server serving the binding's destination service.
     bindingPtr->serverConnectionPtr = FindService(bindingPtr->serverUserPtr, serverInterfaceName);
 
+    // While bindings are being loaded, unbound clients are matched once, when the load ends.
+    if (LoadSessionRef != NULL)
+    {
+        return;
+    }
+
     // Check for unbound client connections that match the new binding.
     le_dls_List_t* unboundClientsListPtr = &(bindingPtr->clientUserPtr->unboundClientsList);
     le_dls_Link_t* linkPtr = le_dls_Peek(unboundClientsListPtr);
@@ -1153,8 +1367,18 @@ static void ProcessAdvertisementFromServer
     // connection to the service list.
     else
     {
-        // Add the object to the User's Service List.
+        // Remember when the user started serving, so that slow app starts can be pinned down.
+        if (le_dls_IsEmpty(&connectionPtr->userPtr->serviceList))
+        {
+            connectionPtr->userPtr->firstAdvertiseTime = le_clk_GetRelativeTime();
+        }
+
+        // Add the object to the User's Service List, and to the Service Table.
         le_dls_Queue(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+        SetInterfaceKey(&connectionPtr->key,
+                        connectionPtr->userPtr->uid,
+                        connectionPtr->interface.interfaceName);
+        le_hashmap_Put(ServiceTable, &connectionPtr->key, connectionPtr);
 
         LE_DEBUG("Server (uid %u '%s', pid %d) now serving service '%s' (%s).",
                  connectionPtr->userPtr->uid,
@@ -1240,9 +1464,11 @@ static void ProcessOpenRequestFromClient
              connectionPtr->interface.interfaceName,
              connectionPtr->interface.protocolId);
 
-    // Look up the client's service name in the client User's Binding List.
+    // Look up the client's service name in the Binding Table.
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
     Binding_t* bindingPtr = FindBinding(connectionPtr->userPtr,
                                         connectionPtr->interface.interfaceName);
+    RecordOpenPhase(OPEN_PHASE_LOOKUP, startTime);
 
     // If a matching binding was found, follow it.
     if (bindingPtr != NULL)
@@ -1256,6 +1482,8 @@ static void ProcessOpenRequestFromClient
         // unbound clients.
         if (shouldWait)
         {
+            CountWaitingOpen(connectionPtr);
+
             connectionPtr->state = CLIENT_STATE_UNBOUND;
 
             le_dls_Queue(&(connectionPtr->userPtr->unboundClientsList), &(connectionPtr->link));
@@ -1321,6 +1549,8 @@ static void ClientReadHandler
     }
     else if (result == LE_OK)
     {
+        RecordOpenPhase(OPEN_PHASE_REQUEST, clientConnectionPtr->connectTime);
+
         memcpy(&(clientConnectionPtr->interface),
                &(msg.interface),
                sizeof(clientConnectionPtr->interface));
@@ -1394,6 +1624,8 @@ static void CreateClientConnection
     connectionPtr->userPtr = GetUser(uid);
     connectionPtr->pid = pid;
     connectionPtr->bindingPtr = NULL;
+    connectionPtr->connectTime = le_clk_GetRelativeTime();
+    connectionPtr->waitCounted = false;
 
     // Haven't received ID yet, so clear it out.
     memset(&connectionPtr->interface, 0, sizeof(connectionPtr->interface));
@@ -1764,6 +1996,7 @@ static void ServerConnectionDestructor
         if (le_dls_IsInList(&connectionPtr->userPtr->serviceList, &connectionPtr->link))
         {
             le_dls_Remove(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+            le_hashmap_Remove(ServiceTable, &connectionPtr->key);
         }
     }
 
@@ -1854,8 +2087,9 @@ static void BindingDestructor
 {
     Binding_t* bindingPtr = objPtr;
 
-    // Remove the Binding object from the User's Binding List.
+    // Remove the Binding object from the User's Binding List and from the Binding Table.
     le_dls_Remove(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    le_hashmap_Remove(BindingTable, &bindingPtr->key);
 
     // While the list of waiting clients is not empty, pop one off and process it.
     le_dls_Link_t* linkPtr;
@@ -2557,6 +2791,177 @@ static void SdirToolBind
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles a "Load Start" request from the 'sdir' tool: deletes all bindings and defers the
+ * matching of unbound clients until the load ends.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolLoadStart
+(
+    le_msg_SessionRef_t sessionRef  ///< [in] Session of the 'sdir' tool loading the bindings.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Re-creates the hard-coded bindings before the load starts, so that clients of the
+    // framework's own services are not held up by the load.
+    SdirToolUnbindAll();
+
+    LoadSessionRef = sessionRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ends a load of bindings: matches every unbound client against the Binding Table.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndLoad
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LoadSessionRef = NULL;
+
+    le_dls_Link_t* userLinkPtr = le_dls_Peek(&UserList);
+
+    while (userLinkPtr != NULL)
+    {
+        User_t* userPtr = CONTAINER_OF(userLinkPtr, User_t, link);
+
+        // Increment the reference count on the User object to ensure that it doesn't go away
+        // when its client connections are dispatched.
+        le_mem_AddRef(userPtr);
+
+        le_dls_Link_t* clientLinkPtr = le_dls_Peek(&userPtr->unboundClientsList);
+        while (clientLinkPtr != NULL)
+        {
+            ClientConnection_t* clientConnectionPtr = CONTAINER_OF(clientLinkPtr,
+                                                                   ClientConnection_t,
+                                                                   link);
+
+            // Move to the next node now, in case this one is removed from the list.
+            clientLinkPtr = le_dls_PeekNext(&userPtr->unboundClientsList, clientLinkPtr);
+
+            Binding_t* bindingPtr = FindBinding(userPtr,
+                                                clientConnectionPtr->interface.interfaceName);
+            if (bindingPtr != NULL)
+            {
+                le_dls_Remove(&userPtr->unboundClientsList, &clientConnectionPtr->link);
+                FollowBinding(bindingPtr, clientConnectionPtr, true /* shouldWait */ );
+            }
+        }
+
+        userLinkPtr = le_dls_PeekNext(&UserList, userLinkPtr);
+
+        le_mem_Release(userPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles the 'sdir' tool closing its IPC session.  Ends the load it was doing, if any, so that
+ * clients are not left unbound.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolCloseHandler
+(
+    le_msg_SessionRef_t sessionRef, ///< [in] Session that closed.
+    void* contextPtr                ///< [in] Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (sessionRef == LoadSessionRef)
+    {
+        LE_WARN("'sdir' tool disconnected while loading bindings.");
+        EndLoad();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles the "Stats" request from the 'sdir' tool.  Dumps the session open timing statistics in
+ * human readable format.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolStats
+(
+    int fd      ///< [in] The file descriptor to write the output to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (fd == -1)
+    {
+        LE_KILL_CLIENT("No output fd provided.");
+    }
+    else
+    {
+        OpenPhase_t phase;
+
+        dprintf(fd, "\nSESSION OPEN TIMES\n\n");
+        dprintf(fd, "        %-10s %10s %12s %12s\n", "phase", "count", "avg (us)", "max (us)");
+
+        for (phase = 0; phase < OPEN_PHASE_COUNT; phase++)
+        {
+            const OpenPhaseStats_t* statsPtr = &OpenPhaseStats[phase];
+
+            dprintf(fd,
+                    "        %-10s %10" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+                    statsPtr->name,
+                    statsPtr->count,
+                    (statsPtr->count > 0) ? (statsPtr->totalUsec / statsPtr->count) : 0,
+                    statsPtr->maxUsec);
+        }
+
+        dprintf(fd, "\n        %" PRIu64 " open request(s) waited for a binding or a server.\n",
+                WaitingOpenCount);
+        dprintf(fd, "        %zu binding(s), %zu service(s).\n\n",
+                le_hashmap_Size(BindingTable),
+                le_hashmap_Size(ServiceTable));
+
+        fd_Close(fd);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles the "First Advertise" request from the Supervisor.  Sets the relative time a user
+ * started serving at in the response, or 0 if it serves no service.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolFirstAdvertise
+(
+    le_sdtp_Msg_t* msgPtr   ///< [in,out] Request message, updated to be the response.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* userLinkPtr = le_dls_Peek(&UserList);
+
+    msgPtr->firstAdvertiseMs = 0;
+
+    while (userLinkPtr != NULL)
+    {
+        User_t* userPtr = CONTAINER_OF(userLinkPtr, User_t, link);
+
+        if (userPtr->uid == msgPtr->server)
+        {
+            if (!le_dls_IsEmpty(&userPtr->serviceList))
+            {
+                msgPtr->firstAdvertiseMs = (uint64_t)userPtr->firstAdvertiseTime.sec * 1000 +
+                                           userPtr->firstAdvertiseTime.usec / 1000;
+            }
+            break;
+        }
+
+        userLinkPtr = le_dls_PeekNext(&UserList, userLinkPtr);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Process a message received from the "sdir" tool.
@@ -2593,12 +2998,40 @@ static void SdirToolRecv
             SdirToolBind(msgPtr);
             break;
 
+        case LE_SDTP_MSGID_LOAD_START:
+
+            SdirToolLoadStart(le_msg_GetSession(msgRef));
+            break;
+
+        case LE_SDTP_MSGID_LOAD_END:
+
+            EndLoad();
+            break;
+
+        case LE_SDTP_MSGID_STATS:
+
+            SdirToolStats(le_msg_GetFd(msgRef));
+            break;
+
+        case LE_SDTP_MSGID_FIRST_ADVERTISE:
+
+            SdirToolFirstAdvertise(msgPtr);
+            break;
+
         default:
             LE_KILL_CLIENT("Invalid message ID %d.", msgPtr->msgType);
             break;
     }
 
-    le_msg_Respond(msgRef);
+    // Bindings sent during a load are not requests.
+    if (le_msg_NeedsResponse(msgRef))
+    {
+        le_msg_Respond(msgRef);
+    }
+    else
+    {
+        le_msg_ReleaseMsg(msgRef);
+    }
 }
 
 
@@ -2619,6 +3052,7 @@ static void StartSdirToolService
     le_msg_ServiceRef_t service = le_msg_CreateService(protocol, LE_SDTP_INTERFACE_NAME);
 
     le_msg_SetServiceRecvHandler(service, SdirToolRecv, NULL);
+    le_msg_AddServiceCloseHandler(service, SdirToolCloseHandler, NULL);
 
     le_msg_AdvertiseService(service);
 }
@@ -2654,6 +3088,10 @@ COMPONENT_INIT
     le_mem_SetDestructor(UserPoolRef, UserDestructor);
     le_mem_SetDestructor(BindingPoolRef, BindingDestructor);
 
+    // Create the look-up tables.
+    BindingTable = le_hashmap_Create("Bindings", 31, HashInterfaceKey, EqualsInterfaceKey);
+    ServiceTable = le_hashmap_Create("Services", 31, HashInterfaceKey, EqualsInterfaceKey);
+
     // Create built-in, hard-coded bindings.
     CreateHardCodedBindings();
 
@@ -355,6 +355,10 @@ typedef struct app_Ref
     le_sls_List_t   additionalLinks;    // List of additional links that are temporarily added to
                                         // the app.
     le_sls_List_t   reqModuleName;      // List of required kernel module names
+    bool            hasStartTimes;      // true if the app has been started at least once.
+    le_clk_Time_t   sandboxSetupTime;   // Time taken to set up the sandbox at the last start.
+    le_clk_Time_t   procStartTime;      // Time taken to start the processes at the last start.
+    le_clk_Time_t   procStartedAt;      // Relative time the processes started being started at.
 }
 App_t;
 
@@ -3609,6 +3613,14 @@ le_result_t app_Start
 
     appRef->state = APP_STATE_RUNNING;
 
+    // Time the start phases, so that slow starts can be pinned down with the appCtrl API.
+    le_clk_Time_t phaseStartTime = le_clk_GetRelativeTime();
+
+    appRef->hasStartTimes = true;
+    appRef->sandboxSetupTime = (le_clk_Time_t){ 0, 0 };
+    appRef->procStartTime = (le_clk_Time_t){ 0, 0 };
+    appRef->procStartedAt = phaseStartTime;
+
     // Set SMACK rules for this app.
     // Setup the runtime area in the file system.
     if ( (SetSmackRules(appRef) != LE_OK) ||
@@ -3638,6 +3650,11 @@ le_result_t app_Start
         }
     }
 
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    appRef->sandboxSetupTime = le_clk_Sub(now, phaseStartTime);
+    appRef->procStartedAt = now;
+    phaseStartTime = now;
+
     // Start all the processes in the application.
     le_dls_Link_t* procLinkPtr = le_dls_Peek(&(appRef->procs));
 
@@ -3691,6 +3708,13 @@ le_result_t app_Start
         procLinkPtr = le_dls_PeekNext(&(appRef->procs), procLinkPtr);
     }
 
+    appRef->procStartTime = le_clk_Sub(le_clk_GetRelativeTime(), phaseStartTime);
+
+    LE_DEBUG("App '%s' started: sandbox setup %ld.%06ld s, process start %ld.%06ld s.",
+             appRef->name,
+             (long)appRef->sandboxSetupTime.sec, (long)appRef->sandboxSetupTime.usec,
+             (long)appRef->procStartTime.sec, (long)appRef->procStartTime.usec);
+
     return LE_OK;
 }
 
@@ -3859,6 +3883,37 @@ const char* app_GetName
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the times taken by the phases of an application's last start.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the application has not been started yet.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t app_GetStartTimes
+(
+    app_Ref_t appRef,                   ///< [IN] The application reference.
+    le_clk_Time_t* sandboxSetupTimePtr, ///< [OUT] Time taken to set up the app's sandbox.
+    le_clk_Time_t* procStartTimePtr,    ///< [OUT] Time taken to start the app's processes.
+    le_clk_Time_t* procStartedAtPtr     ///< [OUT] Relative time the app's processes started
+                                        ///        being started at.
+)
+{
+    if (!appRef->hasStartTimes)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    *sandboxSetupTimePtr = appRef->sandboxSetupTime;
+    *procStartTimePtr = appRef->procStartTime;
+    *procStartedAtPtr = appRef->procStartedAt;
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets an application's UID.
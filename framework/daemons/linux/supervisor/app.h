@@ -246,6 +246,25 @@ const char* app_GetName
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the times taken by the phases of an application's last start.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the application has not been started yet.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t app_GetStartTimes
+(
+    app_Ref_t appRef,                   ///< [IN] The application reference.
+    le_clk_Time_t* sandboxSetupTimePtr, ///< [OUT] Time taken to set up the app's sandbox.
+    le_clk_Time_t* procStartTimePtr,    ///< [OUT] Time taken to start the app's processes.
+    le_clk_Time_t* procStartedAtPtr     ///< [OUT] Relative time the app's processes started
+                                        ///        being started at.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets an application's UID.
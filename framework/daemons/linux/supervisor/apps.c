@@ -5,6 +5,7 @@
  * app related IPC messages.
  *
  *  - @ref c_apps_applications
+ *  - @ref c_apps_autoStart
  *  - @ref c_apps_appProcs
  *
  * @section c_apps_applications Applications
@@ -39,6 +40,20 @@
  * means we do not have to recreate app containers each time.  App containers are only cleaned when
  * the app is uninstalled.
  *
+ * @section c_apps_autoStart Automatic Start
+ *
+ * Apps that are not marked for manual start are started by apps_AutoStart() once the framework
+ * is up.  Their start order follows their bindings: an app that serves a binding of another
+ * auto-start app is started before that client app, so that clients do not sit blocked on
+ * services that are not there yet.  The apps are started one after the other, from the event
+ * loop, which is yielded every LE_CONFIG_SUPERV_AUTO_START_YIELD_INTERVAL apps so that IPC
+ * requests and child process events are serviced while a large system is still starting.
+ * Bindings to apps that are not auto-started are ignored, and apps caught in a binding cycle are
+ * started in config order once nothing else is ready.
+ *
+ * The time each app waited to be started and the times taken by its start phases can be read
+ * back with le_appCtrl_GetStartTimes().
+ *
  * @section c_apps_appProcs Application Processes
  *
  * Generally the processes in an application are encapsulated and handled by the application class
@@ -73,6 +88,7 @@
 #include "cgroups.h"
 #include "file.h"
 #include "installer.h"
+#include "sdirToolProtocol.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -100,6 +116,16 @@
 #define CFG_NODE_START_MANUAL               "startManual"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The name of the node in the config tree that contains an app's bindings, and the name of the
+ * node in a binding that contains the name of the server app.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_NODE_BINDINGS                   "bindings"
+#define CFG_NODE_BINDING_APP                "app"
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The name of the node in the config tree that states whether the application is sandboxed or not
@@ -176,6 +202,8 @@ typedef struct AppContainer
     void* traceAttachContextPtr;          ///< Context for the client's trace attach handler.
     le_timer_Ref_t CheckAppStopTimer;     ///< Timer for waiting APP stop
     int AppStopTryCount;                  ///< Counter number for retrying to mark the stopped APP
+    le_clk_Time_t startWaitTime;          ///< Time the app waited to be launched at its last
+                                          ///< start.  Zero unless it was started automatically.
 }
 AppContainer_t;
 
@@ -196,6 +224,63 @@ static le_mem_PoolRef_t AppContainerPool;
 static le_ref_MapRef_t AppMap;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * App waiting to be started by apps_AutoStart().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct AutoStartApp
+{
+    char            name[LIMIT_MAX_APP_NAME_BYTES]; ///< Name of the app.
+    size_t          numPendingServers;  ///< Number of bindings to server apps not started yet.
+    le_sls_List_t   clients;            ///< Bindings of client apps to this app (AutoStartDep_t).
+    bool            isLaunched;         ///< true once the app has been launched (or tried to be).
+    le_sls_Link_t   link;               ///< Link in the list of all apps to auto-start.
+    le_sls_Link_t   readyLink;          ///< Link in the queue of apps ready to be started.
+}
+AutoStartApp_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Binding of an auto-start client app to another auto-start app.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    AutoStartApp_t* clientPtr;          ///< The client app.
+    le_sls_Link_t   link;               ///< Link in the server app's list of clients.
+}
+AutoStartDep_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pools for auto-start apps and their bindings.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t AutoStartAppPool;
+static le_mem_PoolRef_t AutoStartDepPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apps to auto-start, by name, in config order, and queue of those whose servers are all started.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t AutoStartMap;
+static le_sls_List_t AutoStartList = LE_SLS_LIST_INIT;
+static le_sls_List_t AutoStartReadyQueue = LE_SLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time when apps_AutoStart() was called.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t AutoStartTime;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Safe reference map for application attach handlers.
@@ -632,6 +717,7 @@ static le_result_t CreateApp
     containerPtr->traceAttachContextPtr = NULL;
     containerPtr->CheckAppStopTimer = NULL;
     containerPtr->AppStopTryCount = 0;
+    containerPtr->startWaitTime = (le_clk_Time_t){ 0, 0 };
 
     // Add this app to the inactive list.
     le_dls_Queue(&InactiveAppsList, &(containerPtr->link));
@@ -712,6 +798,96 @@ static le_result_t StartApp
     return result;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Converts a time to milliseconds.
+ *
+ * @return
+ *      The number of milliseconds, saturated to what fits in 32 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t TimeToMs
+(
+    le_clk_Time_t time                      ///< [IN] Time to convert.
+)
+{
+    uint64_t ms = (uint64_t)time.sec * 1000 + time.usec / 1000;
+
+    return (ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)ms;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the relative time an application's user started serving IPC services at, from the Service
+ * Directory.  Both daemons read the same relative clock, so it can be compared with the start
+ * times of the app.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the app serves no service, or runs as root (it is not sandboxed) so its
+ *                   services cannot be told from those of the framework.
+ *      LE_FAULT if the Service Directory could not be asked.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetFirstAdvertiseTime
+(
+    app_Ref_t appRef,                       ///< [IN] The application reference.
+    le_clk_Time_t* timePtr                  ///< [OUT] Relative time the app started serving at.
+)
+{
+    static le_msg_SessionRef_t sdirSessionRef = NULL;
+
+    if (!app_GetIsSandboxed(appRef))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if (sdirSessionRef == NULL)
+    {
+        le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(LE_SDTP_PROTOCOL_ID,
+                                                                 sizeof(le_sdtp_Msg_t));
+        le_msg_SessionRef_t sessionRef = le_msg_CreateSession(protocolRef,
+                                                              LE_SDTP_INTERFACE_NAME);
+
+        if (le_msg_TryOpenSessionSync(sessionRef) != LE_OK)
+        {
+            le_msg_DeleteSession(sessionRef);
+            return LE_FAULT;
+        }
+
+        sdirSessionRef = sessionRef;
+    }
+
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sdirSessionRef);
+    le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    msgPtr->msgType = LE_SDTP_MSGID_FIRST_ADVERTISE;
+    msgPtr->server = app_GetUid(appRef);
+
+    msgRef = le_msg_RequestSyncResponse(msgRef);
+
+    if (msgRef == NULL)
+    {
+        return LE_FAULT;
+    }
+
+    msgPtr = le_msg_GetPayloadPtr(msgRef);
+    uint64_t firstAdvertiseMs = msgPtr->firstAdvertiseMs;
+    le_msg_ReleaseMsg(msgRef);
+
+    if (firstAdvertiseMs == 0)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    timePtr->sec = firstAdvertiseMs / 1000;
+    timePtr->usec = (firstAdvertiseMs % 1000) * 1000;
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Check whether an APP is going to be removed or updated by checking
@@ -768,7 +944,8 @@ static bool IsAppBusy
 //--------------------------------------------------------------------------------------------------
 static le_result_t LaunchApp
 (
-    const char* appNamePtr      ///< [IN] Name of the application to launch.
+    const char* appNamePtr,     ///< [IN] Name of the application to launch.
+    le_clk_Time_t waitTime      ///< [IN] Time the app waited to be launched.
 )
 {
     // Create the app.
@@ -791,6 +968,8 @@ static le_result_t LaunchApp
     }
 
     // Start the app.
+    appContainerPtr->startWaitTime = waitTime;
+
     return StartApp(appContainerPtr);
 }
 
@@ -1329,6 +1508,11 @@ void apps_Init
     AppMap = le_ref_CreateMap("App", 5);
     AppAttachHandlerMap = le_ref_CreateMap("AppAttachHandlers", 5);
 
+    AutoStartAppPool = le_mem_CreatePool("autoStartApps", sizeof(AutoStartApp_t));
+    AutoStartDepPool = le_mem_CreatePool("autoStartDeps", sizeof(AutoStartDep_t));
+    AutoStartMap = le_hashmap_Create("AutoStartApps", 31,
+                                     le_hashmap_HashString, le_hashmap_EqualsString);
+
     le_instStat_AddAppUninstallEventHandler(DeletesInactiveApp, NULL);
     le_instStat_AddAppInstallEventHandler(DeletesInactiveApp, NULL);
 
@@ -1412,9 +1596,226 @@ void apps_SetShutdownHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases everything apps_AutoStart() allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseAutoStartApps
+(
+    void
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&AutoStartList)) != NULL)
+    {
+        AutoStartApp_t* autoAppPtr = CONTAINER_OF(linkPtr, AutoStartApp_t, link);
+        le_sls_Link_t* depLinkPtr;
+
+        while ((depLinkPtr = le_sls_Pop(&(autoAppPtr->clients))) != NULL)
+        {
+            le_mem_Release(CONTAINER_OF(depLinkPtr, AutoStartDep_t, link));
+        }
+
+        le_mem_Release(autoAppPtr);
+    }
+
+    AutoStartReadyQueue = LE_SLS_LIST_INIT;
+    le_hashmap_RemoveAll(AutoStartMap);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the bindings of an auto-start app, and records those served by other auto-start apps.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadAutoStartDeps
+(
+    AutoStartApp_t* autoAppPtr          ///< [IN] The client app.
+)
+{
+    char cfgPath[LIMIT_MAX_PATH_BYTES] = "";
+
+    if (le_path_Concat("/", cfgPath, sizeof(cfgPath), CFG_NODE_APPS_LIST, autoAppPtr->name,
+                       CFG_NODE_BINDINGS, (char*)NULL) != LE_OK)
+    {
+        LE_ERROR("Bindings path of app '%s' too long.  Start order not enforced.",
+                 autoAppPtr->name);
+        return;
+    }
+
+    le_cfg_IteratorRef_t bindingCfg = le_cfg_CreateReadTxn(cfgPath);
+
+    if (le_cfg_GoToFirstChild(bindingCfg) == LE_OK)
+    {
+        do
+        {
+            char serverName[LIMIT_MAX_APP_NAME_BYTES];
+
+            // Bindings to non-app users do not have an app name.
+            if ( (le_cfg_GetString(bindingCfg, CFG_NODE_BINDING_APP,
+                                   serverName, sizeof(serverName), "") != LE_OK) ||
+                 (serverName[0] == '\0') ||
+                 (strcmp(serverName, autoAppPtr->name) == 0) )
+            {
+                continue;
+            }
+
+            // Servers that are not auto-started do not hold up their clients.
+            AutoStartApp_t* serverPtr = le_hashmap_Get(AutoStartMap, serverName);
+
+            if (serverPtr != NULL)
+            {
+                AutoStartDep_t* depPtr = le_mem_ForceAlloc(AutoStartDepPool);
+
+                depPtr->clientPtr = autoAppPtr;
+                depPtr->link = LE_SLS_LINK_INIT;
+                le_sls_Queue(&(serverPtr->clients), &(depPtr->link));
+
+                autoAppPtr->numPendingServers++;
+            }
+        }
+        while (le_cfg_GoToNextSibling(bindingCfg) == LE_OK);
+    }
+
+    le_cfg_CancelTxn(bindingCfg);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launches an auto-start app, and queues the client apps that no longer wait on any server.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LaunchAutoStartApp
+(
+    AutoStartApp_t* autoAppPtr          ///< [IN] The app to launch.
+)
+{
+    autoAppPtr->isLaunched = true;
+
+    // No need to check the return code because there is nothing we can do about errors.  The
+    // clients are released anyway: they have the Service Directory to wait on their services.
+    LaunchApp(autoAppPtr->name, le_clk_Sub(le_clk_GetRelativeTime(), AutoStartTime));
+
+    le_sls_Link_t* linkPtr = le_sls_Peek(&(autoAppPtr->clients));
+
+    while (linkPtr != NULL)
+    {
+        AutoStartApp_t* clientPtr = CONTAINER_OF(linkPtr, AutoStartDep_t, link)->clientPtr;
+
+        clientPtr->numPendingServers--;
+
+        if ((clientPtr->numPendingServers == 0) && !clientPtr->isLaunched)
+        {
+            le_sls_Queue(&AutoStartReadyQueue, &(clientPtr->readyLink));
+        }
+
+        linkPtr = le_sls_PeekNext(&(autoAppPtr->clients), linkPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next auto-start app to launch.
+ *
+ * @return
+ *      The next app, or NULL if all apps have been launched.
+ */
+//--------------------------------------------------------------------------------------------------
+static AutoStartApp_t* GetNextAutoStartApp
+(
+    void
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&AutoStartReadyQueue)) != NULL)
+    {
+        AutoStartApp_t* autoAppPtr = CONTAINER_OF(linkPtr, AutoStartApp_t, readyLink);
+
+        if (!autoAppPtr->isLaunched)
+        {
+            return autoAppPtr;
+        }
+    }
+
+    // Nothing is ready: anything left waits on a binding cycle, so break it in config order.
+    linkPtr = le_sls_Peek(&AutoStartList);
+
+    while (linkPtr != NULL)
+    {
+        AutoStartApp_t* autoAppPtr = CONTAINER_OF(linkPtr, AutoStartApp_t, link);
+
+        if (!autoAppPtr->isLaunched)
+        {
+            LE_WARN("App '%s' is part of a binding cycle.  Starting it before its servers.",
+                    autoAppPtr->name);
+            return autoAppPtr;
+        }
+
+        linkPtr = le_sls_PeekNext(&AutoStartList, linkPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Launches the next auto-start apps, one after the other, then yields to the event loop and queues
+ * itself to go on from its next pass.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ContinueAutoStart
+(
+    void* param1Ptr,    ///< [IN] Not used.
+    void* param2Ptr     ///< [IN] Not used.
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    if (framework_IsStopping())
+    {
+        LE_WARN("Framework is shutting down.  Remaining apps will not be auto-started.");
+        ReleaseAutoStartApps();
+        return;
+    }
+
+    int i;
+
+    for (i = 0; i < LE_CONFIG_SUPERV_AUTO_START_YIELD_INTERVAL; i++)
+    {
+        AutoStartApp_t* autoAppPtr = GetNextAutoStartApp();
+
+        if (autoAppPtr == NULL)
+        {
+            le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), AutoStartTime);
+
+            LE_INFO("Auto-start of %zu apps done in %ld.%06ld s.",
+                    le_hashmap_Size(AutoStartMap), (long)elapsed.sec, (long)elapsed.usec);
+
+            ReleaseAutoStartApps();
+            return;
+        }
+
+        LaunchAutoStartApp(autoAppPtr);
+    }
+
+    le_event_QueueFunction(ContinueAutoStart, NULL, NULL);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Start all applications marked as 'auto' start.
+ *
+ * The apps are launched from the event loop, in the order of their bindings, so this function
+ * returns before they are all started.  See @ref c_apps_autoStart.
  */
 //--------------------------------------------------------------------------------------------------
 void apps_AutoStart
@@ -1422,6 +1823,8 @@ void apps_AutoStart
     void
 )
 {
+    AutoStartTime = le_clk_GetRelativeTime();
+
     // Read the list of applications from the config tree.
     le_cfg_IteratorRef_t appCfg = le_cfg_CreateReadTxn(CFG_NODE_APPS_LIST);
 
@@ -1439,26 +1842,59 @@ void apps_AutoStart
         // Check the start mode for this application.
         if (!le_cfg_GetBool(appCfg, CFG_NODE_START_MANUAL, false))
         {
-            // Get the app name.
-            char appName[LIMIT_MAX_APP_NAME_BYTES];
+            AutoStartApp_t* autoAppPtr = le_mem_ForceAlloc(AutoStartAppPool);
 
-            if (le_cfg_GetNodeName(appCfg, "", appName, sizeof(appName)) == LE_OVERFLOW)
+            if (le_cfg_GetNodeName(appCfg, "", autoAppPtr->name, sizeof(autoAppPtr->name))
+                == LE_OVERFLOW)
             {
                 LE_ERROR("AppName buffer was too small, name truncated to '%s'.  "
                          "Max app name in bytes, %d.  Application not launched.",
-                         appName, LIMIT_MAX_APP_NAME_BYTES);
-            }
-            else
-            {
-                // Launch the application now.  No need to check the return code because there is
-                // nothing we can do about errors.
-                LaunchApp(appName);
+                         autoAppPtr->name, LIMIT_MAX_APP_NAME_BYTES);
+
+                le_mem_Release(autoAppPtr);
+                continue;
             }
+
+            autoAppPtr->numPendingServers = 0;
+            autoAppPtr->clients = LE_SLS_LIST_INIT;
+            autoAppPtr->isLaunched = false;
+            autoAppPtr->link = LE_SLS_LINK_INIT;
+            autoAppPtr->readyLink = LE_SLS_LINK_INIT;
+
+            le_hashmap_Put(AutoStartMap, autoAppPtr->name, autoAppPtr);
+            le_sls_Queue(&AutoStartList, &(autoAppPtr->link));
         }
     }
     while (le_cfg_GoToNextSibling(appCfg) == LE_OK);
 
     le_cfg_CancelTxn(appCfg);
+
+    // Build the dependency graph, then queue the apps that do not wait on any server.
+    le_sls_Link_t* linkPtr = le_sls_Peek(&AutoStartList);
+
+    while (linkPtr != NULL)
+    {
+        ReadAutoStartDeps(CONTAINER_OF(linkPtr, AutoStartApp_t, link));
+
+        linkPtr = le_sls_PeekNext(&AutoStartList, linkPtr);
+    }
+
+    linkPtr = le_sls_Peek(&AutoStartList);
+
+    while (linkPtr != NULL)
+    {
+        AutoStartApp_t* autoAppPtr = CONTAINER_OF(linkPtr, AutoStartApp_t, link);
+
+        if (autoAppPtr->numPendingServers == 0)
+        {
+            le_sls_Queue(&AutoStartReadyQueue, &(autoAppPtr->readyLink));
+        }
+
+        linkPtr = le_sls_PeekNext(&AutoStartList, linkPtr);
+    }
+
+    // Launch the first apps right away; the others follow from the event loop.
+    ContinueAutoStart(NULL, NULL);
 }
 
 
@@ -1740,7 +2176,7 @@ static le_result_t appCtrl_Start
 
     LE_DEBUG("Received request to start application '%s'.", appName);
 
-    return LaunchApp(appName);
+    return LaunchApp(appName, (le_clk_Time_t){ 0, 0 });
 }
 
 
@@ -2168,6 +2604,74 @@ void le_appCtrl_Stop
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the times taken by the phases of an app's last start.  This function is called by the
+ * event loop when a separate process requests an app's start times.
+ *
+ * @note
+ *   The result code for this command should be sent back to the requesting process via
+ *   le_appCtrl_GetStartTimesRespond().  The possible result codes are:
+ *
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if the app has not been started since the framework started.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_appCtrl_GetStartTimes
+(
+    le_appCtrl_ServerCmdRef_t cmdRef,   ///< [IN] Command reference that must be passed to this
+                                        ///       command's response function.
+    const char* appName                 ///< [IN] Name of the application.
+)
+{
+    if (!IsAppNameValid(appName))
+    {
+        LE_KILL_CLIENT("Invalid app name.");
+        return;
+    }
+
+    AppContainer_t* appContainerPtr = GetActiveApp(appName);
+
+    if (appContainerPtr == NULL)
+    {
+        appContainerPtr = GetInactiveApp(appName);
+    }
+
+    le_clk_Time_t sandboxSetupTime;
+    le_clk_Time_t procStartTime;
+    le_clk_Time_t procStartedAt;
+    le_clk_Time_t firstAdvertiseTime;
+
+    if ( (appContainerPtr == NULL) ||
+         (app_GetStartTimes(appContainerPtr->appRef,
+                            &sandboxSetupTime, &procStartTime, &procStartedAt) != LE_OK) )
+    {
+        le_appCtrl_GetStartTimesRespond(cmdRef, LE_NOT_FOUND, 0, 0, 0, 0);
+        return;
+    }
+
+    // Services advertised before the processes were started belong to a previous run.
+    uint32_t advertiseMs = LE_APPCTRL_START_TIME_UNKNOWN;
+
+    if ( (GetFirstAdvertiseTime(appContainerPtr->appRef, &firstAdvertiseTime) == LE_OK) &&
+         (!le_clk_GreaterThan(procStartedAt, firstAdvertiseTime)) )
+    {
+        advertiseMs = TimeToMs(le_clk_Sub(firstAdvertiseTime, procStartedAt));
+
+        if (advertiseMs == LE_APPCTRL_START_TIME_UNKNOWN)
+        {
+            advertiseMs--;
+        }
+    }
+
+    le_appCtrl_GetStartTimesRespond(cmdRef, LE_OK,
+                                    TimeToMs(appContainerPtr->startWaitTime),
+                                    TimeToMs(sandboxSetupTime),
+                                    TimeToMs(procStartTime),
+                                    advertiseMs);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets the state of the specified application.  The state of unknown applications is STOPPED.
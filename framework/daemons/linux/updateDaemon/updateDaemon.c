@@ -58,10 +58,11 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Maximum length of app config tree name.
+ * Maximum length of app config tree file name: the app name, a dot and the longest config tree
+ * file extension, which is the one of the previous journal.
  */
 //--------------------------------------------------------------------------------------------------
-#define MAX_CFGTREE_NAME_BYTES   LIMIT_MAX_USER_NAME_BYTES
+#define MAX_CFGTREE_NAME_BYTES   (LIMIT_MAX_APP_NAME_LEN + sizeof("." CFG_TREE_JOURNAL_PREV_EXT))
 
 
 //--------------------------------------------------------------------------------------------------
@@ -1266,6 +1267,43 @@ static void ImportFile
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the extension of a config tree file, one of CFG_TREE_FILE_EXTS.  Config trees are also
+ * stored as a binary snapshot and journal, and those extensions may themselves contain a dot, so
+ * the known extensions are matched against the end of the name.
+ *
+ * returns
+ *     - pointer to the dot that separates the tree name from the extension.
+ *     - NULL if the name doesn't end with a config tree extension.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* FindCfgTreeExt
+(
+    const char* fileName   ///< [IN] Config tree file name.
+)
+{
+    static const char* extensions[] = { CFG_TREE_FILE_EXTS };
+    size_t nameLen = strlen(fileName);
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(extensions); i++)
+    {
+        size_t extLen = strlen(extensions[i]);
+
+        // Need at least one character of tree name and the dot before the extension.
+        if ((nameLen > extLen + 1) &&
+            (fileName[nameLen - extLen - 1] == '.') &&
+            (strcmp(fileName + nameLen - extLen, extensions[i]) == 0))
+        {
+            return fileName + nameLen - extLen - 1;
+        }
+    }
+
+    return NULL;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks if given name is a valid config tree.
@@ -1280,17 +1318,7 @@ static bool IsCfgTree
     const char* treeName   ///< [IN] Config tree name.
 )
 {
-
-    char* extension = strrchr(treeName, '.');
-
-    if (extension == NULL)
-    {
-        return false;
-    }
-
-    return (strcmp(extension, ".rock") == 0) ||
-           (strcmp(extension, ".paper") == 0) ||
-           (strcmp(extension, ".scissors") == 0);
+    return FindCfgTreeExt(treeName) != NULL;
 }
 
 
@@ -1308,9 +1336,11 @@ static bool IsSystemCfgTree
     const char* treeName   ///< [IN] Config tree name.
 )
 {
-    return (strcmp(treeName, "system.rock") == 0) ||
-           (strcmp(treeName, "system.paper") == 0) ||
-           (strcmp(treeName, "system.scissors") == 0);
+    const char* extPtr = FindCfgTreeExt(treeName);
+
+    return (extPtr != NULL) &&
+           ((size_t)(extPtr - treeName) == sizeof("system") - 1) &&
+           (strncmp(treeName, "system", sizeof("system") - 1) == 0);
 }
 
 
@@ -1368,21 +1398,12 @@ static bool IsThisAppsCfgTree
     const char* appName     ///< [IN] App name
 )
 {
-    char* dotStrPtr = strrchr(treeName, '.');
-
-    if (dotStrPtr == NULL)
-    {
-        return false;
-    }
-
-    char tempTreeName[MAX_CFGTREE_NAME_BYTES] = "";
+    const char* dotStrPtr = FindCfgTreeExt(treeName);
+    size_t appNameLen = strlen(appName);
 
-    LE_ASSERT(le_utf8_CopyUpToSubStr(tempTreeName,
-                                     treeName,
-                                     dotStrPtr,
-                                     sizeof(tempTreeName),
-                                     NULL) == LE_OK);
-    return strcmp(appName, tempTreeName) == 0;
+    return (dotStrPtr != NULL) &&
+           ((size_t)(dotStrPtr - treeName) == appNameLen) &&
+           (strncmp(treeName, appName, appNameLen) == 0);
 }
 
 
@@ -1481,8 +1502,8 @@ static void RemoveFromListTreeInCfgNode
         if ((obsoleteTreeList[i][0] != 0) &&
             IsThisAppsCfgTree(obsoleteTreeList[i], cfgTree))
         {
-            // There may be more than one config tree (e.g. helloWorld.rock, helloWorld.paper), so
-            // don't break after first match.
+            // There may be more than one config tree file (e.g. helloWorld.rock, helloWorld.paper,
+            // helloWorld.snap, helloWorld.journal), so don't break after first match.
             LE_DEBUG("Removed cfgTree '%s' from obsolete list", obsoleteTreeList[i]);
             obsoleteTreeList[i][0] = 0;
         }
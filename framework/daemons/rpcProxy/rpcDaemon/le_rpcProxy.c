@@ -12,6 +12,7 @@
 #include "le_rpcProxyConfig.h"
 #include "le_rpcProxyEventHandler.h"
 #include "le_rpcProxyFileStream.h"
+#include "le_rpcProxyCompress.h"
 
 #ifndef RPC_PROXY_LOCAL_SERVICE
 #include <dlfcn.h>
@@ -183,6 +184,7 @@ static le_hashmap_Ref_t ServiceRefMapByID = NULL;
 //--------------------------------------------------------------------------------------------------
 /**
  * Hash Map to store Proxy Message ID (key) and TimerRef (value) mappings.
+ * Client-Requests time out on the expiry wheel instead (see ExpiryWheel).
  * NOTE: Maximum number of simultaneous timer-references is defined by the maximum number of
  * Message Reference and Keep-alive messages supported by the RPC Proxy.
  * Initialized in rpcProxy_COMPONENT_INIT().
@@ -210,6 +212,48 @@ static le_hashmap_Ref_t ExpiryTimerRefByServiceId = NULL;
 LE_HASHMAP_DEFINE_STATIC(RequestResponseRefHashMap, RPC_PROXY_MSG_REFERENCE_MAX_NUM);
 static le_hashmap_Ref_t RequestResponseRefByProxyId = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash Map to store Proxy Message ID (key) and Client-Request Record (value) mappings, for the
+ * Client-Requests awaiting a response.
+ * Initialized in rpcProxy_COMPONENT_INIT().
+ */
+//--------------------------------------------------------------------------------------------------
+LE_HASHMAP_DEFINE_STATIC(ClientRequestHashMap, RPC_PROXY_MSG_REFERENCE_MAX_NUM);
+static le_hashmap_Ref_t ClientRequestByProxyId = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of slots in the Client-Request expiry wheel.  Requests due more than a turn of the wheel
+ * ahead stay in their slot until the turn they are due in.
+ */
+//--------------------------------------------------------------------------------------------------
+#define EXPIRY_WHEEL_SLOTS      32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Client-Request expiry wheel: the Client-Request Records awaiting a response, in the slot of the
+ * tick they time out at.  A single timer ticks the wheel once a second while it is not empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t ExpiryWheel[EXPIRY_WHEEL_SLOTS];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Current tick of the expiry wheel, and number of records on it.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ExpiryWheelTick = 0;
+static uint32_t ExpiryWheelCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer ticking the expiry wheel.
+ * Initialized in rpcProxy_COMPONENT_INIT().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t ExpiryWheelTimerRef = NULL;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -276,6 +320,48 @@ LE_MEM_DEFINE_STATIC_POOL(ProxyClientRequestResponseRecordPool,
                           sizeof(rpcProxy_ClientRequestResponseRecord_t));
 static le_mem_PoolRef_t ProxyClientRequestResponseRecordPoolRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This pool is used to allocate memory for the Proxy Client-Request Records.
+ * Initialized in rpcProxy_COMPONENT_INIT().
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(ProxyClientRequestRecordPool,
+                          RPC_PROXY_MSG_REFERENCE_MAX_NUM,
+                          sizeof(rpcProxy_ClientRequestRecord_t));
+static le_mem_PoolRef_t ProxyClientRequestRecordPoolRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message, or frame of coalesced messages, kept while a communication channel is congested.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;     ///< Link in the backlog of the Network Record
+    size_t        len;      ///< Number of bytes to send
+    union
+    {
+        uint8_t message[RPC_PROXY_RECV_BUFFER_MAX];
+#if RPC_PROXY_COALESCE_BUFFER_SIZE > 0
+        uint8_t coalesced[RPC_PROXY_COALESCE_BUFFER_SIZE];
+#endif
+    }
+    data;                   ///< Bytes to send
+}
+BacklogFrame_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This pool is used to allocate memory for the messages kept while a channel is congested.
+ * Initialized in rpcProxy_COMPONENT_INIT().
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(BacklogFramePool,
+                          RPC_PROXY_BACKLOG_FRAME_MAX_NUM,
+                          sizeof(BacklogFrame_t));
+static le_mem_PoolRef_t BacklogFramePoolRef = NULL;
+
 
 #ifdef RPC_PROXY_LOCAL_SERVICE
 //--------------------------------------------------------------------------------------------------
@@ -330,6 +416,16 @@ static le_mem_PoolRef_t ResponseParameterArrayPoolRef = NULL;
 
 #endif
 
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffer holding the compressed payload of the message being sent, or the decompressed payload of
+ * the message being received.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t CompressionBuffer[RPC_PROXY_MAX_MESSAGE];
+#endif
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -650,129 +746,891 @@ void rpcProxy_ProxyMessageTimerExpiryHandler
             break;
         }
 
-        case RPC_PROXY_CLIENT_REQUEST:
+        default:
+        {
+            LE_ERROR("Unexpected Proxy Message, type [0x%x]", commonHeaderPtr->type);
+            break;
+        }
+    }
+
+    // Delete Timer
+    le_timer_Delete(timerRef);
+    timerRef = NULL;
+
+exit:
+    return;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for retrieving the Expiry Timer Hash-map reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t rpcProxy_GetExpiryTimerRefByProxyId
+(
+    void
+)
+{
+    return ExpiryTimerRefByProxyId;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a Client-Request Record on the expiry wheel, to time out after the Client-Request interval.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToExpiryWheel
+(
+    rpcProxy_ClientRequestRecord_t* recordPtr ///< [IN] Client-Request Record
+)
+{
+    // One tick more than the interval, as the next tick may be less than a second away
+    recordPtr->expiryTick = ExpiryWheelTick + RPC_PROXY_CLIENT_REQUEST_TIMER_INTERVAL + 1;
+    le_dls_Queue(&ExpiryWheel[recordPtr->expiryTick % EXPIRY_WHEEL_SLOTS], &recordPtr->wheelLink);
+
+    if (ExpiryWheelCount++ == 0)
+    {
+        le_timer_Start(ExpiryWheelTimerRef);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a Client-Request Record off the expiry wheel.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveFromExpiryWheel
+(
+    rpcProxy_ClientRequestRecord_t* recordPtr ///< [IN] Client-Request Record
+)
+{
+    le_dls_Remove(&ExpiryWheel[recordPtr->expiryTick % EXPIRY_WHEEL_SLOTS], &recordPtr->wheelLink);
+
+    if (--ExpiryWheelCount == 0)
+    {
+        le_timer_Stop(ExpiryWheelTimerRef);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for sending a Client-Request to the far side, and accounting for it in the in-flight
+ * window of the destination system.  Releases the Client-Request Record if the client does not
+ * expect a response.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendClientRequest
+(
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the destination system
+    rpcProxy_ClientRequestRecord_t* recordPtr ///< [IN] Client-Request Record
+)
+{
+    LE_DEBUG("Sending message to '%s' RPC Proxy, id [%" PRIu32 "], %u bytes",
+             recordPtr->systemName,
+             recordPtr->messagePtr->commonHeader.id,
+             recordPtr->messagePtr->msgSize);
+
+    // Send Proxy Message to far-side
+    le_result_t result =
+        rpcProxy_SendMsg(recordPtr->systemName, recordPtr->messagePtr, &recordPtr->metaData);
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("le_comm_Send failed, result %d", result);
+        rpcFStream_DeleteOurStream(recordPtr->metaData.fileStreamId, recordPtr->systemName);
+
+        // Left to time out, if the client expects a response
+        recordPtr->state = RPC_PROXY_CLIENT_REQUEST_DETACHED;
+    }
+    else if (recordPtr->needsResponse)
+    {
+        recordPtr->state = RPC_PROXY_CLIENT_REQUEST_IN_FLIGHT;
+        networkRecordPtr->inFlightCount++;
+    }
+
+    if (!recordPtr->needsResponse)
+    {
+        le_mem_Release(recordPtr->messagePtr);
+        le_mem_Release(recordPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for sending the queued Client-Requests of a system, while there is room in its
+ * in-flight window.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendQueuedClientRequests
+(
+    NetworkRecord_t* networkRecordPtr ///< [IN] Network Record of the destination system
+)
+{
+    while (networkRecordPtr->inFlightCount < RPC_PROXY_IN_FLIGHT_WINDOW)
+    {
+        le_dls_Link_t* linkPtr = le_dls_Pop(&networkRecordPtr->windowQueue);
+        if (linkPtr == NULL)
+        {
+            break;
+        }
+
+        SendClientRequest(networkRecordPtr,
+                          CONTAINER_OF(linkPtr, rpcProxy_ClientRequestRecord_t, queueLink));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for sending a Client-Request to the far side, or queueing it behind the requests
+ * already waiting if the in-flight window of the destination system is full.  Requests that do not
+ * expect a response take no place in the window, but are queued to stay in order.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SubmitClientRequest
+(
+    rpcProxy_ClientRequestRecord_t* recordPtr ///< [IN] Client-Request Record
+)
+{
+    NetworkRecord_t* networkRecordPtr =
+        le_hashmap_Get(rpcProxyNetwork_GetNetworkRecordHashMapByName(), recordPtr->systemName);
+
+    if ((networkRecordPtr != NULL) &&
+        (!le_dls_IsEmpty(&networkRecordPtr->windowQueue) ||
+         (recordPtr->needsResponse &&
+          (networkRecordPtr->inFlightCount >= RPC_PROXY_IN_FLIGHT_WINDOW))))
+    {
+        LE_DEBUG("In-flight window full, system [%s] - queueing Client-Request, id [%" PRIu32 "]",
+                 recordPtr->systemName,
+                 recordPtr->messagePtr->commonHeader.id);
+
+        recordPtr->state = RPC_PROXY_CLIENT_REQUEST_QUEUED;
+        le_dls_Queue(&networkRecordPtr->windowQueue, &recordPtr->queueLink);
+        return;
+    }
+
+    SendClientRequest(networkRecordPtr, recordPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for releasing a Client-Request Record that has been answered or has timed out, and the
+ * place it held in the in-flight window.  The record must be off the expiry wheel.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseClientRequest
+(
+    rpcProxy_ClientRequestRecord_t* recordPtr ///< [IN] Client-Request Record
+)
+{
+    NetworkRecord_t* networkRecordPtr =
+        le_hashmap_Get(rpcProxyNetwork_GetNetworkRecordHashMapByName(), recordPtr->systemName);
+
+    if (networkRecordPtr != NULL)
+    {
+        if (recordPtr->state == RPC_PROXY_CLIENT_REQUEST_QUEUED)
+        {
+            le_dls_Remove(&networkRecordPtr->windowQueue, &recordPtr->queueLink);
+        }
+        else if ((recordPtr->state == RPC_PROXY_CLIENT_REQUEST_IN_FLIGHT) &&
+                 (networkRecordPtr->inFlightCount > 0))
+        {
+            networkRecordPtr->inFlightCount--;
+        }
+    }
+
+    le_hashmap_Remove(ClientRequestByProxyId,
+                      (void*)(uintptr_t) recordPtr->messagePtr->commonHeader.id);
+
+    le_mem_Release(recordPtr->messagePtr);
+    le_mem_Release(recordPtr);
+
+    if (networkRecordPtr != NULL)
+    {
+        SendQueuedClientRequests(networkRecordPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for timing out a Client-Request, generating a LE_TIMEOUT response to the client.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExpireClientRequest
+(
+    rpcProxy_ClientRequestRecord_t* recordPtr ///< [IN] Client-Request Record
+)
+{
+    rpcProxy_Message_t* proxyMessagePtr = recordPtr->messagePtr;
+
+    LE_INFO("Client-Request has timed out, "
+            "service-id [%" PRIu32 "], proxy id [%" PRIu32 "]; "
+            "check if client-response needs to be generated",
+            proxyMessagePtr->commonHeader.serviceId,
+            proxyMessagePtr->commonHeader.id);
+
+    // Retrieve Message Reference from hash map, using the Proxy Message Id
+    le_msg_MessageRef_t msgRef =
+        le_hashmap_Get(MsgRefMapByProxyId, (void*)(uintptr_t) proxyMessagePtr->commonHeader.id);
+
+    if (msgRef == NULL)
+    {
+        LE_INFO("Unable to retrieve Message Reference, proxy id [%" PRIu32 "] - "
+                "do not generate response message",
+                proxyMessagePtr->commonHeader.id);
+    }
+    else
+    {
+        // Generate LE_TIMEOUT Server-Response
+        GenerateServerResponseErrorMessage(proxyMessagePtr, LE_TIMEOUT);
+
+        // Trigger a response back to the client
+        ProcessServerResponse(NULL, proxyMessagePtr, NULL, true);
+    }
+
+    ReleaseClientRequest(recordPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler function for the expiry wheel timer: times out the Client-Requests due at this tick.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExpiryWheelTimerHandler
+(
+    le_timer_Ref_t timerRef    ///< Expiry wheel timer
+)
+{
+    le_dls_List_t  expiredList = LE_DLS_LIST_INIT;
+    le_dls_List_t* slotPtr;
+    le_dls_Link_t* linkPtr;
+
+    LE_UNUSED(timerRef);
+
+    ExpiryWheelTick++;
+    slotPtr = &ExpiryWheel[ExpiryWheelTick % EXPIRY_WHEEL_SLOTS];
+
+    // Take the records that are due off the wheel first, as timing them out sends messages
+    linkPtr = le_dls_Peek(slotPtr);
+    while (linkPtr != NULL)
+    {
+        rpcProxy_ClientRequestRecord_t* recordPtr =
+            CONTAINER_OF(linkPtr, rpcProxy_ClientRequestRecord_t, wheelLink);
+
+        linkPtr = le_dls_PeekNext(slotPtr, linkPtr);
+
+        if (recordPtr->expiryTick == ExpiryWheelTick)
+        {
+            RemoveFromExpiryWheel(recordPtr);
+            le_dls_Queue(&expiredList, &recordPtr->wheelLink);
+        }
+    }
+
+    while ((linkPtr = le_dls_Pop(&expiredList)) != NULL)
+    {
+        ExpireClientRequest(CONTAINER_OF(linkPtr, rpcProxy_ClientRequestRecord_t, wheelLink));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset the Client-Request window, the coalesced messages and the backlog of a system whose
+ * Network Connection has failed.
+ */
+//--------------------------------------------------------------------------------------------------
+void rpcProxy_ResetLinkState
+(
+    const char* systemName ///< [IN] Name of System whose Network Connection has failed
+)
+{
+    le_dls_Link_t* linkPtr;
+    le_sls_Link_t* sLinkPtr;
+
+    NetworkRecord_t* networkRecordPtr =
+        le_hashmap_Get(rpcProxyNetwork_GetNetworkRecordHashMapByName(), systemName);
+
+    if (networkRecordPtr == NULL)
+    {
+        return;
+    }
+
+    // Requests not sent yet are not sent on the next connection: those expecting a response are
+    // left to time out, like the requests sent before the failure
+    while ((linkPtr = le_dls_Pop(&networkRecordPtr->windowQueue)) != NULL)
+    {
+        rpcProxy_ClientRequestRecord_t* recordPtr =
+            CONTAINER_OF(linkPtr, rpcProxy_ClientRequestRecord_t, queueLink);
+
+        recordPtr->state = RPC_PROXY_CLIENT_REQUEST_DETACHED;
+
+        if (!recordPtr->needsResponse)
+        {
+            le_mem_Release(recordPtr->messagePtr);
+            le_mem_Release(recordPtr);
+        }
+    }
+
+    le_hashmap_It_Ref_t iter = le_hashmap_GetIterator(ClientRequestByProxyId);
+    while (le_hashmap_NextNode(iter) == LE_OK)
+    {
+        rpcProxy_ClientRequestRecord_t* recordPtr = le_hashmap_GetValue(iter);
+
+        if ((recordPtr->state == RPC_PROXY_CLIENT_REQUEST_IN_FLIGHT) &&
+            (strcmp(recordPtr->systemName, systemName) == 0))
+        {
+            recordPtr->state = RPC_PROXY_CLIENT_REQUEST_DETACHED;
+        }
+    }
+    networkRecordPtr->inFlightCount = 0;
+
+#if RPC_PROXY_COALESCE_BUFFER_SIZE > 0
+    if (networkRecordPtr->coalesceState.len > 0)
+    {
+        LE_WARN("Dropping %" PRIuS " unsent bytes, system [%s]",
+                networkRecordPtr->coalesceState.len, systemName);
+        networkRecordPtr->coalesceState.len = 0;
+    }
+#endif
+
+    // The messages kept while the channel was congested belong to the failed connection
+    if (networkRecordPtr->backlogTimerRef != NULL)
+    {
+        le_timer_Stop(networkRecordPtr->backlogTimerRef);
+    }
+    while ((sLinkPtr = le_sls_Pop(&networkRecordPtr->backlog)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(sLinkPtr, BacklogFrame_t, link));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for retrieving the Service-ID Hash-map reference.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_Ref_t rpcProxy_GetServiceIDMapByName
+(
+    void
+)
+{
+    return ServiceIDMapByName;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for generating unique Proxy Message IDs
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t rpcProxy_GenerateProxyMessageId
+(
+    void
+)
+{
+    // Proxy Message ID Generator
+    // Monotonically increase proxy message ID to ensure each
+    // client request is uniquely identified
+    GlobalMsgId++;
+
+    return GlobalMsgId;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocate new rpcProxy message
+ */
+//--------------------------------------------------------------------------------------------------
+rpcProxy_Message_t* rpcProxy_AllocateNewMessage
+(
+    void
+)
+{
+    return le_mem_Alloc(ProxyMessagesPoolRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for checking if a Proxy Message can be repacked in place, i.e. the only field that
+ * RepackMessage() would change is the Msg ID, and the message size stays the same.  This is the
+ * case for messages that carry no context or handler references, no file stream, and (for local
+ * service messaging) no strings or arrays.
+ *
+ * @note Messages that RepackMessage() would reject are reported as not repackable in place, so
+ *       that they go through RepackMessage() and are rejected there.
+ *
+ * @return
+ *      TRUE if RepackMessage() can be replaced by RepackMsgIdInPlace()
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsRepackInPlace
+(
+    rpcProxy_Message_t *proxyMessagePtr, ///< [IN] Pointer to the Proxy Message
+    rpcProxy_MessageMetadata_t *metaDataPtr,///< [IN] metadata of proxy message (sending only)
+    bool sending ///< [IN] Boolean to identify if message is in-coming or out-going
+)
+{
+    uint8_t* msgBufPtr = &proxyMessagePtr->message[0];
+    uint8_t* msgEndPtr = msgBufPtr + proxyMessagePtr->msgSize;
+
+    if (sending && metaDataPtr && metaDataPtr->isFileStreamValid)
+    {
+        // File stream metadata tags are inserted
+        return false;
+    }
+
+    if (proxyMessagePtr->msgSize == 0)
+    {
+        return true;
+    }
+
+    if ((proxyMessagePtr->msgSize < LE_PACK_SIZEOF_UINT32) ||
+        (proxyMessagePtr->msgSize > RPC_PROXY_MAX_MESSAGE))
+    {
+        return false;
+    }
+
+#ifdef RPC_PROXY_LOCAL_SERVICE
+    if (sending && (proxyMessagePtr->commonHeader.type == RPC_PROXY_SERVER_RESPONSE))
+    {
+        // "out" parameter responses are appended
+        return false;
+    }
+#endif
+
+    // Skip the Msg ID
+    msgBufPtr += LE_PACK_SIZEOF_UINT32;
+
+    // Traverse through the Message buffer, as RepackMessage() does
+    while (msgBufPtr < msgEndPtr)
+    {
+        TagID_t tagId = *msgBufPtr;
+
+        switch(tagId)
+        {
+            // Fixed-length Types
+            case LE_PACK_UINT8:
+            case LE_PACK_INT8:
+            case LE_PACK_BOOL:
+            case LE_PACK_CHAR:
+            case LE_PACK_UINT16:
+            case LE_PACK_INT16:
+            case LE_PACK_RESULT:
+            case LE_PACK_ONOFF:
+            case LE_PACK_UINT32:
+            case LE_PACK_INT32:
+            case LE_PACK_REFERENCE:
+            case LE_PACK_SIZE:
+            case LE_PACK_UINT64:
+            case LE_PACK_INT64:
+            case LE_PACK_DOUBLE:
+            {
+                msgBufPtr += (LE_PACK_SIZEOF_TAG_ID + ItemPackSize[tagId]);
+                break;
+            }
+
+#ifndef RPC_PROXY_LOCAL_SERVICE
+            case LE_PACK_STRING_RESPONSE_SIZE:
+            case LE_PACK_ARRAY_RESPONSE_SIZE:
+            {
+                if (sending)
+                {
+                    return false;
+                }
+                msgBufPtr += (LE_PACK_SIZEOF_TAG_ID + ItemPackSize[tagId]);
+                break;
+            }
+
+            // Variable-length Type, bundled with a size
+            case LE_PACK_STRING:
+            {
+                uint32_t value = 0;
+
+                if ((size_t)(msgEndPtr - msgBufPtr) < (LE_PACK_SIZEOF_TAG_ID + LE_PACK_SIZEOF_UINT32))
+                {
+                    return false;
+                }
+                le_pack_UnpackUint32(&msgBufPtr, &value);
+                if (value > (uint32_t)(msgEndPtr - msgBufPtr))
+                {
+                    return false;
+                }
+                msgBufPtr += value;
+                break;
+            }
+
+            // Variable-length Type, bundled with a size
+            case LE_PACK_ARRAYHEADER:
+            {
+                size_t value = 0;
+
+                if ((size_t)(msgEndPtr - msgBufPtr) < (LE_PACK_SIZEOF_TAG_ID + LE_PACK_SIZEOF_UINT32))
+                {
+                    return false;
+                }
+                le_pack_UnpackSize(&msgBufPtr, &value);
+                if (value > (size_t)(msgEndPtr - msgBufPtr))
+                {
+                    return false;
+                }
+                msgBufPtr += value;
+                break;
+            }
+#endif
+
+            case LE_PACK_CONTEXT_PTR_REFERENCE:
+            case LE_PACK_ASYNC_HANDLER_REFERENCE:
+            case LE_PACK_FILESTREAM_ID:
+            case LE_PACK_FILESTREAM_FLAG:
+#ifdef RPC_PROXY_LOCAL_SERVICE
+            case LE_PACK_STRING:
+            case LE_PACK_ARRAYHEADER:
+            case LE_PACK_STRING_RESPONSE_SIZE:
+            case LE_PACK_ARRAY_RESPONSE_SIZE:
+            case LE_PACK_IN_STRING_POINTER:
+            case LE_PACK_OUT_STRING_POINTER:
+            case LE_PACK_IN_ARRAY_POINTER:
+            case LE_PACK_OUT_ARRAY_POINTER:
+#endif
+                // Requires repack
+                return false;
+
+            default:
+                // RepackMessage() copies the rest of the message as is
+                return true;
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for repacking a Proxy Message in place, converting the Msg ID between Host-Order and
+ * Network-Order.  Only valid if IsRepackInPlace() is TRUE.  Calling it twice restores the message.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RepackMsgIdInPlace
+(
+    rpcProxy_Message_t *proxyMessagePtr, ///< [IN] Pointer to the Proxy Message
+    bool sending ///< [IN] Boolean to identify if message is in-coming or out-going
+)
+{
+    uint32_t id;
+
+    if (proxyMessagePtr->msgSize == 0)
+    {
+        return;
+    }
+
+    // First field in message is the Msg ID (uint32_t)
+    memcpy(&id, &proxyMessagePtr->message[0], LE_PACK_SIZEOF_UINT32);
+    id = sending ? htobe32(id) : be32toh(id);
+    memcpy(&proxyMessagePtr->message[0], &id, LE_PACK_SIZEOF_UINT32);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for sending a variable-length Proxy Message, made of a header and a payload that need
+ * not be contiguous, via the le_comm API.  Uses a scatter/gather send if the le_comm
+ * implementation has one.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendVariableLengthMsg
+(
+    void* handle, ///< [IN] Opaque handle to the le_comm communication channel
+    rpcProxy_Message_t* headerPtr, ///< [IN] Message header, in Network-Order
+    const uint8_t* payloadPtr, ///< [IN] Message payload
+    size_t payloadSize ///< [IN] Size of the message payload
+)
+{
+    le_result_t result;
+
+    if (le_comm_SendV != NULL)
+    {
+        le_comm_IoVec_t iov[2] =
+        {
+            { .bufPtr = headerPtr, .len = RPC_PROXY_MSG_HEADER_SIZE },
+            { .bufPtr = payloadPtr, .len = payloadSize }
+        };
+
+        return le_comm_SendV(handle, iov, (payloadSize > 0) ? 2 : 1);
+    }
+
+    if (payloadPtr == &headerPtr->message[0])
+    {
+        return le_comm_Send(handle, headerPtr, RPC_PROXY_MSG_HEADER_SIZE + payloadSize);
+    }
+
+    // The receiver re-assembles the message, so it can be sent in two pieces
+    result = le_comm_Send(handle, headerPtr, RPC_PROXY_MSG_HEADER_SIZE);
+    if ((result == LE_OK) && (payloadSize > 0))
+    {
+        result = le_comm_Send(handle, payloadPtr, payloadSize);
+        if (result == LE_NO_MEMORY)
+        {
+            // The header went out without its payload: the stream cannot be resumed
+            result = LE_FAULT;
+        }
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for writing a prepared Proxy Message to the le_comm communication channel.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteMsg
+(
+    void* handle, ///< [IN] Opaque handle to the le_comm communication channel
+    void* sendMessagePtr, ///< [IN] Message, or message header if there is a separate payload
+    const uint8_t* payloadPtr, ///< [IN] Payload of a variable-length message, or NULL
+    size_t byteCount ///< [IN] Total size of the message
+)
+{
+    if (payloadPtr != NULL)
+    {
+        return SendVariableLengthMsg(handle,
+                                     sendMessagePtr,
+                                     payloadPtr,
+                                     byteCount - RPC_PROXY_MSG_HEADER_SIZE);
+    }
+
+    return le_comm_Send(handle, sendMessagePtr, byteCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer handler writing out the messages a congested communication channel could not take, in
+ * order, until the channel is congested again.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BacklogTimerExpiryHandler
+(
+    le_timer_Ref_t timerRef ///< [IN] Backlog timer
+)
+{
+    NetworkRecord_t* networkRecordPtr = le_timer_GetContextPtr(timerRef);
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Peek(&networkRecordPtr->backlog)) != NULL)
+    {
+        BacklogFrame_t* framePtr = CONTAINER_OF(linkPtr, BacklogFrame_t, link);
+        le_result_t result = le_comm_Send(networkRecordPtr->handle, &framePtr->data, framePtr->len);
+
+        if (result == LE_NO_MEMORY)
+        {
+            // Still congested
+            le_timer_Start(timerRef);
+            return;
+        }
+
+        if (result != LE_OK)
         {
-            rpcProxy_Message_t* proxyMessagePtr =
-                (rpcProxy_Message_t*) le_timer_GetContextPtr(timerRef);
+            LE_ERROR("le_comm_Send failed, handle [%d], result %d",
+                     le_comm_GetId(networkRecordPtr->handle), result);
 
-            if (proxyMessagePtr != NULL)
-            {
-                LE_INFO("Client-Request has timed out, "
-                        "service-id [%" PRIu32 "], proxy id [%" PRIu32 "]; "
-                        "check if client-response needs to be generated",
-                        proxyMessagePtr->commonHeader.serviceId,
-                        proxyMessagePtr->commonHeader.id);
-
-                // Retrieve Message Reference from hash map, using the Proxy Message Id
-                le_msg_MessageRef_t msgRef =
-                    le_hashmap_Get(MsgRefMapByProxyId,
-                                   (void*)(uintptr_t) proxyMessagePtr->commonHeader.id);
-
-                if (msgRef == NULL)
-                {
-                    LE_INFO("Unable to retrieve Message Reference, proxy id [%" PRIu32 "] - "
-                            "do not generate response message",
-                            proxyMessagePtr->commonHeader.id);
-                }
-                else
-                {
-                    // Generate LE_TIMEOUT Server-Response
-                    GenerateServerResponseErrorMessage(
-                        proxyMessagePtr,
-                        LE_TIMEOUT);
+            // Delete the Network Communication Channel, using the communication handle
+            rpcProxyNetwork_DeleteNetworkCommunicationChannelByHandle(networkRecordPtr->handle);
+            return;
+        }
 
-                    // Trigger a response back to the client
-                    ProcessServerResponse(NULL, proxyMessagePtr, NULL, true);
-                }
+        le_sls_Pop(&networkRecordPtr->backlog);
+        le_mem_Release(framePtr);
+    }
+}
 
-                // Remove entry from hash-map
-                le_hashmap_Remove(
-                    ExpiryTimerRefByProxyId,
-                    (void*)(uintptr_t) proxyMessagePtr->commonHeader.id);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for keeping a prepared Proxy Message, or a frame of coalesced messages, that the
+ * communication channel cannot take right now.  It is retried when the backlog timer expires.
+ *
+ * @return
+ *      - LE_OK if the message was kept.
+ *      - LE_NO_MEMORY if too many messages are kept already.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddToBacklog
+(
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the destination system
+    const void* sendMessagePtr, ///< [IN] Message, or message header if there is a separate payload
+    const uint8_t* payloadPtr, ///< [IN] Payload of a variable-length message, or NULL
+    size_t byteCount ///< [IN] Total size of the message
+)
+{
+    BacklogFrame_t* framePtr = le_mem_TryAlloc(BacklogFramePoolRef);
 
-                // Free Proxy Message Copy Memory
-                le_mem_Release(proxyMessagePtr);
-                proxyMessagePtr = NULL;
-            }
-            else
-            {
-                LE_ERROR("Unable to retrieve copy of the Proxy Message Reference");
-            }
-            break;
+    if ((framePtr == NULL) || (byteCount > sizeof(framePtr->data)))
+    {
+        LE_ERROR("Unable to keep %" PRIuS " bytes until the channel can take them", byteCount);
+        if (framePtr != NULL)
+        {
+            le_mem_Release(framePtr);
         }
+        return LE_NO_MEMORY;
+    }
 
-        default:
+    if (payloadPtr != NULL)
+    {
+        memcpy(&framePtr->data, sendMessagePtr, RPC_PROXY_MSG_HEADER_SIZE);
+        memcpy((uint8_t*)&framePtr->data + RPC_PROXY_MSG_HEADER_SIZE,
+               payloadPtr,
+               byteCount - RPC_PROXY_MSG_HEADER_SIZE);
+    }
+    else
+    {
+        memcpy(&framePtr->data, sendMessagePtr, byteCount);
+    }
+    framePtr->len = byteCount;
+    framePtr->link = LE_SLS_LINK_INIT;
+
+    if (le_sls_IsEmpty(&networkRecordPtr->backlog))
+    {
+        if (networkRecordPtr->backlogTimerRef == NULL)
         {
-            LE_ERROR("Unexpected Proxy Message, type [0x%x]", commonHeaderPtr->type);
-            break;
+            networkRecordPtr->backlogTimerRef = le_timer_Create("Network-Backlog timer");
+            le_timer_SetMsInterval(networkRecordPtr->backlogTimerRef,
+                                   RPC_PROXY_BACKLOG_RETRY_INTERVAL_MS);
+            le_timer_SetHandler(networkRecordPtr->backlogTimerRef, BacklogTimerExpiryHandler);
+            le_timer_SetContextPtr(networkRecordPtr->backlogTimerRef, networkRecordPtr);
         }
+        le_timer_Start(networkRecordPtr->backlogTimerRef);
     }
+    le_sls_Queue(&networkRecordPtr->backlog, &framePtr->link);
 
-    // Delete Timer
-    le_timer_Delete(timerRef);
-    timerRef = NULL;
-
-exit:
-    return;
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Function for retrieving the Expiry Timer Hash-map reference.
+ * Function for sending a prepared Proxy Message to a system.  If the communication channel is
+ * congested, the message is kept and sent later; messages sent meanwhile are kept behind it, so
+ * that they stay in order.
  */
 //--------------------------------------------------------------------------------------------------
-le_hashmap_Ref_t rpcProxy_GetExpiryTimerRefByProxyId
+static le_result_t SendOrKeepMsg
 (
-    void
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the destination system
+    void* sendMessagePtr, ///< [IN] Message, or message header if there is a separate payload
+    const uint8_t* payloadPtr, ///< [IN] Payload of a variable-length message, or NULL
+    size_t byteCount ///< [IN] Total size of the message
 )
 {
-    return ExpiryTimerRefByProxyId;
+    if (le_sls_IsEmpty(&networkRecordPtr->backlog))
+    {
+        le_result_t result =
+            WriteMsg(networkRecordPtr->handle, sendMessagePtr, payloadPtr, byteCount);
+        if (result != LE_NO_MEMORY)
+        {
+            return result;
+        }
+    }
+
+    return AddToBacklog(networkRecordPtr, sendMessagePtr, payloadPtr, byteCount);
 }
 
+#if RPC_PROXY_COALESCE_BUFFER_SIZE > 0
 //--------------------------------------------------------------------------------------------------
 /**
- * Function for retrieving the Service-ID Hash-map reference.
+ * Function for writing out the Proxy Messages coalesced for a system, in one frame.
  */
 //--------------------------------------------------------------------------------------------------
-le_hashmap_Ref_t rpcProxy_GetServiceIDMapByName
+static le_result_t FlushCoalescedMsgs
 (
-    void
+    NetworkRecord_t* networkRecordPtr ///< [IN] Network Record of the destination system
 )
 {
-    return ServiceIDMapByName;
+    NetworkCoalesceState_t* coalesceStatePtr = &networkRecordPtr->coalesceState;
+    le_result_t result;
+
+    if (coalesceStatePtr->len == 0)
+    {
+        return LE_OK;
+    }
+
+    result = SendOrKeepMsg(networkRecordPtr, coalesceStatePtr->buffer, NULL, coalesceStatePtr->len);
+    coalesceStatePtr->len = 0;
+
+    return result;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Function for generating unique Proxy Message IDs
+ * Function queued on the event loop to write out the Proxy Messages coalesced for a system, once
+ * the current pass of the event loop is over.
  */
 //--------------------------------------------------------------------------------------------------
-uint32_t rpcProxy_GenerateProxyMessageId
+static void CoalescedMsgsFlushHandler
 (
-    void
+    void* param1Ptr, ///< [IN] Network Record of the destination system
+    void* param2Ptr  ///< [IN] Unused
 )
 {
-    // Proxy Message ID Generator
-    // Monotonically increase proxy message ID to ensure each
-    // client request is uniquely identified
-    GlobalMsgId++;
+    NetworkRecord_t* networkRecordPtr = param1Ptr;
 
-    return GlobalMsgId;
+    LE_UNUSED(param2Ptr);
+
+    networkRecordPtr->coalesceState.flushQueued = false;
+
+    if (FlushCoalescedMsgs(networkRecordPtr) != LE_OK)
+    {
+        LE_ERROR("le_comm_Send failed, handle [%d]", le_comm_GetId(networkRecordPtr->handle));
+
+        // Delete the Network Communication Channel, using the communication handle
+        rpcProxyNetwork_DeleteNetworkCommunicationChannelByHandle(networkRecordPtr->handle);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Allocate new rpcProxy message
+ * Function for adding a prepared Proxy Message to the messages coalesced for a system.  They are
+ * written out together when the current pass of the event loop is over, or when the buffer is
+ * full.
  */
 //--------------------------------------------------------------------------------------------------
-rpcProxy_Message_t* rpcProxy_AllocateNewMessage
+static le_result_t CoalesceMsg
 (
-    void
+    NetworkRecord_t* networkRecordPtr, ///< [IN] Network Record of the destination system
+    void* sendMessagePtr, ///< [IN] Message, or message header if there is a separate payload
+    const uint8_t* payloadPtr, ///< [IN] Payload of a variable-length message, or NULL
+    size_t byteCount ///< [IN] Total size of the message
 )
 {
-    return le_mem_Alloc(ProxyMessagesPoolRef);
-}
+    NetworkCoalesceState_t* coalesceStatePtr = &networkRecordPtr->coalesceState;
+    uint8_t* destPtr;
+
+    if (byteCount > (sizeof(coalesceStatePtr->buffer) - coalesceStatePtr->len))
+    {
+        le_result_t result = FlushCoalescedMsgs(networkRecordPtr);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+
+    destPtr = &coalesceStatePtr->buffer[coalesceStatePtr->len];
+    if (payloadPtr != NULL)
+    {
+        memcpy(destPtr, sendMessagePtr, RPC_PROXY_MSG_HEADER_SIZE);
+        memcpy(destPtr + RPC_PROXY_MSG_HEADER_SIZE,
+               payloadPtr,
+               byteCount - RPC_PROXY_MSG_HEADER_SIZE);
+    }
+    else
+    {
+        memcpy(destPtr, sendMessagePtr, byteCount);
+    }
+    coalesceStatePtr->len += byteCount;
+
+    if (!coalesceStatePtr->flushQueued)
+    {
+        coalesceStatePtr->flushQueued = true;
+        le_event_QueueFunction(CoalescedMsgsFlushHandler, networkRecordPtr, NULL);
+    }
 
+    return LE_OK;
+}
+#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -789,8 +1647,10 @@ le_result_t rpcProxy_SendMsg
     le_result_t         result;
     size_t              byteCount;
     rpcProxy_Message_t  tmpProxyMessage;
-    rpcProxy_Message_t *proxyMessagePtr;
+    rpcProxy_Message_t *proxyMessagePtr = NULL;
     void               *sendMessagePtr;
+    uint8_t            *payloadPtr = NULL;
+    bool                repackedInPlace = false;
 
     // Retrieve the Network Record for this system
     NetworkRecord_t* networkRecordPtr =
@@ -870,8 +1730,7 @@ le_result_t rpcProxy_SendMsg
             {
                 return result;
             }
-            // proxy message (header + message)
-            byteCount = RPC_PROXY_MSG_HEADER_SIZE + tmpProxyMessage.msgSize;
+            payloadPtr = &tmpProxyMessage.message[0];
 
             // Prepare the Proxy Message Common Header
             commonHeaderPtr->id = htobe32(commonHeaderPtr->id);
@@ -883,9 +1742,7 @@ le_result_t rpcProxy_SendMsg
             tmpProxyMessage.commonHeader.type =
                 proxyMessagePtr->commonHeader.type;
 
-            // Put msgSize into Network-Order before sending
-            tmpProxyMessage.msgSize = htobe16(tmpProxyMessage.msgSize);
-            // Set send pointer to the message pointer
+            // Set send pointer to the message header
             sendMessagePtr = &tmpProxyMessage;
             break;
         }
@@ -903,23 +1760,31 @@ le_result_t rpcProxy_SendMsg
             LE_LOG_DUMP(LE_LOG_INFO, proxyMessagePtr->message, proxyMessagePtr->msgSize);
 #endif
 
-            // Re-package proxy message before sending
-            result = RepackMessage(proxyMessagePtr, &tmpProxyMessage, NULL, metaDataPtr, true);
-            if (result != LE_OK)
+            if (IsRepackInPlace(proxyMessagePtr, metaDataPtr, true))
             {
-                return result;
+                // Re-package proxy message in place, and send the payload straight from it
+                RepackMsgIdInPlace(proxyMessagePtr, true);
+                repackedInPlace = true;
+                tmpProxyMessage.msgSize = proxyMessagePtr->msgSize;
+                payloadPtr = &proxyMessagePtr->message[0];
+            }
+            else
+            {
+                // Re-package proxy message before sending
+                result = RepackMessage(proxyMessagePtr, &tmpProxyMessage, NULL, metaDataPtr, true);
+                if (result != LE_OK)
+                {
+                    return result;
+                }
+                payloadPtr = &tmpProxyMessage.message[0];
             }
 
 #if RPC_PROXY_HEX_DUMP
             LE_INFO("send:%s after repack, size: %d", DisplayMessageType(commonHeaderPtr->type),
                     tmpProxyMessage.msgSize);
-            LE_LOG_DUMP(LE_LOG_INFO, tmpProxyMessage.message, tmpProxyMessage.msgSize);
+            LE_LOG_DUMP(LE_LOG_INFO, payloadPtr, tmpProxyMessage.msgSize);
 #endif
 
-            // Calculate the total size of the repacked
-            // proxy message (header + message)
-            byteCount = RPC_PROXY_MSG_HEADER_SIZE + tmpProxyMessage.msgSize;
-
             //
             // Prepare the Proxy Common Message Header of the tmpProxyMessage
             //
@@ -934,10 +1799,7 @@ le_result_t rpcProxy_SendMsg
             tmpProxyMessage.commonHeader.type =
                 proxyMessagePtr->commonHeader.type;
 
-            // Put msgSize into Network-Order before sending
-            tmpProxyMessage.msgSize = htobe16(tmpProxyMessage.msgSize);
-
-            // Set send pointer to the tmpProxyMessage
+            // Set send pointer to the message header
             sendMessagePtr = &tmpProxyMessage;
             break;
         }
@@ -950,6 +1812,36 @@ le_result_t rpcProxy_SendMsg
         }
     } // End of switch-statement
 
+    if (payloadPtr != NULL)
+    {
+        //
+        // Variable-length message: header in tmpProxyMessage, payload at payloadPtr
+        //
+        size_t payloadSize = tmpProxyMessage.msgSize;
+
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+        if (networkRecordPtr->compression && (payloadSize >= RPC_PROXY_COMPRESSION_THRESHOLD))
+        {
+            size_t compressedSize = rpcProxyCompress_Compress(payloadPtr,
+                                                              payloadSize,
+                                                              CompressionBuffer,
+                                                              sizeof(CompressionBuffer));
+            if (compressedSize > 0)
+            {
+                tmpProxyMessage.commonHeader.type |= RPC_PROXY_COMPRESSED_FLAG;
+                payloadPtr = CompressionBuffer;
+                payloadSize = compressedSize;
+            }
+        }
+#endif
+
+        // Calculate the total size of the proxy message (header + message)
+        byteCount = RPC_PROXY_MSG_HEADER_SIZE + payloadSize;
+
+        // Put msgSize into Network-Order before sending
+        tmpProxyMessage.msgSize = htobe16((uint16_t) payloadSize);
+    }
+
     LE_DEBUG("Sending %s Proxy Message, service-id [%" PRIu32 "], "
              "proxy id [%" PRIu32 "], size [%" PRIuS "]",
              DisplayMessageType(commonHeaderPtr->type),
@@ -958,7 +1850,30 @@ le_result_t rpcProxy_SendMsg
              byteCount);
 
     // Send the Message Payload as an outgoing Proxy Message to the far-size RPC Proxy
-    result = le_comm_Send(networkRecordPtr->handle, sendMessagePtr, byteCount);
+#if RPC_PROXY_COALESCE_BUFFER_SIZE > 0
+    if (byteCount <= (RPC_PROXY_COALESCE_BUFFER_SIZE / 2))
+    {
+        result = CoalesceMsg(networkRecordPtr, sendMessagePtr, payloadPtr, byteCount);
+    }
+    else
+    {
+        // Write out the messages coalesced so far first, to keep the messages in order
+        result = FlushCoalescedMsgs(networkRecordPtr);
+        if (result == LE_OK)
+        {
+            result = SendOrKeepMsg(networkRecordPtr, sendMessagePtr, payloadPtr, byteCount);
+        }
+    }
+#else
+    result = SendOrKeepMsg(networkRecordPtr, sendMessagePtr, payloadPtr, byteCount);
+#endif
+
+    if (repackedInPlace)
+    {
+        // Restore the Msg ID
+        RepackMsgIdInPlace(proxyMessagePtr, false);
+    }
+
     if (result != LE_OK)
     {
         // Delete the Network Communication Channel
@@ -986,6 +1901,52 @@ static void AdvanceRecvMsgState
     msgStatePtr->recvState = NetworkMessageNextRecvState[msgStatePtr->recvState];
 }
 
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for decompressing a received Proxy Message in the receive buffer, if it is compressed.
+ *
+ * @return
+ *      - LE_OK if the message is not compressed, or has been decompressed.
+ *      - LE_FORMAT_ERROR if the compressed payload is not valid.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t DecompressMsg
+(
+    NetworkMessageState_t* msgStatePtr, ///< [IN] Pointer to the Message State-Machine data
+    size_t* bufferSizePtr ///< [INOUT] Pointer to the size of the message in the buffer
+)
+{
+    rpcProxy_Message_t* proxyMessagePtr = (rpcProxy_Message_t*) msgStatePtr->buffer;
+    size_t msgSize = sizeof(CompressionBuffer);
+    le_result_t result;
+
+    if (!(proxyMessagePtr->commonHeader.type & RPC_PROXY_COMPRESSED_FLAG))
+    {
+        return LE_OK;
+    }
+
+    result = rpcProxyCompress_Decompress(proxyMessagePtr->message,
+                                         be16toh(proxyMessagePtr->msgSize),
+                                         CompressionBuffer,
+                                         &msgSize);
+    if (result != LE_OK)
+    {
+        LE_ERROR("Invalid compressed Proxy Message, type [0x%x], result [%d]; Dropping packet",
+                 proxyMessagePtr->commonHeader.type,
+                 result);
+        return LE_FORMAT_ERROR;
+    }
+
+    memcpy(proxyMessagePtr->message, CompressionBuffer, msgSize);
+    proxyMessagePtr->msgSize = htobe16((uint16_t) msgSize);
+    proxyMessagePtr->commonHeader.type &= ~RPC_PROXY_COMPRESSED_FLAG;
+    *bufferSizePtr = RPC_PROXY_MSG_HEADER_SIZE + msgSize;
+
+    return LE_OK;
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function for receiving Proxy Messages from the far side via the le_comm API
@@ -1024,8 +1985,18 @@ static le_result_t RecvMsg
             // Set a pointer to the common message header
             rpcProxy_CommonHeader_t *commonHeaderPtr =
                 (rpcProxy_CommonHeader_t*) msgStatePtr->buffer;
+            uint8_t type = commonHeaderPtr->type;
+
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+            if ((type & RPC_PROXY_COMPRESSED_FLAG) &&
+                IsVariableLengthType(type & ~RPC_PROXY_COMPRESSED_FLAG))
+            {
+                // Compressed payload - decompressed once the message is complete
+                type &= ~RPC_PROXY_COMPRESSED_FLAG;
+            }
+#endif
 
-            switch(commonHeaderPtr->type)
+            switch(type)
             {
                 case RPC_PROXY_CONNECT_SERVICE_REQUEST:
                 case RPC_PROXY_CONNECT_SERVICE_RESPONSE:
@@ -1055,7 +2026,7 @@ static le_result_t RecvMsg
                     break;
             }
             msgStatePtr->recvSize = 0;
-            msgStatePtr->type = commonHeaderPtr->type;
+            msgStatePtr->type = type;
         }
         else if (msgStatePtr->recvState == NETWORK_MSG_MESSAGE) // MESSAGE State
         {
@@ -1154,6 +2125,14 @@ static le_result_t RecvMsg
 
     } // While-loop
 
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+    result = DecompressMsg(msgStatePtr, bufferSizePtr);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+#endif
+
     // Pre-process the buffer before processing the message payload
     result = PreProcessResponse(msgStatePtr->buffer, bufferSizePtr, sessionRefPtr, metaDataPtr);
     return result;
@@ -2129,6 +3108,16 @@ static le_result_t PreProcessResponse
             LE_LOG_DUMP(LE_LOG_INFO, proxyMessagePtr->message, proxyMessagePtr->msgSize);
 #endif
 
+            if (IsRepackInPlace(proxyMessagePtr, NULL, false))
+            {
+                // Re-package proxy message in place
+                metaDataPtr->fileStreamId = 0;
+                metaDataPtr->fileStreamFlags = 0;
+                metaDataPtr->isFileStreamValid = false;
+                RepackMsgIdInPlace(proxyMessagePtr, false);
+                break;
+            }
+
             // Re-package proxy message before processing
             result = RepackMessage(proxyMessagePtr, &tmpProxyMessage, sessionRefPtr, metaDataPtr, false);
             if (result != LE_OK)
@@ -2223,72 +3212,43 @@ static void ProcessServerResponse
     // Check if a client response is required
     if (le_msg_NeedsResponse(msgRef))
     {
-        // Check if timer needs to be cleaned up
+        // Check if the Client-Request Record needs to be cleaned up
         if (!triggeredByTimer)
         {
-            // Retrieve and delete timer associated with Proxy Message ID
-            le_timer_Ref_t timerRef =
+            // Retrieve the Client-Request Record associated with Proxy Message ID
+            rpcProxy_ClientRequestRecord_t* recordPtr =
                 le_hashmap_Get(
-                    ExpiryTimerRefByProxyId,
+                    ClientRequestByProxyId,
                     (void*)(uintptr_t) proxyMessagePtr->commonHeader.id);
 
-            if (timerRef != NULL)
+            if (recordPtr != NULL)
             {
-                rpcProxy_Message_t* proxyMessageCopyPtr = NULL;
+                // Sanity Check - Verify Proxy Message ID and Service-Name
+                if ((recordPtr->messagePtr->commonHeader.id !=
+                        proxyMessagePtr->commonHeader.id) ||
+                    (recordPtr->messagePtr->commonHeader.serviceId !=
+                        proxyMessagePtr->commonHeader.serviceId))
+                {
+                    // Proxy Messages are different
+                    LE_ERROR("Proxy Message Sanity Failure - inconsistent Client-Request record");
+                }
 
-                LE_DEBUG("Deleting timer for Client-Request, "
+                LE_DEBUG("Releasing Client-Request, "
                          "service-id [%" PRIu32 "], id [%" PRIu32 "]",
                          proxyMessagePtr->commonHeader.serviceId,
                          proxyMessagePtr->commonHeader.id);
 
-                // Remove timer entry associated with Proxy Message ID from hash-map
-                le_hashmap_Remove(
-                    ExpiryTimerRefByProxyId,
-                    (void*)(uintptr_t) proxyMessagePtr->commonHeader.id);
-
-                //
-                // Clean up Proxy Message Copy
-                //
-
-                // Retrieve ContextPtr data (proxyMessage copy)
-                proxyMessageCopyPtr = le_timer_GetContextPtr(timerRef);
-
-                if (proxyMessageCopyPtr == NULL)
-                {
-                    LE_ERROR("Error extracting copy of Proxy Message from timer record");
-                }
-                else
-                {
-                    // Sanity Check - Verify Proxy Message ID and Service-Name
-                    if ((proxyMessageCopyPtr->commonHeader.id !=
-                            proxyMessagePtr->commonHeader.id) ||
-                        (proxyMessageCopyPtr->commonHeader.serviceId !=
-                            proxyMessagePtr->commonHeader.serviceId))
-                    {
-                        // Proxy Messages are different
-                        LE_ERROR("Proxy Message Sanity Failure - inconsistent timer record");
-                    }
-
-                    LE_DEBUG("Deleting copy of Proxy Message, "
-                             "service-id [%" PRIu32 "], id [%" PRIu32 "]",
-                             proxyMessageCopyPtr->commonHeader.serviceId,
-                             proxyMessageCopyPtr->commonHeader.id);
-
-                    // Free Proxy Message Copy Memory
-                    le_mem_Release(proxyMessageCopyPtr);
-                }
-
-                // Delete Timer
-                le_timer_Delete(timerRef);
-                timerRef = NULL;
+                // Free the Client-Request and its place in the in-flight window
+                RemoveFromExpiryWheel(recordPtr);
+                ReleaseClientRequest(recordPtr);
             }
             else
             {
-                LE_ERROR("Unable to find Timer record, proxy id [%" PRIu32 "]",
+                LE_ERROR("Unable to find Client-Request record, proxy id [%" PRIu32 "]",
                          proxyMessagePtr->commonHeader.id);
             }
 
-        } // cleanUpTimer
+        } // cleanUpClientRequest
 
 
         if(!triggeredByTimer && rpcFStream_HandleStreamId(msgRef, metaDataPtr,
@@ -3353,7 +4313,7 @@ static void ServerMsgRecvHandler
 )
 {
     rpcProxy_Message_t *proxyMessagePtr = NULL;
-    le_result_t         result;
+    rpcProxy_ClientRequestRecord_t *recordPtr = NULL;
     bool                send = true;
 
     // Confirm context pointer is valid
@@ -3430,71 +4390,58 @@ static void ServerMsgRecvHandler
         proxyMessagePtr->commonHeader.serviceId = *serviceIdPtr;
     }
 
-    // Check if message should be sent to the far-side
-    if (!send)
-    {
-        goto exit;
-    }
-
-    rpcProxy_MessageMetadata_t metaData;
-    if (rpcFStream_HandleFileDescriptor(msgRef, &metaData, *serviceIdPtr, systemName) != LE_OK)
+    // Check if message should be sent to the far-side, or if client requires a response
+    if (!send && !le_msg_NeedsResponse(msgRef))
     {
-        LE_ERROR("Error in handling file descriptor in the ipc message");
-        // we're still sending the main message to the other side but fd will be -1.
+        le_mem_Release(proxyMessagePtr);
+        return;
     }
 
-    // Send a request to the server and get the response.
-    LE_DEBUG("Sending message to '%s' RPC Proxy and waiting for response : %u bytes sent",
-             systemName,
-             proxyMessagePtr->msgSize);
-
-    // Send Proxy Message to far-side
-    result = rpcProxy_SendMsg(systemName, proxyMessagePtr, &metaData);
-    if (result != LE_OK)
-    {
-        LE_ERROR("le_comm_Send failed, result %d", result);
-        rpcFStream_DeleteOurStream(metaData.fileStreamId, systemName);
-    }
+    // Allocate a Client-Request Record to track the message
+    recordPtr = le_mem_Alloc(ProxyClientRequestRecordPoolRef);
+    recordPtr->wheelLink = LE_DLS_LINK_INIT;
+    recordPtr->queueLink = LE_DLS_LINK_INIT;
+    recordPtr->messagePtr = proxyMessagePtr;
+    recordPtr->state = RPC_PROXY_CLIENT_REQUEST_DETACHED;
+    recordPtr->needsResponse = le_msg_NeedsResponse(msgRef);
+    le_utf8_Copy(recordPtr->systemName, systemName, sizeof(recordPtr->systemName), NULL);
 
-exit:
-    // Check if client requires a response
-    if (le_msg_NeedsResponse(msgRef))
+    if (recordPtr->needsResponse)
     {
         //
-        // Client requires a response - Set-up a timer in the event
+        // Client requires a response - Put the request on the expiry wheel in the event
         // we do not hear back from the far-side RPC Proxy
         //
-        le_timer_Ref_t clientRequestTimerRef;
-        le_clk_Time_t  timerInterval = {.sec=RPC_PROXY_CLIENT_REQUEST_TIMER_INTERVAL, .usec=0 };
+        AddToExpiryWheel(recordPtr);
 
-        // Create a timer to handle "lost" requests
-        clientRequestTimerRef = le_timer_Create("Client-Request timer");
-        le_timer_SetInterval(clientRequestTimerRef, timerInterval);
-        le_timer_SetHandler(clientRequestTimerRef, rpcProxy_ProxyMessageTimerExpiryHandler);
-        le_timer_SetWakeup(clientRequestTimerRef, false);
-
-        // Set Proxy Message (copy) in the timer event
-        le_timer_SetContextPtr(clientRequestTimerRef, proxyMessagePtr);
-
-        // Start timer
-        le_timer_Start(clientRequestTimerRef);
-
-        // Store the timerRef in a hashmap, using the Proxy Message ID as a key, so that
+        // Store the record in a hashmap, using the Proxy Message ID as a key, so that
         // it can be retrieved later
-        le_hashmap_Put(ExpiryTimerRefByProxyId,
+        le_hashmap_Put(ClientRequestByProxyId,
                        (void*)(uintptr_t) proxyMessagePtr->commonHeader.id,
-                       clientRequestTimerRef);
+                       recordPtr);
 
-        LE_DEBUG("Starting timer (%d secs.) for Client-Request, "
+        LE_DEBUG("Expiring Client-Request in %d secs., "
                  "service-name [%s], id [%" PRIu32 "]",
                  RPC_PROXY_CLIENT_REQUEST_TIMER_INTERVAL,
                  serviceName,
                  proxyMessagePtr->commonHeader.id);
     }
-    else
+
+    // Service is not available - left to time out
+    if (!send)
     {
-        le_mem_Release(proxyMessagePtr);
+        return;
+    }
+
+    if (rpcFStream_HandleFileDescriptor(msgRef, &recordPtr->metaData, *serviceIdPtr,
+                                        systemName) != LE_OK)
+    {
+        LE_ERROR("Error in handling file descriptor in the ipc message");
+        // we're still sending the main message to the other side but fd will be -1.
     }
+
+    // Send a request to the server, or queue it if the in-flight window is full
+    SubmitClientRequest(recordPtr);
 }
 
 
@@ -4148,6 +5095,10 @@ le_result_t le_rpcProxy_Initialize
                                                  RPC_PROXY_MSG_REFERENCE_MAX_NUM,
                                                  sizeof(rpcProxy_Message_t));
 
+    BacklogFramePoolRef = le_mem_InitStaticPool(BacklogFramePool,
+                                                RPC_PROXY_BACKLOG_FRAME_MAX_NUM,
+                                                sizeof(BacklogFrame_t));
+
     ProxyConnectServiceMessagesPoolRef = le_mem_InitStaticPool(
                                              ProxyConnectServiceMessagePool,
                                              RPC_PROXY_MSG_REFERENCE_MAX_NUM,
@@ -4158,6 +5109,11 @@ le_result_t le_rpcProxy_Initialize
                                                   RPC_PROXY_MSG_REFERENCE_MAX_NUM,
                                                   sizeof(rpcProxy_ClientRequestResponseRecord_t));
 
+    ProxyClientRequestRecordPoolRef = le_mem_InitStaticPool(
+                                          ProxyClientRequestRecordPool,
+                                          RPC_PROXY_MSG_REFERENCE_MAX_NUM,
+                                          sizeof(rpcProxy_ClientRequestRecord_t));
+
     rpcFStream_InitFileStreamPool();
 
 #ifdef RPC_PROXY_LOCAL_SERVICE
@@ -4216,6 +5172,23 @@ le_result_t le_rpcProxy_Initialize
                                                       le_hashmap_HashVoidPointer,
                                                       le_hashmap_EqualsVoidPointer);
 
+    // Create hash map for Client-Request Records, using the Proxy Message ID (key).
+    ClientRequestByProxyId = le_hashmap_InitStatic(ClientRequestHashMap,
+                                                   RPC_PROXY_MSG_REFERENCE_MAX_NUM,
+                                                   le_hashmap_HashVoidPointer,
+                                                   le_hashmap_EqualsVoidPointer);
+
+    // Create the Client-Request expiry wheel, and the timer ticking it
+    for (uint32_t slot = 0; slot < EXPIRY_WHEEL_SLOTS; slot++)
+    {
+        ExpiryWheel[slot] = LE_DLS_LIST_INIT;
+    }
+    ExpiryWheelTimerRef = le_timer_Create("Client-Request expiry wheel");
+    le_timer_SetMsInterval(ExpiryWheelTimerRef, 1000);
+    le_timer_SetRepeat(ExpiryWheelTimerRef, 0);
+    le_timer_SetHandler(ExpiryWheelTimerRef, ExpiryWheelTimerHandler);
+    le_timer_SetWakeup(ExpiryWheelTimerRef, false);
+
     // Create hash map for Request-Response Record references, using the Proxy Message ID (key).
     RequestResponseRefByProxyId = le_hashmap_InitStatic(
                                       RequestResponseRefHashMap,
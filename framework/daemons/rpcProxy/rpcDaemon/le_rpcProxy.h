@@ -65,6 +65,20 @@
 #define RPC_PROXY_NETWORK_KEEPALIVE_TIMEOUT_TIMER_INTERVAL  \
             (LE_CONFIG_RPC_PROXY_NETWORK_KEEPALIVE_TIMEOUT_TIMER_INTERVAL)
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of Client-Requests awaiting a response from one remote system.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_IN_FLIGHT_WINDOW             LE_CONFIG_RPC_PROXY_IN_FLIGHT_WINDOW
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer in which messages to one remote system are coalesced (0 if disabled).
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_COALESCE_BUFFER_SIZE         LE_CONFIG_RPC_PROXY_COALESCE_BUFFER_SIZE
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -104,6 +118,34 @@
 #define RPC_PROXY_SERVER_ASYNC_EVENT           9
 #define RPC_PROXY_FILESTREAM_MESSAGE           10
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy Message Type flag, set on variable-length messages whose payload is compressed
+ * (see le_rpcProxyCompress.h).  msgSize is then the size of the compressed payload.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_COMPRESSED_FLAG              0x80
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy Link Capabilities, carried in the service-id field of the Keep-Alive messages (which
+ * older RPC Proxies set to zero in requests, and echo back in responses).
+ *
+ * An RPC Proxy that can decompress messages sets OFFER in its requests, and sets ACCEPT in its
+ * responses to requests that have OFFER set.  Each side only compresses the messages it sends
+ * once it has seen the far side's OFFER or ACCEPT.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_LINK_CAP_COMPRESSION_OFFER   0x1
+#define RPC_PROXY_LINK_CAP_COMPRESSION_ACCEPT  0x2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Smallest payload the RPC Proxy attempts to compress.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_COMPRESSION_THRESHOLD        LE_CONFIG_RPC_PROXY_COMPRESSION_THRESHOLD
+
 //--------------------------------------------------------------------------------------------------
 /**
  * RPC Proxy Common Message Header Structure
@@ -193,6 +235,38 @@ typedef struct rpcProxy_ClientRequestResponseRecord
 }
 rpcProxy_ClientRequestResponseRecord_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy Client-Request window state
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    RPC_PROXY_CLIENT_REQUEST_QUEUED = 0, ///< Waiting for room in the in-flight window
+    RPC_PROXY_CLIENT_REQUEST_IN_FLIGHT,  ///< Sent, and holding a place in the in-flight window
+    RPC_PROXY_CLIENT_REQUEST_DETACHED    ///< Holding no place (send failed, or network reset)
+}
+rpcProxy_ClientRequestState_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy Client-Request Record Structure, tracking a Client-Request sent (or to be sent) to a
+ * remote system.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct rpcProxy_ClientRequestRecord
+{
+    le_dls_Link_t                 wheelLink;   ///< Link in an expiry wheel slot
+    le_dls_Link_t                 queueLink;   ///< Link in the system's window queue
+    rpcProxy_Message_t*           messagePtr;  ///< Client-Request Proxy Message
+    rpcProxy_MessageMetadata_t    metaData;    ///< Metadata of the Client-Request
+    uint32_t                      expiryTick;  ///< Expiry wheel tick the request times out at
+    rpcProxy_ClientRequestState_t state;       ///< In-flight window state
+    bool                          needsResponse; ///< Client expects a response
+    char  systemName[LIMIT_MAX_SYSTEM_NAME_BYTES]; ///< Destination of the request
+}
+rpcProxy_ClientRequestRecord_t;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -366,6 +440,17 @@ void rpcProxy_DisconnectSessions
     const char* systemName ///< [IN] Name of System on which to disconnect sessions
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset the Client-Request window and the coalesced messages of a system whose Network
+ * Connection has failed.
+ */
+//--------------------------------------------------------------------------------------------------
+void rpcProxy_ResetLinkState
+(
+    const char* systemName ///< [IN] Name of System whose Network Connection has failed
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function for generating unique Proxy Message IDs
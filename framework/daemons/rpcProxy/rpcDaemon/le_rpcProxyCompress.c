@@ -0,0 +1,373 @@
+/**
+ * @file le_rpcProxyCompress.c
+ *
+ * This file contains the source code for the RPC Proxy message compression codec.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "le_rpcProxyCompress.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shortest match that is encoded as a back-reference.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MIN_MATCH           4
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest back-reference distance (the offset is encoded on 16 bits).  Also bounds the size of
+ * the data the compressor accepts, so that positions fit in its hash table.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_OFFSET          0xFFFF
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mask of a length nibble in the token.  A nibble of all ones means more length bytes follow.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TOKEN_LENGTH_MASK   0x0F
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bits in the match finder's hash.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HASH_BITS           10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read four bytes from a possibly unaligned position.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t Read32
+(
+    const uint8_t* ptr
+)
+{
+    uint32_t value;
+
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash the four bytes at the start of a possible match.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t Hash
+(
+    uint32_t value
+)
+{
+    return (value * 2654435761U) >> (32 - HASH_BITS);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the extension bytes of a literal or match length that did not fit in the token.
+ *
+ * @return Pointer past the bytes written, or NULL if they do not fit before the limit.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* WriteLength
+(
+    uint8_t* outPtr,            ///< [IN] Where to write.
+    const uint8_t* limitPtr,    ///< [IN] End of the space available.
+    size_t length               ///< [IN] Length minus the value already held by the token.
+)
+{
+    while (length >= 255)
+    {
+        if (outPtr >= limitPtr)
+        {
+            return NULL;
+        }
+        *outPtr++ = 255;
+        length -= 255;
+    }
+
+    if (outPtr >= limitPtr)
+    {
+        return NULL;
+    }
+    *outPtr++ = (uint8_t)length;
+
+    return outPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write one sequence: literals, then an optional match.
+ *
+ * @return Pointer past the sequence, or NULL if it does not fit before the limit.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* WriteSequence
+(
+    uint8_t* outPtr,                ///< [IN] Where to write.
+    const uint8_t* limitPtr,        ///< [IN] End of the space available.
+    const uint8_t* literalPtr,      ///< [IN] Literals.
+    size_t literalLength,           ///< [IN] Number of literals.
+    size_t offset,                  ///< [IN] Match distance, or 0 for the final sequence.
+    size_t matchLength              ///< [IN] Match length (ignored for the final sequence).
+)
+{
+    uint8_t* tokenPtr = outPtr;
+    uint8_t token;
+
+    if (outPtr >= limitPtr)
+    {
+        return NULL;
+    }
+    outPtr++;
+
+    if (literalLength >= TOKEN_LENGTH_MASK)
+    {
+        token = TOKEN_LENGTH_MASK << 4;
+        outPtr = WriteLength(outPtr, limitPtr, literalLength - TOKEN_LENGTH_MASK);
+        if (outPtr == NULL)
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        token = (uint8_t)(literalLength << 4);
+    }
+
+    if ((size_t)(limitPtr - outPtr) < literalLength)
+    {
+        return NULL;
+    }
+    memcpy(outPtr, literalPtr, literalLength);
+    outPtr += literalLength;
+
+    if (offset != 0)
+    {
+        if ((limitPtr - outPtr) < 2)
+        {
+            return NULL;
+        }
+        *outPtr++ = (uint8_t)(offset & 0xFF);
+        *outPtr++ = (uint8_t)(offset >> 8);
+
+        matchLength -= MIN_MATCH;
+        if (matchLength >= TOKEN_LENGTH_MASK)
+        {
+            token |= TOKEN_LENGTH_MASK;
+            outPtr = WriteLength(outPtr, limitPtr, matchLength - TOKEN_LENGTH_MASK);
+            if (outPtr == NULL)
+            {
+                return NULL;
+            }
+        }
+        else
+        {
+            token |= (uint8_t)matchLength;
+        }
+    }
+
+    *tokenPtr = token;
+    return outPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the extension bytes of a literal or match length.
+ *
+ * @return false if the compressed data ends before the length does.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadLength
+(
+    const uint8_t** inPtrPtr,   ///< [INOUT] Read position.
+    const uint8_t* endPtr,      ///< [IN] End of the compressed data.
+    size_t* lengthPtr           ///< [INOUT] Length, incremented by the extension.
+)
+{
+    uint8_t byte;
+
+    do
+    {
+        if (*inPtrPtr >= endPtr)
+        {
+            return false;
+        }
+        byte = *(*inPtrPtr)++;
+        *lengthPtr += byte;
+    }
+    while (byte == 255);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compresses a buffer.
+ *
+ * @return
+ *      - Size of the compressed data, if it is smaller than the source data and fits in the
+ *        destination buffer.
+ *      - Zero, otherwise (the data should be sent uncompressed).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t rpcProxyCompress_Compress
+(
+    const uint8_t* srcPtr,  ///< [IN] Data to compress.
+    size_t srcSize,         ///< [IN] Size of the data to compress.
+    uint8_t* dstPtr,        ///< [OUT] Buffer to hold the compressed data.
+    size_t dstSize          ///< [IN] Size of the destination buffer.
+)
+{
+    // Positions (plus one, so that zero means empty) of recently seen four-byte sequences.
+    uint16_t hashTable[1 << HASH_BITS];
+    const uint8_t* limitPtr;
+    uint8_t* outPtr = dstPtr;
+    size_t anchor = 0;
+    size_t pos = 0;
+
+    if ((srcSize <= MIN_MATCH) || (srcSize >= MAX_OFFSET) || (dstSize == 0))
+    {
+        return 0;
+    }
+
+    // Only worth it if the result is smaller than the input.
+    limitPtr = dstPtr + ((dstSize < srcSize) ? dstSize : (srcSize - 1));
+
+    memset(hashTable, 0, sizeof(hashTable));
+
+    while (pos + MIN_MATCH <= srcSize)
+    {
+        uint32_t value = Read32(srcPtr + pos);
+        uint32_t hash = Hash(value);
+        size_t candidate = hashTable[hash];
+
+        hashTable[hash] = (uint16_t)(pos + 1);
+
+        if ((candidate == 0) ||
+            ((pos - (candidate - 1)) > MAX_OFFSET) ||
+            (Read32(srcPtr + candidate - 1) != value))
+        {
+            pos++;
+            continue;
+        }
+        candidate--;
+
+        size_t matchLength = MIN_MATCH;
+        while ((pos + matchLength < srcSize) &&
+               (srcPtr[candidate + matchLength] == srcPtr[pos + matchLength]))
+        {
+            matchLength++;
+        }
+
+        outPtr = WriteSequence(outPtr, limitPtr, srcPtr + anchor, pos - anchor,
+                               pos - candidate, matchLength);
+        if (outPtr == NULL)
+        {
+            return 0;
+        }
+
+        pos += matchLength;
+        anchor = pos;
+    }
+
+    outPtr = WriteSequence(outPtr, limitPtr, srcPtr + anchor, srcSize - anchor, 0, 0);
+    if (outPtr == NULL)
+    {
+        return 0;
+    }
+
+    return (size_t)(outPtr - dstPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompresses a buffer.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_OVERFLOW if the decompressed data does not fit in the destination buffer.
+ *      - LE_FORMAT_ERROR if the compressed data is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxyCompress_Decompress
+(
+    const uint8_t* srcPtr,  ///< [IN] Compressed data.
+    size_t srcSize,         ///< [IN] Size of the compressed data.
+    uint8_t* dstPtr,        ///< [OUT] Buffer to hold the decompressed data.
+    size_t* dstSizePtr      ///< [INOUT] Size of the destination buffer on input, size of the
+                            ///<         decompressed data on output.
+)
+{
+    const uint8_t* inPtr = srcPtr;
+    const uint8_t* inEndPtr = srcPtr + srcSize;
+    uint8_t* outPtr = dstPtr;
+    uint8_t* outEndPtr = dstPtr + *dstSizePtr;
+
+    while (inPtr < inEndPtr)
+    {
+        uint8_t token = *inPtr++;
+        size_t length = token >> 4;
+
+        // Literals
+        if ((length == TOKEN_LENGTH_MASK) && !ReadLength(&inPtr, inEndPtr, &length))
+        {
+            return LE_FORMAT_ERROR;
+        }
+        if ((size_t)(inEndPtr - inPtr) < length)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        if ((size_t)(outEndPtr - outPtr) < length)
+        {
+            return LE_OVERFLOW;
+        }
+        memcpy(outPtr, inPtr, length);
+        inPtr += length;
+        outPtr += length;
+
+        if (inPtr == inEndPtr)
+        {
+            // Final sequence has literals only
+            break;
+        }
+
+        // Match
+        if ((inEndPtr - inPtr) < 2)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        size_t offset = inPtr[0] | ((size_t)inPtr[1] << 8);
+        inPtr += 2;
+        if ((offset == 0) || (offset > (size_t)(outPtr - dstPtr)))
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        length = token & TOKEN_LENGTH_MASK;
+        if ((length == TOKEN_LENGTH_MASK) && !ReadLength(&inPtr, inEndPtr, &length))
+        {
+            return LE_FORMAT_ERROR;
+        }
+        length += MIN_MATCH;
+        if ((size_t)(outEndPtr - outPtr) < length)
+        {
+            return LE_OVERFLOW;
+        }
+
+        // Byte by byte, as the match may overlap the bytes it produces
+        const uint8_t* matchPtr = outPtr - offset;
+        while (length-- > 0)
+        {
+            *outPtr++ = *matchPtr++;
+        }
+    }
+
+    *dstSizePtr = (size_t)(outPtr - dstPtr);
+    return LE_OK;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file le_rpcProxyCompress.h
+ *
+ * Header file for the RPC Proxy message compression codec.
+ *
+ * The codec is a byte-oriented LZ77 scheme in the style of the LZ4 block format: the compressed
+ * data is a series of sequences, each made of a token byte, an optional literal-length extension,
+ * the literals, a 16-bit little-endian match offset and an optional match-length extension.  The
+ * final sequence has literals only.  It needs no state between messages, and the compressor's only
+ * working memory is a small hash table on the stack.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LE_RPC_PROXY_COMPRESS_H_INCLUDE_GUARD
+#define LE_RPC_PROXY_COMPRESS_H_INCLUDE_GUARD
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compresses a buffer.
+ *
+ * @return
+ *      - Size of the compressed data, if it is smaller than the source data and fits in the
+ *        destination buffer.
+ *      - Zero, otherwise (the data should be sent uncompressed).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t rpcProxyCompress_Compress
+(
+    const uint8_t* srcPtr,  ///< [IN] Data to compress.
+    size_t srcSize,         ///< [IN] Size of the data to compress.
+    uint8_t* dstPtr,        ///< [OUT] Buffer to hold the compressed data.
+    size_t dstSize          ///< [IN] Size of the destination buffer.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompresses a buffer.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_OVERFLOW if the decompressed data does not fit in the destination buffer.
+ *      - LE_FORMAT_ERROR if the compressed data is malformed.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t rpcProxyCompress_Decompress
+(
+    const uint8_t* srcPtr,  ///< [IN] Compressed data.
+    size_t srcSize,         ///< [IN] Size of the compressed data.
+    uint8_t* dstPtr,        ///< [OUT] Buffer to hold the decompressed data.
+    size_t* dstSizePtr      ///< [INOUT] Size of the destination buffer on input, size of the
+                            ///<         decompressed data on output.
+);
+
+#endif /* LE_RPC_PROXY_COMPRESS_H_INCLUDE_GUARD */
@@ -345,6 +345,11 @@ static void StartNetworkKeepAliveService
 
     // Start timer
     le_timer_Start(networkRecordPtr->keepAliveTimerRef);
+
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+    // Negotiate the link capabilities right away, rather than at the first Keep-Alive interval
+    rpcProxyNetwork_SendKeepAliveRequest(systemName);
+#endif
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -574,6 +579,15 @@ le_result_t rpcProxyNetwork_CreateNetworkCommunicationChannel
         networkRecordPtr->type = UNKNOWN;
         networkRecordPtr->handle = NULL;
         networkRecordPtr->keepAliveTimerRef = NULL;
+        networkRecordPtr->compression = false;
+        networkRecordPtr->inFlightCount = 0;
+        networkRecordPtr->windowQueue = LE_DLS_LIST_INIT;
+        networkRecordPtr->backlog = LE_SLS_LIST_INIT;
+        networkRecordPtr->backlogTimerRef = NULL;
+#if RPC_PROXY_COALESCE_BUFFER_SIZE > 0
+        networkRecordPtr->coalesceState.len = 0;
+        networkRecordPtr->coalesceState.flushQueued = false;
+#endif
 
         le_hashmap_Put(NetworkRecordHashMapByName, systemName, networkRecordPtr);
     }
@@ -747,6 +761,9 @@ void rpcProxyNetwork_DeleteNetworkCommunicationChannel
     rpcProxy_DisconnectSessions(systemName);
     rpcFStream_DeleteStreamsBySystemName(systemName);
 
+    // Drop the messages still waiting to be sent, and the far side's share of the window
+    rpcProxy_ResetLinkState(systemName);
+
     // Delete the Communication channel
     result = le_comm_Delete(networkRecordPtr->handle);
     networkRecordPtr->handle = NULL;
@@ -758,6 +775,9 @@ void rpcProxyNetwork_DeleteNetworkCommunicationChannel
     // Set Network Connection state to DOWN
     networkRecordPtr->state = NETWORK_DOWN;
 
+    // The far side's capabilities are negotiated again on the next connection
+    networkRecordPtr->compression = false;
+
     // Reset Network Message Re-assembly State-Machine
     networkRecordPtr->messageState.recvState = NETWORK_MSG_IDLE;
 
@@ -956,6 +976,19 @@ le_result_t rpcProxyNetwork_ProcessKeepAliveRequest
     // Set the Proxy Message type to SERVER_RESPONSE
     proxyMessagePtr->commonHeader.type = RPC_PROXY_KEEPALIVE_RESPONSE;
 
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+    // Accept compression if the far side offers it
+    if (proxyMessagePtr->commonHeader.serviceId & RPC_PROXY_LINK_CAP_COMPRESSION_OFFER)
+    {
+        if (!networkRecordPtr->compression)
+        {
+            LE_INFO("Compression enabled, system-name [%s]", systemName);
+            networkRecordPtr->compression = true;
+        }
+        proxyMessagePtr->commonHeader.serviceId = RPC_PROXY_LINK_CAP_COMPRESSION_ACCEPT;
+    }
+#endif
+
     LE_INFO("Sending Proxy KEEPALIVE-Response Message, id [%" PRIu32 "]",
              proxyMessagePtr->commonHeader.id);
 
@@ -1013,6 +1046,16 @@ le_result_t rpcProxyNetwork_ProcessKeepAliveResponse
                  proxyMessagePtr->systemName);
     }
 
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+    // Compress messages if the far side has accepted to
+    if ((proxyMessagePtr->commonHeader.serviceId & RPC_PROXY_LINK_CAP_COMPRESSION_ACCEPT) &&
+        !networkRecordPtr->compression)
+    {
+        LE_INFO("Compression enabled, system-name [%s]", systemName);
+        networkRecordPtr->compression = true;
+    }
+#endif
+
     // Retrieve and delete the timer associated with Proxy Message ID
     le_timer_Ref_t timerRef =
         le_hashmap_Get(rpcProxy_GetExpiryTimerRefByProxyId(),
@@ -1092,7 +1135,11 @@ void rpcProxyNetwork_SendKeepAliveRequest
     // Create an Keep-Alive Request Message
     proxyMessagePtr->commonHeader.id = rpcProxy_GenerateProxyMessageId();
     proxyMessagePtr->commonHeader.type = RPC_PROXY_KEEPALIVE_REQUEST;
+#if LE_CONFIG_RPC_PROXY_COMPRESSION
+    proxyMessagePtr->commonHeader.serviceId = RPC_PROXY_LINK_CAP_COMPRESSION_OFFER;
+#else
     proxyMessagePtr->commonHeader.serviceId = 0;
+#endif
 
     // Set the System-Name
     strncpy(proxyMessagePtr->systemName, systemName, sizeof(proxyMessagePtr->systemName) - 1);
@@ -33,6 +33,24 @@
 #define RPC_PROXY_RECV_BUFFER_MAX               (RPC_PROXY_MAX_MESSAGE + RPC_PROXY_MSG_HEADER_SIZE)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of messages, or frames of coalesced messages, kept while the communication
+ * channels are congested.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_BACKLOG_FRAME_MAX_NUM         (RPC_PROXY_NETWORK_SYSTEM_MAX_NUM * 8)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Interval at which the messages kept while a communication channel is congested are retried,
+ * in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RPC_PROXY_BACKLOG_RETRY_INTERVAL_MS     10
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * RPC Proxy Network Operational State definition
@@ -92,6 +110,21 @@ typedef struct NetworkMessageState
 }
 NetworkMessageState_t;
 
+#if RPC_PROXY_COALESCE_BUFFER_SIZE > 0
+//--------------------------------------------------------------------------------------------------
+/**
+ * RPC Proxy Network Message Coalescing structure
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct NetworkCoalesceState
+{
+    uint8_t  buffer[RPC_PROXY_COALESCE_BUFFER_SIZE]; ///< Messages waiting to be written
+    size_t   len;          ///< Number of bytes in the buffer
+    bool     flushQueued;  ///< A flush of the buffer is queued on the event loop
+}
+NetworkCoalesceState_t;
+#endif
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -104,7 +137,15 @@ typedef struct NetworkRecord
     NetworkState_t           state;     ///< Operational state of the network connection
     NetworkConnectionType_t  type;      ///< Type of network connection
     le_timer_Ref_t           keepAliveTimerRef; ///< Keep-Alive Timer Ref
+    bool                     compression; ///< Far side can decompress messages
+    uint32_t                 inFlightCount; ///< Client-Requests awaiting a response
+    le_dls_List_t            windowQueue; ///< Client-Requests waiting for room in the window
     NetworkMessageState_t    messageState; ///< Message Re-assembly State-Machine
+#if RPC_PROXY_COALESCE_BUFFER_SIZE > 0
+    NetworkCoalesceState_t   coalesceState; ///< Messages waiting to be written together
+#endif
+    le_sls_List_t            backlog;   ///< Messages the channel could not take yet, in order
+    le_timer_Ref_t           backlogTimerRef; ///< Timer retrying the backlog
 }
 NetworkRecord_t;
 
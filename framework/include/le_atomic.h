@@ -38,6 +38,33 @@
  */
 #define LE_ATOMIC_ORDER_ACQ_REL __ATOMIC_ACQ_REL
 
+/**
+ * Atomically load a value.
+ *
+ * @param ptr points to the value.
+ * @param order ordering constraint
+ *
+ * @return the value
+ */
+#define LE_ATOMIC_LOAD(ptr, order) __atomic_load_n((ptr), (order))
+
+/**
+ * Atomically store a value.
+ *
+ * @param ptr points to the value.
+ * @param value value to store
+ * @param order ordering constraint
+ */
+#define LE_ATOMIC_STORE(ptr, value, order) __atomic_store_n((ptr), (value), (order))
+
+/**
+ * Creates an ordering constraint between the operations before and after this point, without an
+ * associated atomic operation.
+ *
+ * @param order ordering constraint
+ */
+#define LE_ATOMIC_FENCE(order) __atomic_thread_fence(order)
+
 /**
  * Test if a value has previously been set, and set it to true.  This returns true if and only if
  * the value was previously true.
@@ -103,6 +130,18 @@
 #error "The frameworkAdaptor is missing a definition of LE_ATOMIC_ORDER_ACQ_REL"
 #endif
 
+#ifndef LE_ATOMIC_LOAD
+#error "The frameworkAdaptor is missing a definition of LE_ATOMIC_LOAD"
+#endif
+
+#ifndef LE_ATOMIC_STORE
+#error "The frameworkAdaptor is missing a definition of LE_ATOMIC_STORE"
+#endif
+
+#ifndef LE_ATOMIC_FENCE
+#error "The frameworkAdaptor is missing a definition of LE_ATOMIC_FENCE"
+#endif
+
 #ifndef LE_ATOMIC_TEST_AND_SET
 #error "The frameworkAdaptor is missing a definition of LE_ATOMIC_TEST_AND_SET"
 #endif
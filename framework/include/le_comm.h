@@ -30,6 +30,18 @@
 //--------------------------------------------------------------------------------------------------
 typedef void (*le_comm_CallbackHandlerFunc_t) (void* handle, short events);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * One segment of data to be sent by le_comm_SendV().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const void* bufPtr;     ///< Pointer to the segment's data.
+    size_t len;             ///< Size of the segment's data.
+}
+le_comm_IoVec_t;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -115,8 +127,14 @@ LE_SHARED le_result_t le_comm_Disconnect
 /**
  * Function for Sending Data over a RPC Communication Channel
  *
+ * Implementations must not block the caller's event loop.  Data the channel cannot take right
+ * away may be buffered and sent later, in order with the data sent after it.
+ *
  * @return
  *      - LE_OK if successfully.
+ *      - LE_NO_MEMORY if the channel is congested and none of the data was taken; the caller may
+ *        retry later.
+ *      - otherwise failure
  */
 //--------------------------------------------------------------------------------------------------
 __attribute__((weak))
@@ -127,6 +145,26 @@ LE_SHARED le_result_t le_comm_Send
     size_t len          ///< [IN] Size of data to be sent.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function for Sending Data gathered from several buffers over a RPC Communication Channel, as if
+ * they had been concatenated and sent with a single call to le_comm_Send().
+ *
+ * @note This function is optional.  Callers must check that it is implemented (its address is not
+ *       NULL) and use le_comm_Send() otherwise.
+ *
+ * @return
+ *      - LE_OK if successfully.
+ */
+//--------------------------------------------------------------------------------------------------
+__attribute__((weak))
+LE_SHARED le_result_t le_comm_SendV
+(
+    void* handle,                   ///< [IN] Communication channel.
+    const le_comm_IoVec_t* iovPtr,  ///< [IN] Array of segments to be sent, in order.
+    size_t iovCount                 ///< [IN] Number of segments in the array.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function for Receiving Data over a RPC Communication Channel
@@ -52,6 +52,26 @@
  * }
  * @endcode
  *
+ * The same result can be obtained in a single call with @c le_crc_Crc32Chunks(), which walks an
+ * array of @ref le_crc_Chunk_t descriptors:
+ * @code
+ * le_crc_Chunk_t chunks[] =
+ * {
+ *     { headerPtr,  headerSize },
+ *     { payloadPtr, payloadSize },
+ * };
+ *
+ * uint32_t crc = le_crc_Crc32Chunks(chunks, NUM_ARRAY_MEMBERS(chunks), LE_CRC_START_CRC32);
+ * @endcode
+ *
+ * @section Crc32Perf Performance
+ *
+ * The CRC32 is computed 8 bytes at a time using slicing-by-8 lookup tables.  On ARMv8 targets
+ * built with the CRC extension enabled (e.g., @c -march=armv8-a+crc) the CRC32 instructions are
+ * used instead, and on x86-64 the bulk of large buffers is folded with carry-less multiplication
+ * when the CPU supports it.  All implementations produce identical results, so CRCs may be
+ * exchanged freely between targets.
+ *
  * <HR>
  *
  * Copyright (C) Sierra Wireless Inc.
@@ -81,6 +101,18 @@
 //--------------------------------------------------------------------------------------------------
 #define LE_CRC_START_CRC32         0xFFFFFFFFU
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Describes one buffer of a scattered data set passed to le_crc_Crc32Chunks().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const void* addressPtr;     ///< Start of the buffer
+    size_t      size;           ///< Number of bytes in the buffer
+}
+le_crc_Chunk_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to calculate a CRC-32
@@ -96,4 +128,19 @@ uint32_t le_crc_Crc32
     uint32_t crc        ///< [IN] Starting CRC seed
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function is used to calculate a CRC-32 over several buffers, as if they were contiguous.
+ *
+ * @return
+ *      - 32-bit CRC
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t le_crc_Crc32Chunks
+(
+    const le_crc_Chunk_t*   chunksPtr,  ///< [IN] Array of buffers
+    size_t                  numChunks,  ///< [IN] Number of buffers in the array
+    uint32_t                crc         ///< [IN] Starting CRC seed
+);
+
 #endif // LEGATO_CRC_INCLUDE_GUARD
@@ -998,16 +998,20 @@ void le_event_QueueFunctionToThread
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Queue a function onto a specific thread's Event Queue if it isn't already on the Event
- * Queue with the same parameters.  When it reaches the head of that Event Queue, it will be
- * called by that thread's Event Loop.
+ * Queue a function onto a specific thread's Event Queue if it isn't already waiting on that
+ * Event Queue with the same parameters, from an earlier call to this function.  When it reaches
+ * the head of that Event Queue, it will be called by that thread's Event Loop.
+ *
+ * @note Only functions queued by this function are checked.  The same function queued by
+ *       le_event_QueueFunction() or le_event_QueueFunctionToThread() is not seen as a duplicate.
+ *       A function stops being a duplicate as soon as it starts running.
  *
  * Using this function generally indicates poor design.
  * It's generally better to ensure the event is only generated once, for example by disabling
  * generating the event until the event handler is run.
  *
  * @return LE_OK if the function was queued to the Event Queue
- * @return LE_DUPLICATE if the function was already in the Event Queue
+ * @return LE_DUPLICATE if the function was already queued to the Event Queue by this function
  */
 //--------------------------------------------------------------------------------------------------
 le_result_t le_event_QueueFunctionToThreadUnique
@@ -17,9 +17,15 @@
  * type of key that you intend to store. It's unwise to mix types in a single table because
  * implementation of the table has no way to detect this behaviour.
  *
- * Choose the initial size should carefully as the index size remains fixed. The best
- * choice for the initial size is a prime number slightly larger than the
- * maximum expected capacity. If a too small size is chosen, there will be an
+ * Hashmaps created with @c le_hashmap_Create() grow automatically.  Once the map holds more
+ * entries than 3/4 of its bucket count the bucket array is doubled, and the entries are moved to
+ * their new buckets a few at a time on subsequent calls to le_hashmap_Put() and
+ * le_hashmap_Remove(), so no single call has to rehash the whole map.  The capacity passed to
+ * @c le_hashmap_Create() is therefore only a hint, but a good one avoids the cost of growing.
+ *
+ * Statically-defined hashmaps cannot grow, so choose their initial size carefully as the
+ * index size remains fixed. The best choice for the initial size is slightly larger than
+ * the maximum expected capacity. If a too small size is chosen, there will be an
  * increase in collisions that degrade performance over time.
  *
  * All hashmaps have names for diagnostic purposes.
@@ -114,7 +120,12 @@
  * It is possible to add and remove items during this style of iteration.  When
  * adding items during an iteration it is not guaranteed that the newly added item
  * will be iterated over.  It's very possible that the newly added item is added in
- * an earlier location than the iterator is curently pointed at.
+ * an earlier location than the iterator is curently pointed at.  Entries are never moved
+ * between buckets while an iteration is in progress, so a map which needs to grow finishes
+ * doing so only after le_hashmap_GetIterator() is called again or le_hashmap_NextNode() has
+ * reached the end of the map.  If the map grows to as many entries as it has buckets in the
+ * meantime, the iteration is invalidated instead: the iterator is moved past the end of the map,
+ * so le_hashmap_NextNode() returns LE_NOT_FOUND until le_hashmap_GetIterator() is called again.
  *
  * When removing items during an iteration you also have to keep in mind that the
  * iterator's current item may be the one removed.  If this is the case,
@@ -142,6 +153,24 @@
  *
  * If you need to control access to the hashmap, then a mutex can be used.
  *
+ * @section c_hashmap_flat Flat HashMaps
+ *
+ * When keys are small fixed-size values, such as integers, pointers or safe references, a flat
+ * hashmap created with @c le_hashmap_CreateFlat() can be used instead.  Keys are stored by value
+ * (as @c uintptr_t) directly in an open-addressed table, so lookups touch a single contiguous
+ * array rather than following bucket chains, and no memory is allocated per entry:
+ *
+ * @code
+ *     le_hashmap_FlatRef_t sessionMap = le_hashmap_CreateFlat("Sessions", 16);
+ *
+ *     le_hashmap_FlatPut(sessionMap, (uintptr_t)sessionRef, clientPtr);
+ *     clientPtr = le_hashmap_FlatGet(sessionMap, (uintptr_t)sessionRef);
+ * @endcode
+ *
+ * Flat hashmaps grow by rehashing the whole table at once, which is cheap for the small maps
+ * they are intended for.  They only support le_hashmap_FlatForEach() style iteration, and must
+ * not be modified during it.
+ *
  * @section c_hashmap_tracing Tracing a map
  *
  * Hashmaps can be traced using the logging system.
@@ -293,6 +322,10 @@ typedef struct le_hashmap
     le_mem_PoolRef_t         entryPoolRef;  ///< Memory pool to expand into for expanding buckets.
     size_t                   bucketCount;   ///< Number of buckets.
     size_t                   size;          ///< Number of inserted entries.
+    size_t                   splitCount;    ///< Bucket count before the resize in progress, or 0
+                                            ///< if the map is not being resized.
+    size_t                   splitIndex;    ///< Next bucket to be split by the resize in progress.
+    bool                     isResizable;   ///< Bucket array is on the heap and may be grown.
 
 #if LE_CONFIG_HASHMAP_NAMES_ENABLED
     const char               *nameStr;        ///< Name of the hashmap for diagnostic purposes.
@@ -308,7 +341,7 @@ le_hashmap_Hashmap_t;
  * Create a HashMap.
  *
  * If you create a hashmap with a smaller capacity than you actually use, then
- * the map will continue to work, but performance will degrade the more you put in the map.
+ * the map will grow incrementally as more entries are put in it.
  *
  *  @param[in]  nameStr     Name of the HashMap.  This must be a static string as it is not copied.
  *  @param[in]  capacity    Size of the hashmap
@@ -346,7 +379,7 @@ le_hashmap_Ref_t _le_hashmap_Create
  * Create a HashMap.
  *
  * If you create a hashmap with a smaller capacity than you actually use, then
- * the map will continue to work, but performance will degrade the more you put in the map.
+ * the map will grow incrementally as more entries are put in it.
  *
  *  @param[in]  nameStr     Name of the HashMap.  This must be a static string as it is not copied.
  *  @param[in]  capacity    Size of the hashmap
@@ -934,6 +967,143 @@ bool le_hashmap_EqualsVoidPointer
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a flat (open-addressed) HashMap.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_hashmap_Flat* le_hashmap_FlatRef_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prototype for callback functions for the iterator function le_hashmap_FlatForEach().  This
+ * function should return true in order to continue iterating, or false to stop.
+ *
+ * @param key       Key at the current position in the map
+ * @param valuePtr  Pointer to the value associated to this key
+ * @param contextPtr Pointer to the context supplied to le_hashmap_FlatForEach()
+ * @return Returns true to continue, false to stop
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*le_hashmap_FlatForEachHandler_t)
+(
+    uintptr_t   key,
+    void       *valuePtr,
+    void       *contextPtr
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a flat HashMap.  Keys are stored by value, so the map needs no hash or equality
+ * functions and no per-entry allocations.
+ *
+ *  @param[in]  nameStr     Name of the HashMap.  This must be a static string as it is not copied.
+ *  @param[in]  capacity    Expected number of entries.  The map grows if this is exceeded.
+ *
+ *  @return  Returns a reference to the map.
+ *
+ *  @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_FlatRef_t le_hashmap_CreateFlat
+(
+    const char  *nameStr,
+    size_t       capacity
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a key-value pair to a flat HashMap. If the key already exists in the map, the previous value
+ * will be replaced with the new value passed into this function.
+ *
+ * @return  Returns NULL for a new entry or a pointer to the old value if it is replaced.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_hashmap_FlatPut
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map.
+    uintptr_t                key,       ///< [in] Key to be stored.
+    const void              *valuePtr   ///< [in] Pointer to the value to be stored.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve a value from a flat HashMap.
+ *
+ * @return  Returns a pointer to the value or NULL if the key is not found.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_hashmap_FlatGet
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map.
+    uintptr_t                key        ///< [in] Key to be retrieved.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tests if a flat HashMap contains a particular key.
+ *
+ * @return  Returns true if the key is found, false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_hashmap_FlatContainsKey
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map.
+    uintptr_t                key        ///< [in] Key to be searched for.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a value from a flat HashMap.
+ *
+ * @return  Returns a pointer to the value or NULL if the key is not found.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_hashmap_FlatRemove
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map.
+    uintptr_t                key        ///< [in] Key to be removed.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calculates the number of keys in a flat HashMap.
+ *
+ * @return  The number of keys in the HashMap.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_hashmap_FlatSize
+(
+    le_hashmap_FlatRef_t     mapRef     ///< [in] Reference to the map.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes all the entries held in a flat HashMap.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_hashmap_FlatRemoveAll
+(
+    le_hashmap_FlatRef_t     mapRef     ///< [in] Reference to the map.
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Iterates over a flat HashMap, calling the supplied callback with each key-value pair.  If the
+ * callback returns false for any key then this function will return.  The map must not be
+ * modified from the callback.
+ *
+ * @return  Returns true if all elements were checked; or false if iteration was stopped early.
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_hashmap_FlatForEach
+(
+    le_hashmap_FlatRef_t             mapRef,     ///< [in] Reference to the map.
+    le_hashmap_FlatForEachHandler_t  forEachFn,  ///< [in] Callback to call with each pair.
+    void                            *contextPtr  ///< [in] Context to supply to the callback.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Makes a particular hashmap traceable without enabling the tracing.  After this is called, when
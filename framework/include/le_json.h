@@ -22,6 +22,15 @@
  * event-driven manner: As JSON data is received, asynchronous call-back functions are called
  * to deliver parsed information or an error message.
  *
+ * Regular files are read in blocks of LE_CONFIG_JSON_READ_BLOCK_SIZE bytes, and any data read past
+ * the end of the document is given back when parsing stops, so the file offset is left just
+ * after the document.  Other file descriptors (pipes, sockets, etc.) are read a byte at a time so
+ * that nothing following the document is consumed.
+ *
+ * A document that is already in memory can be parsed using le_json_ParseString() (for a
+ * null-terminated string) or le_json_ParseBuffer() (for a buffer of known size, such as a
+ * memory-mapped file).  Neither copies the document, so it must remain valid until parsing stops.
+ *
  * Parsing stops automatically when the end of the document is reached or an error is encountered.
  *
  * le_json_Cleanup() must be called to release memory resources allocated by the parser.
@@ -236,6 +245,23 @@ le_json_ParsingSessionRef_t le_json_ParseString
     void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a JSON document held in a memory buffer (e.g., a memory-mapped file).  The buffer is not
+ * copied, so it must remain valid and unchanged until parsing stops.
+ *
+ * @return Reference to the JSON parsing session started by this function call.
+ */
+//--------------------------------------------------------------------------------------------------
+le_json_ParsingSessionRef_t le_json_ParseBuffer
+(
+    const void *bufferPtr,  ///< Buffer containing the JSON document.  Need not be null-terminated.
+    size_t bufferSize,      ///< Number of bytes in the buffer.
+    le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
+    le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
+    void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Stops parsing and cleans up memory allocated by the parser.
@@ -393,7 +419,7 @@ const char* le_json_GetContextName
 
 //--------------------------------------------------------------------------------------------------
 /**
- * @return The number of bytes that have been read from the input stream so far.
+ * @return The number of bytes of the document that have been processed by the parser so far.
  */
 //--------------------------------------------------------------------------------------------------
 size_t le_json_GetBytesRead
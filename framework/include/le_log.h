@@ -533,6 +533,17 @@ extern LE_SHARED le_log_SessionRef_t LE_LOG_SESSION;
 //--------------------------------------------------------------------------------------------------
 extern LE_SHARED le_log_Level_t* LE_LOG_LEVEL_FILTER_PTR;
 
+#if LE_CONFIG_LOG_CALL_SITE_CACHE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log filter generation.  Bumped every time a filter level changes in the process, to invalidate
+ * the filter decisions cached at each logging call site.  Never 0, so a call site's cache starts
+ * out invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+extern LE_SHARED uint32_t _le_log_FilterGeneration;
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Internal macro to set whether the function name is displayed with log messages.
@@ -560,6 +571,37 @@ extern LE_SHARED le_log_Level_t* LE_LOG_LEVEL_FILTER_PTR;
                     formatString, ##__VA_ARGS__); \
     } while(0)
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Internal macro like _LE_LOG_MSG(), for the levels that are usually filtered out (debug and
+ * info).  Each call site remembers the filter generation at which it was last filtered out, and
+ * skips the filter level look-up until the generation changes.  The generation is read with
+ * acquire ordering before the level, so a cached decision is never older than the level it was
+ * based on.
+ */
+//--------------------------------------------------------------------------------------------------
+#if LE_CONFIG_LOG_CALL_SITE_CACHE
+#define _LE_LOG_MSG_CACHED(level, formatString, ...) \
+    do { \
+        static uint32_t _le_log_filteredGen; \
+        if ((level >= LE_LOG_LEVEL_STATIC_FILTER) && \
+            (_le_log_filteredGen != \
+                LE_ATOMIC_LOAD(&_le_log_FilterGeneration, LE_ATOMIC_ORDER_RELAXED))) \
+        { \
+            uint32_t _le_log_gen = \
+                LE_ATOMIC_LOAD(&_le_log_FilterGeneration, LE_ATOMIC_ORDER_ACQUIRE); \
+            if ((LE_LOG_LEVEL_FILTER_PTR == NULL) || (level >= *LE_LOG_LEVEL_FILTER_PTR)) \
+                _le_log_Send(level, NULL, LE_LOG_SESSION, __FILE__, _LE_LOG_FUNCTION_NAME, \
+                        __LINE__, formatString, ##__VA_ARGS__); \
+            else \
+                _le_log_filteredGen = _le_log_gen; \
+        } \
+    } while(0)
+#else
+#define _LE_LOG_MSG_CACHED(level, formatString, ...) \
+    _LE_LOG_MSG(level, formatString, ##__VA_ARGS__)
+#endif
+
 
 //--------------------------------------------------------------------------------------------------
 /** @internal
@@ -571,7 +613,8 @@ extern LE_SHARED le_log_Level_t* LE_LOG_LEVEL_FILTER_PTR;
 //--------------------------------------------------------------------------------------------------
 
 /** @copydoc LE_LOG_DEBUG */
-#define LE_DEBUG(formatString, ...)     _LE_LOG_MSG(LE_LOG_DEBUG, formatString, ##__VA_ARGS__)
+#define LE_DEBUG(formatString, ...) \
+    _LE_LOG_MSG_CACHED(LE_LOG_DEBUG, formatString, ##__VA_ARGS__)
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -581,9 +624,8 @@ extern LE_SHARED le_log_Level_t* LE_LOG_LEVEL_FILTER_PTR;
  *  @param  dataLength  Length og the buffer.
  */
 //--------------------------------------------------------------------------------------------------
-#define LE_DUMP(dataPtr, dataLength)                                                              \
-    _le_LogData(LE_LOG_DEBUG, dataPtr, dataLength, STRINGIZE(LE_FILENAME), _LE_LOG_FUNCTION_NAME, \
-        __LINE__)
+#define LE_DUMP(dataPtr, dataLength)                                                          \
+    LE_LOG_DUMP(LE_LOG_DEBUG, dataPtr, dataLength)
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -594,10 +636,15 @@ extern LE_SHARED le_log_Level_t* LE_LOG_LEVEL_FILTER_PTR;
  *  @param  dataLength  Length of the buffer.
  */
 //--------------------------------------------------------------------------------------------------
-#define LE_LOG_DUMP(level, dataPtr, dataLength) \
-    _le_LogData(level, dataPtr, dataLength, STRINGIZE(LE_FILENAME), _LE_LOG_FUNCTION_NAME, __LINE__)
+#define LE_LOG_DUMP(level, dataPtr, dataLength)                                               \
+    do {                                                                                      \
+        if ((level) >= LE_LOG_LEVEL_STATIC_FILTER)                                            \
+            _le_LogData(level, dataPtr, dataLength, STRINGIZE(LE_FILENAME),                   \
+                        _LE_LOG_FUNCTION_NAME, __LINE__);                                     \
+    } while(0)
 /** @copydoc LE_LOG_INFO */
-#define LE_INFO(formatString, ...)      _LE_LOG_MSG(LE_LOG_INFO, formatString, ##__VA_ARGS__)
+#define LE_INFO(formatString, ...) \
+    _LE_LOG_MSG_CACHED(LE_LOG_INFO, formatString, ##__VA_ARGS__)
 /** @copydoc LE_LOG_WARN */
 #define LE_WARN(formatString, ...)      _LE_LOG_MSG(LE_LOG_WARN, formatString, ##__VA_ARGS__)
 /** @copydoc LE_LOG_ERR */
@@ -297,6 +297,34 @@
  * the data structure, then the mutex must be held by the thread that calls le_mem_Release() to
  * ensure there's no other thread accessing the data structure when the destructor runs.
  *
+ * @subsection mem_thread_cache Per-Thread Caches
+ *
+ * By default every allocation and release takes a single process-wide lock.  Pools that are
+ * allocated from and released to at a high rate by several threads can instead be given
+ * per-thread caches by calling @c le_mem_EnableThreadCache() once, right after the pool is
+ * created:
+ *
+ * @code
+ *     MsgPool = le_mem_CreatePool("Msg", sizeof(Msg_t));
+ *     le_mem_ExpandPool(MsgPool, 64);
+ *     le_mem_EnableThreadCache(MsgPool, 16);
+ * @endcode
+ *
+ * Each thread then keeps a small magazine of free blocks for that pool.  Allocations and releases
+ * are served from the calling thread's magazine without locking; the lock is only taken to move
+ * half a magazine of blocks between the magazine and the pool when it runs empty or full.  A
+ * block may be released by a different thread than the one that allocated it.
+ *
+ * Some things to keep in mind when using per-thread caches:
+ *  - Free blocks held in other threads' magazines can't be allocated by the calling thread, so
+ *    a cached pool may need up to (number of threads x cache size) more blocks than an uncached
+ *    pool.  Cached pools are best used with @c le_mem_ForceAlloc().
+ *  - Statistics (@ref mem_stats) are folded into the pool whenever a magazine is refilled or
+ *    spilled, so they may lag by up to one magazine per thread.
+ *  - Sub-pools can not have per-thread caches.
+ *  - Per-thread caches are only available when the @ref MEM_THREAD_CACHE KConfig option is
+ *    enabled.
+ *
  * @section mem_pool_sizes Managing Pool Sizes
  *
  * We know it's possible to have pools automatically expand
@@ -523,6 +551,13 @@ typedef struct le_mem_Pool
     size_t numBlocksInUse;              ///< Number of currently allocated blocks.
     size_t numBlocksToForce;            ///< Number of blocks that is added when Force Alloc
                                         ///  expands the pool.
+#if LE_CONFIG_MEM_THREAD_CACHE
+    size_t threadCacheSize;             ///< Maximum number of blocks cached per thread (0 = per-
+                                        ///  thread caching disabled).
+    size_t threadCacheIndex;            ///< Index of this pool's cache in each thread's cache set.
+    size_t numCachedBlocks;             ///< Free blocks held in thread caches as of their last
+                                        ///  refill or spill.
+#endif
 #if LE_CONFIG_MEM_TRACE
     le_log_TraceRef_t memTrace;         ///< If tracing is enabled, keeps track of a trace object
                                         ///< for this pool.
@@ -1103,6 +1138,29 @@ void le_mem_SetNumObjsToForce
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables per-thread caching of free blocks for a pool.
+ *
+ * Should be called once, after the pool is created and before it is used by multiple threads.
+ *
+ * See @ref mem_thread_cache for more information.
+ *
+ * @return
+ *      - LE_OK if the per-thread caches were enabled.
+ *      - LE_NOT_PERMITTED if the pool is a sub-pool.
+ *      - LE_NO_MEMORY if the maximum number of pools with per-thread caches has been reached.
+ *      - LE_NOT_IMPLEMENTED if per-thread caches are not supported in this build.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_mem_EnableThreadCache
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool to enable per-thread caches for.
+    size_t              numObjects  ///< [IN] Maximum number of free objects cached per thread.
+                                    ///       Limited to the MEM_THREAD_CACHE_SIZE KConfig value.
+);
+
+
 #if !LE_CONFIG_MEM_TRACE
     //----------------------------------------------------------------------------------------------
     /**
@@ -766,6 +766,52 @@
  * @warning DO NOT SEND DIRECTORY FILE DESCRIPTORS.  They can be exploited and used to break out of
  * chroot() jails.
  *
+ * @section c_messagingBulkPayloads Bulk Payloads
+ *
+ * Every message is copied through the session's socket, so a message's payload size is normally
+ * limited to the protocol's maximum message size, and large amounts of data have to be split
+ * over many messages.  On Linux, a message can also carry one bulk payload that does not go
+ * through the socket at all.
+ *
+ * The first time le_msg_AllocBulkPayload() is called on a session, the messaging system creates a
+ * shared memory ring (size set by the @c MSG_BULK_RING_SIZE KConfig option) and passes it to the
+ * other end of the session once, as a file descriptor.  After that, le_msg_AllocBulkPayload()
+ * returns a buffer inside the ring that the sender writes the data into directly, and only a
+ * small descriptor of the buffer is sent with the message.  The receiver reads the data in place
+ * using le_msg_GetBulkPayloadPtr(), and the buffer is handed back to the sender when the
+ * received message is released.
+ *
+ * @code
+ *     msgRef = le_msg_CreateMsg(sessionRef);
+ *     uint8_t* bulkPtr = le_msg_AllocBulkPayload(msgRef, dataSize);
+ *     if (bulkPtr != NULL)
+ *     {
+ *         ReadSamples(bulkPtr, dataSize);
+ *     }
+ *     else
+ *     {
+ *         // No bulk payload available: fall back to sending the data in the normal payload.
+ *     }
+ *     le_msg_Send(msgRef);
+ * @endcode
+ *
+ * @code
+ *     size_t dataSize;
+ *     const uint8_t* dataPtr = le_msg_GetBulkPayloadPtr(msgRef, &dataSize);
+ * @endcode
+ *
+ * le_msg_AllocBulkPayload() returns NULL (and the sender must fall back to the normal payload)
+ * if:
+ *  - the session is a local session, or bulk payloads are disabled or not supported;
+ *  - the requested size is larger than le_msg_GetMaxBulkPayloadSize();
+ *  - the ring is full because the receiver still holds on to messages it received earlier.
+ *
+ * Both ends of the session must be using this C implementation of the messaging API, and the
+ * receiver must be allowed to receive file descriptors from the sender (see
+ * @ref c_messagingSendingFileDescriptors).  The data in the ring can be modified by the other end
+ * of the session at any time, so the receiver should copy out anything that it needs to validate
+ * before acting on it.
+ *
  * @section c_messagingFutureEnhancements Future Enhancements
  *
  * As an optimization to reduce the number of copies in cases where the sender of a message
@@ -1512,6 +1558,52 @@ int le_msg_GetFd
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a bulk payload buffer for a message.  The buffer is sent along with the message
+ * without being copied through the session's socket (see @ref c_messagingBulkPayloads).
+ *
+ * At most one bulk payload is allowed per message.
+ *
+ * @return A pointer to the buffer, or NULL if a bulk payload of this size can't be allocated
+ *         right now (in which case the data must be sent some other way).
+ **/
+//--------------------------------------------------------------------------------------------------
+void* le_msg_AllocBulkPayload
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Size of the bulk payload, in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the bulk payload of a message.
+ *
+ * @return A pointer to the bulk payload, or NULL if the message doesn't have one.  The payload
+ *         remains valid until the message is released.
+ **/
+//--------------------------------------------------------------------------------------------------
+const void* le_msg_GetBulkPayloadPtr
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t*             sizePtr     ///< [out] Size of the bulk payload, in bytes (0 if none).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the largest bulk payload that can be sent on a session.
+ *
+ * @return The size, in bytes, or 0 if bulk payloads are not available on this session.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t le_msg_GetMaxBulkPayloadSize
+(
+    le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sends a message.  No response expected.
@@ -56,6 +56,19 @@
  * dynamically by calling @c le_ref_CreateMap(), or can be allocated statically at compile time
  * via @c LE_REF_DEFINE_STATIC_MAP() and initialized via @c le_ref_InitStaticMap().
  *
+ * @section c_safeRef_readOptimized Read-Optimized Reference Maps
+ *
+ * A Reference Map created by @c le_ref_CreateReadOptimizedMap() is intended for objects that are
+ * looked up far more often than they are created or deleted, such as the objects behind the
+ * references handed out by an IPC service.  In such a map:
+ *  - @c le_ref_Lookup() takes a constant time, however many references the map has grown to hold.
+ *  - Each slot carries a generation number, which is part of the Safe References created for it.
+ *    A stale Safe Reference is still detected after its slot has been reused for a new object.
+ *  - Slots are reused in the order they were freed, and the map grows by doubling, rather than
+ *    one small block at a time.
+ *
+ * The price is that a read-optimized map can't hold more than 32768 references at once.
+ *
  * @section c_safeRef_multithreading Multithreading
  *
  * This API's functions are reentrant, but not thread safe. If there's the slightest
@@ -63,6 +76,13 @@
  * a mutex or some other thread synchronization mechanism to protect the Reference Map from
  * concurrent access.
  *
+ * The exception is @c le_ref_Lookup() on a read-optimized map, which can be called by any thread
+ * without locking, even while another thread is creating or deleting references in the map.  All
+ * of the other functions still need to be protected from each other.  Note that a lock-free
+ * lookup can't stop the object from being deleted straight afterwards, so the object's lifetime
+ * must still be managed some other way (e.g. only the looking-up thread ever deletes it, or the
+ * object is reference counted).
+ *
  * @section c_safeRef_example Sample Code
  *
  * Here's an API Definition sample:
@@ -219,6 +239,13 @@ struct le_ref_Block;
 // Internal block sizing
 #define LE_REF_BLOCK_SIZE(numRefs)  (1 + (numRefs))
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Internal slot type, used by read-optimized maps.
+ */
+//--------------------------------------------------------------------------------------------------
+struct le_ref_Slot;
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Reference Map object, which stores mappings from Safe References to pointers.
@@ -242,6 +269,10 @@ struct le_ref_Map
     uint32_t             mapBase;   ///< Randomized "base" for references in this map.
 
     struct le_ref_Block *blocksPtr; ///< Block list head.
+
+    struct le_ref_Slot **chunksPtr; ///< Slot chunks of a read-optimized map (NULL otherwise).
+    uint32_t             freeHead;  ///< First free slot of a read-optimized map.
+    uint32_t             freeTail;  ///< Last free slot of a read-optimized map.
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -347,6 +378,55 @@ LE_DECLARE_INLINE le_ref_MapRef_t le_ref_CreateMap
 #endif /* end LE_CONFIG_SAFE_REF_NAMES_ENABLED */
 
 
+#if LE_CONFIG_SAFE_REF_NAMES_ENABLED
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a read-optimized Reference Map.  See @ref c_safeRef_readOptimized.
+ *
+ *  @param[in]  name    Name of the map (for diagnostics).
+ *  @param[in]  maxRefs Maximum number of Safe References expected to be kept in this Reference Map
+ *                      at any one time.
+ *
+ *  @return A reference to the Reference Map object.
+ */
+//--------------------------------------------------------------------------------------------------
+le_ref_MapRef_t le_ref_CreateReadOptimizedMap
+(
+    const char *name,
+    size_t      maxRefs
+);
+#else /* if not LE_CONFIG_SAFE_REF_NAMES_ENABLED */
+/// @cond HIDDEN_IN_USER_DOCS
+//--------------------------------------------------------------------------------------------------
+/**
+ * Internal function used to implement le_ref_CreateReadOptimizedMap().
+ */
+//--------------------------------------------------------------------------------------------------
+le_ref_MapRef_t _le_ref_CreateReadOptimizedMap(size_t maxRefs);
+/// @endcond
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a read-optimized Reference Map.  See @ref c_safeRef_readOptimized.
+ *
+ *  @param[in]  name    Name of the map (for diagnostics).
+ *  @param[in]  maxRefs Maximum number of Safe References expected to be kept in this Reference Map
+ *                      at any one time.
+ *
+ *  @return A reference to the Reference Map object.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_DECLARE_INLINE le_ref_MapRef_t le_ref_CreateReadOptimizedMap
+(
+    const char *name,
+    size_t      maxRefs
+)
+{
+    LE_UNUSED(name);
+    return _le_ref_CreateReadOptimizedMap(maxRefs);
+}
+#endif /* end LE_CONFIG_SAFE_REF_NAMES_ENABLED */
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a Safe Reference, storing a mapping between that reference and a specified pointer for
@@ -59,6 +59,12 @@
  * and unlocked using the functions event_Lock() and event_Unlock().  Framework adaptor
  * functions which end in _NoLock are called with the lock held so should not lock.
  *
+ * The exception is the Event Queue itself.  Each thread's Event Queue is fed through a lock-free
+ * "inbox": a stack of Reports that any thread can push onto with a compare-and-swap.  The owning
+ * thread takes the whole inbox in one go, reverses it into arrival order, and appends it to its
+ * private Event Queue, which no other thread touches.  The thread is only woken when a Report
+ * is pushed onto an empty inbox, so a burst of Reports costs a single wake-up.
+ *
  * ----
  *
  * Copyright (C) Sierra Wireless Inc.
@@ -316,6 +322,8 @@ typedef struct
     le_event_DeferredFunc_t function;   ///< Address of the function to be called.
     void*                   param1Ptr;  ///< First parameter to pass to the function.
     void*                   param2Ptr;  ///< Second parameter to pass to the function.
+    bool                    isUnique;   ///< Queued by le_event_QueueFunctionToThreadUnique().
+    le_dls_Link_t           uniqueLink; ///< Used to link onto the thread's Unique List.
 }
 QueuedFunctionReport_t;
 
@@ -438,6 +446,92 @@ static le_log_TraceRef_t TraceRef;
 #define TRACE(...) LE_TRACE(TraceRef, ##__VA_ARGS__)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push an Event Report onto a thread's inbox, and wake the thread up if the inbox was empty.
+ *
+ * Can be called by any thread, with or without the mutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushEventReport
+(
+    event_PerThreadRec_t*   perThreadRecPtr, ///< [in] Pointer to the thread's event data record.
+    Report_t*               reportPtr        ///< [in] Report to be queued.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* headPtr;
+
+    do
+    {
+        headPtr = perThreadRecPtr->inboxPtr;
+        reportPtr->link.nextPtr = headPtr;
+    }
+    while (!LE_SYNC_BOOL_COMPARE_AND_SWAP(&perThreadRecPtr->inboxPtr, headPtr, &reportPtr->link));
+
+    // Only the Report that makes the inbox non-empty needs to wake the thread up.  Anything pushed
+    // after that will be picked up along with it.  The wake-up must not be lost to cancellation,
+    // or nothing pushed afterwards would wake the thread either.
+    if (headPtr == NULL)
+    {
+        int oldState;
+
+        LE_ASSERT(pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &oldState) == 0);
+        fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+        LE_ASSERT(pthread_setcancelstate(oldState, &oldState) == 0);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take everything that has been pushed onto the calling thread's inbox and append it to the
+ * thread's Event Queue, oldest first.
+ *
+ * @return The number of Event Reports moved onto the Event Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t TakeEventReports
+(
+    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Link_t* linkPtr;
+    le_sls_Link_t* orderedPtr = NULL;
+    uint64_t count = 0;
+
+    do
+    {
+        linkPtr = perThreadRecPtr->inboxPtr;
+    }
+    while ((linkPtr != NULL)
+           && !LE_SYNC_BOOL_COMPARE_AND_SWAP(&perThreadRecPtr->inboxPtr, linkPtr, NULL));
+
+    // The inbox is newest first, so reverse it.
+    while (linkPtr != NULL)
+    {
+        le_sls_Link_t* nextPtr = linkPtr->nextPtr;
+
+        linkPtr->nextPtr = orderedPtr;
+        orderedPtr = linkPtr;
+        linkPtr = nextPtr;
+        count++;
+    }
+
+    while (orderedPtr != NULL)
+    {
+        le_sls_Link_t* nextPtr = orderedPtr->nextPtr;
+
+        *orderedPtr = LE_SLS_LINK_INIT;
+        le_sls_Queue(&perThreadRecPtr->eventQueue, orderedPtr);
+        orderedPtr = nextPtr;
+    }
+
+    return count;
+}
+
+
 // ==============================================
 //  PRIVATE FUNCTIONS
 // ==============================================
@@ -560,14 +654,12 @@ void event_ProcessOneEventReport
     le_sls_Link_t* linkPtr;
     Report_t* reportObjPtr;
     Handler_t* handlerPtr;
+    int oldState;
 
-    int oldState = event_Lock();
-
-    // Pop an Event Report off the head of the Event Queue (inside a critical section).
+    // Pop an Event Report off the head of the Event Queue.  Only this thread accesses its
+    // Event Queue, so no locking is needed.
     linkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue);
 
-    event_Unlock(oldState);
-
     if (linkPtr == NULL)
     {
         return;
@@ -587,6 +679,15 @@ void event_ProcessOneEventReport
         QueuedFunctionReport_t* queuedFuncReportPtr;
         queuedFuncReportPtr = CONTAINER_OF(reportObjPtr, QueuedFunctionReport_t, baseClass);
 
+        // Once it's running, it's no longer on the queue as far as
+        // le_event_QueueFunctionToThreadUnique() is concerned.
+        if (queuedFuncReportPtr->isUnique)
+        {
+            oldState = event_Lock();
+            le_dls_Remove(&perThreadRecPtr->uniqueList, &queuedFuncReportPtr->uniqueLink);
+            event_Unlock(oldState);
+        }
+
         // Call the function.
         queuedFuncReportPtr->function(queuedFuncReportPtr->param1Ptr,
                                       queuedFuncReportPtr->param2Ptr);
@@ -654,7 +755,110 @@ void event_ProcessOneEventReport
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Process Event Reports from the calling thread's Event Queue until the queue is empty.
+ * Move any Event Reports queued to the calling thread since the last call onto its Event Queue,
+ * ready to be processed by event_ProcessOneEventReport().
+ *
+ * @return The number of Event Reports added to the Event Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t event_TakeEventReports
+(
+    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return TakeEventReports(perThreadRecPtr);
+}
+
+
+#if LE_CONFIG_EVENT_DISPATCH_STATS || (LE_CONFIG_EVENT_DISPATCH_BUDGET_US > 0)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of microseconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetElapsedUsec
+(
+    le_clk_Time_t startTime     ///< [in] Relative time to measure from.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint64_t)elapsed.sec * 1000000 + (uint64_t)elapsed.usec;
+}
+#endif
+
+
+#if LE_CONFIG_EVENT_DISPATCH_STATS
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the statistics for one Event Loop wake-up.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordDispatchStats
+(
+    event_PerThreadRec_t*   perThreadRecPtr,///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t                numDispatched,  ///< [in] Number of Event Reports dispatched.
+    uint64_t                elapsedUsec     ///< [in] Time taken to dispatch them.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    event_DispatchStats_t* statsPtr = &perThreadRecPtr->stats;
+    uint64_t limit = 10;
+    size_t bucket = 0;
+
+    statsPtr->wakeupCount++;
+    statsPtr->reportCount += numDispatched;
+    if (numDispatched > statsPtr->maxReportsPerWakeup)
+    {
+        statsPtr->maxReportsPerWakeup = (numDispatched > UINT32_MAX ?
+                                            UINT32_MAX : (uint32_t)numDispatched);
+    }
+
+    while ((bucket < EVENT_DISPATCH_HISTOGRAM_SIZE - 1) && (elapsedUsec >= limit))
+    {
+        bucket++;
+        limit *= 10;
+    }
+    statsPtr->dispatchTimeHistogram[bucket]++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the number of Event Reports waiting on the calling thread's Event Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void RecordQueueDepth
+(
+    event_PerThreadRec_t*   perThreadRecPtr,///< [in] Ptr to the calling thread's per-thread record.
+    uint64_t                depth           ///< [in] Number of Event Reports waiting.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (depth > perThreadRecPtr->stats.maxQueueDepth)
+    {
+        perThreadRecPtr->stats.maxQueueDepth = (depth > UINT32_MAX ? UINT32_MAX : (uint32_t)depth);
+    }
+}
+#else
+#   define RecordQueueDepth(perThreadRecPtr, depth)
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process Event Reports from the calling thread's Event Queue.
+ *
+ * By default, only the Event Reports that are already queued when this is called are processed.
+ * Anything reported by the event handlers has to wait until the next wake-up, so that event
+ * handlers that re-queue events can't starve fd events.
+ *
+ * If LE_CONFIG_EVENT_DISPATCH_BATCH_SIZE or LE_CONFIG_EVENT_DISPATCH_BUDGET_US is set, Event
+ * Reports queued while dispatching are picked up without another trip through the OS, until
+ * either limit is reached.  Anything left over is processed on the next wake-up, which is
+ * triggered straight away so that it comes right after the fds have been serviced.
  */
 //--------------------------------------------------------------------------------------------------
 void event_ProcessEventReports
@@ -663,18 +867,61 @@ void event_ProcessEventReports
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Read the eventfd to fetch the number of Reports on the Event Queue and reset the count
-    // to zero.
-    uint64_t numReports = fa_event_WaitForEvent(perThreadRecPtr);
-
-    // Process only those event reports that are already on the queue.  Anything reported by the
-    // event handlers will have to wait until next time ProcessEventReports() is called.
-    // This approach ensures that event handlers that re-queue events to the event
-    // queue don't cause fd events to be starved.
-    for (; numReports > 0; numReports--)
+#if LE_CONFIG_EVENT_DISPATCH_STATS || (LE_CONFIG_EVENT_DISPATCH_BUDGET_US > 0)
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+#endif
+    uint64_t numDispatched = 0;
+
+    // Acknowledge the wake-up before taking the inbox, so that anything pushed after the inbox
+    // has been taken triggers another wake-up.
+    fa_event_WaitForEvent(perThreadRecPtr);
+
+    // Reports may already be waiting, left over from the last wake-up or queued locally by the
+    // Event Loop.
+    uint64_t numReports = perThreadRecPtr->liveEventCount + TakeEventReports(perThreadRecPtr);
+    RecordQueueDepth(perThreadRecPtr, numReports);
+
+    for (;;)
     {
+        if (numReports == 0)
+        {
+#if (LE_CONFIG_EVENT_DISPATCH_BATCH_SIZE > 0) || (LE_CONFIG_EVENT_DISPATCH_BUDGET_US > 0)
+            numReports = TakeEventReports(perThreadRecPtr);
+            RecordQueueDepth(perThreadRecPtr, numReports);
+            if (numReports == 0)
+#endif
+            {
+                break;
+            }
+        }
+
         event_ProcessOneEventReport(perThreadRecPtr);
+        numReports--;
+        numDispatched++;
+
+#if LE_CONFIG_EVENT_DISPATCH_BATCH_SIZE > 0
+        if (numDispatched >= LE_CONFIG_EVENT_DISPATCH_BATCH_SIZE)
+        {
+            break;
+        }
+#endif
+#if LE_CONFIG_EVENT_DISPATCH_BUDGET_US > 0
+        if (GetElapsedUsec(startTime) >= LE_CONFIG_EVENT_DISPATCH_BUDGET_US)
+        {
+            break;
+        }
+#endif
     }
+
+    perThreadRecPtr->liveEventCount = numReports;
+    if (numReports > 0)
+    {
+        fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+    }
+
+#if LE_CONFIG_EVENT_DISPATCH_STATS
+    RecordDispatchStats(perThreadRecPtr, numDispatched, GetElapsedUsec(startTime));
+#endif
 }
 
 
@@ -704,15 +951,13 @@ static void PubSubHandlerFunc
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Queue a function onto a specific thread's Event Queue (could belong to the calling thread or
- * could belong to some other thread).
+ * Create a Queued Function Report.
  *
- * @warning Assumes the mutex is locked and the thread is protected from cancellation.
+ * @return Pointer to the new report.
  */
 //--------------------------------------------------------------------------------------------------
-static void QueueFunction_NoLock
+static QueuedFunctionReport_t* CreateQueuedFunction
 (
-    event_PerThreadRec_t*   perThreadRecPtr, ///< [in] Pointer to the thread's event data record.
     le_event_DeferredFunc_t func,       ///< [in] The function to be called later.
     void*                   param1Ptr,  ///< [in] Value to be passed to the function when called.
     void*                   param2Ptr   ///< [in] Value to be passed to the function when called.
@@ -728,12 +973,34 @@ static void QueueFunction_NoLock
     reportPtr->function = func;
     reportPtr->param1Ptr = param1Ptr;
     reportPtr->param2Ptr = param2Ptr;
+    reportPtr->isUnique = false;
+    reportPtr->uniqueLink = LE_DLS_LINK_INIT;
+
+    return reportPtr;
+}
 
-    // Queue it to the Event Queue.
-    le_sls_Queue(&perThreadRecPtr->eventQueue, &reportPtr->baseClass.link);
 
-    // Write to the eventfd to notify the Event Loop that there is something on the queue.
-    fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a function call straight onto the calling thread's Event Queue, bypassing the inbox.
+ *
+ * This doesn't wake the thread up, so it must only be called by a thread's Event Loop just before
+ * it calls event_ProcessEventReports().  The inbox must be moved onto the Event Queue first, so
+ * that Reports pushed by other threads keep their place ahead of the local ones.
+ */
+//--------------------------------------------------------------------------------------------------
+void event_QueueLocalFunction
+(
+    event_PerThreadRec_t*   perThreadRecPtr,///< [in] Ptr to the calling thread's per-thread record.
+    le_event_DeferredFunc_t func,           ///< [in] The function.
+    void*                   param1Ptr,      ///< [in] Value to be passed to the function when called.
+    void*                   param2Ptr       ///< [in] Value to be passed to the function when called.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_sls_Queue(&perThreadRecPtr->eventQueue,
+                 &CreateQueuedFunction(func, param1Ptr, param2Ptr)->baseClass.link);
+    perThreadRecPtr->liveEventCount++;
 }
 
 
@@ -830,6 +1097,8 @@ event_PerThreadRec_t* event_CreatePerThreadInfo
 
     // Initialize the various thread-specific lists and queues.
     recPtr->eventQueue = LE_SLS_LIST_INIT;
+    recPtr->inboxPtr = NULL;
+    recPtr->uniqueList = LE_DLS_LIST_INIT;
     recPtr->handlerList = LE_DLS_LIST_INIT;
     recPtr->fdMonitorList = LE_DLS_LIST_INIT;
 
@@ -842,6 +1111,10 @@ event_PerThreadRec_t* event_CreatePerThreadInfo
     // Initialize the current event member:
     recPtr->currentEvent = NULL;
 
+    // Nothing is waiting on the Event Queue yet, and nothing has been dispatched.
+    recPtr->liveEventCount = 0;
+    memset(&recPtr->stats, 0, sizeof(recPtr->stats));
+
     // Take note of the fact that the Event Loop for this thread has been initialized, but
     // not started.
     recPtr->state = LE_EVENT_LOOP_INITIALIZED;
@@ -911,6 +1184,9 @@ void event_DestructThread
         DeleteHandler(handlerPtr);
     }
 
+    // Everything on the Unique List is about to be discarded.
+    perThreadRecPtr->uniqueList = LE_DLS_LIST_INIT;
+
     // We are finished accessing the Event List and structures under it.  Furthermore,
     // we know that all the handlers have been deleted now, so there's no risk of anyone adding
     // anything to the Event Queue anymore (unless the API user has done something stupid and
@@ -922,7 +1198,8 @@ void event_DestructThread
     // Delete all the FD Monitors for this thread.
     fdMon_DestructThread(perThreadRecPtr);
 
-    // Discard everything on the Event Queue.
+    // Discard everything on the Event Queue, including anything still in the inbox.
+    TakeEventReports(perThreadRecPtr);
     while (NULL != (singleLinkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue)))
     {
         Report_t* reportPtr = CONTAINER_OF(singleLinkPtr, Report_t, link);
@@ -1246,11 +1523,10 @@ void le_event_Report
         reportObjPtr->handlerRef = handlerPtr->safeRef;
         memset(reportObjPtr->payload, 0, eventPtr->payloadSize);
         memcpy(reportObjPtr->payload, payloadPtr, payloadSize);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+        // Push it onto the handler's thread's inbox.  This will wake up the thread if it
+        // doesn't already have something waiting.
+        PushEventReport(perThreadRecPtr, &reportObjPtr->baseClass);
 
         linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
     }
@@ -1307,11 +1583,10 @@ void le_event_ReportWithRefCounting
         reportObjPtr->handlerRef = handlerPtr->safeRef;
         reportObjPtr->payload[0] = objectPtr;
         le_mem_AddRef(objectPtr);
-        le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
 
-        // Increment the eventfd for the handler's thread's Event Queue.
-        // This will wake up the thread and tell it that it has something on its Event Queue.
-        fa_event_TriggerEvent_NoLock(perThreadRecPtr);
+        // Push it onto the handler's thread's inbox.  This will wake up the thread if it
+        // doesn't already have something waiting.
+        PushEventReport(perThreadRecPtr, &reportObjPtr->baseClass);
 
         linkPtr = le_dls_PeekNext(&eventPtr->handlerList, linkPtr);
     }
@@ -1417,11 +1692,8 @@ void le_event_QueueFunction
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = event_Lock();
-
-    QueueFunction_NoLock(thread_GetEventRecPtr(), func, param1Ptr, param2Ptr);
-
-    event_Unlock(oldState);
+    PushEventReport(thread_GetEventRecPtr(),
+                    &CreateQueuedFunction(func, param1Ptr, param2Ptr)->baseClass);
 }
 
 
@@ -1440,26 +1712,27 @@ void le_event_QueueFunctionToThread
 )
 //--------------------------------------------------------------------------------------------------
 {
-    int oldState = event_Lock();
-
-    QueueFunction_NoLock(thread_GetOtherEventRecPtr(thread), func, param1Ptr, param2Ptr);
-
-    event_Unlock(oldState);
+    PushEventReport(thread_GetOtherEventRecPtr(thread),
+                    &CreateQueuedFunction(func, param1Ptr, param2Ptr)->baseClass);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Queue a function onto a specific thread's Event Queue if it isn't already on the Event
- * Queue with the same parameters.  When it reaches the head of that Event Queue, it will be
- * called by that thread's Event Loop.
+ * Queue a function onto a specific thread's Event Queue if it isn't already waiting on that
+ * Event Queue with the same parameters, from an earlier call to this function.  When it reaches
+ * the head of that Event Queue, it will be called by that thread's Event Loop.
+ *
+ * @note Only functions queued by this function are checked.  The same function queued by
+ *       le_event_QueueFunction() or le_event_QueueFunctionToThread() is not seen as a duplicate.
+ *       A function stops being a duplicate as soon as it starts running.
  *
  * Using this function generally indicates poor design.
  * It's generally better to ensure the event is only generated once, for example by disabling
  * generating the event until the event handler is run.
  *
  * @return LE_OK if the function was queued to the Event Queue
- * @return LE_DUPLICATE if the function was already in the Event Queue
+ * @return LE_DUPLICATE if the function was already queued to the Event Queue by this function
  */
 //--------------------------------------------------------------------------------------------------
 le_result_t le_event_QueueFunctionToThreadUnique
@@ -1476,11 +1749,11 @@ le_result_t le_event_QueueFunctionToThreadUnique
 
     event_PerThreadRec_t* perThreadRecPtr = thread_GetOtherEventRecPtr(thread);
 
-    LE_SLS_FOREACH(&perThreadRecPtr->eventQueue,
-                   reportPtr, QueuedFunctionReport_t, baseClass.link)
+    // The Event Queue belongs to the other thread, so check the Unique List instead, which holds
+    // every function queued by this function that hasn't been called yet.
+    LE_DLS_FOREACH(&perThreadRecPtr->uniqueList, reportPtr, QueuedFunctionReport_t, uniqueLink)
     {
-        if (reportPtr->baseClass.type == LE_EVENT_REPORT_QUEUED_FUNC &&
-            reportPtr->function == func &&
+        if (reportPtr->function == func &&
             reportPtr->param1Ptr == param1Ptr &&
             reportPtr->param2Ptr == param2Ptr)
         {
@@ -1490,7 +1763,13 @@ le_result_t le_event_QueueFunctionToThreadUnique
         }
     }
 
-    QueueFunction_NoLock(thread_GetOtherEventRecPtr(thread), func, param1Ptr, param2Ptr);
+    reportPtr = CreateQueuedFunction(func, param1Ptr, param2Ptr);
+    reportPtr->isUnique = true;
+    le_dls_Queue(&perThreadRecPtr->uniqueList, &reportPtr->uniqueLink);
+
+    // Push while still holding the mutex, so the report can't be called (and removed from the
+    // Unique List) before it's on the list.
+    PushEventReport(perThreadRecPtr, &reportPtr->baseClass);
 
     event_Unlock(oldState);
 
@@ -106,7 +106,44 @@ void event_ProcessOneEventReport
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Process Event Reports from the calling thread's Event Queue until the queue is empty.
+ * Move any Event Reports queued to the calling thread since the last call onto its Event Queue,
+ * ready to be processed by event_ProcessOneEventReport().
+ *
+ * This is usually called from the framework adaptor implementation of le_event_ServiceLoop(),
+ * after fa_event_WaitForEvent().
+ *
+ * @return The number of Event Reports added to the Event Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t event_TakeEventReports
+(
+    event_PerThreadRec_t* perThreadRecPtr   ///< [in] Ptr to the calling thread's per-thread record.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a function call straight onto the calling thread's Event Queue, bypassing the inbox.
+ *
+ * This doesn't wake the thread up, so it must only be called by a thread's Event Loop just before
+ * it calls event_ProcessEventReports() (e.g. to report the fd events from one epoll_wait()).  The
+ * inbox must be moved onto the Event Queue with event_TakeEventReports() first, so that Reports
+ * pushed by other threads keep their place ahead of the local ones.
+ */
+//--------------------------------------------------------------------------------------------------
+void event_QueueLocalFunction
+(
+    event_PerThreadRec_t*   perThreadRecPtr,///< [in] Ptr to the calling thread's per-thread record.
+    le_event_DeferredFunc_t func,           ///< [in] The function.
+    void*                   param1Ptr,      ///< [in] Value to be passed to the function when called.
+    void*                   param2Ptr       ///< [in] Value to be passed to the function when called.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Process Event Reports from the calling thread's Event Queue, up to the limits set by
+ * LE_CONFIG_EVENT_DISPATCH_BATCH_SIZE and LE_CONFIG_EVENT_DISPATCH_BUDGET_US.
  *
  * This is usually called from the framework adaptor implementation of le_event_RunLoop() and
  * le_event_ServiceLoop()
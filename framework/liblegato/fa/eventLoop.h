@@ -28,6 +28,31 @@ typedef enum
 }
 event_LoopState_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of buckets in the dispatch time histogram of an Event Loop.  Bucket n counts the wake-ups
+ * whose reports took less than 10^(n+1) microseconds to dispatch; the last bucket counts all of the
+ * rest.
+ */
+//--------------------------------------------------------------------------------------------------
+#define EVENT_DISPATCH_HISTOGRAM_SIZE   6
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event Loop dispatch statistics.  Only updated if LE_CONFIG_EVENT_DISPATCH_STATS is enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t    wakeupCount;            ///< Number of times the Event Loop has woken up.
+    uint64_t    reportCount;            ///< Number of Event Reports dispatched.
+    uint32_t    maxReportsPerWakeup;    ///< Most Event Reports dispatched in a single wake-up.
+    uint32_t    maxQueueDepth;          ///< Most Event Reports waiting on the Event Queue.
+    uint64_t    dispatchTimeHistogram[EVENT_DISPATCH_HISTOGRAM_SIZE];
+                                        ///< Time taken to dispatch each wake-up's Event Reports.
+}
+event_DispatchStats_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event Loop's per-thread record.
@@ -41,7 +66,13 @@ event_LoopState_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    le_sls_List_t        eventQueue;        ///< The thread's event queue.
+    le_sls_List_t        eventQueue;        ///< The thread's event queue.  Only accessed by the
+                                            ///< thread itself.
+    le_sls_Link_t       *inboxPtr;          ///< Lock-free stack of reports queued by any thread,
+                                            ///< newest first, waiting to be moved onto eventQueue.
+    le_dls_List_t        uniqueList;        ///< Queued functions added by
+                                            ///< le_event_QueueFunctionToThreadUnique() that
+                                            ///< haven't been called yet.  Protected by the mutex.
     le_dls_List_t        handlerList;       ///< List of handlers registered with this thread.
     le_dls_List_t        fdMonitorList;     ///< List of FD Monitors created by this thread.
     void                *contextPtr;        ///< Context pointer from last Handler called.
@@ -50,6 +81,7 @@ typedef struct
                                             ///< balance between queued events and monitored fds
                                             ///< in le_event_ServiceLoop().
     void*                currentEvent;      ///< Pointer to the current event report being processed
+    event_DispatchStats_t stats;            ///< Dispatch statistics, for the inspect tool.
 }
 event_PerThreadRec_t;
 
@@ -102,6 +134,10 @@ void fa_event_ThreadInit
 //--------------------------------------------------------------------------------------------------
 /**
  * Inform event loop an event has fired.  Wakes the event loop if it is asleep.
+ *
+ * @note    Despite its name, this may be called without the event mutex held, from any thread.
+ *          It is called when a report is queued to an empty inbox, so successive calls may be
+ *          coalesced into a single wake-up.
  */
 //--------------------------------------------------------------------------------------------------
 void fa_event_TriggerEvent_NoLock
@@ -111,10 +147,10 @@ void fa_event_TriggerEvent_NoLock
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Wait for an event to trigger.  This fetches the value of the Event FD (which is
- * the number of event reports on the Event Queue) and resets the Event FD value to zero.
+ * Wait for an event to trigger.  This fetches the number of times the event has been triggered
+ * since the last call, and resets that number to zero.
  *
- * @return The number of Event Reports on the thread's Event Queue.
+ * @return The number of times the event was triggered (may be zero).
  */
 //--------------------------------------------------------------------------------------------------
 uint64_t fa_event_WaitForEvent
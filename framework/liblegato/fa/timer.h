@@ -33,7 +33,7 @@ timer_Type_t;
  * Timer object.  Created by le_timer_Create().
  */
 //--------------------------------------------------------------------------------------------------
-typedef struct
+typedef struct Timer
 {
     // Settable attributes
 #if LE_CONFIG_TIMER_NAMES_ENABLED
@@ -46,6 +46,12 @@ typedef struct
 
     // Internal State
     le_dls_Link_t link;                      ///< For adding to the timer list
+    struct Timer* heapChildPtr;              ///< Leftmost child in the timer heap
+    struct Timer* heapNextPtr;               ///< Next sibling in the timer heap
+    struct Timer* heapPrevPtr;               ///< Previous sibling in the timer heap, or parent if
+                                             ///  this is the leftmost child
+    uint64_t startSeq;                       ///< Start order, used to expire timers with equal
+                                             ///  expiry times in the order they were started
     bool isActive;                           ///< Is the timer active/running?
     le_clk_Time_t expiryTime;                ///< Time at which the timer should expire
     uint32_t expiryCount;                    ///< Number of times the counter has expired
@@ -68,11 +74,16 @@ Timer_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    le_dls_List_t activeTimerList;      ///< Linked list of running legato timers for this thread
-    Timer_t* firstTimerPtr;             ///< Pointer to the timer on the active list that is
-                                        ///  associated with the currently running timerFD,
-                                        ///  or NULL if there are no timers on the active list.
-                                        ///  This is normally the first timer on the list.
+    le_dls_List_t activeTimerList;      ///< Unordered list of running legato timers for this
+                                        ///  thread
+    Timer_t* heapRootPtr;               ///< Root of the pairing heap of running timers, ordered
+                                        ///  by expiry time.  This is the next timer to expire.
+    uint64_t startCount;                ///< Number of timers started, used to order timers with
+                                        ///  equal expiry times
+    Timer_t* firstTimerPtr;             ///< Pointer to the active timer that is associated with
+                                        ///  the currently running timerFD, or NULL if there are
+                                        ///  no active timers.  This is normally the root of the
+                                        ///  timer heap.
 }
 timer_ThreadRec_t;
 
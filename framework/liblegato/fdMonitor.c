@@ -256,6 +256,26 @@ void fdMon_Report
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report FD Events straight onto the calling thread's Event Queue.
+ *
+ * This is called by the Event Loop for each fd event returned by one wait, just before it
+ * processes the Event Queue.  Unlike fdMon_Report(), it doesn't wake the thread up.
+ */
+//--------------------------------------------------------------------------------------------------
+void fdMon_ReportLocal
+(
+    event_PerThreadRec_t* perThreadRecPtr,  ///< [in] Calling thread's per-thread record.
+    void        *safeRef,       ///< [in] Safe Reference for the FD Monitor object for the fd.
+    uint32_t     eventFlags     ///< [in] OR'd together event flags.
+)
+{
+    event_QueueLocalFunction(perThreadRecPtr, &DispatchToHandler,
+                             safeRef, (void *) (uintptr_t) eventFlags);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Report FD Events to another thread.
@@ -123,6 +123,14 @@ static inline le_sls_Link_t *bucket_PeekPrev
 
 #endif /* end LE_CONFIG_REDUCE_FOOTPRINT */
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of buckets split on each update while a map is being resized.  The load factor doubles
+ * at most during a resize, so anything above one is enough to finish before the next is due.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HASHMAP_SPLITS_PER_STEP 2
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Trace if tracing is enabled for a given hashmap.
@@ -139,6 +147,27 @@ static inline le_sls_Link_t *bucket_PeekPrev
 #endif /* end LE_CONFIG_HASHMAP_NAMES_ENABLED */
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Scramble a raw hash value so that poorly distributed low bits (e.g. aligned pointers) still
+ * spread across the buckets.
+ *
+ * @param h The raw hash
+ * @return  Returns the scrambled hash
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t MixHash(size_t h) {
+    // We apply this secondary hashing discovered by Doug Lea to defend
+    // against bad hashes. This is important for user-supplied hash fns
+    h += ~(h << 9);
+    h ^= (((unsigned int) h) >> 14);
+    h += (h << 4);
+    h ^= (((unsigned int) h) >> 10);
+
+    return h;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Calculate a hash. First this calls the user-supplied hash function.
@@ -159,14 +188,7 @@ static inline size_t HashKey(le_hashmap_Hashmap_t* map, const void* key) {
         return h;
     }
 
-    // We apply this secondary hashing discovered by Doug Lea to defend
-    // against bad hashes. This is important for user-supplied hash fns
-    h += ~(h << 9);
-    h ^= (((unsigned int) h) >> 14);
-    h += (h << 4);
-    h ^= (((unsigned int) h) >> 10);
-
-    return h;
+    return MixHash(h);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -212,6 +234,31 @@ static inline size_t CalculateIndex(size_t bucketCount, size_t hash) {
     return (hash) & (bucketCount - 1);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Given a hash, find the bucket in the map that holds (or will hold) the entry.
+ *
+ * While a resize is in progress the upper half of the bucket array is only used for buckets whose
+ * partner in the lower half has already been split, so every key still lives in exactly one bucket.
+ *
+ * @param mapRef The map instance
+ * @param hash The hash to use
+ * @return  Returns the index to use in the bucket array
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t CalculateMapIndex(le_hashmap_Hashmap_t* mapRef, size_t hash) {
+    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+
+    if ((mapRef->splitCount != 0) &&
+        (index >= mapRef->splitCount) &&
+        (index - mapRef->splitCount >= mapRef->splitIndex))
+    {
+        index -= mapRef->splitCount;
+    }
+    return index;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Checks if 2 keys are equal (or are actually the same key)
@@ -252,6 +299,177 @@ static le_hashmap_Bucket_t *IndexToBucket
     return (index < mapRef->bucketCount ? &mapRef->bucketsPtr[index] : NULL);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the map's iterator is between iterations (reset, or run off the end of the map).
+ * Entries may only be moved between buckets while this is the case, otherwise an iteration in
+ * progress could see an entry twice or miss it.
+ *
+ * @return  true if entries can be moved.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsIteratorIdle
+(
+    le_hashmap_Hashmap_t    *mapRef     ///< Map instance.
+)
+{
+    return ((mapRef->iterator.currentLinkPtr == NULL) &&
+            ((mapRef->iterator.currentIndex == 0) ||
+             (mapRef->iterator.currentIndex >= mapRef->bucketCount)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Double the size of the bucket array.  No entries are moved here; the new upper half starts out
+ * empty and is populated by SplitBucket() a few buckets at a time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GrowBuckets
+(
+    le_hashmap_Hashmap_t    *mapRef     ///< Map instance.
+)
+{
+    size_t               oldCount = mapRef->bucketCount;
+    size_t               newCount = oldCount * 2;
+    size_t               i;
+    le_hashmap_Bucket_t *newBucketsPtr;
+
+    if ((newCount <= oldCount) || (newCount > SIZE_MAX / sizeof(le_hashmap_Bucket_t)))
+    {
+        return;
+    }
+
+    // Bucket list heads are not referenced by their links, so the array can be moved freely.
+    newBucketsPtr = realloc(mapRef->bucketsPtr, newCount * sizeof(le_hashmap_Bucket_t));
+    if (newBucketsPtr == NULL)
+    {
+        // Not fatal; the map keeps working with longer chains.
+        LE_WARN("Unable to grow hashmap to %" PRIuS " buckets", newCount);
+        return;
+    }
+
+    for (i = oldCount; i < newCount; i++)
+    {
+        newBucketsPtr[i] = BUCKET_LIST_INIT;
+    }
+
+    // Keep an iterator which has run off the end of the map at the end.
+    if (mapRef->iterator.currentIndex >= oldCount)
+    {
+        mapRef->iterator.currentIndex = newCount;
+    }
+
+    mapRef->bucketsPtr = newBucketsPtr;
+    mapRef->bucketCount = newCount;
+    mapRef->splitCount = oldCount;
+    mapRef->splitIndex = 0;
+
+    le_mem_SetNumObjsToForce(mapRef->entryPoolRef, newCount / 8);
+
+    HASHMAP_TRACE(
+        mapRef,
+        "Hashmap %s: Growing to %" PRIuS " buckets",
+        mapRef->nameStr,
+        newCount
+    );
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Split the next unsplit bucket of the lower half, moving the entries which now hash to its
+ * partner in the upper half.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SplitBucket
+(
+    le_hashmap_Hashmap_t    *mapRef     ///< Map instance.
+)
+{
+    size_t               lowIndex = mapRef->splitIndex;
+    size_t               highIndex = lowIndex + mapRef->splitCount;
+    le_hashmap_Bucket_t *lowListPtr = &mapRef->bucketsPtr[lowIndex];
+    le_hashmap_Bucket_t *highListPtr = &mapRef->bucketsPtr[highIndex];
+    le_hashmap_Link_t   *theLinkPtr = bucket_Peek(lowListPtr);
+    le_hashmap_Link_t   *prevLinkPtr = NULL;
+
+    while (theLinkPtr != NULL)
+    {
+        le_hashmap_Entry_t *currentEntryPtr = CONTAINER_OF(theLinkPtr,
+                                                           le_hashmap_Entry_t,
+                                                           entryListLink);
+        le_hashmap_Link_t  *nextLinkPtr = bucket_PeekNext(lowListPtr, theLinkPtr);
+
+        if (CalculateIndex(mapRef->bucketCount,
+                           HashKey(mapRef, currentEntryPtr->keyPtr)) == highIndex)
+        {
+            bucket_Remove(lowListPtr, theLinkPtr, prevLinkPtr);
+            bucket_Queue(highListPtr, theLinkPtr);
+        }
+        else
+        {
+            prevLinkPtr = theLinkPtr;
+        }
+        theLinkPtr = nextLinkPtr;
+    }
+
+    if (++mapRef->splitIndex == mapRef->splitCount)
+    {
+        mapRef->splitCount = 0;
+        mapRef->splitIndex = 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform one step of an incremental resize.  Starts a new resize once the load factor exceeds
+ * 0.75, then splits a few buckets per call so the cost is spread over many updates.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ResizeStep
+(
+    le_hashmap_Hashmap_t    *mapRef     ///< Map instance.
+)
+{
+    size_t i;
+
+    if (!mapRef->isResizable)
+    {
+        return;
+    }
+
+    if (mapRef->splitCount == 0)
+    {
+        if (mapRef->size <= mapRef->bucketCount - mapRef->bucketCount / 4)
+        {
+            return;
+        }
+        GrowBuckets(mapRef);
+    }
+
+    // Defer splitting while an iteration is in progress.  The map remains consistent, so this
+    // only delays the resize until the iterator is reset or reaches the end.  An iterator that is
+    // never finished must not hold the resize off forever though: once the map holds as many
+    // entries as it has buckets, the unsplit chains are twice as long as intended, so the
+    // iteration is invalidated and the split goes ahead.
+    if (!IsIteratorIdle(mapRef))
+    {
+        if (mapRef->size <= mapRef->bucketCount)
+        {
+            return;
+        }
+
+        LE_WARN("Iteration in progress invalidated to let hashmap grow past %" PRIuS " entries",
+                mapRef->size);
+        mapRef->iterator.currentIndex = mapRef->bucketCount;
+        mapRef->iterator.currentLinkPtr = NULL;
+    }
+
+    for (i = 0; (i < HASHMAP_SPLITS_PER_STEP) && (mapRef->splitCount != 0); i++)
+    {
+        SplitBucket(mapRef);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get number of buckets required for a given capacity
@@ -362,10 +580,11 @@ le_hashmap_Ref_t _le_hashmap_Create
 #endif
 
     size_t bucketCount = GetBucketCount(capacity);
+    le_hashmap_Ref_t mapRef;
 
     // Use same function internally as static allocation, but take pointers from
     // heap instead of static memory
-    return _le_hashmap_InitStatic(
+    mapRef = _le_hashmap_InitStatic(
 #if LE_CONFIG_HASHMAP_NAMES_ENABLED
         nameStr,
 #endif
@@ -377,6 +596,10 @@ le_hashmap_Ref_t _le_hashmap_Create
                                             sizeof(le_hashmap_Entry_t)),
                           bucketCount / 2),
         calloc(bucketCount, sizeof(le_hashmap_Bucket_t)));
+
+    // The bucket array came from the heap, so it can grow as the map fills up.
+    mapRef->isResizable = true;
+    return mapRef;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -397,7 +620,7 @@ void* le_hashmap_Put
 )
 {
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = CalculateMapIndex(mapRef, hash);
 
     HASHMAP_TRACE(
         mapRef,
@@ -424,6 +647,7 @@ void* le_hashmap_Put
             mapRef->size
         );
 
+        ResizeStep(mapRef);
         return NULL;
     }
     else
@@ -479,6 +703,7 @@ void* le_hashmap_Put
                     bucket_NumLinks(listHeadPtr)
                 );
 
+                ResizeStep(mapRef);
                 return NULL;
             }
 
@@ -504,7 +729,7 @@ void* le_hashmap_Get
 )
 {
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = CalculateMapIndex(mapRef, hash);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
@@ -566,7 +791,7 @@ void* le_hashmap_GetStoredKey
 )
 {
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = CalculateMapIndex(mapRef, hash);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
@@ -631,7 +856,7 @@ void* le_hashmap_Remove
 )
 {
     int hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = CalculateMapIndex(mapRef, hash);
 
     HASHMAP_TRACE(
         mapRef,
@@ -670,6 +895,7 @@ void* le_hashmap_Remove
                 mapRef->nameStr
             );
 
+            ResizeStep(mapRef);
             return value;
         }
 
@@ -736,7 +962,7 @@ bool le_hashmap_ContainsKey
 )
 {
     int hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = CalculateMapIndex(mapRef, hash);
 
     HASHMAP_TRACE(
         mapRef,
@@ -813,6 +1039,10 @@ void le_hashmap_RemoveAll
     }
     mapRef->size = 0;
 
+    // Nothing left to move, so any resize in progress is complete.
+    mapRef->splitCount = 0;
+    mapRef->splitIndex = 0;
+
     HASHMAP_TRACE(
        mapRef,
        "Hashmap %s: All entries deleted from map",
@@ -1170,7 +1400,7 @@ le_result_t le_hashmap_GetNodeAfter
 
     // Find the node pointed to by the key
     size_t hash = HashKey(mapRef, keyPtr);
-    size_t index = CalculateIndex(mapRef->bucketCount, hash);
+    size_t index = CalculateMapIndex(mapRef, hash);
     HASHMAP_TRACE(
         mapRef,
         "Hashmap %s: Generated index of %" PRIuS " for hash %" PRIuS,
@@ -1442,6 +1672,338 @@ bool le_hashmap_EqualsVoidPointer
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * A slot in a flat hashmap's table.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uintptr_t    key;           ///< Key stored in this slot.
+    const void  *valuePtr;      ///< Pointer to value data.
+    size_t       distance;      ///< One more than the distance from the slot the key hashes to,
+                                ///< or 0 if the slot is empty.
+}
+FlatSlot_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A flat hashmap.  Collisions are resolved with Robin Hood linear probing: an entry being inserted
+ * displaces any entry which is closer to its home slot, which keeps probe sequences short and lets
+ * lookups for missing keys stop early.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_hashmap_Flat
+{
+    FlatSlot_t  *slotsPtr;      ///< Table of slots.
+    size_t       slotCount;     ///< Number of slots (always a power of 2).
+    size_t       size;          ///< Number of inserted entries.
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    const char  *nameStr;       ///< Name of the hashmap for diagnostic purposes.
+#endif
+}
+FlatMap_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Insert an entry into a flat hashmap's table, which must not already contain the key and must
+ * have at least one empty slot.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlatInsertNew
+(
+    FlatSlot_t  *slotsPtr,      ///< Table of slots.
+    size_t       slotCount,     ///< Number of slots.
+    uintptr_t    key,           ///< Key to insert.
+    const void  *valuePtr       ///< Value to insert.
+)
+{
+    FlatSlot_t  entry = { .key = key, .valuePtr = valuePtr, .distance = 1 };
+    size_t      index = CalculateIndex(slotCount, MixHash(key));
+
+    while (slotsPtr[index].distance != 0)
+    {
+        if (slotsPtr[index].distance < entry.distance)
+        {
+            FlatSlot_t displaced = slotsPtr[index];
+            slotsPtr[index] = entry;
+            entry = displaced;
+        }
+        index = CalculateIndex(slotCount, index + 1);
+        entry.distance++;
+    }
+    slotsPtr[index] = entry;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the slot holding a key in a flat hashmap.
+ *
+ * @return  Pointer to the slot, or NULL if the key is not in the map.
+ */
+//--------------------------------------------------------------------------------------------------
+static FlatSlot_t *FlatFind
+(
+    FlatMap_t   *mapPtr,        ///< Map instance.
+    uintptr_t    key            ///< Key to look for.
+)
+{
+    size_t index = CalculateIndex(mapPtr->slotCount, MixHash(key));
+    size_t distance;
+
+    // Any entry for the key must be found before an entry which is closer to its own home slot.
+    for (distance = 1; mapPtr->slotsPtr[index].distance >= distance; distance++)
+    {
+        if (mapPtr->slotsPtr[index].key == key)
+        {
+            return &mapPtr->slotsPtr[index];
+        }
+        index = CalculateIndex(mapPtr->slotCount, index + 1);
+    }
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Double the size of a flat hashmap's table, re-inserting all entries.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlatGrow
+(
+    FlatMap_t   *mapPtr         ///< Map instance.
+)
+{
+    size_t       newCount = mapPtr->slotCount * 2;
+    FlatSlot_t  *newSlotsPtr;
+    size_t       i;
+
+    LE_ASSERT(newCount > mapPtr->slotCount);
+    newSlotsPtr = calloc(newCount, sizeof(FlatSlot_t));
+    LE_ASSERT(newSlotsPtr);
+
+    for (i = 0; i < mapPtr->slotCount; i++)
+    {
+        if (mapPtr->slotsPtr[i].distance != 0)
+        {
+            FlatInsertNew(newSlotsPtr, newCount, mapPtr->slotsPtr[i].key,
+                          mapPtr->slotsPtr[i].valuePtr);
+        }
+    }
+
+    free(mapPtr->slotsPtr);
+    mapPtr->slotsPtr = newSlotsPtr;
+    mapPtr->slotCount = newCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a flat HashMap.
+ *
+ * @return  Returns a reference to the map.
+ *
+ * @note Terminates the process on failure, so no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_hashmap_FlatRef_t le_hashmap_CreateFlat
+(
+    const char  *nameStr,       ///< [in] Name of the HashMap
+    size_t       capacity       ///< [in] Expected capacity of the map
+)
+{
+    FlatMap_t *mapPtr = calloc(1, sizeof(FlatMap_t));
+    LE_ASSERT(mapPtr);
+
+#if LE_CONFIG_HASHMAP_NAMES_ENABLED
+    LE_ASSERT(nameStr);
+    mapPtr->nameStr = nameStr;
+#else
+    LE_UNUSED(nameStr);
+#endif
+
+    mapPtr->slotCount = GetBucketCount(capacity);
+    mapPtr->slotsPtr = calloc(mapPtr->slotCount, sizeof(FlatSlot_t));
+    LE_ASSERT(mapPtr->slotsPtr);
+
+    return mapPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a key-value pair to a flat HashMap. If the key already exists in the map then the previous
+ * value will be replaced with the new value passed into this function.
+ *
+ * The process will terminate if this fails as it implies an inability to allocate any more memory
+ *
+ * @return  Returns NULL for a new entry or a pointer to the old value if it is replaced.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_hashmap_FlatPut
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map
+    uintptr_t                key,       ///< [in] Key to be stored
+    const void              *valuePtr   ///< [in] Pointer to the value to be stored
+)
+{
+    FlatSlot_t *slotPtr = FlatFind(mapRef, key);
+
+    if (slotPtr != NULL)
+    {
+        const void *oldValuePtr = slotPtr->valuePtr;
+        slotPtr->valuePtr = valuePtr;
+        return (void *)oldValuePtr;
+    }
+
+    // Keep the load factor at or below 0.75, as for chained maps.
+    if (mapRef->size + 1 > mapRef->slotCount - mapRef->slotCount / 4)
+    {
+        FlatGrow(mapRef);
+    }
+
+    FlatInsertNew(mapRef->slotsPtr, mapRef->slotCount, key, valuePtr);
+    mapRef->size++;
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve a value from a flat HashMap.
+ *
+ * @return  Returns a pointer to the value or NULL if the key is not found.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_hashmap_FlatGet
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map
+    uintptr_t                key        ///< [in] Key to be retrieved
+)
+{
+    FlatSlot_t *slotPtr = FlatFind(mapRef, key);
+
+    return (slotPtr != NULL ? (void *)slotPtr->valuePtr : NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tests if a flat HashMap contains a particular key.
+ *
+ * @return  Returns true if the key is found, false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_hashmap_FlatContainsKey
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map
+    uintptr_t                key        ///< [in] Key to be searched for
+)
+{
+    return (FlatFind(mapRef, key) != NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a value from a flat HashMap.
+ *
+ * @return  Returns a pointer to the value or NULL if the key is not found.
+ */
+//--------------------------------------------------------------------------------------------------
+void* le_hashmap_FlatRemove
+(
+    le_hashmap_FlatRef_t     mapRef,    ///< [in] Reference to the map
+    uintptr_t                key        ///< [in] Key to be removed
+)
+{
+    FlatSlot_t  *slotPtr = FlatFind(mapRef, key);
+    void        *valuePtr;
+    size_t       index;
+    size_t       nextIndex;
+
+    if (slotPtr == NULL)
+    {
+        return NULL;
+    }
+
+    valuePtr = (void *)slotPtr->valuePtr;
+
+    // Shift the following entries of the probe sequence back by one, so no tombstones are needed.
+    index = slotPtr - mapRef->slotsPtr;
+    nextIndex = CalculateIndex(mapRef->slotCount, index + 1);
+    while (mapRef->slotsPtr[nextIndex].distance > 1)
+    {
+        mapRef->slotsPtr[index] = mapRef->slotsPtr[nextIndex];
+        mapRef->slotsPtr[index].distance--;
+        index = nextIndex;
+        nextIndex = CalculateIndex(mapRef->slotCount, index + 1);
+    }
+    mapRef->slotsPtr[index].distance = 0;
+    mapRef->size--;
+
+    return valuePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Calculates the number of keys in a flat HashMap.
+ *
+ * @return  The number of keys in the HashMap.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t le_hashmap_FlatSize
+(
+    le_hashmap_FlatRef_t     mapRef     ///< [in] Reference to the map
+)
+{
+    return mapRef->size;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Deletes all the entries held in a flat HashMap.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_hashmap_FlatRemoveAll
+(
+    le_hashmap_FlatRef_t     mapRef     ///< [in] Reference to the map
+)
+{
+    memset(mapRef->slotsPtr, 0, mapRef->slotCount * sizeof(FlatSlot_t));
+    mapRef->size = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Iterates over a flat HashMap, calling the supplied callback with each key-value pair. If the
+ * callback returns false for any key then this function will return.
+ *
+ * @return  Returns true if all elements were checked; or false if iteration was stopped early
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_hashmap_FlatForEach
+(
+    le_hashmap_FlatRef_t             mapRef,     ///< [in] Reference to the map
+    le_hashmap_FlatForEachHandler_t  forEachFn,  ///< [in] Callback to call with each pair
+    void                            *contextPtr  ///< [in] Context to supply to the callback
+)
+{
+    size_t i;
+    size_t remaining = mapRef->size;
+
+    for (i = 0; (i < mapRef->slotCount) && (remaining > 0); i++)
+    {
+        if (mapRef->slotsPtr[i].distance != 0)
+        {
+            remaining--;
+            if (!forEachFn(mapRef->slotsPtr[i].key, (void *)mapRef->slotsPtr[i].valuePtr,
+                           contextPtr))
+            {
+                // Despite stopping early, all elements have been examined if this was the last.
+                return (remaining == 0);
+            }
+        }
+    }
+
+    return true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Makes a particular hashmap traceable without enabling the tracing.  After this is called, when
@@ -57,8 +57,16 @@ typedef struct le_json_ParsingSession
     int fd;                         ///< File descriptor to read the JSON document from, if parsing
                                     ///< from a document.
     le_fdMonitor_Ref_t fdMonitor;   ///< File Descriptor Monitor used to monitor the fd.
-    const char *jsonString;         ///< String to read from, if parsing from a string.
-    size_t bytesRead;               ///< # of bytes read from the file descriptor.
+#if LE_CONFIG_LINUX
+    bool canRewind;                 ///< true if the fd is a regular file, so data read ahead of
+                                    ///< the parser can be given back when parsing stops.
+    size_t readPos;                 ///< Index of the next unprocessed byte in readBuffer.
+    size_t readLen;                 ///< # of bytes of data in readBuffer.
+    char readBuffer[LE_CONFIG_JSON_READ_BLOCK_SIZE]; ///< Data read from the fd.
+#endif
+    const char *jsonString;         ///< String or buffer to read from, if not parsing from an fd.
+    size_t jsonLength;              ///< Size of the buffer to read from, or SIZE_MAX for a string.
+    size_t bytesRead;               ///< # of bytes of the document processed so far.
     size_t line;                    ///< Line number of the JSON document (starts at 1).
 
     le_json_ErrorHandler_t errorHandler; ///< Function to call when errors happen.
@@ -124,6 +132,32 @@ static inline bool NotStopped
 }
 
 
+#if LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give back any data which has been read from the file descriptor but not processed by the parser,
+ * so the file offset is left just past the end of the parsed part of the document.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RewindUnprocessedData
+(
+    Parser_t* parserPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    off_t unprocessed = (off_t)(parserPtr->readLen - parserPtr->readPos);
+
+    if ((unprocessed > 0) && (lseek(parserPtr->fd, -unprocessed, SEEK_CUR) == (off_t)-1))
+    {
+        LE_WARN("Failed to rewind JSON document fd %d (%m).", parserPtr->fd);
+    }
+
+    parserPtr->readPos = 0;
+    parserPtr->readLen = 0;
+}
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Stops parsing.  (Stopping a stopped parser is okay.)
@@ -141,6 +175,7 @@ static void StopParsing
         if (parserPtr->fdMonitor != NULL)
         {
 #if LE_CONFIG_LINUX
+            RewindUnprocessedData(parserPtr);
             le_fdMonitor_Delete(parserPtr->fdMonitor);
             parserPtr->fdMonitor = NULL;
 #else
@@ -874,6 +909,10 @@ static void ProcessChar
 //--------------------------------------------------------------------------------------------------
 /**
  * Read data from the JSON document file descriptor and process it.
+ *
+ * Regular files are read a block at a time.  Other fds (pipes, sockets, etc.) are read one byte
+ * at a time, because anything following the document in the stream belongs to the caller and
+ * could not be given back if it were read ahead.
  */
 //--------------------------------------------------------------------------------------------------
 static void ReadData
@@ -887,9 +926,25 @@ static void ReadData
     {
         char c;
         ssize_t bytesRead;
+
+        if (parserPtr->readPos < parserPtr->readLen)
+        {
+            c = parserPtr->readBuffer[parserPtr->readPos];
+            parserPtr->readPos++;
+            parserPtr->bytesRead++;
+            if (c == '\n')
+            {
+                parserPtr->line++;
+            }
+            ProcessChar(parserPtr, c);
+            continue;
+        }
+
         do
         {
-            bytesRead = read(fd, &c, 1);
+            bytesRead = read(fd,
+                             parserPtr->readBuffer,
+                             (parserPtr->canRewind ? sizeof(parserPtr->readBuffer) : 1));
         }
         while ((bytesRead == -1) && (errno == EINTR));
 
@@ -934,12 +989,8 @@ static void ReadData
         }
         else
         {
-            parserPtr->bytesRead++;
-            if (c == '\n')
-            {
-                parserPtr->line++;
-            }
-            ProcessChar(parserPtr, c);
+            parserPtr->readPos = 0;
+            parserPtr->readLen = bytesRead;
         }
     }
 }
@@ -995,7 +1046,7 @@ static void FdEventHandler
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read data from the JSON document string and process it.
+ * Read data from the JSON document string or buffer and process it.
  */
 //--------------------------------------------------------------------------------------------------
 static void StringEventHandler
@@ -1014,6 +1065,13 @@ static void StringEventHandler
 
     while (NotStopped(parserPtr))
     {
+        if (parserPtr->bytesRead >= parserPtr->jsonLength) // End of buffer?
+        {
+            // The document has been truncated.
+            Error(parserPtr, LE_JSON_READ_ERROR, "Unexpected end of JSON buffer");
+            break;
+        }
+
         c = parserPtr->jsonString[parserPtr->bytesRead];
         if (c == '\0') // End of string?
         {
@@ -1093,6 +1151,11 @@ le_json_ParsingSessionRef_t le_json_Parse
     Parser_t* parserPtr = NewParser(eventHandler, errorHandler, opaquePtr);
 
     parserPtr->fd = fd;
+
+    // Only read ahead of the parser if the unprocessed data can be given back afterwards.
+    struct stat fileInfo;
+    parserPtr->canRewind = (fstat(fd, &fileInfo) == 0) && S_ISREG(fileInfo.st_mode);
+
     parserPtr->fdMonitor = le_fdMonitor_Create("le_json", fd, FdEventHandler, POLLIN);
     le_fdMonitor_SetContextPtr(parserPtr->fdMonitor, parserPtr);
 
@@ -1123,6 +1186,38 @@ le_json_ParsingSessionRef_t le_json_ParseString
 
     parserPtr->fd = -1;
     parserPtr->jsonString = jsonString;
+    parserPtr->jsonLength = SIZE_MAX;
+    le_event_QueueFunction((le_event_DeferredFunc_t) &StringEventHandler, parserPtr, NULL);
+
+    // Create the top-level context and push it onto the context stack.
+    PushContext(parserPtr, LE_JSON_CONTEXT_DOC, eventHandler);
+
+    return parserPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parse a JSON document held in a memory buffer (e.g., a memory-mapped file).  The buffer is not
+ * copied, so it must remain valid and unchanged until parsing stops.
+ *
+ * @return Reference to the JSON parsing session started by this function call.
+ */
+//--------------------------------------------------------------------------------------------------
+le_json_ParsingSessionRef_t le_json_ParseBuffer
+(
+    const void *bufferPtr,  ///< Buffer containing the JSON document.  Need not be null-terminated.
+    size_t bufferSize,      ///< Number of bytes in the buffer.
+    le_json_EventHandler_t  eventHandler,   ///< Function to call when normal parsing events happen.
+    le_json_ErrorHandler_t  errorHandler,   ///< Function to call when errors happen.
+    void* opaquePtr   ///< Opaque pointer to be fetched by handlers using le_json_GetOpaquePtr().
+)
+{
+    // Create a Parser.
+    Parser_t* parserPtr = NewParser(eventHandler, errorHandler, opaquePtr);
+
+    parserPtr->fd = -1;
+    parserPtr->jsonString = bufferPtr;
+    parserPtr->jsonLength = bufferSize;
     le_event_QueueFunction((le_event_DeferredFunc_t) &StringEventHandler, parserPtr, NULL);
 
     // Create the top-level context and push it onto the context stack.
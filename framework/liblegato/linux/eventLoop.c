@@ -19,10 +19,12 @@
  * Included in the set of file descriptors that are being monitored by epoll is an eventfd
  * (see 'man eventfd') monitored in "level-triggered" mode.
  *
- * Whenever an Event Report is added to the Event Queue for a thread, the number 1 is written to
- * that thread's eventfd.  When Event Reports are popped off a thread's Event Queue, that thread's
- * eventfd is read to decrement it.  As long as the eventfd's value is greater than 0, epoll_wait()
- * will return immediately, reporting that there is something to read from that fd.
+ * Whenever an Event Report is pushed onto a thread's empty inbox (see @ref eventLoop.c), the
+ * number 1 is written to that thread's eventfd.  Reports pushed onto an inbox that is already
+ * non-empty don't write to the eventfd, because the thread is already due to wake up.  The thread
+ * reads the eventfd to reset it to zero before taking the contents of its inbox.  As long as the
+ * eventfd's value is greater than 0, epoll_wait() will return immediately, reporting that there
+ * is something to read from that fd.
  *
  * The Event Loop is an infinite loop that calls epoll_wait() and then responds to any fd events
  * that epoll_wait() reports.  If epoll_wait() reports an event on the eventfd, then an Event Report
@@ -154,7 +156,7 @@ event_PerThreadRec_t* fa_event_CreatePerThreadInfo
 
     // Open an eventfd for this thread.  This will be uses to signal to the epoll fd that there
     // are Event Reports on the Event Queue.
-    recPtr->eventQueueFd = eventfd(0, 0);
+    recPtr->eventQueueFd = eventfd(0, EFD_NONBLOCK);
     LE_FATAL_IF(recPtr->eventQueueFd < 0, "eventfd() failed with errno %d.", errno);
 
     // Add the eventfd to the list of file descriptors to wait for using epoll_wait().
@@ -219,7 +221,7 @@ void fa_event_DestructThread
 /**
  * Write to a thread's Event File Descriptor.  This increments it by one.
  *
- * This must be done exactly once for each Event Report pushed onto the thread's Event Queue.
+ * This is done when an Event Report is pushed onto the thread's empty inbox.
  */
 //--------------------------------------------------------------------------------------------------
 void fa_event_TriggerEvent_NoLock
@@ -259,10 +261,10 @@ void fa_event_TriggerEvent_NoLock
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read a thread's Event File Descriptor.  This fetches the value of the Event FD (which is
- * the number of event reports on the Event Queue) and resets the Event FD value to zero.
+ * Read a thread's Event File Descriptor.  This fetches the value of the Event FD (the number of
+ * times the thread has been woken up since the last read) and resets the Event FD value to zero.
  *
- * @return The number of Event Reports on the thread's Event Queue.
+ * @return The number of wake-ups (zero if there were none).
  */
 //--------------------------------------------------------------------------------------------------
 uint64_t fa_event_WaitForEvent
@@ -284,6 +286,11 @@ uint64_t fa_event_WaitForEvent
         {
             return readBuff;
         }
+        else if ((readSize == -1) && (errno == EAGAIN))
+        {
+            // Not triggered since the last read.
+            return 0;
+        }
         else
         {
             if ((readSize == -1) && (errno != EINTR))
@@ -345,9 +352,16 @@ void fa_event_RunLoop
             // Check if someone has cancelled the thread and terminate the thread now, if so.
             pthread_testcancel();
 
+            // Move whatever other threads have already pushed onto our inbox to the Event
+            // Queue first, so that those Reports are still processed ahead of the fd events
+            // that come after them.
+            perThreadRecPtr->liveEventCount += event_TakeEventReports(perThreadRecPtr);
+
             // For each fd event reported by epoll_wait(), if it is any file descriptor other
             // than the eventfd (which is used to indicate that there is something on the
-            // Event Queue), queue an Event Report to the Event Queue for that fd.
+            // Event Queue), queue an Event Report to the Event Queue for that fd.  These go
+            // straight onto the Event Queue as one batch, because we are about to process it
+            // anyway; there's no need to wake ourselves up through the eventfd.
             for (i = 0; i < result; i++)
             {
                 // Get the pointer that we registered with epoll_ctl(2) along with this fd.
@@ -358,11 +372,12 @@ void fa_event_RunLoop
 
                 if (safeRef != NULL)
                 {
-                    fdMon_Report(safeRef, EPollToPoll(epollEventList[i].events));
+                    fdMon_ReportLocal(perThreadRecPtr, safeRef,
+                                      EPollToPoll(epollEventList[i].events));
                 }
             }
 
-            // Process all the Event Reports on the Event Queue.
+            // Process the Event Reports on the Event Queue.
             event_ProcessEventReports(perThreadRecPtr);
         }
         // Otherwise, if an epoll_wait() reported an error, hopefully it's just an interruption
@@ -514,8 +529,9 @@ le_result_t le_event_ServiceLoop
     }
 
     // Read the eventfd to reset it to zero so epoll stops telling us about it until more
-    // are added.
-    perThreadRecPtr->liveEventCount = fa_event_WaitForEvent(perThreadRecPtr);
+    // are added, then fetch what has been queued.
+    fa_event_WaitForEvent(perThreadRecPtr);
+    perThreadRecPtr->liveEventCount = event_TakeEventReports(perThreadRecPtr);
 
     LE_DEBUG("perThreadRecPtr->liveEventCount is" "%" PRIu64, perThreadRecPtr->liveEventCount);
 
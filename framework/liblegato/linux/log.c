@@ -13,14 +13,15 @@
 #include "log.h"
 #include "logDaemon/logDaemon.h"
 #include "logPlatform.h"
+#include "logRing.h"
 #include "messagingSession.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Maximum length of log messages.
+ * Identity under which messages are sent to syslog.
  */
 //--------------------------------------------------------------------------------------------------
-#define MAX_MSG_SIZE            256
+#define SYSLOG_IDENT            "Legato"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -358,6 +359,7 @@ static void SetLogLevelFilter
     {
         // Set this component's level.
         sessionPtr->level = levelFilter;
+        log_InvalidateFilterCache();
     }
 
     Unlock();
@@ -910,7 +912,7 @@ void fa_log_Init
     TraceRef = le_log_GetTraceRef("logControl");
 
     // Set the syslog format.
-    openlog("Legato", 0, LOG_USER);
+    openlog(SYSLOG_IDENT, 0, LOG_USER);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -924,7 +926,7 @@ void log_ReInit
 )
 {
     closelog();
-    openlog("Legato", 0, LOG_USER);
+    openlog(SYSLOG_IDENT, 0, LOG_USER);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1111,6 +1113,183 @@ static int ConvertToSyslogLevel
 }
 #endif
 
+#if defined(LEGATO_EMBEDDED) && LE_CONFIG_LOG_DEFERRED
+//--------------------------------------------------------------------------------------------------
+/**
+ * Path of the syslog socket.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SYSLOG_SOCKET_PATH      "/dev/log"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Socket connected to syslog, used to send deferred messages with the time they were logged.
+ * Only used by the deferred log ring's flusher, so it needs no locking.  -1 if not connected.
+ */
+//--------------------------------------------------------------------------------------------------
+static int SyslogFd = -1;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a complete syslog message (priority, timestamp and ident included) to the syslog socket,
+ * reconnecting once if the socket has gone away.
+ *
+ * @return true if the message was sent.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendToSyslog
+(
+    const char *bufPtr,     ///< [IN] Message.
+    size_t      len         ///< [IN] Length of the message.
+)
+{
+    int attempt;
+
+    for (attempt = 0; attempt < 2; attempt++)
+    {
+        if (SyslogFd < 0)
+        {
+            struct sockaddr_un addr = { .sun_family = AF_UNIX, .sun_path = SYSLOG_SOCKET_PATH };
+
+            SyslogFd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            if (SyslogFd < 0)
+            {
+                return false;
+            }
+            if (connect(SyslogFd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+            {
+                close(SyslogFd);
+                SyslogFd = -1;
+                return false;
+            }
+        }
+
+        if (send(SyslogFd, bufPtr, len, MSG_NOSIGNAL) == (ssize_t)len)
+        {
+            return true;
+        }
+
+        close(SyslogFd);
+        SyslogFd = -1;
+    }
+
+    return false;
+}
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a formatted log message out to the log.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_WriteMsg
+(
+    le_log_Level_t          level,              ///< [IN] Severity level, or -1 for a trace.
+    const char             *levelPtr,           ///< [IN] Severity string or trace keyword.
+    const char             *compNamePtr,        ///< [IN] Component name.
+    const char             *threadNamePtr,      ///< [IN] Thread name.
+    const char             *baseFileNamePtr,    ///< [IN] Base name of the source file.
+    const char             *functionNamePtr,    ///< [IN] Function name (may be NULL).
+    unsigned int            lineNumber,         ///< [IN] Line number.
+    const struct timespec  *timePtr,            ///< [IN] Time the message was logged, or NULL
+                                                ///       for now.
+    const char             *msgPtr              ///< [IN] User message.
+)
+{
+    // Get the process name.
+    const char* procNamePtr = le_arg_GetProgramName();
+    if (procNamePtr == NULL)
+    {
+        procNamePtr = "n/a";
+    }
+
+    // If running on an embedded target, write the message out to the log.
+#ifdef LEGATO_EMBEDDED
+
+#if LE_CONFIG_LOG_DEFERRED
+    // syslog() stamps messages with the time they are written, so messages that were deferred
+    // are sent to the syslog socket directly, stamped with the time they were logged.
+    if (timePtr != NULL)
+    {
+        char buf[LOG_MAX_MSG_SIZE + 256];
+        struct tm localTime;
+        size_t len;
+
+        len = snprintf(buf, sizeof(buf), "<%d>", LOG_USER | ConvertToSyslogLevel(level));
+        if (localtime_r(&timePtr->tv_sec, &localTime) != NULL)
+        {
+            len += strftime(buf + len, sizeof(buf) - len, "%b %e %T ", &localTime);
+        }
+
+        if (functionNamePtr == NULL)
+        {
+            len += snprintf(buf + len, sizeof(buf) - len,
+                            SYSLOG_IDENT ": %s | %s[%d]/%s T=%s | %s %d | %s\n",
+                            levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr,
+                            baseFileNamePtr, lineNumber, msgPtr);
+        }
+        else
+        {
+            len += snprintf(buf + len, sizeof(buf) - len,
+                            SYSLOG_IDENT ": %s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
+                            levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr,
+                            baseFileNamePtr, functionNamePtr, lineNumber, msgPtr);
+        }
+
+        if (SendToSyslog(buf, (len < sizeof(buf) ? len : sizeof(buf) - 1)))
+        {
+            return;
+        }
+    }
+#endif
+
+    if (functionNamePtr == NULL)
+    {
+        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %d | %s\n",
+           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
+           lineNumber, msgPtr);
+    }
+    else
+    {
+        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
+           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
+           functionNamePtr, lineNumber, msgPtr);
+    }
+
+    // If running on a PC, write the message to standard error with a timestamp added.
+#else
+
+    time_t now = (timePtr != NULL ? timePtr->tv_sec : time(NULL));
+    char timeStamp[26] = "";
+    char* timeStampPtr = timeStamp;
+
+    if ( (now != ((time_t)-1)) && (ctime_r(&now, timeStamp) != NULL) )
+    {
+        // Tue Jan 14 18:01:56 2014
+        // 0123456789012345678901234
+        timeStampPtr = timeStamp + 4; // Skip day of week.
+        timeStamp[19] = '\0';  // Exclude the year.
+    }
+
+    if (functionNamePtr == NULL)
+    {
+        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %d | %s\n",
+                timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr,
+                threadNamePtr, baseFileNamePtr, lineNumber, msgPtr);
+    }
+    else
+    {
+        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
+            timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr,
+            baseFileNamePtr, functionNamePtr, lineNumber, msgPtr);
+    }
+
+#endif
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Builds the log message and sends it to the logging system.
@@ -1176,18 +1355,17 @@ void fa_log_Send
     // Get the file name.
     char* baseFileNamePtr = le_path_GetBasenamePtr((char*)filenamePtr, "/");
 
-    // Get the thread name.
-    const char* threadNamePtr = le_thread_GetMyName();
-
-    // Get the process name.
-    const char* procNamePtr = le_arg_GetProgramName();
-    if (procNamePtr == NULL)
+#if LE_CONFIG_LOG_DEFERRED
+    // Leave the formatting to the flusher thread, if the message can be deferred.
+    if (logRing_Send(level, levelPtr, compNamePtr, baseFileNamePtr, functionNamePtr, lineNumber,
+                     savedErrno, formatPtr, args))
     {
-        procNamePtr = "n/a";
+        return;
     }
+#endif
 
     // Get the user message.
-    char msg[MAX_MSG_SIZE] = "";
+    char msg[LOG_MAX_MSG_SIZE] = "";
 
     // Reset the errno to ensure that we report the proper errno value.
     errno = savedErrno;
@@ -1196,51 +1374,8 @@ void fa_log_Send
     // it.  If there was a truncation then that'll just show up in the logs.
     vsnprintf(msg, sizeof(msg), formatPtr, args);
 
-    // If running on an embedded target, write the message out to the log.
-#ifdef LEGATO_EMBEDDED
-
-    if (functionNamePtr == NULL)
-    {
-        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %d | %s\n",
-           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
-           lineNumber, msg);
-    }
-    else
-    {
-        syslog(ConvertToSyslogLevel(level), "%s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
-           levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr, baseFileNamePtr,
-           functionNamePtr, lineNumber, msg);
-    }
-
-    // If running on a PC, write the message to standard error with a timestamp added.
-#else
-
-    time_t now;
-    char timeStamp[26] = "";
-    char* timeStampPtr = timeStamp;
-
-    if ( (time(&now) != ((time_t)-1)) && (ctime_r(&now, timeStamp) != NULL) )
-    {
-        // Tue Jan 14 18:01:56 2014
-        // 0123456789012345678901234
-        timeStampPtr = timeStamp + 4; // Skip day of week.
-        timeStamp[19] = '\0';  // Exclude the year.
-    }
-
-    if (functionNamePtr == NULL)
-    {
-        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %d | %s\n",
-                timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr,
-                threadNamePtr, baseFileNamePtr, lineNumber, msg);
-    }
-    else
-    {
-        fprintf(stderr, "%s : %s | %s[%d]/%s T=%s | %s %s() %d | %s\n",
-            timeStampPtr, levelPtr, procNamePtr, getpid(), compNamePtr, threadNamePtr,
-            baseFileNamePtr, functionNamePtr, lineNumber, msg);
-    }
-
-#endif
+    log_WriteMsg(level, levelPtr, compNamePtr, le_thread_GetMyName(), baseFileNamePtr,
+                 functionNamePtr, lineNumber, NULL, msg);
 }
 
 
@@ -35,6 +35,13 @@
 #ifndef LINUX_LOGPLATFORM_INCLUDE_GUARD
 #define LINUX_LOGPLATFORM_INCLUDE_GUARD
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of log messages.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_MAX_MSG_SIZE        256
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Re-Initialize the logging system.
@@ -59,4 +66,23 @@ void log_LogGenericMsg
     const char* msgPtr          ///< [IN] Message.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a formatted log message out to the log.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_WriteMsg
+(
+    le_log_Level_t          level,              ///< [IN] Severity level, or -1 for a trace.
+    const char             *levelPtr,           ///< [IN] Severity string or trace keyword.
+    const char             *compNamePtr,        ///< [IN] Component name.
+    const char             *threadNamePtr,      ///< [IN] Thread name.
+    const char             *baseFileNamePtr,    ///< [IN] Base name of the source file.
+    const char             *functionNamePtr,    ///< [IN] Function name (may be NULL).
+    unsigned int            lineNumber,         ///< [IN] Line number.
+    const struct timespec  *timePtr,            ///< [IN] Time the message was logged, or NULL
+                                                ///       for now.
+    const char             *msgPtr              ///< [IN] User message.
+);
+
 #endif /* end LINUX_LOGPLATFORM_INCLUDE_GUARD */
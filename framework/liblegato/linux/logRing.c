@@ -0,0 +1,1176 @@
+/** @file logRing.c
+ *
+ * Deferred formatting ring for log messages.
+ *
+ * Formatting a log message and handing it to syslog costs far more than the rest of a logging
+ * call, and it is paid by the thread that logged.  With LE_CONFIG_LOG_DEFERRED enabled, the
+ * logging thread instead copies what is needed to format the message later into a binary record:
+ *
+ *  - the format string pointer, and the level and component name pointers (these all live for
+ *    the life of the process),
+ *  - the argument values, found by scanning the format string's conversion specifications.
+ *    Strings are copied into the record, because they may not outlive the call,
+ *  - the file and function names, copied as well: callers such as the Java bindings pass buffers
+ *    that are released as soon as the call returns,
+ *  - the time, the thread name and errno.
+ *
+ * Records are written into a process-wide ring.  Writers reserve space by moving the ring's head
+ * forward with a compare-and-swap, fill in their record and then mark it ready, so no lock is
+ * taken on the logging path.  A flusher thread, started the first time something is logged, takes
+ * records off the tail of the ring in order, formats them exactly as vsnprintf() would have done
+ * and writes them out with the time at which they were logged.
+ *
+ * A message is written immediately, as it was without the ring, when:
+ *  - the ring is full,
+ *  - its format string uses something that can't be captured (positional arguments, %n, wide
+ *    strings), or its string arguments or file and function names don't fit in a record,
+ *  - it is critical or an emergency.  The ring is flushed first, so these are never written
+ *    ahead of the messages that led up to them.
+ *
+ * The ring is flushed at process exit.  Child processes created with fork() don't inherit the
+ * flusher thread, so they go back to writing every message immediately.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#include "limit.h"
+#include "log.h"
+#include "logPlatform.h"
+#include "logRing.h"
+
+#if LE_CONFIG_LOG_DEFERRED
+
+#include <semaphore.h>
+#include <sys/mman.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the ring, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RING_SIZE           ((uint32_t)LE_CONFIG_LOG_DEFERRED_RING_SIZE)
+
+#if (LE_CONFIG_LOG_DEFERRED_RING_SIZE & (LE_CONFIG_LOG_DEFERRED_RING_SIZE - 1)) != 0
+#   error "LE_CONFIG_LOG_DEFERRED_RING_SIZE must be a power of two"
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of captured arguments in one record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_ARGS_SIZE       512
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a single conversion specification (e.g., "%-08.3lld"), including the '\0'.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_SPEC_BYTES      32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Captured arguments are stored in slots that are a multiple of this size.  Records are aligned
+ * to it as well.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SLOT_SIZE           8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Captured string length that stands for a NULL string pointer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NULL_STR_LEN        UINT16_MAX
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of the file and function names copied into a record.  Messages with longer
+ * names are written immediately.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_NAME_LEN        255
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of times the flusher yields waiting for a reserved record to be filled in, before giving
+ * up on it for now.  The writer may never finish (e.g., it is the thread that is exiting from a
+ * signal handler, or it was killed).
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_FLUSH_YIELDS    1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Once woken, the flusher drains the ring every this many milliseconds until it finds it empty.
+ * Messages logged in a burst are thus written in batches, without waking the flusher for each.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FLUSH_INTERVAL_MS   10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rounds a size up to a whole number of slots.
+ */
+//--------------------------------------------------------------------------------------------------
+#define ROUND_TO_SLOT(size) (((size) + SLOT_SIZE - 1) & ~((size_t)SLOT_SIZE - 1))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record states.  A record's memory is zeroed once it has been consumed, so space that has been
+ * reserved but not yet filled in always reads as RECORD_PENDING.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_PENDING      0   ///< Reserved, being filled in.
+#define RECORD_READY        1   ///< Holds a message.
+#define RECORD_PAD          2   ///< Padding up to the end of the ring.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Type of the value a conversion specification takes from the argument list.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    ARG_NONE,           ///< "%%".
+    ARG_ERRNO,          ///< "%m".
+    ARG_INT,            ///< int and shorter integers, and characters.
+    ARG_LONG,           ///< long.
+    ARG_LLONG,          ///< long long.
+    ARG_INTMAX,         ///< intmax_t.
+    ARG_SIZE,           ///< size_t.
+    ARG_PTRDIFF,        ///< ptrdiff_t.
+    ARG_DOUBLE,         ///< double (and float).
+    ARG_LDOUBLE,        ///< long double.
+    ARG_PTR,            ///< void*.
+    ARG_STR,            ///< Narrow character string.
+    ARG_UNSUPPORTED     ///< Can't be captured.
+}
+ArgType_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parsed conversion specification.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ArgType_t type;         ///< Type of the argument.
+    size_t    len;          ///< Length of the specification in the format string.
+    int       numStars;     ///< Number of '*' (int) arguments taken before the value.
+    bool      starPrecision;///< true if the precision is the last '*' argument.
+    int       precision;    ///< Precision, if given in the format string.  -1 if not.
+}
+Spec_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record header.  The captured arguments follow it.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t        size;               ///< Size of the record, including the header.
+    uint32_t        state;              ///< RECORD_xxx.  Written last.
+    le_log_Level_t  level;              ///< Severity level, or -1 for a trace.
+    unsigned int    lineNumber;         ///< Line number.
+    int             savedErrno;         ///< errno at the time of the call.
+    const char     *levelPtr;           ///< Severity string or trace keyword.
+    const char     *compNamePtr;        ///< Component name.
+    const char     *filenamePtr;        ///< Base name of the source file, copied in the record.
+    const char     *functionNamePtr;    ///< Function name, copied in the record (may be NULL).
+    const char     *formatPtr;          ///< Format string.
+    struct timespec timestamp;          ///< Time the message was logged.
+    char            threadName[LIMIT_MAX_THREAD_NAME_BYTES];    ///< Logging thread's name.
+    uint8_t         args[] __attribute__((aligned(SLOT_SIZE))); ///< Captured arguments.
+}
+Record_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The ring.  Mapped the first time something is logged.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t *RingPtr;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Free-running count of bytes reserved in the ring by writers.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RingHead;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Free-running count of bytes consumed from the ring.  Only changed with FlushMutex held.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RingTail;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serializes consumers of the ring (the flusher thread and explicit flushes).
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t FlushMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set by the flusher thread before it waits on FlusherSem, and cleared by the first writer to see
+ * it set, which then posts the semaphore.  Both sides use full-barrier compare-and-swap, so either
+ * the flusher sees a new record or a writer sees the flag.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t FlusherWaiting;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Semaphore the flusher thread waits on when the ring is empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static sem_t FlusherSem;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set if the ring can't be used (it couldn't be started, or this is a forked child).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RingUnavailable;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ensures the ring is started only once.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_once_t StartOnce = PTHREAD_ONCE_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parses the conversion specification at the start of a string.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ParseSpec
+(
+    const char *specPtr,    ///< [IN] Specification, starting with '%'.
+    Spec_t     *outPtr      ///< [OUT] Parsed specification.
+)
+{
+    const char *charPtr = specPtr + 1;
+    int numLongs = 0;
+    char lengthMod = '\0';
+
+    outPtr->type = ARG_UNSUPPORTED;
+    outPtr->len = 0;
+    outPtr->numStars = 0;
+    outPtr->starPrecision = false;
+    outPtr->precision = -1;
+
+    if (*charPtr == '%')
+    {
+        outPtr->type = ARG_NONE;
+        outPtr->len = 2;
+        return;
+    }
+
+    // Flags.
+    while ((*charPtr != '\0') && (strchr("-+ #0'I", *charPtr) != NULL))
+    {
+        charPtr++;
+    }
+
+    // Width.  A '$' here means positional arguments, which can't be captured in one pass.
+    if (*charPtr == '*')
+    {
+        outPtr->numStars++;
+        charPtr++;
+    }
+    while (isdigit((unsigned char)*charPtr))
+    {
+        charPtr++;
+    }
+    if (*charPtr == '$')
+    {
+        return;
+    }
+
+    // Precision.
+    if (*charPtr == '.')
+    {
+        charPtr++;
+        if (*charPtr == '*')
+        {
+            outPtr->numStars++;
+            outPtr->starPrecision = true;
+            charPtr++;
+        }
+        else
+        {
+            outPtr->precision = 0;
+            while (isdigit((unsigned char)*charPtr))
+            {
+                outPtr->precision = (outPtr->precision * 10) + (*charPtr - '0');
+                charPtr++;
+            }
+        }
+    }
+
+    // Length modifier.
+    switch (*charPtr)
+    {
+        case 'h':
+            charPtr++;
+            if (*charPtr == 'h')
+            {
+                charPtr++;
+            }
+            break;
+
+        case 'l':
+            numLongs++;
+            charPtr++;
+            if (*charPtr == 'l')
+            {
+                numLongs++;
+                charPtr++;
+            }
+            break;
+
+        case 'q':
+        case 'L':
+        case 'j':
+        case 'z':
+        case 'Z':
+        case 't':
+            lengthMod = *charPtr;
+            charPtr++;
+            break;
+
+        default:
+            break;
+    }
+
+    // Conversion.
+    switch (*charPtr)
+    {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            switch (lengthMod)
+            {
+                case 'q':
+                case 'L':
+                    outPtr->type = ARG_LLONG;
+                    break;
+                case 'j':
+                    outPtr->type = ARG_INTMAX;
+                    break;
+                case 'z':
+                case 'Z':
+                    outPtr->type = ARG_SIZE;
+                    break;
+                case 't':
+                    outPtr->type = ARG_PTRDIFF;
+                    break;
+                default:
+                    outPtr->type = (numLongs == 0 ? ARG_INT :
+                                    numLongs == 1 ? ARG_LONG : ARG_LLONG);
+                    break;
+            }
+            break;
+
+        case 'c':
+            // A wint_t is passed as an unsigned int.
+            if ((lengthMod == '\0') && (numLongs <= 1))
+            {
+                outPtr->type = ARG_INT;
+            }
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            outPtr->type = (lengthMod == 'L' ? ARG_LDOUBLE : ARG_DOUBLE);
+            break;
+
+        case 's':
+            if ((lengthMod == '\0') && (numLongs == 0))
+            {
+                outPtr->type = ARG_STR;
+            }
+            break;
+
+        case 'p':
+            outPtr->type = ARG_PTR;
+            break;
+
+        case 'm':
+            if (outPtr->numStars == 0)
+            {
+                outPtr->type = ARG_ERRNO;
+            }
+            break;
+
+        default:
+            // Includes %n, which must never be deferred, and the end of the string.
+            return;
+    }
+
+    charPtr++;
+    outPtr->len = charPtr - specPtr;
+    if (outPtr->len >= MAX_SPEC_BYTES)
+    {
+        outPtr->type = ARG_UNSUPPORTED;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a value to the captured arguments, in a whole number of slots.
+ *
+ * @return true if it fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PutArg
+(
+    uint8_t    *bufPtr,     ///< [IN] Captured arguments.
+    size_t     *usedPtr,    ///< [INOUT] Bytes of bufPtr used.
+    const void *valuePtr,   ///< [IN] Value.
+    size_t      size        ///< [IN] Size of the value.
+)
+{
+    if (*usedPtr + ROUND_TO_SLOT(size) > MAX_ARGS_SIZE)
+    {
+        return false;
+    }
+
+    memcpy(bufPtr + *usedPtr, valuePtr, size);
+    *usedPtr += ROUND_TO_SLOT(size);
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a string to the captured arguments as a 16-bit length followed by the characters and a
+ * terminating '\0'.  No more than the precision, nor more than fits in a log message, is copied,
+ * since no more could be printed.
+ *
+ * @return true if it fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PutStr
+(
+    uint8_t    *bufPtr,     ///< [IN] Captured arguments.
+    size_t     *usedPtr,    ///< [INOUT] Bytes of bufPtr used.
+    const char *strPtr,     ///< [IN] String (may be NULL).
+    int         precision   ///< [IN] Precision, or negative if none.
+)
+{
+    size_t maxLen = LOG_MAX_MSG_SIZE - 1;
+    uint16_t len = NULL_STR_LEN;
+    size_t size;
+
+    if (strPtr != NULL)
+    {
+        if ((precision >= 0) && ((size_t)precision < maxLen))
+        {
+            maxLen = precision;
+        }
+        len = strnlen(strPtr, maxLen);
+    }
+
+    size = sizeof(len) + (strPtr != NULL ? len + 1 : 0);
+    if (*usedPtr + ROUND_TO_SLOT(size) > MAX_ARGS_SIZE)
+    {
+        return false;
+    }
+
+    memcpy(bufPtr + *usedPtr, &len, sizeof(len));
+    if (strPtr != NULL)
+    {
+        memcpy(bufPtr + *usedPtr + sizeof(len), strPtr, len);
+        bufPtr[*usedPtr + sizeof(len) + len] = '\0';
+    }
+    *usedPtr += ROUND_TO_SLOT(size);
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies the arguments of a format string into a buffer.
+ *
+ * @return
+ *      - true if all the arguments were captured.
+ *      - false if the format can't be captured or the arguments don't fit.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CaptureArgs
+(
+    const char *formatPtr,  ///< [IN] Format string.
+    va_list     args,       ///< [IN] Arguments.
+    uint8_t    *bufPtr,     ///< [OUT] Captured arguments (MAX_ARGS_SIZE bytes).
+    size_t     *usedPtr     ///< [OUT] Bytes of bufPtr used.
+)
+{
+    const char *charPtr = formatPtr;
+    Spec_t spec;
+    bool fits = true;
+
+    *usedPtr = 0;
+
+    while (fits && ((charPtr = strchr(charPtr, '%')) != NULL))
+    {
+        int stars[2] = { 0, 0 };
+        int i;
+
+        ParseSpec(charPtr, &spec);
+        if (spec.type == ARG_UNSUPPORTED)
+        {
+            return false;
+        }
+
+        for (i = 0; i < spec.numStars; i++)
+        {
+            stars[i] = va_arg(args, int);
+            fits = fits && PutArg(bufPtr, usedPtr, &stars[i], sizeof(int));
+        }
+
+        switch (spec.type)
+        {
+            case ARG_INT:
+            {
+                int value = va_arg(args, int);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_LONG:
+            {
+                long value = va_arg(args, long);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_LLONG:
+            {
+                long long value = va_arg(args, long long);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_INTMAX:
+            {
+                intmax_t value = va_arg(args, intmax_t);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_SIZE:
+            {
+                size_t value = va_arg(args, size_t);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_PTRDIFF:
+            {
+                ptrdiff_t value = va_arg(args, ptrdiff_t);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_DOUBLE:
+            {
+                double value = va_arg(args, double);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_LDOUBLE:
+            {
+                long double value = va_arg(args, long double);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_PTR:
+            {
+                void *value = va_arg(args, void *);
+                fits = fits && PutArg(bufPtr, usedPtr, &value, sizeof(value));
+                break;
+            }
+            case ARG_STR:
+            {
+                const char *value = va_arg(args, const char *);
+                int precision = (spec.starPrecision ? stars[spec.numStars - 1] : spec.precision);
+                fits = fits && PutStr(bufPtr, usedPtr, value, precision);
+                break;
+            }
+            default:
+                break;
+        }
+
+        charPtr += spec.len;
+    }
+
+    return fits;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Formats one conversion specification with its value, passing the '*' arguments first.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FORMAT_ARG(outPtr, outSize, specStr, stars, numStars, value)                  \
+    ((numStars) == 0 ? snprintf((outPtr), (outSize), (specStr), (value)) :            \
+     (numStars) == 1 ? snprintf((outPtr), (outSize), (specStr), (stars)[0], (value)) : \
+                       snprintf((outPtr), (outSize), (specStr), (stars)[0], (stars)[1], (value)))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Formats the value of a conversion specification whose argument is of a given type.  Used in
+ * FormatRecord()'s switch.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FORMAT_CASE(argType, type)                                                      \
+            case argType:                                                               \
+            {                                                                           \
+                type value;                                                             \
+                argPtr = GetArg(argPtr, &value, sizeof(value));                         \
+                len = FORMAT_ARG(outPtr, outSize, specStr, stars, spec.numStars, value);\
+                break;                                                                  \
+            }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads a value from the captured arguments.
+ *
+ * @return Pointer to the next captured argument.
+ */
+//--------------------------------------------------------------------------------------------------
+static const uint8_t *GetArg
+(
+    const uint8_t *argPtr,  ///< [IN] Captured argument.
+    void          *valuePtr,///< [OUT] Value.
+    size_t         size     ///< [IN] Size of the value.
+)
+{
+    memcpy(valuePtr, argPtr, size);
+    return argPtr + ROUND_TO_SLOT(size);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Formats a record's message from its format string and captured arguments.  The result is the
+ * same as vsnprintf() would have produced when the message was logged.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FormatRecord
+(
+    const Record_t *recPtr, ///< [IN] Record.
+    char           *msgPtr, ///< [OUT] Message buffer.
+    size_t          msgSize ///< [IN] Size of the message buffer.
+)
+{
+    const char *charPtr = recPtr->formatPtr;
+    const uint8_t *argPtr = recPtr->args;
+    size_t pos = 0;
+    Spec_t spec;
+
+    while ((*charPtr != '\0') && (pos < msgSize - 1))
+    {
+        char specStr[MAX_SPEC_BYTES];
+        int stars[2] = { 0, 0 };
+        int len = 0;
+        int i;
+
+        if (*charPtr != '%')
+        {
+            msgPtr[pos++] = *charPtr++;
+            continue;
+        }
+
+        ParseSpec(charPtr, &spec);
+        memcpy(specStr, charPtr, spec.len);
+        specStr[spec.len] = '\0';
+        charPtr += spec.len;
+
+        for (i = 0; i < spec.numStars; i++)
+        {
+            argPtr = GetArg(argPtr, &stars[i], sizeof(int));
+        }
+
+        char *outPtr = msgPtr + pos;
+        size_t outSize = msgSize - pos;
+
+        switch (spec.type)
+        {
+            case ARG_NONE:
+                len = snprintf(outPtr, outSize, "%%");
+                break;
+            case ARG_ERRNO:
+                // Flags and width are rarely used with %m, and are ignored.
+                errno = recPtr->savedErrno;
+                len = snprintf(outPtr, outSize, "%m");
+                break;
+            FORMAT_CASE(ARG_INT, int)
+            FORMAT_CASE(ARG_LONG, long)
+            FORMAT_CASE(ARG_LLONG, long long)
+            FORMAT_CASE(ARG_INTMAX, intmax_t)
+            FORMAT_CASE(ARG_SIZE, size_t)
+            FORMAT_CASE(ARG_PTRDIFF, ptrdiff_t)
+            FORMAT_CASE(ARG_DOUBLE, double)
+            FORMAT_CASE(ARG_LDOUBLE, long double)
+            FORMAT_CASE(ARG_PTR, void *)
+            case ARG_STR:
+            {
+                uint16_t strLen;
+                const char *strPtr = NULL;
+
+                memcpy(&strLen, argPtr, sizeof(strLen));
+                if (strLen != NULL_STR_LEN)
+                {
+                    strPtr = (const char *)argPtr + sizeof(strLen);
+                    argPtr += ROUND_TO_SLOT(sizeof(strLen) + strLen + 1);
+                }
+                else
+                {
+                    argPtr += ROUND_TO_SLOT(sizeof(strLen));
+                }
+                len = FORMAT_ARG(outPtr, outSize, specStr, stars, spec.numStars, strPtr);
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (len > 0)
+        {
+            pos = ((size_t)len >= outSize ? msgSize - 1 : pos + len);
+        }
+    }
+
+    msgPtr[pos] = '\0';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes records off the tail of the ring and writes them out, until the ring is empty or the
+ * record at its tail stays pending for too long.
+ *
+ * Must be called with FlushMutex held.
+ *
+ * @return true if any records were taken.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Drain
+(
+    void
+)
+{
+    bool drained = false;
+
+    uint32_t tail = RingTail;
+    int numYields = 0;
+
+    while (tail != LE_ATOMIC_LOAD(&RingHead, LE_ATOMIC_ORDER_ACQUIRE))
+    {
+        Record_t *recPtr = (Record_t *)(RingPtr + (tail & (RING_SIZE - 1)));
+        uint32_t state = LE_ATOMIC_LOAD(&recPtr->state, LE_ATOMIC_ORDER_ACQUIRE);
+
+        if (state == RECORD_PENDING)
+        {
+            // The writer has reserved the record but not finished filling it in.
+            if (++numYields > MAX_FLUSH_YIELDS)
+            {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        uint32_t size = recPtr->size;
+
+        if (state == RECORD_READY)
+        {
+            char msg[LOG_MAX_MSG_SIZE];
+
+            FormatRecord(recPtr, msg, sizeof(msg));
+            log_WriteMsg(recPtr->level, recPtr->levelPtr, recPtr->compNamePtr,
+                         recPtr->threadName, recPtr->filenamePtr, recPtr->functionNamePtr,
+                         recPtr->lineNumber, &recPtr->timestamp, msg);
+        }
+
+        // Zero the record so that its space reads as pending when it is reserved again.
+        memset(recPtr, 0, size);
+        tail += size;
+        LE_ATOMIC_STORE(&RingTail, tail, LE_ATOMIC_ORDER_RELEASE);
+        drained = true;
+    }
+
+    return drained;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flusher thread.  Drains the ring whenever records are added to it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *FlusherThread
+(
+    void *contextPtr    ///< [IN] Not used.
+)
+{
+    bool drained;
+
+    LE_UNUSED(contextPtr);
+
+    for (;;)
+    {
+        pthread_mutex_lock(&FlushMutex);
+        drained = Drain();
+        pthread_mutex_unlock(&FlushMutex);
+
+        // If records are left, the one at the tail is still being filled in: come back to it
+        // later rather than spin on it.
+        if (drained || (LE_ATOMIC_LOAD(&RingHead, LE_ATOMIC_ORDER_ACQUIRE) != RingTail))
+        {
+            // More are likely to follow, so let them gather.  Writers wake us early if the ring
+            // fills past half way.
+            struct timespec deadline;
+
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += FLUSH_INTERVAL_MS * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L)
+            {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            while ((sem_timedwait(&FlusherSem, &deadline) != 0) && (errno == EINTR))
+            {
+            }
+            continue;
+        }
+
+        // Announce that we are about to sleep, then check for records added meanwhile.  If there
+        // are any, take the announcement back; if a writer has already taken it, the semaphore
+        // has been (or is about to be) posted and the wait below returns straight away.
+        LE_SYNC_BOOL_COMPARE_AND_SWAP(&FlusherWaiting, 0, 1);
+        if ((LE_ATOMIC_LOAD(&RingHead, LE_ATOMIC_ORDER_ACQUIRE) != RingTail) &&
+            LE_SYNC_BOOL_COMPARE_AND_SWAP(&FlusherWaiting, 1, 0))
+        {
+            continue;
+        }
+
+        while ((sem_wait(&FlusherSem) != 0) && (errno == EINTR))
+        {
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flushes the ring when the process exits.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushAtExit
+(
+    void
+)
+{
+    if (!RingUnavailable)
+    {
+        pthread_mutex_lock(&FlushMutex);
+        Drain();
+        pthread_mutex_unlock(&FlushMutex);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stops a forked child process from using the ring, since the flusher thread isn't running in it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DisableInChild
+(
+    void
+)
+{
+    RingUnavailable = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps the ring and starts the flusher thread.  Marks the ring unavailable on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartRing
+(
+    void
+)
+{
+    pthread_t thread;
+    pthread_attr_t attr;
+    sigset_t allSignals;
+    sigset_t oldSignals;
+    void *ringPtr;
+    int result;
+
+    ringPtr = mmap(NULL, RING_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ringPtr == MAP_FAILED)
+    {
+        RingUnavailable = true;
+        return;
+    }
+    RingPtr = ringPtr;
+
+    if (sem_init(&FlusherSem, 0, 0) != 0)
+    {
+        munmap(ringPtr, RING_SIZE);
+        RingUnavailable = true;
+        return;
+    }
+
+    // Signals are handled by Legato threads; the flusher must not take any.
+    sigfillset(&allSignals);
+    pthread_sigmask(SIG_SETMASK, &allSignals, &oldSignals);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    result = pthread_create(&thread, &attr, FlusherThread, NULL);
+    pthread_attr_destroy(&attr);
+
+    pthread_sigmask(SIG_SETMASK, &oldSignals, NULL);
+
+    if (result != 0)
+    {
+        sem_destroy(&FlusherSem);
+        munmap(ringPtr, RING_SIZE);
+        RingUnavailable = true;
+        return;
+    }
+
+    pthread_setname_np(thread, "logFlusher");
+    pthread_atfork(NULL, NULL, DisableInChild);
+    atexit(FlushAtExit);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reserves space for a record at the head of the ring.  If the record doesn't fit before the end
+ * of the ring, the rest of the ring is reserved as well and marked as padding.
+ *
+ * @return The record, or NULL if the ring is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static Record_t *Reserve
+(
+    uint32_t size   ///< [IN] Size of the record.  A whole number of slots.
+)
+{
+    uint32_t head, tail, offset, padSize;
+
+    do
+    {
+        head = LE_ATOMIC_LOAD(&RingHead, LE_ATOMIC_ORDER_RELAXED);
+        tail = LE_ATOMIC_LOAD(&RingTail, LE_ATOMIC_ORDER_ACQUIRE);
+
+        offset = head & (RING_SIZE - 1);
+        padSize = (offset + size > RING_SIZE ? RING_SIZE - offset : 0);
+        if ((head - tail) + padSize + size > RING_SIZE)
+        {
+            return NULL;
+        }
+    }
+    while (!LE_SYNC_BOOL_COMPARE_AND_SWAP(&RingHead, head, head + padSize + size));
+
+    // Hurry the flusher along if this takes the ring past half full.
+    if (((head - tail) < (RING_SIZE / 2)) && ((head + padSize + size - tail) >= (RING_SIZE / 2)))
+    {
+        sem_post(&FlusherSem);
+    }
+
+    if (padSize != 0)
+    {
+        Record_t *padPtr = (Record_t *)(RingPtr + offset);
+
+        padPtr->size = padSize;
+        LE_ATOMIC_STORE(&padPtr->state, RECORD_PAD, LE_ATOMIC_ORDER_RELEASE);
+        offset = 0;
+    }
+
+    return (Record_t *)(RingPtr + offset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues a log message on the deferred formatting ring.
+ *
+ * @return
+ *      - true if the message was queued.
+ *      - false if the caller must write the message itself.  args has then not been touched.
+ */
+//--------------------------------------------------------------------------------------------------
+bool logRing_Send
+(
+    le_log_Level_t   level,             ///< [IN] Severity level, or -1 for a trace.
+    const char      *levelPtr,          ///< [IN] Severity string or trace keyword.
+    const char      *compNamePtr,       ///< [IN] Component name.
+    const char      *filenamePtr,       ///< [IN] Base name of the source file.
+    const char      *functionNamePtr,   ///< [IN] Function name (may be NULL).
+    unsigned int     lineNumber,        ///< [IN] Line number.
+    int              savedErrno,        ///< [IN] errno at the time of the call (for %m).
+    const char      *formatPtr,         ///< [IN] printf-style format string.
+    va_list          args               ///< [IN] Format arguments.
+)
+{
+    uint8_t argBuf[MAX_ARGS_SIZE] __attribute__((aligned(SLOT_SIZE)));
+    size_t argSize;
+    va_list argsCopy;
+    bool captured;
+
+    pthread_once(&StartOnce, StartRing);
+    if (RingUnavailable)
+    {
+        return false;
+    }
+
+    if ((level == LE_LOG_CRIT) || (level == LE_LOG_EMERG))
+    {
+        // Written immediately, after everything that came before it.
+        logRing_Flush();
+        return false;
+    }
+
+    va_copy(argsCopy, args);
+    captured = CaptureArgs(formatPtr, argsCopy, argBuf, &argSize);
+    va_end(argsCopy);
+    if (!captured)
+    {
+        return false;
+    }
+
+    size_t filenameLen = (filenamePtr != NULL ? strnlen(filenamePtr, MAX_NAME_LEN + 1) : 0);
+    size_t functionNameLen = (functionNamePtr != NULL ?
+                              strnlen(functionNamePtr, MAX_NAME_LEN + 1) : 0);
+    if ((filenameLen > MAX_NAME_LEN) || (functionNameLen > MAX_NAME_LEN))
+    {
+        return false;
+    }
+
+    // The names follow the captured arguments.
+    uint32_t size = ROUND_TO_SLOT(sizeof(Record_t) + argSize + filenameLen + 1 +
+                                  functionNameLen + 1);
+    Record_t *recPtr = Reserve(size);
+    if (recPtr == NULL)
+    {
+        return false;
+    }
+
+    char *namePtr = (char *)recPtr->args + argSize;
+
+    const char *threadNamePtr = le_thread_GetMyName();
+    size_t threadNameLen = strnlen(threadNamePtr, sizeof(recPtr->threadName) - 1);
+
+    recPtr->size = size;
+    recPtr->level = level;
+    recPtr->lineNumber = lineNumber;
+    recPtr->savedErrno = savedErrno;
+    recPtr->levelPtr = levelPtr;
+    recPtr->compNamePtr = compNamePtr;
+    recPtr->filenamePtr = NULL;
+    if (filenamePtr != NULL)
+    {
+        memcpy(namePtr, filenamePtr, filenameLen);
+        namePtr[filenameLen] = '\0';
+        recPtr->filenamePtr = namePtr;
+        namePtr += filenameLen + 1;
+    }
+    recPtr->functionNamePtr = NULL;
+    if (functionNamePtr != NULL)
+    {
+        memcpy(namePtr, functionNamePtr, functionNameLen);
+        namePtr[functionNameLen] = '\0';
+        recPtr->functionNamePtr = namePtr;
+    }
+    recPtr->formatPtr = formatPtr;
+    clock_gettime(CLOCK_REALTIME, &recPtr->timestamp);
+    memcpy(recPtr->threadName, threadNamePtr, threadNameLen);
+    recPtr->threadName[threadNameLen] = '\0';
+    memcpy(recPtr->args, argBuf, argSize);
+    LE_ATOMIC_STORE(&recPtr->state, RECORD_READY, LE_ATOMIC_ORDER_RELEASE);
+
+    // Wake the flusher if it is waiting.
+    if (LE_SYNC_BOOL_COMPARE_AND_SWAP(&FlusherWaiting, 1, 0))
+    {
+        sem_post(&FlusherSem);
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes out every message queued on the ring so far.
+ *
+ * If another thread keeps the ring locked for too long (e.g., this is a signal handler that
+ * interrupted a flush), this gives up rather than risk waiting forever.
+ */
+//--------------------------------------------------------------------------------------------------
+void logRing_Flush
+(
+    void
+)
+{
+    int numYields = 0;
+
+    if (RingUnavailable || (RingPtr == NULL))
+    {
+        return;
+    }
+
+    while (pthread_mutex_trylock(&FlushMutex) != 0)
+    {
+        if (++numYields > MAX_FLUSH_YIELDS)
+        {
+            return;
+        }
+        sched_yield();
+    }
+
+    Drain();
+    pthread_mutex_unlock(&FlushMutex);
+}
+
+#endif /* end LE_CONFIG_LOG_DEFERRED */
@@ -0,0 +1,58 @@
+/** @file logRing.h
+ *
+ * Linux-specific intra-framework interface to the log's deferred formatting ring.
+ *
+ * When deferred logging is enabled (LE_CONFIG_LOG_DEFERRED), fa_log_Send() does not format
+ * messages itself.  Instead, it copies the message's format string pointer, arguments, timestamp
+ * and thread name into a binary record in a per-process lock-free ring.  A background thread
+ * drains the ring, formats each record and writes it to the log.  If the ring is full, or the
+ * message is critical, or its format string can't be captured, the caller falls back to writing
+ * the message immediately.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LINUX_LOGRING_INCLUDE_GUARD
+#define LINUX_LOGRING_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queues a log message on the deferred formatting ring.
+ *
+ * @warning The format string and the file, function, level and component name strings must
+ *          outlive the call (they are string literals or framework-owned strings for all the
+ *          LE_ logging macros).  Arguments, including strings, are copied.
+ *
+ * @return
+ *      - true if the message was queued.
+ *      - false if the caller must write the message itself.  args has then not been touched.
+ */
+//--------------------------------------------------------------------------------------------------
+bool logRing_Send
+(
+    le_log_Level_t   level,             ///< [IN] Severity level, or -1 for a trace.
+    const char      *levelPtr,          ///< [IN] Severity string or trace keyword.
+    const char      *compNamePtr,       ///< [IN] Component name.
+    const char      *filenamePtr,       ///< [IN] Base name of the source file.
+    const char      *functionNamePtr,   ///< [IN] Function name (may be NULL).
+    unsigned int     lineNumber,        ///< [IN] Line number.
+    int              savedErrno,        ///< [IN] errno at the time of the call (for %m).
+    const char      *formatPtr,         ///< [IN] printf-style format string.
+    va_list          args               ///< [IN] Format arguments.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes out every message queued on the ring so far.  Used before writing a message
+ * immediately, so that the log stays in order, and at process exit.
+ */
+//--------------------------------------------------------------------------------------------------
+void logRing_Flush
+(
+    void
+);
+
+
+#endif /* end LINUX_LOGRING_INCLUDE_GUARD */
@@ -0,0 +1,674 @@
+/** @file messagingBulk.c
+ *
+ * @ref c_messaging implementation's "Bulk" module implementation.
+ *
+ * Each session can have one transmit ring per direction.  A transmit ring is a sealed memfd that
+ * the sending process creates the first time a bulk payload is allocated on the session.  Its file
+ * descriptor is passed to the other end once, using the normal SCM_RIGHTS path, and from then on
+ * bulk payloads are written straight into the ring and only a small descriptor travels over the
+ * socket.
+ *
+ * The ring is carved into chunks, each starting with a small header:
+ *
+ * @verbatim
+ *
+ *      tail                               head
+ *       |                                  |
+ *       v                                  v
+ *   ... [hdr|payload ...][hdr|payload ...] ............ [hdr (FREE wrap marker)]
+ *
+ * @endverbatim
+ *
+ * Only the producer (the process that created the ring) allocates chunks, and all allocation
+ * state (head, tail and byte count) is kept in the producer's private memory.  The consumer only
+ * ever writes the state word of a chunk header, to mark the chunk free when it is done with the
+ * payload.  The producer reclaims free chunks in order from the tail the next time it allocates.
+ *
+ * Because the other process can write to the ring at any time, everything read from shared
+ * memory (descriptors on the consumer side, chunk sizes on the producer side) is checked before
+ * it is used.  A producer that finds a corrupt chunk header stops using the ring.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "messagingBulk.h"
+#include "fileDescriptor.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifndef MFD_CLOEXEC
+#   define MFD_CLOEXEC          0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#   define MFD_ALLOW_SEALING    0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#   define F_ADD_SEALS          1033
+#   define F_GET_SEALS          1034
+#   define F_SEAL_SEAL          0x0001
+#   define F_SEAL_SHRINK        0x0002
+#   define F_SEAL_GROW          0x0004
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Chunk states.  Values are chosen so that a zeroed or partly written header is never mistaken
+ * for a free chunk.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_BUSY  0x42555359U
+#define CHUNK_FREE  0x46524545U
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Chunk header, at the start of every chunk in the ring.  Chunk sizes are a multiple of the
+ * header size, so headers are always naturally aligned.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t size;      ///< Size of the chunk, including this header.
+    uint32_t state;     ///< CHUNK_BUSY or CHUNK_FREE.
+}
+ChunkHeader_t;
+
+#define CHUNK_ALIGN     sizeof(ChunkHeader_t)
+#define CHUNK_SIZE(n)   (((n) + sizeof(ChunkHeader_t) + CHUNK_ALIGN - 1) & ~(CHUNK_ALIGN - 1))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ring object.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct msgBulk_Ring
+{
+    uint8_t*        basePtr;        ///< Start of the mapping.
+    uint32_t        size;           ///< Size of the mapping, in bytes.
+    int             fd;             ///< memfd backing the mapping.
+    bool            isTx;           ///< true = this process is the producer.
+    bool            isAnnounced;    ///< true = sent to the other end of the session.
+    bool            isBroken;       ///< true = found corrupted; no more allocations.
+    pthread_mutex_t mutex;          ///< Protects the allocation state (producer only).
+    uint32_t        head;           ///< Offset of the next chunk to allocate.
+    uint32_t        tail;           ///< Offset of the oldest chunk still in use.
+    uint32_t        used;           ///< Bytes between tail and head, including wrap markers.
+}
+Ring_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which Ring objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t RingPoolRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set when memfd_create() or file sealing turned out not to be supported, so that we don't try
+ * again for every session.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsUnsupported = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Destructor function for Ring objects.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RingDestructor
+(
+    void* objPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Ring_t* ringPtr = objPtr;
+
+    munmap(ringPtr->basePtr, ringPtr->size);
+    fd_Close(ringPtr->fd);
+    pthread_mutex_destroy(&ringPtr->mutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a Ring object for a mapped memfd.
+ *
+ * @return The new Ring object.
+ */
+//--------------------------------------------------------------------------------------------------
+static Ring_t* CreateRing
+(
+    int         fd,
+    void*       basePtr,
+    uint32_t    size,
+    bool        isTx
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Ring_t* ringPtr = le_mem_ForceAlloc(RingPoolRef);
+
+    ringPtr->basePtr = basePtr;
+    ringPtr->size = size;
+    ringPtr->fd = fd;
+    ringPtr->isTx = isTx;
+    ringPtr->isAnnounced = false;
+    ringPtr->isBroken = false;
+    pthread_mutex_init(&ringPtr->mutex, NULL);
+    ringPtr->head = 0;
+    ringPtr->tail = 0;
+    ringPtr->used = 0;
+
+    return ringPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a pointer to the header of the chunk at a given offset.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline ChunkHeader_t* ChunkAt
+(
+    Ring_t*     ringPtr,
+    uint32_t    offset
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (ChunkHeader_t*)(ringPtr->basePtr + offset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves the tail past any chunks that the consumer has freed.
+ *
+ * @note Must be called with the ring's mutex held.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Reclaim
+(
+    Ring_t* ringPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (ringPtr->used > 0)
+    {
+        ChunkHeader_t* hdrPtr = ChunkAt(ringPtr, ringPtr->tail);
+
+        if (__atomic_load_n(&hdrPtr->state, __ATOMIC_ACQUIRE) != CHUNK_FREE)
+        {
+            return;
+        }
+
+        uint32_t chunkSize = hdrPtr->size;
+
+        if (   (chunkSize < sizeof(ChunkHeader_t))
+            || ((chunkSize % CHUNK_ALIGN) != 0)
+            || (chunkSize > ringPtr->size - ringPtr->tail)
+            || (chunkSize > ringPtr->used) )
+        {
+            LE_ERROR("Corrupt bulk ring chunk at offset %" PRIu32 " (size %" PRIu32 ").",
+                     ringPtr->tail,
+                     chunkSize);
+            ringPtr->isBroken = true;
+            return;
+        }
+
+        ringPtr->used -= chunkSize;
+        ringPtr->tail += chunkSize;
+        if (ringPtr->tail == ringPtr->size)
+        {
+            ringPtr->tail = 0;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reserves a chunk of a given size.
+ *
+ * @return true if successful, false if there isn't enough contiguous free space.
+ *
+ * @note Must be called with the ring's mutex held.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Reserve
+(
+    Ring_t*     ringPtr,
+    uint32_t    chunkSize,
+    uint32_t*   offsetPtr       ///< [OUT] Offset of the reserved chunk.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (ringPtr->used == 0)
+    {
+        ringPtr->head = 0;
+        ringPtr->tail = 0;
+    }
+    else if (ringPtr->head == ringPtr->tail)
+    {
+        return false;
+    }
+
+    if ((ringPtr->head > ringPtr->tail) || (ringPtr->used == 0))
+    {
+        // Free space is from the head to the end of the ring, then from the start to the tail.
+        uint32_t spaceToEnd = ringPtr->size - ringPtr->head;
+
+        if (chunkSize > spaceToEnd)
+        {
+            if (chunkSize > ringPtr->tail)
+            {
+                return false;
+            }
+
+            // Skip the rest of the ring with a free chunk, so that the tail steps over it.
+            ChunkHeader_t* markerPtr = ChunkAt(ringPtr, ringPtr->head);
+            markerPtr->size = spaceToEnd;
+            markerPtr->state = CHUNK_FREE;
+            ringPtr->used += spaceToEnd;
+            ringPtr->head = 0;
+        }
+    }
+    else if (chunkSize > ringPtr->tail - ringPtr->head)
+    {
+        return false;
+    }
+
+    *offsetPtr = ringPtr->head;
+
+    ringPtr->used += chunkSize;
+    ringPtr->head += chunkSize;
+    if (ringPtr->head == ringPtr->size)
+    {
+        ringPtr->head = 0;
+    }
+
+    return true;
+}
+
+
+// =======================================
+//  PROTECTED (INTER-MODULE) FUNCTIONS
+// =======================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes this module.  This must be called only once at start-up, before any other functions
+ * in this module are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RingPoolRef = le_mem_CreatePool("MsgBulkRing", sizeof(Ring_t));
+    le_mem_SetDestructor(RingPoolRef, RingDestructor);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a new ring to send bulk payloads from.
+ *
+ * @return A reference to the ring, or NULL if bulk payloads are disabled or not supported.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgBulk_CreateTxRing
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t size = LE_CONFIG_MSG_BULK_RING_SIZE & ~(CHUNK_ALIGN - 1);
+
+    if ((size == 0) || IsUnsupported)
+    {
+        return NULL;
+    }
+
+#ifdef SYS_memfd_create
+    int fd = syscall(SYS_memfd_create, "le_msg_bulk", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    int fd = -1;
+    errno = ENOSYS;
+#endif
+    if (fd < 0)
+    {
+        LE_WARN("Bulk IPC payloads not available: memfd_create failed (%m).");
+        IsUnsupported = true;
+        return NULL;
+    }
+
+    // Seal the size so that the receiver can map the ring without worrying that we will shrink
+    // it underneath them (which would make their accesses fault).
+    if (ftruncate(fd, size) != 0)
+    {
+        LE_ERROR("Failed to size bulk ring (%m).");
+        fd_Close(fd);
+        return NULL;
+    }
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+    {
+        LE_WARN("Bulk IPC payloads not available: memfd sealing failed (%m).");
+        IsUnsupported = true;
+        fd_Close(fd);
+        return NULL;
+    }
+
+    void* basePtr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (basePtr == MAP_FAILED)
+    {
+        LE_ERROR("Failed to map bulk ring (%m).");
+        fd_Close(fd);
+        return NULL;
+    }
+
+    return CreateRing(fd, basePtr, size, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a ring that was announced by the other end of a session.  Takes ownership of the file
+ * descriptor (it is closed on failure).
+ *
+ * @return A reference to the ring, or NULL if the ring was rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgBulk_MapRxRing
+(
+    int         fd,         ///< [IN] File descriptor received with the announcement.
+    uint32_t    size        ///< [IN] Ring size given in the announcement.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat st;
+
+    if (fd < 0)
+    {
+        LE_ERROR("Bulk ring announced without a file descriptor.");
+        return NULL;
+    }
+
+    // Only accept a ring that can't be shrunk, and that is exactly the announced size.
+    int seals = fcntl(fd, F_GET_SEALS);
+    if ((seals < 0) || ((seals & F_SEAL_SHRINK) == 0))
+    {
+        LE_ERROR("Rejecting unsealed bulk ring.");
+        fd_Close(fd);
+        return NULL;
+    }
+    if (   (fstat(fd, &st) != 0)
+        || (st.st_size != (off_t)size)
+        || (size < CHUNK_SIZE(0))
+        || ((size % CHUNK_ALIGN) != 0) )
+    {
+        LE_ERROR("Rejecting bulk ring of unexpected size (%" PRIu32 ").", size);
+        fd_Close(fd);
+        return NULL;
+    }
+
+    void* basePtr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (basePtr == MAP_FAILED)
+    {
+        LE_ERROR("Failed to map bulk ring (%m).");
+        fd_Close(fd);
+        return NULL;
+    }
+
+    return CreateRing(fd, basePtr, size, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the file descriptor and size of a ring, for announcing it to the other end of a session.
+ *
+ * @return A duplicate of the ring's file descriptor (owned by the caller), or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int msgBulk_GetRingFd
+(
+    msgBulk_RingRef_t   ringRef,    ///< [IN] Ring.
+    uint32_t*           sizePtr     ///< [OUT] Ring size.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int fd = fcntl(ringRef->fd, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to duplicate bulk ring fd (%m).");
+    }
+
+    *sizePtr = ringRef->size;
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a ring has been announced to the other end of the session.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgBulk_IsAnnounced
+(
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return ringRef->isAnnounced;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that a ring has been announced to the other end of the session.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_SetAnnounced
+(
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ringRef->isAnnounced = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the largest bulk payload that can be allocated from a ring.
+ *
+ * Payloads are limited to half of the ring so that a new payload always fits once the consumer
+ * has caught up, no matter where the head happens to be.
+ *
+ * @return The size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t msgBulk_GetMaxPayloadSize
+(
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return ((ringRef->size / 2) & ~(CHUNK_ALIGN - 1)) - sizeof(ChunkHeader_t);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a bulk payload from a transmit ring.  On success, the payload holds a reference to
+ * the ring.
+ *
+ * @return Pointer to the payload buffer, or NULL if the ring doesn't have enough free space.
+ */
+//--------------------------------------------------------------------------------------------------
+void* msgBulk_Alloc
+(
+    msgBulk_RingRef_t   ringRef,    ///< [IN] Ring.
+    size_t              size,       ///< [IN] Payload size, in bytes.
+    msgBulk_Payload_t*  payloadPtr  ///< [OUT] Payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(ringRef->isTx);
+
+    if ((size == 0) || (size > msgBulk_GetMaxPayloadSize(ringRef)))
+    {
+        return NULL;
+    }
+
+    uint32_t chunkSize = CHUNK_SIZE(size);
+    uint32_t offset;
+    bool isReserved = false;
+
+    LE_ASSERT(pthread_mutex_lock(&ringRef->mutex) == 0);
+
+    if (!ringRef->isBroken)
+    {
+        Reclaim(ringRef);
+        isReserved = (!ringRef->isBroken) && Reserve(ringRef, chunkSize, &offset);
+    }
+
+    if (isReserved)
+    {
+        // Mark the chunk busy before anyone else can reclaim from the tail.
+        ChunkHeader_t* hdrPtr = ChunkAt(ringRef, offset);
+        hdrPtr->size = chunkSize;
+        hdrPtr->state = CHUNK_BUSY;
+    }
+
+    LE_ASSERT(pthread_mutex_unlock(&ringRef->mutex) == 0);
+
+    if (!isReserved)
+    {
+        return NULL;
+    }
+
+    le_mem_AddRef(ringRef);
+    payloadPtr->ringRef = ringRef;
+    payloadPtr->offset = offset;
+    payloadPtr->size = size;
+
+    return ChunkAt(ringRef, offset) + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up a bulk payload described by a message received from the other end of a session.  The
+ * descriptor comes from another process, so it is checked against the bounds of the ring.  On
+ * success, the payload holds a reference to the ring.
+ *
+ * @return Pointer to the payload, or NULL if the descriptor is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+const void* msgBulk_Lookup
+(
+    msgBulk_RingRef_t           ringRef,    ///< [IN] Ring announced by the sender.
+    const msgBulk_Descriptor_t* descPtr,    ///< [IN] Received descriptor.
+    msgBulk_Payload_t*          payloadPtr  ///< [OUT] Payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(!ringRef->isTx);
+
+    // Compare against sizes rather than adding to the offset, so nothing can wrap around.
+    if (   ((descPtr->offset % CHUNK_ALIGN) != 0)
+        || (descPtr->offset >= ringRef->size)
+        || (descPtr->size == 0)
+        || (descPtr->size > ringRef->size - descPtr->offset - sizeof(ChunkHeader_t)) )
+    {
+        LE_ERROR("Invalid bulk descriptor (offset %" PRIu32 ", size %" PRIu32 ").",
+                 descPtr->offset,
+                 descPtr->size);
+        return NULL;
+    }
+
+    le_mem_AddRef(ringRef);
+    payloadPtr->ringRef = ringRef;
+    payloadPtr->offset = descPtr->offset;
+    payloadPtr->size = descPtr->size;
+
+    return ChunkAt(ringRef, descPtr->offset) + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a pointer to a bulk payload.
+ *
+ * @return The pointer, or NULL if there is no payload.
+ */
+//--------------------------------------------------------------------------------------------------
+void* msgBulk_GetPtr
+(
+    const msgBulk_Payload_t* payloadPtr   ///< [IN] Payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (payloadPtr->ringRef == NULL)
+    {
+        return NULL;
+    }
+
+    return ChunkAt(payloadPtr->ringRef, payloadPtr->offset) + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hands a bulk payload back to the ring's producer, then releases the payload's reference to the
+ * ring.  Does nothing if there is no payload.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_Free
+(
+    msgBulk_Payload_t*  payloadPtr  ///< [IN,OUT] Payload (cleared on return).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (payloadPtr->ringRef == NULL)
+    {
+        return;
+    }
+
+    // The producer picks this up the next time it allocates from the ring.
+    ChunkHeader_t* hdrPtr = ChunkAt(payloadPtr->ringRef, payloadPtr->offset);
+    __atomic_store_n(&hdrPtr->state, CHUNK_FREE, __ATOMIC_RELEASE);
+
+    msgBulk_Forget(payloadPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a bulk payload's reference to its ring without handing the payload back to the
+ * producer.  Used once a payload has been sent, because the receiver frees it.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_Forget
+(
+    msgBulk_Payload_t*  payloadPtr  ///< [IN,OUT] Payload (cleared on return).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (payloadPtr->ringRef != NULL)
+    {
+        le_mem_Release(payloadPtr->ringRef);
+        payloadPtr->ringRef = NULL;
+    }
+}
@@ -0,0 +1,230 @@
+/** @file messagingBulk.h
+ *
+ * @ref c_messaging implementation's "Bulk" module's inter-module interface definitions.
+ *
+ * The Bulk module manages the shared memory rings used to carry large message payloads between
+ * the two ends of a session without copying them through the session's socket.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_MESSAGING_BULK_H_INCLUDE_GUARD
+#define LEGATO_MESSAGING_BULK_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Descriptor flag: the message announces the sender's bulk ring.  The ring's file descriptor is
+ * attached to the message and the descriptor's size field holds the size of the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSGBULK_FLAG_RING   0x1
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Descriptor flag: the message carries a bulk payload located in the sender's bulk ring.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSGBULK_FLAG_DATA   0x2
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Descriptor sent after the payload of any message that uses the bulk ring.  Messages that don't
+ * use the ring are sent without it, so the receiver can tell the two apart by their length.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t flags;     ///< MSGBULK_FLAG_xxx.
+    uint32_t offset;    ///< Offset of the bulk chunk in the sender's ring.
+    uint32_t size;      ///< Size of the bulk payload (or of the ring, for announcements).
+    uint32_t reserved;  ///< Always zero.
+}
+msgBulk_Descriptor_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a bulk ring.  Ring objects are reference counted using le_mem_AddRef() and
+ * le_mem_Release().  The ring is unmapped when the last reference is released.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct msgBulk_Ring* msgBulk_RingRef_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A bulk payload held by a message.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    msgBulk_RingRef_t   ringRef;    ///< Ring holding the payload (NULL = no bulk payload).
+    uint32_t            offset;     ///< Offset of the payload's chunk in the ring.
+    uint32_t            size;       ///< Size of the payload, in bytes.
+}
+msgBulk_Payload_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initializes this module.  This must be called only once at start-up, before any other functions
+ * in this module are called.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a new ring to send bulk payloads from.
+ *
+ * @return A reference to the ring, or NULL if bulk payloads are disabled or not supported.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgBulk_CreateTxRing
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maps a ring that was announced by the other end of a session.  Takes ownership of the file
+ * descriptor (it is closed on failure).
+ *
+ * @return A reference to the ring, or NULL if the ring was rejected.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgBulk_MapRxRing
+(
+    int         fd,         ///< [IN] File descriptor received with the announcement.
+    uint32_t    size        ///< [IN] Ring size given in the announcement.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the file descriptor and size of a ring, for announcing it to the other end of a session.
+ *
+ * @return A duplicate of the ring's file descriptor (owned by the caller), or -1 on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+int msgBulk_GetRingFd
+(
+    msgBulk_RingRef_t   ringRef,    ///< [IN] Ring.
+    uint32_t*           sizePtr     ///< [OUT] Ring size.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks whether a ring has been announced to the other end of the session.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgBulk_IsAnnounced
+(
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that a ring has been announced to the other end of the session.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_SetAnnounced
+(
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the largest bulk payload that can be allocated from a ring.
+ *
+ * @return The size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t msgBulk_GetMaxPayloadSize
+(
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a bulk payload from a transmit ring.  On success, the payload holds a reference to
+ * the ring.
+ *
+ * @return Pointer to the payload buffer, or NULL if the ring doesn't have enough free space.
+ */
+//--------------------------------------------------------------------------------------------------
+void* msgBulk_Alloc
+(
+    msgBulk_RingRef_t   ringRef,    ///< [IN] Ring.
+    size_t              size,       ///< [IN] Payload size, in bytes.
+    msgBulk_Payload_t*  payloadPtr  ///< [OUT] Payload.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up a bulk payload described by a message received from the other end of a session.  The
+ * descriptor comes from another process, so it is checked against the bounds of the ring.  On
+ * success, the payload holds a reference to the ring.
+ *
+ * @return Pointer to the payload, or NULL if the descriptor is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+const void* msgBulk_Lookup
+(
+    msgBulk_RingRef_t           ringRef,    ///< [IN] Ring announced by the sender.
+    const msgBulk_Descriptor_t* descPtr,    ///< [IN] Received descriptor.
+    msgBulk_Payload_t*          payloadPtr  ///< [OUT] Payload.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a pointer to a bulk payload.
+ *
+ * @return The pointer, or NULL if there is no payload.
+ */
+//--------------------------------------------------------------------------------------------------
+void* msgBulk_GetPtr
+(
+    const msgBulk_Payload_t* payloadPtr   ///< [IN] Payload.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hands a bulk payload back to the ring's producer, then releases the payload's reference to the
+ * ring.  Does nothing if there is no payload.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_Free
+(
+    msgBulk_Payload_t*  payloadPtr  ///< [IN,OUT] Payload (cleared on return).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a bulk payload's reference to its ring without handing the payload back to the
+ * producer.  Used once a payload has been sent, because the receiver frees it.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgBulk_Forget
+(
+    msgBulk_Payload_t*  payloadPtr  ///< [IN,OUT] Payload (cleared on return).
+);
+
+
+#endif // LEGATO_MESSAGING_BULK_H_INCLUDE_GUARD
@@ -54,6 +54,70 @@ static le_msg_MessageRef_t msgMessage_GetMessageRef(UnixMessage_t* msgPtr)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets a pointer to the space for the bulk descriptor, right after the end of the payload buffer.
+ * It is not necessarily aligned, so it must only be accessed using memcpy().
+ */
+//--------------------------------------------------------------------------------------------------
+static void* GetBulkDescriptorPtr
+(
+    UnixMessage_t* msgPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (uint8_t*)msgPtr->payload + le_msg_GetMaxPayloadSize(msgMessage_GetMessageRef(msgPtr));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles a bulk descriptor that arrived at the end of a received message.
+ *
+ * @return true if the message was a bulk ring announcement (which is consumed here), false if
+ *         it is a normal message to be passed on.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReceiveBulkDescriptor
+(
+    UnixMessage_t* msgPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_SessionRef_t sessionRef = msgPtr->message.sessionRef;
+    msgBulk_Descriptor_t desc;
+
+    memcpy(&desc, GetBulkDescriptorPtr(msgPtr), sizeof(desc));
+
+    if (desc.flags & MSGBULK_FLAG_RING)
+    {
+        // The fd is the ring; take it from the message.
+        msgBulk_RingRef_t ringRef = msgBulk_MapRxRing(msgPtr->fd, desc.size);
+        msgPtr->fd = -1;
+
+        msgSession_SetBulkRxRing(sessionRef, ringRef);
+
+        return true;
+    }
+
+    if (desc.flags & MSGBULK_FLAG_DATA)
+    {
+        msgBulk_RingRef_t ringRef = msgSession_GetBulkRxRing(sessionRef);
+
+        if (ringRef == NULL)
+        {
+            LE_ERROR("Received bulk payload without a bulk ring.");
+        }
+        else
+        {
+            msgBulk_Lookup(ringRef, &desc, &msgPtr->rxBulk);
+        }
+    }
+
+    return false;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Destructor function for Message objects.
@@ -101,6 +165,10 @@ static void MessageDestructor
         fd_Close(msgPtr->fd);
     }
 
+    // Hand any bulk payloads back to the rings they came from.
+    msgBulk_Free(&msgPtr->txBulk);
+    msgBulk_Free(&msgPtr->rxBulk);
+
     // Release the Message object's hold on the Session object.
     le_mem_Release(msgPtr->message.sessionRef);
 }
@@ -122,7 +190,7 @@ void msgMessage_Init
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Don't actually need to do anything here.
+    msgBulk_Init();
 }
 
 
@@ -151,7 +219,10 @@ le_mem_PoolRef_t msgMessage_CreatePool
         LE_DEBUG("Pool name truncated to '%s' for protocol '%s'.", poolName, name);
     }
 
-    le_mem_PoolRef_t poolRef = le_mem_CreatePool(poolName, sizeof(UnixMessage_t) + largestMsgSize);
+    // Leave room after the payload for a bulk descriptor.
+    le_mem_PoolRef_t poolRef = le_mem_CreatePool(poolName,
+                                                 sizeof(UnixMessage_t) + largestMsgSize
+                                                 + sizeof(msgBulk_Descriptor_t));
 
     le_mem_SetDestructor(poolRef, MessageDestructor);
 
@@ -161,6 +232,64 @@ le_mem_PoolRef_t msgMessage_CreatePool
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Describes a message to be sent, for unixSocket_SendMsg() or unixSocket_SendMsgVec().
+ * msgMessage_SendDone() must be called once the message has been sent.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_GetSendVec
+(
+    le_msg_MessageRef_t     msgRef, ///< [IN] The Message to be sent.
+    unixSocket_MsgVec_t*    vecPtr  ///< [OUT] Description of the data and fd to send.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+    // The first bytes come from our transaction ID and the rest (if any)
+    // from our Message object's payload section, which comes right after the transaction ID.
+    vecPtr->dataPtr = &msgPtr->txnId;
+    vecPtr->dataSize = sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgRef);
+    vecPtr->fd = msgPtr->fd;
+
+    // If the message uses the bulk ring, append a descriptor after the payload.
+    msgBulk_Descriptor_t desc = { 0 };
+    if (msgPtr->announceSize != 0)
+    {
+        desc.flags = MSGBULK_FLAG_RING;
+        desc.size = msgPtr->announceSize;
+    }
+    else if (msgPtr->txBulk.ringRef != NULL)
+    {
+        desc.flags = MSGBULK_FLAG_DATA;
+        desc.offset = msgPtr->txBulk.offset;
+        desc.size = msgPtr->txBulk.size;
+    }
+    if (desc.flags != 0)
+    {
+        memcpy(GetBulkDescriptorPtr(msgPtr), &desc, sizeof(desc));
+        vecPtr->dataSize += sizeof(desc);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that a message described by msgMessage_GetSendVec() has been sent.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_SendDone
+(
+    le_msg_MessageRef_t msgRef      ///< [IN] The Message that was sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Once sent, the bulk payload belongs to the receiver, who hands it back when done with it.
+    msgBulk_Forget(&msgMessage_GetUnixMessagePtr(msgRef)->txBulk);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send a single message over a connected socket.
@@ -181,32 +310,81 @@ le_result_t msgMessage_Send
 )
 //--------------------------------------------------------------------------------------------------
 {
-    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+    unixSocket_MsgVec_t vec;
 
-    // If this is a response message,
-    if (le_msg_NeedsResponse(msgRef))
+    msgMessage_GetSendVec(msgRef, &vec);
+
+    le_result_t result = unixSocket_SendMsg(socketFd,
+                                            vec.dataPtr,
+                                            vec.dataSize,
+                                            vec.fd,
+                                            false   ); // Don't send process credentials.
+    if (result == LE_OK)
     {
-        // If there was an fd that was received from the client but not fetched from the message
-        // generate a warning and close that fd.
-        if (msgPtr->fd >= 0)
-        {
-            LE_WARN("File descriptor not retrieved from message received from client.");
-            fd_Close(msgPtr->fd);
-        }
+        msgMessage_SendDone(msgRef);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Describes where a message is to be received into, for unixSocket_ReceiveMsg() or
+ * unixSocket_ReceiveMsgVec().  msgMessage_ReceiveDone() must be called once the message has been
+ * received.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_GetReceiveVec
+(
+    le_msg_MessageRef_t     msgRef, ///< [IN] Message object to store the received message in.
+    unixSocket_MsgVec_t*    vecPtr  ///< [OUT] Description of the receive buffer.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Receive the first bytes into our transaction ID and the rest (if any)
+    // into our Message object's payload section, followed by an optional bulk descriptor.
+    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+    vecPtr->dataPtr = &msgPtr->txnId;
+    vecPtr->dataSize = sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgRef)
+                       + sizeof(msgBulk_Descriptor_t);
+    vecPtr->fd = -1;
+}
 
-        // Move the responseFd to the normal fd position in the message object.
-        msgPtr->fd = msgPtr->clientServer.server.responseFd;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finishes receiving a message described by msgMessage_GetReceiveVec().
+ *
+ * @return true if the message is to be passed on, false if it was consumed internally (a bulk
+ *         ring announcement) and the Message object can be used to receive another message.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgMessage_ReceiveDone
+(
+    le_msg_MessageRef_t         msgRef, ///< [IN] Message object the message was received into.
+    const unixSocket_MsgVec_t*  vecPtr  ///< [IN] What was received.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+    msgPtr->fd = vecPtr->fd;
+
+    if (msgSession_GetInterfaceType(msgRef->sessionRef) == LE_MSG_INTERFACE_SERVER)
+    {
         msgPtr->clientServer.server.responseFd = -1;
     }
 
-    // The first bytes come from our transaction ID and the rest (if any)
-    // from our Message object's payload section, which comes right after the transaction ID.
-    return unixSocket_SendMsg(  socketFd,
-                                &msgPtr->txnId,
-                                sizeof(msgPtr->txnId) +
-                                le_msg_GetMaxPayloadSize(msgMessage_GetMessageRef(msgPtr)),
-                                msgPtr->fd,
-                                false   ); // Don't send process credentials.
+    // Messages that use the bulk ring have a descriptor appended to them.
+    if (vecPtr->dataSize == sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgRef)
+                            + sizeof(msgBulk_Descriptor_t))
+    {
+        return !ReceiveBulkDescriptor(msgPtr);
+    }
+
+    return true;
 }
 
 
@@ -228,20 +406,29 @@ le_result_t msgMessage_Receive
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Receive the first bytes into our transaction ID and the rest (if any)
-    // into our Message object's payload section.
-    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+    unixSocket_MsgVec_t vec;
+    le_result_t result;
 
-    size_t byteCount = sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgRef);
-    le_result_t result = unixSocket_ReceiveMsg( socketFd,
-                                                &msgPtr->txnId,
-                                                &byteCount,
-                                                &msgPtr->fd,
-                                                NULL    );  // Don't receive credentials.
-    if (msgSession_GetInterfaceType(msgRef->sessionRef) == LE_MSG_INTERFACE_SERVER)
+    // Bulk ring announcements are handled internally and never passed up, so keep receiving
+    // until something else arrives.
+    do
     {
-        msgPtr->clientServer.server.responseFd = -1;
+        msgMessage_GetReceiveVec(msgRef, &vec);
+        result = unixSocket_ReceiveMsg( socketFd,
+                                        vec.dataPtr,
+                                        &vec.dataSize,
+                                        &vec.fd,
+                                        NULL    );  // Don't receive credentials.
+        if (result != LE_OK)
+        {
+            if (msgSession_GetInterfaceType(msgRef->sessionRef) == LE_MSG_INTERFACE_SERVER)
+            {
+                msgMessage_GetUnixMessagePtr(msgRef)->clientServer.server.responseFd = -1;
+            }
+            break;
+        }
     }
+    while (!msgMessage_ReceiveDone(msgRef, &vec));
 
     return result;
 }
@@ -284,6 +471,71 @@ void* msgMessage_GetTxnId
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the ring that a message's (not yet sent) bulk payload was allocated from.
+ *
+ * @return The ring, or NULL if the message doesn't have a bulk payload to send.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgMessage_GetBulkTxRing
+(
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return msgMessage_GetUnixMessagePtr(msgRef)->txBulk.ringRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discards a message's (not yet sent) bulk payload.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_DropBulkPayload
+(
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgBulk_Free(&msgMessage_GetUnixMessagePtr(msgRef)->txBulk);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message that announces a bulk ring to the other end of a session.  Must be sent
+ * before any message with a bulk payload allocated from that ring.
+ *
+ * @return The message, or NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t msgMessage_CreateBulkAnnouncement
+(
+    le_msg_SessionRef_t sessionRef,
+    msgBulk_RingRef_t   ringRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t ringSize;
+    int fd = msgBulk_GetRingFd(ringRef, &ringSize);
+
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+    UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+    msgPtr->fd = fd;
+    msgPtr->announceSize = ringSize;
+
+    return msgRef;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Call the completion callback function for a given message, if it has one.
@@ -365,6 +617,9 @@ le_msg_MessageRef_t le_msg_CreateMsg
     }
 
     msgPtr->fd = -1;
+    msgPtr->txBulk.ringRef = NULL;
+    msgPtr->rxBulk.ringRef = NULL;
+    msgPtr->announceSize = 0;
     msgPtr->txnId = 0;
     memset(msgPtr->payload, 0, le_msg_GetProtocolMaxMsgSize(protocolRef));
 
@@ -603,6 +858,124 @@ int le_msg_GetFd
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a bulk payload buffer for a message.  The buffer is sent along with the message
+ * without being copied through the session's socket.
+ *
+ * At most one bulk payload is allowed per message.
+ *
+ * @return A pointer to the buffer, or NULL if a bulk payload of this size can't be allocated
+ *         right now (in which case the data must be sent some other way).
+ **/
+//--------------------------------------------------------------------------------------------------
+void* le_msg_AllocBulkPayload
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Size of the bulk payload, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(msgRef);
+    switch (msgRef->sessionRef->type)
+    {
+        case LE_MSG_SESSION_LOCAL:
+            return NULL;
+        case LE_MSG_SESSION_UNIX_SOCKET:
+        {
+            UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+            LE_FATAL_IF((msgPtr->txBulk.ringRef != NULL) || (msgPtr->announceSize != 0),
+                        "Attempt to allocate more than one bulk payload on the same message.");
+
+            msgBulk_RingRef_t ringRef = msgSession_GetBulkTxRing(msgRef->sessionRef);
+            if (ringRef == NULL)
+            {
+                return NULL;
+            }
+
+            return msgBulk_Alloc(ringRef, size, &msgPtr->txBulk);
+        }
+        default:
+            LE_FATAL("Corrupted session type: %d", msgRef->sessionRef->type);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the bulk payload of a message.
+ *
+ * @return A pointer to the bulk payload, or NULL if the message doesn't have one.  The payload
+ *         remains valid until the message is released.
+ **/
+//--------------------------------------------------------------------------------------------------
+const void* le_msg_GetBulkPayloadPtr
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t*             sizePtr     ///< [out] Size of the bulk payload, in bytes (0 if none).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(msgRef);
+    LE_ASSERT(sizePtr);
+
+    *sizePtr = 0;
+
+    switch (msgRef->sessionRef->type)
+    {
+        case LE_MSG_SESSION_LOCAL:
+            return NULL;
+        case LE_MSG_SESSION_UNIX_SOCKET:
+        {
+            UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+            const msgBulk_Payload_t* payloadPtr =
+                (msgPtr->rxBulk.ringRef != NULL ? &msgPtr->rxBulk : &msgPtr->txBulk);
+
+            if (payloadPtr->ringRef == NULL)
+            {
+                return NULL;
+            }
+
+            *sizePtr = payloadPtr->size;
+            return msgBulk_GetPtr(payloadPtr);
+        }
+        default:
+            LE_FATAL("Corrupted session type: %d", msgRef->sessionRef->type);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the largest bulk payload that can be sent on a session.
+ *
+ * @return The size, in bytes, or 0 if bulk payloads are not available on this session.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t le_msg_GetMaxBulkPayloadSize
+(
+    le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(sessionRef);
+    switch (sessionRef->type)
+    {
+        case LE_MSG_SESSION_LOCAL:
+            return 0;
+        case LE_MSG_SESSION_UNIX_SOCKET:
+        {
+            msgBulk_RingRef_t ringRef = msgSession_GetBulkTxRing(sessionRef);
+
+            return (ringRef == NULL ? 0 : msgBulk_GetMaxPayloadSize(ringRef));
+        }
+        default:
+            LE_FATAL("Corrupted session type: %d", sessionRef->type);
+    }
+}
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -779,9 +1152,26 @@ void le_msg_Respond
             msgLocal_Respond(msgRef);
             break;
         case LE_MSG_SESSION_UNIX_SOCKET:
+        {
+            UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
+
+            // If there was an fd that was received from the client but not fetched from the
+            // message generate a warning and close that fd.
+            if (msgPtr->fd >= 0)
+            {
+                LE_WARN("File descriptor not retrieved from message received from client.");
+                fd_Close(msgPtr->fd);
+            }
+
+            // Move the responseFd to the normal fd position in the message object.  This is done
+            // here rather than when sending, because sending may be retried.
+            msgPtr->fd = msgPtr->clientServer.server.responseFd;
+            msgPtr->clientServer.server.responseFd = -1;
+
             // Send the response message.
             msgSession_SendMessage(msgRef->sessionRef, msgRef);
             break;
+        }
         default:
             LE_FATAL("Corrupted session type: %d", msgRef->sessionRef->type);
     }
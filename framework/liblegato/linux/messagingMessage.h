@@ -8,6 +8,9 @@
 #ifndef LEGATO_MESSAGING_MESSAGE_H_INCLUDE_GUARD
 #define LEGATO_MESSAGING_MESSAGE_H_INCLUDE_GUARD
 
+#include "messagingBulk.h"
+#include "unixSocket.h"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a message.
@@ -41,8 +44,13 @@ typedef struct le_msg_UnixMessage
     clientServer;
 
     int                         fd;         ///< File descriptor to send or received (-1 = no fd)
+    msgBulk_Payload_t           txBulk;     ///< Bulk payload to be sent (not yet sent).
+    msgBulk_Payload_t           rxBulk;     ///< Bulk payload received.
+    uint32_t                    announceSize; ///< Size of the bulk ring announced by this message
+                                              ///  (0 = not a bulk ring announcement).
     void*                       txnId;      ///< Safe reference value used as a transaction ID.
     void*                       payload[0]; ///< Variable-length payload buffer appears at the end.
+                                            ///  It is followed by space for a bulk descriptor.
 }
 UnixMessage_t;
 
@@ -90,6 +98,59 @@ le_result_t msgMessage_Send
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Describes a message to be sent, for unixSocket_SendMsg() or unixSocket_SendMsgVec().
+ * msgMessage_SendDone() must be called once the message has been sent.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_GetSendVec
+(
+    le_msg_MessageRef_t     msgRef, ///< [IN] The Message to be sent.
+    unixSocket_MsgVec_t*    vecPtr  ///< [OUT] Description of the data and fd to send.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records that a message described by msgMessage_GetSendVec() has been sent.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_SendDone
+(
+    le_msg_MessageRef_t msgRef      ///< [IN] The Message that was sent.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Describes where a message is to be received into, for unixSocket_ReceiveMsg() or
+ * unixSocket_ReceiveMsgVec().  msgMessage_ReceiveDone() must be called once the message has been
+ * received.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_GetReceiveVec
+(
+    le_msg_MessageRef_t     msgRef, ///< [IN] Message object to store the received message in.
+    unixSocket_MsgVec_t*    vecPtr  ///< [OUT] Description of the receive buffer.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finishes receiving a message described by msgMessage_GetReceiveVec().
+ *
+ * @return true if the message is to be passed on, false if it was consumed internally (a bulk
+ *         ring announcement) and the Message object can be used to receive another message.
+ */
+//--------------------------------------------------------------------------------------------------
+bool msgMessage_ReceiveDone
+(
+    le_msg_MessageRef_t         msgRef, ///< [IN] Message object the message was received into.
+    const unixSocket_MsgVec_t*  vecPtr  ///< [IN] What was received.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive a single message from a connected socket.
@@ -180,6 +241,45 @@ void* msgMessage_GetTxnId
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the ring that a message's (not yet sent) bulk payload was allocated from.
+ *
+ * @return The ring, or NULL if the message doesn't have a bulk payload to send.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgMessage_GetBulkTxRing
+(
+    le_msg_MessageRef_t msgRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discards a message's (not yet sent) bulk payload.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_DropBulkPayload
+(
+    le_msg_MessageRef_t msgRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a message that announces a bulk ring to the other end of a session.  Must be sent
+ * before any message with a bulk payload allocated from that ring.
+ *
+ * @return The message, or NULL on failure.
+ */
+//--------------------------------------------------------------------------------------------------
+le_msg_MessageRef_t msgMessage_CreateBulkAnnouncement
+(
+    le_msg_SessionRef_t sessionRef,
+    msgBulk_RingRef_t   ringRef
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Call the completion callback function for a given message.
@@ -417,6 +417,110 @@ static void PurgeReceiveQueue
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a session's bulk rings.
+ *
+ * @note    This is used on both the client side and the server side.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseBulkRings
+(
+    msgSession_UnixSession_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LOCK
+
+    msgBulk_RingRef_t txRingRef = sessionPtr->bulkTxRingRef;
+    msgBulk_RingRef_t rxRingRef = sessionPtr->bulkRxRingRef;
+    sessionPtr->bulkTxRingRef = NULL;
+    sessionPtr->bulkRxRingRef = NULL;
+
+    UNLOCK
+
+    if (txRingRef != NULL)
+    {
+        le_mem_Release(txRingRef);
+    }
+    if (rxRingRef != NULL)
+    {
+        le_mem_Release(rxRingRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * If a message about to be queued for sending has a bulk payload from a ring that the other end
+ * of the session doesn't know about yet, creates the message that announces the ring.
+ *
+ * @return The announcement message, to be sent before the given message, or NULL if none needed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_msg_MessageRef_t CreateBulkAnnouncement
+(
+    msgSession_UnixSession_t*   sessionPtr,
+    le_msg_MessageRef_t         msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgBulk_RingRef_t ringRef = msgMessage_GetBulkTxRing(msgRef);
+
+    if ((ringRef == NULL) || msgBulk_IsAnnounced(ringRef))
+    {
+        return NULL;
+    }
+
+    // A message built before the session was closed and reopened refers to a ring that the new
+    // connection will never see.
+    if (ringRef != sessionPtr->bulkTxRingRef)
+    {
+        LE_ERROR("Discarding bulk payload allocated on a previous connection.");
+        msgMessage_DropBulkPayload(msgRef);
+        return NULL;
+    }
+
+    le_msg_MessageRef_t announceRef =
+        msgMessage_CreateBulkAnnouncement(msgSession_GetSessionRef(sessionPtr), ringRef);
+    if (announceRef == NULL)
+    {
+        msgMessage_DropBulkPayload(msgRef);
+        return NULL;
+    }
+
+    msgBulk_SetAnnounced(ringRef);
+
+    return announceRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pushes a message onto the tail of the Transmit Queue, preceded by the announcement of its
+ * bulk ring if the other end of the session hasn't seen that ring yet.
+ *
+ * @note    This is used on both the client side and the server side.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueMessage
+(
+    msgSession_UnixSession_t*   sessionPtr,
+    le_msg_MessageRef_t         msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_MessageRef_t announceRef = CreateBulkAnnouncement(sessionPtr, msgRef);
+
+    if (announceRef != NULL)
+    {
+        PushTransmitQueue(sessionPtr, announceRef);
+    }
+
+    PushTransmitQueue(sessionPtr, msgRef);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a Session object.
@@ -453,6 +557,12 @@ static msgSession_UnixSession_t* CreateSession
     sessionPtr->closeHandler = NULL;
     sessionPtr->closeContextPtr = NULL;
 
+    sessionPtr->bulkTxRingRef = NULL;
+    sessionPtr->bulkRxRingRef = NULL;
+
+    sessionPtr->isFlushPending = false;
+    sessionPtr->deferredCount = 0;
+
     sessionPtr->interfaceRef = interfaceRef;
 
     SessionObjListChangeCount++;
@@ -505,6 +615,10 @@ static void CloseSession
     }
     PurgeTransmitQueue(sessionPtr);
     PurgeReceiveQueue(sessionPtr);
+
+    // Drop the bulk rings.  Messages still holding bulk payloads keep their ring mapped until
+    // they are released.  If the session is reopened, a new ring is created and announced.
+    ReleaseBulkRings(sessionPtr);
 }
 
 
@@ -933,6 +1047,82 @@ static void ClientSocketError
 }
 
 
+#if LE_CONFIG_MSG_BATCH_SIZE > 1
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive messages from the socket and put them on the Receive Queue.
+ *
+ * Up to LE_CONFIG_MSG_BATCH_SIZE messages are received by each system call.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReceiveMessages
+(
+    msgSession_UnixSession_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_msg_MessageRef_t msgRefs[LE_CONFIG_MSG_BATCH_SIZE];
+    unixSocket_MsgVec_t vecs[LE_CONFIG_MSG_BATCH_SIZE];
+    size_t spareCount = 0;  // Number of Message objects in msgRefs[] that can be received into.
+    size_t receivedCount;
+    size_t i;
+
+    do
+    {
+        // Top up the Message objects to receive into.
+        for (i = 0; i < LE_CONFIG_MSG_BATCH_SIZE; i++)
+        {
+            if (i >= spareCount)
+            {
+                msgRefs[i] = le_msg_CreateMsg(msgSession_GetSessionRef(sessionPtr));
+            }
+            msgMessage_GetReceiveVec(msgRefs[i], &vecs[i]);
+        }
+        spareCount = LE_CONFIG_MSG_BATCH_SIZE;
+
+        if (unixSocket_ReceiveMsgVec(sessionPtr->socketFd,
+                                     vecs,
+                                     LE_CONFIG_MSG_BATCH_SIZE,
+                                     &receivedCount) != LE_OK)
+        {
+            // Nothing left to receive from the socket.  We are done.
+            break;
+        }
+
+        // Push everything that was received onto the Receive Queue for later processing, and
+        // keep the Message objects that weren't used (or were consumed internally) for the next
+        // round.
+        spareCount = 0;
+        for (i = 0; i < LE_CONFIG_MSG_BATCH_SIZE; i++)
+        {
+            if (i < receivedCount)
+            {
+                if (vecs[i].result != LE_OK)
+                {
+                    // Dropped, as msgMessage_Receive() would.
+                    if (vecs[i].fd >= 0)
+                    {
+                        fd_Close(vecs[i].fd);
+                    }
+                }
+                else if (msgMessage_ReceiveDone(msgRefs[i], &vecs[i]))
+                {
+                    PushReceiveQueue(sessionPtr, msgRefs[i]);
+                    continue;
+                }
+            }
+            msgRefs[spareCount++] = msgRefs[i];
+        }
+    }
+    // If the batch was filled, there may be more waiting.
+    while (receivedCount == LE_CONFIG_MSG_BATCH_SIZE);
+
+    for (i = 0; i < spareCount; i++)
+    {
+        le_msg_ReleaseMsg(msgRefs[i]);
+    }
+}
+#else
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive messages from the socket and put them on the Receive Queue.
@@ -965,6 +1155,7 @@ static void ReceiveMessages
         }
     }
 }
+#endif
 
 
 //--------------------------------------------------------------------------------------------------
@@ -1013,10 +1204,60 @@ static void ServerSocketError
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finishes off a message once it has been sent from a session's Transmit Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MessageSent
+(
+    msgSession_UnixSession_t* sessionPtr,
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (sessionPtr->interfaceRef->interfaceType)
+    {
+        // If this is the client side of the session,
+        case LE_MSG_INTERFACE_CLIENT:
+            // If a response is expected from the other side later, then put this
+            // message on the Transaction List.
+            if (msgMessage_GetTxnId(msgRef) != 0)
+            {
+                AddToTxnList(sessionPtr, msgRef);
+            }
+            // Otherwise, release it.
+            else
+            {
+                le_msg_ReleaseMsg(msgRef);
+            }
+
+            break;
+
+        // If this is the server side of the session,
+        case LE_MSG_INTERFACE_SERVER:
+            // Release the message, but first clear out the transaction ID so that
+            // the message knows that it is not being deleted without a reponse message
+            // being sent if one was expected.
+            msgMessage_SetTxnId(msgRef, 0);
+            le_msg_ReleaseMsg(msgRef);
+
+            break;
+
+        default:
+            LE_FATAL("Unhandled interface type (%d)",
+                     sessionPtr->interfaceRef->interfaceType);
+    }
+}
+
+
+#if LE_CONFIG_MSG_BATCH_SIZE > 1
 //--------------------------------------------------------------------------------------------------
 /**
  * Send messages from a session's Transmit Queue until either the socket becomes full or there
  * are no more messages waiting on the queue.
+ *
+ * Up to LE_CONFIG_MSG_BATCH_SIZE messages are sent by each system call.
  */
 //--------------------------------------------------------------------------------------------------
 static void SendFromTransmitQueue
@@ -1025,11 +1266,25 @@ static void SendFromTransmitQueue
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_msg_MessageRef_t msgRefs[LE_CONFIG_MSG_BATCH_SIZE];
+    unixSocket_MsgVec_t vecs[LE_CONFIG_MSG_BATCH_SIZE];
+
+    sessionPtr->deferredCount = 0;
+
     for (;;)
     {
-        le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+        size_t count = 0;
+        size_t sentCount;
+        size_t i;
 
-        if (msgRef == NULL)
+        while ((count < LE_CONFIG_MSG_BATCH_SIZE)
+               && (NULL != (msgRefs[count] = PopTransmitQueue(sessionPtr))))
+        {
+            msgMessage_GetSendVec(msgRefs[count], &vecs[count]);
+            count++;
+        }
+
+        if (count == 0)
         {
             // Since the Transmit Queue is empty, tell the FD Monitor that we don't need to be
             // notified about writeability anymore.
@@ -1037,44 +1292,114 @@ static void SendFromTransmitQueue
             break;
         }
 
-        le_result_t result = msgMessage_Send(sessionPtr->socketFd, msgRef);
+        le_result_t result = unixSocket_SendMsgVec(sessionPtr->socketFd, vecs, count, &sentCount);
+
+        for (i = 0; i < sentCount; i++)
+        {
+            msgMessage_SendDone(msgRefs[i]);
+            MessageSent(sessionPtr, msgRefs[i]);
+        }
+
+        // Put anything that wasn't sent back on the head of the queue, in order.
+        for (i = count; i > sentCount; i--)
+        {
+            UnPopTransmitQueue(sessionPtr, msgRefs[i - 1]);
+        }
 
         switch (result)
         {
             case LE_OK:
-                switch (sessionPtr->interfaceRef->interfaceType)
+                if (sentCount < count)
                 {
-                    // If this is the client side of the session,
-                    case LE_MSG_INTERFACE_CLIENT:
-                        // If a response is expected from the other side later, then put this
-                        // message on the Transaction List.
-                        if (msgMessage_GetTxnId(msgRef) != 0)
-                        {
-                            AddToTxnList(sessionPtr, msgRef);
-                        }
-                        // Otherwise, release it.
-                        else
-                        {
-                            le_msg_ReleaseMsg(msgRef);
-                        }
-
-                        break;
-
-                    // If this is the server side of the session,
-                    case LE_MSG_INTERFACE_SERVER:
-                        // Release the message, but first clear out the transaction ID so that
-                        // the message knows that it is not being deleted without a reponse message
-                        // being sent if one was expected.
-                        msgMessage_SetTxnId(msgRef, 0);
-                        le_msg_ReleaseMsg(msgRef);
-
-                        break;
-
-                    default:
-                        LE_FATAL("Unhandled interface type (%d)",
-                                 sessionPtr->interfaceRef->interfaceType);
+                    // The socket filled up part way through the batch.  Ask the FD Monitor to
+                    // tell us when the socket becomes writeable again.
+                    EnableWriteabilityNotification(sessionPtr);
+                    return;
                 }
+                break;  // Continue to loop around and send another batch.
+
+            case LE_NO_MEMORY:
+                // Have to wait for the socket to become writeable.
+                EnableWriteabilityNotification(sessionPtr);
+                return;
 
+            case LE_COMM_ERROR:
+                // In this case, we expect a handler function to be called by the FD Monitor,
+                // so we don't need to handle this case here.  However, we must stop
+                // trying to transmit now.  The messages left on the Transmit Queue get cleaned
+                // up when the session closes.
+                return;
+
+            default:
+                LE_FATAL("Unexpected return code %d.", result);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends whatever was queued on a session's Transmit Queue while the event handler that queued it
+ * was running.
+ *
+ * @note    This function is called by the Event Loop as a "queued function".
+ *          That's why the parameter list looks unusual.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushTransmitQueue
+(
+    void* param1Ptr,    ///< [IN] Pointer to a Session object.
+    void* param2Ptr     ///< not used
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(param2Ptr);
+
+    msgSession_UnixSession_t* sessionPtr = param1Ptr;
+
+    sessionPtr->isFlushPending = false;
+
+    // The session may have been closed since the flush was queued.
+    if (sessionPtr->state == LE_MSG_SESSION_STATE_OPEN)
+    {
+        SendFromTransmitQueue(sessionPtr);
+    }
+
+    // NOTE: Each of these queued functions holds a reference to the session object so that
+    //       the session object doesn't go away.  But it could go away as soon as we release it.
+    le_mem_Release(sessionPtr);
+}
+#else
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send messages from a session's Transmit Queue until either the socket becomes full or there
+ * are no more messages waiting on the queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendFromTransmitQueue
+(
+    msgSession_UnixSession_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (;;)
+    {
+        le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+
+        if (msgRef == NULL)
+        {
+            // Since the Transmit Queue is empty, tell the FD Monitor that we don't need to be
+            // notified about writeability anymore.
+            DisableWriteabilityNotification(sessionPtr);
+            break;
+        }
+
+        le_result_t result = msgMessage_Send(sessionPtr->socketFd, msgRef);
+
+        switch (result)
+        {
+            case LE_OK:
+                MessageSent(sessionPtr, msgRef);
                 break;  // Continue to loop around and send another.
 
             case LE_NO_MEMORY:
@@ -1100,6 +1425,67 @@ static void SendFromTransmitQueue
         }
     }
 }
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts sending the messages on a session's Transmit Queue.
+ *
+ * With message batching enabled, the actual sending is deferred until the current event handler
+ * returns to the Event Loop, so that everything it sends goes out together.
+ */
+//--------------------------------------------------------------------------------------------------
+static void KickTransmitQueue
+(
+    msgSession_UnixSession_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_MSG_BATCH_SIZE > 1
+    // Don't let a handler that sends a lot without returning to the Event Loop pile up messages;
+    // send as soon as there's a full batch.
+    if (++sessionPtr->deferredCount >= LE_CONFIG_MSG_BATCH_SIZE)
+    {
+        SendFromTransmitQueue(sessionPtr);
+    }
+    else if (!sessionPtr->isFlushPending)
+    {
+        // NOTE: Each of these queued functions holds a reference to the session object so that
+        //       the session object doesn't go away before the queued function is run.
+        sessionPtr->isFlushPending = true;
+        le_mem_AddRef(sessionPtr);
+        le_event_QueueFunction(FlushTransmitQueue, sessionPtr, NULL);
+    }
+#else
+    SendFromTransmitQueue(sessionPtr);
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends messages whose sending was deferred by message batching before a session is closed by
+ * its own end.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendDeferredMessages
+(
+    msgSession_UnixSession_t* sessionPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if LE_CONFIG_MSG_BATCH_SIZE > 1
+    if (sessionPtr->isFlushPending
+        && (sessionPtr->state == LE_MSG_SESSION_STATE_OPEN)
+        && (sessionPtr->threadRef == le_thread_GetCurrent()))
+    {
+        SendFromTransmitQueue(sessionPtr);
+    }
+#else
+    LE_UNUSED(sessionPtr);
+#endif
+}
 
 
 //--------------------------------------------------------------------------------------------------
@@ -1645,10 +2031,10 @@ void msgSession_SendMessage
     else
     {
         // Put the message on the Transmit Queue.
-        PushTransmitQueue(unixSessionPtr, messageRef);
+        QueueMessage(unixSessionPtr, messageRef);
 
         // Try to send something from the Transmit Queue.
-        SendFromTransmitQueue(unixSessionPtr);
+        KickTransmitQueue(unixSessionPtr);
     }
 }
 
@@ -1681,10 +2067,10 @@ void msgSession_RequestResponse
     CreateTxnId(msgRef);
 
     // Put the message on the Transmit Queue.
-    PushTransmitQueue(unixSessionPtr, msgRef);
+    QueueMessage(unixSessionPtr, msgRef);
 
     // Try to send something from the Transmit Queue.
-    SendFromTransmitQueue(unixSessionPtr);
+    KickTransmitQueue(unixSessionPtr);
 }
 
 
@@ -1715,6 +2101,18 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // Put the socket into blocking mode.
     fd_SetBlocking(unixSessionPtr->socketFd);
 
+    // Messages queued earlier (deferred by batching, or held back by a full socket) must reach
+    // the server before the request does.
+    SendFromTransmitQueue(unixSessionPtr);
+
+    // Announce the request's bulk ring first, if the server hasn't seen it yet.
+    le_msg_MessageRef_t announceRef = CreateBulkAnnouncement(unixSessionPtr, msgRef);
+    if (announceRef != NULL)
+    {
+        msgMessage_Send(unixSessionPtr->socketFd, announceRef);
+        le_msg_ReleaseMsg(announceRef);
+    }
+
     // Send the Request Message.
     msgMessage_Send(unixSessionPtr->socketFd, msgRef);
 
@@ -1770,6 +2168,83 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the ring that bulk payloads sent on a session are allocated from, creating it if needed.
+ *
+ * @return The ring, or NULL if bulk payloads are not available.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgSession_GetBulkTxRing
+(
+    le_msg_SessionRef_t sessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgSession_UnixSession_t* unixSessionPtr = msgSession_GetUnixSessionPtr(sessionRef);
+
+    // Messages may be built by threads other than the one that owns the session.
+    LOCK
+
+    if (unixSessionPtr->bulkTxRingRef == NULL)
+    {
+        unixSessionPtr->bulkTxRingRef = msgBulk_CreateTxRing();
+    }
+
+    msgBulk_RingRef_t ringRef = unixSessionPtr->bulkTxRingRef;
+
+    UNLOCK
+
+    return ringRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the ring that the other end of a session announced for its bulk payloads.
+ *
+ * @return The ring, or NULL if none has been announced.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgSession_GetBulkRxRing
+(
+    le_msg_SessionRef_t sessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return msgSession_GetUnixSessionPtr(sessionRef)->bulkRxRingRef;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records the ring that the other end of a session announced for its bulk payloads.  Takes over
+ * the caller's reference to the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgSession_SetBulkRxRing
+(
+    le_msg_SessionRef_t sessionRef,
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring (NULL if the announced ring was rejected).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgSession_UnixSession_t* unixSessionPtr = msgSession_GetUnixSessionPtr(sessionRef);
+
+    LOCK
+
+    msgBulk_RingRef_t oldRingRef = unixSessionPtr->bulkRxRingRef;
+    unixSessionPtr->bulkRxRingRef = ringRef;
+
+    UNLOCK
+
+    if (oldRingRef != NULL)
+    {
+        le_mem_Release(oldRingRef);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the interface reference for a given Session object.
@@ -2047,6 +2522,7 @@ void le_msg_DeleteSession
             msgSession_UnixSession_t* unixSessionPtr = msgSession_GetUnixSessionPtr(sessionRef);
             LE_FATAL_IF((unixSessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER),
                         "Server attempted to delete a session.");
+            SendDeferredMessages(unixSessionPtr);
             DeleteSession(unixSessionPtr, false);
             break;
         }
@@ -2358,6 +2834,8 @@ static void CloseSessionCommon
         {
             msgSession_UnixSession_t* unixSessionPtr = msgSession_GetUnixSessionPtr(sessionRef);
 
+            SendDeferredMessages(unixSessionPtr);
+
             // On the server side, sessions are automatically deleted when they close.
             if (unixSessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER)
             {
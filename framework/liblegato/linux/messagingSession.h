@@ -12,6 +12,7 @@
 
 #include "messagingCommon.h"
 #include "messagingInterface.h"
+#include "messagingBulk.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -63,6 +64,16 @@ typedef struct msg_UnixSession
     void*                           openContextPtr; ///< Open handler's context pointer.
     le_msg_SessionEventHandler_t    closeHandler;   ///< Close handler function.
     void*                           closeContextPtr;///< Close handler's context pointer.
+
+    msgBulk_RingRef_t               bulkTxRingRef;  ///< Ring for bulk payloads we send
+                                                    ///  (NULL = not created yet).
+    msgBulk_RingRef_t               bulkRxRingRef;  ///< Ring announced by the other end
+                                                    ///  (NULL = none).
+
+    bool                            isFlushPending; ///< true if a transmit queue flush has been
+                                                    ///  queued to the event loop.
+    size_t                          deferredCount;  ///< Number of messages queued since the
+                                                    ///  Transmit Queue was last sent from.
 }
 msgSession_UnixSession_t;
 
@@ -192,6 +203,45 @@ le_msg_SessionRef_t msgSession_GetSessionContainingLink
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the ring that bulk payloads sent on a session are allocated from, creating it if needed.
+ *
+ * @return The ring, or NULL if bulk payloads are not available.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgSession_GetBulkTxRing
+(
+    le_msg_SessionRef_t sessionRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the ring that the other end of a session announced for its bulk payloads.
+ *
+ * @return The ring, or NULL if none has been announced.
+ */
+//--------------------------------------------------------------------------------------------------
+msgBulk_RingRef_t msgSession_GetBulkRxRing
+(
+    le_msg_SessionRef_t sessionRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records the ring that the other end of a session announced for its bulk payloads.  Takes over
+ * the caller's reference to the ring.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgSession_SetBulkRxRing
+(
+    le_msg_SessionRef_t sessionRef,
+    msgBulk_RingRef_t   ringRef     ///< [IN] Ring (NULL if the announced ring was rejected).
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a server-side Session object for a given client connection to a given Service.
@@ -66,6 +66,31 @@
 //--------------------------------------------------------------------------------------------------
 #define CFG_TREE_PATH               CURRENT_SYSTEM_PATH"/config"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * File name extensions of the files a config tree is stored in, in the config tree directory.  A
+ * tree named "foo" is stored in "foo.paper", "foo.rock" or "foo.scissors" in the text format, and
+ * in "foo.snap", (with its temporary copy "foo.snap.tmp",) and "foo.journal" when the binary store
+ * (LE_CONFIG_CFGTREE_JOURNAL) is enabled.  The snapshot and journal that were replaced last are
+ * kept as "foo.snap.prev" and "foo.journal.prev".
+ *
+ * CFG_TREE_FILE_EXTS lists all of them, for initializing an array of strings.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_TREE_TEXT_EXTS          "paper", "rock", "scissors"
+#define CFG_TREE_SNAPSHOT_EXT       "snap"
+#define CFG_TREE_SNAPSHOT_TEMP_EXT  "snap.tmp"
+#define CFG_TREE_SNAPSHOT_PREV_EXT  "snap.prev"
+#define CFG_TREE_JOURNAL_EXT        "journal"
+#define CFG_TREE_JOURNAL_PREV_EXT   "journal.prev"
+
+#define CFG_TREE_FILE_EXTS          CFG_TREE_TEXT_EXTS,         \
+                                    CFG_TREE_SNAPSHOT_EXT,      \
+                                    CFG_TREE_SNAPSHOT_TEMP_EXT, \
+                                    CFG_TREE_SNAPSHOT_PREV_EXT, \
+                                    CFG_TREE_JOURNAL_EXT,       \
+                                    CFG_TREE_JOURNAL_PREV_EXT
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -760,6 +760,236 @@ le_result_t unixSocket_ReceiveDataMsg
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends several messages, each containing data and optionally a file descriptor, through a
+ * connected Unix domain datagram or sequenced-packet socket in a single system call.
+ *
+ * Messages are sent in order.  If the socket's buffer fills up part way through, the messages
+ * that were sent are reported in sentCountPtr and the rest must be sent later.
+ *
+ * @return
+ * - LE_OK if at least one message was sent.
+ * - LE_NO_MEMORY if the socket is set to non-blocking and none could be sent right now.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ *
+ * @warning DO NOT SEND DIRECTORY FILE DESCRIPTORS.  That can be exploited to break out of chroot()
+ *          jails.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgVec
+(
+    int localSocketFd,                  ///< [IN] fd of the local socket that will be used to send.
+    const unixSocket_MsgVec_t* msgsPtr, ///< [IN] Messages to send.
+    size_t count,                       ///< [IN] Number of messages (max UNIXSOCKET_MAX_MSG_VEC).
+    size_t* sentCountPtr                ///< [OUT] Number of messages sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // One control message buffer per message, big enough for one file descriptor.
+    union
+    {
+        struct cmsghdr  header;
+        char            buff[CMSG_SPACE(sizeof(int))];
+    }
+    cmsgBuffers[UNIXSOCKET_MAX_MSG_VEC];
+
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_MSG_VEC];
+    struct iovec ioVectors[UNIXSOCKET_MAX_MSG_VEC];
+    size_t i;
+
+    LE_ASSERT((count > 0) && (count <= UNIXSOCKET_MAX_MSG_VEC));
+
+    *sentCountPtr = 0;
+    memset(msgHeaders, 0, count * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < count; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        ioVectors[i].iov_base = msgsPtr[i].dataPtr;
+        ioVectors[i].iov_len = msgsPtr[i].dataSize;
+        msgHeaderPtr->msg_iov = &ioVectors[i];
+        msgHeaderPtr->msg_iovlen = 1;
+
+        if (msgsPtr[i].fd >= 0)
+        {
+            msgHeaderPtr->msg_control = cmsgBuffers[i].buff;
+            msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i].buff);
+
+            struct cmsghdr* cmsgHeaderPtr = CMSG_FIRSTHDR(msgHeaderPtr);
+            cmsgHeaderPtr->cmsg_level = SOL_SOCKET;
+            cmsgHeaderPtr->cmsg_type = SCM_RIGHTS;
+            cmsgHeaderPtr->cmsg_len = CMSG_LEN(sizeof(int));
+            memcpy(CMSG_DATA(cmsgHeaderPtr), &msgsPtr[i].fd, sizeof(int));
+
+            msgHeaderPtr->msg_controllen = cmsgHeaderPtr->cmsg_len;
+
+            LE_DEBUG("Sending fd %d.", msgsPtr[i].fd);
+        }
+    }
+
+    // Send as many as will fit (retry if interrupted by a signal before anything was sent).
+    int sentCount;
+    do
+    {
+        sentCount = sendmmsg(localSocketFd, msgHeaders, count, 0);
+    }
+    while ((sentCount < 0) && (errno == EINTR));
+
+    if (sentCount < 0)
+    {
+        switch (errno)
+        {
+            case EAGAIN:  // Same as EWOULDBLOCK
+                return LE_NO_MEMORY;
+
+            case ENOTCONN:
+            case ECONNRESET:
+            case EPIPE:
+                LE_WARN("sendmmsg() failed with errno %d (%m).", errno);
+                return LE_COMM_ERROR;
+
+            default:
+                LE_ERROR("sendmmsg() failed with errno %d (%m).", errno);
+                return LE_FAULT;
+        }
+    }
+
+    *sentCountPtr = sentCount;
+
+    for (i = 0; i < (size_t)sentCount; i++)
+    {
+        if (msgHeaders[i].msg_len < msgsPtr[i].dataSize)
+        {
+            LE_ERROR("The last %zu data bytes (of %zu total) of message %zu were discarded!",
+                     msgsPtr[i].dataSize - msgHeaders[i].msg_len,
+                     msgsPtr[i].dataSize,
+                     i);
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives up to a given number of messages, each containing data and optionally a file
+ * descriptor, through a connected Unix domain datagram or sequenced-packet socket in a single
+ * system call.  Only blocks (on a blocking socket) until the first message arrives.
+ *
+ * The outcome for each received message is stored in its result field (see
+ * unixSocket_ReceiveMsg()).
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgVec
+(
+    int localSocketFd,                  ///< [IN] fd of local socket to receive the messages on.
+    unixSocket_MsgVec_t* msgsPtr,       ///< [IN,OUT] Buffers to receive the messages into.
+    size_t count,                       ///< [IN] Number of buffers (max UNIXSOCKET_MAX_MSG_VEC).
+    size_t* receivedCountPtr            ///< [OUT] Number of messages received.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    union
+    {
+        struct cmsghdr  header;
+        char            buff[CMSG_BUFF_SIZE];
+    }
+    cmsgBuffers[UNIXSOCKET_MAX_MSG_VEC];
+
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_MSG_VEC];
+    struct iovec ioVectors[UNIXSOCKET_MAX_MSG_VEC];
+    size_t i;
+
+    LE_ASSERT((count > 0) && (count <= UNIXSOCKET_MAX_MSG_VEC));
+
+    *receivedCountPtr = 0;
+    memset(msgHeaders, 0, count * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < count; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        ioVectors[i].iov_base = msgsPtr[i].dataPtr;
+        ioVectors[i].iov_len = msgsPtr[i].dataSize;
+        msgHeaderPtr->msg_iov = &ioVectors[i];
+        msgHeaderPtr->msg_iovlen = 1;
+        msgHeaderPtr->msg_control = cmsgBuffers[i].buff;
+        msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i].buff);
+
+        msgsPtr[i].fd = -1;
+    }
+
+    // Keep trying to receive until we don't get interrupted by a signal.
+    int receivedCount;
+    do
+    {
+        receivedCount = recvmmsg(localSocketFd, msgHeaders, count, MSG_WAITFORONE, NULL);
+    }
+    while ((receivedCount < 0) && (errno == EINTR));
+
+    if (receivedCount < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return LE_WOULD_BLOCK;
+        }
+        else if (errno == ECONNRESET)
+        {
+            return LE_CLOSED;
+        }
+        else
+        {
+            LE_ERROR("recvmmsg() failed with errno %d (%m).", errno);
+            return LE_FAULT;
+        }
+    }
+
+    *receivedCountPtr = receivedCount;
+
+    // Handle each message the same way unixSocket_ReceiveMsg() would.
+    for (i = 0; i < (size_t)receivedCount; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        msgsPtr[i].dataSize = msgHeaders[i].msg_len;
+        msgsPtr[i].result = LE_OK;
+
+        if ((msgHeaderPtr->msg_flags & MSG_CTRUNC) != 0)
+        {
+            // Likely a file descriptor rejected by SMACK.
+            LE_ERROR("Unable to receive fd");
+            msgsPtr[i].result = LE_NOT_PERMITTED;
+        }
+        else if (msgHeaderPtr->msg_controllen > 0)
+        {
+            ExtractAncillaryData(msgHeaderPtr, &msgsPtr[i].fd, NULL);
+        }
+        else if (msgHeaders[i].msg_len == 0)
+        {
+            msgsPtr[i].result = LE_CLOSED;
+        }
+
+        if ((msgsPtr[i].result == LE_OK) && ((msgHeaderPtr->msg_flags & MSG_TRUNC) != 0))
+        {
+            msgsPtr[i].result = LE_NO_MEMORY;
+        }
+    }
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
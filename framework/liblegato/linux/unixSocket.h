@@ -157,6 +157,11 @@
  * - unixSocket_ReceiveMsg() receives a message containing any combination of normal
  *   data, a file descriptor, and authenticated credentials.
  *
+ * - unixSocket_SendMsgVec() and unixSocket_ReceiveMsgVec() send or receive several messages
+ *   (each with data and optionally a file descriptor) in a single system call, using sendmmsg()
+ *   and recvmmsg().  On datagram and sequenced-packet sockets, each message is still delivered
+ *   as a separate packet, so the other end can use either the single or the batched functions.
+ *
  * When file descriptors are sent, they are duplicated in the receiving process as if they had
  * been created using the POSIX dup() function.  This means that they remain open in the sending
  * process and must be closed by the sending process when it doesn't need them anymore.
@@ -519,6 +524,84 @@ le_result_t unixSocket_ReceiveDataMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of messages that can be passed to unixSocket_SendMsgVec() or
+ * unixSocket_ReceiveMsgVec() at once.
+ */
+//--------------------------------------------------------------------------------------------------
+#define UNIXSOCKET_MAX_MSG_VEC  32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * One message to send with unixSocket_SendMsgVec() or receive with unixSocket_ReceiveMsgVec().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*       dataPtr;    ///< Data to send, or buffer to receive data into.
+    size_t      dataSize;   ///< [IN] Bytes to send, or size of the receive buffer.
+                            ///  [OUT] Bytes received.
+    int         fd;         ///< [IN] fd to send, [OUT] fd received.  (-1 = no fd)
+    le_result_t result;     ///< [OUT] Receive only: outcome for this message, as returned by
+                            ///  unixSocket_ReceiveMsg().
+}
+unixSocket_MsgVec_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends several messages, each containing data and optionally a file descriptor, through a
+ * connected Unix domain datagram or sequenced-packet socket in a single system call.
+ *
+ * Messages are sent in order.  If the socket's buffer fills up part way through, the messages
+ * that were sent are reported in sentCountPtr and the rest must be sent later.
+ *
+ * @return
+ * - LE_OK if at least one message was sent.
+ * - LE_NO_MEMORY if the socket is set to non-blocking and none could be sent right now.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ *
+ * @warning DO NOT SEND DIRECTORY FILE DESCRIPTORS.  That can be exploited to break out of chroot()
+ *          jails.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgVec
+(
+    int localSocketFd,                  ///< [IN] fd of the local socket that will be used to send.
+    const unixSocket_MsgVec_t* msgsPtr, ///< [IN] Messages to send.
+    size_t count,                       ///< [IN] Number of messages (max UNIXSOCKET_MAX_MSG_VEC).
+    size_t* sentCountPtr                ///< [OUT] Number of messages sent.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives up to a given number of messages, each containing data and optionally a file
+ * descriptor, through a connected Unix domain datagram or sequenced-packet socket in a single
+ * system call.  Only blocks (on a blocking socket) until the first message arrives.
+ *
+ * The outcome for each received message is stored in its result field (see
+ * unixSocket_ReceiveMsg()).
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgVec
+(
+    int localSocketFd,                  ///< [IN] fd of local socket to receive the messages on.
+    unixSocket_MsgVec_t* msgsPtr,       ///< [IN,OUT] Buffers to receive the messages into.
+    size_t count,                       ///< [IN] Number of buffers (max UNIXSOCKET_MAX_MSG_VEC).
+    size_t* receivedCountPtr            ///< [OUT] Number of messages received.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
@@ -8,6 +8,15 @@
 #include "legato.h"
 #include "log.h"
 
+#if LE_CONFIG_LOG_CALL_SITE_CACHE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log filter generation, checked by the logging macros' call site cache.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED uint32_t _le_log_FilterGeneration = 1;
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize the logging system.  This must be called VERY early in the process initialization.
@@ -22,6 +31,27 @@ void log_Init
     fa_log_Init();
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidates the filter decisions cached at logging call sites.  Must be called after any change
+ * to a log session's filter level.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_InvalidateFilterCache
+(
+    void
+)
+{
+#if LE_CONFIG_LOG_CALL_SITE_CACHE
+    // Release: the new level is visible to anyone who acquires the new generation.
+    if (LE_ATOMIC_ADD_FETCH(&_le_log_FilterGeneration, 1, LE_ATOMIC_ORDER_RELEASE) == 0)
+    {
+        // Skip 0 on wrap-around, since that's what call sites start with.
+        LE_SYNC_BOOL_COMPARE_AND_SWAP(&_le_log_FilterGeneration, 0, 1);
+    }
+#endif
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Convert log level enum values to strings suitable for message logging.
@@ -278,6 +308,12 @@ void _le_LogData
     int     j;
     int     numColumns;
 
+    // Don't format anything that would be filtered out.
+    if ((LE_LOG_LEVEL_FILTER_PTR != NULL) && (level < *LE_LOG_LEVEL_FILTER_PTR))
+    {
+        return;
+    }
+
     for (i = 0; i < dataLength; i += 16)
     {
         numColumns = dataLength - i;
@@ -307,14 +343,8 @@ void _le_LogData
             snprintf(&buffer[51 + j], sizeof(buffer) - (51 + j), "%c", c);
         }
 
-        do
-        {
-            if ((LE_LOG_LEVEL_FILTER_PTR == NULL) || (level >= *LE_LOG_LEVEL_FILTER_PTR))
-            {
-                _le_log_Send(level, NULL, LE_LOG_SESSION, filenamePtr, functionNamePtr,
-                             lineNumber, "%s", buffer);
-            }
-        } while(0);
+        _le_log_Send(level, NULL, LE_LOG_SESSION, filenamePtr, functionNamePtr, lineNumber, "%s",
+                     buffer);
     }
 }
 
@@ -346,6 +376,7 @@ void _le_log_SetFilterLevel
 )
 {
     fa_log_SetFilterLevel(logSession, level);
+    log_InvalidateFilterCache();
 }
 
 //--------------------------------------------------------------------------------------------------
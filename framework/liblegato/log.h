@@ -63,6 +63,17 @@ void log_DisconnectFromControlDaemon
     void
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Invalidates the filter decisions cached at logging call sites.  Must be called after any change
+ * to a log session's filter level.
+ */
+//--------------------------------------------------------------------------------------------------
+void log_InvalidateFilterCache
+(
+    void
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Convert log level enum values to strings suitable for message logging.
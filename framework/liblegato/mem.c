@@ -39,6 +39,25 @@
  * that is unlikely to occur in normal data.  Whenever a block is allocated or released, the guard
  * bands are checked for corruption and any corruption is reported.
  *
+ * PER-THREAD CACHES
+ * =================
+ *
+ * When the @ref MEM_THREAD_CACHE KConfig option is enabled, a pool can be opted into per-thread
+ * caching using le_mem_EnableThreadCache().  Each thread that uses such a pool gets a "magazine"
+ * (a small array of free blocks) for it, stored in the thread's cache set, which is found through
+ * thread-specific data.  Allocations pop from the magazine and releases push onto it without
+ * taking the mutex.  When the magazine is empty it is refilled with half a magazine of blocks
+ * from the pool's free list, and when it is full half of it is spilled back to the free list;
+ * only these batch transfers take the mutex.  Since releases of cached blocks are done without
+ * the mutex, the reference counts of blocks from cached pools are updated atomically.
+ *
+ * Blocks sitting in magazines are off the pool's free list, so they are counted in the pool's
+ * numBlocksInUse.  The pool's numCachedBlocks tracks how many of those are actually free, as of
+ * each magazine's last refill or spill, and allocation counts made from a magazine are folded into
+ * the pool at the same time.  Keeping these in the pool object itself lets the Inspect tool
+ * compute statistics from a copy of the pool.  When a thread exits, its magazines are spilled
+ * back into their pools.
+ *
  * Copyright (C) Sierra Wireless Inc.
  *
  */
@@ -193,6 +212,57 @@ static le_mem_PoolRef_t SubPoolsPool;
 static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;
 
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+//--------------------------------------------------------------------------------------------------
+/**
+ * A thread's cache of free blocks for a single memory pool (a "magazine").
+ *
+ * @note Only ever accessed by the thread that owns it, except at thread exit.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_mem_PoolRef_t poolPtr;           ///< The pool the cached blocks belong to (NULL if unused).
+    size_t           numBlocks;         ///< Number of free blocks currently in the magazine.
+    size_t           numSyncedBlocks;   ///< Value of numBlocks last added to the pool's
+                                        ///  numCachedBlocks.
+#if LE_CONFIG_MEM_POOL_STATS
+    uint64_t         numAllocs;         ///< Allocations not yet added to the pool's statistics.
+#endif
+    MemBlock_t*      blocks[LE_CONFIG_MEM_THREAD_CACHE_SIZE];  ///< The free blocks.
+}
+ThreadCache_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A thread's set of caches, indexed by the pools' threadCacheIndex.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ThreadCache_t caches[LE_CONFIG_MEM_THREAD_CACHE_POOLS];
+}
+ThreadCacheSet_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key used to find the calling thread's cache set.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t ThreadCacheKey;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of pools that have per-thread caches enabled.  Protected by the mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t NumThreadCachePools = 0;
+#endif /* end LE_CONFIG_MEM_THREAD_CACHE */
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Exposing the memory pool list; mainly for the Inspect tool.
@@ -646,6 +716,272 @@ static void InitBlock
 #endif
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prepares a block that has just been taken from a pool for use by its new owner.
+ *
+ * @return A pointer to the user object in the block.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void* InitAllocatedBlock
+(
+    MemBlock_t* blockPtr    ///< [IN] The allocated block.
+)
+{
+    blockPtr->refCount = 1;
+
+    // Return the user object in the block.
+#if LE_CONFIG_USE_GUARD_BAND
+    InitGuardBands(blockPtr);
+    return &blockPtr->data[0].item + GUARD_BAND_SIZE;
+#else
+    return blockPtr->data;
+#endif
+}
+
+
+#if LE_CONFIG_MEM_THREAD_CACHE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the calling thread's cache for a pool, creating the thread's cache set if needed.
+ *
+ * @return Pointer to the cache.
+ */
+//--------------------------------------------------------------------------------------------------
+static ThreadCache_t* GetThreadCache
+(
+    le_mem_PoolRef_t    pool    ///< [IN] Pool with per-thread caches enabled.
+)
+{
+    ThreadCacheSet_t* setPtr = pthread_getspecific(ThreadCacheKey);
+
+    if (setPtr == NULL)
+    {
+        setPtr = calloc(1, sizeof(ThreadCacheSet_t));
+        LE_ASSERT(setPtr);
+        LE_ASSERT(pthread_setspecific(ThreadCacheKey, setPtr) == 0);
+    }
+
+    ThreadCache_t* cachePtr = &setPtr->caches[pool->threadCacheIndex];
+    cachePtr->poolPtr = pool;
+
+    return cachePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Folds a thread cache's block count and statistics into its pool.
+ *
+ * @note Assumes that the mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SyncThreadCache_NoLock
+(
+    ThreadCache_t* cachePtr     ///< [IN] The thread cache.
+)
+{
+    le_mem_PoolRef_t pool = cachePtr->poolPtr;
+
+    pool->numCachedBlocks = pool->numCachedBlocks - cachePtr->numSyncedBlocks
+                                                  + cachePtr->numBlocks;
+    cachePtr->numSyncedBlocks = cachePtr->numBlocks;
+
+#if LE_CONFIG_MEM_POOL_STATS
+    pool->numAllocations += cachePtr->numAllocs;
+    cachePtr->numAllocs = 0;
+
+    // Blocks can be released to a different thread's cache than the one they were allocated from,
+    // so the cached block count can briefly be ahead of the in-use count.
+    if (pool->numBlocksInUse > pool->numCachedBlocks)
+    {
+        size_t numInUse = pool->numBlocksInUse - pool->numCachedBlocks;
+
+        if (numInUse > pool->maxNumBlocksUsed)
+        {
+            pool->maxNumBlocksUsed = numInUse;
+        }
+    }
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves up to half a magazine of free blocks from the pool's free list into a thread cache.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RefillThreadCache
+(
+    ThreadCache_t* cachePtr     ///< [IN] The calling thread's (empty) cache.
+)
+{
+    le_mem_PoolRef_t pool = cachePtr->poolPtr;
+    size_t batchSize = (pool->threadCacheSize + 1) / 2;
+
+    mem_Lock();
+
+    while (cachePtr->numBlocks < batchSize)
+    {
+        le_sls_Link_t* blockLinkPtr = le_sls_Pop(&(pool->freeList));
+
+        if (blockLinkPtr == NULL)
+        {
+            break;
+        }
+
+        cachePtr->blocks[cachePtr->numBlocks++] = CONTAINER_OF(blockLinkPtr,
+                                                               MemBlock_t,
+                                                               data[0].link);
+        pool->numBlocksInUse++;
+    }
+
+    SyncThreadCache_NoLock(cachePtr);
+
+    mem_Unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Moves free blocks from a thread cache back to the pool's free list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SpillThreadCache
+(
+    ThreadCache_t* cachePtr,    ///< [IN] The thread cache.
+    size_t         numBlocks    ///< [IN] Number of blocks to spill.
+)
+{
+    le_mem_PoolRef_t pool = cachePtr->poolPtr;
+
+    mem_Lock();
+
+    while (numBlocks > 0)
+    {
+        MemBlock_t* blockPtr = cachePtr->blocks[--cachePtr->numBlocks];
+
+        blockPtr->data[0].link = LE_SLS_LINK_INIT;
+        le_sls_Stack(&(pool->freeList), &(blockPtr->data[0].link));
+        pool->numBlocksInUse--;
+        numBlocks--;
+    }
+
+    SyncThreadCache_NoLock(cachePtr);
+
+    mem_Unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Returns all of an exiting thread's cached blocks to their pools.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ThreadCacheSetDestructor
+(
+    void* setPtr    ///< [IN] The exiting thread's cache set.
+)
+{
+    ThreadCacheSet_t* cacheSetPtr = setPtr;
+    size_t i;
+
+    for (i = 0; i < LE_CONFIG_MEM_THREAD_CACHE_POOLS; i++)
+    {
+        ThreadCache_t* cachePtr = &cacheSetPtr->caches[i];
+
+        if (cachePtr->poolPtr != NULL)
+        {
+            SpillThreadCache(cachePtr, cachePtr->numBlocks);
+        }
+    }
+
+    free(cacheSetPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a block from the calling thread's cache for a pool, refilling the cache if it is
+ * empty.
+ *
+ * @return
+ *      A pointer to the allocated object, or NULL if both the cache and the pool's free list are
+ *      empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* AllocFromThreadCache
+(
+    le_mem_PoolRef_t    pool    ///< [IN] Pool with per-thread caches enabled.
+)
+{
+    ThreadCache_t* cachePtr = GetThreadCache(pool);
+
+    if (cachePtr->numBlocks == 0)
+    {
+        RefillThreadCache(cachePtr);
+
+        if (cachePtr->numBlocks == 0)
+        {
+            return NULL;
+        }
+    }
+
+#if LE_CONFIG_MEM_POOL_STATS
+    cachePtr->numAllocs++;
+#endif
+
+    return InitAllocatedBlock(cachePtr->blocks[--cachePtr->numBlocks]);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a block from a pool with per-thread caches.  If the block's reference count reaches
+ * zero it is destructed and put into the calling thread's cache, spilling half of the cache back
+ * to the pool if it is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseToThreadCache
+(
+    MemBlock_t* blockPtr,   ///< [IN] The block being released.
+    void*       objPtr      ///< [IN] The user object in the block.
+)
+{
+    le_mem_Pool_t* poolPtr = blockPtr->poolPtr;
+    size_t refCount = LE_ATOMIC_SUB_FETCH(&blockPtr->refCount, 1, LE_ATOMIC_ORDER_ACQ_REL);
+
+    if (refCount == (size_t)-1)
+    {
+        LE_EMERG("Releasing free block.");
+        LE_FATAL("Free block released from pool %p (%s).",
+                 poolPtr,
+                 MEMPOOL_NAME(poolPtr->name));
+    }
+    else if (refCount != 0)
+    {
+        return;
+    }
+
+    if (poolPtr->destructor)
+    {
+        poolPtr->destructor(objPtr);
+    }
+
+    // Get the cache after running the destructor, in case the destructor released other blocks
+    // from this pool.
+    ThreadCache_t* cachePtr = GetThreadCache(poolPtr);
+
+    if (cachePtr->numBlocks >= poolPtr->threadCacheSize)
+    {
+        SpillThreadCache(cachePtr, cachePtr->numBlocks / 2);
+    }
+
+    cachePtr->blocks[cachePtr->numBlocks++] = blockPtr;
+}
+#endif /* end LE_CONFIG_MEM_THREAD_CACHE */
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Log an error message if there is another pool with the same name as a given pool.
@@ -736,6 +1072,10 @@ void mem_Init
                                          LE_CONFIG_MAX_SUB_POOLS_POOL_SIZE,
                                          sizeof(le_mem_Pool_t));
     le_mem_SetDestructor(SubPoolsPool, SubPoolDestructor);
+
+#if LE_CONFIG_MEM_THREAD_CACHE
+    LE_ASSERT(pthread_key_create(&ThreadCacheKey, ThreadCacheSetDestructor) == 0);
+#endif
 }
 
 
@@ -1053,6 +1393,13 @@ void* le_mem_TryAlloc
 {
     LE_ASSERT(pool != NULL);
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+    if (pool->threadCacheSize != 0)
+    {
+        return AllocFromThreadCache(pool);
+    }
+#endif
+
     MemBlock_t* blockPtr = NULL;
     void* userPtr = NULL;
 
@@ -1089,15 +1436,7 @@ void* le_mem_TryAlloc
     }
 #endif
 
-        blockPtr->refCount = 1;
-
-        // Return the user object in the block.
-#if LE_CONFIG_USE_GUARD_BAND
-        InitGuardBands(blockPtr);
-        userPtr = &blockPtr->data[0].item + GUARD_BAND_SIZE;
-#else
-        userPtr = blockPtr->data;
-#endif
+        userPtr = InitAllocatedBlock(blockPtr);
     }
 
     mem_Unlock();
@@ -1327,6 +1666,74 @@ void le_mem_SetNumObjsToForce
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enables per-thread caching of free blocks for a pool.
+ *
+ * @return
+ *      - LE_OK if the per-thread caches were enabled.
+ *      - LE_NOT_PERMITTED if the pool is a sub-pool.
+ *      - LE_NO_MEMORY if the maximum number of pools with per-thread caches has been reached.
+ *      - LE_NOT_IMPLEMENTED if per-thread caches are not supported in this build.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_mem_EnableThreadCache
+(
+    le_mem_PoolRef_t    pool,       ///< [IN] Pool to enable per-thread caches for.
+    size_t              numObjects  ///< [IN] Maximum number of free objects cached per thread.
+)
+{
+    LE_ASSERT(pool != NULL);
+
+#if LE_CONFIG_MEM_THREAD_CACHE
+    le_result_t result = LE_OK;
+
+    // A magazine must be able to hold at least one refill batch plus a released block.
+    if (numObjects < 2)
+    {
+        numObjects = 2;
+    }
+    else if (numObjects > LE_CONFIG_MEM_THREAD_CACHE_SIZE)
+    {
+        numObjects = LE_CONFIG_MEM_THREAD_CACHE_SIZE;
+    }
+
+    mem_Lock();
+
+    if (pool->superPoolPtr != NULL)
+    {
+        LE_ERROR("Sub-pool '%s' can not have per-thread caches.", MEMPOOL_NAME(pool->name));
+        result = LE_NOT_PERMITTED;
+    }
+    else if (pool->threadCacheSize != 0)
+    {
+        // Already enabled; caches are indexed by pool, so just adjust the size.
+        if (numObjects > pool->threadCacheSize)
+        {
+            pool->threadCacheSize = numObjects;
+        }
+    }
+    else if (NumThreadCachePools >= LE_CONFIG_MEM_THREAD_CACHE_POOLS)
+    {
+        LE_WARN("Too many pools with per-thread caches; not caching pool '%s'.",
+                MEMPOOL_NAME(pool->name));
+        result = LE_NO_MEMORY;
+    }
+    else
+    {
+        pool->threadCacheIndex = NumThreadCachePools++;
+        pool->threadCacheSize = numObjects;
+    }
+
+    mem_Unlock();
+
+    return result;
+#else
+    return LE_NOT_IMPLEMENTED;
+#endif
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Releases an object.  If the object's reference count has reached zero, it will be destructed
@@ -1362,6 +1769,14 @@ void le_mem_Release
     CheckGuardBands(blockPtr);
 #endif
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+    if (blockPtr->poolPtr->threadCacheSize != 0)
+    {
+        ReleaseToThreadCache(blockPtr, objPtr);
+        return;
+    }
+#endif
+
     mem_Lock();
 
     switch (blockPtr->refCount)
@@ -1444,6 +1859,16 @@ void le_mem_AddRef
     CheckGuardBands(memBlockPtr);
 #endif
 
+#if LE_CONFIG_MEM_THREAD_CACHE
+    // Blocks from pools with per-thread caches are released without the mutex, so their reference
+    // counts must be updated atomically.
+    if (memBlockPtr->poolPtr->threadCacheSize != 0)
+    {
+        LE_ASSERT(LE_ATOMIC_ADD_FETCH(&memBlockPtr->refCount, 1, LE_ATOMIC_ORDER_RELAXED) > 1);
+        return;
+    }
+#endif
+
     mem_Lock();
 
     LE_ASSERT(memBlockPtr->refCount != 0);
@@ -1529,8 +1954,19 @@ void le_mem_GetStats
     statsPtr->numOverflows = 0;
     statsPtr->maxNumBlocksUsed = 0;
 #endif
-    statsPtr->numFree = pool->totalBlocks - pool->numBlocksInUse;
     statsPtr->numBlocksInUse = pool->numBlocksInUse;
+#if LE_CONFIG_MEM_THREAD_CACHE
+    // Blocks held in per-thread caches are free, even though they are off the pool's free list.
+    if (statsPtr->numBlocksInUse > pool->numCachedBlocks)
+    {
+        statsPtr->numBlocksInUse -= pool->numCachedBlocks;
+    }
+    else
+    {
+        statsPtr->numBlocksInUse = 0;
+    }
+#endif
+    statsPtr->numFree = pool->totalBlocks - statsPtr->numBlocksInUse;
 
     mem_Unlock();
 }
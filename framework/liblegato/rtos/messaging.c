@@ -402,6 +402,61 @@ int le_msg_GetFd
     return msgLocal_GetFd(msgRef);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Allocates a bulk payload buffer for a message.
+ *
+ * @return Always NULL, as bulk payloads are not supported on local sessions.
+ **/
+//--------------------------------------------------------------------------------------------------
+void* le_msg_AllocBulkPayload
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t              size        ///< [in] Size of the bulk payload, in bytes.
+)
+{
+    LE_UNUSED(msgRef);
+    LE_UNUSED(size);
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the bulk payload of a message.
+ *
+ * @return Always NULL, as bulk payloads are not supported on local sessions.
+ **/
+//--------------------------------------------------------------------------------------------------
+const void* le_msg_GetBulkPayloadPtr
+(
+    le_msg_MessageRef_t msgRef,     ///< [in] Reference to the message.
+    size_t*             sizePtr     ///< [out] Size of the bulk payload, in bytes.
+)
+{
+    LE_UNUSED(msgRef);
+
+    *sizePtr = 0;
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the largest bulk payload that can be sent on a session.
+ *
+ * @return Always 0, as bulk payloads are not supported on local sessions.
+ **/
+//--------------------------------------------------------------------------------------------------
+size_t le_msg_GetMaxBulkPayloadSize
+(
+    le_msg_SessionRef_t sessionRef  ///< [in] Reference to the session.
+)
+{
+    LE_UNUSED(sessionRef);
+
+    return 0;
+}
+
 
 //--------------------------------------------------------------------------------------------------
 /**
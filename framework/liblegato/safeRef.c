@@ -36,6 +36,24 @@
 // Offset of index in a safe ref
 #define REF_INDEX_MASK      UINT32_C(0x7FFFFF)
 
+// Offset of slot generation in a safe ref from a read-optimized map
+#define REF_GEN_OFFSET      REF_INDEX_OFFSET
+// Bitmask for slot generation in a safe ref from a read-optimized map
+#define REF_GEN_MASK        UINT32_C(0xFF)
+
+// Offset of slot index in a safe ref from a read-optimized map
+#define REF_SLOT_OFFSET     (REF_GEN_OFFSET + UINT32_C(8))
+// Bitmask for slot index in a safe ref from a read-optimized map
+#define REF_SLOT_MASK       UINT32_C(0x7FFF)
+
+// Slot index used to terminate a read-optimized map's free list
+#define REF_NO_SLOT         UINT32_MAX
+
+// Maximum number of slot chunks in a read-optimized map.  The first chunk holds maxRefs slots and
+// each one after that holds twice as many as the one before, starting from OVERFLOW_BLOCK_SIZE, so
+// this is enough to cover every index allowed by REF_SLOT_MASK whatever maxRefs is.
+#define REF_MAX_CHUNKS      12
+
 // Buffer length for dumping a safe reference
 #define REF_DBG_BUFFER_LENGTH   64
 
@@ -72,6 +90,14 @@ LE_DEFINE_INLINE le_ref_MapRef_t le_ref_CreateMap
 );
 #endif
 
+#if !LE_CONFIG_SAFE_REF_NAMES_ENABLED
+LE_DEFINE_INLINE le_ref_MapRef_t le_ref_CreateReadOptimizedMap
+(
+    const char *name,
+    size_t      maxRefs
+);
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Trace if tracing is enabled for a given reference map.
@@ -98,6 +124,23 @@ struct le_ref_Block
     void                *slots[];   ///< Pointer slots.
 };
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Slot of a read-optimized map.
+ *
+ * The slot's reference doubles as a sequence number for lock-free lookups: it is cleared (by
+ * clearing its safety bit) before the slot is given a new pointer, and only set again afterwards.
+ * A lookup that sees the same reference before and after reading the pointer has read the
+ * pointer that goes with that reference.
+ */
+//--------------------------------------------------------------------------------------------------
+struct le_ref_Slot
+{
+    void        *ptr;       ///< Pointer that the slot's reference maps to.
+    uint32_t     ref;       ///< Slot's reference.  Safety bit clear if the slot is free.
+    uint32_t     nextFree;  ///< Next slot on the free list, if the slot is free.
+};
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Local list of all reference maps created within this process.
@@ -190,6 +233,262 @@ static inline size_t BlockAndSlotToIndex
     return mapRef->maxRefs + (blockNum - 1) * OVERFLOW_BLOCK_SIZE + slotNum;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Determine the chunk number and the slot within that chunk from a read-optimized map's slot
+ *  index.
+ *
+ *  @return The chunk number.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline size_t SlotIndexToChunk
+(
+    le_ref_MapRef_t mapRef,     ///< [IN]   Read-optimized reference map instance.
+    size_t          index,      ///< [IN]   Slot index.
+    size_t         *offsetPtr   ///< [OUT]  Slot within the chunk.
+)
+{
+    size_t overflow;
+    size_t chunk;
+
+    if (index < mapRef->maxRefs)
+    {
+        *offsetPtr = index;
+        return 0;
+    }
+
+    // Overflow chunk n holds OVERFLOW_BLOCK_SIZE << (n - 1) slots.
+    overflow = index - mapRef->maxRefs;
+    chunk = (sizeof(unsigned int) * CHAR_BIT) -
+                __builtin_clz((unsigned int) (overflow / OVERFLOW_BLOCK_SIZE + 1));
+    *offsetPtr = overflow - OVERFLOW_BLOCK_SIZE * (((size_t) 1 << (chunk - 1)) - 1);
+    return chunk;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get a slot of a read-optimized map.  Only for use by functions that modify the map, which must
+ *  not be called concurrently.
+ *
+ *  @return A pointer to the slot.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline struct le_ref_Slot *GetSlot
+(
+    le_ref_MapRef_t mapRef, ///< Read-optimized reference map instance.
+    size_t          index   ///< Slot index (must be less than the map's size).
+)
+{
+    size_t offset;
+    size_t chunk = SlotIndexToChunk(mapRef, index, &offset);
+
+    return &mapRef->chunksPtr[chunk][offset];
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Add a new chunk of slots to a read-optimized map, and put them on the free list.  The free
+ *  list must be empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddChunk
+(
+    le_ref_MapRef_t mapRef  ///< Read-optimized reference map instance.
+)
+{
+    size_t               chunk;
+    size_t               count;
+    size_t               i;
+    size_t               offset;
+    struct le_ref_Slot  *chunkPtr;
+
+    LE_FATAL_IF(mapRef->size > REF_SLOT_MASK,
+        "Safe reference map %s is full (%" PRIuS " references)", SAFEREF_NAME(mapRef->name),
+        mapRef->size);
+
+    chunk = SlotIndexToChunk(mapRef, mapRef->size, &offset);
+    count = (chunk == 0 ? mapRef->maxRefs : (size_t) OVERFLOW_BLOCK_SIZE << (chunk - 1));
+    LE_ASSERT((offset == 0) && (chunk < REF_MAX_CHUNKS));
+
+    chunkPtr = calloc(count, sizeof(*chunkPtr));
+    LE_ASSERT(chunkPtr != NULL);
+
+    // Only link as many slots as there are indices left.
+    for (i = 0; (i < count) && (mapRef->size + i <= REF_SLOT_MASK); ++i)
+    {
+        chunkPtr[i].nextFree = mapRef->size + i + 1;
+    }
+    chunkPtr[i - 1].nextFree = REF_NO_SLOT;
+    mapRef->freeHead = mapRef->size;
+    mapRef->freeTail = mapRef->size + i - 1;
+
+    // Publish the chunk to lock-free lookups.
+    LE_ATOMIC_STORE(&mapRef->chunksPtr[chunk], chunkPtr, LE_ATOMIC_ORDER_RELEASE);
+    mapRef->size += count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Look up a safe reference in a read-optimized map.  This can be called concurrently with
+ *  functions that modify the map.
+ *
+ *  @return The pointer that the safe reference maps to, or NULL if it is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline void *LookupSlot
+(
+    le_ref_MapRef_t  mapRef,    ///< [IN]   Read-optimized reference map instance.
+    const void      *safeRef    ///< [IN]   Safe reference.
+)
+{
+    uintptr_t            ref = (uintptr_t) safeRef;
+    size_t               offset;
+    struct le_ref_Slot  *chunkPtr;
+    struct le_ref_Slot  *slotPtr;
+    void                *ptr;
+
+    if ((ref & (REF_SAFETY_MASK << REF_SAFETY_OFFSET)) == 0)
+    {
+        return NULL;
+    }
+
+    chunkPtr = LE_ATOMIC_LOAD(
+        &mapRef->chunksPtr[SlotIndexToChunk(mapRef, (ref >> REF_SLOT_OFFSET) & REF_SLOT_MASK,
+                                            &offset)],
+        LE_ATOMIC_ORDER_ACQUIRE);
+    if (chunkPtr == NULL)
+    {
+        return NULL;
+    }
+    slotPtr = &chunkPtr[offset];
+
+    // The reference includes the map base and the slot generation, so this one comparison
+    // rejects references from other maps and stale references to reused slots.
+    if (LE_ATOMIC_LOAD(&slotPtr->ref, LE_ATOMIC_ORDER_ACQUIRE) != ref)
+    {
+        return NULL;
+    }
+    ptr = LE_ATOMIC_LOAD(&slotPtr->ptr, LE_ATOMIC_ORDER_RELAXED);
+
+    // If the slot was freed (and perhaps reused) while reading the pointer, the reference has
+    // changed.
+    LE_ATOMIC_FENCE(LE_ATOMIC_ORDER_ACQUIRE);
+    if (LE_ATOMIC_LOAD(&slotPtr->ref, LE_ATOMIC_ORDER_RELAXED) != ref)
+    {
+        return NULL;
+    }
+
+    return ptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the slot of a read-optimized map that a safe reference refers to.  Only for use by
+ *  functions that modify the map.
+ *
+ *  @return A pointer to the slot, or NULL if the reference is invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct le_ref_Slot *FindOptimizedSlot
+(
+    le_ref_MapRef_t  mapRef,    ///< [IN]   Read-optimized reference map instance.
+    const void      *safeRef    ///< [IN]   Safe reference.
+)
+{
+    uintptr_t            ref = (uintptr_t) safeRef;
+    size_t               index = (ref >> REF_SLOT_OFFSET) & REF_SLOT_MASK;
+    struct le_ref_Slot  *slotPtr;
+
+    if (((ref & (REF_SAFETY_MASK << REF_SAFETY_OFFSET)) == 0) || (index >= mapRef->size))
+    {
+        return NULL;
+    }
+
+    slotPtr = GetSlot(mapRef, index);
+    return (slotPtr->ref == ref ? slotPtr : NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Store a pointer in a free slot of a read-optimized map.
+ *
+ *  @return The new safe reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *CreateOptimizedRef
+(
+    le_ref_MapRef_t  mapRef,    ///< [IN]   Read-optimized reference map instance.
+    void            *ptr        ///< [IN]   Pointer to store.
+)
+{
+    uint32_t             index;
+    uint32_t             generation;
+    uint32_t             ref;
+    struct le_ref_Slot  *slotPtr;
+
+    if (mapRef->freeHead == REF_NO_SLOT)
+    {
+        AddChunk(mapRef);
+        LE_WARN("Safe reference map maximum exceeded for %s, new size %" PRIuS,
+                SAFEREF_NAME(mapRef->name), mapRef->size);
+        mapRef->index = mapRef->size;
+    }
+
+    // Slots are reused oldest-freed first, to make it as unlikely as possible that a stale
+    // reference is still around when its slot's generation wraps.
+    index = mapRef->freeHead;
+    slotPtr = GetSlot(mapRef, index);
+    mapRef->freeHead = slotPtr->nextFree;
+    if (mapRef->freeHead == REF_NO_SLOT)
+    {
+        mapRef->freeTail = REF_NO_SLOT;
+    }
+
+    generation = ((slotPtr->ref >> REF_GEN_OFFSET) + 1) & REF_GEN_MASK;
+    ref = (REF_SAFETY_MASK << REF_SAFETY_OFFSET) |
+          ((mapRef->mapBase & REF_BASE_MASK) << REF_BASE_OFFSET) |
+          (generation << REF_GEN_OFFSET) |
+          (index << REF_SLOT_OFFSET);
+
+    // The slot's old reference was cleared when it was freed.  Make sure that is seen before the
+    // new pointer, and the new pointer before the new reference.
+    LE_ATOMIC_FENCE(LE_ATOMIC_ORDER_RELEASE);
+    LE_ATOMIC_STORE(&slotPtr->ptr, ptr, LE_ATOMIC_ORDER_RELAXED);
+    LE_ATOMIC_STORE(&slotPtr->ref, ref, LE_ATOMIC_ORDER_RELEASE);
+
+    return (void *) (uintptr_t) ref;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Free a slot of a read-optimized map.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FreeOptimizedSlot
+(
+    le_ref_MapRef_t      mapRef,    ///< [IN]   Read-optimized reference map instance.
+    struct le_ref_Slot  *slotPtr    ///< [IN]   Slot to free.
+)
+{
+    uint32_t index = (slotPtr->ref >> REF_SLOT_OFFSET) & REF_SLOT_MASK;
+
+    // Keep the generation for when the slot is reused.
+    LE_ATOMIC_STORE(&slotPtr->ref, slotPtr->ref & ~(REF_SAFETY_MASK << REF_SAFETY_OFFSET),
+                    LE_ATOMIC_ORDER_RELAXED);
+    LE_ATOMIC_STORE(&slotPtr->ptr, NULL, LE_ATOMIC_ORDER_RELAXED);
+
+    slotPtr->nextFree = REF_NO_SLOT;
+    if (mapRef->freeTail == REF_NO_SLOT)
+    {
+        mapRef->freeHead = index;
+    }
+    else
+    {
+        GetSlot(mapRef, mapRef->freeTail)->nextFree = index;
+    }
+    mapRef->freeTail = index;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Initialize a reference map instance.
@@ -346,8 +645,19 @@ const char *DebugSafeRef
     size_t      slot;
     uint32_t    base;
 
-    valid = ReadRef(mapRef, ref, &blockNum, &slot);
     base = (uint32_t) ((uintptr_t) ref >> REF_BASE_OFFSET) & REF_BASE_MASK;
+    if (mapRef->chunksPtr != NULL)
+    {
+        valid = (FindOptimizedSlot(mapRef, ref) != NULL);
+        snprintf(buffer, REF_DBG_BUFFER_LENGTH,
+            "<%p>(Bm:%" PRIX32 " Br:%" PRIX32 " G:%" PRIu32 " I:%" PRIu32 " V:%c)",
+            ref, mapRef->mapBase, base,
+            (uint32_t) ((uintptr_t) ref >> REF_GEN_OFFSET) & REF_GEN_MASK,
+            (uint32_t) ((uintptr_t) ref >> REF_SLOT_OFFSET) & REF_SLOT_MASK, (valid ? 'T' : 'F'));
+        return buffer;
+    }
+
+    valid = ReadRef(mapRef, ref, &blockNum, &slot);
     snprintf(buffer, REF_DBG_BUFFER_LENGTH,
         "<%p>(Bm:%" PRIX32 " Br:%" PRIX32 " N:%" PRIuS " S:%" PRIuS " V:%c)",
         ref, mapRef->mapBase, base, blockNum, slot, (valid ? 'T' : 'F'));
@@ -375,6 +685,34 @@ static struct le_ref_Block *NewOverflowBlock
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the Safe Reference for a given index in a map, for iteration.
+ *
+ * @return The Safe Reference, or NULL if nothing is stored at that index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *IndexToRef
+(
+    le_ref_MapRef_t  mapRef,    ///< [IN]   Reference map instance.
+    size_t           index      ///< [IN]   Index (must be less than the map's size).
+)
+{
+    void    **slot;
+    void     *ref;
+
+    if (mapRef->chunksPtr != NULL)
+    {
+        ref = (void *) (uintptr_t) GetSlot(mapRef, index)->ref;
+        return (((uintptr_t) ref & (REF_SAFETY_MASK << REF_SAFETY_OFFSET)) ? ref : NULL);
+    }
+
+    ref = MakeRef(mapRef->mapBase, index);
+    slot = FindSlot(mapRef, ref);
+    return ((slot != NULL && *slot != NULL) ? ref : NULL);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Translates a Safe Reference back into the pointer that was given when the Safe Reference
@@ -398,6 +736,14 @@ static void *Lookup
     SAFE_REF_TRACE(mapRef, "Looking up safe reference %s in %s",
         DebugSafeRef(mapRef, safeRef, buffer), SAFEREF_NAME(mapRef->name));
 
+    if (mapRef->chunksPtr != NULL)
+    {
+        void *ptr = LookupSlot(mapRef, safeRef);
+
+        SAFE_REF_TRACE(mapRef, "    Found entry %p", ptr);
+        return ptr;
+    }
+
     result = FindSlot(mapRef, safeRef);
     if (result == NULL)
     {
@@ -478,6 +824,54 @@ le_ref_MapRef_t _le_ref_CreateMap
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a read-optimized Reference Map.
+ *
+ * @return A reference to the Reference Map object.
+ */
+//--------------------------------------------------------------------------------------------------
+#if LE_CONFIG_SAFE_REF_NAMES_ENABLED
+le_ref_MapRef_t le_ref_CreateReadOptimizedMap
+(
+    const char      *name,      ///< Name of the map (for diagnostics).
+    size_t           maxRefs    ///< Maximum number of Safe References expected to be kept in this
+                                ///  Reference Map at any one time.
+)
+#else
+le_ref_MapRef_t _le_ref_CreateReadOptimizedMap
+(
+    size_t           maxRefs    ///< Maximum number of Safe References expected to be kept in this
+                                ///  Reference Map at any one time.
+)
+#endif
+{
+    le_ref_MapRef_t mapPtr = calloc(1, sizeof(*mapPtr));
+
+    LE_ASSERT(mapPtr != NULL);
+
+#if LE_CONFIG_SAFE_REF_NAMES_ENABLED
+    InitMap(name, maxRefs, mapPtr, NULL);
+#else
+    InitMap(maxRefs, mapPtr, NULL);
+#endif
+
+    mapPtr->chunksPtr = calloc(REF_MAX_CHUNKS, sizeof(*mapPtr->chunksPtr));
+    LE_ASSERT(mapPtr->chunksPtr != NULL);
+
+    mapPtr->size = 0;
+    mapPtr->freeHead = REF_NO_SLOT;
+    mapPtr->freeTail = REF_NO_SLOT;
+    if (maxRefs > 0)
+    {
+        AddChunk(mapPtr);
+    }
+    mapPtr->index = mapPtr->size;
+
+    return mapPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a Safe Reference, storing a mapping between that reference and a given pointer for
@@ -510,6 +904,12 @@ void *le_ref_CreateRef
         goto end;
     }
 
+    if (mapRef->chunksPtr != NULL)
+    {
+        result = CreateOptimizedRef(mapRef, ptr);
+        goto end;
+    }
+
     block = mapRef->blocksPtr;
     for (i = 0; i < blockCount; ++i)
     {
@@ -594,6 +994,22 @@ void le_ref_DeleteRef
     SAFE_REF_TRACE(mapRef, "Deleting safe reference %s in %s",
         DebugSafeRef(mapRef, safeRef, buffer), SAFEREF_NAME(mapRef->name));
 
+    if (mapRef->chunksPtr != NULL)
+    {
+        struct le_ref_Slot *slotPtr = FindOptimizedSlot(mapRef, safeRef);
+
+        if (slotPtr == NULL)
+        {
+            LE_ERROR("Deleting non-existent Safe Reference %p from Map '%s'.", safeRef,
+                SAFEREF_NAME(mapRef->name));
+        }
+        else
+        {
+            FreeOptimizedSlot(mapRef, slotPtr);
+        }
+        return;
+    }
+
     slot = FindSlot(mapRef, safeRef);
     if (slot == NULL || *slot == NULL)
     {
@@ -645,7 +1061,6 @@ le_result_t le_ref_NextNode
 )
 {
     le_ref_MapRef_t   mapRef = (le_ref_MapRef_t) iteratorRef;
-    void            **slot;
 
     SAFE_REF_TRACE(mapRef, "Continuing iteration in %s", SAFEREF_NAME(mapRef->name));
 
@@ -662,8 +1077,7 @@ le_result_t le_ref_NextNode
 
     while (mapRef->index < mapRef->size)
     {
-        slot = FindSlot(mapRef, MakeRef(mapRef->mapBase, mapRef->index));
-        if (slot != NULL && *slot != NULL)
+        if (IndexToRef(mapRef, mapRef->index) != NULL)
         {
             SAFE_REF_TRACE(mapRef, "    Found next item at index %" PRIuS, mapRef->index);
             mapRef->advance = true;
@@ -700,6 +1114,10 @@ const void* le_ref_GetSafeRef
 
     if (mapRef->index < mapRef->size)
     {
+        if (mapRef->chunksPtr != NULL)
+        {
+            return IndexToRef(mapRef, mapRef->index);
+        }
         return MakeRef(mapRef->mapBase, mapRef->index);
     }
 
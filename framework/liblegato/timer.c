@@ -118,6 +118,10 @@ static Timer_t* CreateTimer
     timerPtr->repeatCount = 1;
     timerPtr->contextPtr = NULL;
     timerPtr->link = LE_DLS_LINK_INIT;
+    timerPtr->heapChildPtr = NULL;
+    timerPtr->heapNextPtr = NULL;
+    timerPtr->heapPrevPtr = NULL;
+    timerPtr->startSeq = 0;
     timerPtr->isActive = false;
     timerPtr->expiryTime = (le_clk_Time_t){0, 0};
     timerPtr->expiryCount = 0;
@@ -132,53 +136,150 @@ static Timer_t* CreateTimer
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add the timer record to the given list, sorted according to the timer value
+ * Check whether a timer should expire before another one.
+ *
+ * Timers with equal expiry times expire in the order they were started.
+ *
+ * @return true if aPtr expires before bPtr.
  */
 //--------------------------------------------------------------------------------------------------
-static void AddToTimerList
+static inline bool IsBefore
 (
-    le_dls_List_t* listPtr,               ///< [IN] The list to add to.
-    Timer_t* newTimerPtr                  ///< [IN] The timer to add
+    const Timer_t* aPtr,    ///< [IN] A timer.
+    const Timer_t* bPtr     ///< [IN] Another timer.
 )
 {
-    Timer_t* timerPtr;
-    le_dls_Link_t* linkPtr;
+    if (le_clk_Equal(aPtr->expiryTime, bPtr->expiryTime))
+    {
+        return (aPtr->startSeq < bPtr->startSeq);
+    }
 
-    if ( newTimerPtr->isActive )
+    return le_clk_GreaterThan(bPtr->expiryTime, aPtr->expiryTime);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Meld two timer heaps.
+ *
+ * The active timers of each thread are kept in a pairing heap.  Each timer in the heap points at
+ * its leftmost child and its next sibling; the previous pointer of a timer refers to its previous
+ * sibling or, for the leftmost child, to its parent, so that any timer can be unlinked in O(1).
+ *
+ * @return The root of the melded heap.
+ */
+//--------------------------------------------------------------------------------------------------
+static Timer_t* MeldTimerHeaps
+(
+    Timer_t* aPtr,          ///< [IN] Root of a heap, with no siblings (may be NULL).
+    Timer_t* bPtr           ///< [IN] Root of another heap, with no siblings (may be NULL).
+)
+{
+    if (aPtr == NULL)
     {
-        LE_ERROR("Timer '%s' is already active", TIMER_NAME(newTimerPtr->name));
-        return;
+        return bPtr;
+    }
+    if (bPtr == NULL)
+    {
+        return aPtr;
     }
 
-    // Get the start of the list
-    linkPtr = le_dls_Peek(listPtr);
+    if (IsBefore(bPtr, aPtr))
+    {
+        Timer_t* tempPtr = aPtr;
+        aPtr = bPtr;
+        bPtr = tempPtr;
+    }
 
-    // Find the timer whose expiry time is greater than the new timer.
-    while ( linkPtr != NULL )
+    // Make the later root the leftmost child of the earlier one.
+    bPtr->heapPrevPtr = aPtr;
+    bPtr->heapNextPtr = aPtr->heapChildPtr;
+    if (aPtr->heapChildPtr != NULL)
     {
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
+        aPtr->heapChildPtr->heapPrevPtr = bPtr;
+    }
+    aPtr->heapChildPtr = bPtr;
+
+    return aPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Combine a list of sibling sub-heaps into a single heap, using the standard two-pass pairing.
+ *
+ * @return The root of the combined heap, or NULL if the list was empty.
+ */
+//--------------------------------------------------------------------------------------------------
+static Timer_t* MergeTimerHeapPairs
+(
+    Timer_t* firstPtr       ///< [IN] First of the sibling sub-heaps (may be NULL).
+)
+{
+    Timer_t* pairsPtr = NULL;
+    Timer_t* rootPtr = NULL;
 
-        if ( le_clk_GreaterThan(timerPtr->expiryTime, newTimerPtr->expiryTime) )
+    // First pass: meld siblings pairwise from left to right, stacking the results.
+    while (firstPtr != NULL)
+    {
+        Timer_t* aPtr = firstPtr;
+        Timer_t* bPtr = aPtr->heapNextPtr;
+
+        firstPtr = (bPtr != NULL) ? bPtr->heapNextPtr : NULL;
+
+        aPtr->heapNextPtr = NULL;
+        aPtr->heapPrevPtr = NULL;
+        if (bPtr != NULL)
         {
-            break;
+            bPtr->heapNextPtr = NULL;
+            bPtr->heapPrevPtr = NULL;
         }
 
-        linkPtr = le_dls_PeekNext(listPtr, linkPtr);
+        Timer_t* pairPtr = MeldTimerHeaps(aPtr, bPtr);
+        pairPtr->heapNextPtr = pairsPtr;
+        pairsPtr = pairPtr;
     }
 
-    TimerListChangeCount++;
-    if (linkPtr == NULL)
+    // Second pass: meld the stacked pairs from right to left.
+    while (pairsPtr != NULL)
     {
-        // The list is either empty, or the new timer has the largest expiry time.
-        // In either case, add the new timer to the end of the list.
-        le_dls_Queue(listPtr, &newTimerPtr->link);
+        Timer_t* nextPtr = pairsPtr->heapNextPtr;
+
+        pairsPtr->heapNextPtr = NULL;
+        rootPtr = MeldTimerHeaps(rootPtr, pairsPtr);
+        pairsPtr = nextPtr;
     }
-    else
+
+    return rootPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add the timer record to the given thread's active timers, ordered according to the timer value.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToTimerList
+(
+    timer_ThreadRec_t* threadRecPtr,      ///< [IN] The thread's timer record.
+    Timer_t* newTimerPtr                  ///< [IN] The timer to add
+)
+{
+    if ( newTimerPtr->isActive )
     {
-        // Found a timer with larger expiry time; insert the new timer before it.
-        le_dls_AddBefore(listPtr, linkPtr, &newTimerPtr->link);
+        LE_ERROR("Timer '%s' is already active", TIMER_NAME(newTimerPtr->name));
+        return;
     }
 
+    newTimerPtr->startSeq = threadRecPtr->startCount++;
+    newTimerPtr->heapChildPtr = NULL;
+    newTimerPtr->heapNextPtr = NULL;
+    newTimerPtr->heapPrevPtr = NULL;
+    threadRecPtr->heapRootPtr = MeldTimerHeaps(threadRecPtr->heapRootPtr, newTimerPtr);
+
+    TimerListChangeCount++;
+    le_dls_Queue(&threadRecPtr->activeTimerList, &newTimerPtr->link);
+
     // The new timer is now on the active list
     newTimerPtr->isActive = true;
 }
@@ -186,76 +287,92 @@ static void AddToTimerList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Peek at the first timer from the given timer list
+ * Peek at the first timer to expire from the given thread's active timers
  *
  * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ *      - pointer to the first timer to expire
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
-static Timer_t* PeekFromTimerList
+static inline Timer_t* PeekFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
 )
 {
-    le_dls_Link_t* linkPtr;
-
-    linkPtr = le_dls_Peek(listPtr);
-    if (linkPtr != NULL)
-    {
-        return ( CONTAINER_OF(linkPtr, Timer_t, link) );
-    }
-    return NULL;
+    return threadRecPtr->heapRootPtr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Pop the first timer from the given timer list
- *
- * @return:
- *      - pointer to the first timer on the list
- *      - NULL if the list is empty
+ * Remove the timer from the given thread's active timers
  */
 //--------------------------------------------------------------------------------------------------
-static Timer_t* PopFromTimerList
+static void RemoveFromTimerList
 (
-    le_dls_List_t* listPtr              ///< [IN] The list to look at.
+    timer_ThreadRec_t* threadRecPtr,    ///< [IN] The thread's timer record.
+    Timer_t* timerPtr                   ///< [IN] The timer to remove
 )
 {
-    le_dls_Link_t* linkPtr;
-    Timer_t* timerPtr;
+    Timer_t* subHeapPtr = MergeTimerHeapPairs(timerPtr->heapChildPtr);
 
-    linkPtr = le_dls_Pop(listPtr);
-    if (linkPtr != NULL)
+    if (timerPtr == threadRecPtr->heapRootPtr)
     {
-        TimerListChangeCount++;
-        timerPtr = CONTAINER_OF(linkPtr, Timer_t, link);
-
-        // The timer is no longer on the active list
-        timerPtr->isActive = false;
+        threadRecPtr->heapRootPtr = subHeapPtr;
+    }
+    else
+    {
+        // Unlink the timer from its siblings (or its parent, if it is the leftmost child), then
+        // meld its children back into the heap.
+        if (timerPtr->heapPrevPtr->heapChildPtr == timerPtr)
+        {
+            timerPtr->heapPrevPtr->heapChildPtr = timerPtr->heapNextPtr;
+        }
+        else
+        {
+            timerPtr->heapPrevPtr->heapNextPtr = timerPtr->heapNextPtr;
+        }
+        if (timerPtr->heapNextPtr != NULL)
+        {
+            timerPtr->heapNextPtr->heapPrevPtr = timerPtr->heapPrevPtr;
+        }
 
-        return timerPtr;
+        threadRecPtr->heapRootPtr = MeldTimerHeaps(threadRecPtr->heapRootPtr, subHeapPtr);
     }
-    return NULL;
+
+    timerPtr->heapChildPtr = NULL;
+    timerPtr->heapNextPtr = NULL;
+    timerPtr->heapPrevPtr = NULL;
+
+    // Remove the timer from the active list
+    timerPtr->isActive = false;
+    TimerListChangeCount++;
+    le_dls_Remove(&threadRecPtr->activeTimerList, &timerPtr->link);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Remove the timer from the given timer list
+ * Pop the first timer to expire from the given thread's active timers
+ *
+ * @return:
+ *      - pointer to the first timer to expire
+ *      - NULL if there are no active timers
  */
 //--------------------------------------------------------------------------------------------------
-static void RemoveFromTimerList
+static Timer_t* PopFromTimerList
 (
-    le_dls_List_t* listPtr,             ///< [IN] The list to look at.
-    Timer_t* timerPtr                   ///< [IN] The timer to remove
+    timer_ThreadRec_t* threadRecPtr     ///< [IN] The thread's timer record.
 )
 {
-    // Remove the timer from the active list
-    timerPtr->isActive = false;
-    TimerListChangeCount++;
-    le_dls_Remove(listPtr, &timerPtr->link);
+    Timer_t* timerPtr = threadRecPtr->heapRootPtr;
+
+    if (timerPtr != NULL)
+    {
+        RemoveFromTimerList(threadRecPtr, timerPtr);
+    }
+
+    return timerPtr;
 }
 
 
@@ -324,11 +441,11 @@ static void RunTimer
 
     Timer_t* firstTimerPtr;
 
-    AddToTimerList(&threadRecPtr->activeTimerList, timerPtr);
+    AddToTimerList(threadRecPtr, timerPtr);
 
     // Get the first timer from the active list. This is needed to determine whether the timer
     // needs to be restarted, in case the new timer was put at the beginning of the list.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PeekFromTimerList(threadRecPtr);
 
     // If the timer is not running, or it is running a timer that is no longer at the beginning
     // of the active list, then (re)start the timer.
@@ -353,7 +470,7 @@ static void StopTimer
 {
     timer_ThreadRec_t* threadRecPtr = fa_timer_GetThreadTimerRec(timerPtr);
 
-    RemoveFromTimerList(&threadRecPtr->activeTimerList, timerPtr);
+    RemoveFromTimerList(threadRecPtr, timerPtr);
 
     // If the timer was at the start of the active list, then restart the timerFD using the next
     // timer on the active list, if any.  Otherwise, stop the timerFD.
@@ -362,7 +479,7 @@ static void StopTimer
         TRACE("Stopping the first active timer");
         threadRecPtr->firstTimerPtr = NULL;
 
-        Timer_t* firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+        Timer_t* firstTimerPtr = PeekFromTimerList(threadRecPtr);
         if (firstTimerPtr != NULL)
         {
             RestartTimerPhys(firstTimerPtr);
@@ -406,8 +523,7 @@ static void ProcessExpiredTimer
         expiredTimer->expiryTime = le_clk_Add(expiredTimer->expiryTime, expiredTimer->interval);
 
         // Add the timer back to the timer list
-        AddToTimerList(&threadRecPtr->activeTimerList, expiredTimer);
-        //PrintTimerList(&threadRecPtr->activeTimerList);
+        AddToTimerList(threadRecPtr, expiredTimer);
     }
 
     // call the optional expiry handler function
@@ -454,7 +570,7 @@ void timer_Handler
     Timer_t* firstTimerPtr;
 
     // Pop off the first timer from the active list, and make sure it is the expected timer.
-    firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PopFromTimerList(threadRecPtr);
     LE_ASSERT( NULL != firstTimerPtr);
 
     LE_ASSERT( threadRecPtr->firstTimerPtr == firstTimerPtr );
@@ -469,17 +585,17 @@ void timer_Handler
 
     // Check if there are any other timers that have since expired, pop them off the
     // list and process them.
-    firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+    firstTimerPtr = PeekFromTimerList(threadRecPtr);
     while ( firstTimerPtr != NULL &&
             le_clk_GreaterThan(clk_GetRelativeTime(firstTimerPtr->isWakeupEnabled),
                                firstTimerPtr->expiryTime) )
     {
         // Pop off the timer and process it
-        firstTimerPtr = PopFromTimerList(&threadRecPtr->activeTimerList);
+        firstTimerPtr = PopFromTimerList(threadRecPtr);
         ProcessExpiredTimer(firstTimerPtr);
 
         // Try the next timer on the list
-        firstTimerPtr = PeekFromTimerList(&threadRecPtr->activeTimerList);
+        firstTimerPtr = PeekFromTimerList(threadRecPtr);
     }
 
     // While processing expired timers in the above loop, it is possible that a timer was started,
@@ -567,6 +683,8 @@ timer_ThreadRec_t *timer_InitThread
     threadRecPtr = fa_timer_InitThread(timerType, threadPtr);
 
     threadRecPtr->activeTimerList = LE_DLS_LIST_INIT;
+    threadRecPtr->heapRootPtr = NULL;
+    threadRecPtr->startCount = 0;
     threadRecPtr->firstTimerPtr = NULL;
 
     return threadRecPtr;
@@ -620,6 +738,7 @@ void timer_DestructThread
 
             le_mem_Release(timerPtr);
         }
+        threadRecPtr->heapRootPtr = NULL;
         fa_timer_DestructThread(threadRecPtr);
     }
 }
@@ -6,6 +6,93 @@
 
 #include "legato.h"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer used to exercise the multi-byte code paths.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LONG_DATA_SIZE  4099
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bit-at-a-time reference CRC-32, used to check the optimized implementations.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ReferenceCrc32
+(
+    const uint8_t*  dataPtr,
+    size_t          size,
+    uint32_t        crc
+)
+{
+    int bit;
+
+    while (size-- > 0)
+    {
+        crc ^= *dataPtr++;
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return crc;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check le_crc_Crc32() against the reference over many lengths and alignments of a long buffer,
+ * and le_crc_Crc32Chunks() against le_crc_Crc32() for the same data split into pieces.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestLongBuffers
+(
+    void
+)
+{
+    static uint8_t  longData[LONG_DATA_SIZE];
+    size_t          i;
+    size_t          offset;
+    size_t          size;
+    bool            isMatch = true;
+
+    for (i = 0; i < sizeof(longData); i++)
+    {
+        longData[i] = (uint8_t)((i * 7919) >> 3);
+    }
+
+    for (offset = 0; (offset < 16) && isMatch; offset++)
+    {
+        // Every short length, then a sample of longer ones to keep the run time reasonable.
+        for (size = 0;
+             (size <= sizeof(longData) - offset) && isMatch;
+             size += ((size < 256) ? 1 : 61))
+        {
+            uint32_t crc = le_crc_Crc32(longData + offset, size, LE_CRC_START_CRC32);
+            uint32_t expected = ReferenceCrc32(longData + offset, size, LE_CRC_START_CRC32);
+
+            if (crc != expected)
+            {
+                LE_TEST_INFO("Mismatch at offset %" PRIuS ", size %" PRIuS ": 0x%08" PRIX32
+                             " != 0x%08" PRIX32, offset, size, crc, expected);
+                isMatch = false;
+            }
+        }
+    }
+    LE_TEST_OK(isMatch, "Verified CRC over various lengths and alignments");
+
+    le_crc_Chunk_t chunks[] =
+    {
+        { longData,         3 },
+        { longData + 3,     0 },
+        { longData + 3,     1000 },
+        { longData + 1003,  sizeof(longData) - 1003 }
+    };
+    uint32_t crc = le_crc_Crc32Chunks(chunks, NUM_ARRAY_MEMBERS(chunks), LE_CRC_START_CRC32);
+    uint32_t expected = le_crc_Crc32(longData, sizeof(longData), LE_CRC_START_CRC32);
+    LE_TEST_OK(crc == expected, "Verified chunked CRC (0x%08" PRIX32 ") is valid (0x%08" PRIX32 ")",
+        crc, expected);
+}
+
 COMPONENT_INIT
 {
     uint32_t    crc;
@@ -20,9 +107,9 @@ COMPONENT_INIT
                 };
     uint8_t     data3[2] = { 0x00, 0x00 };
 
-    LE_TEST_PLAN(3); // Indicate that there are 3 test cases in this app.
+    LE_TEST_PLAN(5); // Indicate that there are 5 test cases in this app.
 
-    // Execute the 3 test cases.
+    // Execute the 5 test cases.
     crc = le_crc_Crc32(data1, sizeof(data1), LE_CRC_START_CRC32);
     expected = ~0x7F34014E;
     LE_TEST_OK(crc == expected, "Verified initial CRC (0x%08" PRIX32 ") is valid (0x%08" PRIX32 ")",
@@ -38,6 +125,8 @@ COMPONENT_INIT
     LE_TEST_OK(crc == expected, "Verified final CRC (0x%08" PRIX32 ") is valid (0x%08" PRIX32 ")",
         crc, expected);
 
+    TestLongBuffers();
+
     // End the test sequence.
     LE_TEST_EXIT;
 }
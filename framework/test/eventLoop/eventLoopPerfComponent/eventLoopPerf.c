@@ -0,0 +1,240 @@
+/**
+ * Cross-thread event throughput benchmark.
+ *
+ * Several producer threads feed a single consumer thread's event loop as fast as they can, first
+ * with le_event_QueueFunctionToThread() and then with le_event_Report().  The consumer checks
+ * that each producer's reports arrive complete and in order, and the rate of each run is
+ * reported in events/s.
+ *
+ * To bound memory use, each producer waits for the consumer to catch up after every window of
+ * reports.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#define NUM_PRODUCERS           4
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define EVENTS_PER_PRODUCER  10000
+#   define WINDOW_SIZE          100
+#else
+#   define EVENTS_PER_PRODUCER  250000
+#   define WINDOW_SIZE          1000
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report sent by a producer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t producer;  ///< Index of the producer.
+    uint32_t sequence;  ///< Producer's sequence number.
+}
+PerfReport_t;
+
+/// Method used by the producers to send to the consumer.
+typedef enum
+{
+    METHOD_QUEUE_FUNCTION,
+    METHOD_REPORT
+}
+Method_t;
+
+static Method_t Method;                             ///< Method used by the current run.
+static le_thread_Ref_t ConsumerThread;              ///< Thread receiving the events.
+static le_event_Id_t EventId;                       ///< Event reported by the producers.
+static le_sem_Ref_t ReadySem;                       ///< Posted when the consumer is running.
+static le_sem_Ref_t DoneSem;                        ///< Posted when a producer is done.
+static le_sem_Ref_t WindowSems[NUM_PRODUCERS];      ///< Posted when a producer's window is done.
+static uint32_t ReceivedCounts[NUM_PRODUCERS];      ///< Events received from each producer.
+static bool IsInOrder;                              ///< All events received in order so far.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Account for an event received by the consumer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Receive
+(
+    uint32_t producer,
+    uint32_t sequence
+)
+{
+    if (sequence != ReceivedCounts[producer])
+    {
+        IsInOrder = false;
+    }
+    ReceivedCounts[producer]++;
+
+    if ((ReceivedCounts[producer] % WINDOW_SIZE) == 0)
+    {
+        le_sem_Post(WindowSems[producer]);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queued function run by the consumer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueuedFunction
+(
+    void *param1Ptr,
+    void *param2Ptr
+)
+{
+    Receive((uint32_t)(uintptr_t)param1Ptr, (uint32_t)(uintptr_t)param2Ptr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handler run by the consumer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EventHandler
+(
+    void *reportPtr
+)
+{
+    PerfReport_t *perfReportPtr = reportPtr;
+
+    Receive(perfReportPtr->producer, perfReportPtr->sequence);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function for the consumer thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *ConsumerThreadMain
+(
+    void *contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    le_event_AddHandler("PerfHandler", EventId, EventHandler);
+    le_sem_Post(ReadySem);
+
+    le_event_RunLoop();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function for the producer threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *ProducerThreadMain
+(
+    void *contextPtr
+)
+{
+    uint32_t producer = (uint32_t)(uintptr_t)contextPtr;
+    uint32_t sequence;
+
+    for (sequence = 0; sequence < EVENTS_PER_PRODUCER; sequence++)
+    {
+        if (Method == METHOD_QUEUE_FUNCTION)
+        {
+            le_event_QueueFunctionToThread(ConsumerThread,
+                                           QueuedFunction,
+                                           (void *)(uintptr_t)producer,
+                                           (void *)(uintptr_t)sequence);
+        }
+        else
+        {
+            PerfReport_t report = { producer, sequence };
+
+            le_event_Report(EventId, &report, sizeof(report));
+        }
+
+        if (((sequence + 1) % WINDOW_SIZE) == 0)
+        {
+            le_sem_Wait(WindowSems[producer]);
+        }
+    }
+
+    le_sem_Post(DoneSem);
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run all the producers using a given method, and report the event rate.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunTest
+(
+    Method_t    method,
+    const char *namePtr
+)
+{
+    uint32_t i;
+    bool isComplete = true;
+
+    Method = method;
+    IsInOrder = true;
+    memset(ReceivedCounts, 0, sizeof(ReceivedCounts));
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+    {
+        le_thread_Start(le_thread_Create("Producer", ProducerThreadMain, (void *)(uintptr_t)i));
+    }
+    for (i = 0; i < NUM_PRODUCERS; i++)
+    {
+        le_sem_Wait(DoneSem);
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double elapsedSec = elapsed.sec + elapsed.usec / 1000000.0;
+
+    // Every producer waits for its last window to be processed, so everything has been received.
+    for (i = 0; i < NUM_PRODUCERS; i++)
+    {
+        isComplete = isComplete && (ReceivedCounts[i] == EVENTS_PER_PRODUCER);
+    }
+
+    LE_TEST_OK(isComplete && IsInOrder, "%s: %d events from each of %d threads received in order",
+               namePtr, EVENTS_PER_PRODUCER, NUM_PRODUCERS);
+    LE_TEST_INFO("%s: %.3f s, %.0f events/s", namePtr, elapsedSec,
+                 (NUM_PRODUCERS * EVENTS_PER_PRODUCER) / elapsedSec);
+}
+
+
+COMPONENT_INIT
+{
+    uint32_t i;
+
+    LE_TEST_PLAN(2);
+    LE_TEST_INFO("Cross-thread event throughput benchmark");
+
+    EventId = le_event_CreateId("PerfEvent", sizeof(PerfReport_t));
+    ReadySem = le_sem_Create("Ready", 0);
+    DoneSem = le_sem_Create("Done", 0);
+    for (i = 0; i < NUM_PRODUCERS; i++)
+    {
+        WindowSems[i] = le_sem_Create("Window", 0);
+    }
+
+    ConsumerThread = le_thread_Create("Consumer", ConsumerThreadMain, NULL);
+    le_thread_Start(ConsumerThread);
+    le_sem_Wait(ReadySem);
+
+    RunTest(METHOD_QUEUE_FUNCTION, "Queued functions");
+    RunTest(METHOD_REPORT, "Event reports");
+
+    LE_TEST_EXIT;
+}
@@ -26,6 +26,9 @@ size_t le_hashmap_HashCustom(const void* keyPtr);
 bool le_hashmap_EqualsCustom(const void* firstPtr, const void* secondPtr);
 bool itHandler(const void* keyPtr, const void* valuePtr, void* contextPtr);
 void TestIterRemove(le_hashmap_Ref_t map);
+void TestGrowth(void);
+void TestStaleIterGrowth(void);
+void TestFlatMap(void);
 
 typedef struct Key Key_t;
 struct Key {
@@ -138,6 +141,9 @@ COMPONENT_INIT
     TestLongIntHashMap(map6);
     TestNewIter(map7);
     TestIterRemove(map1);
+    TestGrowth();
+    TestStaleIterGrowth();
+    TestFlatMap();
 
     LE_TEST_INFO("*** Creating hash maps required for static tests. ***");
     InitStaticMaps(&map1, &map2, &map3, &map4, &map5, &map6, &map7);
@@ -678,3 +684,170 @@ void TestLongIntHashMap(le_hashmap_Ref_t map)
     mapIt = le_hashmap_GetIterator(map);
     LE_TEST(le_hashmap_NextNode(mapIt) == LE_NOT_FOUND);
 }
+
+void TestGrowth(void)
+{
+    static uint32_t iKeys[TEST_SIZE];
+    static uint32_t extraKeys[TEST_SIZE];
+    static bool     seen[TEST_SIZE];
+    int j;
+
+    LE_TEST_INFO("*** Running hashmap growth tests ***");
+
+    // Deliberately undersized, so the map has to grow several times.
+    le_hashmap_Ref_t map = le_hashmap_Create("GrowMap", 4, &le_hashmap_HashUInt32,
+                                             &le_hashmap_EqualsUInt32);
+
+    for (j = 0; j < TEST_SIZE; j++)
+    {
+        iKeys[j] = j;
+        le_hashmap_Put(map, &iKeys[j], &iKeys[j]);
+    }
+    LE_TEST(le_hashmap_Size(map) == TEST_SIZE);
+
+    bool allFound = true;
+    for (j = 0; j < TEST_SIZE; j++)
+    {
+        allFound = allFound && (le_hashmap_Get(map, &iKeys[j]) == &iKeys[j]);
+    }
+    LE_TEST_OK(allFound, "all keys found after growing");
+    LE_TEST_INFO("Collision count = %" PRIuS, le_hashmap_CountCollisions(map));
+    LE_TEST(le_hashmap_CountCollisions(map) < TEST_SIZE / 2);
+
+    // Keep adding while iterating; every original key must be seen exactly once.
+    int itercnt = 0;
+    bool noDuplicates = true;
+    le_hashmap_It_Ref_t mapIt = le_hashmap_GetIterator(map);
+    while (le_hashmap_NextNode(mapIt) == LE_OK)
+    {
+        const uint32_t *keyPtr = le_hashmap_GetKey(mapIt);
+        if (*keyPtr < TEST_SIZE)
+        {
+            noDuplicates = noDuplicates && !seen[*keyPtr];
+            seen[*keyPtr] = true;
+            itercnt++;
+        }
+        if (itercnt <= TEST_SIZE)
+        {
+            extraKeys[itercnt - 1] = TEST_SIZE + itercnt;
+            le_hashmap_Put(map, &extraKeys[itercnt - 1], &extraKeys[itercnt - 1]);
+        }
+    }
+    LE_TEST_OK(noDuplicates, "no key visited twice while growing");
+    LE_TEST(itercnt == TEST_SIZE);
+    LE_TEST(le_hashmap_Size(map) == 2 * TEST_SIZE);
+
+    allFound = true;
+    for (j = 0; j < TEST_SIZE; j++)
+    {
+        allFound = allFound && le_hashmap_ContainsKey(map, &extraKeys[j]);
+    }
+    LE_TEST_OK(allFound, "keys added during iteration found");
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_isEmpty(map));
+}
+
+void TestStaleIterGrowth(void)
+{
+    static uint32_t iKeys[TEST_SIZE];
+    int j;
+
+    LE_TEST_INFO("*** Running hashmap growth with a stale iterator tests ***");
+
+    le_hashmap_Ref_t map = le_hashmap_Create("StaleIterMap", 4, &le_hashmap_HashUInt32,
+                                             &le_hashmap_EqualsUInt32);
+
+    for (j = 0; j < 8; j++)
+    {
+        iKeys[j] = j;
+        le_hashmap_Put(map, &iKeys[j], &iKeys[j]);
+    }
+
+    // Leave the iterator part way through the map, and never finish the iteration.
+    le_hashmap_It_Ref_t mapIt = le_hashmap_GetIterator(map);
+    LE_TEST(le_hashmap_NextNode(mapIt) == LE_OK);
+
+    for (j = 8; j < TEST_SIZE; j++)
+    {
+        iKeys[j] = j;
+        le_hashmap_Put(map, &iKeys[j], &iKeys[j]);
+    }
+    LE_TEST(le_hashmap_Size(map) == TEST_SIZE);
+
+    // The map must have grown anyway, at the cost of the stale iteration.
+    LE_TEST_INFO("Collision count = %" PRIuS, le_hashmap_CountCollisions(map));
+    LE_TEST(le_hashmap_CountCollisions(map) < TEST_SIZE / 2);
+    LE_TEST(le_hashmap_GetKey(mapIt) == NULL);
+    LE_TEST(le_hashmap_NextNode(mapIt) == LE_NOT_FOUND);
+
+    bool allFound = true;
+    for (j = 0; j < TEST_SIZE; j++)
+    {
+        allFound = allFound && (le_hashmap_Get(map, &iKeys[j]) == &iKeys[j]);
+    }
+    LE_TEST_OK(allFound, "all keys found after growing past a stale iterator");
+
+    int itercnt = 0;
+    mapIt = le_hashmap_GetIterator(map);
+    while (le_hashmap_NextNode(mapIt) == LE_OK)
+    {
+        itercnt++;
+    }
+    LE_TEST(itercnt == TEST_SIZE);
+
+    le_hashmap_RemoveAll(map);
+    LE_TEST(le_hashmap_isEmpty(map));
+}
+
+static bool FlatCountHandler(uintptr_t key, void *valuePtr, void *contextPtr)
+{
+    if ((uintptr_t)valuePtr == key * 2)
+    {
+        (*(int *)contextPtr)++;
+    }
+    return true;
+}
+
+void TestFlatMap(void)
+{
+    uintptr_t key;
+    int count = 0;
+
+    LE_TEST_INFO("*** Running flat hashmap tests ***");
+
+    le_hashmap_FlatRef_t map = le_hashmap_CreateFlat("FlatMap", 8);
+
+    for (key = 0; key < TEST_SIZE; key++)
+    {
+        LE_TEST_ASSERT(le_hashmap_FlatPut(map, key, (void *)(key * 2)) == NULL,
+                       "put key %" PRIuPTR, key);
+    }
+    LE_TEST(le_hashmap_FlatSize(map) == TEST_SIZE);
+    LE_TEST(le_hashmap_FlatPut(map, 1, (void *)2) == (void *)2);
+    LE_TEST(le_hashmap_FlatSize(map) == TEST_SIZE);
+
+    for (key = 0; key < TEST_SIZE; key += 2)
+    {
+        LE_TEST_ASSERT(le_hashmap_FlatRemove(map, key) == (void *)(key * 2),
+                       "remove key %" PRIuPTR, key);
+    }
+    LE_TEST(le_hashmap_FlatSize(map) == TEST_SIZE / 2);
+    LE_TEST(le_hashmap_FlatRemove(map, 0) == NULL);
+
+    bool lookupsOk = true;
+    for (key = 0; key < TEST_SIZE; key++)
+    {
+        lookupsOk = lookupsOk && (le_hashmap_FlatContainsKey(map, key) == (key % 2 != 0));
+        lookupsOk = lookupsOk &&
+                    (le_hashmap_FlatGet(map, key) == (key % 2 != 0 ? (void *)(key * 2) : NULL));
+    }
+    LE_TEST_OK(lookupsOk, "flat map lookups after removal");
+
+    LE_TEST(le_hashmap_FlatForEach(map, FlatCountHandler, &count));
+    LE_TEST(count == TEST_SIZE / 2);
+
+    le_hashmap_FlatRemoveAll(map);
+    LE_TEST(le_hashmap_FlatSize(map) == 0);
+    LE_TEST(le_hashmap_FlatGet(map, 1) == NULL);
+}
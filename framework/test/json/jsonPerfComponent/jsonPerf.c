@@ -0,0 +1,282 @@
+/**
+ * JSON parsing throughput benchmark.
+ *
+ * Generates a large JSON document and parses it from a memory buffer, a regular file (read in
+ * blocks) and a pipe (read a byte at a time), reporting the throughput of each in MB/s.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#if LE_CONFIG_LINUX
+/// Number of records in the generated document.
+#   define NUM_RECORDS      12000
+#else
+#   define NUM_RECORDS      200
+#endif
+
+/// Text of each record in the generated document.
+#define RECORD_FORMAT \
+    "  { \"id\": %d, \"name\": \"record %d\", \"value\": %d.%02d, \"flags\": [true, false, null] },\n"
+
+/// Data written to the file after the document, which must not be consumed by the parser.
+#define TRAILER "trailing data"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark steps, run one after another from the event loop.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    STEP_BUFFER,
+#if LE_CONFIG_LINUX
+    STEP_FILE,
+    STEP_PIPE,
+#endif
+    STEP_DONE
+}
+Step_t;
+
+static const char *StepNames[] =
+{
+    "Memory buffer",
+#if LE_CONFIG_LINUX
+    "Regular file",
+    "Pipe",
+#endif
+};
+
+static Step_t CurrentStep;          ///< Step currently being run.
+static char *DocPtr;                ///< Generated document.
+static size_t DocSize;              ///< Size of the generated document, in bytes.
+static size_t EventCount;           ///< Number of parsing events seen in the current step.
+static size_t ExpectedEventCount;   ///< Number of parsing events seen in the first step.
+static le_clk_Time_t StartTime;     ///< Time the current step started.
+static int Fd = -1;                 ///< Fd the document is read from in the current step.
+static le_thread_Ref_t WriterThread;    ///< Thread writing the document into the pipe.
+
+static void RunStep(void *param1Ptr, void *param2Ptr);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the JSON document to be parsed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GenerateDocument
+(
+    void
+)
+{
+    size_t maxSize = NUM_RECORDS * (sizeof(RECORD_FORMAT) + 32) + 16;
+    int i;
+
+    DocPtr = malloc(maxSize);
+    LE_TEST_ASSERT(DocPtr != NULL, "Allocate %" PRIuS " byte document", maxSize);
+
+    DocSize = snprintf(DocPtr, maxSize, "[\n");
+    for (i = 0; i < NUM_RECORDS; i++)
+    {
+        DocSize += snprintf(DocPtr + DocSize, maxSize - DocSize, RECORD_FORMAT,
+                            i, i, i, i % 100);
+    }
+    // Replace the last record's trailing comma.
+    DocSize -= 2;
+    DocSize += snprintf(DocPtr + DocSize, maxSize - DocSize, "\n]");
+    LE_TEST_INFO("Generated %" PRIuS " byte document", DocSize);
+}
+
+
+#if LE_CONFIG_LINUX
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread main function: writes the document into the pipe.
+ *
+ * @return NULL.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *WriterMain
+(
+    void *contextPtr    ///< [IN] Write end of the pipe, as an intptr_t.
+)
+{
+    int writeFd = (int)(intptr_t)contextPtr;
+    size_t written = 0;
+
+    while (written < DocSize)
+    {
+        ssize_t result = write(writeFd, DocPtr + written, DocSize - written);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LE_ERROR("Pipe write failed (%m)");
+            break;
+        }
+        written += result;
+    }
+
+    close(writeFd);
+    return NULL;
+}
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parsing event handler.  Counts events and finishes the step at the end of the document.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OnEvent
+(
+    le_json_Event_t event
+)
+{
+    EventCount++;
+
+    if (event != LE_JSON_DOC_END)
+    {
+        return;
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+    double elapsedSec = elapsed.sec + elapsed.usec / 1000000.0;
+
+    LE_TEST_INFO("%s: %.3f s, %.2f MB/s", StepNames[CurrentStep], elapsedSec,
+                 (DocSize / (1024.0 * 1024.0)) / elapsedSec);
+    LE_TEST_OK(le_json_GetBytesRead(le_json_GetSession()) == DocSize,
+               "%s: whole document processed", StepNames[CurrentStep]);
+
+    if (CurrentStep == STEP_BUFFER)
+    {
+        ExpectedEventCount = EventCount;
+    }
+    LE_TEST_OK(EventCount == ExpectedEventCount, "%s: %" PRIuS " events",
+               StepNames[CurrentStep], EventCount);
+
+    le_json_Cleanup(le_json_GetSession());
+
+#if LE_CONFIG_LINUX
+    if (CurrentStep == STEP_FILE)
+    {
+        // Data read ahead of the parser must have been given back.
+        LE_TEST_OK(lseek(Fd, 0, SEEK_CUR) == (off_t)DocSize,
+                   "File offset left at end of document");
+    }
+    else if (CurrentStep == STEP_PIPE)
+    {
+        LE_TEST_OK(le_thread_Join(WriterThread, NULL) == LE_OK, "Join writer thread");
+    }
+
+    if (Fd != -1)
+    {
+        close(Fd);
+        Fd = -1;
+    }
+#endif
+
+    CurrentStep++;
+    le_event_QueueFunction(RunStep, NULL, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Parsing error handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void OnError
+(
+    le_json_Error_t  error,
+    const char      *msg
+)
+{
+    LE_TEST_FATAL("%s: parse error (%d): %s", StepNames[CurrentStep], error, msg);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the current benchmark step.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunStep
+(
+    void *param1Ptr,
+    void *param2Ptr
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    EventCount = 0;
+
+    switch (CurrentStep)
+    {
+        case STEP_BUFFER:
+            StartTime = le_clk_GetRelativeTime();
+            LE_TEST_ASSERT(le_json_ParseBuffer(DocPtr, DocSize, OnEvent, OnError, NULL) != NULL,
+                           "Start parsing from buffer");
+            break;
+
+#if LE_CONFIG_LINUX
+        case STEP_FILE:
+        {
+            char path[] = "/tmp/jsonPerfXXXXXX";
+
+            Fd = mkstemp(path);
+            LE_TEST_ASSERT(Fd != -1, "Create temporary file");
+            unlink(path);
+            LE_TEST_ASSERT(write(Fd, DocPtr, DocSize) == (ssize_t)DocSize, "Write document");
+            LE_TEST_ASSERT(write(Fd, TRAILER, sizeof(TRAILER)) == sizeof(TRAILER),
+                           "Write trailer");
+            lseek(Fd, 0, SEEK_SET);
+
+            StartTime = le_clk_GetRelativeTime();
+            LE_TEST_ASSERT(le_json_Parse(Fd, OnEvent, OnError, NULL) != NULL,
+                           "Start parsing from file");
+            break;
+        }
+
+        case STEP_PIPE:
+        {
+            int pipeFds[2];
+
+            LE_TEST_ASSERT(pipe(pipeFds) == 0, "Create pipe");
+            Fd = pipeFds[0];
+            fcntl(Fd, F_SETFL, fcntl(Fd, F_GETFL) | O_NONBLOCK);
+
+            WriterThread = le_thread_Create("jsonWriter", WriterMain,
+                                            (void *)(intptr_t)pipeFds[1]);
+            le_thread_SetJoinable(WriterThread);
+
+            StartTime = le_clk_GetRelativeTime();
+            le_thread_Start(WriterThread);
+            LE_TEST_ASSERT(le_json_Parse(Fd, OnEvent, OnError, NULL) != NULL,
+                           "Start parsing from pipe");
+            break;
+        }
+#endif
+
+        case STEP_DONE:
+            free(DocPtr);
+            LE_TEST_EXIT;
+            break;
+    }
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("JSON parsing throughput benchmark");
+
+    GenerateDocument();
+
+    CurrentStep = STEP_BUFFER;
+    le_event_QueueFunction(RunStep, NULL, NULL);
+}
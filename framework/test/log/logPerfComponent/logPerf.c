@@ -0,0 +1,128 @@
+/**
+ * Per-call cost benchmark for the logging macros.
+ *
+ * Logs bursts of messages, pausing between bursts so that a deferred log ring (if enabled) can be
+ * drained without overflowing, and reports the average time spent in each logging call.  Run it
+ * with and without LE_CONFIG_LOG_DEFERRED to compare the two.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+/// Number of messages logged in each burst.
+#define BURST_SIZE          100
+
+/// Time to wait between bursts, in milliseconds.
+#define BURST_PAUSE_MS      50
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_BURSTS       5
+#else
+#   define NUM_BURSTS       20
+#endif
+
+/// Kinds of message logged by the benchmark.
+typedef enum
+{
+    MSG_FILTERED,       ///< Below the filter level.
+    MSG_PLAIN,          ///< No arguments.
+    MSG_ARGS,           ///< Integer, string and floating point arguments.
+    MSG_LONG_STRING     ///< A string argument longer than a log message.
+}
+MsgKind_t;
+
+/// String argument that is longer than a log message can hold.
+static char LongString[400];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs a message of a given kind.
+ */
+//--------------------------------------------------------------------------------------------------
+static void LogOne
+(
+    MsgKind_t   kind,   ///< [IN] Kind of message.
+    int         i       ///< [IN] Message number.
+)
+{
+    switch (kind)
+    {
+        case MSG_FILTERED:
+            LE_DEBUG("Filtered message %d", i);
+            break;
+        case MSG_PLAIN:
+            LE_INFO("Plain message");
+            break;
+        case MSG_ARGS:
+            LE_INFO("Message %d from '%s' after %.3f s (0x%08" PRIx32 ")", i,
+                    le_thread_GetMyName(), i / 1000.0, (uint32_t)i);
+            break;
+        case MSG_LONG_STRING:
+            LE_INFO("Message %d: %s", i, LongString);
+            break;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logs bursts of messages of a given kind and reports the average time per call.
+ *
+ * @return The number of messages logged.
+ */
+//--------------------------------------------------------------------------------------------------
+static int RunBenchmark
+(
+    MsgKind_t   kind,       ///< [IN] Kind of message.
+    const char *descPtr     ///< [IN] Description of the kind for the report.
+)
+{
+    le_clk_Time_t total = { 0, 0 };
+    int burst, i;
+    int numLogged = 0;
+
+    for (burst = 0; burst < NUM_BURSTS; burst++)
+    {
+        le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+        for (i = 0; i < BURST_SIZE; i++)
+        {
+            LogOne(kind, numLogged++);
+        }
+        total = le_clk_Add(total, le_clk_Sub(le_clk_GetRelativeTime(), startTime));
+
+        usleep(BURST_PAUSE_MS * 1000);
+    }
+
+    LE_TEST_INFO("%s: %.0f ns per call", descPtr,
+                 (total.sec * 1e9 + total.usec * 1e3) / numLogged);
+    return numLogged;
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("Logging per-call cost benchmark (deferred formatting %s)",
+#if LE_CONFIG_LOG_DEFERRED
+                 "enabled"
+#else
+                 "disabled"
+#endif
+                 );
+
+    memset(LongString, 'x', sizeof(LongString) - 1);
+
+    LE_TEST_OK(RunBenchmark(MSG_FILTERED, "Filtered") == NUM_BURSTS * BURST_SIZE,
+               "Filtered messages");
+    LE_TEST_OK(RunBenchmark(MSG_PLAIN, "No arguments") == NUM_BURSTS * BURST_SIZE,
+               "Messages without arguments");
+    LE_TEST_OK(RunBenchmark(MSG_ARGS, "With arguments") == NUM_BURSTS * BURST_SIZE,
+               "Messages with arguments");
+    LE_TEST_OK(RunBenchmark(MSG_LONG_STRING, "Long string argument") == NUM_BURSTS * BURST_SIZE,
+               "Messages with a long string argument");
+
+    LE_TEST_EXIT;
+}
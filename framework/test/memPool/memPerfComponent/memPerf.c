@@ -0,0 +1,139 @@
+/**
+ * Multi-threaded allocation/release throughput benchmark for the le_mem module.
+ *
+ * Runs the same alloc/release workload on 1, 2, 4 and 8 threads, first on a pool without
+ * per-thread caches and then on a pool with per-thread caches enabled, and reports the total
+ * throughput for each run.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+/// Size of the objects allocated by the benchmark.
+#define OBJ_SIZE            64
+
+/// Number of objects each thread holds at once.
+#define OBJS_PER_ROUND      32
+
+/// Per-thread cache size used for the cached pool.
+#define THREAD_CACHE_SIZE   32
+
+/// Maximum number of threads used by the benchmark.
+#define MAX_THREADS         8
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_ROUNDS       2000
+#else
+#   define NUM_ROUNDS       50000
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread main function: repeatedly allocates a round of objects from the pool and releases them.
+ *
+ * @return NULL.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WorkerMain
+(
+    void* contextPtr    ///< [IN] Pool to allocate from.
+)
+{
+    le_mem_PoolRef_t pool = contextPtr;
+    void* objs[OBJS_PER_ROUND];
+    int round, i;
+
+    for (round = 0; round < NUM_ROUNDS; round++)
+    {
+        for (i = 0; i < OBJS_PER_ROUND; i++)
+        {
+            objs[i] = le_mem_ForceAlloc(pool);
+            memset(objs[i], round, OBJ_SIZE);
+        }
+
+        for (i = 0; i < OBJS_PER_ROUND; i++)
+        {
+            le_mem_Release(objs[i]);
+        }
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the workload on a given number of threads and reports the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunBenchmark
+(
+    le_mem_PoolRef_t pool,      ///< [IN] Pool to allocate from.
+    const char*      poolDesc,  ///< [IN] Description of the pool for the report.
+    int              numThreads ///< [IN] Number of threads to run the workload on.
+)
+{
+    le_thread_Ref_t threads[MAX_THREADS];
+    char threadName[32];
+    int i;
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (i = 0; i < numThreads; i++)
+    {
+        snprintf(threadName, sizeof(threadName), "memPerf%d", i);
+        threads[i] = le_thread_Create(threadName, WorkerMain, pool);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    for (i = 0; i < numThreads; i++)
+    {
+        LE_TEST_OK(le_thread_Join(threads[i], NULL) == LE_OK, "Join thread %d", i);
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double elapsedSec = elapsed.sec + elapsed.usec / 1000000.0;
+    double numOps = 2.0 * numThreads * NUM_ROUNDS * OBJS_PER_ROUND;
+
+    LE_TEST_INFO("%s, %d thread(s): %.3f s, %.0f alloc+release ops/s",
+                 poolDesc, numThreads, elapsedSec, numOps / elapsedSec);
+
+    // All threads have exited, so all of their cached blocks must be back in the pool.
+    le_mem_PoolStats_t stats;
+    le_mem_GetStats(pool, &stats);
+    LE_TEST_OK(stats.numBlocksInUse == 0, "%s: no blocks in use after run (%" PRIuS ")",
+               poolDesc, stats.numBlocksInUse);
+    LE_TEST_OK(stats.numFree == le_mem_GetObjectCount(pool),
+               "%s: all blocks free after run", poolDesc);
+}
+
+
+COMPONENT_INIT
+{
+    int numThreads;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("Memory pool multi-threaded throughput benchmark");
+
+    le_mem_PoolRef_t lockedPool = le_mem_CreatePool("Locked", OBJ_SIZE);
+    le_mem_ExpandPool(lockedPool, MAX_THREADS * OBJS_PER_ROUND);
+
+    le_mem_PoolRef_t cachedPool = le_mem_CreatePool("Cached", OBJ_SIZE);
+    le_mem_ExpandPool(cachedPool, MAX_THREADS * (OBJS_PER_ROUND + THREAD_CACHE_SIZE));
+    le_mem_SetNumObjsToForce(cachedPool, THREAD_CACHE_SIZE);
+
+    le_result_t result = le_mem_EnableThreadCache(cachedPool, THREAD_CACHE_SIZE);
+    LE_TEST_BEGIN_SKIP(!LE_CONFIG_IS_ENABLED(LE_CONFIG_MEM_THREAD_CACHE), 1);
+    LE_TEST_OK(result == LE_OK, "Enable per-thread caches");
+    LE_TEST_END_SKIP();
+
+    for (numThreads = 1; numThreads <= MAX_THREADS; numThreads *= 2)
+    {
+        RunBenchmark(lockedPool, "Locked pool", numThreads);
+        RunBenchmark(cachedPool, "Cached pool", numThreads);
+    }
+
+    LE_TEST_EXIT;
+}
@@ -7,5 +7,6 @@
 import os
 
 def pytest_ignore_collect(path, config):
-    if os.environ.get('LE_CONFIG_LINUX') != "y" and path.basename == "testUnixMessaging.adef":
+    if os.environ.get('LE_CONFIG_LINUX') != "y" and \
+       path.basename in ("testUnixMessaging.adef", "test_UnixMessagingPerf.adef"):
         return True
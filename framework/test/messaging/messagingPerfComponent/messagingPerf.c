@@ -0,0 +1,428 @@
+/**
+ * IPC throughput benchmark.
+ *
+ * Runs a server thread and a client in the same process, connected through a Unix socket session.
+ * The client streams the same block of data to the server twice, using synchronous
+ * request-response transactions:
+ *
+ * - split up into messages that carry the data in their normal (copied) payload;
+ * - in bulk payloads, which are passed through the session's shared memory ring.
+ *
+ * The server checksums everything it receives so that both runs read every byte, and the
+ * throughput of each run is reported in MB/s.
+ *
+ * Small messages are then exchanged on a second session to measure the round-trip latency of
+ * synchronous request-response transactions and the rate at which one-way messages can be
+ * delivered.  These are the numbers to compare when changing LE_CONFIG_MSG_BATCH_SIZE.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#define SERVICE_INSTANCE_NAME   "IpcPerf"
+#define PROTOCOL_ID_STR         "ipcPerf"
+
+#define SMALL_SERVICE_INSTANCE_NAME "IpcPerfSmall"
+#define SMALL_PROTOCOL_ID_STR       "ipcPerfSmall"
+
+/// Total amount of data sent in each run.
+#define TOTAL_BYTES             (64 * 1024 * 1024)
+
+/// Amount of data carried in the normal payload of each message.
+#define INLINE_BLOCK_BYTES      4096
+
+/// Largest amount of data carried in the bulk payload of each message.
+#define BULK_BLOCK_BYTES        (256 * 1024)
+
+/// Number of round trips timed for the latency run.
+#define ROUND_TRIP_COUNT        10000
+
+/// Number of one-way messages sent for the message rate run.
+#define ONE_WAY_COUNT           100000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark protocol message.  The server responds to every request with the checksum of the
+ * data it carried, either in the data field or in the bulk payload.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t size;                      ///< Size of the data in the data field (0 = use bulk).
+    uint32_t checksum;                  ///< Checksum of the data (response only).
+    uint8_t  data[INLINE_BLOCK_BYTES];  ///< Data.
+}
+PerfMessage_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Small message protocol.  One-way messages are counted by the server; requests are answered
+ * with the number of one-way messages received so far.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t count;                     ///< One-way message count (response only).
+    uint32_t sequence;                  ///< Sequence number, echoed back.
+}
+SmallMessage_t;
+
+static uint8_t *DataPtr;    ///< Data to send.
+static uint32_t OneWayCount;    ///< Number of one-way messages received by the server.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute a simple checksum of a block of data.
+ *
+ * @return The checksum.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Checksum
+(
+    uint32_t        checksum,   ///< [IN] Checksum of the data so far.
+    const uint8_t  *bufPtr,     ///< [IN] Data.
+    size_t          size        ///< [IN] Size of the data.
+)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        checksum = (checksum << 1 | checksum >> 31) ^ bufPtr[i];
+    }
+
+    return checksum;
+}
+
+
+// ==================================
+//  SERVER
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message receive handler: checksum the data and respond.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServerRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void               *contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    PerfMessage_t *msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    if (msgPtr->size != 0)
+    {
+        msgPtr->checksum = Checksum(0, msgPtr->data, msgPtr->size);
+    }
+    else
+    {
+        size_t bulkSize;
+        const uint8_t *bulkPtr = le_msg_GetBulkPayloadPtr(msgRef, &bulkSize);
+
+        msgPtr->checksum = Checksum(0, bulkPtr, bulkSize);
+    }
+
+    le_msg_Respond(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Small message receive handler: count one-way messages and answer requests.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SmallServerRecvHandler
+(
+    le_msg_MessageRef_t msgRef,
+    void               *contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    if (le_msg_NeedsResponse(msgRef))
+    {
+        SmallMessage_t *msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+        msgPtr->count = OneWayCount;
+        le_msg_Respond(msgRef);
+    }
+    else
+    {
+        OneWayCount++;
+        le_msg_ReleaseMsg(msgRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function for the server thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void *ServerThreadMain
+(
+    void *contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR,
+                                                             sizeof(PerfMessage_t));
+    le_msg_ServiceRef_t serviceRef = le_msg_CreateService(protocolRef, SERVICE_INSTANCE_NAME);
+
+    le_msg_SetServiceRecvHandler(serviceRef, ServerRecvHandler, NULL);
+    le_msg_AdvertiseService(serviceRef);
+
+    protocolRef = le_msg_GetProtocolRef(SMALL_PROTOCOL_ID_STR, sizeof(SmallMessage_t));
+    serviceRef = le_msg_CreateService(protocolRef, SMALL_SERVICE_INSTANCE_NAME);
+
+    le_msg_SetServiceRecvHandler(serviceRef, SmallServerRecvHandler, NULL);
+    le_msg_AdvertiseService(serviceRef);
+
+    le_event_RunLoop();
+}
+
+
+// ==================================
+//  CLIENT
+// ==================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a block of data to the server and check the checksum it sends back.
+ *
+ * @return true if the server's checksum matched.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendBlock
+(
+    le_msg_SessionRef_t sessionRef,
+    const uint8_t      *bufPtr,
+    size_t              size,
+    bool                useBulk
+)
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+    PerfMessage_t *msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    if (useBulk)
+    {
+        uint8_t *bulkPtr = le_msg_AllocBulkPayload(msgRef, size);
+        if (bulkPtr == NULL)
+        {
+            LE_ERROR("Unable to allocate %" PRIuS " byte bulk payload", size);
+            le_msg_ReleaseMsg(msgRef);
+            return false;
+        }
+        memcpy(bulkPtr, bufPtr, size);
+        msgPtr->size = 0;
+    }
+    else
+    {
+        memcpy(msgPtr->data, bufPtr, size);
+        msgPtr->size = size;
+    }
+
+    msgRef = le_msg_RequestSyncResponse(msgRef);
+    if (msgRef == NULL)
+    {
+        LE_ERROR("No response from server");
+        return false;
+    }
+
+    msgPtr = le_msg_GetPayloadPtr(msgRef);
+    bool isMatch = (msgPtr->checksum == Checksum(0, bufPtr, size));
+    le_msg_ReleaseMsg(msgRef);
+
+    return isMatch;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send all the data to the server in blocks of a given size, and report the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunTest
+(
+    le_msg_SessionRef_t sessionRef,
+    const char         *namePtr,
+    size_t              blockSize,
+    bool                useBulk
+)
+{
+    size_t offset;
+    size_t blockCount = 0;
+    bool isOk = true;
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (offset = 0; (offset < TOTAL_BYTES) && isOk; offset += blockSize)
+    {
+        size_t size = (TOTAL_BYTES - offset < blockSize ? TOTAL_BYTES - offset : blockSize);
+
+        isOk = SendBlock(sessionRef, DataPtr + offset, size, useBulk);
+        blockCount++;
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double elapsedSec = elapsed.sec + elapsed.usec / 1000000.0;
+
+    LE_TEST_OK(isOk, "%s: %" PRIuS " blocks of %" PRIuS " bytes echoed back correctly",
+               namePtr, blockCount, blockSize);
+    LE_TEST_INFO("%s: %.3f s, %.2f MB/s", namePtr, elapsedSec,
+                 (TOTAL_BYTES / (1024.0 * 1024.0)) / elapsedSec);
+}
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ask the server how many one-way messages it has received so far.
+ *
+ * @return The count, or UINT32_MAX if the request failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetOneWayCount
+(
+    le_msg_SessionRef_t sessionRef,
+    uint32_t            sequence
+)
+{
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+    SmallMessage_t *msgPtr = le_msg_GetPayloadPtr(msgRef);
+    uint32_t count = UINT32_MAX;
+
+    msgPtr->sequence = sequence;
+
+    msgRef = le_msg_RequestSyncResponse(msgRef);
+    if (msgRef != NULL)
+    {
+        msgPtr = le_msg_GetPayloadPtr(msgRef);
+        if (msgPtr->sequence == sequence)
+        {
+            count = msgPtr->count;
+        }
+        le_msg_ReleaseMsg(msgRef);
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time small synchronous request-response transactions, and report the average round trip.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunLatencyTest
+(
+    le_msg_SessionRef_t sessionRef
+)
+{
+    uint32_t i;
+    bool isOk = true;
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (i = 0; (i < ROUND_TRIP_COUNT) && isOk; i++)
+    {
+        isOk = (GetOneWayCount(sessionRef, i) != UINT32_MAX);
+    }
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double elapsedUsec = elapsed.sec * 1000000.0 + elapsed.usec;
+
+    LE_TEST_OK(isOk, "Latency: %" PRIu32 " round trips completed", i);
+    LE_TEST_INFO("Latency: %.2f us per round trip", elapsedUsec / i);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a burst of one-way messages, then check that the server got them all (the request that
+ * asks for the count can't overtake them), and report the message rate.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunMessageRateTest
+(
+    le_msg_SessionRef_t sessionRef
+)
+{
+    uint32_t i;
+    uint32_t startCount = GetOneWayCount(sessionRef, 0);
+
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+    for (i = 0; i < ONE_WAY_COUNT; i++)
+    {
+        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+        SmallMessage_t *msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+        msgPtr->sequence = i;
+        le_msg_Send(msgRef);
+    }
+
+    uint32_t endCount = GetOneWayCount(sessionRef, 1);
+
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    double elapsedSec = elapsed.sec + elapsed.usec / 1000000.0;
+
+    LE_TEST_OK(endCount - startCount == ONE_WAY_COUNT,
+               "Message rate: %" PRIu32 " of %d one-way messages delivered in order",
+               endCount - startCount, ONE_WAY_COUNT);
+    LE_TEST_INFO("Message rate: %.0f messages/s", ONE_WAY_COUNT / elapsedSec);
+}
+
+
+COMPONENT_INIT
+{
+    size_t i;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("IPC throughput benchmark");
+
+    DataPtr = malloc(TOTAL_BYTES);
+    LE_TEST_ASSERT(DataPtr != NULL, "Allocate %d bytes of data", TOTAL_BYTES);
+    for (i = 0; i < TOTAL_BYTES; i++)
+    {
+        DataPtr[i] = (uint8_t)(i * 31 + (i >> 12));
+    }
+
+    le_thread_Start(le_thread_Create("IpcPerfServer", ServerThreadMain, NULL));
+
+    le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(PROTOCOL_ID_STR,
+                                                             sizeof(PerfMessage_t));
+    le_msg_SessionRef_t sessionRef = le_msg_CreateSession(protocolRef, SERVICE_INSTANCE_NAME);
+    le_msg_OpenSessionSync(sessionRef);
+
+    RunTest(sessionRef, "Inline payload", INLINE_BLOCK_BYTES, false);
+
+    size_t maxBulkSize = le_msg_GetMaxBulkPayloadSize(sessionRef);
+    LE_TEST_INFO("Largest bulk payload: %" PRIuS " bytes", maxBulkSize);
+
+    LE_TEST_BEGIN_SKIP(maxBulkSize == 0, 1)
+    RunTest(sessionRef, "Bulk payload",
+            (maxBulkSize < BULK_BLOCK_BYTES ? maxBulkSize : BULK_BLOCK_BYTES), true);
+    LE_TEST_END_SKIP();
+
+    le_msg_DeleteSession(sessionRef);
+    free(DataPtr);
+
+    protocolRef = le_msg_GetProtocolRef(SMALL_PROTOCOL_ID_STR, sizeof(SmallMessage_t));
+    sessionRef = le_msg_CreateSession(protocolRef, SMALL_SERVICE_INSTANCE_NAME);
+    le_msg_OpenSessionSync(sessionRef);
+
+    RunLatencyTest(sessionRef);
+    RunMessageRateTest(sessionRef);
+
+    le_msg_DeleteSession(sessionRef);
+
+    LE_TEST_EXIT;
+}
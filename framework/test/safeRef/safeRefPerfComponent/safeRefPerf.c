@@ -0,0 +1,229 @@
+/**
+ * Lookup, create and delete throughput benchmark for the le_ref module.
+ *
+ * Runs the same workload on a normal Reference Map and on a read-optimized Reference Map, with
+ * the maps filled to their nominal size and then well past it (into overflow), and reports the
+ * throughput of each operation.  Also checks that the read-optimized map rejects stale references
+ * and can be looked up from other threads while it is being modified.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+/// Nominal size of the maps.
+#define MAP_SIZE            64
+
+/// Number of references held in the overflowing runs.
+#define NUM_OVERFLOW_REFS   2048
+
+/// Number of threads doing lookups while the map is modified.
+#define NUM_READERS         3
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_ROUNDS       20
+#else
+#   define NUM_ROUNDS       500
+#endif
+
+/// Objects that references are created for.
+static int Objects[NUM_OVERFLOW_REFS];
+
+/// References to the objects.
+static void* Refs[NUM_OVERFLOW_REFS];
+
+/// Map looked up by the reader threads.
+static le_ref_MapRef_t SharedMap;
+
+/// Set to stop the reader threads.
+static volatile bool StopReaders;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetElapsedSec
+(
+    le_clk_Time_t startTime     ///< [IN] Relative time to measure from.
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs the workload on a map holding a given number of references and reports the throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunBenchmark
+(
+    le_ref_MapRef_t mapRef,     ///< [IN] Map to use.
+    const char*     mapDesc,    ///< [IN] Description of the map for the report.
+    int             numRefs     ///< [IN] Number of references to hold in the map.
+)
+{
+    le_clk_Time_t startTime;
+    double elapsedSec;
+    int round, i;
+    int numBad = 0;
+
+    for (i = 0; i < numRefs; i++)
+    {
+        Refs[i] = le_ref_CreateRef(mapRef, &Objects[i]);
+    }
+
+    startTime = le_clk_GetRelativeTime();
+    for (round = 0; round < NUM_ROUNDS * 10; round++)
+    {
+        for (i = 0; i < numRefs; i++)
+        {
+            if (le_ref_Lookup(mapRef, Refs[i]) != &Objects[i])
+            {
+                numBad++;
+            }
+        }
+    }
+    elapsedSec = GetElapsedSec(startTime);
+    LE_TEST_OK(numBad == 0, "%s, %d refs: all lookups found their object", mapDesc, numRefs);
+    LE_TEST_INFO("%s, %d refs: %.0f lookups/s", mapDesc, numRefs,
+                 (10.0 * NUM_ROUNDS * numRefs) / elapsedSec);
+
+    startTime = le_clk_GetRelativeTime();
+    for (round = 0; round < NUM_ROUNDS; round++)
+    {
+        for (i = 0; i < numRefs; i++)
+        {
+            le_ref_DeleteRef(mapRef, Refs[i]);
+        }
+        for (i = 0; i < numRefs; i++)
+        {
+            Refs[i] = le_ref_CreateRef(mapRef, &Objects[i]);
+        }
+    }
+    elapsedSec = GetElapsedSec(startTime);
+    LE_TEST_INFO("%s, %d refs: %.0f create+delete pairs/s", mapDesc, numRefs,
+                 (1.0 * NUM_ROUNDS * numRefs) / elapsedSec);
+
+    for (i = 0; i < numRefs; i++)
+    {
+        le_ref_DeleteRef(mapRef, Refs[i]);
+    }
+
+    le_ref_IterRef_t iterRef = le_ref_GetIterator(mapRef);
+    LE_TEST_OK(le_ref_NextNode(iterRef) == LE_NOT_FOUND, "%s: empty after run", mapDesc);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reader thread: looks up references in the shared map until told to stop, checking that every
+ * successful lookup returns one of the objects.
+ *
+ * @return The number of bad lookups.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ReaderMain
+(
+    void* contextPtr    ///< [IN] Not used.
+)
+{
+    uintptr_t numBad = 0;
+    int i = 0;
+
+    LE_UNUSED(contextPtr);
+
+    while (!StopReaders)
+    {
+        int* objPtr = le_ref_Lookup(SharedMap, LE_ATOMIC_LOAD(&Refs[i], LE_ATOMIC_ORDER_RELAXED));
+
+        if ((objPtr != NULL) && ((objPtr < Objects) || (objPtr >= Objects + MAP_SIZE)))
+        {
+            numBad++;
+        }
+        i = (i + 1) % MAP_SIZE;
+    }
+
+    return (void*)numBad;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that stale references are rejected, and that lookups from other threads are safe while
+ * the map is being modified.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestReadOptimized
+(
+    void
+)
+{
+    le_thread_Ref_t threads[NUM_READERS];
+    char threadName[32];
+    void* staleRef;
+    int round, i;
+
+    SharedMap = le_ref_CreateReadOptimizedMap("PerfShared", MAP_SIZE);
+
+    staleRef = le_ref_CreateRef(SharedMap, &Objects[0]);
+    le_ref_DeleteRef(SharedMap, staleRef);
+    for (i = 0; i < MAP_SIZE; i++)
+    {
+        Refs[i] = le_ref_CreateRef(SharedMap, &Objects[i]);
+    }
+    LE_TEST_OK(le_ref_Lookup(SharedMap, staleRef) == NULL, "Stale reference rejected");
+    LE_TEST_OK(le_ref_Lookup(SharedMap, NULL) == NULL, "NULL reference rejected");
+    LE_TEST_OK(le_ref_Lookup(SharedMap, &Objects[0]) == NULL, "Pointer rejected");
+
+    for (i = 0; i < NUM_READERS; i++)
+    {
+        snprintf(threadName, sizeof(threadName), "refReader%d", i);
+        threads[i] = le_thread_Create(threadName, ReaderMain, NULL);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    for (round = 0; round < NUM_ROUNDS * 10; round++)
+    {
+        for (i = 0; i < MAP_SIZE; i++)
+        {
+            le_ref_DeleteRef(SharedMap, Refs[i]);
+            LE_ATOMIC_STORE(&Refs[i], le_ref_CreateRef(SharedMap, &Objects[(i + round) % MAP_SIZE]),
+                            LE_ATOMIC_ORDER_RELAXED);
+        }
+    }
+
+    StopReaders = true;
+    for (i = 0; i < NUM_READERS; i++)
+    {
+        void* numBad;
+
+        LE_TEST_OK(le_thread_Join(threads[i], &numBad) == LE_OK, "Join reader %d", i);
+        LE_TEST_OK(numBad == NULL, "Reader %d saw no bad lookups (%" PRIuPTR ")", i,
+                   (uintptr_t)numBad);
+    }
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("Safe reference map throughput benchmark");
+
+    le_ref_MapRef_t blockMap = le_ref_CreateMap("PerfBlock", MAP_SIZE);
+    le_ref_MapRef_t optimizedMap = le_ref_CreateReadOptimizedMap("PerfOptimized", MAP_SIZE);
+
+    RunBenchmark(blockMap, "Block map", MAP_SIZE);
+    RunBenchmark(optimizedMap, "Read-optimized map", MAP_SIZE);
+    RunBenchmark(blockMap, "Block map", NUM_OVERFLOW_REFS);
+    RunBenchmark(optimizedMap, "Read-optimized map", NUM_OVERFLOW_REFS);
+
+    TestReadOptimized();
+
+    LE_TEST_EXIT;
+}
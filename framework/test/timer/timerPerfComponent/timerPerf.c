@@ -0,0 +1,134 @@
+/**
+ * Benchmark for starting and stopping large numbers of le_timer timers.
+ *
+ * Creates a large number of guard timers with long, randomly distributed intervals, then measures
+ * the time taken to start, restart and stop all of them.  Finally a handful of short timers are
+ * started among the guard timers to check that they still expire in order.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#ifdef LE_CONFIG_REDUCE_FOOTPRINT
+#   define NUM_TIMERS       2000
+#else
+#   define NUM_TIMERS       100000
+#endif
+
+/// Number of short timers used to check expiry order.
+#define NUM_SHORT_TIMERS    5
+
+/// Timers used in the benchmark.
+static le_timer_Ref_t Timers[NUM_TIMERS];
+
+/// Short timers used to check expiry order.
+static le_timer_Ref_t ShortTimers[NUM_SHORT_TIMERS];
+
+/// Number of short timers that have expired so far.
+static int NumShortExpired;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of seconds elapsed since a start time.
+ */
+//--------------------------------------------------------------------------------------------------
+static double SecondsSince
+(
+    le_clk_Time_t startTime
+)
+{
+    le_clk_Time_t elapsed = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return elapsed.sec + elapsed.usec / 1000000.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Report the rate of an operation applied to all timers.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReportRate
+(
+    const char*   opName,       ///< [IN] Operation measured.
+    le_clk_Time_t startTime     ///< [IN] Time the operation started.
+)
+{
+    double elapsedSec = SecondsSince(startTime);
+
+    LE_TEST_INFO("%s %d timers: %.3f s (%.0f ops/s)",
+                 opName, NUM_TIMERS, elapsedSec, NUM_TIMERS / elapsedSec);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Expiry handler for the short timers.  They are started in reverse order of their intervals, so
+ * must expire in index order.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ShortTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    int index = (int)(intptr_t)le_timer_GetContextPtr(timerRef);
+
+    LE_TEST_OK(index == NumShortExpired, "Short timer %d expired in order", index);
+    NumShortExpired++;
+
+    if (NumShortExpired == NUM_SHORT_TIMERS)
+    {
+        int i;
+        le_clk_Time_t startTime = le_clk_GetRelativeTime();
+
+        for (i = 0; i < NUM_TIMERS; i++)
+        {
+            LE_ASSERT(le_timer_Stop(Timers[i]) == LE_OK);
+        }
+        ReportRate("Stop", startTime);
+
+        LE_TEST_EXIT;
+    }
+}
+
+
+COMPONENT_INIT
+{
+    int i;
+    le_clk_Time_t startTime;
+
+    LE_TEST_PLAN(NUM_SHORT_TIMERS);
+    LE_TEST_INFO("Timer start/stop benchmark");
+
+    for (i = 0; i < NUM_TIMERS; i++)
+    {
+        Timers[i] = le_timer_Create("guard");
+        LE_ASSERT(le_timer_SetMsInterval(Timers[i], 60000 + (rand() % 3600000)) == LE_OK);
+    }
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_TIMERS; i++)
+    {
+        LE_ASSERT(le_timer_Start(Timers[i]) == LE_OK);
+    }
+    ReportRate("Start", startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < NUM_TIMERS; i++)
+    {
+        le_timer_Restart(Timers[i]);
+    }
+    ReportRate("Restart", startTime);
+
+    // Start short timers with decreasing intervals while the guard timers are running.
+    for (i = NUM_SHORT_TIMERS - 1; i >= 0; i--)
+    {
+        ShortTimers[i] = le_timer_Create("short");
+        LE_ASSERT(le_timer_SetMsInterval(ShortTimers[i], 100 * (i + 1)) == LE_OK);
+        LE_ASSERT(le_timer_SetContextPtr(ShortTimers[i], (void*)(intptr_t)i) == LE_OK);
+        LE_ASSERT(le_timer_SetHandler(ShortTimers[i], ShortTimerHandler) == LE_OK);
+        LE_ASSERT(le_timer_Start(ShortTimers[i]) == LE_OK);
+    }
+}
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -1300,9 +1301,25 @@ int main
 
             crc32Orig = LE_CRC_START_CRC32;
 
-            while( 0 < (len = read( fdr, Chunk, chunkLen )) )
+            // Compute the CRC straight from the page cache if the origin can be mapped, and fall
+            // back to copying it through Chunk otherwise.
+            void* origMapPtr = MAP_FAILED;
+            if( 0 < st.st_size )
             {
-                crc32Orig = le_crc_Crc32( Chunk, len, crc32Orig );
+                origMapPtr = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fdr, 0 );
+            }
+            if( MAP_FAILED != origMapPtr )
+            {
+                (void)madvise( origMapPtr, st.st_size, MADV_SEQUENTIAL );
+                crc32Orig = le_crc_Crc32( origMapPtr, st.st_size, crc32Orig );
+                munmap( origMapPtr, st.st_size );
+            }
+            else
+            {
+                while( 0 < (len = read( fdr, Chunk, chunkLen )) )
+                {
+                    crc32Orig = le_crc_Crc32( Chunk, len, crc32Orig );
+                }
             }
             close( fdr );
             PatchMetaHeader.origCrc32 = htobe32(crc32Orig);
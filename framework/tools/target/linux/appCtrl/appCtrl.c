@@ -208,6 +208,7 @@ static void PrintHelp
         "    app restartLegato\n"
         "    app list\n"
         "    app status [<appName>]\n"
+        "    app startTimes [<appName>]\n"
         "    app version <appName>\n"
         "    app info [<appName>]\n"
         "    app runProc <appName> <procName> [options]\n"
@@ -253,6 +254,12 @@ static void PrintHelp
         "       If a name is given, prints the status of the specified application.\n"
         "       The status of the application can be 'stopped', 'running', 'paused' or 'not installed'.\n"
         "\n"
+        "    app startTimes [<appName>]\n"
+        "       Prints the times, in milliseconds, taken by the last start of all installed\n"
+        "       applications, or of the specified application: the time it waited to be launched\n"
+        "       at start-up, the time to set up its sandbox, the time to start its processes and\n"
+        "       the time from starting its processes to advertising its first IPC service.\n"
+        "\n"
         "    app version <appName>\n"
         "       Prints the version of the specified application.\n"
         "\n"
@@ -693,6 +700,68 @@ static void PrintStatus
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints the times taken by the last start of an application.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintAppStartTimes
+(
+    const char* appNamePtr      ///< [IN] Application name to get the start times for.
+)
+{
+    uint32_t waitMs;
+    uint32_t sandboxMs;
+    uint32_t execMs;
+    uint32_t advertiseMs;
+
+    le_appCtrl_ConnectService();
+
+    if (le_appCtrl_GetStartTimes(appNamePtr, &waitMs, &sandboxMs, &execMs, &advertiseMs) != LE_OK)
+    {
+        printf("[not started] %s\n", appNamePtr);
+        return;
+    }
+
+    printf("%s: wait %" PRIu32 " ms, sandbox %" PRIu32 " ms, exec %" PRIu32 " ms",
+           appNamePtr, waitMs, sandboxMs, execMs);
+
+    if (advertiseMs != LE_APPCTRL_START_TIME_UNKNOWN)
+    {
+        printf(", first advertise %" PRIu32 " ms\n", advertiseMs);
+    }
+    else
+    {
+        printf(", first advertise n/a\n");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Implements the "startTimes" command.
+ *
+ * @note This function does not return.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void PrintStartTimes
+(
+    void
+)
+{
+    if (AppNamePtr == NULL)
+    {
+        ListInstalledApps(PrintAppStartTimes);
+    }
+    else
+    {
+        PrintAppStartTimes(AppNamePtr);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Parses a line of the APP_INFO_FILE for display.
@@ -1924,6 +1993,14 @@ static void CommandArgHandler
         le_arg_AddPositionalCallback(AppNameArgHandler);
         le_arg_AllowLessPositionalArgsThanCallbacks();
     }
+    else if (strcmp(command, "startTimes") == 0)
+    {
+        CommandFunc = PrintStartTimes;
+
+        // Accept an optional app name argument.
+        le_arg_AddPositionalCallback(AppNameArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
     else if (strcmp(command, "version") == 0)
     {
         CommandFunc = PrintAppVersion;
@@ -2196,8 +2196,19 @@ static ColumnInfo_t ThreadObjTableInfo[] =
     {"CONTENTION SCOPE", "%*s", NULL, "%*s",  0,                    true,  0, true},
     {"GUARD SIZE",       "%*s", NULL, "%*zu", sizeof(size_t),       false, 0, true},
     {"STACK ADDR",       "%*s", NULL, "%*X",  sizeof(uint64_t),     false, 0, true},
-    {"STACK SIZE",       "%*s", NULL, "%*zu", sizeof(size_t),       false, 0, true}
+    {"STACK SIZE",       "%*s", NULL, "%*zu", sizeof(size_t),       false, 0, true},
+    {"WAKEUPS",          "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, true},
+    {"REPORTS",          "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, true},
+    {"MAX PER WAKEUP",   "%*s", NULL, "%*u",  sizeof(uint32_t),     false, 0, true},
+    {"MAX QUEUED",       "%*s", NULL, "%*u",  sizeof(uint32_t),     false, 0, true},
+    {"DISPATCH <10us",   "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, false},
+    {"<100us",           "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, false},
+    {"<1ms",             "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, false},
+    {"<10ms",            "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, false},
+    {"<100ms",           "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, false},
+    {">=100ms",          "%*s", NULL, "%*"PRIu64"", sizeof(uint64_t), false, 0, false}
 };
+static_assert(EVENT_DISPATCH_HISTOGRAM_SIZE == 6, "DISPATCH columns don't match the histogram");
 static size_t ThreadObjTableInfoSize = NUM_ARRAY_MEMBERS(ThreadObjTableInfo);
 
 static ColumnInfo_t TimerTableInfo[] =
@@ -3412,8 +3423,24 @@ static int PrintThreadObjInfo
         INTERNAL_ERR("pthread_attr_getstack failed.");
     }
 
+    // The event loop's dispatch statistics are in the thread's event record.  A thread that
+    // hasn't initialized its event loop yet has none.
+    event_DispatchStats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    if (threadObjRef->eventRecPtr != NULL)
+    {
+        if (TargetReadAddress(PidToInspect,
+                              (uintptr_t)threadObjRef->eventRecPtr +
+                                  offsetof(event_PerThreadRec_t, stats),
+                              &stats, sizeof(stats)) != LE_OK)
+        {
+            INTERNAL_ERR(REMOTE_READ_ERR("event loop statistics"));
+        }
+    }
+
     // Output thread object info
     int index = 0;
+    size_t i;
 
     if (!IsOutputJson)
     {
@@ -3439,6 +3466,19 @@ static int PrintThreadObjInfo
                                                                     ThreadObjTableInfoSize, &index);
         FillSizeTColField (stackSize,                               ThreadObjTableInfo,
                                                                     ThreadObjTableInfoSize, &index);
+        FillUint64ColField(stats.wakeupCount,                       ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
+        FillUint64ColField(stats.reportCount,                       ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
+        FillUint32ColField(stats.maxReportsPerWakeup,               ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
+        FillUint32ColField(stats.maxQueueDepth,                     ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
+        for (i = 0; i < EVENT_DISPATCH_HISTOGRAM_SIZE; i++)
+        {
+            FillUint64ColField(stats.dispatchTimeHistogram[i],      ThreadObjTableInfo,
+                                                                    ThreadObjTableInfoSize, &index);
+        }
 
         PrintInfo(ThreadObjTableInfo, ThreadObjTableInfoSize);
         lineCount++;
@@ -3481,6 +3521,19 @@ static int PrintThreadObjInfo
                                                           ThreadObjTableInfoSize, &index, &printed);
         ExportSizeTToJson (stackSize,                     ThreadObjTableInfo,
                                                           ThreadObjTableInfoSize, &index, &printed);
+        ExportUint64ToJson(stats.wakeupCount,             ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
+        ExportUint64ToJson(stats.reportCount,             ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
+        ExportUint32ToJson(stats.maxReportsPerWakeup,     ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
+        ExportUint32ToJson(stats.maxQueueDepth,           ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
+        for (i = 0; i < EVENT_DISPATCH_HISTOGRAM_SIZE; i++)
+        {
+            ExportUint64ToJson(stats.dispatchTimeHistogram[i], ThreadObjTableInfo,
+                                                          ThreadObjTableInfoSize, &index, &printed);
+        }
 
         printf("]");
     }
@@ -75,6 +75,7 @@ static void PrintHelpAndExit
         "SYNOPSIS:\n"
         "    sdir list\n"
         "    sdir list --format=json\n"
+        "    sdir stats\n"
         "    sdir load\n"
         "    sdir bind CLIENT_IF SERVER_IF\n"
         "    sdir help\n"
@@ -88,6 +89,10 @@ static void PrintHelpAndExit
         "    sdir list --format=json\n"
         "            Lists bindings, services, and waiting clients in json format.\n"
         "\n"
+        "    sdir stats\n"
+        "            Shows how long the phases of opening IPC sessions took, on\n"
+        "            average and at worst, since the Service Directory started.\n"
+        "\n"
         "    sdir load\n"
         "            Updates the Service Directory's bindings with the current state\n"
         "            of the binding configuration settings in the configuration tree.\n"
@@ -234,12 +239,13 @@ static void PrintList
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Execute a 'list' command.
+ * Send a request whose output the Service Directory writes to a file descriptor, print the output
+ * and exit.
  */
 //--------------------------------------------------------------------------------------------------
-static void List
+static void RequestOutput
 (
-    void
+    le_sdtp_MsgType_t msgType   ///< [in] Type of the request.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -256,15 +262,7 @@ static void List
 
     le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
 
-    if (FormatPtr == NULL)
-    {
-        msgPtr->msgType = LE_SDTP_MSGID_LIST;
-    }
-    else
-    {
-        // Currently only json format is accepted.
-        msgPtr->msgType = LE_SDTP_MSGID_LIST_JSON;
-    }
+    msgPtr->msgType = msgType;
 
     msgRef = le_msg_RequestSyncResponse(msgRef);
 
@@ -286,19 +284,42 @@ static void List
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Send an "Unbind All" request to the Service Directory.
+ * Execute a 'list' command.
  */
 //--------------------------------------------------------------------------------------------------
-static void SendUnbindAllRequest
+static void List
 (
     void
 )
 //--------------------------------------------------------------------------------------------------
+{
+    if (FormatPtr == NULL)
+    {
+        RequestOutput(LE_SDTP_MSGID_LIST);
+    }
+    else
+    {
+        // Currently only json format is accepted.
+        RequestOutput(LE_SDTP_MSGID_LIST_JSON);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a request that has no payload to the Service Directory, and wait for it to be processed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendRequest
+(
+    le_sdtp_MsgType_t msgType   ///< [in] Type of the request.
+)
+//--------------------------------------------------------------------------------------------------
 {
     le_msg_MessageRef_t msgRef = le_msg_CreateMsg(SessionRef);
     le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
 
-    msgPtr->msgType = LE_SDTP_MSGID_UNBIND_ALL;
+    msgPtr->msgType = msgType;
 
     msgRef = le_msg_RequestSyncResponse(msgRef);
 
@@ -440,6 +461,9 @@ static le_result_t GetServerUid
 //--------------------------------------------------------------------------------------------------
 /**
  * Send a binding from a configuration tree iterator's current node to the Service Directory.
+ *
+ * Does not wait for the binding to be processed: the Service Directory processes messages in
+ * order, so the request that ends the load confirms that all the bindings sent before it were.
  */
 //--------------------------------------------------------------------------------------------------
 static void SendCfgBindRequest
@@ -467,6 +491,7 @@ static void SendCfgBindRequest
         char path[LIMIT_MAX_PATH_BYTES];
         le_cfg_GetPath(i, "", path, sizeof(path));
         LE_CRIT("Configured client service name too long (@ %s)", path);
+        le_msg_ReleaseMsg(msgRef);
         return;
     }
 
@@ -474,6 +499,7 @@ static void SendCfgBindRequest
     result = GetServerUid(i, &msgPtr->server);
     if (result != LE_OK)
     {
+        le_msg_ReleaseMsg(msgRef);
         return;
     }
 
@@ -488,6 +514,7 @@ static void SendCfgBindRequest
         char path[LIMIT_MAX_PATH_BYTES];
         le_cfg_GetPath(i, "interface", path, sizeof(path));
         LE_CRIT("Server interface name too big (@ %s)", path);
+        le_msg_ReleaseMsg(msgRef);
         return;
     }
     if (msgPtr->serverInterfaceName[0] == '\0')
@@ -495,17 +522,11 @@ static void SendCfgBindRequest
         char path[LIMIT_MAX_PATH_BYTES];
         le_cfg_GetPath(i, "interface", path, sizeof(path));
         LE_CRIT("Server interface name missing (@ %s)", path);
+        le_msg_ReleaseMsg(msgRef);
         return;
     }
 
-    msgRef = le_msg_RequestSyncResponse(msgRef);
-
-    if (msgRef == NULL)
-    {
-        ExitWithErrorMsg("Communication with Service Directory failed.");
-    }
-
-    le_msg_ReleaseMsg(msgRef);
+    le_msg_Send(msgRef);
 }
 
 
@@ -626,8 +647,8 @@ static void Load
     // Start a read transaction on the root of the "system" configuration tree.
     le_cfg_IteratorRef_t i = le_cfg_CreateReadTxn("system:");
 
-    // Tell the Service Directory to delete all existing bindings.
-    SendUnbindAllRequest();
+    // Tell the Service Directory to delete all existing bindings and start a load.
+    SendRequest(LE_SDTP_MSGID_LOAD_START);
 
     // Iterate over the users collection.
     le_cfg_GoToNode(i, "/users");
@@ -684,6 +705,8 @@ static void Load
         result = le_cfg_GoToNextSibling(i);
     }
 
+    // End the load, and wait for all the bindings to have been applied.
+    SendRequest(LE_SDTP_MSGID_LOAD_END);
 
     exit(EXIT_SUCCESS);
 }
@@ -952,6 +975,10 @@ COMPONENT_INIT
                  CommandPtr);
         ExitWithErrorMsg(errorMsg);
     }
+    else if (strcmp(CommandPtr, "stats") == 0)
+    {
+        RequestOutput(LE_SDTP_MSGID_STATS);
+    }
     else if (strcmp(CommandPtr, "load") == 0)
     {
         Load();